@@ -192,6 +192,12 @@
 // 非同期タスク | Asynchronous task
 # include <Siv3D/AsyncTask.hpp>
 
+// 並列ループ | Parallel loop
+# include <Siv3D/ParallelFor.hpp>
+
+// タスクグループ | Task group
+# include <Siv3D/TaskGroup.hpp>
+
 // 子プロセス | Child process
 # include <Siv3D/ChildProcess.hpp>
 
@@ -348,6 +354,9 @@
 // プロファイラー | Profiler
 # include <Siv3D/Profiler.hpp>
 
+// プロファイラのゾーン | Profiler zone
+# include <Siv3D/ProfilerZone.hpp>
+
 // 処理にかかった時間の測定 | Clock counter in milliseconds
 # include <Siv3D/MillisecClock.hpp>
 
@@ -387,6 +396,9 @@
 // リソースファイルの管理 | Resource files
 # include <Siv3D/Resource.hpp>
 
+// リソースパック | Resource pack
+# include <Siv3D/ResourcePack.hpp>
+
 // ファイル操作のイベント | File action
 # include <Siv3D/FileAction.hpp>
 
@@ -450,6 +462,15 @@
 // Zstandard 方式による可逆圧縮 | Lossless compression with Zstandard algorithm
 # include <Siv3D/Compression.hpp>
 
+// ストリーム圧縮の形式 | Stream compression format
+# include <Siv3D/CompressionFormat.hpp>
+
+// 圧縮しながら書き込む Writer | Writer that compresses data as it writes
+# include <Siv3D/CompressionWriter.hpp>
+
+// 伸長しながら読み込む Reader | Reader that decompresses data as it reads
+# include <Siv3D/DecompressionReader.hpp>
+
 // ZIP 圧縮ファイルの読み込み | ZIP reader
 # include <Siv3D/ZIPReader.hpp>
 
@@ -474,12 +495,21 @@
 // CSV データの読み書き | CSV reader/writer
 # include <Siv3D/CSV.hpp>
 
+// CSV ファイルのメモリマップによる読み込み | Memory-mapped CSV file reader
+# include <Siv3D/CSVView.hpp>
+
 // INI データの読み書き | INI reader/writer
 # include <Siv3D/INI.hpp>
 
 // JSON データの読み書き | JSON reader/writer
 # include <Siv3D/JSON.hpp>
 
+// JSON のストリーミング読み込み | Streaming JSON reader
+# include <Siv3D/JSONReader.hpp>
+
+// JSON のストリーミング書き出し | Streaming JSON writer
+# include <Siv3D/JSONWriter.hpp>
+
 // JSON データの検証 | JSON validation
 # include <Siv3D/JSONValidator.hpp>
 
@@ -507,6 +537,9 @@
 // ログの種類 | Log type
 # include <Siv3D/LogType.hpp>
 
+// 非同期ログのバッファが一杯になったときの動作 | Log overflow policy
+# include <Siv3D/LogOverflowPolicy.hpp>
+
 // ロガー | Logger
 # include <Siv3D/Logger.hpp>
 
@@ -732,6 +765,9 @@
 // 2D 幾何 | 2D geometry processing
 # include <Siv3D/Geometry2D.hpp>
 
+// 2D 図形の一括交差判定 | Batch 2D intersection tests
+# include <Siv3D/BroadPhase2D.hpp>
+
 // 長方形詰込み | Rectangle packing
 # include <Siv3D/RectanglePacking.hpp>
 
@@ -1260,6 +1296,15 @@
 // 高速フーリエ変換 | Fast Fourier transform
 # include <Siv3D/FFT.hpp>
 
+// FFT の窓関数 | FFT window function
+# include <Siv3D/FFTWindowFunction.hpp>
+
+// スペクトログラム | Spectrogram
+# include <Siv3D/Spectrogram.hpp>
+
+// スペクトログラムの計算 | Spectrogram analyzer
+# include <Siv3D/SpectrogramAnalyzer.hpp>
+
 //////////////////////////////////////////////////
 //
 //	音声形式 | Audio Encoding
@@ -1267,6 +1312,7 @@
 //////////////////////////////////////////////////
 
 # include <Siv3D/AudioFormat.hpp>
+# include <Siv3D/IAudioDecoderStream.hpp>
 # include <Siv3D/IAudioDecoder.hpp>
 # include <Siv3D/IAudioEncoder.hpp>
 # include <Siv3D/AudioDecoder.hpp>
@@ -1318,6 +1364,9 @@
 // オーディオストリームのインタフェース | Audio stream interface
 # include <Siv3D/IAudioStream.hpp>
 
+// 先読みしながらデコードするオーディオストリーム | Prefetching audio stream
+# include <Siv3D/PrefetchAudioStream.hpp>
+
 // 音声 | Audio
 # include <Siv3D/Audio.hpp>
 
@@ -1415,6 +1464,10 @@
 
 # include <Siv3D/AssetInfo.hpp>
 
+# include <Siv3D/AssetLoadPriority.hpp>
+
+# include <Siv3D/AssetLoadProgress.hpp>
+
 # include <Siv3D/Asset.hpp>
 
 # include <Siv3D/AudioAssetData.hpp>
@@ -1468,6 +1521,9 @@
 
 # include <Siv3D/Graphics2D.hpp>
 
+// 2D 描画コマンドリスト | 2D draw command list
+# include <Siv3D/Graphics2DCommandList.hpp>
+
 // ブレンドステート | Blend state
 # include <Siv3D/BlendState.hpp>
 
@@ -1602,6 +1658,9 @@
 // 動的テクスチャ | Dynamic texture
 # include <Siv3D/DynamicTexture.hpp>
 
+// テクスチャアトラス | Texture atlas
+# include <Siv3D/TextureAtlas.hpp>
+
 // ビデオ・テクスチャ | Video texture
 # include <Siv3D/VideoTexture.hpp>
 
@@ -10,14 +10,19 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include "Common.hpp"
 # include "String.hpp"
 # include "Array.hpp"
 # include "AssetState.hpp"
 # include "AssetInfo.hpp"
+# include "AssetLoadPriority.hpp"
+# include "AssetLoadProgress.hpp"
 
 namespace s3d
 {
+	using FilePath = String;
+
 	class IAsset
 	{
 	public:
@@ -58,10 +63,53 @@ namespace s3d
 
 		void setState(AssetState state);
 
+		/// @brief エンジンのアセットローダーに非同期ロードを要求し、状態を `AssetState::AsyncLoading` にします。
+		/// @param loader ロード処理。成功した場合 true を返す関数
+		/// @param files ロード処理が読み込むファイル。ロード処理の前に I/O スレッドで先読みします。
+		/// @remark ロード処理の戻り値に応じて、状態を `AssetState::Loaded` または `AssetState::Failed` にします。キャンセルされた場合は `AssetState::Uninitialized` に戻します。
+		void requestAsyncLoad(std::function<bool()> loader, Array<FilePath> files = {});
+
+		/// @brief `requestAsyncLoad()` で要求した非同期ロードが終了するまで待機します。
+		/// @remark まだ開始されていない場合は、呼び出したスレッドでロードします。
+		void waitAsyncLoad();
+
 	private:
 
 		class IAssetDetail;
 
 		std::shared_ptr<IAssetDetail> pImpl;
 	};
+
+	namespace Asset
+	{
+		/// @brief 指定したタグを持つすべてのアセットの非同期ロードを開始します。
+		/// @param tag アセットタグ
+		/// @param priority 優先度
+		/// @remark シェーダアセットは対象になりません。
+		void LoadAsync(const AssetTag& tag, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+		/// @brief 指定したタグを持つすべてのアセットの非同期ロードを、依存するアセットのロードが終わってから開始します。
+		/// @param tag アセットタグ
+		/// @param dependencies 依存するアセットのタグ。これらのタグを持つアセットのロードが終わるまで、`tag` のアセットのロードを開始しません。
+		/// @param priority 優先度
+		/// @remark 依存するアセットがまだロードされていない場合は、同じ優先度で非同期ロードを開始します。
+		/// @remark シェーダアセットは対象になりません。
+		void LoadAsync(const AssetTag& tag, const Array<AssetTag>& dependencies, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+		/// @brief 指定したタグを持つアセットのうち、まだ開始されていない非同期ロードをキャンセルします。
+		/// @param tag アセットタグ
+		/// @return キャンセルした非同期ロードの数
+		/// @remark キャンセルされたアセットは、ロードを開始していない状態に戻ります。
+		size_t CancelLoadAsync(const AssetTag& tag);
+
+		/// @brief まだ開始されていないすべての非同期ロードをキャンセルします。
+		/// @return キャンセルした非同期ロードの数
+		/// @remark キャンセルされたアセットは、ロードを開始していない状態に戻ります。
+		size_t CancelLoadAsyncAll();
+
+		/// @brief アセットの非同期ロードの進捗を返します。
+		/// @return 非同期ロードの進捗
+		[[nodiscard]]
+		AssetLoadProgress LoadProgress();
+	}
 }
@@ -0,0 +1,29 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief アセットの非同期ロードの優先度
+	enum class AssetLoadPriority : uint8
+	{
+		/// @brief 低い
+		Low,
+
+		/// @brief 通常
+		Normal,
+
+		/// @brief 高い
+		High,
+	};
+}
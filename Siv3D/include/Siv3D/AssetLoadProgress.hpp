@@ -0,0 +1,49 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief アセットの非同期ロードの進捗
+	/// @remark 非同期ロードがすべて終わった後に新しく要求されたロードから、集計をやり直します。
+	struct AssetLoadProgress
+	{
+		/// @brief 要求された非同期ロードの数
+		size_t total = 0;
+
+		/// @brief 終了した（成功、失敗、キャンセルを含む）非同期ロードの数
+		size_t finished = 0;
+
+		/// @brief 失敗した非同期ロードの数
+		size_t failed = 0;
+
+		/// @brief キャンセルされた非同期ロードの数
+		size_t canceled = 0;
+
+		/// @brief 進捗の割合を返します。
+		/// @return 進捗の割合 [0.0, 1.0]。要求された非同期ロードが無い場合は 1.0
+		[[nodiscard]]
+		constexpr double ratio() const noexcept
+		{
+			return (total ? (static_cast<double>(finished) / total) : 1.0);
+		}
+
+		/// @brief 要求された非同期ロードがすべて終了しているかを返します。
+		/// @return すべて終了している場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool isFinished() const noexcept
+		{
+			return (finished == total);
+		}
+	};
+}
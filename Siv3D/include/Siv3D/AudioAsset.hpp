@@ -82,7 +82,7 @@ namespace s3d
 
 		static bool Load(AssetNameView name);
 
-		static void LoadAsync(AssetNameView name);
+		static void LoadAsync(AssetNameView name, AssetLoadPriority priority = AssetLoadPriority::Normal);
 
 		static void Wait(AssetNameView name);
 
@@ -53,6 +53,21 @@ namespace s3d
 		[[nodiscard]]
 		Wave Decode(IReader& reader, StringView decoderName);
 
+		/// @brief 音声ファイルを少しずつデコードするストリームを作成します。
+		/// @param path 音声ファイルのパス
+		/// @param audioFormat 音声のフォーマット。不明の場合は `AudioFormat::Unknown`
+		/// @return 作成したストリーム。デコーダが少しずつデコードすることに対応しない場合や、失敗した場合は nullptr
+		/// @remark 作成したストリームは `PrefetchAudioStream` に渡して再生できます。
+		[[nodiscard]]
+		std::unique_ptr<IAudioDecoderStream> OpenStream(FilePathView path, AudioFormat audioFormat);
+
+		/// @brief 音声データを少しずつデコードするストリームを作成します。
+		/// @param reader 音声データの IReader インタフェース。作成したストリームが所有します
+		/// @param audioFormat 音声のフォーマット。不明の場合は `AudioFormat::Unknown`
+		/// @return 作成したストリーム。デコーダが少しずつデコードすることに対応しない場合や、失敗した場合は nullptr
+		[[nodiscard]]
+		std::unique_ptr<IAudioDecoderStream> OpenStream(std::unique_ptr<IReader>&& reader, AudioFormat audioFormat);
+
 		/// @brief エンジンに新しいカスタム音声デコーダを追加します。
 		/// @param decoder 追加するデコーダ
 		/// @return 追加に成功した場合 true, それ以外の場合は false
@@ -52,5 +52,12 @@ namespace s3d
 		/// @return 作成した Wave
 		[[nodiscard]]
 		Wave decode(IReader& reader, FilePathView pathHint = {}) const override;
+
+		/// @brief Opus 形式の音声データを少しずつデコードするストリームを作成します。
+		/// @param reader 音声データの IReader インタフェース
+		/// @return 作成したストリーム。失敗した場合は nullptr
+		/// @remark デコード後のサンプリングレートは、元のサンプリングレートによらず 48 kHz です。
+		[[nodiscard]]
+		std::unique_ptr<IAudioDecoderStream> openStream(std::unique_ptr<IReader>&& reader) const override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "2DShapes.hpp"
+# include "FormatData.hpp"
+
+namespace s3d
+{
+	/// @brief 多数の図形の交差判定をまとめて行う関数群
+	/// @remark x 軸でのスイープ・アンド・プルーン（ソートして走査）で候補を絞り込んでから、`Geometry2D::Intersect()` で判定します。
+	/// @remark 結果は `Geometry2D::Intersect()` を組ごとに呼んだ場合と一致します。
+	namespace BroadPhase2D
+	{
+		/// @brief 交差する 2 つの図形のインデックスの組
+		struct IndexPair
+		{
+			/// @brief 1 つ目の図形のインデックス
+			uint32 first;
+
+			/// @brief 2 つ目の図形のインデックス
+			uint32 second;
+
+			[[nodiscard]]
+			friend constexpr bool operator ==(const IndexPair& lhs, const IndexPair& rhs) noexcept
+			{
+				return ((lhs.first == rhs.first) && (lhs.second == rhs.second));
+			}
+
+			[[nodiscard]]
+			friend constexpr bool operator !=(const IndexPair& lhs, const IndexPair& rhs) noexcept
+			{
+				return ((lhs.first != rhs.first) || (lhs.second != rhs.second));
+			}
+
+			friend void Formatter(FormatData& formatData, const IndexPair& value);
+		};
+
+		//////////////////////////////////////////////////
+		//
+		//	a と b の間
+		//
+		//////////////////////////////////////////////////
+
+		/// @brief `a` の図形と `b` の図形で、交差する組をすべて返します。
+		/// @param a 図形の配列
+		/// @param b 図形の配列
+		/// @return 交差する組 `{ a のインデックス, b のインデックス }` の配列。`first`, `second` の昇順
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Circle>& a, const Array<Circle>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Circle>& a, const Array<RectF>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Circle>& a, const Array<Line>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<RectF>& a, const Array<Circle>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<RectF>& a, const Array<RectF>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<RectF>& a, const Array<Line>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Line>& a, const Array<Circle>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Line>& a, const Array<RectF>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Line>& a, const Array<Line>& b);
+
+		//////////////////////////////////////////////////
+		//
+		//	shapes どうし
+		//
+		//////////////////////////////////////////////////
+
+		/// @brief `shapes` の中で、交差する図形の組をすべて返します。
+		/// @param shapes 図形の配列
+		/// @return 交差する組 `{ i, j }` (i < j) の配列。`first`, `second` の昇順
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Circle>& shapes);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<RectF>& shapes);
+
+		[[nodiscard]]
+		Array<IndexPair> FindIntersections(const Array<Line>& shapes);
+
+		//////////////////////////////////////////////////
+		//
+		//	並列版
+		//
+		//////////////////////////////////////////////////
+
+		/// @brief `a` の図形と `b` の図形で、交差する組をすべて返します。エンジンのスレッドプールを使って並列に判定します。
+		/// @param a 図形の配列
+		/// @param b 図形の配列
+		/// @return 交差する組 `{ a のインデックス, b のインデックス }` の配列。`first`, `second` の昇順
+		/// @remark 結果は `FindIntersections()` と同じです。
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& a, const Array<Circle>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& a, const Array<RectF>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& a, const Array<Line>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& a, const Array<Circle>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& a, const Array<RectF>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& a, const Array<Line>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& a, const Array<Circle>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& a, const Array<RectF>& b);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& a, const Array<Line>& b);
+
+		/// @brief `shapes` の中で、交差する図形の組をすべて返します。エンジンのスレッドプールを使って並列に判定します。
+		/// @param shapes 図形の配列
+		/// @return 交差する組 `{ i, j }` (i < j) の配列。`first`, `second` の昇順
+		/// @remark 結果は `FindIntersections()` と同じです。
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& shapes);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& shapes);
+
+		[[nodiscard]]
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& shapes);
+	}
+}
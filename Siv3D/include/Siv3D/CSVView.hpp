@@ -0,0 +1,216 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <array>
+# include <functional>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "Optional.hpp"
+# include "Parse.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct CSVViewSyntax;
+
+		/// @brief ヒープを使わずに変換するフィールドの最大の長さ（バイト）
+		inline constexpr size_t CSVViewSmallFieldLength = 64;
+	}
+
+	/// @brief CSVView の 1 行を参照するクラス
+	/// @remark 参照元の CSVView、または CSVView::ForEachRow() のコールバックの呼び出しよりも長く使うことはできません。
+	class CSVRowView
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		CSVRowView() = default;
+
+		/// @brief 列数を返します。
+		/// @return 列数
+		[[nodiscard]]
+		size_t columns() const noexcept;
+
+		/// @brief 指定した列の値を読み取ります。
+		/// @tparam Type 読み取る値の型
+		/// @param column 列
+		/// @return 読み取った値
+		template <class Type = String>
+		[[nodiscard]]
+		Type get(size_t column) const;
+
+		/// @brief 指定した列の値を読み取ります。失敗した場合は defaultValue を返します。
+		/// @tparam Type 読み取る値の型
+		/// @tparam U デフォルトの値の型
+		/// @param column 列
+		/// @param defaultValue デフォルトの値
+		/// @return 読み取った値。失敗した場合はデフォルトの値
+		template <class Type, class U>
+		[[nodiscard]]
+		Type getOr(size_t column, U&& defaultValue) const;
+
+		/// @brief 指定した列の値を読み取ります。失敗した場合は none を返します。
+		/// @tparam Type 読み取る値の型
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は none
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt(size_t column) const;
+
+		/// @brief 指定した列の、クオーテーションやエスケープを処理する前の UTF-8 文字列を返します。
+		/// @param column 列
+		/// @return 指定した列の UTF-8 文字列。範囲外の場合は空の文字列
+		[[nodiscard]]
+		std::string_view getRaw(size_t column) const noexcept;
+
+		/// @brief 行のすべての値を文字列の配列で返します。
+		/// @return 行のすべての値
+		[[nodiscard]]
+		Array<String> asArray() const;
+
+		[[nodiscard]]
+		String operator [](size_t column) const;
+
+	private:
+
+		friend class CSVView;
+
+		const char8* m_pLine = nullptr;
+
+		// 各フィールドの開始位置と、最後のフィールドの終端 + 1
+		const uint32* m_pFields = nullptr;
+
+		size_t m_columns = 0;
+
+		const detail::CSVViewSyntax* m_pSyntax = nullptr;
+
+		SIV3D_NODISCARD_CXX20
+		CSVRowView(const char8* pLine, const uint32* pFields, size_t columns, const detail::CSVViewSyntax* pSyntax) noexcept;
+
+		[[nodiscard]]
+		Optional<String> getItem(size_t column) const;
+
+		[[nodiscard]]
+		Optional<size_t> getSmallItem(size_t column, char32* pDst) const;
+	};
+
+	/// @brief CSV 形式のファイルをメモリマップし、値を必要になったときに変換するクラス
+	/// @remark ファイルを開くときには各フィールドの位置だけを調べるため、CSV よりも高速に開けて、メモリの使用量も小さくなります。
+	/// @remark ファイルは UTF-8 でなければなりません。区切り文字・クオーテーション記号・エスケープ記号には ASCII 文字のみ使えます。
+	class CSVView
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		CSVView();
+
+		/// @brief CSV ファイルを開きます。
+		/// @param path ファイルパス
+		/// @param separators 要素のセパレータ
+		/// @param quotes クオーテーション記号
+		/// @param escapes エスケープ記号
+		SIV3D_NODISCARD_CXX20
+		explicit CSVView(FilePathView path, StringView separators = U",", StringView quotes = U"\"", StringView escapes = U"\\");
+
+		/// @brief CSV ファイルを開きます。
+		/// @param path ファイルパス
+		/// @param separators 要素のセパレータ
+		/// @param quotes クオーテーション記号
+		/// @param escapes エスケープ記号
+		/// @return ファイルを開くのに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path, StringView separators = U",", StringView quotes = U"\"", StringView escapes = U"\\");
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 行数を返します。
+		/// @return 行数
+		[[nodiscard]]
+		size_t rows() const noexcept;
+
+		/// @brief 指定した行の列数を返します。
+		/// @param row 行
+		/// @return 指定した行の列数
+		[[nodiscard]]
+		size_t columns(size_t row) const noexcept;
+
+		/// @brief 指定した位置の値を読み取ります。
+		/// @tparam Type 読み取る値の型
+		/// @param row 行
+		/// @param column 列
+		/// @return 読み取った値
+		template <class Type = String>
+		[[nodiscard]]
+		Type get(size_t row, size_t column) const;
+
+		/// @brief 指定した位置の値を読み取ります。失敗した場合は defaultValue を返します。
+		/// @tparam Type 読み取る値の型
+		/// @tparam U デフォルトの値の型
+		/// @param row 行
+		/// @param column 列
+		/// @param defaultValue デフォルトの値
+		/// @return 読み取った値。失敗した場合はデフォルトの値
+		template <class Type, class U>
+		[[nodiscard]]
+		Type getOr(size_t row, size_t column, U&& defaultValue) const;
+
+		/// @brief 指定した位置の値を読み取ります。失敗した場合は none を返します。
+		/// @tparam Type 読み取る値の型
+		/// @param row 行
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は none
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt(size_t row, size_t column) const;
+
+		/// @brief 指定した行を参照するオブジェクトを返します。
+		/// @param row 行
+		/// @return 指定した行を参照するオブジェクト。範囲外の場合は列数 0 の行
+		[[nodiscard]]
+		CSVRowView getRow(size_t row) const noexcept;
+
+		[[nodiscard]]
+		CSVRowView operator [](size_t row) const noexcept;
+
+		/// @brief 開いているファイルのフルパスを返します。
+		/// @return 開いているファイルのフルパス
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+		/// @brief CSV ファイルを先頭から 1 行ずつ読み、コールバックを呼びます。
+		/// @param path ファイルパス
+		/// @param callback 各行に対して呼ばれるコールバック
+		/// @param separators 要素のセパレータ
+		/// @param quotes クオーテーション記号
+		/// @param escapes エスケープ記号
+		/// @return ファイルを最後まで読むのに成功した場合 true, それ以外の場合は false
+		/// @remark ファイルを一定の大きさずつメモリマップするため、メモリに収まらない大きさのファイルも読めます。
+		static bool ForEachRow(FilePathView path, const std::function<void(const CSVRowView&)>& callback,
+			StringView separators = U",", StringView quotes = U"\"", StringView escapes = U"\\");
+
+	private:
+
+		class CSVViewDetail;
+
+		std::shared_ptr<CSVViewDetail> pImpl;
+	};
+}
+
+# include "detail/CSVView.ipp"
@@ -0,0 +1,26 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief ストリーム圧縮の形式
+	enum class CompressionFormat : uint8
+	{
+		/// @brief Zstandard (`Compression` と互換)
+		Zstandard,
+
+		/// @brief zlib (`Zlib` と互換)
+		Zlib,
+	};
+}
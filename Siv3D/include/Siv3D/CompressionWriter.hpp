@@ -0,0 +1,154 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "IWriter.hpp"
+# include "StringView.hpp"
+# include "CompressionFormat.hpp"
+
+namespace s3d
+{
+	/// @brief データを圧縮しながら、別の Writer に書き込む Writer
+	/// @remark 一定の大きさのバッファだけを使うため、データの大きさに関わらずメモリ使用量は増えません。
+	/// @remark 書き込まれたデータは `Compression::Decompress()` / `Zlib::Decompress()` または `DecompressionReader` で伸長できます。
+	class CompressionWriter : public IWriter
+	{
+	public:
+
+		/// @brief 圧縮形式ごとのデフォルトの圧縮レベルを使うことを表す値
+		static constexpr int32 DefaultLevel = 0;
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		CompressionWriter();
+
+		/// @brief ファイルを開き、圧縮したデータを書き込みます。
+		/// @param path ファイルパス
+		/// @param format 圧縮形式
+		/// @param compressionLevel 圧縮レベル。`DefaultLevel` の場合は圧縮形式ごとのデフォルト
+		/// @param numWorkers Zstandard の圧縮に使うワーカースレッドの数。0 の場合は書き込みを行うスレッドで圧縮します。
+		SIV3D_NODISCARD_CXX20
+		explicit CompressionWriter(FilePathView path, CompressionFormat format = CompressionFormat::Zstandard, int32 compressionLevel = DefaultLevel, int32 numWorkers = 0);
+
+		/// @brief Writer に圧縮したデータを書き込みます。
+		/// @tparam Writer Writer の型
+		/// @param writer 圧縮したデータの書き込み先
+		/// @param format 圧縮形式
+		/// @param compressionLevel 圧縮レベル。`DefaultLevel` の場合は圧縮形式ごとのデフォルト
+		/// @param numWorkers Zstandard の圧縮に使うワーカースレッドの数。0 の場合は書き込みを行うスレッドで圧縮します。
+		template <class Writer, std::enable_if_t<std::is_base_of_v<IWriter, Writer> && !std::is_lvalue_reference_v<Writer>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		explicit CompressionWriter(Writer&& writer, CompressionFormat format = CompressionFormat::Zstandard, int32 compressionLevel = DefaultLevel, int32 numWorkers = 0);
+
+		/// @brief Writer に圧縮したデータを書き込みます。
+		/// @param writer 圧縮したデータの書き込み先
+		/// @param format 圧縮形式
+		/// @param compressionLevel 圧縮レベル。`DefaultLevel` の場合は圧縮形式ごとのデフォルト
+		/// @param numWorkers Zstandard の圧縮に使うワーカースレッドの数。0 の場合は書き込みを行うスレッドで圧縮します。
+		SIV3D_NODISCARD_CXX20
+		explicit CompressionWriter(std::unique_ptr<IWriter>&& writer, CompressionFormat format = CompressionFormat::Zstandard, int32 compressionLevel = DefaultLevel, int32 numWorkers = 0);
+
+		/// @brief ファイルを開き、圧縮したデータを書き込みます。
+		/// @param path ファイルパス
+		/// @param format 圧縮形式
+		/// @param compressionLevel 圧縮レベル。`DefaultLevel` の場合は圧縮形式ごとのデフォルト
+		/// @param numWorkers Zstandard の圧縮に使うワーカースレッドの数。0 の場合は書き込みを行うスレッドで圧縮します。
+		/// @return 圧縮の開始に成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path, CompressionFormat format = CompressionFormat::Zstandard, int32 compressionLevel = DefaultLevel, int32 numWorkers = 0);
+
+		/// @brief Writer に圧縮したデータを書き込みます。
+		/// @tparam Writer Writer の型
+		/// @param writer 圧縮したデータの書き込み先
+		/// @param format 圧縮形式
+		/// @param compressionLevel 圧縮レベル。`DefaultLevel` の場合は圧縮形式ごとのデフォルト
+		/// @param numWorkers Zstandard の圧縮に使うワーカースレッドの数。0 の場合は書き込みを行うスレッドで圧縮します。
+		/// @return 圧縮の開始に成功した場合 true, それ以外の場合は false
+		template <class Writer, std::enable_if_t<std::is_base_of_v<IWriter, Writer> && !std::is_lvalue_reference_v<Writer>>* = nullptr>
+		bool open(Writer&& writer, CompressionFormat format = CompressionFormat::Zstandard, int32 compressionLevel = DefaultLevel, int32 numWorkers = 0);
+
+		/// @brief Writer に圧縮したデータを書き込みます。
+		/// @param writer 圧縮したデータの書き込み先
+		/// @param format 圧縮形式
+		/// @param compressionLevel 圧縮レベル。`DefaultLevel` の場合は圧縮形式ごとのデフォルト
+		/// @param numWorkers Zstandard の圧縮に使うワーカースレッドの数。0 の場合は書き込みを行うスレッドで圧縮します。
+		/// @return 圧縮の開始に成功した場合 true, それ以外の場合は false
+		bool open(std::unique_ptr<IWriter>&& writer, CompressionFormat format = CompressionFormat::Zstandard, int32 compressionLevel = DefaultLevel, int32 numWorkers = 0);
+
+		/// @brief 圧縮を終了して残りのデータを書き込み、書き込み先を閉じます。
+		/// @remark 明示的に呼ばなかった場合は、最後のコピーが破棄されるときに呼ばれます。
+		/// @return すべてのデータを書き込めた場合 true, それ以外の場合は false
+		bool close();
+
+		/// @brief 圧縮を行っているかを返します。
+		/// @return 圧縮を行っている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept override;
+
+		/// @brief 圧縮を行っているかを返します。
+		/// @return 圧縮を行っている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief これまでに書き込まれたデータを、伸長できる状態で書き込み先に出力します。
+		/// @remark 頻繁に呼ぶと圧縮率が下がります。
+		/// @return 出力に成功した場合 true, それ以外の場合は false
+		bool flush();
+
+		/// @brief これまでに書き込まれた、圧縮前のデータのサイズ（バイト）を返します。
+		/// @return 圧縮前のデータのサイズ（バイト）
+		[[nodiscard]]
+		int64 size() const override;
+
+		/// @brief 現在の書き込み位置を返します。
+		/// @return 現在の書き込み位置。`size()` と同じです。
+		[[nodiscard]]
+		int64 getPos() const override;
+
+		/// @brief 書き込み位置を変更します。
+		/// @param pos 新しい書き込み位置（バイト）
+		/// @remark ストリームのため、現在の書き込み位置以外には変更できません。
+		/// @return `pos` が現在の書き込み位置の場合 true, それ以外の場合は false
+		bool setPos(int64 pos) override;
+
+		/// @brief データを圧縮して書き込みます。
+		/// @param src 書き込むデータ
+		/// @param sizeBytes 書き込むサイズ（バイト）
+		/// @return 実際に書き込んだサイズ（バイト）
+		int64 write(const void* src, int64 sizeBytes) override;
+
+		/// @brief データを圧縮して書き込みます。
+		/// @tparam TriviallyCopyable 書き込む値の型
+		/// @param src 書き込むデータ
+		/// @return 書き込みに成功した場合 true, それ以外の場合は false
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		bool write(const TriviallyCopyable& src);
+
+		/// @brief これまでに書き込み先に出力した、圧縮後のデータのサイズ（バイト）を返します。
+		/// @return 圧縮後のデータのサイズ（バイト）
+		[[nodiscard]]
+		int64 compressedSize() const;
+
+		/// @brief 圧縮形式を返します。
+		/// @return 圧縮形式
+		[[nodiscard]]
+		CompressionFormat format() const noexcept;
+
+	private:
+
+		class CompressionWriterDetail;
+
+		std::shared_ptr<CompressionWriterDetail> pImpl;
+	};
+}
+
+# include "detail/CompressionWriter.ipp"
@@ -0,0 +1,153 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "IReader.hpp"
+# include "StringView.hpp"
+# include "CompressionFormat.hpp"
+
+namespace s3d
+{
+	/// @brief 別の Reader から圧縮されたデータを読み込み、伸長しながら読み込む Reader
+	/// @remark 一定の大きさのバッファだけを使うため、データの大きさに関わらずメモリ使用量は増えません。
+	/// @remark `Compression::Compress()` / `Zlib::Compress()` または `CompressionWriter` で圧縮したデータを読み込めます。
+	class DecompressionReader : public IReader
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		DecompressionReader();
+
+		/// @brief 圧縮されたファイルを開きます。
+		/// @param path ファイルパス
+		/// @param format 圧縮形式
+		SIV3D_NODISCARD_CXX20
+		explicit DecompressionReader(FilePathView path, CompressionFormat format = CompressionFormat::Zstandard);
+
+		/// @brief Reader から圧縮されたデータを読み込みます。
+		/// @tparam Reader Reader の型
+		/// @param reader 圧縮されたデータの読み込み元
+		/// @param format 圧縮形式
+		template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader> && !std::is_lvalue_reference_v<Reader>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		explicit DecompressionReader(Reader&& reader, CompressionFormat format = CompressionFormat::Zstandard);
+
+		/// @brief Reader から圧縮されたデータを読み込みます。
+		/// @param reader 圧縮されたデータの読み込み元
+		/// @param format 圧縮形式
+		SIV3D_NODISCARD_CXX20
+		explicit DecompressionReader(std::unique_ptr<IReader>&& reader, CompressionFormat format = CompressionFormat::Zstandard);
+
+		/// @brief 圧縮されたファイルを開きます。
+		/// @param path ファイルパス
+		/// @param format 圧縮形式
+		/// @return 伸長の開始に成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path, CompressionFormat format = CompressionFormat::Zstandard);
+
+		/// @brief Reader から圧縮されたデータを読み込みます。
+		/// @tparam Reader Reader の型
+		/// @param reader 圧縮されたデータの読み込み元
+		/// @param format 圧縮形式
+		/// @return 伸長の開始に成功した場合 true, それ以外の場合は false
+		template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader> && !std::is_lvalue_reference_v<Reader>>* = nullptr>
+		bool open(Reader&& reader, CompressionFormat format = CompressionFormat::Zstandard);
+
+		/// @brief Reader から圧縮されたデータを読み込みます。
+		/// @param reader 圧縮されたデータの読み込み元
+		/// @param format 圧縮形式
+		/// @return 伸長の開始に成功した場合 true, それ以外の場合は false
+		bool open(std::unique_ptr<IReader>&& reader, CompressionFormat format = CompressionFormat::Zstandard);
+
+		/// @brief 読み込み元を閉じます。
+		void close();
+
+		/// @brief 読み込み位置を変更しないデータ読み込みをサポートしているかを返します。
+		/// @return false
+		[[nodiscard]]
+		bool supportsLookahead() const noexcept override;
+
+		/// @brief 伸長を行っているかを返します。
+		/// @return 伸長を行っている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept override;
+
+		/// @brief 伸長を行っているかを返します。
+		/// @return 伸長を行っている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 伸長後のデータのサイズを返します。
+		/// @remark 伸長後のサイズはデータを最後まで読み込むまで分からないため、それまでは -1 を返します。
+		/// @return 伸長後のデータのサイズ（バイト）。分からない場合は -1
+		[[nodiscard]]
+		int64 size() const override;
+
+		/// @brief 伸長後のデータにおける現在の読み込み位置を返します。
+		/// @return 現在の読み込み位置（バイト）
+		[[nodiscard]]
+		int64 getPos() const override;
+
+		/// @brief 伸長後のデータにおける読み込み位置を変更します。
+		/// @param pos 新しい読み込み位置（バイト）
+		/// @remark 前方へは読み飛ばして移動します。後方へは読み込み元が `setPos()` に対応している場合のみ、先頭から伸長し直して移動します。
+		/// @return 読み込み位置の変更に成功した場合 true, それ以外の場合は false
+		bool setPos(int64 pos) override;
+
+		/// @brief 伸長後のデータを読み飛ばします。
+		/// @param offset 読み飛ばすサイズ（バイト）
+		/// @return 新しい読み込み位置（バイト）
+		int64 skip(int64 offset) override;
+
+		/// @brief データを伸長して読み込みます。
+		/// @param dst 読み込み先
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 read(void* dst, int64 size) override;
+
+		/// @brief データを伸長して読み込みます。
+		/// @param dst 読み込み先
+		/// @param pos 伸長後のデータの先頭から数えた読み込み開始位置（バイト）
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 read(void* dst, int64 pos, int64 size) override;
+
+		/// @brief データを伸長して読み込みます。
+		/// @tparam TriviallyCopyable 読み込む値の型
+		/// @param dst 読み込み先
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		bool read(TriviallyCopyable& dst);
+
+		/// @brief サポートしていません。
+		/// @return 0
+		int64 lookahead(void* dst, int64 size) const override;
+
+		/// @brief サポートしていません。
+		/// @return 0
+		int64 lookahead(void* dst, int64 pos, int64 size) const override;
+
+		/// @brief 圧縮形式を返します。
+		/// @return 圧縮形式
+		[[nodiscard]]
+		CompressionFormat format() const noexcept;
+
+	private:
+
+		class DecompressionReaderDetail;
+
+		std::shared_ptr<DecompressionReaderDetail> pImpl;
+	};
+}
+
+# include "detail/DecompressionReader.ipp"
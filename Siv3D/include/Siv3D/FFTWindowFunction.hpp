@@ -0,0 +1,32 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief FFT の前に波形に掛ける窓関数
+	enum class FFTWindowFunction : uint8
+	{
+		/// @brief 矩形窓（窓関数を掛けない）
+		Rectangular,
+
+		/// @brief ハン窓
+		Hann,
+
+		/// @brief ハミング窓
+		Hamming,
+
+		/// @brief ブラックマン窓
+		Blackman,
+	};
+}
@@ -405,6 +405,25 @@ namespace s3d
 		/// @return 事前生成に成功した場合 true, それ以外の場合は false
 		bool preload(StringView chars) const;
 
+		/// @brief 指定した文字列のためのグリフの生成をバックグラウンドで開始します。
+		/// @param chars 文字列
+		/// @remark SDF / MSDF フォントでは距離場の生成をバックグラウンドで行い、完了したグリフは次の描画時に取り込まれます。生成中のグリフを描画しようとした場合は完了を待ちます。
+		/// @remark ビットマップフォントでは `preload()` と同じです。
+		/// @return 生成の開始に成功した場合 true, それ以外の場合は false
+		bool preloadAsync(StringView chars) const;
+
+		/// @brief キャッシュされているグリフとテクスチャをファイルに保存します。
+		/// @param path 保存するファイルのパス
+		/// @remark 保存したファイルを次回の起動時に `loadGlyphCache()` で読み込むと、グリフの生成を省略できます。MSDF / SDF フォントの起動時間の短縮に有効です。
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		bool saveGlyphCache(FilePathView path) const;
+
+		/// @brief `saveGlyphCache()` で保存したグリフとテクスチャを読み込み、現在のキャッシュと置き換えます。
+		/// @param path 読み込むファイルのパス
+		/// @remark フォントファイルの内容、フェイスインデックス、サイズ、スタイル、描画方式、バッファの太さが保存時と異なる場合は読み込みません。
+		/// @return 読み込みに成功した場合 true, ファイルが存在しないか、現在のフォントと一致しない場合は false
+		bool loadGlyphCache(FilePathView path) const;
+
 		/// @brief フォントの内部でキャッシュされているテクスチャを返します。
 		/// @return フォントの内部でキャッシュされているテクスチャ
 		[[nodiscard]]
@@ -58,7 +58,7 @@ namespace s3d
 
 		static bool Load(AssetNameView name, StringView preloadText = U"");
 
-		static void LoadAsync(AssetNameView name, StringView preloadText = U"");
+		static void LoadAsync(AssetNameView name, StringView preloadText = U"", AssetLoadPriority priority = AssetLoadPriority::Normal);
 
 		/// @brief 指定したフォントアセットのロードが完了するまで待機します。
 		/// @param name フォントアセット名
@@ -13,7 +13,6 @@
 # include "Common.hpp"
 # include "Asset.hpp"
 # include "Font.hpp"
-# include "AsyncTask.hpp"
 
 namespace s3d
 {
@@ -57,9 +56,5 @@ namespace s3d
 		static bool DefaultLoad(FontAssetData& asset, const String& hint);
 
 		static void DefaultRelease(FontAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
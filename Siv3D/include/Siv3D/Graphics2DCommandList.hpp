@@ -0,0 +1,224 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "Optional.hpp"
+# include "Vertex2D.hpp"
+# include "TriangleIndex.hpp"
+# include "Mat3x2.hpp"
+# include "RectF.hpp"
+# include "BlendState.hpp"
+# include "RasterizerState.hpp"
+# include "Texture.hpp"
+# include "TextureRegion.hpp"
+# include "ColorF.hpp"
+# include "Palette.hpp"
+# include "2DShapesFwd.hpp"
+
+namespace s3d
+{
+	namespace Graphics2D
+	{
+		/// @brief 任意のスレッドで記録し、メインスレッドでまとめて描画できる 2D 描画コマンドリスト | 2D draw command list that can be recorded on any thread and drawn on the main thread
+		/// @remark 1 つのコマンドリストに同時に記録できるのは 1 つのスレッドだけです。複数のスレッドで並列に記録するには、スレッドごとにコマンドリストを用意してください。 | Only one thread may record into a command list at a time. Use one command list per thread to record in parallel.
+		/// @remark 記録された図形は `draw()` を呼んだ順に、通常の描画と同じバッチに追加されます。 | Recorded shapes are appended to the same batch as ordinary drawing, in the order `draw()` is called.
+		class CommandList
+		{
+		public:
+
+			SIV3D_NODISCARD_CXX20
+			CommandList() = default;
+
+			/// @brief 記録されたコマンドをすべて消去し、座標変換とステートを初期状態に戻します。 | Clears all recorded commands and resets the transform and states.
+			/// @remark 確保済みのメモリは再利用されます。 | Allocated memory is kept for reuse.
+			void clear() noexcept;
+
+			/// @brief 頂点と三角形のためのメモリを予約します。 | Reserves memory for vertices and triangles.
+			/// @param vertexCount 頂点数 | Number of vertices
+			/// @param triangleCount 三角形の数 | Number of triangles
+			void reserve(size_t vertexCount, size_t triangleCount);
+
+			/// @brief コマンドが記録されていないかを返します。 | Returns whether no commands are recorded.
+			/// @return コマンドが記録されていない場合 true, それ以外の場合は false | Returns true if no commands are recorded, false otherwise
+			[[nodiscard]]
+			bool isEmpty() const noexcept;
+
+			/// @brief 記録されている頂点数を返します。 | Returns the number of recorded vertices.
+			/// @return 記録されている頂点数 | Number of recorded vertices
+			[[nodiscard]]
+			size_t num_vertices() const noexcept;
+
+			/// @brief 記録されている三角形の数を返します。 | Returns the number of recorded triangles.
+			/// @return 記録されている三角形の数 | Number of recorded triangles
+			[[nodiscard]]
+			size_t num_triangles() const noexcept;
+
+			/// @brief 以降に記録する図形に適用する座標変換を設定します。 | Sets the transform applied to subsequently recorded shapes.
+			/// @param transform 座標変換 | Transform
+			/// @remark 座標変換は記録時に頂点に適用されます。`draw()` の時点で有効な `Transformer2D` は、それに加えて適用されます。 | The transform is applied to vertices while recording. `Transformer2D` active at `draw()` is applied on top of it.
+			void setTransform(const Mat3x2& transform) noexcept;
+
+			/// @brief 現在の座標変換を返します。 | Returns the current transform.
+			/// @return 現在の座標変換 | Current transform
+			[[nodiscard]]
+			const Mat3x2& getTransform() const noexcept;
+
+			/// @brief 以降に記録する図形に適用するブレンドステートを設定します。 | Sets the blend state applied to subsequently recorded shapes.
+			/// @param blendState ブレンドステート。none の場合 `draw()` の時点のブレンドステートを使います。 | Blend state. If none, the blend state at `draw()` is used.
+			void setBlendState(const Optional<BlendState>& blendState) noexcept;
+
+			/// @brief 以降に記録する図形に適用するラスタライザーステートを設定します。 | Sets the rasterizer state applied to subsequently recorded shapes.
+			/// @param rasterizerState ラスタライザーステート。none の場合 `draw()` の時点のラスタライザーステートを使います。 | Rasterizer state. If none, the rasterizer state at `draw()` is used.
+			void setRasterizerState(const Optional<RasterizerState>& rasterizerState) noexcept;
+
+			/// @brief 以降に記録する図形の並べ替えを許可するかを設定します。 | Sets whether subsequently recorded shapes may be reordered.
+			/// @param reorderable 並べ替えを許可する場合 true, それ以外の場合は false | If true, shapes may be reordered
+			/// @remark 並べ替えが許可された図形は、描画結果が変わらない範囲で、同じテクスチャとステートを使う先行の図形の直後へ移動され、ドローコールが削減されます。 | Reorderable shapes are moved next to an earlier shape with the same texture and states when this does not change the final image, which reduces draw calls.
+			/// @remark 移動先との間にある図形と領域が重なる場合は移動しません。 | A shape is not moved past any shape whose bounds overlap its own.
+			void setReorderable(bool reorderable) noexcept;
+
+			/// @brief 以降に記録する図形の並べ替えが許可されているかを返します。 | Returns whether subsequently recorded shapes may be reordered.
+			/// @return 並べ替えが許可されている場合 true, それ以外の場合は false | Returns true if shapes may be reordered, false otherwise
+			[[nodiscard]]
+			bool isReorderable() const noexcept;
+
+			/// @brief 記録されたコマンドを描画するために必要なドローコールの数の目安を返します。 | Returns the approximate number of draw calls needed to draw the recorded commands.
+			/// @return ドローコールの数の目安 | Approximate number of draw calls
+			[[nodiscard]]
+			size_t num_batches() const noexcept;
+
+			/// @brief 三角形を記録します。 | Records a triangle.
+			/// @param triangle 三角形 | Triangle
+			/// @param color 色 | Color
+			void addTriangle(const Triangle& triangle, const ColorF& color);
+
+			/// @brief 長方形を記録します。 | Records a rectangle.
+			/// @param rect 長方形 | Rectangle
+			/// @param color 色 | Color
+			void addRect(const RectF& rect, const ColorF& color);
+
+			/// @brief 長方形の枠を記録します。 | Records a rectangle frame.
+			/// @param rect 長方形 | Rectangle
+			/// @param thickness 枠の太さ | Thickness of the frame
+			/// @param color 色 | Color
+			void addRectFrame(const RectF& rect, double thickness, const ColorF& color);
+
+			/// @brief 円を記録します。 | Records a circle.
+			/// @param circle 円 | Circle
+			/// @param color 色 | Color
+			void addCircle(const Circle& circle, const ColorF& color);
+
+			/// @brief 円の枠を記録します。 | Records a circle frame.
+			/// @param circle 円 | Circle
+			/// @param thickness 枠の太さ | Thickness of the frame
+			/// @param color 色 | Color
+			void addCircleFrame(const Circle& circle, double thickness, const ColorF& color);
+
+			/// @brief 線分を記録します。 | Records a line.
+			/// @param line 線分 | Line
+			/// @param thickness 線の太さ | Thickness of the line
+			/// @param color 色 | Color
+			void addLine(const Line& line, double thickness, const ColorF& color);
+
+			/// @brief 凸四角形を記録します。 | Records a quad.
+			/// @param quad 凸四角形 | Quad
+			/// @param color 色 | Color
+			void addQuad(const Quad& quad, const ColorF& color);
+
+			/// @brief テクスチャを記録します。 | Records a texture.
+			/// @param texture テクスチャ | Texture
+			/// @param pos 左上の座標 | Top-left position
+			/// @param diffuse 乗算する色 | Diffuse color
+			void addTexture(const Texture& texture, const Vec2& pos, const ColorF& diffuse = Palette::White);
+
+			/// @brief テクスチャ領域を記録します。 | Records a texture region.
+			/// @param region テクスチャ領域 | Texture region
+			/// @param rect 描画する長方形 | Destination rectangle
+			/// @param diffuse 乗算する色 | Diffuse color
+			void addTextureRegion(const TextureRegion& region, const RectF& rect, const ColorF& diffuse = Palette::White);
+
+			/// @brief 頂点とインデックスを記録します。 | Records vertices and indices.
+			/// @param vertices 頂点配列の先頭ポインタ | Pointer to the vertices
+			/// @param vertexCount 頂点数 | Number of vertices
+			/// @param indices インデックス配列の先頭ポインタ | Pointer to the indices
+			/// @param num_triangles 三角形の数 | Number of triangles
+			/// @param texture テクスチャ。none の場合は図形として描画されます。 | Texture. If none, the vertices are drawn as shapes.
+			/// @remark 1 回のドローコールに収まらない数の三角形は、複数のドローコールに分割して記録されます。 | Triangles that do not fit in a single draw call are split across several draw calls.
+			void addVertices(const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles, const Optional<Texture>& texture = none);
+
+			/// @brief 記録されたコマンドを、記録順に現在の 2D 描画バッチに追加します。 | Appends the recorded commands to the current 2D batch in recorded order.
+			/// @remark メインスレッドから呼ぶ必要があります。 | Must be called from the main thread.
+			/// @remark 記録中のスレッドが存在しない状態で呼んでください。 | Call this only when no thread is recording into this list.
+			void draw() const;
+
+		private:
+
+			struct Segment
+			{
+				Optional<Texture> texture;
+
+				Optional<BlendState> blendState;
+
+				Optional<RasterizerState> rasterizerState;
+
+				Array<Vertex2D> vertices;
+
+				Array<Vertex2D::IndexType> indices;
+
+				// 含まれる図形の領域の和
+				RectF bounds{ 0 };
+			};
+
+			// clear() 後もメモリを再利用するため、使用中のセグメントは先頭の m_segmentCount 個
+			Array<Segment> m_segments;
+
+			size_t m_segmentCount = 0;
+
+			size_t m_vertexCount = 0;
+
+			size_t m_indexCount = 0;
+
+			Mat3x2 m_transform = Mat3x2::Identity();
+
+			float m_maxScaling = 1.0f;
+
+			bool m_hasTransform = false;
+
+			bool m_reorderable = false;
+
+			Optional<BlendState> m_blendState;
+
+			Optional<RasterizerState> m_rasterizerState;
+
+			Optional<Texture> m_texture;
+
+			// 並べ替え可能な図形を一時的に構築するバッファ
+			Segment m_scratch;
+
+			[[nodiscard]]
+			bool isCompatible(const Segment& segment) const noexcept;
+
+			[[nodiscard]]
+			Segment& newSegment();
+
+			[[nodiscard]]
+			Segment& getSegmentForAppend(Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize);
+
+			[[nodiscard]]
+			Segment& findSegmentForReorder(const RectF& bounds, size_t vertexSize, size_t indexSize);
+
+			template <class Builder>
+			void build(Builder builder);
+		};
+	}
+}
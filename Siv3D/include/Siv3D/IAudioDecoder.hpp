@@ -15,6 +15,7 @@
 # include "BinaryReader.hpp"
 # include "AudioFormat.hpp"
 # include "Wave.hpp"
+# include "IAudioDecoderStream.hpp"
 
 namespace s3d
 {
@@ -39,6 +40,12 @@ namespace s3d
 
 		[[nodiscard]]
 		virtual Wave decode(IReader& reader, FilePathView pathHint) const = 0;
+
+		/// @brief 音声データを少しずつデコードするストリームを作成します。
+		/// @param reader 音声データの IReader インタフェース。作成したストリームが所有します
+		/// @return 作成したストリーム。少しずつデコードすることに対応しない場合や、失敗した場合は nullptr
+		[[nodiscard]]
+		virtual std::unique_ptr<IAudioDecoderStream> openStream(std::unique_ptr<IReader>&& reader) const;
 	};
 }
 
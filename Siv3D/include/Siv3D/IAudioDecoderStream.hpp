@@ -0,0 +1,46 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Wave.hpp"
+
+namespace s3d
+{
+	/// @brief 音声データを先頭から少しずつデコードするストリームのインタフェース
+	/// @remark `IAudioDecoder::openStream()` によって作成されます。
+	/// @remark 1 つのストリームを複数のスレッドから同時に使うことはできません。
+	struct IAudioDecoderStream
+	{
+		virtual ~IAudioDecoderStream() = default;
+
+		/// @brief デコード後の音声のサンプリングレートを返します。
+		/// @return サンプリングレート
+		[[nodiscard]]
+		virtual uint32 sampleRate() const = 0;
+
+		/// @brief デコード後の音声の長さ（サンプル数）を返します。
+		/// @return 音声の長さ（サンプル数）。不明な場合は 0
+		[[nodiscard]]
+		virtual size_t samples() const = 0;
+
+		/// @brief 現在の位置から音声をデコードします。
+		/// @param dst デコードしたサンプルの書き込み先
+		/// @param count 最大でデコードするサンプル数
+		/// @return デコードしたサンプル数。終端に達した場合は 0
+		virtual size_t read(WaveSample* dst, size_t count) = 0;
+
+		/// @brief 次にデコードする位置を変更します。
+		/// @param posSample 新しい位置（サンプル）
+		/// @return 位置の変更に成功した場合 true, それ以外の場合は false
+		virtual bool seek(size_t posSample) = 0;
+	};
+}
@@ -25,5 +25,11 @@ namespace s3d
 		virtual bool hasEnded() = 0;
 
 		virtual void rewind() = 0;
+
+		// 再生位置の変更に対応する場合は true を返す。false の場合、先頭から読み飛ばして再生位置を変更する
+		virtual bool seekSamples([[maybe_unused]] size_t posSample)
+		{
+			return false;
+		}
 	};
 }
@@ -483,6 +483,17 @@ namespace s3d
 		[[nodiscard]]
 		Image grayscaled() &&;
 
+		/// @brief 画像の RGB 成分にアルファ値を乗算します。
+		/// @remark 各成分は (c * a + 127) / 255 になります。アルファ値は変わりません。
+		/// @return *this
+		Image& premultiplyAlpha();
+
+		[[nodiscard]]
+		Image premultipliedAlpha() const&;
+
+		[[nodiscard]]
+		Image premultipliedAlpha() &&;
+
 		/// @brief 画像をセピア画像に変換します。
 		/// @return *this
 		Image& sepia();
@@ -652,21 +663,28 @@ namespace s3d
 		[[nodiscard]]
 		Image medianBlurred(int32 apertureSize) &&;
 
-		Image& gaussianBlur(int32 size, BorderType borderType = BorderType::Reflect_101);
+		Image& gaussianBlur(int32 size, BorderType borderType = BorderType::Reflect_101, Parallel parallel = Parallel::No);
 
-		Image& gaussianBlur(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101);
+		/// @brief 画像にガウシアンぼかしを適用します。
+		/// @param horizontal 水平方向のカーネル半径
+		/// @param vertical 垂直方向のカーネル半径
+		/// @param borderType 画像の外側の扱い
+		/// @param parallel 画像を行ごとのタイルに分割して並列に処理するか
+		/// @remark 並列に処理した場合も、結果は並列に処理しない場合と完全に一致します。
+		/// @return *this
+		Image& gaussianBlur(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101, Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image gaussianBlurred(int32 size, BorderType borderType = BorderType::Reflect_101) const&;
+		Image gaussianBlurred(int32 size, BorderType borderType = BorderType::Reflect_101, Parallel parallel = Parallel::No) const&;
 
 		[[nodiscard]]
-		Image gaussianBlurred(int32 size, BorderType borderType = BorderType::Reflect_101) &&;
+		Image gaussianBlurred(int32 size, BorderType borderType = BorderType::Reflect_101, Parallel parallel = Parallel::No) &&;
 
 		[[nodiscard]]
-		Image gaussianBlurred(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101) const&;
+		Image gaussianBlurred(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101, Parallel parallel = Parallel::No) const&;
 
 		[[nodiscard]]
-		Image gaussianBlurred(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101) &&;
+		Image gaussianBlurred(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101, Parallel parallel = Parallel::No) &&;
 
 		Image& bilateralFilter(int32 d, double sigmaColor, double sigmaSpace, BorderType borderType = BorderType::Reflect_101);
 
@@ -744,11 +762,17 @@ namespace s3d
 		[[nodiscard]]
 		Image bordered(int32 top, int32 right, int32 bottom, int32 left, const Color& color = Palette::White) const;
 
+		/// @brief アフィン変換した画像を返します。
+		/// @param mat 変換行列
+		/// @param background 背景色
+		/// @param parallel 出力を行ごとのタイルに分割して並列に処理するか
+		/// @remark 並列に処理した場合も、結果は並列に処理しない場合と完全に一致します。
+		/// @return アフィン変換した画像
 		[[nodiscard]]
-		Image warpAffine(const Mat3x2& mat, const Color& background = Color{ 0, 0 }) const;
+		Image warpAffine(const Mat3x2& mat, const Color& background = Color{ 0, 0 }, Parallel parallel = Parallel::No) const;
 
 		[[nodiscard]]
-		Image rotated(double angle, const Color& background = Color{ 0, 0 }) const;
+		Image rotated(double angle, const Color& background = Color{ 0, 0 }, Parallel parallel = Parallel::No) const;
 
 		[[nodiscard]]
 		Image warpPerspective(const Quad& quad, const Color& background = Color{ 0, 0 }) const;
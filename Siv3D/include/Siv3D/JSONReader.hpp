@@ -0,0 +1,220 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <string_view>
+# include "Common.hpp"
+# include "IReader.hpp"
+# include "String.hpp"
+# include "Optional.hpp"
+# include "Error.hpp"
+# include "JSON.hpp"
+
+namespace s3d
+{
+	/// @brief JSONReader が読み取ったトークンの種類
+	enum class JSONEvent : uint8
+	{
+		/// @brief まだ読み取っていない、またはドキュメントの終端に達した
+		None,
+
+		/// @brief `{`
+		StartObject,
+
+		/// @brief `}`
+		EndObject,
+
+		/// @brief `[`
+		StartArray,
+
+		/// @brief `]`
+		EndArray,
+
+		/// @brief オブジェクトのキー
+		Key,
+
+		/// @brief 文字列
+		String,
+
+		/// @brief 数値
+		Number,
+
+		/// @brief true または false
+		Bool,
+
+		/// @brief null
+		Null,
+
+		/// @brief 構文エラーや読み込みエラー
+		Error,
+	};
+
+	/// @brief JSON を先頭からトークンごとに読み取るプルパーサ
+	/// @remark ドキュメント全体をメモリに読み込まず、木構造も作らないため、大きな JSON ファイルを一定のメモリ使用量で処理できます。
+	/// @remark 入力は UTF-8 でなければなりません。
+	class JSONReader
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		JSONReader();
+
+		/// @brief JSON ファイルを開きます。
+		/// @param path ファイルパス
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(FilePathView path);
+
+		/// @brief Reader から JSON を読み込みます。
+		/// @tparam Reader Reader の型
+		/// @param reader JSON の読み込み元
+		template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader> && !std::is_lvalue_reference_v<Reader>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(Reader&& reader);
+
+		/// @brief Reader から JSON を読み込みます。
+		/// @param reader JSON の読み込み元
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(std::unique_ptr<IReader>&& reader);
+
+		/// @brief JSON ファイルを開きます。
+		/// @param path ファイルパス
+		/// @return ファイルを開くのに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path);
+
+		/// @brief Reader から JSON を読み込みます。
+		/// @tparam Reader Reader の型
+		/// @param reader JSON の読み込み元
+		/// @return 読み込みの開始に成功した場合 true, それ以外の場合は false
+		template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader> && !std::is_lvalue_reference_v<Reader>>* = nullptr>
+		bool open(Reader&& reader);
+
+		/// @brief Reader から JSON を読み込みます。
+		/// @param reader JSON の読み込み元
+		/// @return 読み込みの開始に成功した場合 true, それ以外の場合は false
+		bool open(std::unique_ptr<IReader>&& reader);
+
+		/// @brief 読み込み元を閉じます。
+		void close();
+
+		/// @brief 読み込み元が開いているかを返します。
+		/// @return 読み込み元が開いている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief 読み込み元が開いているかを返します。
+		/// @return 読み込み元が開いている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 次のトークンを読み取ります。
+		/// @return 読み取ったトークンの種類。ドキュメントの終端に達した場合は `JSONEvent::None`, エラーの場合は `JSONEvent::Error`
+		JSONEvent next();
+
+		/// @brief 最後に読み取ったトークンの種類を返します。
+		/// @return 最後に読み取ったトークンの種類
+		[[nodiscard]]
+		JSONEvent event() const noexcept;
+
+		/// @brief 現在のオブジェクトや配列のネストの深さを返します。
+		/// @return ネストの深さ。`JSONEvent::StartObject` の直後は、そのオブジェクトを含めた深さ
+		[[nodiscard]]
+		size_t depth() const noexcept;
+
+		/// @brief キー・文字列・数値のトークンを、エスケープを展開した UTF-8 文字列で返します。
+		/// @return トークンの UTF-8 文字列。それ以外のトークンの場合は空の文字列
+		/// @remark 次に `next()` を呼ぶまで有効です。String を作らないため、キーの比較に適しています。
+		[[nodiscard]]
+		std::string_view getRaw() const noexcept;
+
+		/// @brief 最後に読み取ったトークンがキーで、かつ指定した文字列と等しいかを返します。
+		/// @param key 比較する UTF-8 文字列
+		/// @return キーが等しい場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isKey(std::string_view key) const noexcept;
+
+		/// @brief 最後に読み取った値を返します。
+		/// @tparam Type 値の型
+		/// @throw Error 値の型が異なる場合
+		/// @return 値
+		template <class Type>
+		[[nodiscard]]
+		Type get() const;
+
+		/// @brief 最後に読み取った値を返します。失敗した場合は defaultValue を返します。
+		/// @tparam Type 値の型
+		/// @tparam U デフォルトの値の型
+		/// @param defaultValue デフォルトの値
+		/// @return 値。失敗した場合はデフォルトの値
+		template <class Type, class U>
+		[[nodiscard]]
+		Type getOr(U&& defaultValue) const;
+
+		/// @brief 最後に読み取った値を返します。失敗した場合は none を返します。
+		/// @tparam Type 値の型
+		/// @return 値。失敗した場合は none
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt() const;
+
+		/// @brief 最後に読み取った値を、オブジェクトや配列の場合はその終端まで読み飛ばします。
+		/// @return 読み飛ばすのに成功した場合 true, エラーの場合は false
+		/// @remark 最後に読み取ったトークンがキーの場合は、そのキーに対応する値を読み飛ばします。
+		bool skip();
+
+		/// @brief 最後に読み取った値を、オブジェクトや配列の場合はその終端まで読み、JSON オブジェクトとして返します。
+		/// @return 読み取った JSON オブジェクト。エラーの場合は無効な JSON オブジェクト
+		/// @remark 最後に読み取ったトークンがキーの場合は、そのキーに対応する値を読みます。
+		/// @remark 巨大な配列の各要素を、1 つずつ JSON オブジェクトとして処理する場合に便利です。
+		[[nodiscard]]
+		JSON readJSON();
+
+		/// @brief エラーの内容を返します。
+		/// @return エラーの内容。エラーが発生していない場合は空の文字列
+		[[nodiscard]]
+		const String& getErrorMessage() const noexcept;
+
+		/// @brief これまでに読み取ったバイト数を返します。
+		/// @return これまでに読み取ったバイト数
+		[[nodiscard]]
+		int64 getPos() const noexcept;
+
+	private:
+
+		class JSONReaderDetail;
+
+		std::shared_ptr<JSONReaderDetail> pImpl;
+
+		SIV3D_CONCEPT_INTEGRAL
+		Optional<Int> getOpt_() const;
+
+		SIV3D_CONCEPT_FLOATING_POINT
+		Optional<Float> getOpt_() const;
+
+		template <class Type, std::enable_if_t<!std::is_arithmetic_v<Type>>* = nullptr>
+		Optional<Type> getOpt_() const;
+
+		[[nodiscard]]
+		Optional<String> getOptString() const;
+
+		[[nodiscard]]
+		Optional<int64> getOptInt64() const;
+
+		[[nodiscard]]
+		Optional<double> getOptDouble() const;
+
+		[[nodiscard]]
+		Optional<bool> getOptBool() const;
+	};
+}
+
+# include "detail/JSONReader.ipp"
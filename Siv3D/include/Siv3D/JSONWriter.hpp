@@ -0,0 +1,163 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "IWriter.hpp"
+# include "StringView.hpp"
+# include "Concepts.hpp"
+# include "JSON.hpp"
+
+namespace s3d
+{
+	/// @brief JSON を先頭から順に書き出すクラス
+	/// @remark 木構造を作らず、一定の大きさのバッファを通して書き出すため、大きな JSON を一定のメモリ使用量で書き出せます。
+	/// @remark 出力は UTF-8 で、余分な空白を含みません。
+	class JSONWriter
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		JSONWriter();
+
+		/// @brief ファイルを開き、JSON を書き出します。
+		/// @param path ファイルパス
+		SIV3D_NODISCARD_CXX20
+		explicit JSONWriter(FilePathView path);
+
+		/// @brief Writer に JSON を書き出します。
+		/// @tparam Writer Writer の型
+		/// @param writer JSON の書き込み先
+		template <class Writer, std::enable_if_t<std::is_base_of_v<IWriter, Writer> && !std::is_lvalue_reference_v<Writer>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		explicit JSONWriter(Writer&& writer);
+
+		/// @brief Writer に JSON を書き出します。
+		/// @param writer JSON の書き込み先
+		SIV3D_NODISCARD_CXX20
+		explicit JSONWriter(std::unique_ptr<IWriter>&& writer);
+
+		/// @brief ファイルを開き、JSON を書き出します。
+		/// @param path ファイルパス
+		/// @return ファイルを開くのに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path);
+
+		/// @brief Writer に JSON を書き出します。
+		/// @tparam Writer Writer の型
+		/// @param writer JSON の書き込み先
+		/// @return 書き出しの開始に成功した場合 true, それ以外の場合は false
+		template <class Writer, std::enable_if_t<std::is_base_of_v<IWriter, Writer> && !std::is_lvalue_reference_v<Writer>>* = nullptr>
+		bool open(Writer&& writer);
+
+		/// @brief Writer に JSON を書き出します。
+		/// @param writer JSON の書き込み先
+		/// @return 書き出しの開始に成功した場合 true, それ以外の場合は false
+		bool open(std::unique_ptr<IWriter>&& writer);
+
+		/// @brief バッファに残っているデータを書き出し、書き込み先を閉じます。
+		/// @return 書き出しに成功し、すべてのオブジェクトと配列が閉じられていた場合 true, それ以外の場合は false
+		bool close();
+
+		/// @brief 書き込み先が開いているかを返します。
+		/// @return 書き込み先が開いている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief 書き込み先が開いているかを返します。
+		/// @return 書き込み先が開いている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief バッファに残っているデータを書き込み先に書き出します。
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		bool flush();
+
+		/// @brief `{` を書き出します。
+		void startObject();
+
+		/// @brief `}` を書き出します。
+		void endObject();
+
+		/// @brief `[` を書き出します。
+		void startArray();
+
+		/// @brief `]` を書き出します。
+		void endArray();
+
+		/// @brief オブジェクトのキーを書き出します。
+		/// @param key キー
+		void key(StringView key);
+
+		/// @brief null を書き出します。
+		void write(std::nullptr_t);
+
+		/// @brief 真偽値を書き出します。
+		/// @param value 値
+		void write(bool value);
+
+		/// @brief 整数を書き出します。
+		/// @tparam Int 整数型
+		/// @param value 値
+		SIV3D_CONCEPT_INTEGRAL
+		void write(Int value);
+
+		/// @brief 浮動小数点数を書き出します。
+		/// @tparam Float 浮動小数点数型
+		/// @param value 値
+		/// @remark 非数と無限大は null として書き出します。
+		SIV3D_CONCEPT_FLOATING_POINT
+		void write(Float value);
+
+		/// @brief 文字列を書き出します。
+		/// @param value 値
+		void write(StringView value);
+
+		/// @brief 文字列を書き出します。
+		/// @param value 値
+		void write(const String& value);
+
+		/// @brief 文字列を書き出します。
+		/// @param value 値
+		void write(const char32* value);
+
+		/// @brief JSON オブジェクトを書き出します。
+		/// @param value 値
+		void write(const JSON& value);
+
+		/// @brief オブジェクトのキーと値を書き出します。
+		/// @tparam Type 値の型
+		/// @param key キー
+		/// @param value 値
+		template <class Type>
+		void write(StringView key, const Type& value);
+
+		/// @brief これまでに書き出したバイト数を返します。
+		/// @return これまでに書き出したバイト数（バッファに残っているものを含む）
+		[[nodiscard]]
+		int64 size() const noexcept;
+
+	private:
+
+		class JSONWriterDetail;
+
+		std::shared_ptr<JSONWriterDetail> pImpl;
+
+		void writeInt64(int64 value);
+
+		void writeUint64(uint64 value);
+
+		void writeDouble(double value);
+	};
+}
+
+# include "detail/JSONWriter.ipp"
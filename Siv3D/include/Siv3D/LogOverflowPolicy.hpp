@@ -0,0 +1,26 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief 非同期ログのバッファが一杯になったときの動作
+	enum class LogOverflowPolicy : uint8
+	{
+		/// @brief 書き込もうとしたログを捨てます。捨てたログの数は後で警告として出力されます。
+		Drop,
+
+		/// @brief バッファに空きができるまで、書き込むスレッドを待機させます。
+		Block,
+	};
+}
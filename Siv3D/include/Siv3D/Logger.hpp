@@ -14,6 +14,7 @@
 # include "Common.hpp"
 # include "Format.hpp"
 # include "Formatter.hpp"
+# include "LogOverflowPolicy.hpp"
 
 namespace s3d
 {
@@ -105,6 +106,22 @@ namespace s3d
 
 			/// @brief ログ出力を有効化します
 			void enable() const;
+
+			/// @brief ログの出力を、バックグラウンドのスレッドで行うかを設定します。
+			/// @param enabled バックグラウンドのスレッドで出力する場合 true, 呼び出したスレッドで出力する場合 false
+			/// @param bufferSize スレッドごとのバッファのサイズ（バイト）
+			/// @param overflow バッファが一杯になったときの動作
+			/// @remark 有効な場合、ログを書き込むスレッドでは時刻の取得とバッファへのコピーだけを行います。
+			/// @remark Web 版（スレッドを使わない場合）では効果がありません。
+			void setAsync(bool enabled, size_t bufferSize = (256 * 1024), LogOverflowPolicy overflow = LogOverflowPolicy::Drop) const;
+
+			/// @brief 書き込まれたログがすべて出力されるまで待機します。
+			void flush() const;
+
+			/// @brief ログの出力先をファイルに変更します。
+			/// @param path ファイルパス。空の場合は標準の出力先に戻します
+			/// @return 出力先の変更に成功した場合 true, それ以外の場合は false
+			bool setOutputFile(FilePathView path) const;
 		};
 	}
 
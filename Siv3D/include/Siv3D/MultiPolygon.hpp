@@ -10,13 +10,67 @@
 //-----------------------------------------------
 
 # pragma once
+# include <atomic>
 # include "Common.hpp"
 # include "Array.hpp"
 # include "Polygon.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		class MultiPolygonSpatialIndex;
+
+		/// @brief MultiPolygon の空間インデックスを、必要になったときに作成して保持するクラス
+		/// @remark 複数のスレッドから同時に `get()` を呼べます。MultiPolygon を変更する操作とは同時に呼べません。
+		class MultiPolygonSpatialIndexCache
+		{
+		public:
+
+			MultiPolygonSpatialIndexCache() = default;
+
+			// コピーした MultiPolygon では、必要になったときに作り直す
+			MultiPolygonSpatialIndexCache(const MultiPolygonSpatialIndexCache&) noexcept;
+
+			MultiPolygonSpatialIndexCache& operator =(const MultiPolygonSpatialIndexCache& other) noexcept;
+
+			~MultiPolygonSpatialIndexCache();
+
+			/// @brief 空間インデックスを返します。
+			/// @return 空間インデックス。多角形の数が少ない場合や、要素への変更可能な参照を返した後でインデックスを使わない場合は nullptr
+			[[nodiscard]]
+			const MultiPolygonSpatialIndex* get(const Array<Polygon>& polygons) const;
+
+			void reset() noexcept;
+
+			/// @brief 要素への変更可能な参照を返したことを記録し、空間インデックスを破棄します。
+			/// @remark 参照を通して要素が変更されたかは分からないので、`resetMutableAccess()` が呼ばれるまでインデックスを使いません。
+			void markMutableAccess() noexcept;
+
+			/// @brief すべての要素が置き換えられ、以前に返した参照が無効になったことを記録し、空間インデックスを破棄します。
+			void resetMutableAccess() noexcept;
+
+			/// @brief ムーブされた MultiPolygon の状態を引き継ぎます。
+			/// @remark ムーブ元の要素への参照は、ムーブ先の要素を指すようになります。
+			void moveFrom(MultiPolygonSpatialIndexCache& other) noexcept;
+
+			void swap(MultiPolygonSpatialIndexCache& other) noexcept;
+
+		private:
+
+			mutable std::atomic<MultiPolygonSpatialIndex*> m_index{ nullptr };
+
+			// 要素への変更可能な参照を返したか
+			bool m_mutableAccess = false;
+		};
+	}
+
 	/// @brief Polygon の集合
+	/// @remark 多角形の数が多い場合、交差判定には空間インデックスを使います。
+	/// 非 const の `operator[]`, `at()`, `begin()`, `front()`, `data()`, `insert()` などで要素への変更可能な参照やイテレータを取得すると、
+	/// それを通して要素が変更されても検出できないため、以降は空間インデックスを使わずにすべての多角形を調べます。
+	/// `clear()`, `assign()`, 代入ですべての要素を置き換えると、再び空間インデックスを使います。
+	/// 要素を読むだけの場合は `asArray()` や const な参照を通すと、空間インデックスを使い続けられます。
 	class MultiPolygon
 	{
 	public:
@@ -484,9 +538,15 @@ namespace s3d
 
 		void drawTransformed(double s, double c, const Vec2& pos, const ColorF& color = Palette::White) const;
 
+		[[nodiscard]]
+		const detail::MultiPolygonSpatialIndex* _spatialIndex() const;
+
 	private:
 
 		base_type m_data;
+
+		// 変更する操作では破棄する。要素への変更可能な参照を返した後は使わない
+		detail::MultiPolygonSpatialIndexCache m_spatialIndex;
 	};
 }
 
@@ -18,6 +18,7 @@
 namespace s3d
 {
 	/// @brief ナビメッシュ
+	/// @remark `query()`, `queryBatch()` は複数のスレッドから同時に呼び出せます。`build()`, `rebuildTiles()` とは同時に呼び出せません。
 	class NavMesh
 	{
 	public:
@@ -126,6 +127,51 @@ namespace s3d
 		/// @return ナビメッシュの構築に成功した場合 true, それ以外の場合は false
 		bool build(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config = {});
 
+		/// @brief 地形データを差し替えて、地形が変わった範囲にかかるタイルだけを再構築します。
+		/// @param polygon 新しい地形データ
+		/// @param region 地形が変わった範囲
+		/// @return 再構築に成功した場合 true, それ以外の場合は false
+		/// @remark `NavMeshConfig::tileSize` を 0 より大きくして構築したナビメッシュのみ、一部のタイルだけを再構築します。それ以外の場合はすべてを再構築します。
+		/// @remark ナビメッシュの水平方向の範囲は、最初に構築したときの地形で決まります。その外側の地形は無視されます。
+		bool rebuildTiles(const Polygon& polygon, const RectF& region);
+
+		/// @brief 地形データを差し替えて、地形が変わった範囲にかかるタイルだけを再構築します。
+		/// @param polygon 新しい地形データ
+		/// @param areaIDs 各三角形のエリア ID
+		/// @param region 地形が変わった範囲
+		/// @return 再構築に成功した場合 true, それ以外の場合は false
+		bool rebuildTiles(const Polygon& polygon, const Array<uint8>& areaIDs, const RectF& region);
+
+		/// @brief 地形データを差し替えて、地形が変わった範囲にかかるタイルだけを再構築します。
+		/// @param vertices 新しい地形データの頂点配列
+		/// @param indices 新しい地形データのインデックス配列
+		/// @param region 地形が変わった範囲
+		/// @return 再構築に成功した場合 true, それ以外の場合は false
+		bool rebuildTiles(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const RectF& region);
+
+		/// @brief 地形データを差し替えて、地形が変わった範囲にかかるタイルだけを再構築します。
+		/// @param vertices 新しい地形データの頂点配列
+		/// @param indices 新しい地形データのインデックス配列
+		/// @param areaIDs 各三角形のエリア ID
+		/// @param region 地形が変わった範囲
+		/// @return 再構築に成功した場合 true, それ以外の場合は false
+		bool rebuildTiles(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& region);
+
+		/// @brief 地形データを差し替えて、地形が変わった範囲にかかるタイルだけを再構築します。
+		/// @param vertices 新しい地形データの頂点配列
+		/// @param indices 新しい地形データのインデックス配列
+		/// @param regionXZ 地形が変わった範囲の XZ 平面上の矩形
+		/// @return 再構築に成功した場合 true, それ以外の場合は false
+		bool rebuildTiles(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const RectF& regionXZ);
+
+		/// @brief 地形データを差し替えて、地形が変わった範囲にかかるタイルだけを再構築します。
+		/// @param vertices 新しい地形データの頂点配列
+		/// @param indices 新しい地形データのインデックス配列
+		/// @param areaIDs 各三角形のエリア ID
+		/// @param regionXZ 地形が変わった範囲の XZ 平面上の矩形
+		/// @return 再構築に成功した場合 true, それ以外の場合は false
+		bool rebuildTiles(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& regionXZ);
+
 		/// @brief 目的地もしくは目的地の近くまで到達できるナビメッシュ上の経路を計算します。
 		/// @param start 出発地点の座標
 		/// @param end 目的地の座標
@@ -156,6 +202,34 @@ namespace s3d
 		/// @param areaCosts エリアのコスト
 		void query(const Vec3& start, const Vec3& end, Array<Vec3>& dst, const Array<std::pair<int32, double>>& areaCosts = {}) const;
 
+		/// @brief 複数の経路をまとめて計算します。エンジンのスレッドプールを使って並列に計算します。
+		/// @param queries 出発地点と目的地の座標の組の配列
+		/// @param areaCosts エリアのコスト
+		/// @return 各組のナビメッシュ上の経路
+		/// @remark 結果は各組について `query()` を呼んだ場合と同じです。
+		[[nodiscard]]
+		Array<Array<Vec2>> queryBatch(const Array<std::pair<Vec2, Vec2>>& queries, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
+		/// @brief 複数の経路をまとめて計算します。エンジンのスレッドプールを使って並列に計算します。
+		/// @param queries 出発地点と目的地の座標の組の配列
+		/// @param dst 各組の経路の格納先
+		/// @param areaCosts エリアのコスト
+		void queryBatch(const Array<std::pair<Vec2, Vec2>>& queries, Array<Array<Vec2>>& dst, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
+		/// @brief 複数の経路をまとめて計算します。エンジンのスレッドプールを使って並列に計算します。
+		/// @param queries 出発地点と目的地の座標の組の配列
+		/// @param areaCosts エリアのコスト
+		/// @return 各組のナビメッシュ上の経路
+		/// @remark 結果は各組について `query()` を呼んだ場合と同じです。
+		[[nodiscard]]
+		Array<Array<Vec3>> queryBatch(const Array<std::pair<Vec3, Vec3>>& queries, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
+		/// @brief 複数の経路をまとめて計算します。エンジンのスレッドプールを使って並列に計算します。
+		/// @param queries 出発地点と目的地の座標の組の配列
+		/// @param dst 各組の経路の格納先
+		/// @param areaCosts エリアのコスト
+		void queryBatch(const Array<std::pair<Vec3, Vec3>>& queries, Array<Array<Vec3>>& dst, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
 	private:
 
 		class NavMeshDetail;
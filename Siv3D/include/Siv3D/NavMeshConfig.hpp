@@ -31,5 +31,9 @@ namespace s3d
 		/// @brief エージェントの半径
 		/// @remark これより狭い経路を通過できません
 		double agentRadius = 0.25;
+
+		/// @brief タイルの一辺のセル数
+		/// @remark 0 より大きい場合、ナビメッシュをタイルに分けて構築し、`NavMesh::rebuildTiles()` で地形が変わった範囲のタイルだけを再構築できるようにします。
+		int32 tileSize = 0;
 	};
 }
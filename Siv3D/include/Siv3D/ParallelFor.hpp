@@ -0,0 +1,50 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# ifndef SIV3D_NO_CONCURRENT_API
+
+# include <type_traits>
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief [beginIndex, endIndex) の各インデックスについて、エンジンのスレッドプールを使って関数を並列に実行します。 | Invokes the function for each index in [beginIndex, endIndex) in parallel using the engine's thread pool.
+	/// @tparam Fty 関数の型 | Function type
+	/// @param beginIndex 開始インデックス | Begin index
+	/// @param endIndex 終了インデックス（この値を含まない） | End index (exclusive)
+	/// @param f 各インデックスに対して呼ばれる関数 `f(index)` | Function called for each index `f(index)`
+	/// @param grainSize 1 回に取り出すインデックスの数の目安。0 の場合は自動 | Number of indices claimed at a time. 0 for automatic
+	/// @remark 呼び出し元のスレッドも処理に参加し、すべての処理が終わるまで戻りません。 | The calling thread participates and the function returns after all indices are processed.
+	/// @remark 関数が例外を送出した場合、残りの処理は打ち切られ、最初の例外が呼び出し元で再送出されます。 | If the function throws, the remaining work is cancelled and the first exception is rethrown to the caller.
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t>>* = nullptr>
+	void ParallelFor(size_t beginIndex, size_t endIndex, Fty f, size_t grainSize = 0);
+
+	/// @brief [beginIndex, endIndex) を部分範囲に分割し、エンジンのスレッドプールを使って関数を並列に実行します。 | Splits [beginIndex, endIndex) into sub-ranges and invokes the function for each of them in parallel using the engine's thread pool.
+	/// @tparam Fty 関数の型 | Function type
+	/// @param beginIndex 開始インデックス | Begin index
+	/// @param endIndex 終了インデックス（この値を含まない） | End index (exclusive)
+	/// @param f 各部分範囲に対して呼ばれる関数 `f(first, last)` | Function called for each sub-range `f(first, last)`
+	/// @param grainSize 部分範囲の大きさの目安。0 の場合は自動 | Size of each sub-range. 0 for automatic
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t, size_t>>* = nullptr>
+	void ParallelFor(size_t beginIndex, size_t endIndex, Fty f, size_t grainSize = 0);
+
+	namespace detail
+	{
+		using ParallelForRangeFunction = void(*)(void*, size_t, size_t);
+
+		void ParallelForImpl(size_t beginIndex, size_t endIndex, size_t grainSize, ParallelForRangeFunction f, void* context);
+	}
+}
+
+# include "detail/ParallelFor.ipp"
+
+# endif // SIV3D_NO_CONCURRENT_API
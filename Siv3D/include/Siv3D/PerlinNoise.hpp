@@ -16,9 +16,16 @@
 # include "PointVector.hpp"
 # include "Random.hpp"
 # include "Noise.hpp"
+# include "2DShapesFwd.hpp"
+# include "PredefinedYesNo.hpp"
 
 namespace s3d
 {
+	class Image;
+
+	template <class Type, class Allocator>
+	class Grid;
+
 	/// @brief Perlin Noise 生成器
 	/// @tparam Float 出力結果の型
 	template <class Float>
@@ -141,6 +148,28 @@ namespace s3d
 		value_type normalizedOctave3D0_1(Vector3D<value_type> xyz, int32 octaves, value_type persistence = value_type(0.5)) const noexcept;
 
 
+		/// @brief 指定した範囲の 2D ノイズをまとめて計算し、Grid に格納します。
+		/// @param dst 結果を格納する Grid。大きさは region.size に変更されます
+		/// @param region 計算する範囲。dst[y][x] には normalizedOctave2D0_1((region.x + x) * frequency, (region.y + y) * frequency, octaves, persistence) と（丸め誤差を除いて）同じ値が格納されます
+		/// @param frequency 周波数
+		/// @param octaves オクターブ数
+		/// @param persistence 持続度
+		/// @param parallel 行ごとに分割して並列に計算するか
+		/// @remark 行ごとにまとめて計算するため、サンプルごとに normalizedOctave2D0_1() を呼ぶより高速です。
+		/// @remark PerlinNoiseF と PerlinNoise でのみ利用できます。
+		void fill(Grid<value_type, std::allocator<value_type>>& dst, const Rect& region, value_type frequency, int32 octaves, value_type persistence = value_type(0.5), Parallel parallel = Parallel::No) const;
+
+		/// @brief 指定した範囲の 2D ノイズをまとめて計算し、明るさとして Image に格納します。
+		/// @param dst 結果を格納する Image。大きさは region.size に変更されます
+		/// @param region 計算する範囲。各ピクセルの明るさは fill(Grid&, ...) で得られる値を 0-255 に変換したものです
+		/// @param frequency 周波数
+		/// @param octaves オクターブ数
+		/// @param persistence 持続度
+		/// @param parallel 行ごとに分割して並列に計算するか
+		/// @remark PerlinNoiseF と PerlinNoise でのみ利用できます。
+		void fill(Image& dst, const Rect& region, value_type frequency, int32 octaves, value_type persistence = value_type(0.5), Parallel parallel = Parallel::No) const;
+
+
 		[[nodiscard]]
 		constexpr const state_type& serialize() const noexcept;
 
@@ -155,6 +184,15 @@ namespace s3d
 		static constexpr Float Lerp(Float a, Float b, Float t) noexcept;
 
 		static constexpr Float Grad(uint8 hash, Float x, Float y, Float z) noexcept;
+
+		// 行をこの数のサンプルごとに分けて計算する
+		static constexpr size_t RowBlockSize = 32;
+
+		// y が一定の 1 行分のノイズに amplitude を掛けて dst に加算する
+		void addRow2D(value_type* dst, size_t count, int32 beginX, value_type frequency, value_type scale, value_type y, value_type amplitude) const noexcept;
+
+		// 1 行分の normalizedOctave2D0_1() を計算する
+		void fillRow2D(value_type* dst, size_t count, int32 beginX, int32 y, value_type frequency, int32 octaves, value_type persistence) const noexcept;
 	};
 
 	using PerlinNoiseF	= BasicPerlinNoise<float>;
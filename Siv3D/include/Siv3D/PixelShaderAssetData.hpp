@@ -14,7 +14,6 @@
 # include "Asset.hpp"
 # include "ShaderCommon.hpp"
 # include "PixelShader.hpp"
-# include "AsyncTask.hpp"
 
 namespace s3d
 {
@@ -67,9 +66,5 @@ namespace s3d
 		static bool DefaultLoad(PixelShaderAssetData& asset, const String& hint);
 
 		static void DefaultRelease(PixelShaderAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
@@ -121,4 +121,7 @@ namespace s3d
 
 	/// @brief リガチャ（合字）を使う
 	using Ligature = YesNo<struct Ligature_tag>;
+
+	/// @brief 並列に処理する
+	using Parallel = YesNo<struct Parallel_tag>;
 }
@@ -0,0 +1,112 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "IAudioStream.hpp"
+# include "IAudioDecoderStream.hpp"
+# include "Duration.hpp"
+
+namespace s3d
+{
+	class PrefetchAudioStreamDetail;
+
+	/// @brief 音声データをバックグラウンドのスレッドで先読みしてデコードしながら再生するオーディオストリーム
+	/// @remark デコード済みのサンプルを一定の長さのリングバッファに保持するため、長い音声も一定のメモリ使用量で再生できます。
+	/// @remark `Audio{ pStream, Arg::sampleRate = pStream->sampleRate() }` のように、サンプリングレートとともに Audio に渡して使います。
+	class PrefetchAudioStream : public IAudioStream
+	{
+	public:
+
+		/// @brief 先読みしておく長さのデフォルト値
+		static constexpr Duration DefaultBufferLength = SecondsF{ 2.0 };
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		PrefetchAudioStream();
+
+		/// @brief ストリームから音声の先読みを開始します。
+		/// @param stream 音声データのストリーム
+		/// @param bufferLength 先読みしておく長さ
+		SIV3D_NODISCARD_CXX20
+		explicit PrefetchAudioStream(std::unique_ptr<IAudioDecoderStream>&& stream, const Duration& bufferLength = DefaultBufferLength);
+
+		~PrefetchAudioStream() override;
+
+		/// @brief ストリームが開かれているかを返します。
+		/// @return ストリームが開かれている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief ストリームが開かれているかを返します。
+		/// @return ストリームが開かれている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 音声のサンプリングレートを返します。
+		/// @return サンプリングレート
+		[[nodiscard]]
+		uint32 sampleRate() const noexcept;
+
+		/// @brief 音声の長さ（サンプル数）を返します。
+		/// @return 音声の長さ（サンプル数）。不明な場合は 0
+		[[nodiscard]]
+		size_t samples() const noexcept;
+
+		/// @brief ループ再生するかを設定します。
+		/// @param loop ループ再生する場合 true, それ以外の場合は false
+		/// @remark ループ区間の終端はストリームの終端です。
+		void setLoop(bool loop);
+
+		/// @brief ループ再生するかを返します。
+		/// @return ループ再生する場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isLoop() const noexcept;
+
+		/// @brief ループ区間の始まりを設定します。
+		/// @param loopBegin ループ区間の始まり（サンプル）
+		void setLoopBegin(uint64 loopBegin);
+
+		/// @brief 再生位置を返します。
+		/// @return 再生位置（サンプル）
+		[[nodiscard]]
+		uint64 posSample() const noexcept;
+
+		/// @brief ループした回数を返します。
+		/// @return ループした回数
+		[[nodiscard]]
+		size_t loopCount() const noexcept;
+
+		/// @brief 先読みが済んでいるサンプル数を返します。
+		/// @return 先読みが済んでいるサンプル数
+		[[nodiscard]]
+		size_t bufferedSamples() const noexcept;
+
+		/// @brief デコードが再生に間に合わず、無音を出力した回数を返します。
+		/// @return デコードが再生に間に合わなかった回数
+		[[nodiscard]]
+		size_t underrunCount() const noexcept;
+
+		void getAudio(float* left, float* right, size_t samplesToWrite) override;
+
+		[[nodiscard]]
+		bool hasEnded() override;
+
+		void rewind() override;
+
+		bool seekSamples(size_t posSample) override;
+
+	private:
+
+		std::shared_ptr<PrefetchAudioStreamDetail> pImpl;
+	};
+}
@@ -12,6 +12,9 @@
 # pragma once
 # include "Common.hpp"
 # include "ProfilerStat.hpp"
+# include "ProfilerZone.hpp"
+# include "StringView.hpp"
+# include "2DShapesFwd.hpp"
 
 namespace s3d
 {
@@ -29,5 +32,26 @@ namespace s3d
 
 		[[nodiscard]]
 		const ProfilerStat& GetStat();
+
+		/// @brief `SIV3D_PROFILE_ZONE` によるゾーンの記録の ON / OFF を設定します。
+		/// @param enabled 記録を有効にするか
+		/// @remark 記録はスレッドごとの固定長のリングバッファに行われ、古いものから上書きされます。
+		void EnableZoneRecording(bool enabled);
+
+		/// @brief ゾーンの記録が有効であるかを返します。
+		/// @return ゾーンの記録が有効である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsZoneRecordingEnabled() noexcept;
+
+		/// @brief 直近のフレームで記録されたゾーンを Chrome のトレース形式 (JSON) で保存します。
+		/// @param path 保存するファイルのパス
+		/// @param frames 保存するフレーム数
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		/// @remark 保存したファイルは chrome://tracing や Perfetto で開くことができます。
+		bool ExportChromeTrace(FilePathView path, size_t frames = 60);
+
+		/// @brief 直前のフレームで記録されたゾーンを、スレッドごとのフレームグラフとして描画します。
+		/// @param rect 描画する領域
+		void DrawZoneTimeline(const RectF& rect);
 	}
 }
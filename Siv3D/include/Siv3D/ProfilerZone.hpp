@@ -0,0 +1,56 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief プロファイラのゾーン。生存期間の処理時間を記録します。 | Profiler zone that records the time spent during its lifetime.
+	/// @remark `Profiler::EnableZoneRecording(true)` が呼ばれていない間は何も記録しません。 | Nothing is recorded unless `Profiler::EnableZoneRecording(true)` has been called.
+	/// @remark ゾーンは入れ子にでき、スレッドごとに記録されます。 | Zones can be nested and are recorded per thread.
+	class ProfilerZone
+	{
+	public:
+
+		/// @brief ゾーンを開始します。 | Begins a zone.
+		/// @param name ゾーンの名前。プログラムの終了まで有効な文字列リテラルである必要があります。 | Name of the zone. Must be a string literal that lives until the program ends.
+		SIV3D_NODISCARD_CXX20
+		explicit ProfilerZone(const char32* name) noexcept;
+
+		/// @brief ゾーンを終了し、記録します。 | Ends the zone and records it.
+		~ProfilerZone();
+
+		ProfilerZone(const ProfilerZone&) = delete;
+
+		ProfilerZone& operator =(const ProfilerZone&) = delete;
+
+	private:
+
+		const char32* m_name = nullptr;
+
+		uint64 m_beginNanosec = 0;
+	};
+}
+
+# define SIV3D_PROFILE_ZONE_CONCAT_IMPL(a, b) a##b
+# define SIV3D_PROFILE_ZONE_CONCAT(a, b) SIV3D_PROFILE_ZONE_CONCAT_IMPL(a, b)
+
+# if defined(SIV3D_DISABLE_PROFILE_ZONE)
+
+	# define SIV3D_PROFILE_ZONE(NAME) ((void)0)
+
+# else
+
+	/// @brief 現在のスコープをプロファイラのゾーンとして記録します。 | Records the current scope as a profiler zone.
+	# define SIV3D_PROFILE_ZONE(NAME) const s3d::ProfilerZone SIV3D_PROFILE_ZONE_CONCAT(siv3d_profile_zone_, __LINE__){ NAME }
+
+# endif
@@ -19,6 +19,7 @@ namespace s3d
 {
 	/// @brief リソースファイルの一覧を取得します。
 	/// @return リソースファイルの一覧
+	/// @remark リソースパックをマウントしている場合、返した参照は、マウントの状態の変化によって異なる一覧がさらに 15 個作成されるまで有効です。
 	[[nodiscard]]
 	const Array<FilePath>& EnumResourceFiles() noexcept;
 
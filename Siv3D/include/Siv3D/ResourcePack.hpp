@@ -0,0 +1,77 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "Compression.hpp"
+
+namespace s3d
+{
+	/// @brief リソースパック
+	/// @remark 多数のリソースファイルを 1 つのファイルにまとめ、ファイルシステムへの問い合わせなしで読み込めるようにします。
+	namespace ResourcePack
+	{
+		/// @brief リソースパックファイルの標準の拡張子
+		inline constexpr StringView Extension = U"s3dpack";
+
+		/// @brief ディレクトリ内のすべてのファイルを、リソースパックファイルにまとめます。
+		/// @param sourceDirectory まとめるファイルがあるディレクトリ
+		/// @param outputPath 作成するリソースパックファイルのパス
+		/// @param compressionLevel 圧縮レベル
+		/// @return リソースパックファイルの作成に成功した場合 true, それ以外の場合は false
+		/// @remark パックの中のファイルパスは、`sourceDirectory` からの相対パスになります。
+		/// @remark ファイルは一定サイズのブロックごとに独立して zstd で圧縮されます。圧縮の効果が小さいファイル（PNG や Ogg Vorbis など）は無圧縮で格納されます。
+		bool Create(FilePathView sourceDirectory, FilePathView outputPath, int32 compressionLevel = Compression::DefaultLevel);
+
+		/// @brief ファイルの一覧を、リソースパックファイルにまとめます。
+		/// @param files まとめるファイルの一覧
+		/// @param baseDirectory パックの中のファイルパスの基準にするディレクトリ
+		/// @param outputPath 作成するリソースパックファイルのパス
+		/// @param compressionLevel 圧縮レベル
+		/// @return リソースパックファイルの作成に成功した場合 true, それ以外の場合は false
+		bool Create(const Array<FilePath>& files, FilePathView baseDirectory, FilePathView outputPath, int32 compressionLevel = Compression::DefaultLevel);
+
+		/// @brief リソースパックファイルを、リソースフォルダにマウントします。
+		/// @param packPath リソースパックファイルのパス
+		/// @return マウントに成功した場合 true, それ以外の場合は false
+		/// @remark マウント後は、`Resource()` や `FileOrResource()` が返すパスのうちパックに含まれるものが、パックから読み込まれます。
+		bool Mount(FilePathView packPath);
+
+		/// @brief リソースパックファイルを、指定したディレクトリにマウントします。
+		/// @param packPath リソースパックファイルのパス
+		/// @param mountPoint マウント先のディレクトリ。空の場合はカレントディレクトリからの相対パスで読み込めるようになります
+		/// @return マウントに成功した場合 true, それ以外の場合は false
+		/// @remark 同じファイルが複数のパックに含まれる場合は、後からマウントしたパックが優先されます。
+		bool Mount(FilePathView packPath, FilePathView mountPoint);
+
+		/// @brief リソースパックファイルのマウントを解除します。
+		/// @param packPath リソースパックファイルのパス
+		/// @return マウントを解除した場合 true, マウントされていなかった場合は false
+		/// @remark パックから開いているファイルは、閉じるまで引き続き読み込めます。
+		bool Unmount(FilePathView packPath);
+
+		/// @brief すべてのリソースパックファイルのマウントを解除します。
+		void UnmountAll();
+
+		/// @brief マウントされているリソースパックに、指定したファイルが含まれるかを返します。
+		/// @param path ファイルパス
+		/// @return 含まれる場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool Contains(FilePathView path);
+
+		/// @brief マウントされているリソースパックに含まれるファイルの一覧を返します。
+		/// @return マウントされているリソースパックに含まれるファイルの一覧
+		[[nodiscard]]
+		Array<FilePath> EnumFiles();
+	}
+}
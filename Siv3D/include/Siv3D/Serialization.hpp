@@ -111,6 +111,9 @@ CEREAL_REGISTER_ARCHIVE(s3d::Deserializer<s3d::BinaryReader>)
 CEREAL_REGISTER_ARCHIVE(s3d::Serializer<s3d::MemoryWriter>)
 CEREAL_REGISTER_ARCHIVE(s3d::Deserializer<s3d::MemoryReader>)
 CEREAL_REGISTER_ARCHIVE(s3d::Deserializer<s3d::MemoryViewReader>)
+CEREAL_REGISTER_ARCHIVE(s3d::Serializer<s3d::CompressionWriter>)
+CEREAL_REGISTER_ARCHIVE(s3d::Deserializer<s3d::DecompressionReader>)
 
 CEREAL_SETUP_ARCHIVE_TRAITS(s3d::Deserializer<s3d::BinaryReader>, s3d::Serializer<s3d::BinaryWriter>)
 CEREAL_SETUP_ARCHIVE_TRAITS(s3d::Deserializer<s3d::MemoryReader>, s3d::Serializer<s3d::MemoryWriter>)
+CEREAL_SETUP_ARCHIVE_TRAITS(s3d::Deserializer<s3d::DecompressionReader>, s3d::Serializer<s3d::CompressionWriter>)
@@ -0,0 +1,58 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Grid.hpp"
+
+namespace s3d
+{
+	/// @brief スペクトログラム（短時間フーリエ変換の結果）
+	struct Spectrogram
+	{
+		/// @brief 各フレームの振幅スペクトル。`magnitudes[frame][bin]` は、frame 番目のフレームの `bin * resolution` Hz の成分
+		Grid<float> magnitudes;
+
+		/// @brief 周波数分解能 (Hz)
+		double resolution = 0.0;
+
+		/// @brief 元の波形のサンプルレート
+		uint32 sampleRate = 0;
+
+		/// @brief フレームの間隔（サンプル）
+		size_t hopSize = 0;
+
+		/// @brief フレーム数を返します。
+		/// @return フレーム数
+		[[nodiscard]]
+		size_t frames() const noexcept
+		{
+			return magnitudes.height();
+		}
+
+		/// @brief 1 フレームあたりの周波数成分の数を返します。
+		/// @return 1 フレームあたりの周波数成分の数
+		[[nodiscard]]
+		size_t bins() const noexcept
+		{
+			return magnitudes.width();
+		}
+
+		/// @brief フレームの先頭の時刻（秒）を返します。
+		/// @param frame フレームのインデックス
+		/// @return フレームの先頭の時刻（秒）
+		[[nodiscard]]
+		double frameTime(const size_t frame) const noexcept
+		{
+			return (sampleRate ? (static_cast<double>(frame * hopSize) / sampleRate) : 0.0);
+		}
+	};
+}
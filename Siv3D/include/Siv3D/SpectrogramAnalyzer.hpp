@@ -0,0 +1,124 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "Spectrogram.hpp"
+# include "FFTWindowFunction.hpp"
+# include "PredefinedYesNo.hpp"
+
+namespace s3d
+{
+	class Wave;
+	class IAudioStream;
+	class Microphone;
+
+	/// @brief 短時間フーリエ変換 (STFT) によってスペクトログラムを計算するクラス
+	/// @remark フレーム i は、波形の `i * hopSize()` サンプル目から `fftSize()` サンプルを窓関数を掛けて FFT したものです。
+	/// @remark 1 つのオブジェクトを複数のスレッドから同時に使うことはできません。
+	class SpectrogramAnalyzer
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		/// @remark FFT サンプル数 2048, フレームの間隔 512 サンプル, ハン窓で計算します。
+		SIV3D_NODISCARD_CXX20
+		SpectrogramAnalyzer();
+
+		/// @brief スペクトログラムの計算方法を指定して作成します。
+		/// @param fftSize 1 フレームの FFT サンプル数。32 の倍数で、素因数が 2, 3, 5 のみである必要があります
+		/// @param hopSize フレームの間隔（サンプル）。0 の場合は fftSize / 4。fftSize より小さい場合、フレームは重なり合います
+		/// @param windowFunction 窓関数
+		/// @throw Error fftSize が不正な場合
+		SIV3D_NODISCARD_CXX20
+		explicit SpectrogramAnalyzer(size_t fftSize, size_t hopSize = 0, FFTWindowFunction windowFunction = FFTWindowFunction::Hann);
+
+		/// @brief デストラクタ
+		~SpectrogramAnalyzer();
+
+		/// @brief 1 フレームの FFT サンプル数を返します。
+		/// @return 1 フレームの FFT サンプル数
+		[[nodiscard]]
+		size_t fftSize() const noexcept;
+
+		/// @brief フレームの間隔（サンプル）を返します。
+		/// @return フレームの間隔（サンプル）
+		[[nodiscard]]
+		size_t hopSize() const noexcept;
+
+		/// @brief 1 フレームあたりの周波数成分の数 (fftSize() / 2) を返します。
+		/// @return 1 フレームあたりの周波数成分の数
+		[[nodiscard]]
+		size_t bins() const noexcept;
+
+		/// @brief 窓関数を返します。
+		/// @return 窓関数
+		[[nodiscard]]
+		FFTWindowFunction windowFunction() const noexcept;
+
+		/// @brief 波形全体のスペクトログラムを計算します。
+		/// @param dst 結果の出力先。既存のメモリは再利用されます
+		/// @param samples モノラルの波形
+		/// @param length 波形のサンプル数
+		/// @param sampleRate 波形のサンプルレート
+		/// @param parallel フレームを分割して並列に計算するか
+		/// @remark 波形の末尾を超える部分は 0 として扱います。
+		void analyze(Spectrogram& dst, const float* samples, size_t length, uint32 sampleRate, Parallel parallel = Parallel::No);
+
+		/// @brief 波形全体のスペクトログラムを計算します。
+		/// @param dst 結果の出力先。既存のメモリは再利用されます
+		/// @param wave 波形。左右のチャンネルの平均を使います
+		/// @param parallel フレームを分割して並列に計算するか
+		void analyze(Spectrogram& dst, const Wave& wave, Parallel parallel = Parallel::No);
+
+		/// @brief 波形の一部のスペクトログラムを計算します。
+		/// @param dst 結果の出力先。既存のメモリは再利用されます
+		/// @param wave 波形。左右のチャンネルの平均を使います
+		/// @param beginSample 計算を開始するサンプル位置
+		/// @param sampleCount 計算するサンプル数
+		/// @param parallel フレームを分割して並列に計算するか
+		/// @remark 長い波形は、範囲を分けて計算することで結果のメモリを抑えられます。
+		void analyze(Spectrogram& dst, const Wave& wave, size_t beginSample, size_t sampleCount, Parallel parallel = Parallel::No);
+
+		/// @brief ストリーミング入力に波形を追加し、新しく完成したフレームを dst の末尾に追加します。
+		/// @param dst 結果の出力先
+		/// @param samples 追加するモノラルの波形
+		/// @param length 追加する波形のサンプル数
+		/// @param sampleRate 波形のサンプルレート
+		/// @return 追加されたフレーム数
+		/// @remark フレームにまだ足りないサンプルは、次の呼び出しまで保持されます。
+		size_t process(Spectrogram& dst, const float* samples, size_t length, uint32 sampleRate);
+
+		/// @brief オーディオストリームから波形を読み込み、新しく完成したフレームを dst の末尾に追加します。
+		/// @param dst 結果の出力先
+		/// @param stream オーディオストリーム
+		/// @param sampleCount 読み込むサンプル数
+		/// @param sampleRate ストリームのサンプルレート
+		/// @return 追加されたフレーム数
+		size_t process(Spectrogram& dst, IAudioStream& stream, size_t sampleCount, uint32 sampleRate);
+
+		/// @brief マイクが前回の呼び出し以降に録音した波形を読み込み、新しく完成したフレームを dst の末尾に追加します。
+		/// @param dst 結果の出力先
+		/// @param microphone マイク
+		/// @return 追加されたフレーム数
+		/// @remark 最初の呼び出しでは、その時点の録音位置から読み込みを開始します。
+		size_t process(Spectrogram& dst, const Microphone& microphone);
+
+		/// @brief ストリーミング入力で保持しているサンプルと、マイクの読み込み位置を破棄します。
+		void resetStream();
+
+	private:
+
+		class SpectrogramAnalyzerDetail;
+
+		std::shared_ptr<SpectrogramAnalyzerDetail> pImpl;
+	};
+}
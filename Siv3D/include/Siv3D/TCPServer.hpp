@@ -13,6 +13,7 @@
 # include <memory>
 # include "Common.hpp"
 # include "Array.hpp"
+# include "Blob.hpp"
 # include "Optional.hpp"
 # include "Unspecified.hpp"
 
@@ -34,6 +35,12 @@ namespace s3d
 
 		void startAcceptMulti(uint16 port);
 
+		/// @brief 複数の I/O スレッドを使って、複数のセッションの接続受付を開始します。
+		/// @param port ポート番号
+		/// @param numThreads I/O スレッドの数。スレッドごとに io_context を持ち、セッションは順番に割り当てられます。
+		/// @remark 多数の接続を同時に扱うサーバ向けです。一度増やしたスレッドは `disconnect()` 後も再利用されます。
+		void startAcceptMulti(uint16 port, size_t numThreads);
+
 		void cancelAccept();
 
 		[[nodiscard]]
@@ -53,6 +60,12 @@ namespace s3d
 		[[nodiscard]]
 		Array<TCPSessionID> getSessionIDs() const;
 
+		/// @brief 受信済みのデータが指定したサイズ以上あるセッションの ID 一覧を返します。
+		/// @param minSize 受信済みデータの最小サイズ（バイト）
+		/// @return 受信済みのデータが minSize バイト以上あるセッションの ID 一覧
+		[[nodiscard]]
+		Array<TCPSessionID> getReadableSessionIDs(size_t minSize = 1) const;
+
 		[[nodiscard]]
 		uint16 port() const;
 
@@ -76,6 +89,27 @@ namespace s3d
 		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
 		bool send(const TriviallyCopyable& to, const Optional<TCPSessionID>& id = unspecified);
 
+		/// @brief データを送信します。データはコピーされずに送信キューへ移動します。
+		/// @param data 送信するデータ
+		/// @param id セッション ID
+		/// @return 送信キューに追加された場合 true, それ以外の場合は false
+		bool send(Blob&& data, const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief すべてのセッションに同じデータを送信します。
+		/// @param data 送信するデータの先頭ポインタ
+		/// @param size 送信するデータのサイズ（バイト）
+		/// @return データを送信キューに追加したセッションの数
+		/// @remark データのコピーは 1 回だけ作られ、すべてのセッションで共有されます。
+		size_t broadcast(const void* data, size_t size);
+
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		size_t broadcast(const TriviallyCopyable& data);
+
+		/// @brief すべてのセッションに同じデータを送信します。データはコピーされずに、すべてのセッションで共有されます。
+		/// @param data 送信するデータ
+		/// @return データを送信キューに追加したセッションの数
+		size_t broadcast(Blob&& data);
+
 	private:
 
 		class TCPServerDetail;
@@ -0,0 +1,71 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# ifndef SIV3D_NO_CONCURRENT_API
+
+# include <atomic>
+# include <exception>
+# include <functional>
+# include <mutex>
+# include <type_traits>
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief エンジンのスレッドプールで実行されるタスクのグループ | A group of tasks executed on the engine's thread pool
+	/// @remark スレッドを新しく作成せず、エンジンが所有するワーカースレッドでタスクを実行します。 | Tasks run on worker threads owned by the engine instead of newly created threads.
+	class TaskGroup
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		TaskGroup() = default;
+
+		TaskGroup(const TaskGroup&) = delete;
+
+		TaskGroup& operator =(const TaskGroup&) = delete;
+
+		/// @brief デストラクタ | Destructor
+		/// @remark 未完了のタスクがある場合、完了まで待機します。 | Waits for unfinished tasks.
+		~TaskGroup();
+
+		/// @brief タスクをスレッドプールに追加します。 | Adds a task to the thread pool.
+		/// @tparam Fty タスクの関数の型 | Task function type
+		/// @param f タスクの関数 | Task function
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty>>* = nullptr>
+		void run(Fty&& f);
+
+		/// @brief すべてのタスクの完了を待ちます。 | Waits for all tasks to complete.
+		/// @remark 待機中、呼び出し元のスレッドもスレッドプールのタスクを実行します。 | The calling thread executes pending pool tasks while waiting.
+		/// @remark タスクが例外を送出していた場合、最初の例外を再送出します。 | Rethrows the first exception thrown by a task, if any.
+		void wait();
+
+		/// @brief 未完了のタスクの数を返します。 | Returns the number of unfinished tasks.
+		/// @return 未完了のタスクの数 | Number of unfinished tasks
+		[[nodiscard]]
+		size_t num_pending() const noexcept;
+
+	private:
+
+		std::atomic<size_t> m_pendingCount = 0;
+
+		std::mutex m_exceptionMutex;
+
+		std::exception_ptr m_exception;
+
+		void submit(std::function<void()> task);
+	};
+}
+
+# include "detail/TaskGroup.ipp"
+
+# endif // SIV3D_NO_CONCURRENT_API
@@ -73,7 +73,8 @@ namespace s3d
 
 		/// @brief 指定したテクスチャアセットの非同期ロードを開始します。
 		/// @param name テクスチャアセット名
-		static void LoadAsync(AssetNameView name);
+		/// @param priority 優先度
+		static void LoadAsync(AssetNameView name, AssetLoadPriority priority = AssetLoadPriority::Normal);
 
 		/// @brief 指定したテクスチャアセットのロードが完了するまで待機します。
 		/// @param name テクスチャアセット名
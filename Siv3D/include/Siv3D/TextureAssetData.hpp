@@ -15,7 +15,6 @@
 # include "Texture.hpp"
 # include "Emoji.hpp"
 # include "Icon.hpp"
-# include "AsyncTask.hpp"
 
 namespace s3d
 {
@@ -70,9 +69,5 @@ namespace s3d
 		static bool DefaultLoad(TextureAssetData& asset, const String& hint);
 
 		static void DefaultRelease(TextureAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
@@ -0,0 +1,187 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+# include "Image.hpp"
+# include "2DShapes.hpp"
+# include "ColorF.hpp"
+# include "Palette.hpp"
+# include "Texture.hpp"
+# include "TextureDesc.hpp"
+# include "TextureRegion.hpp"
+# include "AssetInfo.hpp"
+
+namespace s3d
+{
+	class TextureAtlasRegion;
+
+	/// @brief 実行時に複数の画像を 1 枚のテクスチャにまとめるテクスチャアトラス | Texture atlas that packs many images into a single texture at runtime
+	/// @remark 追加された画像は、画像の追加や削除のあと最初に領域やテクスチャを取得したときに空き領域に配置され、その領域だけがテクスチャに転送されます。 | Added images are placed into free space the first time a region or the texture is requested after images are added or removed, and only those areas are uploaded to the texture.
+	/// @remark 空き領域が足りない場合はテクスチャを拡大し、最大サイズでも足りない場合は `RectanglePacking` ですべての画像を再配置します。 | If free space runs out, the texture grows; if it still does not fit at the maximum size, every image is repacked with `RectanglePacking`.
+	/// @remark `region()` が返す `TextureAtlasRegion` は、再配置やテクスチャの拡大のあとも正しい領域を指します。 | `TextureAtlasRegion` returned by `region()` keeps pointing at the right area after repacking or growing.
+	class TextureAtlas
+	{
+	public:
+
+		/// @brief デフォルトの最大サイズ | Default maximum size
+		static constexpr int32 DefaultMaxSide = 4096;
+
+		/// @brief デフォルトの画像間の余白 | Default padding between images
+		static constexpr int32 DefaultPadding = 1;
+
+		SIV3D_NODISCARD_CXX20
+		TextureAtlas();
+
+		/// @brief テクスチャアトラスを作成します。 | Creates a texture atlas.
+		/// @param maxSide テクスチャの幅と高さの最大値 | Maximum width and height of the texture
+		/// @param padding 画像間の余白（ピクセル）。余白は画像の端のピクセルで埋められます。 | Padding between images in pixels. The padding is filled with the edge pixels of each image.
+		/// @param desc テクスチャの設定 | Texture description
+		SIV3D_NODISCARD_CXX20
+		explicit TextureAtlas(int32 maxSide, int32 padding = DefaultPadding, TextureDesc desc = TextureDesc::Unmipped);
+
+		~TextureAtlas();
+
+		/// @brief 画像を追加します。同じ名前の画像がある場合は置き換えます。 | Adds an image. Replaces the image with the same name, if any.
+		/// @param name 画像の名前 | Name of the image
+		/// @param image 画像 | Image
+		/// @return 追加に成功した場合 true, それ以外の場合は false | Returns true if the image was added, false otherwise
+		bool add(StringView name, const Image& image);
+
+		/// @brief 画像を追加します。同じ名前の画像がある場合は置き換えます。 | Adds an image. Replaces the image with the same name, if any.
+		/// @param name 画像の名前 | Name of the image
+		/// @param image 画像 | Image
+		/// @return 追加に成功した場合 true, それ以外の場合は false | Returns true if the image was added, false otherwise
+		bool add(StringView name, Image&& image);
+
+		/// @brief 登録済みのテクスチャアセットの元画像を、アセット名で追加します。 | Adds the source image of a registered texture asset, under the asset name.
+		/// @param name テクスチャアセットの登録名 | Name of the texture asset
+		/// @return 追加に成功した場合 true, それ以外の場合は false | Returns true if the image was added, false otherwise
+		/// @remark 画像はアセットの登録情報（ファイルパス、絵文字、アイコン）から読み込まれます。テクスチャアセットのロード状態は変わりません。 | The image is loaded from the asset's registration (file path, emoji, or icon). The load state of the texture asset does not change.
+		bool addAsset(AssetNameView name);
+
+		/// @brief 指定したタグを持つ登録済みのテクスチャアセットをすべて追加します。 | Adds every registered texture asset that has the specified tag.
+		/// @param tag タグ | Tag
+		/// @return 追加したアセットの数 | Number of assets added
+		size_t addAssetsWithTag(const AssetTag& tag);
+
+		/// @brief 画像を削除します。 | Removes an image.
+		/// @param name 画像の名前 | Name of the image
+		/// @return 削除した場合 true, 画像が存在しない場合は false | Returns true if the image was removed, false if it did not exist
+		bool remove(StringView name);
+
+		/// @brief 画像が含まれているかを返します。 | Returns whether the atlas contains an image.
+		/// @param name 画像の名前 | Name of the image
+		/// @return 画像が含まれている場合 true, それ以外の場合は false | Returns true if the image is contained, false otherwise
+		[[nodiscard]]
+		bool contains(StringView name) const;
+
+		/// @brief 含まれている画像の数を返します。 | Returns the number of images in the atlas.
+		/// @return 含まれている画像の数 | Number of images
+		[[nodiscard]]
+		size_t num_images() const noexcept;
+
+		/// @brief 画像の追加や削除を反映して、必要であれば再配置とテクスチャの更新を行います。 | Applies added and removed images, repacking and updating the texture if needed.
+		/// @return 全ての画像を配置できた場合 true, それ以外の場合は false | Returns true if all images fit, false otherwise
+		/// @remark 配置に失敗した場合、直前のテクスチャと領域がそのまま使われます。 | If packing fails, the previous texture and regions are kept.
+		bool build();
+
+		/// @brief 画像の領域を指すハンドルを返します。 | Returns a handle to the region of an image.
+		/// @param name 画像の名前 | Name of the image
+		/// @return 画像の領域を指すハンドル。画像が存在しない場合は空のハンドル | Handle to the region. Empty if the image does not exist
+		[[nodiscard]]
+		TextureAtlasRegion region(StringView name) const;
+
+		/// @brief 現在の配置での画像のテクスチャ領域を返します。 | Returns the texture region of an image in the current layout.
+		/// @param name 画像の名前 | Name of the image
+		/// @return テクスチャ領域。画像が存在しない場合は空のテクスチャ領域 | Texture region. Empty if the image does not exist
+		/// @remark 返されたテクスチャ領域は、次の再配置までのみ有効です。 | The returned texture region is valid only until the next repack.
+		[[nodiscard]]
+		TextureRegion operator ()(StringView name) const;
+
+		/// @brief アトラスのテクスチャを返します。 | Returns the atlas texture.
+		/// @return アトラスのテクスチャ | Atlas texture
+		[[nodiscard]]
+		const Texture& getTexture() const;
+
+		/// @brief アトラスのテクスチャのサイズを返します。 | Returns the size of the atlas texture.
+		/// @return アトラスのテクスチャのサイズ | Size of the atlas texture
+		[[nodiscard]]
+		Size size() const;
+
+		/// @brief 配置が更新された回数を返します。 | Returns how many times the layout has been updated.
+		/// @return 配置が更新された回数 | Number of layout updates
+		[[nodiscard]]
+		uint64 version() const noexcept;
+
+	private:
+
+		friend class TextureAtlasRegion;
+
+		class TextureAtlasDetail;
+
+		std::shared_ptr<TextureAtlasDetail> pImpl;
+	};
+
+	/// @brief テクスチャアトラス内の画像の領域を指すハンドル | Handle to the region of an image in a texture atlas
+	/// @remark アトラスが再配置されても、常に現在の領域を返します。 | Always returns the current region, even after the atlas is repacked.
+	class TextureAtlasRegion
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		TextureAtlasRegion() = default;
+
+		/// @brief 有効な画像を指しているかを返します。 | Returns whether the handle points at a valid image.
+		/// @return 有効な画像を指している場合 true, それ以外の場合は false | Returns true if the handle points at a valid image, false otherwise
+		[[nodiscard]]
+		bool isEmpty() const;
+
+		[[nodiscard]]
+		explicit operator bool() const;
+
+		/// @brief 現在の配置でのテクスチャ領域を返します。 | Returns the texture region in the current layout.
+		/// @return テクスチャ領域 | Texture region
+		[[nodiscard]]
+		TextureRegion get() const;
+
+		[[nodiscard]]
+		operator TextureRegion() const;
+
+		/// @brief 画像のサイズを返します。 | Returns the size of the image.
+		/// @return 画像のサイズ | Size of the image
+		[[nodiscard]]
+		Size size() const;
+
+		RectF draw(double x, double y, const ColorF& diffuse = Palette::White) const;
+
+		RectF draw(const Vec2& pos = Vec2{ 0, 0 }, const ColorF& diffuse = Palette::White) const;
+
+		RectF drawAt(double x, double y, const ColorF& diffuse = Palette::White) const;
+
+		RectF drawAt(const Vec2& pos, const ColorF& diffuse = Palette::White) const;
+
+	private:
+
+		friend class TextureAtlas;
+
+		std::shared_ptr<TextureAtlas::TextureAtlasDetail> m_atlas;
+
+		uint32 m_index = 0;
+
+		uint64 m_id = 0;
+
+		TextureAtlasRegion(const std::shared_ptr<TextureAtlas::TextureAtlasDetail>& atlas, uint32 index, uint64 id);
+	};
+}
@@ -14,7 +14,6 @@
 # include "Asset.hpp"
 # include "ShaderCommon.hpp"
 # include "VertexShader.hpp"
-# include "AsyncTask.hpp"
 
 namespace s3d
 {
@@ -67,9 +66,5 @@ namespace s3d
 		static bool DefaultLoad(VertexShaderAssetData& asset, const String& hint);
 
 		static void DefaultRelease(VertexShaderAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
@@ -10,11 +10,13 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
 # include "Common.hpp"
 # include "String.hpp"
 # include "Array.hpp"
 # include "Blob.hpp"
 # include "MemoryReader.hpp"
+# include "IReader.hpp"
 
 namespace s3d
 {
@@ -44,8 +46,24 @@ namespace s3d
 		[[nodiscard]]
 		const Array<FilePath>& enumPaths() const;
 
+		/// @brief アーカイブ内に指定したファイルがあるかを返します。
+		/// @param filePath アーカイブ内のファイルパス
+		/// @return ファイルがある場合 true, それ以外の場合は false
+		/// @remark パスの索引を使うため、ファイル数によらず定数時間で判定します。
+		[[nodiscard]]
+		bool contains(FilePathView filePath) const;
+
+		/// @brief アーカイブ内のすべてのファイルを展開します。
+		/// @param targetDirectory 展開先のディレクトリ
+		/// @return 展開に成功した場合 true, それ以外の場合は false
+		/// @remark 複数のファイルを、ワーカースレッドで並列に展開します。
 		bool extractAll(FilePathView targetDirectory) const;
 
+		/// @brief アーカイブ内のファイルのうち、パターンに一致するものを展開します。
+		/// @param pattern パターン（ワイルドカード `*` と `?` を使えます）
+		/// @param targetDirectory 展開先のディレクトリ
+		/// @return 展開に成功した場合 true, それ以外の場合は false
+		/// @remark 複数のファイルを、ワーカースレッドで並列に展開します。
 		bool extractFiles(StringView pattern, FilePathView targetDirectory) const;
 
 		[[nodiscard]]
@@ -54,6 +72,15 @@ namespace s3d
 		[[nodiscard]]
 		Blob extractToBlob(FilePathView filePath) const;
 
+		/// @brief アーカイブ内のファイルを、全体を展開せずに読み込む IReader を作成します。
+		/// @param filePath アーカイブ内のファイルパス
+		/// @return IReader。ファイルが見つからない場合は nullptr
+		/// @remark 無圧縮のファイルは、メモリマップしたアーカイブからコピーせずに読み込みます。
+		/// Deflate で圧縮されたファイルは、読み込みに合わせて少しずつ展開します。
+		/// 返された IReader は、ZIPReader を閉じた後も使えます。
+		[[nodiscard]]
+		std::unique_ptr<IReader> openReader(FilePathView filePath) const;
+
 	private:
 
 		class ZIPReaderDetail;
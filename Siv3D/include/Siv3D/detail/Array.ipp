@@ -1541,191 +1541,65 @@ namespace s3d
 
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_r_v<bool, Fty, Type>>*>
-	inline size_t Array<Type, Allocator>::parallel_count_if(Fty f) const
+	inline size_t Array<Type, Allocator>::parallel_count_if(Fty f, const size_t grainSize) const
 	{
-	# if SIV3D_PLATFORM(WINDOWS)
-
-		return std::count_if(std::execution::par, begin(), end(), f);
-
-	# else
-
 		if (isEmpty())
 		{
 			return 0;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return count_if(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
+		std::atomic<size_t> result = 0;
 
-		for (size_t i = 0; i < (numThreads - 1); ++i)
+		ParallelFor(0, size(), [&](const size_t first, const size_t last)
 		{
-			const size_t n = Min(countPerthread, countLeft);
+			const auto it = begin();
 
-			if (n == 0)
-			{
-				break;
-			}
+			result.fetch_add(static_cast<size_t>(std::count_if((it + first), (it + last), f)), std::memory_order_relaxed);
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				return std::count_if(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		size_t result = 0;
-		
-		if (countLeft)
-		{
-			result = std::count_if(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			result += future.get();
-		}
-
-		return result;
+		}, grainSize);
 
-	# endif
+		return result.load();
 	}
 
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>*>
-	inline void Array<Type, Allocator>::parallel_each(Fty f)
+	inline void Array<Type, Allocator>::parallel_each(Fty f, const size_t grainSize)
 	{
-	# if SIV3D_PLATFORM(WINDOWS)
-
-		std::for_each(std::execution::par, begin(), end(), f);
-
-	# else
-
 		if (isEmpty())
 		{
 			return;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return each(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
+		ParallelFor(0, size(), [&](const size_t first, const size_t last)
 		{
-			std::for_each(it, it + countLeft, f);
-		}
+			const auto it = begin();
 
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+			std::for_each((it + first), (it + last), f);
 
-	# endif
+		}, grainSize);
 	}
 
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
-	inline void Array<Type, Allocator>::parallel_each(Fty f) const
+	inline void Array<Type, Allocator>::parallel_each(Fty f, const size_t grainSize) const
 	{
-	# if SIV3D_PLATFORM(WINDOWS)
-
-		std::for_each(std::execution::par, begin(), end(), f);
-
-	# else
-
 		if (isEmpty())
 		{
 			return;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
+		ParallelFor(0, size(), [&](const size_t first, const size_t last)
 		{
-			return each(f);
-		}
+			const auto it = begin();
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
+			std::for_each((it + first), (it + last), f);
 
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			std::for_each(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
-
-	# endif
+		}, grainSize);
 	}
 
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
-	inline auto Array<Type, Allocator>::parallel_map(Fty f) const
+	inline auto Array<Type, Allocator>::parallel_map(Fty f, const size_t grainSize) const
 	{
 		using Ret = std::remove_cvref_t<decltype(f((*this)[0]))>;
 
@@ -1734,61 +1608,20 @@ namespace s3d
 			return Array<Ret>{};
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return map(f);
-		}
-
 		Array<Ret> new_array(size());
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<void>> futures;
-
-		auto itDst = new_array.begin();
-		auto itSrc = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
-			{
-				const auto itSrcEnd = itSrc + n;
-
-				while (itSrc != itSrcEnd)
-				{
-					*itDst++ = f(*itSrc++);
-				}
-			}));
-
-			itDst += n;
-			itSrc += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
+		ParallelFor(0, size(), [&](size_t first, const size_t last)
 		{
-			const auto itSrcEnd = end();
+			auto itDst = (new_array.begin() + first);
+			auto itSrc = (begin() + first);
+			const auto itSrcEnd = (begin() + last);
 
 			while (itSrc != itSrcEnd)
 			{
 				*itDst++ = f(*itSrc++);
 			}
-		}
 
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		}, grainSize);
 
 		return new_array;
 	}
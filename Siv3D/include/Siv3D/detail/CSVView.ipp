@@ -0,0 +1,105 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline CSVRowView::CSVRowView(const char8* pLine, const uint32* pFields, const size_t columns, const detail::CSVViewSyntax* pSyntax) noexcept
+		: m_pLine{ pLine }
+		, m_pFields{ pFields }
+		, m_columns{ columns }
+		, m_pSyntax{ pSyntax } {}
+
+	inline size_t CSVRowView::columns() const noexcept
+	{
+		return m_columns;
+	}
+
+	template <class Type>
+	inline Type CSVRowView::get(const size_t column) const
+	{
+		if (const auto opt = getOpt<Type>(column))
+		{
+			return opt.value();
+		}
+
+		return Type();
+	}
+
+	template <class Type, class U>
+	inline Type CSVRowView::getOr(const size_t column, U&& defaultValue) const
+	{
+		return getOpt<Type>(column).value_or(std::forward<U>(defaultValue));
+	}
+
+	template <class Type>
+	inline Optional<Type> CSVRowView::getOpt(const size_t column) const
+	{
+		if constexpr (std::is_same_v<Type, String>)
+		{
+			return getItem(column);
+		}
+		else
+		{
+			if constexpr (std::is_arithmetic_v<Type>)
+			{
+				// 数値は短いので、String を作らずに変換する
+				std::array<char32, detail::CSVViewSmallFieldLength> buffer;
+
+				if (const auto length = getSmallItem(column, buffer.data()))
+				{
+					return ParseOpt<Type>(StringView{ buffer.data(), *length });
+				}
+			}
+
+			if (const auto item = getItem(column))
+			{
+				return ParseOpt<Type>(*item);
+			}
+
+			return none;
+		}
+	}
+
+	inline String CSVRowView::operator [](const size_t column) const
+	{
+		return getItem(column).value_or(String{});
+	}
+
+	inline CSVView::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	template <class Type>
+	inline Type CSVView::get(const size_t row, const size_t column) const
+	{
+		return getRow(row).get<Type>(column);
+	}
+
+	template <class Type, class U>
+	inline Type CSVView::getOr(const size_t row, const size_t column, U&& defaultValue) const
+	{
+		return getRow(row).getOr<Type>(column, std::forward<U>(defaultValue));
+	}
+
+	template <class Type>
+	inline Optional<Type> CSVView::getOpt(const size_t row, const size_t column) const
+	{
+		return getRow(row).getOpt<Type>(column);
+	}
+
+	inline CSVRowView CSVView::operator [](const size_t row) const noexcept
+	{
+		return getRow(row);
+	}
+}
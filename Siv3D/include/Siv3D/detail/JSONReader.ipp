@@ -0,0 +1,110 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader> && !std::is_lvalue_reference_v<Reader>>*>
+	inline JSONReader::JSONReader(Reader&& reader)
+		: JSONReader{}
+	{
+		open(std::move(reader));
+	}
+
+	template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader> && !std::is_lvalue_reference_v<Reader>>*>
+	inline bool JSONReader::open(Reader&& reader)
+	{
+		return open(std::make_unique<Reader>(std::move(reader)));
+	}
+
+	inline JSONReader::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	template <class Type>
+	inline Type JSONReader::get() const
+	{
+		if (const auto opt = getOpt<Type>())
+		{
+			return opt.value();
+		}
+		else
+		{
+			throw Error{ U"JSONReader::get(): Invalid JSON type" };
+		}
+	}
+
+	template <class Type, class U>
+	inline Type JSONReader::getOr(U&& defaultValue) const
+	{
+		return getOpt<Type>().value_or(std::forward<U>(defaultValue));
+	}
+
+	template <class Type>
+	inline Optional<Type> JSONReader::getOpt() const
+	{
+		if constexpr (std::is_same_v<Type, String>)
+		{
+			return getOptString();
+		}
+		else if constexpr (std::is_same_v<Type, int64>)
+		{
+			return getOptInt64();
+		}
+		else if constexpr (std::is_same_v<Type, double>)
+		{
+			return getOptDouble();
+		}
+		else if constexpr (std::is_same_v<Type, bool>)
+		{
+			return getOptBool();
+		}
+		else
+		{
+			return getOpt_<Type>();
+		}
+	}
+
+	SIV3D_CONCEPT_INTEGRAL_
+	inline Optional<Int> JSONReader::getOpt_() const
+	{
+		if (const auto opt = getOptInt64())
+		{
+			return static_cast<Int>(*opt);
+		}
+
+		return none;
+	}
+
+	SIV3D_CONCEPT_FLOATING_POINT_
+	inline Optional<Float> JSONReader::getOpt_() const
+	{
+		if (const auto opt = getOptDouble())
+		{
+			return static_cast<Float>(*opt);
+		}
+
+		return none;
+	}
+
+	template <class Type, std::enable_if_t<!std::is_arithmetic_v<Type>>*>
+	inline Optional<Type> JSONReader::getOpt_() const
+	{
+		if (const auto opt = getOptString())
+		{
+			return ParseOpt<Type>(*opt);
+		}
+
+		return none;
+	}
+}
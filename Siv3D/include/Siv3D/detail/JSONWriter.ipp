@@ -0,0 +1,65 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Writer, std::enable_if_t<std::is_base_of_v<IWriter, Writer> && !std::is_lvalue_reference_v<Writer>>*>
+	inline JSONWriter::JSONWriter(Writer&& writer)
+		: JSONWriter{}
+	{
+		open(std::move(writer));
+	}
+
+	template <class Writer, std::enable_if_t<std::is_base_of_v<IWriter, Writer> && !std::is_lvalue_reference_v<Writer>>*>
+	inline bool JSONWriter::open(Writer&& writer)
+	{
+		return open(std::make_unique<Writer>(std::move(writer)));
+	}
+
+	inline JSONWriter::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	SIV3D_CONCEPT_INTEGRAL_
+	inline void JSONWriter::write(const Int value)
+	{
+		if constexpr (std::is_signed_v<Int>)
+		{
+			writeInt64(static_cast<int64>(value));
+		}
+		else
+		{
+			writeUint64(static_cast<uint64>(value));
+		}
+	}
+
+	SIV3D_CONCEPT_FLOATING_POINT_
+	inline void JSONWriter::write(const Float value)
+	{
+		writeDouble(static_cast<double>(value));
+	}
+
+	inline void JSONWriter::write(const String& value)
+	{
+		write(StringView{ value });
+	}
+
+	template <class Type>
+	inline void JSONWriter::write(const StringView _key, const Type& value)
+	{
+		key(_key);
+
+		write(value);
+	}
+}
@@ -33,7 +33,10 @@ namespace s3d
 		: m_data(polygons.begin(), polygons.end(), alloc) {}
 
 	inline MultiPolygon::MultiPolygon(MultiPolygon&& lines) noexcept
-		: m_data(std::move(lines.m_data)) {}
+		: m_data(std::move(lines.m_data))
+	{
+		m_spatialIndex.moveFrom(lines.m_spatialIndex);
+	}
 
 	inline MultiPolygon::MultiPolygon(std::initializer_list<value_type> init, const allocator_type& alloc)
 		: m_data(init, alloc) {}
@@ -49,6 +52,8 @@ namespace s3d
 
 	inline MultiPolygon& MultiPolygon::operator =(const Array<value_type>& other)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data.assign(other.begin(), other.end());
 
 		return *this;
@@ -56,6 +61,8 @@ namespace s3d
 
 	inline MultiPolygon& MultiPolygon::operator =(Array<value_type>&& other) noexcept
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data = other;
 
 		return *this;
@@ -63,6 +70,8 @@ namespace s3d
 
 	inline MultiPolygon& MultiPolygon::operator =(const MultiPolygon& other)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data = other.m_data;
 
 		return *this;
@@ -70,6 +79,8 @@ namespace s3d
 
 	inline MultiPolygon& MultiPolygon::operator =(MultiPolygon&& other) noexcept
 	{
+		m_spatialIndex.moveFrom(other.m_spatialIndex);
+
 		m_data = std::move(other.m_data);
 
 		return *this;
@@ -88,36 +99,50 @@ namespace s3d
 	template <class Iterator>
 	inline void MultiPolygon::assign(Iterator first, Iterator last)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data.assign(first, last);
 	}
 
 	inline void MultiPolygon::assign(size_type n, const value_type& value)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data.assign(n, value);
 	}
 
 	inline void MultiPolygon::assign(std::initializer_list<value_type> il)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data.assign(il);
 	}
 
 	inline void MultiPolygon::assign(const Array<Polygon>& other)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data = other;
 	}
 
 	inline void MultiPolygon::assign(Array<Polygon>&& other)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data = std::move(other);
 	}
 
 	inline void MultiPolygon::assign(const MultiPolygon& other)
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data = other.m_data;
 	}
 
 	inline void MultiPolygon::assign(MultiPolygon&& other) noexcept
 	{
+		m_spatialIndex.moveFrom(other.m_spatialIndex);
+
 		m_data = std::move(other.m_data);
 	}
 
@@ -128,6 +153,8 @@ namespace s3d
 
 	inline MultiPolygon::value_type& MultiPolygon::at(const size_t index)&
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.at(index);
 	}
 
@@ -138,11 +165,15 @@ namespace s3d
 
 	inline MultiPolygon::value_type MultiPolygon::at(const size_t index)&&
 	{
+		m_spatialIndex.reset();
+
 		return std::move(m_data.at(index));
 	}
 
 	inline MultiPolygon::value_type& MultiPolygon::operator[](const size_t index) & noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data[index];
 	}
 
@@ -153,51 +184,71 @@ namespace s3d
 
 	inline MultiPolygon::value_type MultiPolygon::operator[](const size_t index) && noexcept
 	{
+		m_spatialIndex.reset();
+
 		return std::move(m_data[index]);
 	}
 
 	inline void MultiPolygon::push_front(const value_type& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.push_front(value);
 	}
 
 	inline void MultiPolygon::push_front(value_type&& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.push_front(std::move(value));
 	}
 
 	inline void MultiPolygon::push_back(const value_type& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.push_back(value);
 	}
 
 	inline void MultiPolygon::push_back(value_type&& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.push_back(std::move(value));
 	}
 
 	inline void MultiPolygon::pop_front()
 	{
+		m_spatialIndex.reset();
+
 		m_data.pop_front();
 	}
 
 	inline void MultiPolygon::pop_front_N(const size_t n)
 	{
+		m_spatialIndex.reset();
+
 		m_data.pop_front_N(n);
 	}
 
 	inline void MultiPolygon::pop_back() noexcept
 	{
+		m_spatialIndex.reset();
+
 		m_data.pop_back();
 	}
 
 	inline void MultiPolygon::pop_back_N(const size_t n)
 	{
+		m_spatialIndex.reset();
+
 		m_data.pop_back_N(n);
 	}
 
 	inline MultiPolygon& MultiPolygon::operator <<(const value_type& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.push_back(value);
 
 		return *this;
@@ -205,6 +256,8 @@ namespace s3d
 
 	inline MultiPolygon& MultiPolygon::operator <<(value_type&& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.push_back(std::move(value));
 
 		return *this;
@@ -213,17 +266,23 @@ namespace s3d
 	template <class... Args>
 	MultiPolygon::iterator MultiPolygon::emplace(const_iterator position, Args&&... args)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.emplace(position, std::forward<Args>(args)...);
 	}
 
 	template <class... Args>
 	decltype(auto) MultiPolygon::emplace_back(Args&&... args)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.emplace_back(std::forward<Args>(args)...);
 	}
 
 	inline MultiPolygon::value_type& MultiPolygon::front() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.front();
 	}
 
@@ -234,6 +293,8 @@ namespace s3d
 
 	inline MultiPolygon::value_type& MultiPolygon::back() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.back();
 	}
 
@@ -244,6 +305,8 @@ namespace s3d
 
 	inline void MultiPolygon::swap(MultiPolygon& other) noexcept
 	{
+		m_spatialIndex.swap(other.m_spatialIndex);
+
 		m_data.swap(other.m_data);
 	}
 
@@ -254,16 +317,22 @@ namespace s3d
 
 	inline MultiPolygon::value_type* MultiPolygon::data() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.data();
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::begin() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.begin();
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::end() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.end();
 	}
 
@@ -289,11 +358,15 @@ namespace s3d
 
 	inline MultiPolygon::reverse_iterator MultiPolygon::rbegin() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.rbegin();
 	}
 
 	inline MultiPolygon::reverse_iterator MultiPolygon::rend() noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.rend();
 	}
 
@@ -364,11 +437,15 @@ namespace s3d
 
 	inline void MultiPolygon::clear() noexcept
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		m_data.clear();
 	}
 
 	inline void MultiPolygon::release()
 	{
+		m_spatialIndex.resetMutableAccess();
+
 		clear();
 
 		shrink_to_fit();
@@ -376,47 +453,65 @@ namespace s3d
 
 	inline MultiPolygon::iterator MultiPolygon::insert(const_iterator where, const value_type& value)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.insert(where, value);
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::insert(const_iterator where, value_type&& value)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.insert(where, std::move(value));
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::insert(const_iterator where, const size_t count, const value_type& value)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.insert(where, count, value);
 	}
 
 	template <class Iterator>
 	inline MultiPolygon::iterator MultiPolygon::insert(const_iterator where, Iterator first, Iterator last)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.insert(where, first, last);
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::insert(const_iterator where, std::initializer_list<value_type> il)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.insert(where, il);
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::erase(const_iterator where) noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.erase(where);
 	}
 
 	inline MultiPolygon::iterator MultiPolygon::erase(const_iterator first, const_iterator last) noexcept
 	{
+		m_spatialIndex.markMutableAccess();
+
 		return m_data.erase(first, last);
 	}
 
 	inline void MultiPolygon::resize(const size_t newSize)
 	{
+		m_spatialIndex.reset();
+
 		m_data.resize(newSize);
 	}
 
 	inline void MultiPolygon::resize(const size_t newSize, const value_type& value)
 	{
+		m_spatialIndex.reset();
+
 		m_data.resize(newSize, value);
 	}
 
@@ -435,6 +530,8 @@ namespace s3d
 	SIV3D_CONCEPT_URBG_
 	inline MultiPolygon::value_type& MultiPolygon::choice(URBG&& rbg)
 	{
+		m_spatialIndex.markMutableAccess();
+
 		if (empty())
 		{
 			throw std::out_of_range("MultiPolygon::choice(): Array is empty");
@@ -494,6 +591,8 @@ namespace s3d
 	template <class Fty>
 	inline MultiPolygon& MultiPolygon::remove_if(Fty f)
 	{
+		m_spatialIndex.reset();
+
 		m_data.remove_if(f);
 
 		return *this;
@@ -502,6 +601,8 @@ namespace s3d
 	SIV3D_CONCEPT_URBG_
 	inline MultiPolygon& MultiPolygon::shuffle(URBG&& rbg)
 	{
+		m_spatialIndex.reset();
+
 		m_data.shuffle(std::forward<URBG>(rbg));
 
 		return *this;
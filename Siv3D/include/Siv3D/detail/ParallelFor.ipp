@@ -0,0 +1,40 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t>>*>
+	inline void ParallelFor(const size_t beginIndex, const size_t endIndex, Fty f, const size_t grainSize)
+	{
+		detail::ParallelForImpl(beginIndex, endIndex, grainSize,
+			[](void* context, size_t first, const size_t last)
+			{
+				Fty& func = *static_cast<Fty*>(context);
+
+				for (; first < last; ++first)
+				{
+					func(first);
+				}
+			}, &f);
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t, size_t>>*>
+	inline void ParallelFor(const size_t beginIndex, const size_t endIndex, Fty f, const size_t grainSize)
+	{
+		detail::ParallelForImpl(beginIndex, endIndex, grainSize,
+			[](void* context, const size_t first, const size_t last)
+			{
+				(*static_cast<Fty*>(context))(first, last);
+			}, &f);
+	}
+}
@@ -30,4 +30,10 @@ namespace s3d
 	{
 		return send(std::addressof(to), sizeof(TriviallyCopyable), id);
 	}
+
+	SIV3D_CONCEPT_TRIVIALLY_COPYABLE_
+	inline size_t TCPServer::broadcast(const TriviallyCopyable& data)
+	{
+		return broadcast(std::addressof(data), sizeof(TriviallyCopyable));
+	}
 }
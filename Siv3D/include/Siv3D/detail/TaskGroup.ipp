@@ -0,0 +1,21 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty>>*>
+	inline void TaskGroup::run(Fty&& f)
+	{
+		submit(std::function<void()>(std::forward<Fty>(f)));
+	}
+}
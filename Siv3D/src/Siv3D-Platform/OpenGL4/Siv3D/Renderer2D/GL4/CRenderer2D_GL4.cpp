@@ -16,6 +16,7 @@
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Renderer/GL4/CRenderer_GL4.hpp>
 # include <Siv3D/Shader/GL4/CShader_GL4.hpp>
@@ -802,24 +803,30 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_GL4::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_GL4::addTexturedParticles(const Texture& texture, const Particle2DStore& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		// インデックスが Vertex2D::IndexType に収まるよう、分割して描画する
+		for (size_t first = 0; first < particles.size(); first += Vertex2DBuilder::MaxParticlesPerBuild)
 		{
-			if (not m_currentCustomVS)
-			{
-				m_commandManager.pushStandardVS(m_standardVS->spriteID);
-			}
+			const size_t last = Min((first + Vertex2DBuilder::MaxParticlesPerBuild), particles.size());
 
-			if (not m_currentCustomPS)
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, first, last, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
 			{
-				m_commandManager.pushStandardPS(m_standardPS->textureID);
-			}
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
 
-			m_commandManager.pushPSTexture(0, texture);
-			m_commandManager.pushDraw(indexCount);
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
+			}
 		}
 	}
 
@@ -1064,6 +1071,8 @@ namespace s3d
 
 	void CRenderer2D_GL4::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_batches.reset();
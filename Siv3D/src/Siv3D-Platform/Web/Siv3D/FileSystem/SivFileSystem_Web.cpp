@@ -18,6 +18,7 @@
 # include <Siv3D/EnvironmentVariable.hpp>
 # include <Siv3D/INI.hpp>
 # include <Siv3D/SimpleHTTP.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 
 namespace s3d
 {
@@ -246,6 +247,11 @@ namespace s3d
 
 		bool IsResource(const FilePathView path)
 		{
+			if (detail::IsPackedFile(path))
+			{
+				return true;
+			}
+
 			return IsResourcePath(path)
 				&& detail::Exists(path);
 		}
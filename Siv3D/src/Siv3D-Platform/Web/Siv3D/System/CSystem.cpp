@@ -13,6 +13,7 @@
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Resource/IResource.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
+# include <Siv3D/ThreadPool/IThreadPool.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
 # include <Siv3D/LicenseManager/ILicenseManager.hpp>
 # include <Siv3D/ImageDecoder/IImageDecoder.hpp>
@@ -96,6 +97,7 @@ namespace s3d
 		
 		SIV3D_ENGINE(Resource)->init();
 		SIV3D_ENGINE(Profiler)->init();
+		SIV3D_ENGINE(ThreadPool)->init();
 		SIV3D_ENGINE(Window)->init();
 		SIV3D_ENGINE(ImageDecoder)->init();
 		SIV3D_ENGINE(ImageEncoder)->init();
@@ -16,6 +16,7 @@
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Renderer/WebGPU/CRenderer_WebGPU.hpp>
 # include <Siv3D/Shader/WebGPU/CShader_WebGPU.hpp>
@@ -797,24 +798,30 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_WebGPU::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_WebGPU::addTexturedParticles(const Texture& texture, const Particle2DStore& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		// インデックスが Vertex2D::IndexType に収まるよう、分割して描画する
+		for (size_t first = 0; first < particles.size(); first += Vertex2DBuilder::MaxParticlesPerBuild)
 		{
-			if (not m_currentCustomVS)
-			{
-				m_commandManager.pushStandardVS(m_standardVS->spriteID);
-			}
+			const size_t last = Min((first + Vertex2DBuilder::MaxParticlesPerBuild), particles.size());
 
-			if (not m_currentCustomPS)
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, first, last, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
 			{
-				m_commandManager.pushStandardPS(m_standardPS->textureID);
-			}
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
 
-			m_commandManager.pushPSTexture(0, texture);
-			m_commandManager.pushDraw(indexCount);
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
+			}
 		}
 	}	
 
@@ -1059,6 +1066,8 @@ namespace s3d
 
 	void CRenderer2D_WebGPU::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		auto encoder = *pRenderer->getCommandEncoder();
 		flush(encoder);
 	}
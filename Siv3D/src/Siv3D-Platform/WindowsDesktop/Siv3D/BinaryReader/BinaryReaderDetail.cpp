@@ -29,6 +29,24 @@ namespace s3d
 
 		close();
 
+		// マウントされているリソースパックに含まれるファイルは、ファイルシステムに問い合わせずに開く
+		if (m_packed.reader.open(path))
+		{
+			m_packed.pos = 0;
+
+			m_info =
+			{
+				.isOpen		= true,
+				.size		= m_packed.reader.size(),
+				.fullPath	= FilePath(path)
+			};
+
+			LOG_INFO(U"📤 BinaryReader: File `{0}` opened from `{1}` (size: {2})"_fmt(
+				m_info.fullPath, m_packed.reader.packPath(), FormatDataSize(m_info.size)));
+
+			return true;
+		}
+
 		if (FileSystem::IsResourcePath(path))
 		{
 			HMODULE hModule = ::GetModuleHandleW(nullptr);
@@ -95,7 +113,14 @@ namespace s3d
 			return;
 		}
 
-		if (isResource())
+		if (isPacked())
+		{
+			m_packed.reader.close();
+			m_packed.pos = 0;
+			LOG_INFO(U"📥 BinaryReader: File `{0}` closed"_fmt(
+				m_info.fullPath));
+		}
+		else if (isResource())
 		{
 			m_resource = {};
 			LOG_INFO(U"📥 BinaryReader: Resource `{0}` closed"_fmt(
@@ -131,7 +156,11 @@ namespace s3d
 
 		assert(InRange<int64>(clampedPos, 0, size()));
 
-		if (isResource())
+		if (isPacked())
+		{
+			return (m_packed.pos = clampedPos);
+		}
+		else if (isResource())
 		{
 			return (m_resource.pos = clampedPos);
 		}
@@ -145,7 +174,11 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::getPos()
 	{
-		if (isResource())
+		if (isPacked())
+		{
+			return m_packed.pos;
+		}
+		else if (isResource())
 		{
 			return m_resource.pos;
 		}
@@ -157,7 +190,13 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::read(const NonNull<void*> dst, const int64 size)
 	{
-		if (isResource())
+		if (isPacked())
+		{
+			const int64 readBytes = m_packed.reader.read(dst.pointer, m_packed.pos, size);
+			m_packed.pos += readBytes;
+			return readBytes;
+		}
+		else if (isResource())
 		{
 			const int64 readBytes = Clamp(size, 0LL, (m_info.size - m_resource.pos));
 			std::memcpy(dst.pointer, (m_resource.pointer + m_resource.pos), static_cast<size_t>(readBytes));
@@ -191,7 +230,13 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::read(const NonNull<void*> dst, const int64 pos, const int64 size)
 	{
-		if (isResource())
+		if (isPacked())
+		{
+			const int64 readBytes = m_packed.reader.read(dst.pointer, pos, size);
+			m_packed.pos = (pos + readBytes);
+			return readBytes;
+		}
+		else if (isResource())
 		{
 			const int64 readBytes = Clamp(size, 0LL, (m_info.size - pos));
 			std::memcpy(dst.pointer, (m_resource.pointer + pos), static_cast<size_t>(readBytes));
@@ -230,7 +275,11 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::lookahead(const NonNull<void*> dst, const int64 size)
 	{
-		if (isResource())
+		if (isPacked())
+		{
+			return m_packed.reader.read(dst.pointer, m_packed.pos, size);
+		}
+		else if (isResource())
 		{
 			const int64 readBytes = Clamp(size, 0LL, (m_info.size - m_resource.pos));
 			std::memcpy(dst.pointer, (m_resource.pointer + m_resource.pos), static_cast<size_t>(readBytes));
@@ -265,7 +314,11 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::lookahead(const NonNull<void*> dst, const int64 pos, const int64 size)
 	{
-		if (isResource())
+		if (isPacked())
+		{
+			return m_packed.reader.read(dst.pointer, pos, size);
+		}
+		else if (isResource())
 		{
 			const int64 readBytes = Clamp(size, 0LL, (m_info.size - pos));
 			std::memcpy(dst.pointer, (m_resource.pointer + pos), static_cast<size_t>(readBytes));
@@ -312,4 +365,9 @@ namespace s3d
 	{
 		return (m_resource.pointer != nullptr);
 	}
+
+	bool BinaryReader::BinaryReaderDetail::isPacked() const noexcept
+	{
+		return m_packed.reader.isOpen();
+	}
 }
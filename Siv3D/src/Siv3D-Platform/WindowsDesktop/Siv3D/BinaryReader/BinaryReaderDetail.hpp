@@ -16,6 +16,7 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Byte.hpp>
 # include <Siv3D/NonNull.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 
 namespace s3d
 {
@@ -35,6 +36,12 @@ namespace s3d
 			int64 pos = 0;
 		} m_resource;
 
+		struct Packed
+		{
+			detail::PackedFileReader reader;
+			int64 pos = 0;
+		} m_packed;
+
 		struct Info
 		{
 			bool isOpen = false;
@@ -44,6 +51,8 @@ namespace s3d
 
 		bool isResource() const noexcept;
 
+		bool isPacked() const noexcept;
+
 	public:
 
 		BinaryReaderDetail();
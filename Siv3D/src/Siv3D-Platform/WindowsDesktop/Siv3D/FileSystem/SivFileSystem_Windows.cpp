@@ -18,6 +18,7 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Windows/Windows.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 # include <Shlobj.h>
 
 namespace s3d
@@ -323,6 +324,11 @@ namespace s3d
 
 		bool IsResource(const FilePathView path)
 		{
+			if (detail::IsPackedFile(path))
+			{
+				return true;
+			}
+
 			return IsResourcePath(path)
 				&& detail::ResourceExists(path);
 		}
@@ -9,54 +9,32 @@
 //
 //-----------------------------------------------
 
-# include <array>
+# include <cstdio>
 # include <Siv3D/Windows/Windows.hpp>
 # include <Siv3D/String.hpp>
-# include <Siv3D/FormatLiteral.hpp>
-# include <Siv3D/Utility.hpp>
-# include <Siv3D/Time.hpp>
+# include <Siv3D/Unicode.hpp>
 # include "CLogger.hpp"
 
 namespace s3d
 {
-	namespace detail
+	void CLogger::writeOutput(const String& text)
 	{
-		constexpr std::array<StringView, 7> LogTypeNames =
-		{
-			U"[error]   "_sv,
-			U"[fail]    "_sv,
-			U"[warning] "_sv,
-			U""_sv,
-			U"[info]    "_sv,
-			U"[trace]   "_sv,
-			U"[verbose] "_sv,
-		};
-	}
-
-	CLogger::CLogger() = default;
-
-	CLogger::~CLogger() = default;
-
-	void CLogger::write(const LogType type, const StringView s)
-	{
-		if (not m_enabled)
-		{
-			return;
-		}
-
-		const int64 timeStamp = Time::GetMillisec();
-		const StringView logTypeName = detail::LogTypeNames[FromEnum(type)];
-		const String text = U"{}: {}"_fmt(timeStamp, logTypeName) + s + U'\n';
-		const std::wstring output = text.toWstr();
-
 		std::lock_guard lock{ m_mutex };
 		{
-			::OutputDebugStringW(output.c_str());
+			if (m_file)
+			{
+				const std::string output = text.toUTF8();
+				std::fwrite(output.data(), 1, output.size(), m_file);
+				std::fflush(m_file);
+				return;
+			}
+
+			::OutputDebugStringW(text.toWstr().c_str());
 		}
 	}
 
-	void CLogger::setEnabled(const bool enabled)
+	std::FILE* CLogger::OpenFile(const StringView path)
 	{
-		m_enabled = enabled;
+		return ::_wfopen(Unicode::ToWstring(path).c_str(), L"wb");
 	}
 }
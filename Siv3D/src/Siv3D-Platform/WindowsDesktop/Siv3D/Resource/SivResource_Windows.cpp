@@ -11,6 +11,7 @@
 
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 # include <Siv3D/Windows/Windows.hpp>
 
 namespace s3d
@@ -22,7 +23,7 @@ namespace s3d
 
 	const Array<FilePath>& EnumResourceFiles() noexcept
 	{
-		return detail::init::GetResourceFilePaths();
+		return detail::EnumResourceFilesWithPacks(detail::init::GetResourceFilePaths());
 	}
 
 	FilePath Resource(const FilePathView path)
@@ -14,6 +14,7 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 # define BOOST_FILESYSTEM_NO_DEPRECATED
 # include <boost/filesystem.hpp>
 # import  <Foundation/Foundation.h>
@@ -415,6 +416,11 @@ namespace s3d
 
 		bool IsResource(const FilePathView path)
 		{
+			if (detail::IsPackedFile(path))
+			{
+				return true;
+			}
+
 			return IsResourcePath(path)
 				&& detail::Exists(path);
 		}
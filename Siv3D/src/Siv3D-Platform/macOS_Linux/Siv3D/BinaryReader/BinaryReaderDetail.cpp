@@ -29,6 +29,24 @@ namespace s3d
 
 		close();
 
+		// マウントされているリソースパックに含まれるファイルは、ファイルシステムに問い合わせずに開く
+		if (m_packed.reader.open(path))
+		{
+			m_packed.pos = 0;
+
+			m_info =
+			{
+				.isOpen		= true,
+				.size		= m_packed.reader.size(),
+				.fullPath	= FilePath(path)
+			};
+
+			LOG_INFO(U"📤 BinaryReader: File `{0}` opened from `{1}` (size: {2})"_fmt(
+				m_info.fullPath, m_packed.reader.packPath(), FormatDataSize(m_info.size)));
+
+			return true;
+		}
+
 		// ファイルのオープン
 		{
 			m_file.file.open(path.narrow(), std::ios_base::binary);
@@ -61,8 +79,17 @@ namespace s3d
 			return;
 		}
 
-		m_file.file.close();
-		m_file.pos = 0;
+		if (isPacked())
+		{
+			m_packed.reader.close();
+			m_packed.pos = 0;
+		}
+		else
+		{
+			m_file.file.close();
+			m_file.pos = 0;
+		}
+
 		LOG_INFO(U"📥 BinaryReader: File `{0}` closed"_fmt(
 			m_info.fullPath));
 
@@ -88,6 +115,11 @@ namespace s3d
 
 		assert(InRange<int64>(clampedPos, 0, size()));
 
+		if (isPacked())
+		{
+			return (m_packed.pos = clampedPos);
+		}
+
 		m_file.file.seekg(clampedPos);
 		m_file.pos = clampedPos;
 		return m_file.pos;
@@ -95,11 +127,23 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::getPos()
 	{
+		if (isPacked())
+		{
+			return m_packed.pos;
+		}
+
 		return m_file.pos;
 	}
 
 	int64 BinaryReader::BinaryReaderDetail::read(const NonNull<void*> dst, const int64 size)
 	{
+		if (isPacked())
+		{
+			const int64 readBytes = m_packed.reader.read(dst.pointer, m_packed.pos, size);
+			m_packed.pos += readBytes;
+			return readBytes;
+		}
+
 		const int64 readBytes = Clamp<int64>(size, 0LL, (m_info.size - m_file.pos));
 
 		if (readBytes)
@@ -129,6 +173,13 @@ namespace s3d
 			return 0;
 		}
 
+		if (isPacked())
+		{
+			const int64 readBytes = m_packed.reader.read(dst.pointer, m_packed.pos, size);
+			m_packed.pos += readBytes;
+			return readBytes;
+		}
+
 		const int64 readBytes = Clamp<int64>(size, 0LL, (m_info.size - m_file.pos));
 
 		if (readBytes)
@@ -153,6 +204,11 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::lookahead(const NonNull<void*> dst, const int64 size)
 	{
+		if (isPacked())
+		{
+			return m_packed.reader.read(dst.pointer, m_packed.pos, size);
+		}
+
 		const auto previousPos = getPos();
 
 		const int64 readBytes = Clamp<int64>(size, 0LL, (m_info.size - m_file.pos));
@@ -179,6 +235,11 @@ namespace s3d
 
 	int64 BinaryReader::BinaryReaderDetail::lookahead(const NonNull<void*> dst, const int64 pos, const int64 size)
 	{
+		if (isPacked())
+		{
+			return m_packed.reader.read(dst.pointer, pos, size);
+		}
+
 		const auto previousPos = getPos();
 
 		if (pos != setPos(pos))
@@ -212,4 +273,9 @@ namespace s3d
 	{
 		return m_info.fullPath;
 	}
+
+	bool BinaryReader::BinaryReaderDetail::isPacked() const noexcept
+	{
+		return m_packed.reader.isOpen();
+	}
 }
@@ -14,6 +14,7 @@
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/NonNull.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 
 namespace s3d
 {
@@ -26,6 +27,12 @@ namespace s3d
 			std::ifstream file;
 			int64 pos = 0;
 		} m_file;
+
+		struct Packed
+		{
+			detail::PackedFileReader reader;
+			int64 pos = 0;
+		} m_packed;
 		
 		struct Info
 		{
@@ -33,6 +40,8 @@ namespace s3d
 			int64 size = 0;
 			FilePath fullPath;
 		} m_info;
+
+		bool isPacked() const noexcept;
 		
 	public:
 
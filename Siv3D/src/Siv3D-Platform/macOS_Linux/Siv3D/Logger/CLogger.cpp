@@ -9,62 +9,37 @@
 //
 //-----------------------------------------------
 
-# include <array>
+# include <cstdio>
+# include <iostream>
 # include <Siv3D/String.hpp>
-# include <Siv3D/FormatLiteral.hpp>
-# include <Siv3D/Time.hpp>
+# include <Siv3D/Unicode.hpp>
 # include "CLogger.hpp"
 
 namespace s3d
 {
-	namespace detail
+	void CLogger::writeOutput(const String& text)
 	{
-		constexpr std::array<StringView, 7> LogTypeNames =
-		{
-			U"[error]   "_sv,
-			U"[fail]    "_sv,
-			U"[warning] "_sv,
-			U""_sv,
-			U"[info]    "_sv,
-			U"[trace]   "_sv,
-			U"[verbose] "_sv,
-		};
-	}
-
-	CLogger::CLogger()
-	{
-
-	}
-
-	CLogger::~CLogger()
-	{
-	
-	}
-
-	void CLogger::write(const LogType type, const StringView s)
-	{
-		if (not m_enabled)
-		{
-			return;
-		}
-
-		const int64 timeStamp = Time::GetMillisec();
-		const StringView logTypeName = detail::LogTypeNames[FromEnum(type)];
-		const String text = U"{}: {}"_fmt(timeStamp, logTypeName) + s;
 		const std::string output = text.narrow();
 
 		std::lock_guard lock{ m_mutex };
 		{
+			if (m_file)
+			{
+				std::fwrite(output.data(), 1, output.size(), m_file);
+				std::fflush(m_file);
+				return;
+			}
+
 		# if SIV3D_PLATFORM(WEB)
-			std::cout << output << std::endl;
+			std::cout << output << std::flush;
 		# else
-			std::clog << output << std::endl;
+			std::clog << output << std::flush;
 		# endif
 		}
 	}
 
-	void CLogger::setEnabled(const bool enabled)
+	std::FILE* CLogger::OpenFile(const StringView path)
 	{
-		m_enabled = enabled;
-	}	
+		return std::fopen(Unicode::Narrow(path).c_str(), "wb");
+	}
 }
@@ -10,9 +10,12 @@
 //-----------------------------------------------
 
 # pragma once
+# include <array>
 # include <atomic>
+# include <cstdio>
 # include <mutex>
 # include <Siv3D/Logger/ILogger.hpp>
+# include <Siv3D/Logger/AsyncLogger.hpp>
 
 namespace s3d
 {
@@ -24,6 +27,38 @@ namespace s3d
 
 		std::atomic<bool> m_enabled{ true };
 
+		std::FILE* m_file = nullptr;
+
+	# if SIV3D_ASYNC_LOGGER_THREAD
+
+		std::mutex m_asyncMutex;
+
+		std::unique_ptr<AsyncLogger> m_asyncLogger;
+
+		std::atomic<AsyncLogger*> m_async{ nullptr };
+
+		// m_async を読んで書き込み中のスレッドの数。差し替えの世代の偶奇ごとに数える
+		std::array<std::atomic<size_t>, 2> m_asyncWriters{};
+
+		std::atomic<uint32> m_asyncGeneration{ 0 };
+
+		std::atomic<bool> m_asyncSwitching{ false };
+
+		void replaceAsyncLogger(std::unique_ptr<AsyncLogger> asyncLogger);
+
+	# endif
+
+		void writeLine(LogType type, uint64 timeStamp, StringView s);
+
+		void writeRecords(const Array<LogRecord>& records);
+
+		// 以下はプラットフォームごとに実装する
+
+		void writeOutput(const String& text);
+
+		[[nodiscard]]
+		static std::FILE* OpenFile(StringView path);
+
 	public:
 
 		CLogger();
@@ -33,5 +68,11 @@ namespace s3d
 		void write(LogType type, StringView s) override;
 
 		void setEnabled(bool enabled) override;
+
+		void setAsync(bool enabled, size_t bufferSize, LogOverflowPolicy overflow) override;
+
+		void flush() override;
+
+		bool setOutputFile(StringView path) override;
 	};
 }
@@ -0,0 +1,515 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/Texture/ITexture.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "AssetLoader.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 同時に多くのファイルを読んでもディスクを取り合うだけなので、I/O スレッドは少なくする
+		inline constexpr size_t AssetReadThreadCount = 2;
+
+		inline constexpr size_t PrefetchBlockSize = (1024 * 1024);
+
+		// 待機中に、メインスレッドで作成するテクスチャを 1 回あたりいくつ処理するか
+		inline constexpr size_t WaitTextureUpdateCount = 16;
+
+		[[nodiscard]]
+		static size_t GetAssetLoadThreadCount() noexcept
+		{
+			return (Max<size_t>(Threading::GetConcurrency(), 2) - 1);
+		}
+
+		// ファイルを最後まで読んで、ロード処理が OS のファイルキャッシュから読めるようにする
+		static void Prefetch(const Array<FilePath>& files, Array<Byte>& buffer)
+		{
+			const int64 bufferSize = static_cast<int64>(buffer.size());
+
+			for (const auto& path : files)
+			{
+				BinaryReader reader{ path };
+
+				// 開けない場合は、ロード処理で失敗させる
+				if (not reader)
+				{
+					continue;
+				}
+
+				while (reader.read(buffer.data(), bufferSize) == bufferSize) {}
+			}
+		}
+
+		[[nodiscard]]
+		static bool IsDone(const AssetLoadJob& job) noexcept
+		{
+			return ((job.stage == AssetLoadJob::Stage::Finished)
+				|| (job.stage == AssetLoadJob::Stage::Canceled));
+		}
+	}
+
+	AssetLoader::AssetLoader()
+		: m_mainThreadID{ std::this_thread::get_id() } {}
+
+	AssetLoader::~AssetLoader()
+	{
+		shutdown();
+	}
+
+	void AssetLoader::setRequestOptions(const IAsset* asset, const AssetLoadPriority priority, const Array<const IAsset*>& dependencies)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_requestOptions[asset] = RequestOptions{ priority, dependencies };
+
+		// すでに待機中のロードは、優先度を上げる場合だけ並べ直す
+		const auto it = m_activeJobs.find(asset);
+
+		if ((it == m_activeJobs.end())
+			|| (priority <= it->second->priority))
+		{
+			return;
+		}
+
+		const std::shared_ptr<AssetLoadJob> job = it->second;
+
+		JobQueue* queue = ((job->stage == AssetLoadJob::Stage::WaitingForRead) ? &m_readQueue
+			: (job->stage == AssetLoadJob::Stage::WaitingForLoad) ? &m_loadQueue : nullptr);
+
+		if (queue && removeJob(*queue, *job))
+		{
+			(*queue)[FromEnum(priority)].push_back(job);
+		}
+
+		job->priority = priority;
+	}
+
+	void AssetLoader::clearRequestOptions(const IAsset* asset)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_requestOptions.erase(asset);
+	}
+
+	std::shared_ptr<AssetLoadJob> AssetLoader::submit(const IAsset* asset, std::function<bool()> load, Array<FilePath> files, std::function<void(AssetState)> setState)
+	{
+		auto job = std::make_shared<AssetLoadJob>();
+		job->asset		= asset;
+		job->load		= std::move(load);
+		job->setState	= std::move(setState);
+		job->files		= std::move(files.remove_if([](const FilePath& path) { return path.isEmpty(); }));
+		job->tags		= asset->getTags();
+
+		std::unique_lock lock{ m_mutex };
+
+		// 前回のロードがすべて終わっていれば、進捗の集計をやり直す
+		if (m_progress.isFinished())
+		{
+			m_progress = AssetLoadProgress{};
+		}
+
+		++m_progress.total;
+
+		if (const auto it = m_requestOptions.find(asset);
+			it != m_requestOptions.end())
+		{
+			job->priority = it->second.priority;
+
+			for (const IAsset* dependency : it->second.dependencies)
+			{
+				if (const auto itDependency = m_activeJobs.find(dependency);
+					itDependency != m_activeJobs.end())
+				{
+					job->dependencies << itDependency->second;
+				}
+			}
+
+			m_requestOptions.erase(it);
+		}
+
+		m_activeJobs[asset] = job;
+
+	# if SIV3D_ASSET_LOADER_THREAD
+
+		startThreads();
+
+		if (job->files)
+		{
+			job->stage = AssetLoadJob::Stage::WaitingForRead;
+			m_readQueue[FromEnum(job->priority)].push_back(job);
+			m_readCondition.notify_one();
+		}
+		else
+		{
+			job->stage = AssetLoadJob::Stage::WaitingForLoad;
+			m_loadQueue[FromEnum(job->priority)].push_back(job);
+			m_loadCondition.notify_one();
+		}
+
+	# else
+
+		// スレッドを使えない環境では、その場でロードする
+		job->stage = AssetLoadJob::Stage::Loading;
+		lock.unlock();
+		run(*job);
+
+	# endif
+
+		return job;
+	}
+
+	void AssetLoader::wait(const std::shared_ptr<AssetLoadJob>& job)
+	{
+		std::unique_lock lock{ m_mutex };
+
+		waitForCompletion(job, lock);
+
+		// ロード処理で発生した例外は、最初に待機した呼び出し元に伝える
+		if (job->exception)
+		{
+			const std::exception_ptr exception = std::exchange(job->exception, nullptr);
+
+			lock.unlock();
+
+			std::rethrow_exception(exception);
+		}
+	}
+
+	size_t AssetLoader::cancel(const AssetTag& tag)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return cancelIf([&tag](const AssetLoadJob& job) { return job.tags.contains(tag); });
+	}
+
+	size_t AssetLoader::cancelAll()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return cancelIf([](const AssetLoadJob&) { return true; });
+	}
+
+	AssetLoadProgress AssetLoader::getProgress() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_progress;
+	}
+
+	void AssetLoader::shutdown()
+	{
+		std::unique_lock lock{ m_mutex };
+
+		cancelIf([](const AssetLoadJob&) { return true; });
+
+		// 実行中のロードが終わるのを待つ。メインスレッドでのテクスチャの作成は打ち切る
+		while (not m_activeJobs.empty())
+		{
+			m_stageCondition.wait_for(lock, std::chrono::milliseconds(1));
+
+			updateAsyncTextureLoad(lock, Largest<size_t>);
+		}
+
+		m_abort = true;
+		m_readCondition.notify_all();
+		m_loadCondition.notify_all();
+
+		lock.unlock();
+
+		for (auto& thread : m_readThreads)
+		{
+			thread.join();
+		}
+
+		for (auto& thread : m_loadThreads)
+		{
+			thread.join();
+		}
+
+		m_readThreads.clear();
+		m_loadThreads.clear();
+	}
+
+	void AssetLoader::startThreads()
+	{
+		if (m_threadsStarted)
+		{
+			return;
+		}
+
+		m_threadsStarted = true;
+
+		for (size_t i = 0; i < detail::AssetReadThreadCount; ++i)
+		{
+			m_readThreads.emplace_back(&AssetLoader::readThread, this);
+		}
+
+		const size_t loadThreadCount = detail::GetAssetLoadThreadCount();
+
+		for (size_t i = 0; i < loadThreadCount; ++i)
+		{
+			m_loadThreads.emplace_back(&AssetLoader::loadThread, this);
+		}
+	}
+
+	void AssetLoader::readThread()
+	{
+		Array<Byte> buffer(detail::PrefetchBlockSize);
+
+		for (;;)
+		{
+			std::shared_ptr<AssetLoadJob> job;
+			{
+				std::unique_lock lock{ m_mutex };
+
+				m_readCondition.wait(lock, [&]() { return (m_abort || (job = popJob(m_readQueue, false))); });
+
+				if (not job)
+				{
+					return;
+				}
+
+				job->stage = AssetLoadJob::Stage::Reading;
+			}
+
+			detail::Prefetch(job->files, buffer);
+
+			{
+				std::lock_guard lock{ m_mutex };
+
+				if (job->cancelRequested)
+				{
+					job->setState(AssetState::Uninitialized);
+					finish(*job, AssetLoadJob::Stage::Canceled, false);
+				}
+				else
+				{
+					job->stage = AssetLoadJob::Stage::WaitingForLoad;
+					m_loadQueue[FromEnum(job->priority)].push_back(job);
+					m_loadCondition.notify_one();
+					m_stageCondition.notify_all();
+				}
+			}
+		}
+	}
+
+	void AssetLoader::loadThread()
+	{
+		for (;;)
+		{
+			std::shared_ptr<AssetLoadJob> job;
+			{
+				std::unique_lock lock{ m_mutex };
+
+				m_loadCondition.wait(lock, [&]() { return (m_abort || (job = popJob(m_loadQueue, true))); });
+
+				if (not job)
+				{
+					return;
+				}
+
+				job->stage = AssetLoadJob::Stage::Loading;
+				m_stageCondition.notify_all();
+			}
+
+			run(*job);
+		}
+	}
+
+	void AssetLoader::run(AssetLoadJob& job)
+	{
+		bool succeeded = false;
+
+		try
+		{
+			succeeded = job.load();
+		}
+		catch (...)
+		{
+			job.exception = std::current_exception();
+		}
+
+		job.setState(succeeded ? AssetState::Loaded : AssetState::Failed);
+
+		std::lock_guard lock{ m_mutex };
+
+		finish(job, AssetLoadJob::Stage::Finished, succeeded);
+	}
+
+	void AssetLoader::waitForCompletion(const std::shared_ptr<AssetLoadJob>& job, std::unique_lock<std::mutex>& lock)
+	{
+		while (not detail::IsDone(*job))
+		{
+			const bool waitingForRead = (job->stage == AssetLoadJob::Stage::WaitingForRead);
+
+			// まだ開始されていなければ、このスレッドでロードする
+			if (waitingForRead || (job->stage == AssetLoadJob::Stage::WaitingForLoad))
+			{
+				removeJob((waitingForRead ? m_readQueue : m_loadQueue), *job);
+				job->stage = AssetLoadJob::Stage::Loading;
+
+				for (const auto& dependency : Array<std::shared_ptr<AssetLoadJob>>{ job->dependencies })
+				{
+					waitForCompletion(dependency, lock);
+				}
+
+				lock.unlock();
+				{
+					run(*job);
+				}
+				lock.lock();
+
+				continue;
+			}
+
+			m_stageCondition.wait_for(lock, std::chrono::milliseconds(1));
+
+			// ロード中のスレッドが、メインスレッドでのテクスチャの作成を待っている場合がある
+			updateAsyncTextureLoad(lock, detail::WaitTextureUpdateCount);
+		}
+	}
+
+	void AssetLoader::updateAsyncTextureLoad(std::unique_lock<std::mutex>& lock, const size_t maxUpdate)
+	{
+		// メインスレッド以外で待機している場合は、メインスレッドの System::Update() に任せる
+		if (std::this_thread::get_id() != m_mainThreadID)
+		{
+			return;
+		}
+
+		lock.unlock();
+		{
+			SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(maxUpdate);
+		}
+		lock.lock();
+	}
+
+	std::shared_ptr<AssetLoadJob> AssetLoader::popJob(JobQueue& queue, const bool checkDependencies)
+	{
+		// 優先度の高い順に、依存先のロードが終わっているものを探す
+		for (size_t i = queue.size(); i--;)
+		{
+			auto& jobs = queue[i];
+
+			for (auto it = jobs.begin(); it != jobs.end(); ++it)
+			{
+				if (checkDependencies
+					&& (not std::all_of((*it)->dependencies.begin(), (*it)->dependencies.end(),
+						[](const std::shared_ptr<AssetLoadJob>& dependency) { return detail::IsDone(*dependency); })))
+				{
+					continue;
+				}
+
+				std::shared_ptr<AssetLoadJob> job = std::move(*it);
+
+				jobs.erase(it);
+
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool AssetLoader::removeJob(JobQueue& queue, const AssetLoadJob& job)
+	{
+		auto& jobs = queue[FromEnum(job.priority)];
+
+		const auto it = std::find_if(jobs.begin(), jobs.end(),
+			[&job](const std::shared_ptr<AssetLoadJob>& queued) { return (queued.get() == &job); });
+
+		if (it == jobs.end())
+		{
+			return false;
+		}
+
+		jobs.erase(it);
+
+		return true;
+	}
+
+	template <class Predicate>
+	size_t AssetLoader::cancelIf(Predicate predicate)
+	{
+		size_t canceled = 0;
+
+		for (JobQueue* queue : { &m_readQueue, &m_loadQueue })
+		{
+			for (auto& jobs : *queue)
+			{
+				for (auto it = jobs.begin(); it != jobs.end();)
+				{
+					if (not predicate(**it))
+					{
+						++it;
+						continue;
+					}
+
+					const std::shared_ptr<AssetLoadJob> job = std::move(*it);
+
+					it = jobs.erase(it);
+
+					job->setState(AssetState::Uninitialized);
+					finish(*job, AssetLoadJob::Stage::Canceled, false);
+
+					++canceled;
+				}
+			}
+		}
+
+		// 先読み中のものは、先読みが終わったところでキャンセルする
+		for (auto&& [asset, job] : m_activeJobs)
+		{
+			if ((job->stage == AssetLoadJob::Stage::Reading)
+				&& (not job->cancelRequested)
+				&& predicate(*job))
+			{
+				job->cancelRequested = true;
+
+				++canceled;
+			}
+		}
+
+		return canceled;
+	}
+
+	void AssetLoader::finish(AssetLoadJob& job, const AssetLoadJob::Stage stage, const bool succeeded)
+	{
+		job.stage = stage;
+		job.load = nullptr;
+		job.dependencies.clear();
+
+		++m_progress.finished;
+
+		if (stage == AssetLoadJob::Stage::Canceled)
+		{
+			++m_progress.canceled;
+		}
+		else if (not succeeded)
+		{
+			++m_progress.failed;
+		}
+
+		if (const auto it = m_activeJobs.find(job.asset);
+			(it != m_activeJobs.end()) && (it->second.get() == &job))
+		{
+			m_activeJobs.erase(it);
+		}
+
+		// 依存先のロードが終わって、開始できるようになったものがあるかもしれない
+		m_loadCondition.notify_all();
+		m_stageCondition.notify_all();
+	}
+}
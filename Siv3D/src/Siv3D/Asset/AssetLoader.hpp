@@ -0,0 +1,174 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <condition_variable>
+# include <deque>
+# include <exception>
+# include <mutex>
+# include <thread>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Asset.hpp>
+# include <Siv3D/HashTable.hpp>
+
+# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+#	define SIV3D_ASSET_LOADER_THREAD 1
+# else
+#	define SIV3D_ASSET_LOADER_THREAD 0
+# endif
+
+namespace s3d
+{
+	/// @brief アセットローダーに要求された 1 つの非同期ロード
+	struct AssetLoadJob
+	{
+		enum class Stage : uint8
+		{
+			// I/O スレッドによる先読みを待っている
+			WaitingForRead,
+
+			// 先読み中
+			Reading,
+
+			// ロード処理を待っている
+			WaitingForLoad,
+
+			// ロード処理中
+			Loading,
+
+			Finished,
+
+			Canceled,
+		};
+
+		const IAsset* asset = nullptr;
+
+		std::function<bool()> load;
+
+		std::function<void(AssetState)> setState;
+
+		Array<FilePath> files;
+
+		Array<AssetTag> tags;
+
+		// これらのロードが終わるまで、ロード処理を開始しない
+		Array<std::shared_ptr<AssetLoadJob>> dependencies;
+
+		// 以下はアセットローダーのロックで保護する
+
+		AssetLoadPriority priority = AssetLoadPriority::Normal;
+
+		Stage stage = Stage::WaitingForRead;
+
+		// 先読み中にキャンセルされた
+		bool cancelRequested = false;
+
+		std::exception_ptr exception;
+	};
+
+	/// @brief アセットの非同期ロードを、数を制限したスレッドで優先度順に行うクラス
+	/// @remark ファイルの先読みをする I/O スレッドと、ロード処理をするスレッドを分けて、ディスクと CPU の取り合いを抑えます。
+	class AssetLoader
+	{
+	public:
+
+		AssetLoader();
+
+		~AssetLoader();
+
+		/// @brief 次に `submit()` される `asset` のロードの優先度と依存先を設定します。
+		/// @remark `asset` のロードがすでに待機中の場合は、その優先度を変更します。
+		void setRequestOptions(const IAsset* asset, AssetLoadPriority priority, const Array<const IAsset*>& dependencies);
+
+		void clearRequestOptions(const IAsset* asset);
+
+		[[nodiscard]]
+		std::shared_ptr<AssetLoadJob> submit(const IAsset* asset, std::function<bool()> load, Array<FilePath> files, std::function<void(AssetState)> setState);
+
+		/// @brief ロードが終わるまで待機します。まだ開始されていない場合は、呼び出したスレッドでロードします。
+		void wait(const std::shared_ptr<AssetLoadJob>& job);
+
+		size_t cancel(const AssetTag& tag);
+
+		size_t cancelAll();
+
+		[[nodiscard]]
+		AssetLoadProgress getProgress() const;
+
+		/// @brief 待機中のロードをすべてキャンセルし、実行中のロードが終わるのを待ってスレッドを終了します。
+		void shutdown();
+
+	private:
+
+		struct RequestOptions
+		{
+			AssetLoadPriority priority = AssetLoadPriority::Normal;
+
+			Array<const IAsset*> dependencies;
+		};
+
+		using JobQueue = std::array<std::deque<std::shared_ptr<AssetLoadJob>>, 3>;
+
+		mutable std::mutex m_mutex;
+
+		std::condition_variable m_readCondition;
+
+		std::condition_variable m_loadCondition;
+
+		// ロードの段階が変わるたびに通知する
+		std::condition_variable m_stageCondition;
+
+		JobQueue m_readQueue;
+
+		JobQueue m_loadQueue;
+
+		HashTable<const IAsset*, RequestOptions> m_requestOptions;
+
+		// 終わっていないロード
+		HashTable<const IAsset*, std::shared_ptr<AssetLoadJob>> m_activeJobs;
+
+		AssetLoadProgress m_progress;
+
+		bool m_abort = false;
+
+		bool m_threadsStarted = false;
+
+		// メインスレッドでしか作成できないテクスチャを処理するため、作成したスレッドを記録する
+		std::thread::id m_mainThreadID;
+
+		Array<std::thread> m_readThreads;
+
+		Array<std::thread> m_loadThreads;
+
+		void startThreads();
+
+		void readThread();
+
+		void loadThread();
+
+		void run(AssetLoadJob& job);
+
+		void waitForCompletion(const std::shared_ptr<AssetLoadJob>& job, std::unique_lock<std::mutex>& lock);
+
+		void updateAsyncTextureLoad(std::unique_lock<std::mutex>& lock, size_t maxUpdate);
+
+		[[nodiscard]]
+		std::shared_ptr<AssetLoadJob> popJob(JobQueue& queue, bool checkDependencies);
+
+		bool removeJob(JobQueue& queue, const AssetLoadJob& job);
+
+		template <class Predicate>
+		size_t cancelIf(Predicate predicate);
+
+		void finish(AssetLoadJob& job, AssetLoadJob::Stage stage, bool succeeded);
+	};
+}
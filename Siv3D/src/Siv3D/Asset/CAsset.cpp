@@ -37,6 +37,17 @@ namespace s3d
 				return U"Unknown"_sv;
 			}
 		}
+
+		// タグを指定した非同期ロードの対象。シェーダはメインスレッド以外で作成できない場合があるため除く
+		inline constexpr std::array<AssetType, 3> TaggedLoadAssetTypes = { AssetType::Audio, AssetType::Texture, AssetType::Font };
+
+		[[nodiscard]]
+		static bool HasAnyTag(const IAsset& asset, const Array<AssetTag>& tags)
+		{
+			const Array<AssetTag>& assetTags = asset.getTags();
+
+			return tags.any([&assetTags](const AssetTag& tag) { return assetTags.contains(tag); });
+		}
 	}
 
 	CAsset::CAsset() {}
@@ -45,16 +56,8 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CAsset::~CAsset()");
 
-		SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(Largest<size_t>);
-
-		// wait for all
-		for (auto& assetList : m_assetLists)
-		{
-			for (auto& asset : assetList)
-			{
-				asset.second->wait();
-			}
-		}
+		// 待機中の非同期ロードをキャンセルし、実行中のものが終わるのを待つ
+		m_loader.shutdown();
 	}
 
 	void CAsset::update()
@@ -127,7 +130,7 @@ namespace s3d
 		return it->second->load(String{ hint });
 	}
 
-	void CAsset::loadAsync(const AssetType assetType, const AssetNameView name, const StringView hint)
+	void CAsset::loadAsync(const AssetType assetType, const AssetNameView name, const StringView hint, const AssetLoadPriority priority)
 	{
 		auto& assetList = m_assetLists[FromEnum(assetType)];
 		const auto it = assetList.find(name);
@@ -138,7 +141,7 @@ namespace s3d
 			return;
 		}
 
-		it->second->loadAsync(String{ hint });
+		loadAsync(*it->second, hint, priority, {});
 	}
 
 	void CAsset::wait(const AssetType assetType, const AssetNameView name)
@@ -244,4 +247,75 @@ namespace s3d
 
 		return result;
 	}
+
+	std::shared_ptr<AssetLoadJob> CAsset::submitAsyncLoad(const IAsset* asset, std::function<bool()> load, Array<FilePath> files, std::function<void(AssetState)> setState)
+	{
+		return m_loader.submit(asset, std::move(load), std::move(files), std::move(setState));
+	}
+
+	void CAsset::waitAsyncLoad(const std::shared_ptr<AssetLoadJob>& job)
+	{
+		m_loader.wait(job);
+	}
+
+	void CAsset::loadAsyncByTag(const AssetTag& tag, const Array<AssetTag>& dependencies, const AssetLoadPriority priority)
+	{
+		Array<const IAsset*> dependencyAssets;
+
+		// 依存先を先に要求する
+		if (dependencies)
+		{
+			for (const AssetType assetType : detail::TaggedLoadAssetTypes)
+			{
+				for (auto&& [name, asset] : m_assetLists[FromEnum(assetType)])
+				{
+					if (asset->getTags().contains(tag)
+						|| (not detail::HasAnyTag(*asset, dependencies)))
+					{
+						continue;
+					}
+
+					loadAsync(*asset, {}, priority, {});
+
+					dependencyAssets << asset.get();
+				}
+			}
+		}
+
+		for (const AssetType assetType : detail::TaggedLoadAssetTypes)
+		{
+			for (auto&& [name, asset] : m_assetLists[FromEnum(assetType)])
+			{
+				if (asset->getTags().contains(tag))
+				{
+					loadAsync(*asset, {}, priority, dependencyAssets);
+				}
+			}
+		}
+	}
+
+	size_t CAsset::cancelAsyncLoad(const AssetTag& tag)
+	{
+		return m_loader.cancel(tag);
+	}
+
+	size_t CAsset::cancelAsyncLoadAll()
+	{
+		return m_loader.cancelAll();
+	}
+
+	AssetLoadProgress CAsset::getLoadProgress() const
+	{
+		return m_loader.getProgress();
+	}
+
+	void CAsset::loadAsync(IAsset& asset, const StringView hint, const AssetLoadPriority priority, const Array<const IAsset*>& dependencies)
+	{
+		// すでに待機中の場合は、優先度だけが変更される
+		m_loader.setRequestOptions(&asset, priority, dependencies);
+
+		asset.loadAsync(String{ hint });
+
+		m_loader.clearRequestOptions(&asset);
+	}
 }
@@ -13,6 +13,7 @@
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/String.hpp>
 # include "IAsset.hpp"
+# include "AssetLoader.hpp"
 
 namespace s3d
 {
@@ -34,7 +35,7 @@ namespace s3d
 
 		bool load(AssetType assetType, AssetNameView name, StringView hint) override;
 
-		void loadAsync(AssetType assetType, AssetNameView name, StringView hint) override;
+		void loadAsync(AssetType assetType, AssetNameView name, StringView hint, AssetLoadPriority priority) override;
 
 		void wait(AssetType assetType, AssetNameView name) override;
 
@@ -50,8 +51,24 @@ namespace s3d
 
 		HashTable<AssetName, AssetInfo> enumerate(AssetType assetType) override;
 
+		std::shared_ptr<AssetLoadJob> submitAsyncLoad(const IAsset* asset, std::function<bool()> load, Array<FilePath> files, std::function<void(AssetState)> setState) override;
+
+		void waitAsyncLoad(const std::shared_ptr<AssetLoadJob>& job) override;
+
+		void loadAsyncByTag(const AssetTag& tag, const Array<AssetTag>& dependencies, AssetLoadPriority priority) override;
+
+		size_t cancelAsyncLoad(const AssetTag& tag) override;
+
+		size_t cancelAsyncLoadAll() override;
+
+		AssetLoadProgress getLoadProgress() const override;
+
 	private:
 
 		std::array<HashTable<String, std::unique_ptr<IAsset>>, 5> m_assetLists;
+
+		AssetLoader m_loader;
+
+		void loadAsync(IAsset& asset, StringView hint, AssetLoadPriority priority, const Array<const IAsset*>& dependencies);
 	};
 }
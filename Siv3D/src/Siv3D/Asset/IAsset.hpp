@@ -16,6 +16,8 @@
 
 namespace s3d
 {
+	struct AssetLoadJob;
+
 	enum class AssetType
 	{
 		Audio,
@@ -47,7 +49,7 @@ namespace s3d
 
 		virtual bool load(AssetType assetType, AssetNameView name, StringView hint) = 0;
 
-		virtual void loadAsync(AssetType assetType, AssetNameView name, StringView hint) = 0;
+		virtual void loadAsync(AssetType assetType, AssetNameView name, StringView hint, AssetLoadPriority priority) = 0;
 
 		virtual void wait(AssetType assetType, AssetNameView name) = 0;
 
@@ -62,5 +64,17 @@ namespace s3d
 		virtual void unregisterAll(AssetType assetType) = 0;
 
 		virtual HashTable<AssetName, AssetInfo> enumerate(AssetType assetType) = 0;
+
+		virtual std::shared_ptr<AssetLoadJob> submitAsyncLoad(const IAsset* asset, std::function<bool()> load, Array<FilePath> files, std::function<void(AssetState)> setState) = 0;
+
+		virtual void waitAsyncLoad(const std::shared_ptr<AssetLoadJob>& job) = 0;
+
+		virtual void loadAsyncByTag(const AssetTag& tag, const Array<AssetTag>& dependencies, AssetLoadPriority priority) = 0;
+
+		virtual size_t cancelAsyncLoad(const AssetTag& tag) = 0;
+
+		virtual size_t cancelAsyncLoadAll() = 0;
+
+		virtual AssetLoadProgress getLoadProgress() const = 0;
 	};
 }
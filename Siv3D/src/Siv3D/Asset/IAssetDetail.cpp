@@ -34,4 +34,29 @@ namespace s3d
 	{
 		return m_tags;
 	}
+
+	void IAsset::IAssetDetail::setJob(std::shared_ptr<AssetLoadJob> job)
+	{
+		std::lock_guard lock{ m_jobMutex };
+
+		m_job = std::move(job);
+	}
+
+	std::shared_ptr<AssetLoadJob> IAsset::IAssetDetail::getJob()
+	{
+		std::lock_guard lock{ m_jobMutex };
+
+		return m_job;
+	}
+
+	void IAsset::IAssetDetail::releaseJob(const std::shared_ptr<AssetLoadJob>& job)
+	{
+		std::lock_guard lock{ m_jobMutex };
+
+		// 待機している間に、次のロードが要求されている場合がある
+		if (m_job == job)
+		{
+			m_job = nullptr;
+		}
+	}
 }
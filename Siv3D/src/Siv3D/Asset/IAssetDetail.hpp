@@ -11,6 +11,7 @@
 
 # pragma once
 # include <Siv3D/Asset.hpp>
+# include "AssetLoader.hpp"
 
 namespace s3d
 {
@@ -32,10 +33,22 @@ namespace s3d
 		[[nodiscard]]
 		const Array<AssetTag>& getTags() const;
 
+		void setJob(std::shared_ptr<AssetLoadJob> job);
+
+		[[nodiscard]]
+		std::shared_ptr<AssetLoadJob> getJob();
+
+		/// @brief 現在のロードが `job` のままであれば、それを手放します。
+		void releaseJob(const std::shared_ptr<AssetLoadJob>& job);
+
 	private:
 
 		Array<String> m_tags;
 
 		std::atomic<AssetState> m_state = AssetState::Uninitialized;
+
+		std::mutex m_jobMutex;
+
+		std::shared_ptr<AssetLoadJob> m_job;
 	};
 }
@@ -10,7 +10,9 @@
 //-----------------------------------------------
 
 # include <Siv3D/Asset.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "IAssetDetail.hpp"
+# include "IAsset.hpp"
 
 namespace s3d
 {
@@ -59,4 +61,51 @@ namespace s3d
 	{
 		pImpl->setState(state);
 	}
+
+	void IAsset::requestAsyncLoad(std::function<bool()> loader, Array<FilePath> files)
+	{
+		setState(AssetState::AsyncLoading);
+
+		pImpl->setJob(SIV3D_ENGINE(Asset)->submitAsyncLoad(this, std::move(loader), std::move(files),
+			[this](const AssetState state) { setState(state); }));
+	}
+
+	void IAsset::waitAsyncLoad()
+	{
+		// 複数のスレッドが同時に待機しても、すべてがロードの終了まで待つ
+		if (const auto job = pImpl->getJob())
+		{
+			SIV3D_ENGINE(Asset)->waitAsyncLoad(job);
+
+			pImpl->releaseJob(job);
+		}
+	}
+
+	namespace Asset
+	{
+		void LoadAsync(const AssetTag& tag, const AssetLoadPriority priority)
+		{
+			SIV3D_ENGINE(Asset)->loadAsyncByTag(tag, {}, priority);
+		}
+
+		void LoadAsync(const AssetTag& tag, const Array<AssetTag>& dependencies, const AssetLoadPriority priority)
+		{
+			SIV3D_ENGINE(Asset)->loadAsyncByTag(tag, dependencies, priority);
+		}
+
+		size_t CancelLoadAsync(const AssetTag& tag)
+		{
+			return SIV3D_ENGINE(Asset)->cancelAsyncLoad(tag);
+		}
+
+		size_t CancelLoadAsyncAll()
+		{
+			return SIV3D_ENGINE(Asset)->cancelAsyncLoadAll();
+		}
+
+		AssetLoadProgress LoadProgress()
+		{
+			return SIV3D_ENGINE(Asset)->getLoadProgress();
+		}
+	}
 }
@@ -15,6 +15,7 @@
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Char.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AudioDecoder.hpp>
 # include "AudioData.hpp"
 # include "AudioBus.hpp"
 # include <ThirdParty/soloud/include/soloud_wav.h>
@@ -96,9 +97,18 @@ namespace s3d
 	{
 		std::unique_ptr<SoLoud::WavStream> source = std::make_unique<SoLoud::WavStream>();
 
+		// リソースパックに含まれるファイルは、マップされたメモリから読み込む
+		if (m_packed.open(path))
+		{
+			if (SoLoud::SO_NO_ERROR != source->loadMem(
+				static_cast<const unsigned char*>(m_packed.data()),
+				static_cast<uint32>(m_packed.size()), false, false))
+			{
+				return;
+			}
+		}
 	# if SIV3D_PLATFORM(WINDOWS)
-		
-		if (FileSystem::IsResource(path))
+		else if (FileSystem::IsResource(path))
 		{
 			m_resource = AudioResourceHolder{ path };
 
@@ -109,6 +119,7 @@ namespace s3d
 				return;
 			}
 		}
+	# endif
 		else
 		{
 			if (SoLoud::SO_NO_ERROR != source->load(path.narrow().c_str()))
@@ -117,15 +128,6 @@ namespace s3d
 			}
 		}
 
-	# else
-		
-		if (SoLoud::SO_NO_ERROR != source->load(path.narrow().c_str()))
-		{
-			return;
-		}
-
-	# endif
-
 		m_sampleRate	= static_cast<uint32>(source->mBaseSamplerate);
 		m_lengthSample	= source->mSampleCount;
 		m_audioSource	= std::move(source);
@@ -139,9 +141,18 @@ namespace s3d
 	{
 		std::unique_ptr<SoLoud::WavStream> source = std::make_unique<SoLoud::WavStream>();
 
+		// リソースパックに含まれるファイルは、マップされたメモリから読み込む
+		if (m_packed.open(path))
+		{
+			if (SoLoud::SO_NO_ERROR != source->loadMem(
+				static_cast<const unsigned char*>(m_packed.data()),
+				static_cast<uint32>(m_packed.size()), false, false))
+			{
+				return;
+			}
+		}
 	# if SIV3D_PLATFORM(WINDOWS)
-		
-		if (FileSystem::IsResource(path))
+		else if (FileSystem::IsResource(path))
 		{
 			m_resource = AudioResourceHolder{ path };
 
@@ -152,6 +163,7 @@ namespace s3d
 				return;
 			}
 		}
+	# endif
 		else
 		{
 			if (SoLoud::SO_NO_ERROR != source->load(path.narrow().c_str()))
@@ -160,15 +172,6 @@ namespace s3d
 			}
 		}
 
-	# else
-		
-		if (SoLoud::SO_NO_ERROR != source->load(path.narrow().c_str()))
-		{
-			return;
-		}
-
-	# endif
-
 		m_sampleRate	= static_cast<uint32>(source->mBaseSamplerate);
 		m_lengthSample	= source->mSampleCount;
 		m_audioSource	= std::move(source);
@@ -193,6 +196,32 @@ namespace s3d
 		m_initialized = true;
 	}
 
+	AudioData::AudioData(Prefetch, SoLoud::Soloud* pSoloud, const std::shared_ptr<PrefetchAudioStream>& pAudioStream, const FilePathView path, const AudioFormat format, const Optional<uint64>& loopBegin)
+		: m_prefetchStream{ pAudioStream }
+		, m_prefetchPath{ path }
+		, m_prefetchFormat{ format }
+		, m_pSoloud{ pSoloud }
+		, m_isStreaming{ true }
+		, m_loop{ loopBegin.has_value() }
+	{
+		if ((not pAudioStream) || (not pAudioStream->isOpen()))
+		{
+			return;
+		}
+
+		if (loopBegin)
+		{
+			m_loopTiming = { *loopBegin, 0 };
+			pAudioStream->setLoopBegin(*loopBegin);
+			pAudioStream->setLoop(true);
+		}
+
+		m_sampleRate	= pAudioStream->sampleRate();
+		m_lengthSample	= static_cast<uint32>(pAudioStream->samples());
+		m_audioSource	= std::make_unique<DynamicAudioSource>(pAudioStream, m_sampleRate);
+		m_initialized	= true;
+	}
+
 	AudioData::AudioData(TextToSpeech, SoLoud::Soloud* pSoloud, const StringView text, const KlattTTSParameters& param)
 		: m_pSoloud{ pSoloud }
 	{
@@ -292,12 +321,27 @@ namespace s3d
 			return;
 		}
 
-		m_audioSource->setLooping(loop);
+		if (m_prefetchStream)
+		{
+			m_prefetchStream->setLoop(loop);
+		}
+		else
+		{
+			m_audioSource->setLooping(loop);
+		}
+
 		m_loop = loop;
 	}
 	
 	void AudioData::setLoopPoint(const Duration& loopBegin)
 	{
+		if (m_prefetchStream)
+		{
+			m_loopTiming.beginPos = static_cast<uint64>(loopBegin.count() * m_sampleRate);
+			m_prefetchStream->setLoopBegin(m_loopTiming.beginPos);
+			return;
+		}
+
 		m_audioSource->setLoopPoint(loopBegin.count());
 		m_loopTiming.beginPos = static_cast<uint64>(loopBegin.count() / m_sampleRate);
 	}
@@ -308,6 +352,8 @@ namespace s3d
 		{
 			m_busIndex = static_cast<uint32>(busIndex);
 
+			seekPrefetchStream();
+
 			m_handle = SIV3D_ENGINE(Audio)->getBus(busIndex).getBus()
 				.play(*m_audioSource,
 					static_cast<float>(m_reservedSetting.volume),
@@ -339,6 +385,8 @@ namespace s3d
 		{
 			m_busIndex = static_cast<uint32>(busIndex);
 
+			seekPrefetchStream();
+
 			m_handle = SIV3D_ENGINE(Audio)->getBus(busIndex).getBus()
 				.play(*m_audioSource,
 					0.0f,
@@ -397,8 +445,20 @@ namespace s3d
 	{
 		clearInvalidShots();
 
+		// 先読みするストリームを共有すると再生位置が干渉するため、ワンショット再生ごとにストリームを作成する
+		std::unique_ptr<SoLoud::AudioSource> shotSource;
+
+		if (m_prefetchStream)
+		{
+			if (not (shotSource = createPrefetchShotSource()))
+			{
+				LOG_FAIL(U"❌ Audio::playOneShot(): Failed to open `{}`"_fmt(m_prefetchPath));
+				return;
+			}
+		}
+
 		const SoLoud::handle shotHandle = SIV3D_ENGINE(Audio)->getBus(busIndex).getBus()
-			.play(*m_audioSource,
+			.play((shotSource ? *shotSource : *m_audioSource),
 				static_cast<float>(volume),
 				static_cast<float>(pan), false);
 
@@ -410,6 +470,11 @@ namespace s3d
 		m_pSoloud->setPause(shotHandle, false);
 
 		m_shotHandles << shotHandle;
+
+		if (shotSource)
+		{
+			m_shotSources.emplace(shotHandle, std::move(shotSource));
+		}
 	}
 
 	void AudioData::pauseAllShots()
@@ -463,6 +528,7 @@ namespace s3d
 		}
 
 		m_shotHandles.clear();
+		m_shotSources.clear();
 	}
 
 	void AudioData::stopAllShots(const Duration& fadeTime)
@@ -490,6 +556,11 @@ namespace s3d
 			return m_reservedSetting.pos.count();
 		}
 
+		if (m_prefetchStream)
+		{
+			return (static_cast<double>(m_prefetchStream->posSample()) / m_sampleRate);
+		}
+
 		return m_pSoloud->getStreamPosition(m_handle);
 	}
 
@@ -511,6 +582,8 @@ namespace s3d
 		m_pSoloud->stop(m_handle);
 		m_handle = 0;
 
+		seekPrefetchStream();
+
 		{
 			m_handle = SIV3D_ENGINE(Audio)->getBus(m_busIndex).getBus()
 				.play(*m_audioSource,
@@ -543,6 +616,11 @@ namespace s3d
 			return 0;
 		}
 
+		if (m_prefetchStream)
+		{
+			return m_prefetchStream->loopCount();
+		}
+
 		return m_pSoloud->getLoopCount(m_handle);
 	}
 
@@ -649,5 +727,53 @@ namespace s3d
 			{
 				return (not m_pSoloud->isValidVoiceHandle(handle));
 			});
+
+		// 再生が終わったワンショット再生のストリームを破棄する
+		for (auto it = m_shotSources.begin(); it != m_shotSources.end();)
+		{
+			if (m_pSoloud->isValidVoiceHandle(it->first))
+			{
+				++it;
+			}
+			else
+			{
+				it = m_shotSources.erase(it);
+			}
+		}
+	}
+
+	void AudioData::seekPrefetchStream()
+	{
+		// 新しい再生は、前回の再生が終わった位置からではなく、指定された位置から始める
+		if (m_prefetchStream)
+		{
+			m_prefetchStream->seekSamples(static_cast<size_t>(m_reservedSetting.pos.count() * m_sampleRate));
+		}
+	}
+
+	std::unique_ptr<SoLoud::AudioSource> AudioData::createPrefetchShotSource() const
+	{
+		auto stream = AudioDecoder::OpenStream(m_prefetchPath, m_prefetchFormat);
+
+		if (not stream)
+		{
+			return nullptr;
+		}
+
+		auto pAudioStream = std::make_shared<PrefetchAudioStream>(std::move(stream));
+
+		if (not pAudioStream->isOpen())
+		{
+			return nullptr;
+		}
+
+		// ループの設定は通常の再生と同じにする
+		if (m_loop)
+		{
+			pAudioStream->setLoopBegin(m_loopTiming.beginPos);
+			pAudioStream->setLoop(true);
+		}
+
+		return std::make_unique<DynamicAudioSource>(pAudioStream, m_sampleRate);
 	}
 }
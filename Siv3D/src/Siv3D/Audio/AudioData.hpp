@@ -14,7 +14,9 @@
 # include <Siv3D/StringView.hpp>
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/Audio.hpp>
+# include <Siv3D/HashTable.hpp>
 # include <Siv3D/KlattTTSParameters.hpp>
+# include <Siv3D/PrefetchAudioStream.hpp>
 # include "AudioResourceHolder.hpp"
 # include <ThirdParty/soloud/include/soloud.h>
 
@@ -28,6 +30,8 @@ namespace s3d
 
 		struct Dynamic {};
 
+		struct Prefetch {};
+
 		struct TextToSpeech {};
 
 		AudioData() = default;
@@ -42,6 +46,8 @@ namespace s3d
 
 		AudioData(Dynamic, SoLoud::Soloud* pSoloud, const std::shared_ptr<IAudioStream>& pAudioStream, Arg::sampleRate_<uint32> sampleRate);
 
+		AudioData(Prefetch, SoLoud::Soloud* pSoloud, const std::shared_ptr<PrefetchAudioStream>& pAudioStream, FilePathView path, AudioFormat format, const Optional<uint64>& loopBegin);
+
 		AudioData(TextToSpeech, SoLoud::Soloud* pSoloud, StringView text, const KlattTTSParameters& param);
 
 		~AudioData();
@@ -148,8 +154,18 @@ namespace s3d
 
 	# endif
 
+		PackedAudioHolder m_packed;
+
 		std::unique_ptr<SoLoud::AudioSource> m_audioSource;
 
+		// ループと再生位置は SoLoud ではなくストリームが管理する
+		std::shared_ptr<PrefetchAudioStream> m_prefetchStream;
+
+		// ストリームは 1 つの再生位置しか持てないため、ワンショット再生ではファイルを開き直す
+		FilePath m_prefetchPath;
+
+		AudioFormat m_prefetchFormat = AudioFormat::Unspecified;
+
 		SoLoud::Soloud* m_pSoloud = nullptr;
 
 		Wave m_wave;
@@ -182,8 +198,16 @@ namespace s3d
 
 		Array<SoLoud::handle> m_shotHandles;
 
+		// ワンショット再生ごとに作成したストリームの AudioSource
+		HashTable<SoLoud::handle, std::unique_ptr<SoLoud::AudioSource>> m_shotSources;
+
 		bool m_initialized = false;
 
 		void clearInvalidShots();
+
+		void seekPrefetchStream();
+
+		[[nodiscard]]
+		std::unique_ptr<SoLoud::AudioSource> createPrefetchShotSource() const;
 	};
 }
@@ -12,6 +12,8 @@
 # pragma once
 # include <Siv3D/Common.hpp>
 # include <Siv3D/String.hpp>
+# include <Siv3D/Blob.hpp>
+# include <Siv3D/ResourcePack/ResourcePackDetail.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS)
 
@@ -72,3 +74,60 @@ namespace s3d
 }
 
 # endif
+
+namespace s3d
+{
+	// リソースパック内のオーディオファイルのデータを、ストリーミング再生の間保持する
+	class PackedAudioHolder
+	{
+	public:
+
+		bool open(const FilePathView path)
+		{
+			if (not m_reader.open(path))
+			{
+				return false;
+			}
+
+			// 圧縮されている場合はメモリ上に展開する
+			if (m_reader.data() == nullptr)
+			{
+				const int64 size = m_reader.size();
+
+				m_data.resize(static_cast<size_t>(size));
+
+				if (m_reader.read(m_data.data(), 0, size) != size)
+				{
+					m_reader.close();
+					m_data.release();
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		[[nodiscard]]
+		const void* data() const noexcept
+		{
+			if (const Byte* data = m_reader.data())
+			{
+				return data;
+			}
+
+			return m_data.data();
+		}
+
+		[[nodiscard]]
+		int64 size() const noexcept
+		{
+			return m_reader.size();
+		}
+
+	private:
+
+		detail::PackedFileReader m_reader;
+
+		Blob m_data;
+	};
+}
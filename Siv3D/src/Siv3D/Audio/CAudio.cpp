@@ -18,6 +18,7 @@
 # include <Siv3D/AudioDecoder.hpp>
 # include <Siv3D/KlattTTSParameters.hpp>
 # include <Siv3D/DLL.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include "CAudio.hpp"
 
 namespace s3d
@@ -204,6 +205,8 @@ namespace s3d
 
 	Audio::IDType CAudio::create(Wave&& wave, const Optional<AudioLoopTiming>& loop)
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::create");
+
 		if (not wave)
 		{
 			return Audio::IDType::NullAsset();
@@ -232,6 +235,8 @@ namespace s3d
 
 	Audio::IDType CAudio::createStreamingNonLoop(const FilePathView path)
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::createStreaming");
+
 		// ストリーミングに対応しない形式の場合のフォールバック
 		if (const AudioFormat format = AudioDecoder::GetAudioFormat(path);
 			(format != AudioFormat::WAVE)
@@ -239,6 +244,12 @@ namespace s3d
 			&& (format != AudioFormat::OggVorbis)
 			&& (format != AudioFormat::FLAC))
 		{
+			// 少しずつデコードできる形式は、バックグラウンドのスレッドで先読みしながら再生する
+			if (auto stream = AudioDecoder::OpenStream(path, format))
+			{
+				return createPrefetch(std::move(stream), path, format, none);
+			}
+
 			return create(Wave{ path }, none);
 		}
 
@@ -258,6 +269,8 @@ namespace s3d
 
 	Audio::IDType CAudio::createStreamingLoop(const FilePathView path, const uint64 loopBegin)
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::createStreaming");
+
 		// ストリーミングに対応しない形式の場合のフォールバック
 		if (const AudioFormat format = AudioDecoder::GetAudioFormat(path);
 			(format != AudioFormat::WAVE)
@@ -265,6 +278,12 @@ namespace s3d
 			&& (format != AudioFormat::OggVorbis)
 			&& (format != AudioFormat::FLAC))
 		{
+			// 少しずつデコードできる形式は、バックグラウンドのスレッドで先読みしながら再生する
+			if (auto stream = AudioDecoder::OpenStream(path, format))
+			{
+				return createPrefetch(std::move(stream), path, format, loopBegin);
+			}
+
 			return create(Wave{ path }, AudioLoopTiming{ loopBegin, 0 });
 		}
 
@@ -282,6 +301,24 @@ namespace s3d
 		return m_audios.add(std::move(audio), info);
 	}
 
+	Audio::IDType CAudio::createPrefetch(std::unique_ptr<IAudioDecoderStream>&& stream, const FilePathView path, const AudioFormat format, const Optional<uint64>& loopBegin)
+	{
+		auto pAudioStream = std::make_shared<PrefetchAudioStream>(std::move(stream));
+
+		// Audio を作成
+		auto audio = std::make_unique<AudioData>(AudioData::Prefetch{}, m_soloud.get(), pAudioStream, path, format, loopBegin);
+
+		if (not audio->isInitialized()) // もし作成に失敗していたら
+		{
+			return Audio::IDType::NullAsset();
+		}
+
+		const String info = detail::ToInfo(audio);
+
+		// Audio を管理に登録
+		return m_audios.add(std::move(audio), info);
+	}
+
 	Audio::IDType CAudio::createDynamic(const std::shared_ptr<IAudioStream>& pAudioStream, const Arg::sampleRate_<uint32> sampleRate)
 	{
 		// Audio を作成
@@ -195,5 +195,7 @@ namespace s3d
 		SoundTouchFunctions m_soundTouchFunctions;
 
 		std::unique_ptr<AudioData> m_speech;
+
+		Audio::IDType createPrefetch(std::unique_ptr<IAudioDecoderStream>&& stream, FilePathView path, AudioFormat format, const Optional<uint64>& loopBegin);
 	};
 }
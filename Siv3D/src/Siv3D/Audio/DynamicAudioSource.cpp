@@ -43,7 +43,17 @@ namespace s3d
 		}
 		
 		// Seek to certain place in the stream. Base implementation is generic "tape" seek (and slow).
-		//SoLoud::result seek(SoLoud::time aSeconds, float* mScratch, unsigned int mScratchSize) override;
+		SoLoud::result seek(SoLoud::time aSeconds, float* mScratch, unsigned int mScratchSize) override
+		{
+			if (mParent->m_pAudioStream->seekSamples(static_cast<size_t>(aSeconds * mBaseSamplerate)))
+			{
+				mStreamPosition = aSeconds;
+
+				return SoLoud::SO_NO_ERROR;
+			}
+
+			return AudioSourceInstance::seek(aSeconds, mScratch, mScratchSize);
+		}
 		
 		// Rewind stream. Base implementation returns NOT_IMPLEMENTED, meaning it can't rewind.
 		SoLoud::result rewind() override
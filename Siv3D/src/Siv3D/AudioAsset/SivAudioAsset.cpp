@@ -240,9 +240,9 @@ namespace s3d
 		return SIV3D_ENGINE(Asset)->load(AssetType::Audio, name, {});
 	}
 
-	void AudioAsset::LoadAsync(const AssetNameView name)
+	void AudioAsset::LoadAsync(const AssetNameView name, const AssetLoadPriority priority)
 	{
-		SIV3D_ENGINE(Asset)->loadAsync(AssetType::Audio, name, {});
+		SIV3D_ENGINE(Asset)->loadAsync(AssetType::Audio, name, {}, priority);
 	}
 
 	void AudioAsset::Wait(const AssetNameView name)
@@ -124,6 +124,32 @@ namespace s3d
 		return (*it)->decode(reader, {});
 	}
 
+	std::unique_ptr<IAudioDecoderStream> CAudioDecoder::openStream(std::unique_ptr<IReader>&& reader, const FilePathView pathHint, const AudioFormat audioFormat)
+	{
+		LOG_SCOPED_TRACE(U"CAudioDecoder::openStream()");
+
+		if (not reader)
+		{
+			return nullptr;
+		}
+
+		auto it = findDecoder(audioFormat);
+
+		if (it == m_decoders.end())
+		{
+			it = findDecoder(*reader, pathHint);
+
+			if (it == m_decoders.end())
+			{
+				return nullptr;
+			}
+		}
+
+		LOG_TRACE(U"Audio decoder name: {}"_fmt((*it)->name()));
+
+		return (*it)->openStream(std::move(reader));
+	}
+
 	bool CAudioDecoder::add(std::unique_ptr<IAudioDecoder>&& decoder)
 	{
 		const StringView name = decoder->name();
@@ -33,6 +33,8 @@ namespace s3d
 
 		Wave decode(IReader& reader, StringView decoderName) override;
 
+		std::unique_ptr<IAudioDecoderStream> openStream(std::unique_ptr<IReader>&& reader, FilePathView pathHint, AudioFormat audioFormat) override;
+
 		bool add(std::unique_ptr<IAudioDecoder>&& decoder) override;
 
 		void remove(StringView name) override;
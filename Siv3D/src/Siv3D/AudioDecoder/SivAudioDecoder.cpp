@@ -74,6 +74,27 @@ namespace s3d
 			return SIV3D_ENGINE(AudioDecoder)->decode(reader, decoderName);
 		}
 
+		std::unique_ptr<IAudioDecoderStream> OpenStream(const FilePathView path, const AudioFormat audioFormat)
+		{
+		# if SIV3D_PLATFORM(WEB)
+			Platform::Web::FetchFile(path);
+		# endif
+
+			auto reader = std::make_unique<BinaryReader>(path);
+
+			if (not reader->isOpen())
+			{
+				return nullptr;
+			}
+
+			return SIV3D_ENGINE(AudioDecoder)->openStream(std::move(reader), path, audioFormat);
+		}
+
+		std::unique_ptr<IAudioDecoderStream> OpenStream(std::unique_ptr<IReader>&& reader, const AudioFormat audioFormat)
+		{
+			return SIV3D_ENGINE(AudioDecoder)->openStream(std::move(reader), {}, audioFormat);
+		}
+
 		bool Add(std::unique_ptr<IAudioDecoder>&& decoder)
 		{
 			return SIV3D_ENGINE(AudioDecoder)->add(std::move(decoder));
@@ -89,6 +89,119 @@ namespace s3d
 
 			return static_cast<long>(reader->getPos());
 		}
+
+		class OggVorbisDecoderStream : public IAudioDecoderStream
+		{
+		public:
+
+			explicit OggVorbisDecoderStream(std::unique_ptr<IReader>&& reader)
+				: m_reader{ std::move(reader) }
+			{
+				ov_callbacks callbacks;
+				callbacks.read_func = ReadOgg_Callback;
+				callbacks.seek_func = SeekOgg_Callback;
+				callbacks.close_func = CloseOgg_Callback;
+				callbacks.tell_func = TellOgg_Callback;
+
+				if (::ov_open_callbacks(m_reader.get(), &m_file, nullptr, -1, callbacks) != 0)
+				{
+					return;
+				}
+
+				m_opened = true;
+
+				const vorbis_info* vi = ::ov_info(&m_file, -1);
+
+				if ((not vi) || ((vi->channels != 1) && (vi->channels != 2)))
+				{
+					return;
+				}
+
+				m_sampleRate = (vi->rate ? static_cast<uint32>(vi->rate) : Wave::DefaultSampleRate);
+
+				if (const ogg_int64_t total = ::ov_pcm_total(&m_file, -1);
+					0 < total)
+				{
+					m_samples = static_cast<size_t>(total);
+				}
+
+				m_initialized = true;
+			}
+
+			~OggVorbisDecoderStream() override
+			{
+				if (m_opened)
+				{
+					::ov_clear(&m_file);
+				}
+			}
+
+			[[nodiscard]]
+			bool isOpen() const noexcept
+			{
+				return m_initialized;
+			}
+
+			[[nodiscard]]
+			uint32 sampleRate() const override
+			{
+				return m_sampleRate;
+			}
+
+			[[nodiscard]]
+			size_t samples() const override
+			{
+				return m_samples;
+			}
+
+			size_t read(WaveSample* dst, const size_t count) override
+			{
+				size_t written = 0;
+
+				while (written < count)
+				{
+					float** pcm = nullptr;
+					int bitstream = 0;
+					const long result = ::ov_read_float(&m_file, &pcm,
+						static_cast<int>(Min<size_t>((count - written), INT32_MAX)), &bitstream);
+
+					if (result <= 0)
+					{
+						break;
+					}
+
+					const vorbis_info* vi = ::ov_info(&m_file, bitstream);
+					const float* pLeft = pcm[0];
+					const float* pRight = ((vi && (2 <= vi->channels)) ? pcm[1] : pcm[0]);
+
+					for (long i = 0; i < result; ++i)
+					{
+						dst[written++].set(pLeft[i], pRight[i]);
+					}
+				}
+
+				return written;
+			}
+
+			bool seek(const size_t posSample) override
+			{
+				return (::ov_pcm_seek(&m_file, static_cast<ogg_int64_t>(posSample)) == 0);
+			}
+
+		private:
+
+			std::unique_ptr<IReader> m_reader;
+
+			OggVorbis_File m_file{};
+
+			uint32 m_sampleRate = 0;
+
+			size_t m_samples = 0;
+
+			bool m_opened = false;
+
+			bool m_initialized = false;
+		};
 	}
 
 	StringView OggVorbisDecoder::name() const
@@ -241,6 +354,23 @@ namespace s3d
 		return wave;
 	}
 
+	std::unique_ptr<IAudioDecoderStream> OggVorbisDecoder::openStream(std::unique_ptr<IReader>&& reader) const
+	{
+		if ((not reader) || (not reader->isOpen()))
+		{
+			return nullptr;
+		}
+
+		auto stream = std::make_unique<detail::OggVorbisDecoderStream>(std::move(reader));
+
+		if (not stream->isOpen())
+		{
+			return nullptr;
+		}
+
+		return stream;
+	}
+
 	AudioLoopTiming OggVorbisDecoder::getLoopInfo(const FilePathView path) const
 	{
 		BinaryReader reader{ path };
@@ -26,6 +26,138 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		static int ReadOpus_Callback(void* stream, unsigned char* ptr, const int nbytes)
+		{
+			IReader* reader = static_cast<IReader*>(stream);
+
+			return static_cast<int>(reader->read(ptr, nbytes));
+		}
+
+		static int SeekOpus_Callback(void* stream, const opus_int64 offset, const int whence)
+		{
+			IReader* reader = static_cast<IReader*>(stream);
+
+			int64 pos = 0;
+
+			switch (whence)
+			{
+			case SEEK_CUR:
+				pos = (reader->getPos() + offset);
+				break;
+			case SEEK_END:
+				pos = (reader->size() + offset);
+				break;
+			case SEEK_SET:
+				pos = offset;
+				break;
+			default:
+				return -1;
+			}
+
+			if ((pos < 0) || (reader->size() < pos))
+			{
+				return -1;
+			}
+
+			return (reader->setPos(pos) ? 0 : -1);
+		}
+
+		static opus_int64 TellOpus_Callback(void* stream)
+		{
+			IReader* reader = static_cast<IReader*>(stream);
+
+			return reader->getPos();
+		}
+
+		class OpusDecoderStream : public IAudioDecoderStream
+		{
+		public:
+
+			explicit OpusDecoderStream(std::unique_ptr<IReader>&& reader)
+				: m_reader{ std::move(reader) }
+			{
+				const OpusFileCallbacks callbacks = { ReadOpus_Callback, SeekOpus_Callback, TellOpus_Callback, nullptr };
+
+				int err;
+				m_file = ::op_open_callbacks(m_reader.get(), &callbacks, nullptr, 0, &err);
+
+				if (not m_file)
+				{
+					return;
+				}
+
+				if (const ogg_int64_t total = ::op_pcm_total(m_file, -1);
+					0 < total)
+				{
+					m_samples = static_cast<size_t>(total);
+				}
+			}
+
+			~OpusDecoderStream() override
+			{
+				if (m_file)
+				{
+					::op_free(m_file);
+				}
+			}
+
+			[[nodiscard]]
+			bool isOpen() const noexcept
+			{
+				return (m_file != nullptr);
+			}
+
+			[[nodiscard]]
+			uint32 sampleRate() const override
+			{
+				// opusfile は元のサンプリングレートによらず 48 kHz でデコードする
+				return 48000;
+			}
+
+			[[nodiscard]]
+			size_t samples() const override
+			{
+				return m_samples;
+			}
+
+			size_t read(WaveSample* dst, const size_t count) override
+			{
+				size_t written = 0;
+
+				while (written < count)
+				{
+					// モノラルの場合も左右に同じ値が書き込まれる
+					const int32 result = ::op_read_float_stereo(m_file, &dst[written].left,
+						static_cast<int32>(Min<size_t>((count - written), (INT32_MAX / 2)) * 2));
+
+					if (result <= 0)
+					{
+						break;
+					}
+
+					written += result;
+				}
+
+				return written;
+			}
+
+			bool seek(const size_t posSample) override
+			{
+				return (::op_pcm_seek(m_file, static_cast<ogg_int64_t>(posSample)) == 0);
+			}
+
+		private:
+
+			std::unique_ptr<IReader> m_reader;
+
+			OggOpusFile* m_file = nullptr;
+
+			size_t m_samples = 0;
+		};
+	}
+
 	StringView OpusDecoder::name() const
 	{
 		return U"Opus"_sv;
@@ -149,4 +281,21 @@ namespace s3d
 
 		return wave;
 	}
+
+	std::unique_ptr<IAudioDecoderStream> OpusDecoder::openStream(std::unique_ptr<IReader>&& reader) const
+	{
+		if ((not reader) || (not reader->isOpen()))
+		{
+			return nullptr;
+		}
+
+		auto stream = std::make_unique<detail::OpusDecoderStream>(std::move(reader));
+
+		if (not stream->isOpen())
+		{
+			return nullptr;
+		}
+
+		return stream;
+	}
 }
@@ -0,0 +1,462 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <cmath>
+# include <limits>
+# include <numeric>
+# include <Siv3D/BroadPhase2D.hpp>
+# include <Siv3D/Geometry2D.hpp>
+# include <Siv3D/Formatter.hpp>
+# include <Siv3D/ParallelFor.hpp>
+# include <Siv3D/SIMD.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 並列に走査するときの、1 タスクあたりの走査の起点の数
+		inline constexpr size_t SweepGrainSize = 256;
+
+		// float に丸めても範囲が狭くならないように、下限は切り下げ、上限は切り上げる
+		[[nodiscard]]
+		static float ToFloatDown(const double value) noexcept
+		{
+			const float f = static_cast<float>(value);
+			return ((value < f) ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f);
+		}
+
+		[[nodiscard]]
+		static float ToFloatUp(const double value) noexcept
+		{
+			const float f = static_cast<float>(value);
+			return ((f < value) ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f);
+		}
+
+		[[nodiscard]]
+		static RectF BoundingRect(const Circle& shape) noexcept
+		{
+			return shape.boundingRect();
+		}
+
+		[[nodiscard]]
+		static RectF BoundingRect(const RectF& shape) noexcept
+		{
+			return shape;
+		}
+
+		[[nodiscard]]
+		static RectF BoundingRect(const Line& shape) noexcept
+		{
+			return shape.boundingRect();
+		}
+
+		/// @brief x 座標の下限でソートした境界ボックスの列
+		class SweepList
+		{
+		public:
+
+			template <class Shape>
+			void build(const Array<Shape>& shapes)
+			{
+				Array<Entry> entries(Arg::reserve = shapes.size());
+
+				for (size_t i = 0; i < shapes.size(); ++i)
+				{
+					const RectF rect = BoundingRect(shapes[i]);
+					const double x0 = Min(rect.x, (rect.x + rect.w));
+					const double x1 = Max(rect.x, (rect.x + rect.w));
+					const double y0 = Min(rect.y, (rect.y + rect.h));
+					const double y1 = Max(rect.y, (rect.y + rect.h));
+
+					// NaN を含む図形は何とも交差しない
+					if (std::isnan(x0) || std::isnan(x1) || std::isnan(y0) || std::isnan(y1))
+					{
+						continue;
+					}
+
+					entries.push_back({ ToFloatDown(x0), ToFloatUp(x1), ToFloatDown(y0), ToFloatUp(y1), static_cast<uint32>(i) });
+				}
+
+				std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return (a.minX < b.minX); });
+
+				const size_t count = entries.size();
+
+				// 4 要素ずつ読み込めるように、交差しない番兵を末尾に置く
+				const size_t paddedCount = (count + 4);
+				// 上限が +inf の要素とは番兵も交差しうるので、走査は m_count で打ち切る
+				m_minX.assign(paddedCount, std::numeric_limits<float>::infinity());
+				m_maxX.assign(paddedCount, -std::numeric_limits<float>::infinity());
+				m_minY.assign(paddedCount, std::numeric_limits<float>::infinity());
+				m_maxY.assign(paddedCount, -std::numeric_limits<float>::infinity());
+				m_indices.assign(paddedCount, 0);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					const Entry& entry = entries[i];
+					m_minX[i]		= entry.minX;
+					m_maxX[i]		= entry.maxX;
+					m_minY[i]		= entry.minY;
+					m_maxY[i]		= entry.maxY;
+					m_indices[i]	= entry.index;
+				}
+
+				m_count = count;
+			}
+
+			[[nodiscard]]
+			size_t size() const noexcept
+			{
+				return m_count;
+			}
+
+			/// @brief [first, last) の各要素について、それより後ろにあって境界ボックスが交差する要素を `f(index, index)` に渡します。
+			template <class Fty>
+			void sweep(const size_t first, const size_t last, Fty f) const
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					scan(i, *this, (i + 1), f);
+				}
+			}
+
+			/// @brief [first, last) の各要素について、`other` の中で境界ボックスが交差する要素を `f(index, otherIndex)` に渡します。
+			/// @param inclusive x 座標の下限が等しい要素を含める場合 true
+			/// @remark `other` のうち、x 座標の下限が自身以上（`inclusive` が false の場合は自身より大きい）の要素だけを調べます。
+			/// 2 つの列で `inclusive` を変えて互いに呼ぶと、すべての組を 1 回ずつ調べられます。
+			template <class Fty>
+			void sweep(const size_t first, const size_t last, const SweepList& other, const bool inclusive, Fty f) const
+			{
+				if (first == last)
+				{
+					return;
+				}
+
+				const auto otherBegin = other.m_minX.begin();
+				const auto otherEnd = (otherBegin + other.m_count);
+				size_t j = ((inclusive ? std::lower_bound(otherBegin, otherEnd, m_minX[first]) : std::upper_bound(otherBegin, otherEnd, m_minX[first])) - otherBegin);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					// 自身の minX は単調に増えるので、走査の開始位置も単調に進む
+					while ((j < other.m_count) && (inclusive ? (other.m_minX[j] < m_minX[i]) : (other.m_minX[j] <= m_minX[i])))
+					{
+						++j;
+					}
+
+					scan(i, other, j, f);
+				}
+			}
+
+		private:
+
+			struct Entry
+			{
+				float minX;
+				float maxX;
+				float minY;
+				float maxY;
+				uint32 index;
+			};
+
+			Array<float> m_minX;
+
+			Array<float> m_maxX;
+
+			Array<float> m_minY;
+
+			Array<float> m_maxY;
+
+			Array<uint32> m_indices;
+
+			size_t m_count = 0;
+
+			/// @brief `target` の j 番目以降で、i 番目の要素と境界ボックスが交差する要素を `f(index, targetIndex)` に渡します。
+			template <class Fty>
+			void scan(const size_t i, const SweepList& target, size_t j, Fty& f) const
+			{
+				const __m128 maxX = _mm_set1_ps(m_maxX[i]);
+				const __m128 minY = _mm_set1_ps(m_minY[i]);
+				const __m128 maxY = _mm_set1_ps(m_maxY[i]);
+				const uint32 index = m_indices[i];
+
+				for (; j < target.m_count; j += 4)
+				{
+					// 末尾の 4 要素に満たない部分では、番兵を除く
+					const int32 validMask = (((j + 4) <= target.m_count) ? 0b1111 : ((1 << (target.m_count - j)) - 1));
+
+					// minX でソートしているので、minX[j] <= maxX[i] を満たす要素は先頭から連続する
+					const int32 xMask = (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(target.m_minX.data() + j), maxX)) & validMask);
+
+					if (xMask == 0)
+					{
+						break;
+					}
+
+					const __m128 yOverlap = _mm_and_ps(
+						_mm_cmple_ps(_mm_loadu_ps(target.m_minY.data() + j), maxY),
+						_mm_cmpge_ps(_mm_loadu_ps(target.m_maxY.data() + j), minY));
+
+					int32 mask = (xMask & _mm_movemask_ps(yOverlap));
+
+					while (mask)
+					{
+						f(index, target.m_indices[j + std::countr_zero(static_cast<uint32>(mask))]);
+						mask &= (mask - 1);
+					}
+
+					if (xMask != 0b1111)
+					{
+						break;
+					}
+				}
+			}
+		};
+
+		/// @brief [0, count) を部分範囲に分けて `f(first, last, results)` を呼び、結果を連結して昇順に並べます。
+		template <class Fty>
+		[[nodiscard]]
+		static Array<BroadPhase2D::IndexPair> Sweep(const size_t count, const bool parallel, Fty f)
+		{
+			Array<BroadPhase2D::IndexPair> results;
+
+			if (not parallel)
+			{
+				f(0, count, results);
+			}
+			else
+			{
+				const size_t numChunks = ((count + (SweepGrainSize - 1)) / SweepGrainSize);
+
+				Array<Array<BroadPhase2D::IndexPair>> chunkResults(numChunks);
+
+				ParallelFor(0, numChunks, [&](const size_t chunk)
+					{
+						const size_t first = (chunk * SweepGrainSize);
+						f(first, Min((first + SweepGrainSize), count), chunkResults[chunk]);
+					}, 1);
+
+				results.reserve(std::accumulate(chunkResults.begin(), chunkResults.end(), size_t{ 0 },
+					[](const size_t sum, const Array<BroadPhase2D::IndexPair>& chunkResult) { return (sum + chunkResult.size()); }));
+
+				for (const auto& chunkResult : chunkResults)
+				{
+					results.append(chunkResult);
+				}
+			}
+
+			std::sort(results.begin(), results.end(), [](const BroadPhase2D::IndexPair& a, const BroadPhase2D::IndexPair& b)
+				{
+					return ((a.first < b.first) || ((a.first == b.first) && (a.second < b.second)));
+				});
+
+			return results;
+		}
+
+		template <class ShapeA, class ShapeB>
+		[[nodiscard]]
+		static Array<BroadPhase2D::IndexPair> FindIntersections(const Array<ShapeA>& a, const Array<ShapeB>& b, const bool parallel)
+		{
+			if (a.isEmpty() || b.isEmpty())
+			{
+				return{};
+			}
+
+			SweepList listA, listB;
+			listA.build(a);
+			listB.build(b);
+
+			const size_t sizeA = listA.size();
+
+			// a の各要素から b を、b の各要素から a を走査する
+			return Sweep((sizeA + listB.size()), parallel, [&](const size_t first, const size_t last, Array<BroadPhase2D::IndexPair>& results)
+				{
+					if (first < sizeA)
+					{
+						listA.sweep(first, Min(last, sizeA), listB, true, [&](const uint32 ia, const uint32 ib)
+							{
+								if (Geometry2D::Intersect(a[ia], b[ib]))
+								{
+									results.push_back({ ia, ib });
+								}
+							});
+					}
+
+					if (sizeA < last)
+					{
+						listB.sweep((Max(first, sizeA) - sizeA), (last - sizeA), listA, false, [&](const uint32 ib, const uint32 ia)
+							{
+								if (Geometry2D::Intersect(a[ia], b[ib]))
+								{
+									results.push_back({ ia, ib });
+								}
+							});
+					}
+				});
+		}
+
+		template <class Shape>
+		[[nodiscard]]
+		static Array<BroadPhase2D::IndexPair> FindIntersections(const Array<Shape>& shapes, const bool parallel)
+		{
+			if (shapes.size() < 2)
+			{
+				return{};
+			}
+
+			SweepList list;
+			list.build(shapes);
+
+			return Sweep(list.size(), parallel, [&](const size_t first, const size_t last, Array<BroadPhase2D::IndexPair>& results)
+				{
+					list.sweep(first, last, [&](const uint32 i, const uint32 j)
+						{
+							if (Geometry2D::Intersect(shapes[i], shapes[j]))
+							{
+								results.push_back({ Min(i, j), Max(i, j) });
+							}
+						});
+				});
+		}
+	}
+
+	namespace BroadPhase2D
+	{
+		void Formatter(FormatData& formatData, const IndexPair& value)
+		{
+			formatData.string.push_back(U'(');
+			Formatter(formatData, value.first);
+			formatData.string.append(U", "_sv);
+			Formatter(formatData, value.second);
+			formatData.string.push_back(U')');
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Circle>& a, const Array<Circle>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Circle>& a, const Array<RectF>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Circle>& a, const Array<Line>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<RectF>& a, const Array<Circle>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<RectF>& a, const Array<RectF>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<RectF>& a, const Array<Line>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Line>& a, const Array<Circle>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Line>& a, const Array<RectF>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Line>& a, const Array<Line>& b)
+		{
+			return detail::FindIntersections(a, b, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Circle>& shapes)
+		{
+			return detail::FindIntersections(shapes, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<RectF>& shapes)
+		{
+			return detail::FindIntersections(shapes, false);
+		}
+
+		Array<IndexPair> FindIntersections(const Array<Line>& shapes)
+		{
+			return detail::FindIntersections(shapes, false);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& a, const Array<Circle>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& a, const Array<RectF>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& a, const Array<Line>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& a, const Array<Circle>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& a, const Array<RectF>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& a, const Array<Line>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& a, const Array<Circle>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& a, const Array<RectF>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& a, const Array<Line>& b)
+		{
+			return detail::FindIntersections(a, b, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Circle>& shapes)
+		{
+			return detail::FindIntersections(shapes, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<RectF>& shapes)
+		{
+			return detail::FindIntersections(shapes, true);
+		}
+
+		Array<IndexPair> ParallelFindIntersections(const Array<Line>& shapes)
+		{
+			return detail::FindIntersections(shapes, true);
+		}
+	}
+}
@@ -0,0 +1,356 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include <Siv3D/ParallelFor.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "CSVViewDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static bool AddToSyntax(CSVViewSyntax& syntax, const StringView chars, const uint8 flag)
+		{
+			for (const char32 ch : chars)
+			{
+				if (0x7F < ch)
+				{
+					LOG_FAIL(U"❌ CSVView: Non-ASCII character U+{:04X} cannot be used as a separator, quote, or escape"_fmt(static_cast<uint32>(ch)));
+					return false;
+				}
+
+				syntax.table[ch] |= flag;
+			}
+
+			return true;
+		}
+
+		// boost::escaped_list_separator と同じ規則でフィールドを区切る。不正なエスケープシーケンスがあれば false を返す
+		static bool IndexFields(const char8* pLine, const size_t length, const CSVViewSyntax& syntax, Array<uint32>& fields)
+		{
+			// 空の行は 0 列
+			if (length == 0)
+			{
+				fields.push_back(1);
+				return true;
+			}
+
+			fields.push_back(0);
+
+			bool inQuote = false;
+
+			for (size_t i = 0; i < length; ++i)
+			{
+				const uint8 flags = syntax[pLine[i]];
+
+				if (flags == 0)
+				{
+					continue;
+				}
+
+				if (flags & CSVViewSyntax::Escape)
+				{
+					// TextReader は \r を取り除くため、エスケープ記号の直後の \r は読み飛ばす
+					do
+					{
+						++i;
+					} while ((i < length) && (pLine[i] == '\r'));
+
+					if ((i == length) || ((pLine[i] != 'n') && (syntax[pLine[i]] == 0)))
+					{
+						return false;
+					}
+				}
+				else if (flags & CSVViewSyntax::Separator)
+				{
+					if (not inQuote)
+					{
+						fields.push_back(static_cast<uint32>(i + 1));
+					}
+				}
+				else
+				{
+					inQuote = (not inQuote);
+				}
+			}
+
+			fields.push_back(static_cast<uint32>(length + 1));
+
+			return true;
+		}
+
+		Optional<CSVViewFormat> CSVViewFormat::Create(const StringView separators, const StringView quotes, const StringView escapes)
+		{
+			CSVViewFormat format;
+
+			if ((not AddToSyntax(format.syntax, separators, CSVViewSyntax::Separator))
+				|| (not AddToSyntax(format.syntax, quotes, CSVViewSyntax::Quote))
+				|| (not AddToSyntax(format.syntax, escapes, CSVViewSyntax::Escape)))
+			{
+				return none;
+			}
+
+			format.literalEscapes = format.syntax;
+
+			for (auto& flags : format.literalEscapes.table)
+			{
+				flags &= ~CSVViewSyntax::Escape;
+			}
+
+			return format;
+		}
+
+		const CSVViewSyntax* CSVViewFormat::indexLine(const char8* pLine, const size_t length, Array<uint32>& fields) const
+		{
+			// フィールドの位置は uint32 で表す
+			if (Largest<uint32> <= length)
+			{
+				LOG_FAIL(U"❌ CSVView: A line is too long ({} bytes)"_fmt(length));
+				return nullptr;
+			}
+
+			const size_t first = fields.size();
+
+			if (IndexFields(pLine, length, syntax, fields))
+			{
+				return &syntax;
+			}
+
+			fields.resize(first);
+
+			// エスケープ記号が無いため、必ず成功する
+			IndexFields(pLine, length, literalEscapes, fields);
+
+			return &literalEscapes;
+		}
+
+		size_t TrimCR(const char8* pLine, size_t length) noexcept
+		{
+			while (length && (pLine[length - 1] == '\r'))
+			{
+				--length;
+			}
+
+			return length;
+		}
+
+		Optional<size_t> GetBOMLength(const char8* pData, const size_t size) noexcept
+		{
+			const auto p = reinterpret_cast<const uint8*>(pData);
+
+			if ((3 <= size) && (p[0] == 0xEF) && (p[1] == 0xBB) && (p[2] == 0xBF))
+			{
+				return 3;
+			}
+
+			if ((2 <= size) && (((p[0] == 0xFF) && (p[1] == 0xFE)) || ((p[0] == 0xFE) && (p[1] == 0xFF))))
+			{
+				LOG_FAIL(U"❌ CSVView: UTF-16 files are not supported");
+				return none;
+			}
+
+			return 0;
+		}
+	}
+
+	CSVView::CSVViewDetail::CSVViewDetail() {}
+
+	CSVView::CSVViewDetail::~CSVViewDetail()
+	{
+		close();
+	}
+
+	bool CSVView::CSVViewDetail::open(const FilePathView path, const StringView separators, const StringView quotes, const StringView escapes)
+	{
+		close();
+
+		const auto format = detail::CSVViewFormat::Create(separators, quotes, escapes);
+
+		if (not format)
+		{
+			return false;
+		}
+
+		if (not m_file.open(path, MapAll::Yes))
+		{
+			LOG_FAIL(U"❌ CSVView: Failed to open `{}`"_fmt(path));
+			return false;
+		}
+
+		const size_t size = m_file.mappedSize();
+
+		if ((size == 0) && (0 < m_file.fileSize()))
+		{
+			LOG_FAIL(U"❌ CSVView: Failed to map `{}`"_fmt(path));
+			close();
+			return false;
+		}
+
+		m_format = *format;
+		m_pData = reinterpret_cast<const char8*>(m_file.data());
+
+		const auto bomLength = detail::GetBOMLength(m_pData, size);
+
+		if (not bomLength)
+		{
+			close();
+			return false;
+		}
+
+		// 行の途中で分割しないよう、各チャンクの終端を改行の直後に合わせる
+		Array<IndexChunk> chunks;
+
+		for (size_t begin = *bomLength; begin < size;)
+		{
+			size_t end = size;
+
+			if ((begin + IndexChunkSize) < size)
+			{
+				const size_t searchBegin = (begin + IndexChunkSize - 1);
+
+				if (const void* pNewLine = std::memchr((m_pData + searchBegin), '\n', (size - searchBegin)))
+				{
+					end = (static_cast<const char8*>(pNewLine) - m_pData + 1);
+				}
+			}
+
+			IndexChunk chunk;
+			chunk.begin	= begin;
+			chunk.end	= end;
+			chunks.push_back(std::move(chunk));
+
+			begin = end;
+		}
+
+		ParallelFor(0, chunks.size(), [&](const size_t i)
+		{
+			indexChunk(chunks[i]);
+		}, 1);
+
+		size_t numRows = 0, numFields = 0;
+
+		for (const auto& chunk : chunks)
+		{
+			if (not chunk.succeeded)
+			{
+				close();
+				return false;
+			}
+
+			numRows += chunk.rowOffsets.size();
+			numFields += chunk.fields.size();
+		}
+
+		m_rowOffsets.reserve(numRows);
+		m_rowFirstFields.reserve(numRows + 1);
+		m_fields.reserve(numFields);
+
+		for (const auto& chunk : chunks)
+		{
+			const uint64 fieldBase = m_fields.size();
+
+			for (const uint64 rowFirstField : chunk.rowFirstFields)
+			{
+				m_rowFirstFields.push_back(fieldBase + rowFirstField);
+			}
+
+			m_rowOffsets.append(chunk.rowOffsets);
+			m_fields.append(chunk.fields);
+		}
+
+		m_rowFirstFields.push_back(m_fields.size());
+
+		return true;
+	}
+
+	void CSVView::CSVViewDetail::close()
+	{
+		m_file.close();
+		m_pData = nullptr;
+		m_rowOffsets.clear();
+		m_rowFirstFields.clear();
+		m_fields.clear();
+	}
+
+	bool CSVView::CSVViewDetail::isOpen() const noexcept
+	{
+		return m_file.isOpen();
+	}
+
+	size_t CSVView::CSVViewDetail::rows() const noexcept
+	{
+		return m_rowOffsets.size();
+	}
+
+	size_t CSVView::CSVViewDetail::columns(const size_t row) const noexcept
+	{
+		if (m_rowOffsets.size() <= row)
+		{
+			return 0;
+		}
+
+		return static_cast<size_t>(m_rowFirstFields[row + 1] - m_rowFirstFields[row] - 1);
+	}
+
+	const char8* CSVView::CSVViewDetail::line(const size_t row) const noexcept
+	{
+		return (m_pData + (m_rowOffsets[row] & ~LiteralEscapesBit));
+	}
+
+	const uint32* CSVView::CSVViewDetail::fields(const size_t row) const noexcept
+	{
+		return (m_fields.data() + m_rowFirstFields[row]);
+	}
+
+	const detail::CSVViewSyntax* CSVView::CSVViewDetail::syntax(const size_t row) const noexcept
+	{
+		return ((m_rowOffsets[row] & LiteralEscapesBit) ? &m_format.literalEscapes : &m_format.syntax);
+	}
+
+	const FilePath& CSVView::CSVViewDetail::path() const noexcept
+	{
+		return m_file.path();
+	}
+
+	void CSVView::CSVViewDetail::indexChunk(IndexChunk& chunk) const
+	{
+		size_t pos = chunk.begin;
+
+		while (pos < chunk.end)
+		{
+			const char8* pLine = (m_pData + pos);
+			const void* pNewLine = std::memchr(pLine, '\n', (chunk.end - pos));
+			const size_t lineEnd = (pNewLine ? static_cast<size_t>(static_cast<const char8*>(pNewLine) - m_pData) : chunk.end);
+			const size_t length = detail::TrimCR(pLine, (lineEnd - pos));
+
+			// 改行で終わらない最後の行は、空でない場合のみ数える（TextReader::readLine() と同じ）
+			if (pNewLine || length)
+			{
+				chunk.rowFirstFields.push_back(chunk.fields.size());
+
+				const detail::CSVViewSyntax* pSyntax = m_format.indexLine(pLine, length, chunk.fields);
+
+				if (not pSyntax)
+				{
+					chunk.succeeded = false;
+					return;
+				}
+
+				chunk.rowOffsets.push_back((pSyntax == &m_format.literalEscapes) ? (pos | LiteralEscapesBit) : pos);
+			}
+
+			pos = (lineEnd + 1);
+		}
+	}
+}
@@ -0,0 +1,138 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/CSVView.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 バイトの文字がセパレータ・クオーテーション記号・エスケープ記号であるかを引く表
+		struct CSVViewSyntax
+		{
+			enum : uint8
+			{
+				Separator	= (1 << 0),
+
+				Quote		= (1 << 1),
+
+				Escape		= (1 << 2),
+			};
+
+			std::array<uint8, 256> table{};
+
+			[[nodiscard]]
+			uint8 operator [](const char8 ch) const noexcept
+			{
+				return table[static_cast<uint8>(ch)];
+			}
+		};
+
+		// 不正なエスケープシーケンスを含む行は、CSV と同じくエスケープ記号を通常の文字として扱う
+		struct CSVViewFormat
+		{
+			CSVViewSyntax syntax;
+
+			CSVViewSyntax literalEscapes;
+
+			[[nodiscard]]
+			static Optional<CSVViewFormat> Create(StringView separators, StringView quotes, StringView escapes);
+
+			// 1 行を解析し、各フィールドの開始位置と、最後のフィールドの終端 + 1 を fields に追加する。
+			// 行の解析に使った表を返す。行が長すぎる場合は nullptr
+			const CSVViewSyntax* indexLine(const char8* pLine, size_t length, Array<uint32>& fields) const;
+		};
+
+		// 行末の \r を除いた長さを返す
+		[[nodiscard]]
+		size_t TrimCR(const char8* pLine, size_t length) noexcept;
+
+		// UTF-8 の BOM の長さを返す。UTF-16 の BOM がある場合は none
+		[[nodiscard]]
+		Optional<size_t> GetBOMLength(const char8* pData, size_t size) noexcept;
+	}
+
+	class CSVView::CSVViewDetail
+	{
+	public:
+
+		CSVViewDetail();
+
+		~CSVViewDetail();
+
+		bool open(FilePathView path, StringView separators, StringView quotes, StringView escapes);
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		size_t rows() const noexcept;
+
+		[[nodiscard]]
+		size_t columns(size_t row) const noexcept;
+
+		[[nodiscard]]
+		const char8* line(size_t row) const noexcept;
+
+		[[nodiscard]]
+		const uint32* fields(size_t row) const noexcept;
+
+		[[nodiscard]]
+		const detail::CSVViewSyntax* syntax(size_t row) const noexcept;
+
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		// 行の開始位置の最上位ビットに、エスケープ記号を通常の文字として扱う行であるかを格納する
+		static constexpr uint64 LiteralEscapesBit = (uint64{ 1 } << 63);
+
+		// 1 タスクで索引を作る、ファイルの大きさの目安
+		static constexpr size_t IndexChunkSize = (4 * 1024 * 1024);
+
+		struct IndexChunk
+		{
+			size_t begin = 0;
+
+			size_t end = 0;
+
+			Array<uint64> rowOffsets;
+
+			// チャンク内での、各行の最初のフィールドのインデックス
+			Array<uint64> rowFirstFields;
+
+			Array<uint32> fields;
+
+			bool succeeded = true;
+		};
+
+		MemoryMappedFileView m_file;
+
+		detail::CSVViewFormat m_format;
+
+		const char8* m_pData = nullptr;
+
+		// 各行の開始位置
+		Array<uint64> m_rowOffsets;
+
+		// 各行の最初のフィールドの m_fields 内でのインデックス。末尾に m_fields.size() を加えた rows() + 1 要素
+		Array<uint64> m_rowFirstFields;
+
+		Array<uint32> m_fields;
+
+		void indexChunk(IndexChunk& chunk) const;
+	};
+}
@@ -0,0 +1,301 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include <Siv3D/CSVView.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Unicode/UnicodeKernels.hpp>
+# include <Siv3D/CSVView/CSVViewDetail.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// ForEachRow() で一度にメモリマップする大きさ
+		inline constexpr size_t CSVViewStreamingWindowSize = (64 * 1024 * 1024);
+
+		[[nodiscard]]
+		static bool HasSpecialCharacters(const std::string_view raw, const CSVViewSyntax& syntax) noexcept
+		{
+			for (const char8 ch : raw)
+			{
+				if (syntax[ch] || (ch == '\r'))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// クオーテーション記号を取り除き、エスケープシーケンスを展開する。書き込んだ長さを返す
+		// 出力は入力よりも長くならない
+		static size_t DecodeField(const std::string_view raw, const CSVViewSyntax& syntax, char8* pDst) noexcept
+		{
+			char8* const pDstBegin = pDst;
+
+			for (size_t i = 0; i < raw.size(); ++i)
+			{
+				const char8 ch = raw[i];
+
+				// TextReader は \r を取り除く
+				if (ch == '\r')
+				{
+					continue;
+				}
+
+				const uint8 flags = syntax[ch];
+
+				if (flags & CSVViewSyntax::Escape)
+				{
+					do
+					{
+						++i;
+					} while ((i < raw.size()) && (raw[i] == '\r'));
+
+					if (i < raw.size())
+					{
+						*pDst++ = ((raw[i] == 'n') ? '\n' : raw[i]);
+					}
+				}
+				else if ((flags & CSVViewSyntax::Quote) && (not (flags & CSVViewSyntax::Separator)))
+				{
+					continue;
+				}
+				else
+				{
+					*pDst++ = ch;
+				}
+			}
+
+			return static_cast<size_t>(pDst - pDstBegin);
+		}
+	}
+
+	std::string_view CSVRowView::getRaw(const size_t column) const noexcept
+	{
+		if (m_columns <= column)
+		{
+			return{};
+		}
+
+		const uint32 begin = m_pFields[column];
+		const uint32 end = (m_pFields[column + 1] - 1);
+
+		return{ (m_pLine + begin), (end - begin) };
+	}
+
+	Array<String> CSVRowView::asArray() const
+	{
+		Array<String> result(Arg::reserve = m_columns);
+
+		for (size_t i = 0; i < m_columns; ++i)
+		{
+			result.push_back(*getItem(i));
+		}
+
+		return result;
+	}
+
+	Optional<String> CSVRowView::getItem(const size_t column) const
+	{
+		if (m_columns <= column)
+		{
+			return none;
+		}
+
+		const std::string_view raw = getRaw(column);
+
+		if (not detail::HasSpecialCharacters(raw, *m_pSyntax))
+		{
+			return Unicode::FromUTF8(raw);
+		}
+
+		std::string buffer(raw.size(), '\0');
+		buffer.resize(detail::DecodeField(raw, *m_pSyntax, buffer.data()));
+
+		return Unicode::FromUTF8(buffer);
+	}
+
+	Optional<size_t> CSVRowView::getSmallItem(const size_t column, char32* pDst) const
+	{
+		if (m_columns <= column)
+		{
+			return none;
+		}
+
+		const std::string_view raw = getRaw(column);
+
+		if (detail::CSVViewSmallFieldLength < raw.size())
+		{
+			return none;
+		}
+
+		char8 buffer[detail::CSVViewSmallFieldLength];
+		const size_t length = detail::DecodeField(raw, *m_pSyntax, buffer);
+
+		// UTF-32 の要素数は UTF-8 のバイト数を超えない
+		return static_cast<size_t>(UnicodeKernels::UTF8ToUTF32(buffer, length, pDst) - pDst);
+	}
+
+	CSVView::CSVView()
+		: pImpl{ std::make_shared<CSVViewDetail>() } {}
+
+	CSVView::CSVView(const FilePathView path, const StringView separators, const StringView quotes, const StringView escapes)
+		: CSVView{}
+	{
+		open(path, separators, quotes, escapes);
+	}
+
+	bool CSVView::open(const FilePathView path, const StringView separators, const StringView quotes, const StringView escapes)
+	{
+		return pImpl->open(path, separators, quotes, escapes);
+	}
+
+	void CSVView::close()
+	{
+		pImpl->close();
+	}
+
+	bool CSVView::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	size_t CSVView::rows() const noexcept
+	{
+		return pImpl->rows();
+	}
+
+	size_t CSVView::columns(const size_t row) const noexcept
+	{
+		return pImpl->columns(row);
+	}
+
+	CSVRowView CSVView::getRow(const size_t row) const noexcept
+	{
+		if (pImpl->rows() <= row)
+		{
+			return{};
+		}
+
+		return{ pImpl->line(row), pImpl->fields(row), pImpl->columns(row), pImpl->syntax(row) };
+	}
+
+	const FilePath& CSVView::path() const noexcept
+	{
+		return pImpl->path();
+	}
+
+	bool CSVView::ForEachRow(const FilePathView path, const std::function<void(const CSVRowView&)>& callback,
+		const StringView separators, const StringView quotes, const StringView escapes)
+	{
+		const auto format = detail::CSVViewFormat::Create(separators, quotes, escapes);
+
+		if (not format)
+		{
+			return false;
+		}
+
+		MemoryMappedFileView file{ path, MapAll::No };
+
+		if (not file)
+		{
+			LOG_FAIL(U"❌ CSVView: Failed to open `{}`"_fmt(path));
+			return false;
+		}
+
+		const size_t fileSize = static_cast<size_t>(file.fileSize());
+		size_t windowSize = detail::CSVViewStreamingWindowSize;
+		size_t offset = 0;
+		Array<uint32> fields;
+
+		while (offset < fileSize)
+		{
+			file.map(offset, windowSize);
+
+			const char8* pData = reinterpret_cast<const char8*>(file.data());
+			const size_t size = file.mappedSize();
+
+			if (not pData)
+			{
+				LOG_FAIL(U"❌ CSVView: Failed to map `{}`"_fmt(path));
+				return false;
+			}
+
+			size_t begin = 0;
+
+			if (offset == 0)
+			{
+				if (const auto bomLength = detail::GetBOMLength(pData, size))
+				{
+					begin = *bomLength;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			const bool isLastWindow = ((offset + size) == fileSize);
+			size_t pos = begin;
+
+			while (pos < size)
+			{
+				const char8* pLine = (pData + pos);
+				const void* pNewLine = std::memchr(pLine, '\n', (size - pos));
+
+				// 行の途中で切れている場合は、次のウィンドウで読む
+				if ((not pNewLine) && (not isLastWindow))
+				{
+					break;
+				}
+
+				const size_t lineEnd = (pNewLine ? static_cast<size_t>(static_cast<const char8*>(pNewLine) - pData) : size);
+				const size_t length = detail::TrimCR(pLine, (lineEnd - pos));
+
+				if (pNewLine || length)
+				{
+					fields.clear();
+
+					const detail::CSVViewSyntax* pSyntax = format->indexLine(pLine, length, fields);
+
+					if (not pSyntax)
+					{
+						return false;
+					}
+
+					callback(CSVRowView{ pLine, fields.data(), (fields.size() - 1), pSyntax });
+				}
+
+				pos = (lineEnd + 1);
+			}
+
+			if (isLastWindow)
+			{
+				break;
+			}
+
+			// ウィンドウに収まらない長さの行がある場合は、ウィンドウを大きくする
+			if (pos == begin)
+			{
+				windowSize *= 2;
+				continue;
+			}
+
+			offset += pos;
+		}
+
+		return true;
+	}
+}
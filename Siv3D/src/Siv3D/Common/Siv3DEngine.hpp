@@ -21,6 +21,7 @@ namespace s3d
 	class ISiv3DSystem;
 	class ISiv3DResource;
 	class ISiv3DProfiler;
+	class ISiv3DThreadPool;
 	class ISiv3DAssetMonitor;
 	class ISiv3DUserAction;
 	class ISiv3DWindow;
@@ -77,6 +78,7 @@ namespace s3d
 			Siv3DComponent<ISiv3DSystem>,
 			Siv3DComponent<ISiv3DResource>,
 			Siv3DComponent<ISiv3DProfiler>,
+			Siv3DComponent<ISiv3DThreadPool>,
 			Siv3DComponent<ISiv3DAssetMonitor>,
 			Siv3DComponent<ISiv3DUserAction>,
 			Siv3DComponent<ISiv3DWindow>,
@@ -0,0 +1,331 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Compression.hpp>
+# include <Siv3D/Zlib.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "CompressionWriterDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// zlib で一度に書き出す圧縮データの大きさ
+		inline constexpr size_t ZlibOutputBufferSize = (64 * 1024);
+
+		// z_stream::avail_in は 32-bit のため、大きな入力は分割して渡す
+		inline constexpr size_t ZlibMaxInputSize = (1u << 30);
+	}
+
+	CompressionWriter::CompressionWriterDetail::CompressionWriterDetail()
+	{
+		// do nothing
+	}
+
+	CompressionWriter::CompressionWriterDetail::~CompressionWriterDetail()
+	{
+		close();
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::open(std::unique_ptr<IWriter>&& writer, const CompressionFormat format, const int32 compressionLevel, const int32 numWorkers)
+	{
+		close();
+
+		if ((not writer) || (not writer->isOpen()))
+		{
+			return false;
+		}
+
+		m_format = format;
+
+		if (format == CompressionFormat::Zstandard)
+		{
+			if (not initZstd(compressionLevel, numWorkers))
+			{
+				return false;
+			}
+
+			m_buffer.resize(ZSTD_CStreamOutSize());
+		}
+		else
+		{
+			if (not initZlib(compressionLevel))
+			{
+				return false;
+			}
+
+			m_buffer.resize(detail::ZlibOutputBufferSize);
+		}
+
+		m_writer = std::move(writer);
+		m_size = 0;
+		m_compressedSize = 0;
+
+		return true;
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::close()
+	{
+		if (not m_writer)
+		{
+			return false;
+		}
+
+		const bool result = compress(nullptr, 0, Mode::End);
+
+		release();
+
+		// BinaryWriter などの書き込み先は、ここで閉じられる
+		m_writer.reset();
+
+		return result;
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::isOpen() const noexcept
+	{
+		return static_cast<bool>(m_writer);
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::flush()
+	{
+		if (not m_writer)
+		{
+			return false;
+		}
+
+		return compress(nullptr, 0, Mode::Flush);
+	}
+
+	int64 CompressionWriter::CompressionWriterDetail::size() const noexcept
+	{
+		return m_size;
+	}
+
+	int64 CompressionWriter::CompressionWriterDetail::write(const void* src, const int64 sizeBytes)
+	{
+		if ((not m_writer) || (sizeBytes <= 0))
+		{
+			return 0;
+		}
+
+		if (not compress(src, static_cast<size_t>(sizeBytes), Mode::Continue))
+		{
+			return 0;
+		}
+
+		m_size += sizeBytes;
+
+		return sizeBytes;
+	}
+
+	int64 CompressionWriter::CompressionWriterDetail::compressedSize() const noexcept
+	{
+		return m_compressedSize;
+	}
+
+	CompressionFormat CompressionWriter::CompressionWriterDetail::format() const noexcept
+	{
+		return m_format;
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::initZstd(const int32 compressionLevel, const int32 numWorkers)
+	{
+		m_zstd = ZSTD_createCCtx();
+
+		if (not m_zstd)
+		{
+			LOG_FAIL(U"❌ CompressionWriter: ZSTD_createCCtx() failed");
+			return false;
+		}
+
+		const int32 level = ((compressionLevel == DefaultLevel) ? Compression::DefaultLevel
+			: Clamp(compressionLevel, Compression::MinLevel, Compression::MaxLevel));
+
+		if (ZSTD_isError(ZSTD_CCtx_setParameter(m_zstd, ZSTD_c_compressionLevel, level)))
+		{
+			LOG_FAIL(U"❌ CompressionWriter: Failed to set the compression level {}"_fmt(level));
+			release();
+			return false;
+		}
+
+		if (0 < numWorkers)
+		{
+			// ZSTD_MULTITHREAD なしでビルドされた zstd では失敗するため、その場合はこのスレッドで圧縮する
+			if (const size_t result = ZSTD_CCtx_setParameter(m_zstd, ZSTD_c_nbWorkers, numWorkers);
+				ZSTD_isError(result))
+			{
+				LOG_INFO(U"ℹ️ CompressionWriter: Multi-threaded compression is not available ({}). Compressing on the calling thread"_fmt(Unicode::Widen(ZSTD_getErrorName(result))));
+			}
+		}
+
+		return true;
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::initZlib(const int32 compressionLevel)
+	{
+		const int32 level = ((compressionLevel == DefaultLevel) ? Zlib::DefaultCompressionLevel
+			: Clamp(compressionLevel, Zlib::MinCompressionLevel, Zlib::MaxCompressionLevel));
+
+		m_zlib = z_stream{};
+
+		if (deflateInit(&m_zlib, level) != Z_OK)
+		{
+			LOG_FAIL(U"❌ CompressionWriter: deflateInit() failed");
+			return false;
+		}
+
+		m_zlibInitialized = true;
+
+		return true;
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::compress(const void* src, const size_t sizeBytes, const Mode mode)
+	{
+		if (m_format == CompressionFormat::Zstandard)
+		{
+			return compressZstd(src, sizeBytes, mode);
+		}
+		else
+		{
+			return compressZlib(src, sizeBytes, mode);
+		}
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::compressZstd(const void* src, const size_t sizeBytes, const Mode mode)
+	{
+		const ZSTD_EndDirective directive = ((mode == Mode::Continue) ? ZSTD_e_continue
+			: (mode == Mode::Flush) ? ZSTD_e_flush : ZSTD_e_end);
+
+		ZSTD_inBuffer input{ src, sizeBytes, 0 };
+
+		for (;;)
+		{
+			ZSTD_outBuffer outBuffer{ m_buffer.data(), m_buffer.size(), 0 };
+
+			const size_t remaining = ZSTD_compressStream2(m_zstd, &outBuffer, &input, directive);
+
+			if (ZSTD_isError(remaining))
+			{
+				LOG_FAIL(U"❌ CompressionWriter: ZSTD_compressStream2() failed ({})"_fmt(Unicode::Widen(ZSTD_getErrorName(remaining))));
+				return false;
+			}
+
+			if (not output(outBuffer.pos))
+			{
+				return false;
+			}
+
+			if (mode == Mode::Continue)
+			{
+				if (input.pos == input.size)
+				{
+					return true;
+				}
+			}
+			else if (remaining == 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::compressZlib(const void* src, size_t sizeBytes, const Mode mode)
+	{
+		const int32 flush = ((mode == Mode::Continue) ? Z_NO_FLUSH
+			: (mode == Mode::Flush) ? Z_SYNC_FLUSH : Z_FINISH);
+
+		const Byte* pSrc = static_cast<const Byte*>(src);
+
+		do
+		{
+			const size_t inputSize = Min(sizeBytes, detail::ZlibMaxInputSize);
+			m_zlib.next_in = reinterpret_cast<::Bytef*>(const_cast<Byte*>(pSrc));
+			m_zlib.avail_in = static_cast<uInt>(inputSize);
+			pSrc += inputSize;
+			sizeBytes -= inputSize;
+
+			// 分割した入力の途中ではフラッシュしない
+			const int32 currentFlush = (sizeBytes ? Z_NO_FLUSH : flush);
+
+			for (;;)
+			{
+				m_zlib.next_out = reinterpret_cast<::Bytef*>(m_buffer.data());
+				m_zlib.avail_out = static_cast<uInt>(m_buffer.size());
+
+				const int32 result = deflate(&m_zlib, currentFlush);
+
+				if (result == Z_STREAM_ERROR)
+				{
+					LOG_FAIL(U"❌ CompressionWriter: deflate() failed");
+					return false;
+				}
+
+				if (not output(m_buffer.size() - m_zlib.avail_out))
+				{
+					return false;
+				}
+
+				if (currentFlush == Z_FINISH)
+				{
+					if (result == Z_STREAM_END)
+					{
+						break;
+					}
+				}
+				else if (m_zlib.avail_out != 0)
+				{
+					break;
+				}
+			}
+
+		} while (sizeBytes);
+
+		return true;
+	}
+
+	bool CompressionWriter::CompressionWriterDetail::output(const size_t sizeBytes)
+	{
+		if (sizeBytes == 0)
+		{
+			return true;
+		}
+
+		if (m_writer->write(m_buffer.data(), static_cast<int64>(sizeBytes)) != static_cast<int64>(sizeBytes))
+		{
+			LOG_FAIL(U"❌ CompressionWriter: Failed to write compressed data");
+			return false;
+		}
+
+		m_compressedSize += sizeBytes;
+
+		return true;
+	}
+
+	void CompressionWriter::CompressionWriterDetail::release()
+	{
+		if (m_zstd)
+		{
+			ZSTD_freeCCtx(m_zstd);
+			m_zstd = nullptr;
+		}
+
+		if (m_zlibInitialized)
+		{
+			deflateEnd(&m_zlib);
+			m_zlibInitialized = false;
+		}
+
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+	}
+}
@@ -0,0 +1,94 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/CompressionWriter.hpp>
+# include <Siv3D/Array.hpp>
+# include <ThirdParty/zstd/zstd.h>
+# include <ThirdParty/zlib/zlib.h>
+
+namespace s3d
+{
+	class CompressionWriter::CompressionWriterDetail
+	{
+	public:
+
+		CompressionWriterDetail();
+
+		~CompressionWriterDetail();
+
+		bool open(std::unique_ptr<IWriter>&& writer, CompressionFormat format, int32 compressionLevel, int32 numWorkers);
+
+		bool close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		bool flush();
+
+		[[nodiscard]]
+		int64 size() const noexcept;
+
+		int64 write(const void* src, int64 sizeBytes);
+
+		[[nodiscard]]
+		int64 compressedSize() const noexcept;
+
+		[[nodiscard]]
+		CompressionFormat format() const noexcept;
+
+	private:
+
+		enum class Mode
+		{
+			Continue,
+
+			Flush,
+
+			End,
+		};
+
+		std::unique_ptr<IWriter> m_writer;
+
+		CompressionFormat m_format = CompressionFormat::Zstandard;
+
+		ZSTD_CCtx* m_zstd = nullptr;
+
+		z_stream m_zlib{};
+
+		bool m_zlibInitialized = false;
+
+		Array<Byte> m_buffer;
+
+		int64 m_size = 0;
+
+		int64 m_compressedSize = 0;
+
+		bool initZstd(int32 compressionLevel, int32 numWorkers);
+
+		bool initZlib(int32 compressionLevel);
+
+		// 入力をすべて圧縮し、mode に応じて内部に溜まっているデータを書き出す
+		[[nodiscard]]
+		bool compress(const void* src, size_t sizeBytes, Mode mode);
+
+		[[nodiscard]]
+		bool compressZstd(const void* src, size_t sizeBytes, Mode mode);
+
+		[[nodiscard]]
+		bool compressZlib(const void* src, size_t sizeBytes, Mode mode);
+
+		[[nodiscard]]
+		bool output(size_t sizeBytes);
+
+		void release();
+	};
+}
@@ -0,0 +1,92 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/CompressionWriter.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include "CompressionWriterDetail.hpp"
+
+namespace s3d
+{
+	CompressionWriter::CompressionWriter()
+		: pImpl{ std::make_shared<CompressionWriterDetail>() } {}
+
+	CompressionWriter::CompressionWriter(const FilePathView path, const CompressionFormat format, const int32 compressionLevel, const int32 numWorkers)
+		: CompressionWriter{}
+	{
+		open(path, format, compressionLevel, numWorkers);
+	}
+
+	CompressionWriter::CompressionWriter(std::unique_ptr<IWriter>&& writer, const CompressionFormat format, const int32 compressionLevel, const int32 numWorkers)
+		: CompressionWriter{}
+	{
+		open(std::move(writer), format, compressionLevel, numWorkers);
+	}
+
+	bool CompressionWriter::open(const FilePathView path, const CompressionFormat format, const int32 compressionLevel, const int32 numWorkers)
+	{
+		return open(std::make_unique<BinaryWriter>(path), format, compressionLevel, numWorkers);
+	}
+
+	bool CompressionWriter::open(std::unique_ptr<IWriter>&& writer, const CompressionFormat format, const int32 compressionLevel, const int32 numWorkers)
+	{
+		return pImpl->open(std::move(writer), format, compressionLevel, numWorkers);
+	}
+
+	bool CompressionWriter::close()
+	{
+		return pImpl->close();
+	}
+
+	bool CompressionWriter::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	CompressionWriter::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	bool CompressionWriter::flush()
+	{
+		return pImpl->flush();
+	}
+
+	int64 CompressionWriter::size() const
+	{
+		return pImpl->size();
+	}
+
+	int64 CompressionWriter::getPos() const
+	{
+		return pImpl->size();
+	}
+
+	bool CompressionWriter::setPos(const int64 pos)
+	{
+		return (isOpen() && (pos == pImpl->size()));
+	}
+
+	int64 CompressionWriter::write(const void* src, const int64 sizeBytes)
+	{
+		return pImpl->write(src, sizeBytes);
+	}
+
+	int64 CompressionWriter::compressedSize() const
+	{
+		return pImpl->compressedSize();
+	}
+
+	CompressionFormat CompressionWriter::format() const noexcept
+	{
+		return pImpl->format();
+	}
+}
@@ -0,0 +1,332 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "DecompressionReaderDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// zlib で一度に読み込む圧縮データの大きさ
+		inline constexpr size_t ZlibInputBufferSize = (64 * 1024);
+
+		// z_stream::avail_out は 32-bit のため、大きな出力は分割して受け取る
+		inline constexpr size_t ZlibMaxOutputSize = (1u << 30);
+
+		// skip() で読み捨てるときに使うバッファの大きさ
+		inline constexpr size_t SkipBufferSize = (16 * 1024);
+	}
+
+	DecompressionReader::DecompressionReaderDetail::DecompressionReaderDetail()
+	{
+		// do nothing
+	}
+
+	DecompressionReader::DecompressionReaderDetail::~DecompressionReaderDetail()
+	{
+		close();
+	}
+
+	bool DecompressionReader::DecompressionReaderDetail::open(std::unique_ptr<IReader>&& reader, const CompressionFormat format)
+	{
+		close();
+
+		if ((not reader) || (not reader->isOpen()))
+		{
+			return false;
+		}
+
+		m_format = format;
+
+		if (format == CompressionFormat::Zstandard)
+		{
+			m_zstd = ZSTD_createDCtx();
+
+			if (not m_zstd)
+			{
+				LOG_FAIL(U"❌ DecompressionReader: ZSTD_createDCtx() failed");
+				return false;
+			}
+
+			m_input.resize(ZSTD_DStreamInSize());
+		}
+		else
+		{
+			m_zlib = z_stream{};
+
+			if (inflateInit(&m_zlib) != Z_OK)
+			{
+				LOG_FAIL(U"❌ DecompressionReader: inflateInit() failed");
+				return false;
+			}
+
+			m_zlibInitialized = true;
+			m_input.resize(detail::ZlibInputBufferSize);
+		}
+
+		m_startPos = reader->getPos();
+		m_reader = std::move(reader);
+
+		return true;
+	}
+
+	void DecompressionReader::DecompressionReaderDetail::close()
+	{
+		release();
+
+		m_reader.reset();
+		m_inputPos		= 0;
+		m_inputSize		= 0;
+		m_startPos		= 0;
+		m_pos			= 0;
+		m_size			= -1;
+		m_inputEnd		= false;
+		m_outputEnd		= false;
+		m_frameEnd		= false;
+	}
+
+	bool DecompressionReader::DecompressionReaderDetail::isOpen() const noexcept
+	{
+		return static_cast<bool>(m_reader);
+	}
+
+	int64 DecompressionReader::DecompressionReaderDetail::size() const noexcept
+	{
+		return m_size;
+	}
+
+	int64 DecompressionReader::DecompressionReaderDetail::getPos() const noexcept
+	{
+		return m_pos;
+	}
+
+	bool DecompressionReader::DecompressionReaderDetail::setPos(const int64 pos)
+	{
+		if ((not m_reader) || (pos < 0))
+		{
+			return false;
+		}
+
+		if ((pos < m_pos)
+			&& (not rewind()))
+		{
+			return false;
+		}
+
+		skip(pos - m_pos);
+
+		return (m_pos == pos);
+	}
+
+	int64 DecompressionReader::DecompressionReaderDetail::skip(int64 offset)
+	{
+		if ((not m_reader) || (offset <= 0))
+		{
+			return m_pos;
+		}
+
+		std::array<Byte, detail::SkipBufferSize> buffer;
+
+		while (0 < offset)
+		{
+			const int64 readSize = read(buffer.data(), Min<int64>(offset, buffer.size()));
+
+			if (readSize == 0)
+			{
+				break;
+			}
+
+			offset -= readSize;
+		}
+
+		return m_pos;
+	}
+
+	int64 DecompressionReader::DecompressionReaderDetail::read(void* dst, const int64 size)
+	{
+		if ((not m_reader) || (size <= 0) || m_outputEnd)
+		{
+			return 0;
+		}
+
+		const size_t readSize = ((m_format == CompressionFormat::Zstandard)
+			? readZstd(static_cast<Byte*>(dst), static_cast<size_t>(size))
+			: readZlib(static_cast<Byte*>(dst), static_cast<size_t>(size)));
+
+		m_pos += readSize;
+
+		if (m_outputEnd)
+		{
+			m_size = m_pos;
+		}
+
+		return static_cast<int64>(readSize);
+	}
+
+	CompressionFormat DecompressionReader::DecompressionReaderDetail::format() const noexcept
+	{
+		return m_format;
+	}
+
+	void DecompressionReader::DecompressionReaderDetail::fillInput()
+	{
+		m_inputPos = 0;
+		m_inputSize = static_cast<size_t>(Max<int64>(m_reader->read(m_input.data(), m_input.size()), 0));
+
+		if (m_inputSize == 0)
+		{
+			m_inputEnd = true;
+		}
+	}
+
+	size_t DecompressionReader::DecompressionReaderDetail::readZstd(Byte* dst, const size_t size)
+	{
+		ZSTD_outBuffer output{ dst, size, 0 };
+
+		while (output.pos < output.size)
+		{
+			if ((m_inputPos == m_inputSize) && (not m_inputEnd))
+			{
+				fillInput();
+			}
+
+			ZSTD_inBuffer input{ m_input.data(), m_inputSize, m_inputPos };
+			const size_t previousOutputPos = output.pos;
+
+			const size_t result = ZSTD_decompressStream(m_zstd, &output, &input);
+
+			if (ZSTD_isError(result))
+			{
+				LOG_FAIL(U"❌ DecompressionReader: ZSTD_decompressStream() failed ({})"_fmt(Unicode::Widen(ZSTD_getErrorName(result))));
+				m_outputEnd = true;
+				break;
+			}
+
+			const bool progressed = ((input.pos != m_inputPos) || (output.pos != previousOutputPos));
+			m_inputPos = input.pos;
+
+			if (progressed)
+			{
+				// 0 はフレームの終わりを表す。読み込み元に続きがあれば、次のフレームとして伸長する
+				m_frameEnd = (result == 0);
+			}
+			else if (m_inputEnd && (m_inputPos == m_inputSize))
+			{
+				if (not m_frameEnd)
+				{
+					LOG_FAIL(U"❌ DecompressionReader: The compressed data is truncated");
+				}
+
+				m_outputEnd = true;
+				break;
+			}
+		}
+
+		return output.pos;
+	}
+
+	size_t DecompressionReader::DecompressionReaderDetail::readZlib(Byte* dst, const size_t size)
+	{
+		size_t total = 0;
+
+		while (total < size)
+		{
+			if ((m_inputPos == m_inputSize) && (not m_inputEnd))
+			{
+				fillInput();
+			}
+
+			const size_t outputSize = Min((size - total), detail::ZlibMaxOutputSize);
+			m_zlib.next_in = reinterpret_cast<::Bytef*>(m_input.data() + m_inputPos);
+			m_zlib.avail_in = static_cast<uInt>(m_inputSize - m_inputPos);
+			m_zlib.next_out = reinterpret_cast<::Bytef*>(dst + total);
+			m_zlib.avail_out = static_cast<uInt>(outputSize);
+
+			const int32 result = inflate(&m_zlib, Z_NO_FLUSH);
+
+			const size_t inputPos = (m_inputSize - m_zlib.avail_in);
+			const size_t produced = (outputSize - m_zlib.avail_out);
+			const bool progressed = ((inputPos != m_inputPos) || (produced != 0));
+			m_inputPos = inputPos;
+			total += produced;
+
+			if (result == Z_STREAM_END)
+			{
+				m_outputEnd = true;
+				break;
+			}
+
+			// Z_BUF_ERROR は入力が足りないことを表す
+			if ((result != Z_OK) && (result != Z_BUF_ERROR))
+			{
+				LOG_FAIL(U"❌ DecompressionReader: inflate() failed ({})"_fmt(result));
+				m_outputEnd = true;
+				break;
+			}
+
+			if ((not progressed) && m_inputEnd && (m_inputPos == m_inputSize))
+			{
+				LOG_FAIL(U"❌ DecompressionReader: The compressed data is truncated");
+				m_outputEnd = true;
+				break;
+			}
+		}
+
+		return total;
+	}
+
+	bool DecompressionReader::DecompressionReaderDetail::rewind()
+	{
+		if (not m_reader->setPos(m_startPos))
+		{
+			return false;
+		}
+
+		if (m_format == CompressionFormat::Zstandard)
+		{
+			ZSTD_DCtx_reset(m_zstd, ZSTD_reset_session_only);
+		}
+		else
+		{
+			inflateReset(&m_zlib);
+		}
+
+		m_inputPos	= 0;
+		m_inputSize	= 0;
+		m_pos		= 0;
+		m_inputEnd	= false;
+		m_outputEnd	= false;
+		m_frameEnd	= false;
+
+		return true;
+	}
+
+	void DecompressionReader::DecompressionReaderDetail::release()
+	{
+		if (m_zstd)
+		{
+			ZSTD_freeDCtx(m_zstd);
+			m_zstd = nullptr;
+		}
+
+		if (m_zlibInitialized)
+		{
+			inflateEnd(&m_zlib);
+			m_zlibInitialized = false;
+		}
+
+		m_input.clear();
+		m_input.shrink_to_fit();
+	}
+}
@@ -0,0 +1,101 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <Siv3D/DecompressionReader.hpp>
+# include <Siv3D/Array.hpp>
+# include <ThirdParty/zstd/zstd.h>
+# include <ThirdParty/zlib/zlib.h>
+
+namespace s3d
+{
+	class DecompressionReader::DecompressionReaderDetail
+	{
+	public:
+
+		DecompressionReaderDetail();
+
+		~DecompressionReaderDetail();
+
+		bool open(std::unique_ptr<IReader>&& reader, CompressionFormat format);
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		int64 size() const noexcept;
+
+		[[nodiscard]]
+		int64 getPos() const noexcept;
+
+		bool setPos(int64 pos);
+
+		int64 skip(int64 offset);
+
+		int64 read(void* dst, int64 size);
+
+		[[nodiscard]]
+		CompressionFormat format() const noexcept;
+
+	private:
+
+		std::unique_ptr<IReader> m_reader;
+
+		CompressionFormat m_format = CompressionFormat::Zstandard;
+
+		ZSTD_DCtx* m_zstd = nullptr;
+
+		z_stream m_zlib{};
+
+		bool m_zlibInitialized = false;
+
+		// 読み込み元から読み込んだ、圧縮されたデータ
+		Array<Byte> m_input;
+
+		size_t m_inputPos = 0;
+
+		size_t m_inputSize = 0;
+
+		// 読み込み元の、圧縮されたデータの先頭の位置
+		int64 m_startPos = 0;
+
+		// 伸長後のデータにおける読み込み位置
+		int64 m_pos = 0;
+
+		// 伸長後のデータのサイズ。最後まで読み込むまでは -1
+		int64 m_size = -1;
+
+		// 読み込み元の終端に達したか
+		bool m_inputEnd = false;
+
+		// 伸長後のデータの終端に達したか
+		bool m_outputEnd = false;
+
+		// 直前に伸長した Zstandard のフレームが完結しているか
+		bool m_frameEnd = false;
+
+		void fillInput();
+
+		[[nodiscard]]
+		size_t readZstd(Byte* dst, size_t size);
+
+		[[nodiscard]]
+		size_t readZlib(Byte* dst, size_t size);
+
+		[[nodiscard]]
+		bool rewind();
+
+		void release();
+	};
+}
@@ -0,0 +1,112 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/DecompressionReader.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include "DecompressionReaderDetail.hpp"
+
+namespace s3d
+{
+	DecompressionReader::DecompressionReader()
+		: pImpl{ std::make_shared<DecompressionReaderDetail>() } {}
+
+	DecompressionReader::DecompressionReader(const FilePathView path, const CompressionFormat format)
+		: DecompressionReader{}
+	{
+		open(path, format);
+	}
+
+	DecompressionReader::DecompressionReader(std::unique_ptr<IReader>&& reader, const CompressionFormat format)
+		: DecompressionReader{}
+	{
+		open(std::move(reader), format);
+	}
+
+	bool DecompressionReader::open(const FilePathView path, const CompressionFormat format)
+	{
+		return open(std::make_unique<BinaryReader>(path), format);
+	}
+
+	bool DecompressionReader::open(std::unique_ptr<IReader>&& reader, const CompressionFormat format)
+	{
+		return pImpl->open(std::move(reader), format);
+	}
+
+	void DecompressionReader::close()
+	{
+		pImpl->close();
+	}
+
+	bool DecompressionReader::supportsLookahead() const noexcept
+	{
+		return false;
+	}
+
+	bool DecompressionReader::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	DecompressionReader::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	int64 DecompressionReader::size() const
+	{
+		return pImpl->size();
+	}
+
+	int64 DecompressionReader::getPos() const
+	{
+		return pImpl->getPos();
+	}
+
+	bool DecompressionReader::setPos(const int64 pos)
+	{
+		return pImpl->setPos(pos);
+	}
+
+	int64 DecompressionReader::skip(const int64 offset)
+	{
+		return pImpl->skip(offset);
+	}
+
+	int64 DecompressionReader::read(void* dst, const int64 size)
+	{
+		return pImpl->read(dst, size);
+	}
+
+	int64 DecompressionReader::read(void* dst, const int64 pos, const int64 size)
+	{
+		if (not pImpl->setPos(pos))
+		{
+			return 0;
+		}
+
+		return pImpl->read(dst, size);
+	}
+
+	int64 DecompressionReader::lookahead(void*, int64) const
+	{
+		return 0;
+	}
+
+	int64 DecompressionReader::lookahead(void*, int64, int64) const
+	{
+		return 0;
+	}
+
+	CompressionFormat DecompressionReader::format() const noexcept
+	{
+		return pImpl->format();
+	}
+}
@@ -352,6 +352,27 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
+	bool CFont::preloadAsync(const Font::IDType handleID, const StringView chars)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().preloadAsync(*font, chars);
+	}
+
+	bool CFont::saveGlyphCache(const Font::IDType handleID, const FilePathView path)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().save(*font, path);
+	}
+
+	bool CFont::loadGlyphCache(const Font::IDType handleID, const FilePathView path)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().load(*font, path);
+	}
+
 	const Texture& CFont::getTexture(const Font::IDType handleID)
 	{
 		return m_fonts[handleID]->getGlyphCache().getTexture();
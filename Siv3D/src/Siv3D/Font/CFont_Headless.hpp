@@ -87,6 +87,12 @@ namespace s3d
 	
 		bool preload(Font::IDType handleID, StringView chars) override;
 
+		bool preloadAsync(Font::IDType handleID, StringView chars) override;
+
+		bool saveGlyphCache(Font::IDType handleID, FilePathView path) override;
+
+		bool loadGlyphCache(Font::IDType handleID, FilePathView path) override;
+
 		const Texture& getTexture(Font::IDType handleID) override;
 
 		Glyph getGlyph(Font::IDType handleID, StringView ch) override;
@@ -10,6 +10,8 @@
 //-----------------------------------------------
 
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Blob.hpp>
+# include <Siv3D/Hash.hpp>
 # include <Siv3D/PolygonGlyph.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
@@ -83,8 +85,27 @@ namespace s3d
 			break;
 		}
 
+		if ((fontMethod == FontMethod::SDF) || (fontMethod == FontMethod::MSDF))
+		{
+			const void* data = nullptr;
+			size_t size = 0;
+
+		# if SIV3D_PLATFORM(WINDOWS)
+
+			data = m_resource.data();
+			size = static_cast<size_t>(m_resource.size());
+
+		# endif
+
+			m_facePool = std::make_shared<FontFacePool>(library, path, data, size, faceIndex, m_fontFace.getProperty().fontPixelSize);
+		}
+
 		m_method = fontMethod;
 
+		m_path = path;
+
+		m_faceIndex = faceIndex;
+
 		m_initialized = true;
 	}
 
@@ -113,6 +134,33 @@ namespace s3d
 		return m_method;
 	}
 
+	const FilePath& FontData::getPath() const noexcept
+	{
+		return m_path;
+	}
+
+	size_t FontData::getFaceIndex() const noexcept
+	{
+		return m_faceIndex;
+	}
+
+	Optional<uint64> FontData::getFileHash() const
+	{
+		if (not m_fileHash)
+		{
+			const Blob blob{ m_path };
+
+			if (not blob)
+			{
+				return none;
+			}
+
+			m_fileHash = Hash::XXHash3(blob.data(), blob.size());
+		}
+
+		return m_fileHash;
+	}
+
 	bool FontData::hasGlyph(const StringView ch)
 	{
 		const HBGlyphInfo glyphInfo = m_fontFace.getHBGlyphInfo(ch, Ligature::Yes);
@@ -323,6 +371,16 @@ namespace s3d
 		return RenderMSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
 	}
 
+	std::shared_ptr<SDFGlyphBatch> FontData::prepareSDFGlyphs(const Array<GlyphIndex>& glyphIndices, const int32 buffer) const
+	{
+		return std::make_shared<SDFGlyphBatch>(m_fontFace.getFT_Face(), m_facePool, glyphIndices, buffer, m_fontFace.getProperty());
+	}
+
+	std::shared_ptr<MSDFGlyphBatch> FontData::prepareMSDFGlyphs(const Array<GlyphIndex>& glyphIndices, const int32 buffer) const
+	{
+		return std::make_shared<MSDFGlyphBatch>(m_fontFace.getFT_Face(), m_facePool, glyphIndices, buffer, m_fontFace.getProperty());
+	}
+
 	IGlyphCache& FontData::getGlyphCache() const
 	{
 		return *m_glyphCache;
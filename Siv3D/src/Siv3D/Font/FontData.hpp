@@ -15,11 +15,16 @@
 # include <Siv3D/Font.hpp>
 # include "FontResourceHolder.hpp"
 # include "FontFace.hpp"
+# include "FontFacePool.hpp"
 
 namespace s3d
 {
 	class IGlyphCache;
 
+	class SDFGlyphBatch;
+
+	class MSDFGlyphBatch;
+
 	class FontData
 	{
 	public:
@@ -45,6 +50,18 @@ namespace s3d
 		[[nodiscard]]
 		FontMethod getMethod() const;
 
+		[[nodiscard]]
+		const FilePath& getPath() const noexcept;
+
+		[[nodiscard]]
+		size_t getFaceIndex() const noexcept;
+
+		/// @brief フォントファイルの内容のハッシュ値を返します。
+		/// @remark 初回の呼び出しでのみファイルを読み込みます。
+		/// @return ハッシュ値。ファイルを読み込めなかった場合は none
+		[[nodiscard]]
+		Optional<uint64> getFileHash() const;
+
 		[[nodiscard]]
 		bool hasGlyph(StringView ch);
 
@@ -78,6 +95,12 @@ namespace s3d
 		[[nodiscard]]
 		MSDFGlyph renderMSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
 
+		[[nodiscard]]
+		std::shared_ptr<SDFGlyphBatch> prepareSDFGlyphs(const Array<GlyphIndex>& glyphIndices, int32 buffer) const;
+
+		[[nodiscard]]
+		std::shared_ptr<MSDFGlyphBatch> prepareMSDFGlyphs(const Array<GlyphIndex>& glyphIndices, int32 buffer) const;
+
 		[[nodiscard]]
 		IGlyphCache& getGlyphCache() const;
 
@@ -99,8 +122,18 @@ namespace s3d
 
 		Array<std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>> m_fallbackFonts;
 
+		FilePath m_path;
+
+		size_t m_faceIndex = 0;
+
 		FontMethod m_method = FontMethod::Bitmap;
 
+		mutable Optional<uint64> m_fileHash;
+
+		// SDF / MSDF のグリフのアウトラインを並列に読み込むためのフォントフェイス
+		// 先読み中のグリフが使うため、グリフキャッシュより後に破棄する
+		std::shared_ptr<FontFacePool> m_facePool;
+
 		std::unique_ptr<IGlyphCache> m_glyphCache;
 
 		bool m_initialized = false;
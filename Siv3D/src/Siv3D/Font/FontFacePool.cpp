@@ -0,0 +1,94 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Threading.hpp>
+# include "FontFacePool.hpp"
+# include "FreeType.hpp"
+
+namespace s3d
+{
+	FontFacePool::FontFacePool(const FT_Library library, const FilePathView path, const void* data, const size_t size, const size_t faceIndex, const int32 pixelSize)
+		: m_library{ library }
+		, m_path{ path }
+		, m_data{ data }
+		, m_size{ size }
+		, m_faceIndex{ faceIndex }
+		, m_pixelSize{ pixelSize }
+		, m_maxFaces{ Max<size_t>(Threading::GetConcurrency(), 1) } {}
+
+	FontFacePool::~FontFacePool()
+	{
+		for (const auto face : m_faces)
+		{
+			::FT_Done_Face(face);
+		}
+	}
+
+	Array<FT_Face> FontFacePool::acquire(const size_t count)
+	{
+		Array<FT_Face> faces;
+
+		std::lock_guard lock{ m_mutex };
+
+		while ((faces.size() < count) && m_freeFaces)
+		{
+			faces.push_back(m_freeFaces.back());
+			m_freeFaces.pop_back();
+		}
+
+		while ((faces.size() < count) && (m_faces.size() < m_maxFaces))
+		{
+			const FT_Face face = create();
+
+			if (not face)
+			{
+				break;
+			}
+
+			m_faces.push_back(face);
+			faces.push_back(face);
+		}
+
+		return faces;
+	}
+
+	void FontFacePool::release(const Array<FT_Face>& faces)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_freeFaces.append(faces);
+	}
+
+	FT_Face FontFacePool::create() const
+	{
+		FT_Face face = nullptr;
+
+		const FT_Error error = (m_data
+			? ::FT_New_Memory_Face(m_library, static_cast<const FT_Byte*>(m_data), static_cast<FT_Long>(m_size), static_cast<FT_Long>(m_faceIndex), &face)
+			: ::FT_New_Face(m_library, m_path.narrow().c_str(), static_cast<FT_Long>(m_faceIndex), &face));
+
+		if (error)
+		{
+			LOG_FAIL(U"FontFacePool: Failed to open the font face `{}`"_fmt(m_path));
+			return nullptr;
+		}
+
+		if (::FT_Set_Pixel_Sizes(face, 0, m_pixelSize))
+		{
+			::FT_Done_Face(face);
+			return nullptr;
+		}
+
+		return face;
+	}
+}
@@ -0,0 +1,75 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <mutex>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+
+struct FT_LibraryRec_;
+typedef struct FT_LibraryRec_* FT_Library;
+
+struct FT_FaceRec_;
+typedef struct FT_FaceRec_* FT_Face;
+
+namespace s3d
+{
+	// グリフのアウトラインを複数のスレッドで読み込むための、フォントフェイスの複製
+	// FreeType のフォントフェイスは同時に 1 つのスレッドからしか使えないため、スレッドごとに別のフォントフェイスを貸し出す
+	class FontFacePool
+	{
+	public:
+
+		// 1 つのフォントフェイスで読み込むグリフの数の目安
+		static constexpr size_t GlyphsPerFace = 8;
+
+		// data が nullptr の場合は path から開く
+		FontFacePool(FT_Library library, FilePathView path, const void* data, size_t size, size_t faceIndex, int32 pixelSize);
+
+		~FontFacePool();
+
+		// 足りないフォントフェイスは FreeType のライブラリを使って作成するため、フォントを作成したスレッドからのみ呼ぶ
+		// 上限に達している場合は、要求より少ない数を返す
+		[[nodiscard]]
+		Array<FT_Face> acquire(size_t count);
+
+		// 任意のスレッドから呼べる
+		void release(const Array<FT_Face>& faces);
+
+	private:
+
+		FT_Library m_library = nullptr;
+
+		FilePath m_path;
+
+		const void* m_data = nullptr;
+
+		size_t m_size = 0;
+
+		size_t m_faceIndex = 0;
+
+		int32 m_pixelSize = 0;
+
+		size_t m_maxFaces = 1;
+
+		std::mutex m_mutex;
+
+		// 作成したすべてのフォントフェイス
+		Array<FT_Face> m_faces;
+
+		// 貸し出していないフォントフェイス
+		Array<FT_Face> m_freeFaces;
+
+		[[nodiscard]]
+		FT_Face create() const;
+	};
+}
@@ -484,6 +484,35 @@ namespace s3d
 		return prerender(font, font.getGlyphClusters(s, false, Ligature::Yes), true);
 	}
 
+	bool BitmapGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		// ビットマップのラスタライズには FreeType を使うため、バックグラウンドでは行わない
+		return preload(font, s);
+	}
+
+	bool BitmapGlyphCache::save(const FontData& font, const FilePathView path)
+	{
+		return SaveGlyphCacheFile(path, font, m_buffer, m_glyphTable);
+	}
+
+	bool BitmapGlyphCache::load(const FontData& font, const FilePathView path)
+	{
+		if (not LoadGlyphCacheFile(path, font, m_buffer, m_glyphTable))
+		{
+			return false;
+		}
+
+		m_hasDirty = true;
+
+		// texture content can be updated in a different thread
+		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
+		{
+			updateTexture();
+		}
+
+		return true;
+	}
+
 	const Texture& BitmapGlyphCache::getTexture() noexcept
 	{
 		updateTexture();
@@ -50,6 +50,12 @@ namespace s3d
 
 		bool preload(const FontData & font, StringView s) override;
 
+		bool preloadAsync(const FontData& font, StringView s) override;
+
+		bool save(const FontData& font, FilePathView path) override;
+
+		bool load(const FontData& font, FilePathView path) override;
+
 		[[nodiscard]]
 		const Texture& getTexture() noexcept override;
 
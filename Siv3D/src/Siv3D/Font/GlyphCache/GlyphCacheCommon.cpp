@@ -9,10 +9,157 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/HashSet.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
 # include "GlyphCacheCommon.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// グリフキャッシュファイルの形式を変更したら値を増やす
+		constexpr uint32 GlyphCacheFileVersion = 1;
+
+		constexpr char GlyphCacheFileMagic[8] = { 'S', '3', 'D', 'G', 'L', 'Y', 'P', 'H' };
+
+		struct GlyphCacheFileHeader
+		{
+			char magic[8];
+
+			uint32 version;
+
+			uint32 glyphCount;
+
+			uint64 fontHash;
+
+			uint64 faceIndex;
+
+			int32 fontPixelSize;
+
+			int32 bufferWidth;
+
+			int32 padding;
+
+			uint32 method;
+
+			uint32 style;
+
+			int32 imageWidth;
+
+			int32 imageHeight;
+
+			int32 penPosX;
+
+			int32 penPosY;
+
+			int32 currentMaxHeight;
+
+			uint32 backgroundColor;
+
+			uint32 reserved;
+		};
+		static_assert(sizeof(GlyphCacheFileHeader) == 80);
+
+		struct GlyphCacheFileRecord
+		{
+			uint32 glyphIndex;
+
+			int32 buffer;
+
+			int16 left;
+
+			int16 top;
+
+			int16 width;
+
+			int16 height;
+
+			int16 ascender;
+
+			int16 descender;
+
+			int16 textureRegionLeft;
+
+			int16 textureRegionTop;
+
+			int16 textureRegionWidth;
+
+			int16 textureRegionHeight;
+
+			uint32 reserved;
+
+			double xAdvance;
+
+			double yAdvance;
+		};
+		static_assert(sizeof(GlyphCacheFileRecord) == 48);
+
+		// フォントファイルの内容と、グリフの見た目に影響する設定をキーにする
+		[[nodiscard]]
+		static bool MakeGlyphCacheFileHeader(const FontData& font, const BufferImage& buffer, GlyphCacheFileHeader& header)
+		{
+			// フォントファイルは FontData ごとに 1 回だけ読み込んでハッシュ値を求める
+			const Optional<uint64> fontHash = font.getFileHash();
+
+			if (not fontHash)
+			{
+				return false;
+			}
+
+			const FontFaceProperty& prop = font.getProperty();
+
+			header = {};
+			std::memcpy(header.magic, GlyphCacheFileMagic, sizeof(header.magic));
+			header.version			= GlyphCacheFileVersion;
+			header.fontHash			= *fontHash;
+			header.faceIndex		= font.getFaceIndex();
+			header.fontPixelSize	= prop.fontPixelSize;
+			header.bufferWidth		= buffer.bufferWidth;
+			header.padding			= buffer.padding;
+			header.method			= FromEnum(font.getMethod());
+			header.style			= FromEnum(prop.style);
+			header.backgroundColor	= buffer.backgroundColor.asUint32();
+			return true;
+		}
+
+		[[nodiscard]]
+		static bool IsSameKey(const GlyphCacheFileHeader& a, const GlyphCacheFileHeader& b) noexcept
+		{
+			return ((std::memcmp(a.magic, b.magic, sizeof(a.magic)) == 0)
+				&& (a.version == b.version)
+				&& (a.fontHash == b.fontHash)
+				&& (a.faceIndex == b.faceIndex)
+				&& (a.fontPixelSize == b.fontPixelSize)
+				&& (a.bufferWidth == b.bufferWidth)
+				&& (a.padding == b.padding)
+				&& (a.method == b.method)
+				&& (a.style == b.style)
+				&& (a.backgroundColor == b.backgroundColor));
+		}
+
+		// ペンの位置と、すべてのグリフの領域が画像の範囲内にあるかを調べる
+		[[nodiscard]]
+		static bool IsInsideImage(const GlyphCacheFileHeader& header) noexcept
+		{
+			return ((0 <= header.penPosX) && (header.penPosX <= header.imageWidth)
+				&& (0 <= header.penPosY) && (header.penPosY <= header.imageHeight)
+				&& (0 <= header.currentMaxHeight) && (header.currentMaxHeight <= header.imageHeight));
+		}
+
+		[[nodiscard]]
+		static bool IsInsideImage(const GlyphCacheFileRecord& record, const GlyphCacheFileHeader& header) noexcept
+		{
+			return ((0 <= record.textureRegionLeft) && (0 <= record.textureRegionTop)
+				&& (0 <= record.textureRegionWidth) && (0 <= record.textureRegionHeight)
+				&& ((record.textureRegionLeft + record.textureRegionWidth) <= header.imageWidth)
+				&& ((record.textureRegionTop + record.textureRegionHeight) <= header.imageHeight));
+		}
+	}
+
 	double GetTabAdvance(const double spaceWidth, const double scale, const double baseX, const double currentX, const int32 indentSize)
 	{
 		const double maxTabWidth = (spaceWidth * scale * indentSize);
@@ -108,4 +255,187 @@ namespace s3d
 
 		return true;
 	}
+
+	Array<GlyphIndex> GetUncachedGlyphIndices(const Array<GlyphCluster>& clusters, const bool isMainFont, const HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		Array<GlyphIndex> glyphIndices;
+		HashSet<GlyphIndex> added;
+
+		for (const auto& cluster : clusters)
+		{
+			if (isMainFont && (cluster.fontIndex != 0))
+			{
+				continue;
+			}
+
+			if (glyphTable.contains(cluster.glyphIndex))
+			{
+				continue;
+			}
+
+			if (added.insert(cluster.glyphIndex).second)
+			{
+				glyphIndices << cluster.glyphIndex;
+			}
+		}
+
+		return glyphIndices;
+	}
+
+	bool SaveGlyphCacheFile(const FilePathView path, const FontData& font, const BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		detail::GlyphCacheFileHeader header;
+
+		if (not detail::MakeGlyphCacheFileHeader(font, buffer, header))
+		{
+			LOG_FAIL(U"❌ Font::saveGlyphCache(): Failed to read the font file `{}`"_fmt(font.getPath()));
+			return false;
+		}
+
+		header.glyphCount		= static_cast<uint32>(glyphTable.size());
+		header.imageWidth		= buffer.image.width();
+		header.imageHeight		= buffer.image.height();
+		header.penPosX			= buffer.penPos.x;
+		header.penPosY			= buffer.penPos.y;
+		header.currentMaxHeight	= buffer.currentMaxHeight;
+
+		Array<detail::GlyphCacheFileRecord> records(Arg::reserve = glyphTable.size());
+
+		for (const auto& [glyphIndex, cache] : glyphTable)
+		{
+			const GlyphInfo& info = cache.info;
+			records.push_back({ .glyphIndex = glyphIndex, .buffer = info.buffer,
+				.left = info.left, .top = info.top, .width = info.width, .height = info.height,
+				.ascender = info.ascender, .descender = info.descender,
+				.textureRegionLeft = cache.textureRegionLeft, .textureRegionTop = cache.textureRegionTop,
+				.textureRegionWidth = cache.textureRegionWidth, .textureRegionHeight = cache.textureRegionHeight,
+				.reserved = 0, .xAdvance = info.xAdvance, .yAdvance = info.yAdvance });
+		}
+
+		BinaryWriter writer{ path };
+
+		if (not writer)
+		{
+			LOG_FAIL(U"❌ Font::saveGlyphCache(): Failed to open `{}`"_fmt(path));
+			return false;
+		}
+
+		const int64 recordsSize = static_cast<int64>(records.size_bytes());
+		const int64 imageSize = static_cast<int64>(buffer.image.size_bytes());
+
+		if ((not writer.write(header))
+			|| (writer.write(records.data(), recordsSize) != recordsSize)
+			|| (writer.write(buffer.image.data(), imageSize) != imageSize))
+		{
+			LOG_FAIL(U"❌ Font::saveGlyphCache(): Failed to write `{}`"_fmt(path));
+			return false;
+		}
+
+		LOG_TRACE(U"Font::saveGlyphCache(): Saved {} glyphs to `{}`"_fmt(records.size(), path));
+
+		return true;
+	}
+
+	bool LoadGlyphCacheFile(const FilePathView path, const FontData& font, BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		if (not FileSystem::Exists(path))
+		{
+			return false;
+		}
+
+		const MemoryMappedFileView file{ path };
+
+		if (not file)
+		{
+			return false;
+		}
+
+		detail::GlyphCacheFileHeader expected;
+
+		if (not detail::MakeGlyphCacheFileHeader(font, buffer, expected))
+		{
+			LOG_FAIL(U"❌ Font::loadGlyphCache(): Failed to read the font file `{}`"_fmt(font.getPath()));
+			return false;
+		}
+
+		const size_t fileSize = file.mappedSize();
+		detail::GlyphCacheFileHeader header;
+
+		if (fileSize < sizeof(header))
+		{
+			LOG_FAIL(U"❌ Font::loadGlyphCache(): `{}` is not a glyph cache file"_fmt(path));
+			return false;
+		}
+
+		std::memcpy(&header, file.data(), sizeof(header));
+
+		// フォントや設定が異なる場合は、古いキャッシュとして扱う
+		if (not detail::IsSameKey(header, expected))
+		{
+			LOG_INFO(U"Font::loadGlyphCache(): `{}` was created for a different font or version"_fmt(path));
+			return false;
+		}
+
+		if ((header.imageWidth < 0) || (header.imageHeight < 0)
+			|| (BufferImage::MaxImageHeight < header.imageHeight)
+			|| (fileSize != (sizeof(header)
+				+ (size_t{ header.glyphCount } * sizeof(detail::GlyphCacheFileRecord))
+				+ (static_cast<size_t>(header.imageWidth) * header.imageHeight * sizeof(Color))))
+			|| (not detail::IsInsideImage(header)))
+		{
+			LOG_FAIL(U"❌ Font::loadGlyphCache(): `{}` is broken"_fmt(path));
+			return false;
+		}
+
+		const Byte* pSrc = (file.data() + sizeof(header));
+
+		HashTable<GlyphIndex, GlyphCache> newTable;
+		newTable.reserve(header.glyphCount);
+
+		for (uint32 i = 0; i < header.glyphCount; ++i)
+		{
+			detail::GlyphCacheFileRecord record;
+			std::memcpy(&record, pSrc, sizeof(record));
+			pSrc += sizeof(record);
+
+			if (not detail::IsInsideImage(record, header))
+			{
+				LOG_FAIL(U"❌ Font::loadGlyphCache(): `{}` is broken"_fmt(path));
+				return false;
+			}
+
+			GlyphCache cache;
+			cache.info.glyphIndex		= record.glyphIndex;
+			cache.info.buffer			= record.buffer;
+			cache.info.left				= record.left;
+			cache.info.top				= record.top;
+			cache.info.width			= record.width;
+			cache.info.height			= record.height;
+			cache.info.ascender			= record.ascender;
+			cache.info.descender		= record.descender;
+			cache.info.xAdvance			= record.xAdvance;
+			cache.info.yAdvance			= record.yAdvance;
+			cache.textureRegionLeft		= record.textureRegionLeft;
+			cache.textureRegionTop		= record.textureRegionTop;
+			cache.textureRegionWidth	= record.textureRegionWidth;
+			cache.textureRegionHeight	= record.textureRegionHeight;
+			newTable.emplace(record.glyphIndex, cache);
+		}
+
+		Image image{ Size{ header.imageWidth, header.imageHeight } };
+
+		if (image)
+		{
+			std::memcpy(image.data(), pSrc, image.size_bytes());
+		}
+
+		buffer.image			= std::move(image);
+		buffer.penPos			= Point{ header.penPosX, header.penPosY };
+		buffer.currentMaxHeight	= header.currentMaxHeight;
+		glyphTable				= std::move(newTable);
+
+		LOG_TRACE(U"Font::loadGlyphCache(): Loaded {} glyphs from `{}`"_fmt(header.glyphCount, path));
+
+		return true;
+	}
 }
@@ -15,6 +15,7 @@
 # include <Siv3D/Image.hpp>
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/Char.hpp>
+# include <Siv3D/GlyphCluster.hpp>
 # include "../FontData.hpp"
 
 namespace s3d
@@ -58,4 +59,14 @@ namespace s3d
 	[[nodiscard]]
 	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
 		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	/// @brief まだキャッシュされていないグリフのインデックスを、重複なく出現順に返します。
+	[[nodiscard]]
+	Array<GlyphIndex> GetUncachedGlyphIndices(const Array<GlyphCluster>& clusters, bool isMainFont, const HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	[[nodiscard]]
+	bool SaveGlyphCacheFile(FilePathView path, const FontData& font, const BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	[[nodiscard]]
+	bool LoadGlyphCacheFile(FilePathView path, const FontData& font, BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
 }
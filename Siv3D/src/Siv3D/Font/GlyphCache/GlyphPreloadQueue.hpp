@@ -0,0 +1,155 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <deque>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/AsyncTask.hpp>
+# include <Siv3D/GlyphCluster.hpp>
+
+namespace s3d
+{
+	/// @brief Font::preloadAsync() で生成中のグリフを、要求された順に管理します。
+	/// @tparam GlyphType 生成されるグリフの型
+	/// @remark 先読みは待たずに追加され、完了したものから要求された順に取り込まれます。
+	template <class GlyphType>
+	class GlyphPreloadQueue
+	{
+	public:
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return m_jobs.empty();
+		}
+
+		/// @brief 先読み中のグリフを取り除きます。
+		/// @param glyphIndices グリフインデックス
+		/// @return 先読み中ではないグリフインデックス
+		[[nodiscard]]
+		Array<GlyphIndex> excludePending(const Array<GlyphIndex>& glyphIndices) const
+		{
+			return glyphIndices.removed_if([this](const GlyphIndex glyphIndex) { return m_pendingGlyphs.contains(glyphIndex); });
+		}
+
+		/// @brief 先読みを追加します。完了は待ちません。
+		/// @param glyphIndices 生成するグリフインデックス
+		/// @param job グリフを生成する関数
+		template <class Fty>
+		void push(const Array<GlyphIndex>& glyphIndices, Fty job)
+		{
+			const uint64 id = ++m_lastID;
+
+			for (const auto& glyphIndex : glyphIndices)
+			{
+				m_pendingGlyphs.emplace(glyphIndex, id);
+			}
+
+			m_jobs.push_back(Job{ id, glyphIndices, Async(std::move(job)) });
+		}
+
+		/// @brief 完了した先読みと、clusters が必要とするグリフを含む先読みを、要求された順に取り込みます。
+		/// @param clusters 必要なグリフ
+		/// @param isMainFont メインフォントのグリフだけを対象にする場合 true
+		/// @param cacheGlyphs 生成されたグリフを取り込む関数
+		/// @return 取り込みに成功した場合 true, それ以外の場合は false
+		template <class Fty>
+		[[nodiscard]]
+		bool merge(const Array<GlyphCluster>& clusters, const bool isMainFont, Fty cacheGlyphs)
+		{
+			if (m_jobs.empty())
+			{
+				return true;
+			}
+
+			// 必要なグリフを含む先読みのうち、最も新しいものまでは完了を待つ
+			uint64 requiredID = 0;
+
+			for (const auto& cluster : clusters)
+			{
+				if (isMainFont && (cluster.fontIndex != 0))
+				{
+					continue;
+				}
+
+				if (auto it = m_pendingGlyphs.find(cluster.glyphIndex);
+					it != m_pendingGlyphs.end())
+				{
+					requiredID = Max(requiredID, it->second);
+				}
+			}
+
+			while ((not m_jobs.empty())
+				&& ((m_jobs.front().id <= requiredID) || m_jobs.front().task.isReady()))
+			{
+				if (not mergeFront(cacheGlyphs))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/// @brief すべての先読みの完了を待ち、要求された順に取り込みます。
+		/// @param cacheGlyphs 生成されたグリフを取り込む関数
+		/// @return 取り込みに成功した場合 true, それ以外の場合は false
+		template <class Fty>
+		[[nodiscard]]
+		bool mergeAll(Fty cacheGlyphs)
+		{
+			while (not m_jobs.empty())
+			{
+				if (not mergeFront(cacheGlyphs))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+	private:
+
+		struct Job
+		{
+			uint64 id = 0;
+
+			Array<GlyphIndex> glyphIndices;
+
+			AsyncTask<Array<GlyphType>> task;
+		};
+
+		std::deque<Job> m_jobs;
+
+		// 先読み中のグリフと、それを生成する先読みの ID
+		HashTable<GlyphIndex, uint64> m_pendingGlyphs;
+
+		uint64 m_lastID = 0;
+
+		template <class Fty>
+		[[nodiscard]]
+		bool mergeFront(Fty& cacheGlyphs)
+		{
+			Job job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+
+			for (const auto& glyphIndex : job.glyphIndices)
+			{
+				m_pendingGlyphs.erase(glyphIndex);
+			}
+
+			return cacheGlyphs(job.task.get());
+		}
+	};
+}
@@ -48,6 +48,12 @@ namespace s3d
 
 		virtual bool preload(const FontData& font, StringView s) = 0;
 
+		virtual bool preloadAsync(const FontData& font, StringView s) = 0;
+
+		virtual bool save(const FontData& font, FilePathView path) = 0;
+
+		virtual bool load(const FontData& font, FilePathView path) = 0;
+
 		[[nodiscard]]
 		virtual const Texture& getTexture() noexcept = 0;
 
@@ -15,6 +15,7 @@
 # include <Siv3D/HashTable.hpp>
 # include "IGlyphCache.hpp"
 # include "GlyphCacheCommon.hpp"
+# include "GlyphPreloadQueue.hpp"
 
 namespace s3d
 {
@@ -50,6 +51,12 @@ namespace s3d
 
 		bool preload(const FontData & font, StringView s) override;
 
+		bool preloadAsync(const FontData& font, StringView s) override;
+
+		bool save(const FontData& font, FilePathView path) override;
+
+		bool load(const FontData& font, FilePathView path) override;
+
 		[[nodiscard]]
 		const Texture& getTexture() noexcept override;
 
@@ -71,9 +78,15 @@ namespace s3d
 
 		BufferImage m_buffer = { .image = {}, .backgroundColor = Color{ 0, 0 } };
 
+		// 先読み中のグリフ
+		GlyphPreloadQueue<MSDFGlyph> m_preloadQueue;
+
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
 
+		[[nodiscard]]
+		bool cacheGlyphs(const FontData& font, const Array<MSDFGlyph>& glyphs);
+
 		void updateTexture();
 	};
 }
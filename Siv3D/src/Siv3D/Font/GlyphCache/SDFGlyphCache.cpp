@@ -15,6 +15,7 @@
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "SDFGlyphCache.hpp"
+# include "../GlyphRenderer/SDFGlyphRenderer.hpp"
 
 namespace s3d
 {
@@ -484,6 +485,64 @@ namespace s3d
 		return prerender(font, font.getGlyphClusters(s, false, Ligature::Yes), true);
 	}
 
+	bool SDFGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		// 完了した先読みを取り込む
+		if (not prerender(font, {}, true))
+		{
+			return false;
+		}
+
+		const Array<GlyphIndex> glyphIndices = m_preloadQueue.excludePending(
+			GetUncachedGlyphIndices(font.getGlyphClusters(s, false, Ligature::Yes), true, m_glyphTable));
+
+		if (not glyphIndices)
+		{
+			return true;
+		}
+
+		// 先に要求された先読みの完了は待たずに追加する
+		std::shared_ptr<SDFGlyphBatch> batch = font.prepareSDFGlyphs(glyphIndices, m_buffer.bufferWidth);
+
+		m_preloadQueue.push(glyphIndices, [batch = std::move(batch)]() { return batch->render(); });
+
+		return true;
+	}
+
+	bool SDFGlyphCache::save(const FontData& font, const FilePathView path)
+	{
+		// 先読み中のグリフも含めて保存する
+		if (not m_preloadQueue.mergeAll([&](const Array<SDFGlyph>& glyphs) { return cacheGlyphs(font, glyphs); }))
+		{
+			return false;
+		}
+
+		return SaveGlyphCacheFile(path, font, m_buffer, m_glyphTable);
+	}
+
+	bool SDFGlyphCache::load(const FontData& font, const FilePathView path)
+	{
+		if (not m_preloadQueue.mergeAll([&](const Array<SDFGlyph>& glyphs) { return cacheGlyphs(font, glyphs); }))
+		{
+			return false;
+		}
+
+		if (not LoadGlyphCacheFile(path, font, m_buffer, m_glyphTable))
+		{
+			return false;
+		}
+
+		m_hasDirty = true;
+
+		// texture content can be updated in a different thread
+		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
+		{
+			updateTexture();
+		}
+
+		return true;
+	}
+
 	const Texture& SDFGlyphCache::getTexture() noexcept
 	{
 		updateTexture();
@@ -528,20 +587,46 @@ namespace s3d
 			m_hasDirty = true;
 		}
 
-		for (const auto& cluster : clusters)
+		// 完了した先読みを取り込む。必要なグリフが先読み中であれば、その先読みまでの完了を待つ
+		if (not m_preloadQueue.merge(clusters, isMainFont, [&](const Array<SDFGlyph>& glyphs) { return cacheGlyphs(font, glyphs); }))
+		{
+			return false;
+		}
+
+		const Array<GlyphIndex> glyphIndices = GetUncachedGlyphIndices(clusters, isMainFont, m_glyphTable);
+
+		if (glyphIndices.size() == 1)
 		{
-			if (isMainFont && (cluster.fontIndex != 0))
+			const SDFGlyph glyph = font.renderSDFByGlyphIndex(glyphIndices.front(), m_buffer.bufferWidth);
+
+			if (not cacheGlyphs(font, { glyph }))
 			{
-				continue;
+				return false;
 			}
-
-			if (m_glyphTable.contains(cluster.glyphIndex))
+		}
+		else if (glyphIndices)
+		{
+			// アウトラインの取得と距離場の生成を並列に行う
+			if (not cacheGlyphs(font, font.prepareSDFGlyphs(glyphIndices, m_buffer.bufferWidth)->render()))
 			{
-				continue;
+				return false;
 			}
+		}
 
-			const SDFGlyph glyph = font.renderSDFByGlyphIndex(cluster.glyphIndex, m_buffer.bufferWidth);
+		// texture content can be updated in a different thread
+		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
+		{
+			updateTexture();
+		}
+
+		return true;
+	}
 
+	bool SDFGlyphCache::cacheGlyphs(const FontData& font, const Array<SDFGlyph>& glyphs)
+	{
+		// テクスチャ上の配置が生成の順序に依存しないよう、要求された順に書き込む
+		for (const auto& glyph : glyphs)
+		{
 			if (m_glyphTable.contains(glyph.glyphIndex))
 			{
 				continue;
@@ -555,12 +640,6 @@ namespace s3d
 			m_hasDirty = true;
 		}
 
-		// texture content can be updated in a different thread
-		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
-		{
-			updateTexture();
-		}
-
 		return true;
 	}
 
@@ -10,8 +10,11 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
 # include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
 # include <Siv3D/MSDFGlyph.hpp>
+# include <Siv3D/FontStyle.hpp>
 
 struct FT_FaceRec_;
 typedef struct FT_FaceRec_* FT_Face;
@@ -20,6 +23,47 @@ namespace s3d
 {
 	struct FontFaceProperty;
 
+	class FontFacePool;
+
 	[[nodiscard]]
 	MSDFGlyph RenderMSDFGlyph(FT_Face face, GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop);
+
+	// アウトラインの取得と距離場の生成を render() で並列に行う
+	// アウトラインの取得には FontFacePool から借りたフォントフェイスを使う。借りられなかった場合は、構築時に呼び出し元のスレッドで face から取得する
+	class MSDFGlyphBatch
+	{
+	public:
+
+		MSDFGlyphBatch(FT_Face face, const std::shared_ptr<FontFacePool>& facePool, const Array<GlyphIndex>& glyphIndices, int32 buffer, const FontFaceProperty& prop);
+
+		~MSDFGlyphBatch();
+
+		[[nodiscard]]
+		const Array<GlyphIndex>& glyphIndices() const noexcept;
+
+		// 任意のスレッドから 1 回だけ呼べる。結果は glyphIndices() と同じ順で、失敗したグリフは空
+		[[nodiscard]]
+		Array<MSDFGlyph> render();
+
+	private:
+
+		struct Outline;
+
+		std::shared_ptr<FontFacePool> m_facePool;
+
+		// 借りているフォントフェイス
+		Array<FT_Face> m_faces;
+
+		FontStyle m_style = FontStyle::Default;
+
+		Array<GlyphIndex> m_glyphIndices;
+
+		std::unique_ptr<Outline[]> m_outlines;
+
+		int32 m_buffer = 0;
+
+		int16 m_ascender = 0;
+
+		int16 m_descender = 0;
+	};
 }
@@ -11,7 +11,9 @@
 
 # include "GlyphRenderer.hpp"
 # include "SDFGlyphRenderer.hpp"
+# include "../FontFacePool.hpp"
 # include "../FreeType.hpp"
+# include <Siv3D/ParallelFor.hpp>
 # include <ThirdParty/msdfgen/msdfgen.h>
 # include <ThirdParty/msdfgen/ext/resolve-shape-geometry.h>
 
@@ -136,66 +138,174 @@ namespace s3d
 
 			return image;
 		}
+
+		struct SDFOutline
+		{
+			msdfgen::Shape shape;
+
+			GlyphBBox bbox;
+
+			double xAdvance = 0.0;
+
+			double yAdvance = 0.0;
+
+			bool loaded = false;
+		};
+
+		// FreeType を使うため、フォントフェイスを所有するスレッドからのみ呼ぶ
+		[[nodiscard]]
+		static bool LoadSDFOutline(FT_Face face, const GlyphIndex glyphIndex, const FontStyle style, SDFOutline& outline)
+		{
+			if (not LoadOutlineGlyph(face, glyphIndex, style))
+			{
+				return false;
+			}
+
+			if (not GetShape(face, outline.shape))
+			{
+				return false;
+			}
+
+			outline.bbox		= GetBound(outline.shape);
+			outline.xAdvance	= (face->glyph->metrics.horiAdvance / 64.0);
+			outline.yAdvance	= (face->glyph->metrics.vertAdvance / 64.0);
+			outline.loaded		= true;
+			return true;
+		}
+
+		// FreeType を使わないため、任意のスレッドから呼べる
+		[[nodiscard]]
+		static SDFGlyph GenerateSDFGlyph(const SDFOutline& outline, const GlyphIndex glyphIndex, const int32 buffer, const int16 ascender, const int16 descender)
+		{
+			if (std::isinf(outline.bbox.xMin) || std::isinf(outline.bbox.xMax) || std::isinf(outline.bbox.yMin) || std::isinf(outline.bbox.yMax))
+			{
+				SDFGlyph result;
+				result.glyphIndex	= glyphIndex;
+				result.buffer		= buffer;
+				result.left			= 0;
+				result.top			= 0;
+				result.width		= 0;
+				result.height		= 0;
+				result.xAdvance		= outline.xAdvance;
+				result.yAdvance		= outline.yAdvance;
+				result.ascender		= ascender;
+				result.descender	= descender;
+				result.image		= {};
+				return result;
+			}
+			else
+			{
+				const int32 width		= static_cast<int32>(outline.bbox.xMax - outline.bbox.xMin);
+				const int32 height		= static_cast<int32>(outline.bbox.yMax - outline.bbox.yMin);
+				const Vec2 offset{ (-outline.bbox.xMin+ buffer), (-outline.bbox.yMin + buffer) };
+				const msdfgen::Projection projection{ 1.0, msdfgen::Vector2{ offset.x, offset.y } };
+				msdfgen::GeneratorConfig generatorConfig;
+				generatorConfig.overlapSupport = false;
+
+				msdfgen::Bitmap<float, 1> bitmap{ (width + (2 * buffer)), (height + (2 * buffer)) };
+				msdfgen::generateSDF(bitmap, outline.shape, projection, 8.0, generatorConfig);
+
+				SDFGlyph result;
+				result.glyphIndex	= glyphIndex;
+				result.buffer		= buffer;
+				result.left			= static_cast<int16>(outline.bbox.xMin);
+				result.top			= static_cast<int16>(outline.bbox.yMax);
+				result.width		= static_cast<int16>(width);
+				result.height		= static_cast<int16>(height);
+				result.xAdvance		= outline.xAdvance;
+				result.yAdvance		= outline.yAdvance;
+				result.ascender		= ascender;
+				result.descender	= descender;
+				result.image		= detail::RenderMSDF(bitmap);
+				return result;
+			}
+		}
 	}
 
+	struct SDFGlyphBatch::Outline : detail::SDFOutline {};
+
 	SDFGlyph RenderSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
 	{
-		if (not LoadOutlineGlyph(face, glyphIndex, prop.style))
+		detail::SDFOutline outline;
+
+		if (not detail::LoadSDFOutline(face, glyphIndex, prop.style, outline))
 		{
 			return{};
 		}
 
 		buffer = Max(buffer, 0);
 
-		msdfgen::Shape shape;	
-		if (not detail::GetShape(face, shape))
+		return detail::GenerateSDFGlyph(outline, glyphIndex, buffer, prop.ascender, prop.descender);
+	}
+
+	SDFGlyphBatch::SDFGlyphBatch(FT_Face face, const std::shared_ptr<FontFacePool>& facePool, const Array<GlyphIndex>& glyphIndices, const int32 buffer, const FontFaceProperty& prop)
+		: m_facePool{ facePool }
+		, m_style{ prop.style }
+		, m_glyphIndices{ glyphIndices }
+		, m_outlines{ std::make_unique<Outline[]>(glyphIndices.size()) }
+		, m_buffer{ Max(buffer, 0) }
+		, m_ascender{ prop.ascender }
+		, m_descender{ prop.descender }
+	{
+		if (m_facePool)
 		{
-			return{};
+			m_faces = m_facePool->acquire((m_glyphIndices.size() + (FontFacePool::GlyphsPerFace - 1)) / FontFacePool::GlyphsPerFace);
 		}
 
-		const GlyphBBox bbox = detail::GetBound(shape);
-
-		if (std::isinf(bbox.xMin) || std::isinf(bbox.xMax) || std::isinf(bbox.yMin) || std::isinf(bbox.yMax))
-		{
-			SDFGlyph result;
-			result.glyphIndex	= glyphIndex;
-			result.buffer		= buffer;
-			result.left			= 0;
-			result.top			= 0;
-			result.width		= 0;
-			result.height		= 0;
-			result.xAdvance		= (face->glyph->metrics.horiAdvance / 64.0);
-			result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
-			result.ascender		= prop.ascender;
-			result.descender	= prop.descender;
-			result.image		= {};
-			return result;
+		if (not m_faces)
+		{
+			for (size_t i = 0; i < m_glyphIndices.size(); ++i)
+			{
+				[[maybe_unused]] const bool loaded = detail::LoadSDFOutline(face, m_glyphIndices[i], m_style, m_outlines[i]);
+			}
 		}
-		else
-		{
-			const int32 width		= static_cast<int32>(bbox.xMax - bbox.xMin);
-			const int32 height		= static_cast<int32>(bbox.yMax - bbox.yMin);
-			const Vec2 offset{ (-bbox.xMin+ buffer), (-bbox.yMin + buffer) };
-			const msdfgen::Projection projection{ 1.0, msdfgen::Vector2{ offset.x, offset.y } };
-			msdfgen::GeneratorConfig generatorConfig;
-			generatorConfig.overlapSupport = false;
-
-			msdfgen::Bitmap<float, 1> bitmap{ (width + (2 * buffer)), (height + (2 * buffer)) };
-			msdfgen::generateSDF(bitmap, shape, projection, 8.0, generatorConfig);
-
-			SDFGlyph result;
-			result.glyphIndex	= glyphIndex;
-			result.buffer		= buffer;
-			result.left			= static_cast<int16>(bbox.xMin);
-			result.top			= static_cast<int16>(bbox.yMax);
-			result.width		= static_cast<int16>(width);
-			result.height		= static_cast<int16>(height);
-			result.xAdvance		= (face->glyph->metrics.horiAdvance / 64.0);
-			result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
-			result.ascender		= prop.ascender;
-			result.descender	= prop.descender;
-			result.image		= detail::RenderMSDF(bitmap);
-			return result;
+	}
+
+	SDFGlyphBatch::~SDFGlyphBatch()
+	{
+		if (m_faces)
+		{
+			m_facePool->release(m_faces);
 		}
 	}
+
+	const Array<GlyphIndex>& SDFGlyphBatch::glyphIndices() const noexcept
+	{
+		return m_glyphIndices;
+	}
+
+	Array<SDFGlyph> SDFGlyphBatch::render()
+	{
+		// 借りたフォントフェイスごとに、アウトラインの取得を分担する
+		if (m_faces)
+		{
+			const size_t count = m_glyphIndices.size();
+
+			ParallelFor(0, m_faces.size(), [&](const size_t k)
+			{
+				const size_t first = (count * k / m_faces.size());
+				const size_t last = (count * (k + 1) / m_faces.size());
+
+				for (size_t i = first; i < last; ++i)
+				{
+					[[maybe_unused]] const bool loaded = detail::LoadSDFOutline(m_faces[k], m_glyphIndices[i], m_style, m_outlines[i]);
+				}
+			}, 1);
+
+			m_facePool->release(m_faces);
+			m_faces.clear();
+		}
+
+		Array<SDFGlyph> results(m_glyphIndices.size());
+
+		ParallelFor(0, m_glyphIndices.size(), [&](const size_t i)
+		{
+			if (m_outlines[i].loaded)
+			{
+				results[i] = detail::GenerateSDFGlyph(m_outlines[i], m_glyphIndices[i], m_buffer, m_ascender, m_descender);
+			}
+		}, 1);
+
+		return results;
+	}
 }
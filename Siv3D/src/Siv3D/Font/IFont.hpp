@@ -84,6 +84,12 @@ namespace s3d
 
 		virtual bool preload(Font::IDType handleID, StringView chars) = 0;
 
+		virtual bool preloadAsync(Font::IDType handleID, StringView chars) = 0;
+
+		virtual bool saveGlyphCache(Font::IDType handleID, FilePathView path) = 0;
+
+		virtual bool loadGlyphCache(Font::IDType handleID, FilePathView path) = 0;
+
 		virtual const Texture& getTexture(Font::IDType handleID) = 0;
 
 		virtual Glyph getGlyph(Font::IDType handleID, StringView ch) = 0;
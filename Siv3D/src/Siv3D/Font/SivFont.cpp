@@ -398,6 +398,21 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->preload(m_handle->id(), chars);
 	}
 
+	bool Font::preloadAsync(const StringView chars) const
+	{
+		return SIV3D_ENGINE(Font)->preloadAsync(m_handle->id(), chars);
+	}
+
+	bool Font::saveGlyphCache(const FilePathView path) const
+	{
+		return SIV3D_ENGINE(Font)->saveGlyphCache(m_handle->id(), path);
+	}
+
+	bool Font::loadGlyphCache(const FilePathView path) const
+	{
+		return SIV3D_ENGINE(Font)->loadGlyphCache(m_handle->id(), path);
+	}
+
 	const Texture& Font::getTexture() const
 	{
 		return SIV3D_ENGINE(Font)->getTexture(m_handle->id());
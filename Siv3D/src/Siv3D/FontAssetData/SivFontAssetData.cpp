@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/FontAssetData.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 
 namespace s3d
 {
@@ -32,6 +33,8 @@ namespace s3d
 
 	bool FontAssetData::load(const String& hint)
 	{
+		SIV3D_PROFILE_ZONE(U"FontAsset::load");
+
 		if (isUninitialized())
 		{
 			if (onLoad(*this, hint))
@@ -58,21 +61,13 @@ namespace s3d
 	{
 		if (isUninitialized())
 		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
-				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
-				});
+			requestAsyncLoad([this, hint = hint]() { return onLoad(*this, hint); }, { path });
 		}
 	}
 
 	void FontAssetData::wait()
 	{
-		if (m_task.isValid())
-		{
-			m_task.get();
-		}
+		waitAsyncLoad();
 	}
 
 	void FontAssetData::release()
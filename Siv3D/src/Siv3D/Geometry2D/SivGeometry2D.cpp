@@ -660,6 +660,30 @@ namespace s3d
 
 			return Polygon{ outer, holes, SkipValidation::Yes };
 		}
+
+		// 境界ボックスが region と交差する多角形について、f が true を返すまで f を呼ぶ
+		template <class Fty>
+		[[nodiscard]]
+		static bool AnyPolygon(const MultiPolygon& polygons, const RectF& region, Fty f)
+		{
+			if (const MultiPolygonSpatialIndex* index = polygons._spatialIndex())
+			{
+				return index->anyPolygon(region, [&](const uint32 i)
+					{
+						return f(polygons[i]);
+					});
+			}
+
+			for (const Polygon& polygon : polygons)
+			{
+				if (f(polygon))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
 	}
 
 	namespace detail
@@ -984,30 +1008,18 @@ namespace s3d
 				return false;
 			}
 
-			const size_t num_triangles = b.num_triangles();
-
-			for (size_t i = 0; i < num_triangles; ++i)
-			{
-				if (Intersect(a, b.triangle(i)))
+			return b._detail()->anyTriangle(RectF{ a, 0, 0 }, [&a](const Triangle& triangle)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, triangle);
+				});
 		}
 
 		bool Intersect(const Vec2& a, const MultiPolygon& b) noexcept
 		{
-			for (const auto& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, RectF{ a, 0, 0 }, [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const Vec2& a, const LineString& b) noexcept
@@ -1247,15 +1259,10 @@ namespace s3d
 
 		bool Intersect(const Line& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a.boundingRect(), [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const Line& a, const LineString& b) noexcept
@@ -1428,15 +1435,10 @@ namespace s3d
 
 		bool Intersect(const RectF& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a, [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const RectF& a, const LineString& b) noexcept
@@ -1488,30 +1490,18 @@ namespace s3d
 				return false;
 			}
 
-			const size_t num_triangles = b.num_triangles();
-
-			for (size_t i = 0; i < num_triangles; ++i)
-			{
-				if (Intersect(a, b.triangle(i)))
+			return b._detail()->anyTriangle(a.boundingRect(), [&a](const Triangle& triangle)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, triangle);
+				});
 		}
 
 		bool Intersect(const Circle& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a.boundingRect(), [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const Circle& a, const LineString& b) noexcept
@@ -1653,15 +1643,10 @@ namespace s3d
 
 		bool Intersect(const Ellipse& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a.boundingRect(), [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const Ellipse& a, const LineString& b) noexcept
@@ -1779,15 +1764,10 @@ namespace s3d
 
 		bool Intersect(const Triangle& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a.boundingRect(), [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const Triangle& a, const LineString& b) noexcept
@@ -1849,15 +1829,10 @@ namespace s3d
 
 		bool Intersect(const Quad& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a.boundingRect(), [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const Quad& a, const LineString& b) noexcept
@@ -1923,15 +1898,10 @@ namespace s3d
 
 		bool Intersect(const RoundRect& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (Intersect(a, polygon))
+			return detail::AnyPolygon(b, a.rect, [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return Intersect(a, polygon);
+				});
 		}
 
 		bool Intersect(const RoundRect& a, const LineString& b) noexcept
@@ -1971,15 +1941,10 @@ namespace s3d
 
 		bool Intersect(const Polygon& a, const MultiPolygon& b) noexcept
 		{
-			for (const Polygon& polygon : b)
-			{
-				if (a.intersects(polygon))
+			return detail::AnyPolygon(b, a.boundingRect(), [&a](const Polygon& polygon)
 				{
-					return true;
-				}
-			}
-
-			return false;
+					return a.intersects(polygon);
+				});
 		}
 
 		bool Intersect(const Polygon& a, const LineString& b) noexcept
@@ -2006,12 +1971,9 @@ namespace s3d
 		{
 			for (const Polygon& polygonA : a)
 			{
-				for (const Polygon& polygonB : b)
+				if (detail::AnyPolygon(b, polygonA.boundingRect(), [&polygonA](const Polygon& polygonB) { return polygonA.intersects(polygonB); }))
 				{
-					if (polygonA.intersects(polygonB))
-					{
-						return true;
-					}
+					return true;
 				}
 			}
 
@@ -2517,13 +2479,10 @@ namespace s3d
 
 			Array<Vec2> results;
 
-			for (const Array<Vec2>& inner : b.inners())
-			{
-				const size_t inner_size = inner.size();
-
-				for (size_t i = 0; i < inner_size; ++i)
+			// 穴、外周の順に、線分の境界ボックスと交差する辺だけを調べる
+			b._detail()->anyEdge(a.boundingRect(), [&](const Vec2& begin, const Vec2& end)
 				{
-					if (const auto& point = a.intersectsAt(Line{ inner[i], inner[(i + 1) % inner_size] }))
+					if (const auto& point = a.intersectsAt(Line{ begin, end }))
 					{
 						hasIntersection = true;
 
@@ -2532,25 +2491,9 @@ namespace s3d
 							results << *point;
 						}
 					}
-				}
-			}
-
-			const Array<Vec2>& outer = b.outer();
 
-			const size_t outer_size = outer.size();
-
-			for (size_t i = 0; i < outer_size; ++i)
-			{
-				if (const auto& point = a.intersectsAt(Line{ outer[i], outer[(i + 1) % outer_size] }))
-				{
-					hasIntersection = true;
-
-					if (not point->hasNaN())
-					{
-						results << *point;
-					}
-				}
-			}
+					return false;
+				});
 
 			if (hasIntersection)
 			{
@@ -4450,35 +4393,10 @@ namespace s3d
 				return false;
 			}
 
-			{
-				const auto& outer = a._detail()->getPolygon().outer();
-				const size_t num_outer = outer.size();
-
-				for (size_t i = 0; i < num_outer; ++i)
-				{
-					if (Line{ outer[i], outer[(i + 1) % num_outer] }.intersects(b))
-					{
-						return false;
-					}
-				}
-			}
-
-			{
-				for (const auto& inner : a._detail()->getPolygon().inners())
+			return (not a._detail()->anyEdge(b.boundingRect(), [&b](const Vec2& begin, const Vec2& end)
 				{
-					const size_t num_inner = inner.size();
-
-					for (size_t i = 0; i < num_inner; ++i)
-					{
-						if (Line{ inner[i], inner[(i + 1) % num_inner] }.intersects(b))
-						{
-							return false;
-						}
-					}
-				}
-			}
-
-			return true;
+					return Line{ begin, end }.intersects(b);
+				}));
 		}
 
 		bool Contains(const Polygon& a, const Triangle& b)
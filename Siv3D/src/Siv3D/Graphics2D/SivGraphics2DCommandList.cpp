@@ -0,0 +1,593 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Graphics2DCommandList.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/LineStyle.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Renderer2D/IRenderer2D.hpp>
+# include <Siv3D/Renderer2D/Vertex2DBuilder.hpp>
+# include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	namespace Graphics2D
+	{
+		namespace detail
+		{
+			// 1 回の addPolygon() / addTexturedVertices() で送れる最大数
+			static constexpr uint32 MaxSegmentVertexCount = 65535;
+
+			static constexpr uint32 MaxSegmentIndexCount = 65535;
+
+			// 並べ替え先を探すときにさかのぼるセグメントの最大数
+			static constexpr size_t MaxReorderSearchDepth = 32;
+
+			[[nodiscard]]
+			static bool IsSameTexture(const Optional<Texture>& a, const Optional<Texture>& b) noexcept
+			{
+				if (a.has_value() != b.has_value())
+				{
+					return false;
+				}
+
+				return ((not a) || (a->id() == b->id()));
+			}
+
+			[[nodiscard]]
+			static RectF CalculateBounds(const Vertex2D* vertices, const size_t vertexCount) noexcept
+			{
+				Float2 minPos = vertices[0].pos;
+				Float2 maxPos = vertices[0].pos;
+
+				for (size_t i = 1; i < vertexCount; ++i)
+				{
+					const Float2 pos = vertices[i].pos;
+					minPos.x = Min(minPos.x, pos.x);
+					minPos.y = Min(minPos.y, pos.y);
+					maxPos.x = Max(maxPos.x, pos.x);
+					maxPos.y = Max(maxPos.y, pos.y);
+				}
+
+				return{ minPos, (maxPos - minPos) };
+			}
+
+			[[nodiscard]]
+			static RectF Union(const RectF& a, const RectF& b) noexcept
+			{
+				const double left	= Min(a.x, b.x);
+				const double top	= Min(a.y, b.y);
+				const double right	= Max((a.x + a.w), (b.x + b.w));
+				const double bottom	= Max((a.y + a.h), (b.y + b.h));
+				return{ left, top, (right - left), (bottom - top) };
+			}
+
+			// 辺が接している場合も重なっているとみなす
+			[[nodiscard]]
+			static bool Overlaps(const RectF& a, const RectF& b) noexcept
+			{
+				return ((a.x <= (b.x + b.w)) && (b.x <= (a.x + a.w))
+					&& (a.y <= (b.y + b.h)) && (b.y <= (a.y + a.h)));
+			}
+		}
+
+		void CommandList::clear() noexcept
+		{
+			for (size_t i = 0; i < m_segmentCount; ++i)
+			{
+				Segment& segment = m_segments[i];
+				segment.texture.reset();
+				segment.vertices.clear();
+				segment.indices.clear();
+			}
+
+			m_segmentCount = 0;
+			m_vertexCount = 0;
+			m_indexCount = 0;
+			m_transform = Mat3x2::Identity();
+			m_maxScaling = 1.0f;
+			m_hasTransform = false;
+			m_reorderable = false;
+			m_blendState.reset();
+			m_rasterizerState.reset();
+			m_texture.reset();
+		}
+
+		void CommandList::reserve(const size_t vertexCount, const size_t triangleCount)
+		{
+			const auto reserveSegment = [=](Segment& segment)
+			{
+				segment.vertices.reserve(Min<size_t>((segment.vertices.size() + vertexCount), detail::MaxSegmentVertexCount));
+				segment.indices.reserve(Min<size_t>((segment.indices.size() + triangleCount * 3), detail::MaxSegmentIndexCount));
+			};
+
+			// 次の図形は、最後のセグメントか、その次に使われるセグメントに追加される
+			if (m_segmentCount != 0)
+			{
+				reserveSegment(m_segments[m_segmentCount - 1]);
+			}
+
+			if (m_segmentCount == m_segments.size())
+			{
+				m_segments.emplace_back();
+			}
+
+			reserveSegment(m_segments[m_segmentCount]);
+		}
+
+		bool CommandList::isEmpty() const noexcept
+		{
+			return (m_segmentCount == 0);
+		}
+
+		size_t CommandList::num_vertices() const noexcept
+		{
+			return m_vertexCount;
+		}
+
+		size_t CommandList::num_triangles() const noexcept
+		{
+			return (m_indexCount / 3);
+		}
+
+		void CommandList::setTransform(const Mat3x2& transform) noexcept
+		{
+			m_transform = transform;
+			m_maxScaling = s3d::detail::CalculateMaxScaling(transform);
+			m_hasTransform = (transform != Mat3x2::Identity());
+		}
+
+		const Mat3x2& CommandList::getTransform() const noexcept
+		{
+			return m_transform;
+		}
+
+		void CommandList::setBlendState(const Optional<BlendState>& blendState) noexcept
+		{
+			m_blendState = blendState;
+		}
+
+		void CommandList::setRasterizerState(const Optional<RasterizerState>& rasterizerState) noexcept
+		{
+			m_rasterizerState = rasterizerState;
+		}
+
+		void CommandList::setReorderable(const bool reorderable) noexcept
+		{
+			m_reorderable = reorderable;
+		}
+
+		bool CommandList::isReorderable() const noexcept
+		{
+			return m_reorderable;
+		}
+
+		size_t CommandList::num_batches() const noexcept
+		{
+			return m_segmentCount;
+		}
+
+		void CommandList::addTriangle(const Triangle& triangle, const ColorF& color)
+		{
+			m_texture.reset();
+
+			const Float2 points[3] = { triangle.p0, triangle.p1, triangle.p2 };
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildTriangle(bufferCreator, points, color0);
+			});
+		}
+
+		void CommandList::addRect(const RectF& rect, const ColorF& color)
+		{
+			m_texture.reset();
+
+			const FloatRect floatRect{ rect.x, rect.y, (rect.x + rect.w), (rect.y + rect.h) };
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildRect(bufferCreator, floatRect, color0);
+			});
+		}
+
+		void CommandList::addRectFrame(const RectF& rect, const double thickness, const ColorF& color)
+		{
+			const double innerThickness = (thickness * 0.5);
+
+			if ((rect.w <= 0.0) || (rect.h <= 0.0) || (thickness <= 0.0))
+			{
+				return;
+			}
+
+			if (((rect.w * 0.5) <= innerThickness) || ((rect.h * 0.5) <= innerThickness))
+			{
+				addRect(rect.stretched(innerThickness), color);
+				return;
+			}
+
+			m_texture.reset();
+
+			const FloatRect floatRect{ (rect.x + innerThickness), (rect.y + innerThickness), (rect.x + rect.w - innerThickness), (rect.y + rect.h - innerThickness) };
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildRectFrame(bufferCreator, floatRect, static_cast<float>(thickness), color0, color0);
+			});
+		}
+
+		void CommandList::addCircle(const Circle& circle, const ColorF& color)
+		{
+			m_texture.reset();
+
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildCircle(bufferCreator, circle.center, static_cast<float>(circle.r), color0, color0, m_maxScaling);
+			});
+		}
+
+		void CommandList::addCircleFrame(const Circle& circle, const double thickness, const ColorF& color)
+		{
+			m_texture.reset();
+
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildCircleFrame(bufferCreator, circle.center, static_cast<float>(circle.r - thickness * 0.5), static_cast<float>(thickness), color0, color0, m_maxScaling);
+			});
+		}
+
+		void CommandList::addLine(const Line& line, const double thickness, const ColorF& color)
+		{
+			m_texture.reset();
+
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildLine(LineStyle::Default, bufferCreator, line.begin, line.end, static_cast<float>(thickness), { color0, color0 }, m_maxScaling);
+			});
+		}
+
+		void CommandList::addQuad(const Quad& quad, const ColorF& color)
+		{
+			m_texture.reset();
+
+			const FloatQuad floatQuad{ quad.p0, quad.p1, quad.p2, quad.p3 };
+			const Float4 color0 = color.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildQuad(bufferCreator, floatQuad, color0);
+			});
+		}
+
+		void CommandList::addTexture(const Texture& texture, const Vec2& pos, const ColorF& diffuse)
+		{
+			addTextureRegion(TextureRegion{ texture }, RectF{ pos, texture.size() }, diffuse);
+		}
+
+		void CommandList::addTextureRegion(const TextureRegion& region, const RectF& rect, const ColorF& diffuse)
+		{
+			if (not detail::IsSameTexture(m_texture, region.texture))
+			{
+				m_texture = region.texture;
+			}
+
+			const FloatRect floatRect{ rect.x, rect.y, (rect.x + rect.w), (rect.y + rect.h) };
+			const Float4 color0 = diffuse.toFloat4();
+
+			build([&](const BufferCreatorFunc& bufferCreator)
+			{
+				return Vertex2DBuilder::BuildTextureRegion(bufferCreator, floatRect, region.uvRect, color0);
+			});
+		}
+
+		void CommandList::addVertices(const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles, const Optional<Texture>& texture)
+		{
+			if ((vertexCount == 0) || (num_triangles == 0))
+			{
+				return;
+			}
+
+			if (not detail::IsSameTexture(m_texture, texture))
+			{
+				m_texture = texture;
+			}
+
+			if ((vertexCount <= detail::MaxSegmentVertexCount)
+				&& ((num_triangles * 3) <= detail::MaxSegmentIndexCount))
+			{
+				build([&](const BufferCreatorFunc& bufferCreator)
+				{
+					return Vertex2DBuilder::BuildPolygon(bufferCreator, vertices, vertexCount, indices, num_triangles);
+				});
+
+				return;
+			}
+
+			// 1 つのセグメントに収まらない場合は、三角形を先頭から順に複数のセグメントに分けて記録する
+			constexpr uint32 NotMapped = UINT32_MAX;
+
+			Array<uint32> localIndices(vertexCount, NotMapped);
+			Array<uint32> sourceIndices;
+			Array<Vertex2D> chunkVertices;
+			Array<TriangleIndex> chunkTriangles;
+
+			const auto flush = [&]()
+			{
+				if (chunkTriangles)
+				{
+					build([&](const BufferCreatorFunc& bufferCreator)
+					{
+						return Vertex2DBuilder::BuildPolygon(bufferCreator, chunkVertices.data(), chunkVertices.size(), chunkTriangles.data(), chunkTriangles.size());
+					});
+				}
+
+				for (const auto sourceIndex : sourceIndices)
+				{
+					localIndices[sourceIndex] = NotMapped;
+				}
+
+				sourceIndices.clear();
+				chunkVertices.clear();
+				chunkTriangles.clear();
+			};
+
+			const auto mapIndex = [&](const Vertex2D::IndexType index)
+			{
+				uint32& localIndex = localIndices[index];
+
+				if (localIndex == NotMapped)
+				{
+					localIndex = static_cast<uint32>(chunkVertices.size());
+					sourceIndices.push_back(index);
+					chunkVertices.push_back(vertices[index]);
+				}
+
+				return static_cast<Vertex2D::IndexType>(localIndex);
+			};
+
+			size_t invalidTriangleCount = 0;
+
+			for (size_t i = 0; i < num_triangles; ++i)
+			{
+				const TriangleIndex& triangle = indices[i];
+
+				if ((vertexCount <= triangle.i0) || (vertexCount <= triangle.i1) || (vertexCount <= triangle.i2))
+				{
+					++invalidTriangleCount;
+					continue;
+				}
+
+				if ((detail::MaxSegmentVertexCount < (chunkVertices.size() + 3))
+					|| (detail::MaxSegmentIndexCount < ((chunkTriangles.size() + 1) * 3)))
+				{
+					flush();
+				}
+
+				const Vertex2D::IndexType i0 = mapIndex(triangle.i0);
+				const Vertex2D::IndexType i1 = mapIndex(triangle.i1);
+				const Vertex2D::IndexType i2 = mapIndex(triangle.i2);
+				chunkTriangles.push_back(TriangleIndex{ i0, i1, i2 });
+			}
+
+			flush();
+
+			if (invalidTriangleCount)
+			{
+				LOG_FAIL(U"Graphics2D::CommandList::addVertices(): {} triangles with out-of-range indices were skipped"_fmt(invalidTriangleCount));
+			}
+		}
+
+		void CommandList::draw() const
+		{
+			if (m_segmentCount == 0)
+			{
+				return;
+			}
+
+			auto pRenderer = SIV3D_ENGINE(Renderer2D);
+			const BlendState oldBlendState = pRenderer->getBlendState();
+			const RasterizerState oldRasterizerState = pRenderer->getRasterizerState();
+
+			for (size_t i = 0; i < m_segmentCount; ++i)
+			{
+				const Segment& segment = m_segments[i];
+
+				pRenderer->setBlendState(segment.blendState.value_or(oldBlendState));
+				pRenderer->setRasterizerState(segment.rasterizerState.value_or(oldRasterizerState));
+
+				const Vertex2D* pVertex = segment.vertices.data();
+				const TriangleIndex* pIndex = reinterpret_cast<const TriangleIndex*>(segment.indices.data());
+				const size_t num_triangles = (segment.indices.size() / 3);
+
+				if (segment.texture)
+				{
+					pRenderer->addTexturedVertices(*segment.texture, pVertex, segment.vertices.size(), pIndex, num_triangles);
+				}
+				else
+				{
+					pRenderer->addPolygon(pVertex, segment.vertices.size(), pIndex, num_triangles);
+				}
+			}
+
+			pRenderer->setBlendState(oldBlendState);
+			pRenderer->setRasterizerState(oldRasterizerState);
+		}
+
+		bool CommandList::isCompatible(const Segment& segment) const noexcept
+		{
+			return (detail::IsSameTexture(segment.texture, m_texture)
+				&& (segment.blendState == m_blendState)
+				&& (segment.rasterizerState == m_rasterizerState));
+		}
+
+		CommandList::Segment& CommandList::newSegment()
+		{
+			if (m_segmentCount == m_segments.size())
+			{
+				m_segments.emplace_back();
+			}
+
+			Segment& segment = m_segments[m_segmentCount++];
+			segment.texture			= m_texture;
+			segment.blendState		= m_blendState;
+			segment.rasterizerState	= m_rasterizerState;
+			segment.bounds			= RectF{ 0 };
+			return segment;
+		}
+
+		CommandList::Segment& CommandList::getSegmentForAppend(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+		{
+			if (m_segmentCount != 0)
+			{
+				Segment& last = m_segments[m_segmentCount - 1];
+
+				if (isCompatible(last)
+					&& ((last.vertices.size() + vertexSize) <= detail::MaxSegmentVertexCount)
+					&& ((last.indices.size() + indexSize) <= detail::MaxSegmentIndexCount))
+				{
+					return last;
+				}
+			}
+
+			return newSegment();
+		}
+
+		CommandList::Segment& CommandList::findSegmentForReorder(const RectF& bounds, const size_t vertexSize, const size_t indexSize)
+		{
+			const size_t searchEnd = ((detail::MaxReorderSearchDepth < m_segmentCount) ? (m_segmentCount - detail::MaxReorderSearchDepth) : 0);
+
+			for (size_t i = m_segmentCount; searchEnd < i; --i)
+			{
+				Segment& segment = m_segments[i - 1];
+
+				if (isCompatible(segment)
+					&& ((segment.vertices.size() + vertexSize) <= detail::MaxSegmentVertexCount)
+					&& ((segment.indices.size() + indexSize) <= detail::MaxSegmentIndexCount))
+				{
+					return segment;
+				}
+
+				// 重なる図形を追い越すと描画結果が変わる
+				if (detail::Overlaps(segment.bounds, bounds))
+				{
+					break;
+				}
+			}
+
+			return newSegment();
+		}
+
+		template <class Builder>
+		void CommandList::build(Builder builder)
+		{
+			if (m_reorderable)
+			{
+				// 領域が確定するまで移動先を決められないので、いったん別のバッファに構築する
+				m_scratch.vertices.clear();
+				m_scratch.indices.clear();
+
+				const BufferCreatorFunc bufferCreator = [this](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+				{
+					const size_t vertexPos = m_scratch.vertices.size();
+					const size_t indexPos = m_scratch.indices.size();
+					m_scratch.vertices.resize(vertexPos + vertexSize);
+					m_scratch.indices.resize(indexPos + indexSize);
+					return Vertex2DBufferPointer{ (m_scratch.vertices.data() + vertexPos), (m_scratch.indices.data() + indexPos), static_cast<Vertex2D::IndexType>(vertexPos) };
+				};
+
+				builder(bufferCreator);
+
+				if (m_scratch.vertices.isEmpty()
+					|| (detail::MaxSegmentVertexCount < m_scratch.vertices.size())
+					|| (detail::MaxSegmentIndexCount < m_scratch.indices.size()))
+				{
+					return;
+				}
+
+				if (m_hasTransform)
+				{
+					for (auto& vertex : m_scratch.vertices)
+					{
+						vertex.pos = m_transform.transformPoint(vertex.pos);
+					}
+				}
+
+				const RectF bounds = detail::CalculateBounds(m_scratch.vertices.data(), m_scratch.vertices.size());
+				Segment& segment = findSegmentForReorder(bounds, m_scratch.vertices.size(), m_scratch.indices.size());
+				const auto indexOffset = static_cast<Vertex2D::IndexType>(segment.vertices.size());
+
+				segment.bounds = (segment.vertices.isEmpty() ? bounds : detail::Union(segment.bounds, bounds));
+				segment.vertices.append(m_scratch.vertices);
+
+				for (const auto index : m_scratch.indices)
+				{
+					segment.indices.push_back(static_cast<Vertex2D::IndexType>(indexOffset + index));
+				}
+
+				m_vertexCount += m_scratch.vertices.size();
+				m_indexCount += m_scratch.indices.size();
+			}
+			else
+			{
+				Segment* pSegment = nullptr;
+				size_t vertexBegin = 0;
+
+				const BufferCreatorFunc bufferCreator = [&](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+				{
+					Segment& segment = getSegmentForAppend(vertexSize, indexSize);
+					const size_t vertexPos = segment.vertices.size();
+					const size_t indexPos = segment.indices.size();
+					segment.vertices.resize(vertexPos + vertexSize);
+					segment.indices.resize(indexPos + indexSize);
+
+					pSegment = &segment;
+					vertexBegin = vertexPos;
+					m_vertexCount += vertexSize;
+					m_indexCount += indexSize;
+
+					return Vertex2DBufferPointer{ (segment.vertices.data() + vertexPos), (segment.indices.data() + indexPos), static_cast<Vertex2D::IndexType>(vertexPos) };
+				};
+
+				builder(bufferCreator);
+
+				if ((not pSegment) || (pSegment->vertices.size() == vertexBegin))
+				{
+					return;
+				}
+
+				Vertex2D* const pVertex = (pSegment->vertices.data() + vertexBegin);
+				const size_t vertexCount = (pSegment->vertices.size() - vertexBegin);
+
+				if (m_hasTransform)
+				{
+					for (size_t i = 0; i < vertexCount; ++i)
+					{
+						pVertex[i].pos = m_transform.transformPoint(pVertex[i].pos);
+					}
+				}
+
+				const RectF bounds = detail::CalculateBounds(pVertex, vertexCount);
+				pSegment->bounds = ((vertexBegin == 0) ? bounds : detail::Union(pSegment->bounds, bounds));
+			}
+		}
+	}
+}
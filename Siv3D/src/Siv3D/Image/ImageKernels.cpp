@@ -0,0 +1,558 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/CPUInfo.hpp>
+# include <Siv3D/SIMD.hpp>
+# include "ImageKernels.hpp"
+
+// x64 では AVX2 / SSE4.1 を実行時に選択する。ARM では SSE4.1 のコードが SIMDe によって NEON に変換される
+# if SIV3D_INTRINSIC(SSE) && (defined(_M_X64) || defined(__x86_64__))
+#	define SIV3D_IMAGE_KERNELS_X64 1
+#	include <immintrin.h>
+#	if defined(_MSC_VER) && !defined(__clang__)
+#		define SIV3D_TARGET_AVX2
+#	else
+#		define SIV3D_TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+# else
+#	define SIV3D_IMAGE_KERNELS_X64 0
+# endif
+
+namespace s3d
+{
+	namespace ImageKernels
+	{
+		namespace
+		{
+			[[nodiscard]]
+			inline uint8 Div255Round(const uint32 x) noexcept
+			{
+				return static_cast<uint8>((x + 127) / 255);
+			}
+
+			void Negate_Reference(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				for (size_t i = 0; i < num_pixels; ++i)
+				{
+					pDst[i] = ~pSrc[i];
+				}
+			}
+
+			void Grayscale_Reference(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				for (size_t i = 0; i < num_pixels; ++i)
+				{
+					const Color pixel = pSrc[i];
+					const uint8 gray = pixel.grayscale0_255();
+					pDst[i] = Color{ gray, gray, gray, pixel.a };
+				}
+			}
+
+			void PremultiplyAlpha_Reference(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				for (size_t i = 0; i < num_pixels; ++i)
+				{
+					const Color pixel = pSrc[i];
+					const uint32 a = pixel.a;
+					pDst[i] = Color{ Div255Round(pixel.r * a), Div255Round(pixel.g * a), Div255Round(pixel.b * a), pixel.a };
+				}
+			}
+
+			void MirrorLine_Reference(const Color* pSrc, Color* pDst, const size_t width)
+			{
+				std::reverse_copy(pSrc, (pSrc + width), pDst);
+			}
+
+			void MirrorLineInPlace_Reference(Color* pLine, const size_t width)
+			{
+				std::reverse(pLine, (pLine + width));
+			}
+
+			void Rotate90_Reference(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+			{
+				for (size_t y = 0; y < srcHeight; ++y)
+				{
+					const Color* pSrcLine = (pSrc + y * srcWidth);
+					const size_t dstX = (srcHeight - y - 1);
+
+					for (size_t x = 0; x < srcWidth; ++x)
+					{
+						pDst[x * srcHeight + dstX] = pSrcLine[x];
+					}
+				}
+			}
+
+			void Rotate270_Reference(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+			{
+				for (size_t y = 0; y < srcHeight; ++y)
+				{
+					const Color* pSrcLine = (pSrc + y * srcWidth);
+
+					for (size_t x = 0; x < srcWidth; ++x)
+					{
+						pDst[(srcWidth - x - 1) * srcHeight + y] = pSrcLine[x];
+					}
+				}
+			}
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			[[nodiscard]]
+			inline __m128i Load(const Color* p) noexcept
+			{
+				return ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			}
+
+			inline void Store(Color* p, const __m128i v) noexcept
+			{
+				::_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+			}
+
+			// 4 ピクセルの並びを逆にする
+			[[nodiscard]]
+			inline __m128i Reverse4(const __m128i v) noexcept
+			{
+				return ::_mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+			}
+
+			inline void Transpose4x4(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3) noexcept
+			{
+				const __m128i t0 = ::_mm_unpacklo_epi32(r0, r1);
+				const __m128i t1 = ::_mm_unpacklo_epi32(r2, r3);
+				const __m128i t2 = ::_mm_unpackhi_epi32(r0, r1);
+				const __m128i t3 = ::_mm_unpackhi_epi32(r2, r3);
+				r0 = ::_mm_unpacklo_epi64(t0, t1);
+				r1 = ::_mm_unpackhi_epi64(t0, t1);
+				r2 = ::_mm_unpacklo_epi64(t2, t3);
+				r3 = ::_mm_unpackhi_epi64(t2, t3);
+			}
+
+			void Negate_SSE4_1(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				const __m128i mask = ::_mm_set1_epi32(0x00FFFFFF);
+				size_t i = 0;
+
+				for (; (i + 4) <= num_pixels; i += 4)
+				{
+					Store((pDst + i), ::_mm_xor_si128(Load(pSrc + i), mask));
+				}
+
+				Negate_Reference((pSrc + i), (pDst + i), (num_pixels - i));
+			}
+
+			// Color::grayscale0_255() と同じ順序で double の演算を行い、結果を一致させる
+			[[nodiscard]]
+			inline __m128i Gray2(const __m128i r, const __m128i g, const __m128i b) noexcept
+			{
+				const __m128d wr = ::_mm_set1_pd(0.299);
+				const __m128d wg = ::_mm_set1_pd(0.587);
+				const __m128d wb = ::_mm_set1_pd(0.114);
+				const __m128d sum = ::_mm_add_pd(::_mm_add_pd(::_mm_mul_pd(wr, ::_mm_cvtepi32_pd(r)), ::_mm_mul_pd(wg, ::_mm_cvtepi32_pd(g))), ::_mm_mul_pd(wb, ::_mm_cvtepi32_pd(b)));
+				return ::_mm_cvttpd_epi32(sum);
+			}
+
+			void Grayscale_SSE4_1(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				const __m128i channelMask = ::_mm_set1_epi32(0xFF);
+				const __m128i alphaMask = ::_mm_set1_epi32(static_cast<int32>(0xFF000000));
+				const __m128i broadcast = ::_mm_set1_epi32(0x010101);
+				size_t i = 0;
+
+				for (; (i + 4) <= num_pixels; i += 4)
+				{
+					const __m128i v = Load(pSrc + i);
+					const __m128i r = ::_mm_and_si128(v, channelMask);
+					const __m128i g = ::_mm_and_si128(::_mm_srli_epi32(v, 8), channelMask);
+					const __m128i b = ::_mm_and_si128(::_mm_srli_epi32(v, 16), channelMask);
+					const __m128i lo = Gray2(r, g, b);
+					const __m128i hi = Gray2(::_mm_shuffle_epi32(r, 0x0E), ::_mm_shuffle_epi32(g, 0x0E), ::_mm_shuffle_epi32(b, 0x0E));
+					const __m128i gray = ::_mm_unpacklo_epi64(lo, hi);
+					Store((pDst + i), ::_mm_or_si128(::_mm_and_si128(v, alphaMask), ::_mm_mullo_epi32(gray, broadcast))); //SSE4.1
+				}
+
+				Grayscale_Reference((pSrc + i), (pDst + i), (num_pixels - i));
+			}
+
+			// (x + 127) / 255 を 16-bit の範囲で正確に計算する
+			[[nodiscard]]
+			inline __m128i Div255Round16(const __m128i x) noexcept
+			{
+				const __m128i y = ::_mm_add_epi16(x, ::_mm_set1_epi16(128));
+				return ::_mm_srli_epi16(::_mm_add_epi16(y, ::_mm_srli_epi16(y, 8)), 8);
+			}
+
+			void PremultiplyAlpha_SSE4_1(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				const __m128i zero = ::_mm_setzero_si128();
+				const __m128i alphaShuffle = ::_mm_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+				const __m128i c255 = ::_mm_set1_epi16(255);
+				size_t i = 0;
+
+				for (; (i + 4) <= num_pixels; i += 4)
+				{
+					const __m128i v = Load(pSrc + i);
+					const __m128i lo = ::_mm_unpacklo_epi8(v, zero);
+					const __m128i hi = ::_mm_unpackhi_epi8(v, zero);
+					// アルファ自身には 255 を掛けて値を保つ
+					const __m128i aLo = ::_mm_blend_epi16(::_mm_shuffle_epi8(lo, alphaShuffle), c255, 0x88); //SSE4.1
+					const __m128i aHi = ::_mm_blend_epi16(::_mm_shuffle_epi8(hi, alphaShuffle), c255, 0x88); //SSE4.1
+					const __m128i rLo = Div255Round16(::_mm_mullo_epi16(lo, aLo));
+					const __m128i rHi = Div255Round16(::_mm_mullo_epi16(hi, aHi));
+					Store((pDst + i), ::_mm_packus_epi16(rLo, rHi));
+				}
+
+				PremultiplyAlpha_Reference((pSrc + i), (pDst + i), (num_pixels - i));
+			}
+
+			void MirrorLine_SSE4_1(const Color* pSrc, Color* pDst, const size_t width)
+			{
+				size_t x = 0;
+
+				for (; (x + 4) <= width; x += 4)
+				{
+					Store((pDst + x), Reverse4(Load(pSrc + (width - x - 4))));
+				}
+
+				MirrorLine_Reference(pSrc, (pDst + x), (width - x));
+			}
+
+			void MirrorLineInPlace_SSE4_1(Color* pLine, const size_t width)
+			{
+				size_t left = 0;
+				size_t right = width;
+
+				while ((left + 8) <= right)
+				{
+					const __m128i l = Load(pLine + left);
+					const __m128i r = Load(pLine + (right - 4));
+					Store((pLine + left), Reverse4(r));
+					Store((pLine + (right - 4)), Reverse4(l));
+					left += 4;
+					right -= 4;
+				}
+
+				MirrorLineInPlace_Reference((pLine + left), (right - left));
+			}
+
+			// キャッシュに収まるよう、タイル単位で 4x4 ブロックを転置する
+			constexpr size_t RotateTileSize = 64;
+
+			template <bool Clockwise>
+			void Rotate_SSE4_1(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+			{
+				const size_t blockWidth = (srcWidth & ~size_t{ 3 });
+				const size_t blockHeight = (srcHeight & ~size_t{ 3 });
+
+				for (size_t ty = 0; ty < blockHeight; ty += RotateTileSize)
+				{
+					const size_t tyEnd = Min((ty + RotateTileSize), blockHeight);
+
+					for (size_t tx = 0; tx < blockWidth; tx += RotateTileSize)
+					{
+						const size_t txEnd = Min((tx + RotateTileSize), blockWidth);
+
+						for (size_t y = ty; y < tyEnd; y += 4)
+						{
+							const Color* pSrcLine = (pSrc + y * srcWidth);
+
+							for (size_t x = tx; x < txEnd; x += 4)
+							{
+								__m128i r0 = Load(pSrcLine + x);
+								__m128i r1 = Load(pSrcLine + srcWidth + x);
+								__m128i r2 = Load(pSrcLine + srcWidth * 2 + x);
+								__m128i r3 = Load(pSrcLine + srcWidth * 3 + x);
+								Transpose4x4(r0, r1, r2, r3);
+
+								if constexpr (Clockwise)
+								{
+									// dst[x][srcHeight - 1 - y] = src[y][x]
+									Color* p = (pDst + x * srcHeight + (srcHeight - 4 - y));
+									Store(p, Reverse4(r0));
+									Store((p + srcHeight), Reverse4(r1));
+									Store((p + srcHeight * 2), Reverse4(r2));
+									Store((p + srcHeight * 3), Reverse4(r3));
+								}
+								else
+								{
+									// dst[srcWidth - 1 - x][y] = src[y][x]
+									Color* p = (pDst + (srcWidth - 1 - x) * srcHeight + y);
+									Store(p, r0);
+									Store((p - srcHeight), r1);
+									Store((p - srcHeight * 2), r2);
+									Store((p - srcHeight * 3), r3);
+								}
+							}
+						}
+					}
+				}
+
+				// 4 で割り切れない右端の列と下端の行
+				for (size_t y = 0; y < srcHeight; ++y)
+				{
+					const Color* pSrcLine = (pSrc + y * srcWidth);
+					const size_t xBegin = ((y < blockHeight) ? blockWidth : 0);
+
+					for (size_t x = xBegin; x < srcWidth; ++x)
+					{
+						if constexpr (Clockwise)
+						{
+							pDst[x * srcHeight + (srcHeight - y - 1)] = pSrcLine[x];
+						}
+						else
+						{
+							pDst[(srcWidth - x - 1) * srcHeight + y] = pSrcLine[x];
+						}
+					}
+				}
+			}
+
+		# endif
+
+		# if SIV3D_IMAGE_KERNELS_X64
+
+			SIV3D_TARGET_AVX2
+			void Negate_AVX2(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				const __m256i mask = _mm256_set1_epi32(0x00FFFFFF);
+				size_t i = 0;
+
+				for (; (i + 8) <= num_pixels; i += 8)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_xor_si256(v, mask));
+				}
+
+				Negate_SSE4_1((pSrc + i), (pDst + i), (num_pixels - i));
+			}
+
+			SIV3D_TARGET_AVX2
+			inline __m128i Gray4_AVX2(const __m128i r, const __m128i g, const __m128i b) noexcept
+			{
+				const __m256d wr = _mm256_set1_pd(0.299);
+				const __m256d wg = _mm256_set1_pd(0.587);
+				const __m256d wb = _mm256_set1_pd(0.114);
+				const __m256d sum = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(wr, _mm256_cvtepi32_pd(r)), _mm256_mul_pd(wg, _mm256_cvtepi32_pd(g))), _mm256_mul_pd(wb, _mm256_cvtepi32_pd(b)));
+				return _mm256_cvttpd_epi32(sum);
+			}
+
+			SIV3D_TARGET_AVX2
+			void Grayscale_AVX2(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				const __m256i channelMask = _mm256_set1_epi32(0xFF);
+				const __m256i alphaMask = _mm256_set1_epi32(static_cast<int32>(0xFF000000));
+				const __m256i broadcast = _mm256_set1_epi32(0x010101);
+				size_t i = 0;
+
+				for (; (i + 8) <= num_pixels; i += 8)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+					const __m256i r = _mm256_and_si256(v, channelMask);
+					const __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 8), channelMask);
+					const __m256i b = _mm256_and_si256(_mm256_srli_epi32(v, 16), channelMask);
+					const __m128i lo = Gray4_AVX2(_mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b));
+					const __m128i hi = Gray4_AVX2(_mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1));
+					const __m256i gray = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+					const __m256i result = _mm256_or_si256(_mm256_and_si256(v, alphaMask), _mm256_mullo_epi32(gray, broadcast));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), result);
+				}
+
+				Grayscale_SSE4_1((pSrc + i), (pDst + i), (num_pixels - i));
+			}
+
+			SIV3D_TARGET_AVX2
+			inline __m256i Div255Round16_AVX2(const __m256i x) noexcept
+			{
+				const __m256i y = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+				return _mm256_srli_epi16(_mm256_add_epi16(y, _mm256_srli_epi16(y, 8)), 8);
+			}
+
+			SIV3D_TARGET_AVX2
+			void PremultiplyAlpha_AVX2(const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				const __m256i zero = _mm256_setzero_si256();
+				const __m256i alphaShuffle = _mm256_setr_epi8(
+					6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15,
+					6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+				const __m256i c255 = _mm256_set1_epi16(255);
+				size_t i = 0;
+
+				for (; (i + 8) <= num_pixels; i += 8)
+				{
+					// unpack / pack は 128-bit レーン内で対になるため、ピクセルの順序は保たれる
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+					const __m256i lo = _mm256_unpacklo_epi8(v, zero);
+					const __m256i hi = _mm256_unpackhi_epi8(v, zero);
+					const __m256i aLo = _mm256_blend_epi16(_mm256_shuffle_epi8(lo, alphaShuffle), c255, 0x88);
+					const __m256i aHi = _mm256_blend_epi16(_mm256_shuffle_epi8(hi, alphaShuffle), c255, 0x88);
+					const __m256i rLo = Div255Round16_AVX2(_mm256_mullo_epi16(lo, aLo));
+					const __m256i rHi = Div255Round16_AVX2(_mm256_mullo_epi16(hi, aHi));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_packus_epi16(rLo, rHi));
+				}
+
+				PremultiplyAlpha_SSE4_1((pSrc + i), (pDst + i), (num_pixels - i));
+			}
+
+		# endif
+
+			enum class KernelLevel
+			{
+				Reference,
+
+				SSE4_1,
+
+				AVX2,
+			};
+
+			[[nodiscard]]
+			KernelLevel GetKernelLevel() noexcept
+			{
+			# if SIV3D_IMAGE_KERNELS_X64
+
+				static const KernelLevel level = []()
+				{
+					const CPUInfo& cpu = GetCPUInfo();
+
+					if (cpu.features.avx2)
+					{
+						return KernelLevel::AVX2;
+					}
+					else if (cpu.features.sse4_1)
+					{
+						return KernelLevel::SSE4_1;
+					}
+
+					return KernelLevel::Reference;
+				}();
+
+				return level;
+
+			# elif SIV3D_INTRINSIC(SSE)
+
+				return KernelLevel::SSE4_1;
+
+			# else
+
+				return KernelLevel::Reference;
+
+			# endif
+			}
+		}
+
+		void Negate(const Color* pSrc, Color* pDst, const size_t num_pixels)
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_IMAGE_KERNELS_X64
+			case KernelLevel::AVX2:
+				return Negate_AVX2(pSrc, pDst, num_pixels);
+		# endif
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::SSE4_1:
+				return Negate_SSE4_1(pSrc, pDst, num_pixels);
+		# endif
+			default:
+				return Negate_Reference(pSrc, pDst, num_pixels);
+			}
+		}
+
+		void Grayscale(const Color* pSrc, Color* pDst, const size_t num_pixels)
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_IMAGE_KERNELS_X64
+			case KernelLevel::AVX2:
+				return Grayscale_AVX2(pSrc, pDst, num_pixels);
+		# endif
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::SSE4_1:
+				return Grayscale_SSE4_1(pSrc, pDst, num_pixels);
+		# endif
+			default:
+				return Grayscale_Reference(pSrc, pDst, num_pixels);
+			}
+		}
+
+		void PremultiplyAlpha(const Color* pSrc, Color* pDst, const size_t num_pixels)
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_IMAGE_KERNELS_X64
+			case KernelLevel::AVX2:
+				return PremultiplyAlpha_AVX2(pSrc, pDst, num_pixels);
+		# endif
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::SSE4_1:
+				return PremultiplyAlpha_SSE4_1(pSrc, pDst, num_pixels);
+		# endif
+			default:
+				return PremultiplyAlpha_Reference(pSrc, pDst, num_pixels);
+			}
+		}
+
+		// 以下はメモリ帯域が律速になるため、AVX2 版は用意しない
+
+		void MirrorLine(const Color* pSrc, Color* pDst, const size_t width)
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetKernelLevel() != KernelLevel::Reference)
+			{
+				return MirrorLine_SSE4_1(pSrc, pDst, width);
+			}
+
+		# endif
+
+			MirrorLine_Reference(pSrc, pDst, width);
+		}
+
+		void MirrorLineInPlace(Color* pLine, const size_t width)
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetKernelLevel() != KernelLevel::Reference)
+			{
+				return MirrorLineInPlace_SSE4_1(pLine, width);
+			}
+
+		# endif
+
+			MirrorLineInPlace_Reference(pLine, width);
+		}
+
+		void Rotate90(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetKernelLevel() != KernelLevel::Reference)
+			{
+				return Rotate_SSE4_1<true>(pSrc, pDst, srcWidth, srcHeight);
+			}
+
+		# endif
+
+			Rotate90_Reference(pSrc, pDst, srcWidth, srcHeight);
+		}
+
+		void Rotate270(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetKernelLevel() != KernelLevel::Reference)
+			{
+				return Rotate_SSE4_1<false>(pSrc, pDst, srcWidth, srcHeight);
+			}
+
+		# endif
+
+			Rotate270_Reference(pSrc, pDst, srcWidth, srcHeight);
+		}
+	}
+}
@@ -0,0 +1,38 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Image.hpp>
+
+namespace s3d
+{
+	namespace ImageKernels
+	{
+		// pSrc と pDst は同じでもよい
+		void Negate(const Color* pSrc, Color* pDst, size_t num_pixels);
+
+		// pSrc と pDst は同じでもよい
+		void Grayscale(const Color* pSrc, Color* pDst, size_t num_pixels);
+
+		// pSrc と pDst は同じでもよい
+		void PremultiplyAlpha(const Color* pSrc, Color* pDst, size_t num_pixels);
+
+		void MirrorLine(const Color* pSrc, Color* pDst, size_t width);
+
+		void MirrorLineInPlace(Color* pLine, size_t width);
+
+		// pDst は srcHeight x srcWidth の領域を持つ
+		void Rotate90(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+		// pDst は srcHeight x srcWidth の領域を持つ
+		void Rotate270(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+	}
+}
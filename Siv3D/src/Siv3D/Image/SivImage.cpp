@@ -27,7 +27,9 @@
 # include <Siv3D/ImageFormat/PPMEncoder.hpp>
 # include <Siv3D/ImageFormat/WebPEncoder.hpp>
 # include <Siv3D/OpenCV_Bridge.hpp>
+# include <Siv3D/ParallelFor.hpp>
 # include "ImagePainting.hpp"
+# include "ImageKernels.hpp"
 
 namespace s3d
 {
@@ -328,6 +330,118 @@ namespace s3d
 
 			return polygons;
 		}
+
+		// 並列処理で 1 タイルあたりに出力するバイト数の目安（L2 キャッシュに収まる大きさ）
+		inline constexpr size_t ParallelTileBytes = (256 * 1024);
+
+		[[nodiscard]]
+		static int32 ParallelTileHeight(const int32 width, const int32 minHeight) noexcept
+		{
+			const int32 height = static_cast<int32>(ParallelTileBytes / (static_cast<size_t>(width) * sizeof(Color)));
+
+			return Max(Max(height, minHeight), 1);
+		}
+
+		// 上下に vertical 行ののりしろを付けた行タイルごとに cv::GaussianBlur() を並列に実行する
+		// のりしろ付きのタイルを BORDER_ISOLATED で独立した画像として処理すると、画像全体を一度に処理した場合と同じ固定小数点演算の結果が得られる
+		static void ParallelGaussianBlur(const Image& src, Image& dst, const int32 horizontal, const int32 vertical, const BorderType borderType)
+		{
+			const int32 width = src.width();
+			const int32 height = src.height();
+			const int32 tileHeight = ParallelTileHeight(width, (vertical * 4));
+			const size_t numTiles = ((height + (tileHeight - 1)) / tileHeight);
+			const cv::Size kernelSize{ (horizontal * 2 + 1), (vertical * 2 + 1) };
+			const int32 border = (OpenCV_Bridge::ConvertBorderType(borderType) | cv::BORDER_ISOLATED);
+
+			ParallelFor(0, numTiles, [&](const size_t i)
+			{
+				const int32 y0 = static_cast<int32>(i * tileHeight);
+				const int32 y1 = Min((y0 + tileHeight), height);
+				const int32 haloTop = Max((y0 - vertical), 0);
+				const int32 haloBottom = Min((y1 + vertical), height);
+
+				const cv::Mat matSrc((haloBottom - haloTop), width, CV_8UC4, const_cast<Color*>(src[haloTop]), src.stride());
+				cv::Mat matBlurred;
+				cv::GaussianBlur(matSrc, matBlurred, kernelSize, 0.0, 0.0, border);
+
+				cv::Mat matDst((y1 - y0), width, CV_8UC4, dst[y0], dst.stride());
+				matBlurred.rowRange((y0 - haloTop), (y1 - haloTop)).copyTo(matDst);
+			}, 1);
+		}
+
+		// cv::warpAffine() (INTER_LINEAR) が内部で作る固定小数点の座標マップを行タイルごとに再現し、cv::remap() を並列に実行する
+		static void ParallelWarpAffine(const Image& src, Image& dst, const cv::Matx23f& transform, const Color& background)
+		{
+			constexpr int32 InterBits = cv::INTER_BITS;
+			constexpr int32 InterTabSize = cv::INTER_TAB_SIZE;
+			constexpr int32 ABBits = Max(10, InterBits);
+			constexpr int32 ABScale = (1 << ABBits);
+			constexpr int32 RoundDelta = (ABScale / InterTabSize / 2);
+
+			// 逆変換
+			double m[6] = { transform(0, 0), transform(0, 1), transform(0, 2), transform(1, 0), transform(1, 1), transform(1, 2) };
+			{
+				double d = (m[0] * m[4] - m[1] * m[3]);
+				d = ((d != 0) ? (1.0 / d) : 0.0);
+				const double a11 = (m[4] * d);
+				const double a22 = (m[0] * d);
+				m[0] = a11; m[1] *= -d;
+				m[3] *= -d; m[4] = a22;
+				const double b1 = (-m[0] * m[2] - m[1] * m[5]);
+				const double b2 = (-m[3] * m[2] - m[4] * m[5]);
+				m[2] = b1; m[5] = b2;
+			}
+
+			if (not dst)
+			{
+				return;
+			}
+
+			const int32 width = dst.width();
+			const int32 height = dst.height();
+
+			Array<int32> aDelta(width), bDelta(width);
+
+			for (int32 x = 0; x < width; ++x)
+			{
+				aDelta[x] = cv::saturate_cast<int32>(m[0] * x * ABScale);
+				bDelta[x] = cv::saturate_cast<int32>(m[3] * x * ABScale);
+			}
+
+			const cv::Mat matSrc(src.height(), src.width(), CV_8UC4, const_cast<Color*>(src.data()), src.stride());
+			const cv::Scalar borderValue(background.r, background.g, background.b, background.a);
+			const int32 tileHeight = ParallelTileHeight(width, 1);
+			const size_t numTiles = ((height + (tileHeight - 1)) / tileHeight);
+
+			ParallelFor(0, numTiles, [&](const size_t i)
+			{
+				const int32 y0 = static_cast<int32>(i * tileHeight);
+				const int32 y1 = Min((y0 + tileHeight), height);
+
+				cv::Mat matXY((y1 - y0), width, CV_16SC2);
+				cv::Mat matA((y1 - y0), width, CV_16UC1);
+
+				for (int32 y = y0; y < y1; ++y)
+				{
+					int16* pXY = matXY.ptr<int16>(y - y0);
+					uint16* pA = matA.ptr<uint16>(y - y0);
+					const int32 x0 = (cv::saturate_cast<int32>((m[1] * y + m[2]) * ABScale) + RoundDelta);
+					const int32 yy0 = (cv::saturate_cast<int32>((m[4] * y + m[5]) * ABScale) + RoundDelta);
+
+					for (int32 x = 0; x < width; ++x)
+					{
+						const int32 sx = ((x0 + aDelta[x]) >> (ABBits - InterBits));
+						const int32 sy = ((yy0 + bDelta[x]) >> (ABBits - InterBits));
+						pXY[x * 2] = cv::saturate_cast<int16>(sx >> InterBits);
+						pXY[x * 2 + 1] = cv::saturate_cast<int16>(sy >> InterBits);
+						pA[x] = static_cast<uint16>((sy & (InterTabSize - 1)) * InterTabSize + (sx & (InterTabSize - 1)));
+					}
+				}
+
+				cv::Mat matDst((y1 - y0), width, CV_8UC4, dst[y0], dst.stride());
+				cv::remap(matSrc, matDst, matXY, matA, cv::INTER_LINEAR, cv::BORDER_CONSTANT, borderValue);
+			}, 1);
+		}
 	}
 
 	Image::Image(const FilePathView path, const ImageFormat format)
@@ -946,10 +1060,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				pixel = ~pixel;
-			}
+			ImageKernels::Negate(m_data.data(), m_data.data(), m_data.size());
 		}
 
 		return *this;
@@ -967,12 +1078,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			Image image{ *this };
+			Image image{ m_width, m_height };
 
-			for (auto& pixel : image)
-			{
-				pixel = ~pixel;
-			}
+			ImageKernels::Negate(data(), image.data(), num_pixels());
 
 			return image;
 		}
@@ -995,13 +1103,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				const uint8 gray = pixel.grayscale0_255();
-				pixel.r = gray;
-				pixel.g = gray;
-				pixel.b = gray;
-			}
+			ImageKernels::Grayscale(m_data.data(), m_data.data(), m_data.size());
 		}
 
 		return *this;
@@ -1019,15 +1121,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			Image image{ *this };
+			Image image{ m_width, m_height };
 
-			for (auto& pixel : image)
-			{
-				const uint8 gray = pixel.grayscale0_255();
-				pixel.r = gray;
-				pixel.g = gray;
-				pixel.b = gray;
-			}
+			ImageKernels::Grayscale(data(), image.data(), num_pixels());
 
 			return image;
 		}
@@ -1038,6 +1134,49 @@ namespace s3d
 		return std::move(grayscale());
 	}
 
+	Image& Image::premultiplyAlpha()
+	{
+		// 1. パラメータチェック
+		{
+			if (isEmpty())
+			{
+				return *this;
+			}
+		}
+
+		// 2. 処理
+		{
+			ImageKernels::PremultiplyAlpha(m_data.data(), m_data.data(), m_data.size());
+		}
+
+		return *this;
+	}
+
+	Image Image::premultipliedAlpha() const&
+	{
+		// 1. パラメータチェック
+		{
+			if (isEmpty())
+			{
+				return *this;
+			}
+		}
+
+		// 2. 処理
+		{
+			Image image{ m_width, m_height };
+
+			ImageKernels::PremultiplyAlpha(data(), image.data(), num_pixels());
+
+			return image;
+		}
+	}
+
+	Image Image::premultipliedAlpha() &&
+	{
+		return std::move(premultiplyAlpha());
+	}
+
 	Image& Image::sepia()
 	{
 		// 1. パラメータチェック
@@ -1240,7 +1379,7 @@ namespace s3d
 
 			for (uint32 y = 0; y < m_height; ++y)
 			{
-				std::reverse(p, p + imageWidth);
+				ImageKernels::MirrorLineInPlace(p, imageWidth);
 				p += imageWidth;
 			}
 		}
@@ -1268,13 +1407,7 @@ namespace s3d
 
 			for (size_t y = 0; y < m_height; ++y)
 			{
-				const Color* pSrcLine = (pSrc + width * y + width - 1);
-				Color* pDstLine = (pDst + width * y);
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					*(pDstLine + x) = *(pSrcLine - x);
-				}
+				ImageKernels::MirrorLine((pSrc + width * y), (pDst + width * y), width);
 			}
 
 			return image;
@@ -1359,19 +1492,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			// [Siv3D ToDo] 最適化
 			Image tmp{ m_height, m_width };
 
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = data() + y * m_width;
-				const size_t dstX = m_height - y - 1;
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					tmp[x][dstX] = pSrc[x];
-				}
-			}
+			ImageKernels::Rotate90(data(), tmp.data(), m_width, m_height);
 
 			swap(tmp);
 		}
@@ -1411,17 +1534,7 @@ namespace s3d
 		{
 			Image image{ m_height, m_width };
 
-			// [Siv3D ToDo] 最適化
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = data() + y * m_width;
-				const size_t dstX = m_height - y - 1;
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					image[x][dstX] = pSrc[x];
-				}
-			}
+			ImageKernels::Rotate90(data(), image.data(), m_width, m_height);
 
 			return image;
 		}
@@ -1521,18 +1634,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			// [Siv3D ToDo] 最適化
 			Image tmp{ m_height, m_width };
 
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = (data() + y * m_width);
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					tmp[m_width - x - 1][y] = pSrc[x];
-				}
-			}
+			ImageKernels::Rotate270(data(), tmp.data(), m_width, m_height);
 
 			swap(tmp);
 		}
@@ -1554,15 +1658,7 @@ namespace s3d
 		{
 			Image image{ m_height, m_width };
 
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = (data() + y * m_width);
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					image[m_width - x - 1][y] = pSrc[x];
-				}
-			}
+			ImageKernels::Rotate270(data(), image.data(), m_width, m_height);
 
 			return image;
 		}
@@ -2218,12 +2314,12 @@ namespace s3d
 		return std::move(medianBlur(apertureSize));
 	}
 
-	Image& Image::gaussianBlur(const int32 size, const BorderType borderType)
+	Image& Image::gaussianBlur(const int32 size, const BorderType borderType, const Parallel parallel)
 	{
-		return gaussianBlur(size, size, borderType);
+		return gaussianBlur(size, size, borderType, parallel);
 	}
 
-	Image& Image::gaussianBlur(const int32 horizontal, const int32 vertical, const BorderType borderType)
+	Image& Image::gaussianBlur(const int32 horizontal, const int32 vertical, const BorderType borderType, const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -2239,6 +2335,13 @@ namespace s3d
 		}
 
 		// 2. 処理
+		if (parallel)
+		{
+			Image image{ size() };
+			detail::ParallelGaussianBlur(*this, image, horizontal, vertical, borderType);
+			swap(image);
+		}
+		else
 		{
 			cv::Mat matSrc = OpenCV_Bridge::GetMatView(*this);
 			cv::GaussianBlur(matSrc, matSrc, cv::Size(horizontal * 2 + 1, vertical * 2 + 1), 0.0, 0.0, OpenCV_Bridge::ConvertBorderType(borderType));
@@ -2247,17 +2350,17 @@ namespace s3d
 		return *this;
 	}
 
-	Image Image::gaussianBlurred(const int32 size, const BorderType borderType) const&
+	Image Image::gaussianBlurred(const int32 size, const BorderType borderType, const Parallel parallel) const&
 	{
-		return gaussianBlurred(size, size, borderType);
+		return gaussianBlurred(size, size, borderType, parallel);
 	}
 
-	Image Image::gaussianBlurred(const int32 size, const BorderType borderType) &&
+	Image Image::gaussianBlurred(const int32 size, const BorderType borderType, const Parallel parallel) &&
 	{
-		return std::move(gaussianBlur(size, size, borderType));
+		return std::move(gaussianBlur(size, size, borderType, parallel));
 	}
 
-	Image Image::gaussianBlurred(const int32 horizontal, const int32 vertical, const BorderType borderType) const&
+	Image Image::gaussianBlurred(const int32 horizontal, const int32 vertical, const BorderType borderType, const Parallel parallel) const&
 	{
 		// 1. パラメータチェック
 		{
@@ -2275,6 +2378,13 @@ namespace s3d
 		// 2. 処理
 		{
 			Image image{ m_width, m_height };
+
+			if (parallel)
+			{
+				detail::ParallelGaussianBlur(*this, image, horizontal, vertical, borderType);
+				return image;
+			}
+
 			const cv::Mat matSrc(cv::Size(m_width, m_height), CV_8UC4, const_cast<uint8*>(dataAsUint8()), stride());
 			cv::Mat matDst = OpenCV_Bridge::GetMatView(image);
 
@@ -2283,9 +2393,9 @@ namespace s3d
 		}
 	}
 
-	Image Image::gaussianBlurred(const int32 horizontal, const int32 vertical, const BorderType borderType) &&
+	Image Image::gaussianBlurred(const int32 horizontal, const int32 vertical, const BorderType borderType, const Parallel parallel) &&
 	{
-		return std::move(gaussianBlur(horizontal, vertical, borderType));
+		return std::move(gaussianBlur(horizontal, vertical, borderType, parallel));
 	}
 
 	Image& Image::bilateralFilter(const int32 d, const double sigmaColor, const double sigmaSpace, const BorderType borderType)
@@ -2805,7 +2915,7 @@ namespace s3d
 		}
 	}
 
-	Image Image::warpAffine(const Mat3x2& mat, const Color& background) const
+	Image Image::warpAffine(const Mat3x2& mat, const Color& background, const Parallel parallel) const
 	{
 		if (isEmpty())
 		{
@@ -2823,6 +2933,14 @@ namespace s3d
 		const Size dstSize = Math::Ceil(boundingRect.size).asPoint();
 
 		const cv::Matx23f transform{ m._11, m._21, m._31, m._12, m._22, m._32 };
+
+		if (parallel)
+		{
+			Image image{ dstSize };
+			detail::ParallelWarpAffine(*this, image, transform, background);
+			return image;
+		}
+
 		const cv::Mat matSrc(cv::Size(m_width, m_height), CV_8UC4, const_cast<uint8*>(dataAsUint8()), stride());
 		cv::Mat_<cv::Vec4b> matDst;
 
@@ -2835,9 +2953,9 @@ namespace s3d
 		return image;
 	}
 
-	Image Image::rotated(const double angle, const Color& background) const
+	Image Image::rotated(const double angle, const Color& background, const Parallel parallel) const
 	{
-		return warpAffine(Mat3x2::Rotate(angle, size() * 0.5), background);
+		return warpAffine(Mat3x2::Rotate(angle, size() * 0.5), background, parallel);
 	}
 
 	Image Image::warpPerspective(const Quad& quad, const Color& background) const
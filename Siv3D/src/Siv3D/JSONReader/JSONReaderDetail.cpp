@@ -0,0 +1,797 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <charconv>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/JSONWriter/JSONWriterDetail.hpp>
+# include <ThirdParty/double-conversion/double-conversion.h>
+# include "JSONReaderDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static constexpr bool IsDigit(const int32 ch) noexcept
+		{
+			return (('0' <= ch) && (ch <= '9'));
+		}
+
+		// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+		[[nodiscard]]
+		static bool IsValidNumber(const std::string_view s) noexcept
+		{
+			size_t i = 0;
+
+			const auto skipDigits = [&]()
+			{
+				const size_t first = i;
+
+				while ((i < s.size()) && IsDigit(s[i]))
+				{
+					++i;
+				}
+
+				return (first < i);
+			};
+
+			if ((i < s.size()) && (s[i] == '-'))
+			{
+				++i;
+			}
+
+			if ((i < s.size()) && (s[i] == '0'))
+			{
+				++i;
+			}
+			else if (not skipDigits())
+			{
+				return false;
+			}
+
+			if ((i < s.size()) && (s[i] == '.'))
+			{
+				++i;
+
+				if (not skipDigits())
+				{
+					return false;
+				}
+			}
+
+			if ((i < s.size()) && ((s[i] == 'e') || (s[i] == 'E')))
+			{
+				++i;
+
+				if ((i < s.size()) && ((s[i] == '+') || (s[i] == '-')))
+				{
+					++i;
+				}
+
+				if (not skipDigits())
+				{
+					return false;
+				}
+			}
+
+			return (i == s.size());
+		}
+
+		static void AppendUTF8(std::string& dst, const char32 ch)
+		{
+			if (ch < 0x80)
+			{
+				dst.push_back(static_cast<char8>(ch));
+			}
+			else if (ch < 0x800)
+			{
+				dst.push_back(static_cast<char8>(0xC0 | (ch >> 6)));
+				dst.push_back(static_cast<char8>(0x80 | (ch & 0x3F)));
+			}
+			else if (ch < 0x10000)
+			{
+				dst.push_back(static_cast<char8>(0xE0 | (ch >> 12)));
+				dst.push_back(static_cast<char8>(0x80 | ((ch >> 6) & 0x3F)));
+				dst.push_back(static_cast<char8>(0x80 | (ch & 0x3F)));
+			}
+			else
+			{
+				dst.push_back(static_cast<char8>(0xF0 | (ch >> 18)));
+				dst.push_back(static_cast<char8>(0x80 | ((ch >> 12) & 0x3F)));
+				dst.push_back(static_cast<char8>(0x80 | ((ch >> 6) & 0x3F)));
+				dst.push_back(static_cast<char8>(0x80 | (ch & 0x3F)));
+			}
+		}
+
+		// 直前のトークンと event の間に ',' が必要か
+		[[nodiscard]]
+		static bool NeedsComma(const JSONEvent previous, const JSONEvent event) noexcept
+		{
+			switch (previous)
+			{
+			case JSONEvent::EndObject:
+			case JSONEvent::EndArray:
+			case JSONEvent::String:
+			case JSONEvent::Number:
+			case JSONEvent::Bool:
+			case JSONEvent::Null:
+				return ((event != JSONEvent::EndObject) && (event != JSONEvent::EndArray));
+			default:
+				return false;
+			}
+		}
+	}
+
+	JSONReader::JSONReaderDetail::JSONReaderDetail() {}
+
+	JSONReader::JSONReaderDetail::~JSONReaderDetail()
+	{
+		close();
+	}
+
+	bool JSONReader::JSONReaderDetail::open(std::unique_ptr<IReader>&& reader)
+	{
+		close();
+
+		if ((not reader) || (not reader->isOpen()))
+		{
+			return false;
+		}
+
+		m_reader = std::move(reader);
+		m_buffer.resize(BufferSize);
+
+		// UTF-8 の BOM を読み飛ばす
+		if (fill() && (3 <= m_bufferEnd)
+			&& (static_cast<uint8>(m_buffer[0]) == 0xEF) && (static_cast<uint8>(m_buffer[1]) == 0xBB) && (static_cast<uint8>(m_buffer[2]) == 0xBF))
+		{
+			m_bufferPos = 3;
+		}
+
+		return true;
+	}
+
+	void JSONReader::JSONReaderDetail::close()
+	{
+		m_reader.reset();
+		m_buffer.clear();
+		m_bufferPos = 0;
+		m_bufferEnd = 0;
+		m_bufferBase = 0;
+		m_containers.clear();
+		m_state = State::Value;
+		m_event = JSONEvent::None;
+		m_token.clear();
+		m_isInteger = false;
+		m_bool = false;
+		m_errorMessage.clear();
+	}
+
+	bool JSONReader::JSONReaderDetail::isOpen() const noexcept
+	{
+		return static_cast<bool>(m_reader);
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::next()
+	{
+		if ((not m_reader) || (m_event == JSONEvent::Error))
+		{
+			return m_event;
+		}
+
+		m_token.clear();
+
+		for (;;)
+		{
+			const int32 ch = skipWhitespace();
+
+			switch (m_state)
+			{
+			case State::Value:
+				return startValue(ch);
+			case State::FirstKeyOrEnd:
+				if (ch == '}')
+				{
+					static_cast<void>(get());
+					return endContainer('{', JSONEvent::EndObject);
+				}
+				[[fallthrough]];
+			case State::Key:
+				{
+					if (ch != '\"')
+					{
+						return setError(U"Expected a key");
+					}
+
+					static_cast<void>(get());
+
+					if (not readString())
+					{
+						return m_event;
+					}
+
+					if (skipWhitespace() != ':')
+					{
+						return setError(U"Expected `:`");
+					}
+
+					static_cast<void>(get());
+					m_state = State::Value;
+					return (m_event = JSONEvent::Key);
+				}
+			case State::FirstValueOrEnd:
+				if (ch == ']')
+				{
+					static_cast<void>(get());
+					return endContainer('[', JSONEvent::EndArray);
+				}
+				return startValue(ch);
+			case State::CommaOrEnd:
+				if (ch == ',')
+				{
+					static_cast<void>(get());
+					m_state = ((m_containers.back() == '{') ? State::Key : State::Value);
+					continue;
+				}
+				else if (ch == '}')
+				{
+					static_cast<void>(get());
+					return endContainer('{', JSONEvent::EndObject);
+				}
+				else if (ch == ']')
+				{
+					static_cast<void>(get());
+					return endContainer('[', JSONEvent::EndArray);
+				}
+				return setError(U"Expected `,` or a closing bracket");
+			case State::EndOfDocument:
+			default:
+				if (ch != EndOfInput)
+				{
+					return setError(U"Unexpected character after the document");
+				}
+				return (m_event = JSONEvent::None);
+			}
+		}
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::event() const noexcept
+	{
+		return m_event;
+	}
+
+	size_t JSONReader::JSONReaderDetail::depth() const noexcept
+	{
+		return m_containers.size();
+	}
+
+	std::string_view JSONReader::JSONReaderDetail::getRaw() const noexcept
+	{
+		return m_token;
+	}
+
+	Optional<String> JSONReader::JSONReaderDetail::getOptString() const
+	{
+		if ((m_event != JSONEvent::String) && (m_event != JSONEvent::Key))
+		{
+			return none;
+		}
+
+		return Unicode::FromUTF8(m_token);
+	}
+
+	Optional<int64> JSONReader::JSONReaderDetail::getOptInt64() const
+	{
+		if (m_event != JSONEvent::Number)
+		{
+			return none;
+		}
+
+		if (m_isInteger)
+		{
+			int64 value;
+			const auto result = std::from_chars(m_token.data(), (m_token.data() + m_token.size()), value);
+
+			if (result.ec == std::errc{})
+			{
+				return value;
+			}
+		}
+
+		// JSON::getOpt<int64>() と同じく、小数部を切り捨てる
+		return static_cast<int64>(*getOptDouble());
+	}
+
+	Optional<double> JSONReader::JSONReaderDetail::getOptDouble() const
+	{
+		if (m_event != JSONEvent::Number)
+		{
+			return none;
+		}
+
+		const double_conversion::StringToDoubleConverter conv{ double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0, nullptr, nullptr };
+
+		int processed = 0;
+		return conv.StringToDouble(m_token.data(), static_cast<int>(m_token.size()), &processed);
+	}
+
+	Optional<bool> JSONReader::JSONReaderDetail::getOptBool() const
+	{
+		if (m_event != JSONEvent::Bool)
+		{
+			return none;
+		}
+
+		return m_bool;
+	}
+
+	bool JSONReader::JSONReaderDetail::skip()
+	{
+		if (m_event == JSONEvent::Key)
+		{
+			next();
+		}
+
+		if ((m_event == JSONEvent::StartObject) || (m_event == JSONEvent::StartArray))
+		{
+			const size_t target = (depth() - 1);
+
+			while (target < depth())
+			{
+				if (next() == JSONEvent::Error)
+				{
+					return false;
+				}
+			}
+		}
+
+		return (m_event != JSONEvent::Error);
+	}
+
+	Optional<std::string> JSONReader::JSONReaderDetail::readValue()
+	{
+		if (m_event == JSONEvent::Key)
+		{
+			next();
+		}
+
+		std::string result;
+
+		const auto append = [&](const JSONEvent event)
+		{
+			switch (event)
+			{
+			case JSONEvent::StartObject:
+				result.push_back('{');
+				break;
+			case JSONEvent::EndObject:
+				result.push_back('}');
+				break;
+			case JSONEvent::StartArray:
+				result.push_back('[');
+				break;
+			case JSONEvent::EndArray:
+				result.push_back(']');
+				break;
+			case JSONEvent::Key:
+				detail::AppendJSONString(result, std::string_view{ m_token });
+				result.push_back(':');
+				break;
+			case JSONEvent::String:
+				detail::AppendJSONString(result, std::string_view{ m_token });
+				break;
+			case JSONEvent::Number:
+				result.append(m_token);
+				break;
+			case JSONEvent::Bool:
+				result.append(m_bool ? "true" : "false");
+				break;
+			case JSONEvent::Null:
+				result.append("null");
+				break;
+			default:
+				break;
+			}
+		};
+
+		switch (m_event)
+		{
+		case JSONEvent::String:
+		case JSONEvent::Number:
+		case JSONEvent::Bool:
+		case JSONEvent::Null:
+			append(m_event);
+			return result;
+		case JSONEvent::StartObject:
+		case JSONEvent::StartArray:
+			break;
+		default:
+			return none;
+		}
+
+		const size_t target = (depth() - 1);
+		JSONEvent previous = m_event;
+		append(m_event);
+
+		while (target < depth())
+		{
+			const JSONEvent event = next();
+
+			if (event == JSONEvent::Error)
+			{
+				return none;
+			}
+
+			if (detail::NeedsComma(previous, event))
+			{
+				result.push_back(',');
+			}
+
+			append(event);
+			previous = event;
+		}
+
+		return result;
+	}
+
+	const String& JSONReader::JSONReaderDetail::getErrorMessage() const noexcept
+	{
+		return m_errorMessage;
+	}
+
+	int64 JSONReader::JSONReaderDetail::getPos() const noexcept
+	{
+		return (m_bufferBase + static_cast<int64>(m_bufferPos));
+	}
+
+	bool JSONReader::JSONReaderDetail::fill()
+	{
+		m_bufferBase += static_cast<int64>(m_bufferEnd);
+		m_bufferPos = 0;
+		m_bufferEnd = 0;
+
+		const int64 readSize = m_reader->read(m_buffer.data(), static_cast<int64>(m_buffer.size()));
+
+		if (readSize <= 0)
+		{
+			return false;
+		}
+
+		m_bufferEnd = static_cast<size_t>(readSize);
+		return true;
+	}
+
+	int32 JSONReader::JSONReaderDetail::peek()
+	{
+		if ((m_bufferPos == m_bufferEnd) && (not fill()))
+		{
+			return EndOfInput;
+		}
+
+		return static_cast<uint8>(m_buffer[m_bufferPos]);
+	}
+
+	int32 JSONReader::JSONReaderDetail::get()
+	{
+		const int32 ch = peek();
+
+		if (ch != EndOfInput)
+		{
+			++m_bufferPos;
+		}
+
+		return ch;
+	}
+
+	int32 JSONReader::JSONReaderDetail::skipWhitespace()
+	{
+		for (;;)
+		{
+			const int32 ch = peek();
+
+			if ((ch != ' ') && (ch != '\n') && (ch != '\r') && (ch != '\t'))
+			{
+				return ch;
+			}
+
+			++m_bufferPos;
+		}
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::startValue(const int32 ch)
+	{
+		switch (ch)
+		{
+		case '{':
+			static_cast<void>(get());
+			return startContainer('{', JSONEvent::StartObject);
+		case '[':
+			static_cast<void>(get());
+			return startContainer('[', JSONEvent::StartArray);
+		case '\"':
+			static_cast<void>(get());
+
+			if (not readString())
+			{
+				return m_event;
+			}
+
+			return endValue(JSONEvent::String);
+		case 't':
+			if (not readLiteral("true"))
+			{
+				return m_event;
+			}
+
+			m_bool = true;
+			return endValue(JSONEvent::Bool);
+		case 'f':
+			if (not readLiteral("false"))
+			{
+				return m_event;
+			}
+
+			m_bool = false;
+			return endValue(JSONEvent::Bool);
+		case 'n':
+			if (not readLiteral("null"))
+			{
+				return m_event;
+			}
+
+			return endValue(JSONEvent::Null);
+		case EndOfInput:
+			return setError(U"Unexpected end of input");
+		default:
+			if ((ch == '-') || detail::IsDigit(ch))
+			{
+				if (not readNumber())
+				{
+					return m_event;
+				}
+
+				return endValue(JSONEvent::Number);
+			}
+
+			return setError(U"Unexpected character `{}`"_fmt(static_cast<char32>(ch)));
+		}
+	}
+
+	bool JSONReader::JSONReaderDetail::readString()
+	{
+		for (;;)
+		{
+			if ((m_bufferPos == m_bufferEnd) && (not fill()))
+			{
+				setError(U"Unterminated string");
+				return false;
+			}
+
+			// エスケープや終端が現れるまでをまとめて追加する
+			const char8* const pBegin = (m_buffer.data() + m_bufferPos);
+			const char8* const pEnd = (m_buffer.data() + m_bufferEnd);
+			const char8* p = pBegin;
+
+			while ((p != pEnd) && (*p != '\"') && (*p != '\\') && (0x20 <= static_cast<uint8>(*p)))
+			{
+				++p;
+			}
+
+			m_token.append(pBegin, p);
+			m_bufferPos += (p - pBegin);
+
+			if (p == pEnd)
+			{
+				continue;
+			}
+
+			const char8 ch = *p;
+			++m_bufferPos;
+
+			if (ch == '\"')
+			{
+				return true;
+			}
+
+			if (ch != '\\')
+			{
+				setError(U"Control character in a string");
+				return false;
+			}
+
+			switch (get())
+			{
+			case '\"':
+				m_token.push_back('\"');
+				break;
+			case '\\':
+				m_token.push_back('\\');
+				break;
+			case '/':
+				m_token.push_back('/');
+				break;
+			case 'b':
+				m_token.push_back('\b');
+				break;
+			case 'f':
+				m_token.push_back('\f');
+				break;
+			case 'n':
+				m_token.push_back('\n');
+				break;
+			case 'r':
+				m_token.push_back('\r');
+				break;
+			case 't':
+				m_token.push_back('\t');
+				break;
+			case 'u':
+				if (not readUnicodeEscape())
+				{
+					return false;
+				}
+				break;
+			default:
+				setError(U"Invalid escape sequence");
+				return false;
+			}
+		}
+	}
+
+	bool JSONReader::JSONReaderDetail::readUnicodeEscape()
+	{
+		char32 codePoint;
+
+		if (not readHex4(codePoint))
+		{
+			return false;
+		}
+
+		if ((0xDC00 <= codePoint) && (codePoint < 0xE000))
+		{
+			setError(U"Unpaired surrogate");
+			return false;
+		}
+
+		if ((0xD800 <= codePoint) && (codePoint < 0xDC00))
+		{
+			char32 low;
+
+			if ((get() != '\\') || (get() != 'u') || (not readHex4(low))
+				|| (not ((0xDC00 <= low) && (low < 0xE000))))
+			{
+				setError(U"Unpaired surrogate");
+				return false;
+			}
+
+			codePoint = (0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00));
+		}
+
+		detail::AppendUTF8(m_token, codePoint);
+		return true;
+	}
+
+	bool JSONReader::JSONReaderDetail::readHex4(char32& codePoint)
+	{
+		codePoint = 0;
+
+		for (int32 i = 0; i < 4; ++i)
+		{
+			const int32 ch = get();
+			int32 value;
+
+			if (detail::IsDigit(ch))
+			{
+				value = (ch - '0');
+			}
+			else if (('a' <= ch) && (ch <= 'f'))
+			{
+				value = (ch - 'a' + 10);
+			}
+			else if (('A' <= ch) && (ch <= 'F'))
+			{
+				value = (ch - 'A' + 10);
+			}
+			else
+			{
+				setError(U"Invalid \\u escape sequence");
+				return false;
+			}
+
+			codePoint = ((codePoint << 4) | static_cast<char32>(value));
+		}
+
+		return true;
+	}
+
+	bool JSONReader::JSONReaderDetail::readNumber()
+	{
+		m_isInteger = true;
+
+		for (;;)
+		{
+			const int32 ch = peek();
+
+			if (detail::IsDigit(ch) || (ch == '-') || (ch == '+'))
+			{
+				m_token.push_back(static_cast<char8>(ch));
+			}
+			else if ((ch == '.') || (ch == 'e') || (ch == 'E'))
+			{
+				m_token.push_back(static_cast<char8>(ch));
+				m_isInteger = false;
+			}
+			else
+			{
+				break;
+			}
+
+			++m_bufferPos;
+		}
+
+		if (not detail::IsValidNumber(m_token))
+		{
+			setError(U"Invalid number `{}`"_fmt(Unicode::FromUTF8(m_token)));
+			return false;
+		}
+
+		return true;
+	}
+
+	bool JSONReader::JSONReaderDetail::readLiteral(const std::string_view literal)
+	{
+		for (const char8 ch : literal)
+		{
+			if (get() != static_cast<uint8>(ch))
+			{
+				setError(U"Invalid literal");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::startContainer(const char8 bracket, const JSONEvent event)
+	{
+		m_containers.push_back(bracket);
+		m_state = ((bracket == '{') ? State::FirstKeyOrEnd : State::FirstValueOrEnd);
+		return (m_event = event);
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::endContainer(const char8 bracket, const JSONEvent event)
+	{
+		if (m_containers.isEmpty() || (m_containers.back() != bracket))
+		{
+			return setError(U"Mismatched closing bracket");
+		}
+
+		m_containers.pop_back();
+		return endValue(event);
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::endValue(const JSONEvent event)
+	{
+		m_state = (m_containers.isEmpty() ? State::EndOfDocument : State::CommaOrEnd);
+		return (m_event = event);
+	}
+
+	JSONEvent JSONReader::JSONReaderDetail::setError(const StringView message)
+	{
+		m_errorMessage = U"{} at byte {}"_fmt(message, getPos());
+
+		LOG_FAIL(U"❌ JSONReader: {}"_fmt(m_errorMessage));
+
+		return (m_event = JSONEvent::Error);
+	}
+}
@@ -0,0 +1,155 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <string>
+# include <Siv3D/JSONReader.hpp>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	class JSONReader::JSONReaderDetail
+	{
+	public:
+
+		JSONReaderDetail();
+
+		~JSONReaderDetail();
+
+		bool open(std::unique_ptr<IReader>&& reader);
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		JSONEvent next();
+
+		[[nodiscard]]
+		JSONEvent event() const noexcept;
+
+		[[nodiscard]]
+		size_t depth() const noexcept;
+
+		[[nodiscard]]
+		std::string_view getRaw() const noexcept;
+
+		[[nodiscard]]
+		Optional<String> getOptString() const;
+
+		[[nodiscard]]
+		Optional<int64> getOptInt64() const;
+
+		[[nodiscard]]
+		Optional<double> getOptDouble() const;
+
+		[[nodiscard]]
+		Optional<bool> getOptBool() const;
+
+		bool skip();
+
+		// 最後に読み取った値を、余分な空白を含まない UTF-8 の JSON として返す
+		[[nodiscard]]
+		Optional<std::string> readValue();
+
+		[[nodiscard]]
+		const String& getErrorMessage() const noexcept;
+
+		[[nodiscard]]
+		int64 getPos() const noexcept;
+
+	private:
+
+		// 次に読み取るべきもの
+		enum class State : uint8
+		{
+			Value,
+
+			FirstKeyOrEnd,
+
+			Key,
+
+			FirstValueOrEnd,
+
+			CommaOrEnd,
+
+			EndOfDocument,
+		};
+
+		static constexpr size_t BufferSize = (64 * 1024);
+
+		static constexpr int32 EndOfInput = -1;
+
+		std::unique_ptr<IReader> m_reader;
+
+		Array<char8> m_buffer;
+
+		size_t m_bufferPos = 0;
+
+		size_t m_bufferEnd = 0;
+
+		// m_buffer の先頭より前に読み取ったバイト数
+		int64 m_bufferBase = 0;
+
+		// 開いているオブジェクト ('{') と配列 ('[')
+		Array<char8> m_containers;
+
+		State m_state = State::Value;
+
+		JSONEvent m_event = JSONEvent::None;
+
+		// キー・文字列・数値のトークン。容量を使い回すため、トークンごとのメモリ確保は起こらない
+		std::string m_token;
+
+		bool m_isInteger = false;
+
+		bool m_bool = false;
+
+		String m_errorMessage;
+
+		[[nodiscard]]
+		bool fill();
+
+		[[nodiscard]]
+		int32 peek();
+
+		[[nodiscard]]
+		int32 get();
+
+		[[nodiscard]]
+		int32 skipWhitespace();
+
+		JSONEvent startValue(int32 ch);
+
+		[[nodiscard]]
+		bool readString();
+
+		[[nodiscard]]
+		bool readUnicodeEscape();
+
+		[[nodiscard]]
+		bool readHex4(char32& codePoint);
+
+		[[nodiscard]]
+		bool readNumber();
+
+		[[nodiscard]]
+		bool readLiteral(std::string_view literal);
+
+		JSONEvent startContainer(char8 bracket, JSONEvent event);
+
+		JSONEvent endContainer(char8 bracket, JSONEvent event);
+
+		JSONEvent endValue(JSONEvent event);
+
+		JSONEvent setError(StringView message);
+	};
+}
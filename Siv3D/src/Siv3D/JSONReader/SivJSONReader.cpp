@@ -0,0 +1,123 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/JSONReader.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/Unicode.hpp>
+# include "JSONReaderDetail.hpp"
+
+namespace s3d
+{
+	JSONReader::JSONReader()
+		: pImpl{ std::make_shared<JSONReaderDetail>() } {}
+
+	JSONReader::JSONReader(const FilePathView path)
+		: JSONReader{}
+	{
+		open(path);
+	}
+
+	JSONReader::JSONReader(std::unique_ptr<IReader>&& reader)
+		: JSONReader{}
+	{
+		open(std::move(reader));
+	}
+
+	bool JSONReader::open(const FilePathView path)
+	{
+		return open(std::make_unique<BinaryReader>(path));
+	}
+
+	bool JSONReader::open(std::unique_ptr<IReader>&& reader)
+	{
+		return pImpl->open(std::move(reader));
+	}
+
+	void JSONReader::close()
+	{
+		pImpl->close();
+	}
+
+	bool JSONReader::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	JSONEvent JSONReader::next()
+	{
+		return pImpl->next();
+	}
+
+	JSONEvent JSONReader::event() const noexcept
+	{
+		return pImpl->event();
+	}
+
+	size_t JSONReader::depth() const noexcept
+	{
+		return pImpl->depth();
+	}
+
+	std::string_view JSONReader::getRaw() const noexcept
+	{
+		return pImpl->getRaw();
+	}
+
+	bool JSONReader::isKey(const std::string_view key) const noexcept
+	{
+		return ((pImpl->event() == JSONEvent::Key) && (pImpl->getRaw() == key));
+	}
+
+	bool JSONReader::skip()
+	{
+		return pImpl->skip();
+	}
+
+	JSON JSONReader::readJSON()
+	{
+		if (const auto value = pImpl->readValue())
+		{
+			return JSON::Parse(Unicode::FromUTF8(*value));
+		}
+
+		return JSON::Invalid();
+	}
+
+	const String& JSONReader::getErrorMessage() const noexcept
+	{
+		return pImpl->getErrorMessage();
+	}
+
+	int64 JSONReader::getPos() const noexcept
+	{
+		return pImpl->getPos();
+	}
+
+	Optional<String> JSONReader::getOptString() const
+	{
+		return pImpl->getOptString();
+	}
+
+	Optional<int64> JSONReader::getOptInt64() const
+	{
+		return pImpl->getOptInt64();
+	}
+
+	Optional<double> JSONReader::getOptDouble() const
+	{
+		return pImpl->getOptDouble();
+	}
+
+	Optional<bool> JSONReader::getOptBool() const
+	{
+		return pImpl->getOptBool();
+	}
+}
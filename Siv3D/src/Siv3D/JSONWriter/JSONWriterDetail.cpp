@@ -0,0 +1,352 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "JSONWriterDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static void AppendEscaped(std::string& dst, const char8 ch)
+		{
+			switch (ch)
+			{
+			case '\"':
+				dst.append("\\\"");
+				break;
+			case '\\':
+				dst.append("\\\\");
+				break;
+			case '\b':
+				dst.append("\\b");
+				break;
+			case '\f':
+				dst.append("\\f");
+				break;
+			case '\n':
+				dst.append("\\n");
+				break;
+			case '\r':
+				dst.append("\\r");
+				break;
+			case '\t':
+				dst.append("\\t");
+				break;
+			default:
+				{
+					constexpr char Hex[] = "0123456789abcdef";
+					const char escaped[] = { '\\', 'u', '0', '0', Hex[(ch >> 4) & 0xF], Hex[ch & 0xF] };
+					dst.append(escaped, std::size(escaped));
+					break;
+				}
+			}
+		}
+
+		[[nodiscard]]
+		static constexpr bool NeedsEscape(const char32 ch) noexcept
+		{
+			return ((ch < 0x20) || (ch == U'\"') || (ch == U'\\'));
+		}
+
+		void AppendJSONString(std::string& dst, const StringView s)
+		{
+			dst.push_back('\"');
+
+			for (char32 ch : s)
+			{
+				if (NeedsEscape(ch))
+				{
+					AppendEscaped(dst, static_cast<char8>(ch));
+					continue;
+				}
+
+				if (ch < 0x80)
+				{
+					dst.push_back(static_cast<char8>(ch));
+					continue;
+				}
+
+				// サロゲートや範囲外の値は U+FFFD に置き換える
+				if (((0xD800 <= ch) && (ch < 0xE000)) || (0x10FFFF < ch))
+				{
+					ch = 0xFFFD;
+				}
+
+				if (ch < 0x800)
+				{
+					const char8 utf8[] = { static_cast<char8>(0xC0 | (ch >> 6)), static_cast<char8>(0x80 | (ch & 0x3F)) };
+					dst.append(utf8, std::size(utf8));
+				}
+				else if (ch < 0x10000)
+				{
+					const char8 utf8[] = { static_cast<char8>(0xE0 | (ch >> 12)), static_cast<char8>(0x80 | ((ch >> 6) & 0x3F)), static_cast<char8>(0x80 | (ch & 0x3F)) };
+					dst.append(utf8, std::size(utf8));
+				}
+				else
+				{
+					const char8 utf8[] = { static_cast<char8>(0xF0 | (ch >> 18)), static_cast<char8>(0x80 | ((ch >> 12) & 0x3F)), static_cast<char8>(0x80 | ((ch >> 6) & 0x3F)), static_cast<char8>(0x80 | (ch & 0x3F)) };
+					dst.append(utf8, std::size(utf8));
+				}
+			}
+
+			dst.push_back('\"');
+		}
+
+		void AppendJSONString(std::string& dst, const std::string_view utf8)
+		{
+			dst.push_back('\"');
+
+			size_t begin = 0;
+
+			for (size_t i = 0; i < utf8.size(); ++i)
+			{
+				const char8 ch = utf8[i];
+
+				if (NeedsEscape(static_cast<uint8>(ch)))
+				{
+					dst.append((utf8.data() + begin), (i - begin));
+					AppendEscaped(dst, ch);
+					begin = (i + 1);
+				}
+			}
+
+			dst.append((utf8.data() + begin), (utf8.size() - begin));
+			dst.push_back('\"');
+		}
+	}
+
+	JSONWriter::JSONWriterDetail::JSONWriterDetail() {}
+
+	JSONWriter::JSONWriterDetail::~JSONWriterDetail()
+	{
+		close();
+	}
+
+	bool JSONWriter::JSONWriterDetail::open(std::unique_ptr<IWriter>&& writer)
+	{
+		close();
+
+		if ((not writer) || (not writer->isOpen()))
+		{
+			return false;
+		}
+
+		m_writer = std::move(writer);
+		m_buffer.reserve(FlushThreshold * 2);
+
+		return true;
+	}
+
+	bool JSONWriter::JSONWriterDetail::close()
+	{
+		if (not m_writer)
+		{
+			return false;
+		}
+
+		bool result = flush();
+
+		if (not m_containers.isEmpty())
+		{
+			LOG_FAIL(U"❌ JSONWriter: {} object(s) or array(s) are not closed"_fmt(m_containers.size()));
+			result = false;
+		}
+
+		result &= (not m_hasError);
+
+		m_writer.reset();
+		m_buffer.clear();
+		m_containers.clear();
+		m_first = true;
+		m_afterKey = false;
+		m_hasRoot = false;
+		m_hasError = false;
+		m_flushedSize = 0;
+
+		return result;
+	}
+
+	bool JSONWriter::JSONWriterDetail::isOpen() const noexcept
+	{
+		return static_cast<bool>(m_writer);
+	}
+
+	bool JSONWriter::JSONWriterDetail::flush()
+	{
+		if (not m_writer)
+		{
+			return false;
+		}
+
+		if (m_buffer.empty())
+		{
+			return true;
+		}
+
+		const int64 size = static_cast<int64>(m_buffer.size());
+		const bool result = (m_writer->write(m_buffer.data(), size) == size);
+
+		if (not result)
+		{
+			setError(U"Failed to write");
+		}
+
+		m_flushedSize += size;
+		m_buffer.clear();
+
+		return result;
+	}
+
+	void JSONWriter::JSONWriterDetail::startContainer(const char8 bracket)
+	{
+		if (not beginValue())
+		{
+			return;
+		}
+
+		m_buffer.push_back(bracket);
+		m_containers.push_back(bracket);
+		m_first = true;
+	}
+
+	void JSONWriter::JSONWriterDetail::endContainer(const char8 bracket)
+	{
+		if (not m_writer)
+		{
+			return;
+		}
+
+		const char8 openBracket = ((bracket == '}') ? '{' : '[');
+
+		if (m_containers.isEmpty() || (m_containers.back() != openBracket) || m_afterKey)
+		{
+			setError(U"Unexpected `{}`"_fmt(static_cast<char32>(bracket)));
+			return;
+		}
+
+		m_buffer.push_back(bracket);
+		m_containers.pop_back();
+		m_first = false;
+
+		endValue();
+	}
+
+	void JSONWriter::JSONWriterDetail::key(const StringView key)
+	{
+		if (not m_writer)
+		{
+			return;
+		}
+
+		if (m_containers.isEmpty() || (m_containers.back() != '{') || m_afterKey)
+		{
+			setError(U"A key must be written in an object, before its value");
+			return;
+		}
+
+		if (not m_first)
+		{
+			m_buffer.push_back(',');
+		}
+
+		detail::AppendJSONString(m_buffer, key);
+		m_buffer.push_back(':');
+
+		m_first = false;
+		m_afterKey = true;
+	}
+
+	void JSONWriter::JSONWriterDetail::writeString(const StringView value)
+	{
+		if (not beginValue())
+		{
+			return;
+		}
+
+		detail::AppendJSONString(m_buffer, value);
+
+		endValue();
+	}
+
+	void JSONWriter::JSONWriterDetail::writeToken(const std::string_view token)
+	{
+		if (not beginValue())
+		{
+			return;
+		}
+
+		m_buffer.append(token);
+
+		endValue();
+	}
+
+	int64 JSONWriter::JSONWriterDetail::size() const noexcept
+	{
+		return (m_flushedSize + static_cast<int64>(m_buffer.size()));
+	}
+
+	bool JSONWriter::JSONWriterDetail::beginValue()
+	{
+		if (not m_writer)
+		{
+			return false;
+		}
+
+		if (m_containers.isEmpty())
+		{
+			if (m_hasRoot)
+			{
+				setError(U"A document can have only one root value");
+				return false;
+			}
+
+			m_hasRoot = true;
+			return true;
+		}
+
+		if (m_containers.back() == '{')
+		{
+			if (not m_afterKey)
+			{
+				setError(U"A value in an object must follow a key");
+				return false;
+			}
+
+			m_afterKey = false;
+			return true;
+		}
+
+		if (not m_first)
+		{
+			m_buffer.push_back(',');
+		}
+
+		m_first = false;
+		return true;
+	}
+
+	void JSONWriter::JSONWriterDetail::endValue()
+	{
+		if (FlushThreshold <= m_buffer.size())
+		{
+			flush();
+		}
+	}
+
+	void JSONWriter::JSONWriterDetail::setError(const StringView message)
+	{
+		LOG_FAIL(U"❌ JSONWriter: {}"_fmt(message));
+
+		m_hasError = true;
+	}
+}
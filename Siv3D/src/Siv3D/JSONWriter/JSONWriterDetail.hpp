@@ -0,0 +1,91 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <string>
+# include <Siv3D/JSONWriter.hpp>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// JSON の文字列としてエスケープし、クオーテーション記号で囲んで dst に追加する
+		void AppendJSONString(std::string& dst, StringView s);
+
+		// JSON の文字列としてエスケープし、クオーテーション記号で囲んで dst に追加する
+		void AppendJSONString(std::string& dst, std::string_view utf8);
+	}
+
+	class JSONWriter::JSONWriterDetail
+	{
+	public:
+
+		JSONWriterDetail();
+
+		~JSONWriterDetail();
+
+		bool open(std::unique_ptr<IWriter>&& writer);
+
+		bool close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		bool flush();
+
+		void startContainer(char8 bracket);
+
+		void endContainer(char8 bracket);
+
+		void key(StringView key);
+
+		void writeString(StringView value);
+
+		// 数値やリテラルなど、エスケープが不要な値を書き出す
+		void writeToken(std::string_view token);
+
+		[[nodiscard]]
+		int64 size() const noexcept;
+
+	private:
+
+		// バッファがこの大きさを超えたら書き出す
+		static constexpr size_t FlushThreshold = (64 * 1024);
+
+		std::unique_ptr<IWriter> m_writer;
+
+		std::string m_buffer;
+
+		// 開いているオブジェクト ('{') と配列 ('[')
+		Array<char8> m_containers;
+
+		// 現在のオブジェクトや配列に、まだ要素を書き出していない
+		bool m_first = true;
+
+		// キーを書き出し、値を待っている
+		bool m_afterKey = false;
+
+		bool m_hasRoot = false;
+
+		bool m_hasError = false;
+
+		int64 m_flushedSize = 0;
+
+		// 値を書き出す前に、区切りの ',' を書き出す。値を書き出せない位置の場合は false
+		[[nodiscard]]
+		bool beginValue();
+
+		void endValue();
+
+		void setError(StringView message);
+	};
+}
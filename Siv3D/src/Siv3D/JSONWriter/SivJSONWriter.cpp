@@ -0,0 +1,152 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cmath>
+# include <charconv>
+# include <Siv3D/JSONWriter.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <ThirdParty/double-conversion/double-conversion.h>
+# include "JSONWriterDetail.hpp"
+
+namespace s3d
+{
+	JSONWriter::JSONWriter()
+		: pImpl{ std::make_shared<JSONWriterDetail>() } {}
+
+	JSONWriter::JSONWriter(const FilePathView path)
+		: JSONWriter{}
+	{
+		open(path);
+	}
+
+	JSONWriter::JSONWriter(std::unique_ptr<IWriter>&& writer)
+		: JSONWriter{}
+	{
+		open(std::move(writer));
+	}
+
+	bool JSONWriter::open(const FilePathView path)
+	{
+		return open(std::make_unique<BinaryWriter>(path));
+	}
+
+	bool JSONWriter::open(std::unique_ptr<IWriter>&& writer)
+	{
+		return pImpl->open(std::move(writer));
+	}
+
+	bool JSONWriter::close()
+	{
+		return pImpl->close();
+	}
+
+	bool JSONWriter::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	bool JSONWriter::flush()
+	{
+		return pImpl->flush();
+	}
+
+	void JSONWriter::startObject()
+	{
+		pImpl->startContainer('{');
+	}
+
+	void JSONWriter::endObject()
+	{
+		pImpl->endContainer('}');
+	}
+
+	void JSONWriter::startArray()
+	{
+		pImpl->startContainer('[');
+	}
+
+	void JSONWriter::endArray()
+	{
+		pImpl->endContainer(']');
+	}
+
+	void JSONWriter::key(const StringView key)
+	{
+		pImpl->key(key);
+	}
+
+	void JSONWriter::write(std::nullptr_t)
+	{
+		pImpl->writeToken("null");
+	}
+
+	void JSONWriter::write(const bool value)
+	{
+		pImpl->writeToken(value ? "true" : "false");
+	}
+
+	void JSONWriter::write(const StringView value)
+	{
+		pImpl->writeString(value);
+	}
+
+	void JSONWriter::write(const char32* value)
+	{
+		pImpl->writeString(value);
+	}
+
+	void JSONWriter::write(const JSON& value)
+	{
+		if (not value)
+		{
+			pImpl->writeToken("null");
+			return;
+		}
+
+		pImpl->writeToken(value.formatUTF8Minimum());
+	}
+
+	int64 JSONWriter::size() const noexcept
+	{
+		return pImpl->size();
+	}
+
+	void JSONWriter::writeInt64(const int64 value)
+	{
+		char buffer[24];
+		const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+		pImpl->writeToken(std::string_view(buffer, (result.ptr - buffer)));
+	}
+
+	void JSONWriter::writeUint64(const uint64 value)
+	{
+		char buffer[24];
+		const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+		pImpl->writeToken(std::string_view(buffer, (result.ptr - buffer)));
+	}
+
+	void JSONWriter::writeDouble(const double value)
+	{
+		// JSON では非数と無限大を表せない
+		if (not std::isfinite(value))
+		{
+			pImpl->writeToken("null");
+			return;
+		}
+
+		char buffer[32];
+		double_conversion::StringBuilder builder(buffer, static_cast<int>(std::size(buffer)));
+		double_conversion::DoubleToStringConverter::EcmaScriptConverter().ToShortest(value, &builder);
+
+		const int length = builder.position();
+		pImpl->writeToken(std::string_view(builder.Finalize(), length));
+	}
+}
@@ -0,0 +1,380 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <cstring>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Time.hpp>
+# include "AsyncLogger.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline constexpr size_t MinLogBufferSize = 4096;
+
+		// バッファが半分埋まるまでは、この間隔でまとめて出力する
+		inline constexpr std::chrono::milliseconds LogWriteInterval{ 10 };
+
+		[[nodiscard]]
+		static uint64 NextAsyncLoggerID() noexcept
+		{
+			static std::atomic<uint64> id{ 0 };
+
+			return ++id;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	ThreadBuffer
+	//
+	////////////////////////////////////////////////////////////////
+
+	// 1 つのスレッドが書き込み、出力スレッドが読み出すリングバッファ
+	class AsyncLogger::ThreadBuffer
+	{
+	public:
+
+		explicit ThreadBuffer(const size_t capacity)
+			: m_data{ std::make_unique<uint8[]>(capacity) }
+			, m_capacity{ capacity } {}
+
+		[[nodiscard]]
+		size_t maxLength() const noexcept
+		{
+			return (((m_capacity / 2) - sizeof(Header)) / sizeof(char32));
+		}
+
+		[[nodiscard]]
+		bool tryPush(const LogType type, const uint64 timeStamp, const StringView s) noexcept
+		{
+			const Header header{ timeStamp, static_cast<uint32>(s.size()), type };
+			const size_t recordSize = RecordSize(header.length);
+
+			const size_t head = m_head.load(std::memory_order_relaxed);
+			const size_t tail = m_tail.load(std::memory_order_acquire);
+
+			if ((m_capacity - (head - tail)) < recordSize)
+			{
+				return false;
+			}
+
+			copyIn(head, &header, sizeof(Header));
+			copyIn((head + sizeof(Header)), s.data(), (s.size() * sizeof(char32)));
+
+			m_head.store((head + recordSize), std::memory_order_release);
+
+			return true;
+		}
+
+		template <class Fty>
+		void popAll(Fty f)
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			const size_t head = m_head.load(std::memory_order_acquire);
+
+			while (tail != head)
+			{
+				Header header;
+				copyOut(tail, &header, sizeof(Header));
+
+				String text(header.length, U'\0');
+				copyOut((tail + sizeof(Header)), text.data(), (header.length * sizeof(char32)));
+
+				f(LogRecord{ header.timeStamp, header.type, std::move(text) });
+
+				tail += RecordSize(header.length);
+			}
+
+			m_tail.store(tail, std::memory_order_release);
+		}
+
+		[[nodiscard]]
+		size_t usedBytes() const noexcept
+		{
+			return (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed));
+		}
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return (usedBytes() == 0);
+		}
+
+		void addDropped() noexcept
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]]
+		uint64 takeDropped() noexcept
+		{
+			return m_dropped.exchange(0, std::memory_order_relaxed);
+		}
+
+	private:
+
+		struct Header
+		{
+			uint64 timeStamp;
+
+			uint32 length;
+
+			LogType type;
+		};
+
+		std::unique_ptr<uint8[]> m_data;
+
+		size_t m_capacity = 0;
+
+		// 書き込む位置。書き込むスレッドだけが進める
+		alignas(64) std::atomic<size_t> m_head{ 0 };
+
+		// 読み出す位置。出力スレッドだけが進める
+		alignas(64) std::atomic<size_t> m_tail{ 0 };
+
+		std::atomic<uint64> m_dropped{ 0 };
+
+		[[nodiscard]]
+		static constexpr size_t RecordSize(const size_t length) noexcept
+		{
+			return ((sizeof(Header) + length * sizeof(char32) + 7) & ~size_t{ 7 });
+		}
+
+		void copyIn(const size_t position, const void* src, const size_t size) noexcept
+		{
+			const size_t offset = (position & (m_capacity - 1));
+			const size_t first = Min(size, (m_capacity - offset));
+
+			std::memcpy((m_data.get() + offset), src, first);
+			std::memcpy(m_data.get(), (static_cast<const uint8*>(src) + first), (size - first));
+		}
+
+		void copyOut(const size_t position, void* dst, const size_t size) const noexcept
+		{
+			const size_t offset = (position & (m_capacity - 1));
+			const size_t first = Min(size, (m_capacity - offset));
+
+			std::memcpy(dst, (m_data.get() + offset), first);
+			std::memcpy((static_cast<uint8*>(dst) + first), m_data.get(), (size - first));
+		}
+	};
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	AsyncLogger
+	//
+	////////////////////////////////////////////////////////////////
+
+	AsyncLogger::AsyncLogger(const size_t bufferSize, const LogOverflowPolicy overflow, OutputFunction output)
+		: m_id{ detail::NextAsyncLoggerID() }
+		, m_bufferSize{ std::bit_ceil(Max(bufferSize, detail::MinLogBufferSize)) }
+		, m_overflow{ overflow }
+		, m_output{ std::move(output) }
+		, m_thread{ &AsyncLogger::run, this } {}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		stop();
+	}
+
+	void AsyncLogger::write(const LogType type, const uint64 timeStamp, StringView s)
+	{
+		if (m_stop.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		ThreadBuffer& buffer = getThreadBuffer();
+
+		// 長すぎるログは切り詰める
+		s = s.substr(0, buffer.maxLength());
+
+		// 出力スレッド自身のバッファは、出力スレッドが待っている間は空かないので待たない
+		const bool block = ((m_overflow == LogOverflowPolicy::Block)
+			&& (not isOutputThread()));
+
+		while (not buffer.tryPush(type, timeStamp, s))
+		{
+			if ((not block)
+				|| m_stop.load(std::memory_order_relaxed))
+			{
+				buffer.addDropped();
+				wake();
+				return;
+			}
+
+			wake();
+			std::this_thread::yield();
+		}
+
+		if ((m_bufferSize / 2) <= buffer.usedBytes())
+		{
+			wake();
+		}
+	}
+
+	void AsyncLogger::flush()
+	{
+		// 出力スレッドから呼ばれた場合は、自分自身を待つことになるので何もしない
+		if (isOutputThread())
+		{
+			return;
+		}
+
+		std::unique_lock lock{ m_wakeMutex };
+
+		if (m_stop)
+		{
+			return;
+		}
+
+		const uint64 request = ++m_flushRequested;
+
+		m_wakeCondition.notify_one();
+
+		m_flushCondition.wait(lock, [&]() { return (request <= m_flushed); });
+	}
+
+	void AsyncLogger::stop()
+	{
+		{
+			std::lock_guard lock{ m_wakeMutex };
+
+			m_stop = true;
+		}
+
+		m_wakeCondition.notify_one();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+	}
+
+	bool AsyncLogger::isOutputThread() const noexcept
+	{
+		return (std::this_thread::get_id() == m_thread.get_id());
+	}
+
+	AsyncLogger::ThreadBuffer& AsyncLogger::getThreadBuffer()
+	{
+		struct Cache
+		{
+			uint64 id = 0;
+
+			std::shared_ptr<ThreadBuffer> buffer;
+		};
+
+		thread_local Cache cache;
+
+		if (cache.id != m_id)
+		{
+			auto buffer = std::make_shared<ThreadBuffer>(m_bufferSize);
+			{
+				std::lock_guard lock{ m_buffersMutex };
+
+				m_buffers << buffer;
+			}
+
+			cache = Cache{ m_id, std::move(buffer) };
+		}
+
+		return *cache.buffer;
+	}
+
+	void AsyncLogger::wake()
+	{
+		// 出力スレッドが待機に入る直前だった場合でも、次の間隔で出力される
+		if (not m_wakeRequested.exchange(true, std::memory_order_relaxed))
+		{
+			m_wakeCondition.notify_one();
+		}
+	}
+
+	void AsyncLogger::run()
+	{
+		Array<LogRecord> records;
+
+		for (;;)
+		{
+			uint64 flushRequested;
+			bool stop;
+			{
+				std::unique_lock lock{ m_wakeMutex };
+
+				m_wakeCondition.wait_for(lock, detail::LogWriteInterval,
+					[this]() { return (m_wakeRequested.load(std::memory_order_relaxed) || m_stop || (m_flushed < m_flushRequested)); });
+
+				m_wakeRequested.store(false, std::memory_order_relaxed);
+				flushRequested = m_flushRequested;
+				stop = m_stop;
+			}
+
+			drain(records);
+
+			if (m_flushed < flushRequested)
+			{
+				{
+					std::lock_guard lock{ m_wakeMutex };
+
+					m_flushed = flushRequested;
+				}
+
+				m_flushCondition.notify_all();
+			}
+
+			if (stop)
+			{
+				return;
+			}
+		}
+	}
+
+	size_t AsyncLogger::drain(Array<LogRecord>& records)
+	{
+		records.clear();
+
+		Array<std::shared_ptr<ThreadBuffer>> buffers;
+		{
+			std::lock_guard lock{ m_buffersMutex };
+
+			// 終了したスレッドのバッファは、空になったら捨てる
+			m_buffers.remove_if([](const std::shared_ptr<ThreadBuffer>& buffer) { return ((buffer.use_count() == 1) && buffer->isEmpty()); });
+
+			buffers = m_buffers;
+		}
+
+		for (const auto& buffer : buffers)
+		{
+			if (const uint64 dropped = buffer->takeDropped())
+			{
+				records << LogRecord{ Time::GetMillisec(), LogType::Warning, U"{} log messages were dropped (log buffer is full)"_fmt(dropped) };
+			}
+
+			buffer->popAll([&records](LogRecord&& record) { records << std::move(record); });
+		}
+
+		if (not records)
+		{
+			return 0;
+		}
+
+		// スレッドをまたいで時刻順に並べる
+		std::stable_sort(records.begin(), records.end(),
+			[](const LogRecord& a, const LogRecord& b) { return (a.timeStamp < b.timeStamp); });
+
+		m_output(records);
+
+		return records.size();
+	}
+}
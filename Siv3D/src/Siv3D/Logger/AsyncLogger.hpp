@@ -0,0 +1,111 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <condition_variable>
+# include <functional>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/LogType.hpp>
+# include <Siv3D/LogOverflowPolicy.hpp>
+
+# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+#	define SIV3D_ASYNC_LOGGER_THREAD 1
+# else
+#	define SIV3D_ASYNC_LOGGER_THREAD 0
+# endif
+
+namespace s3d
+{
+	struct LogRecord
+	{
+		uint64 timeStamp = 0;
+
+		LogType type = LogType::App;
+
+		String text;
+	};
+
+	/// @brief ログをスレッドごとのリングバッファに書き込み、バックグラウンドのスレッドでまとめて出力するクラス
+	/// @remark ログを書き込むスレッドはロックを取りません。
+	class AsyncLogger
+	{
+	public:
+
+		/// @brief 時刻順に並べたログをまとめて出力する関数
+		using OutputFunction = std::function<void(const Array<LogRecord>&)>;
+
+		AsyncLogger(size_t bufferSize, LogOverflowPolicy overflow, OutputFunction output);
+
+		/// @brief 残っているログをすべて出力してから、スレッドを終了します。
+		~AsyncLogger();
+
+		/// @brief ログをバッファに書き込みます。
+		/// @remark `LogOverflowPolicy::Block` の場合でも、出力スレッドから呼ばれたときはバッファが空くのを待たずに破棄します。
+		void write(LogType type, uint64 timeStamp, StringView s);
+
+		/// @brief この関数を呼ぶ前に書き込まれたログがすべて出力されるまで待機します。
+		void flush();
+
+		/// @brief 残っているログをすべて出力してから、スレッドを終了します。以降に書き込まれたログは出力されません。
+		void stop();
+
+	private:
+
+		class ThreadBuffer;
+
+		const uint64 m_id;
+
+		const size_t m_bufferSize;
+
+		const LogOverflowPolicy m_overflow;
+
+		OutputFunction m_output;
+
+		std::mutex m_buffersMutex;
+
+		Array<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+		std::mutex m_wakeMutex;
+
+		std::condition_variable m_wakeCondition;
+
+		std::condition_variable m_flushCondition;
+
+		std::atomic<bool> m_wakeRequested{ false };
+
+		uint64 m_flushRequested = 0;
+
+		uint64 m_flushed = 0;
+
+		std::atomic<bool> m_stop{ false };
+
+		std::thread m_thread;
+
+		[[nodiscard]]
+		ThreadBuffer& getThreadBuffer();
+
+		[[nodiscard]]
+		bool isOutputThread() const noexcept;
+
+		void wake();
+
+		void run();
+
+		// すべてのバッファからログを取り出して出力する。取り出したログの数を返す
+		size_t drain(Array<LogRecord>& records);
+	};
+}
@@ -0,0 +1,237 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+// CLogger のうち、プラットフォームに依存しない部分の実装
+
+# include <array>
+# include <Siv3D/String.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/ScopeGuard.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/Logger/CLogger.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr std::array<StringView, 7> LogTypeNames =
+		{
+			U"[error]   "_sv,
+			U"[fail]    "_sv,
+			U"[warning] "_sv,
+			U""_sv,
+			U"[info]    "_sv,
+			U"[trace]   "_sv,
+			U"[verbose] "_sv,
+		};
+
+		static void AppendLine(String& dst, const uint64 timeStamp, const LogType type, const StringView s)
+		{
+			dst += U"{}: {}"_fmt(timeStamp, LogTypeNames[FromEnum(type)]);
+			dst += s;
+			dst += U'\n';
+		}
+	}
+
+	CLogger::CLogger() = default;
+
+	CLogger::~CLogger()
+	{
+	# if SIV3D_ASYNC_LOGGER_THREAD
+
+		replaceAsyncLogger(nullptr);
+
+	# endif
+
+		if (m_file)
+		{
+			std::fclose(m_file);
+		}
+	}
+
+	void CLogger::write(const LogType type, const StringView s)
+	{
+		if (not m_enabled)
+		{
+			return;
+		}
+
+		const uint64 timeStamp = Time::GetMillisec();
+
+	# if SIV3D_ASYNC_LOGGER_THREAD
+
+		for (;;)
+		{
+			// 書き込みが終わるまで、setAsync() は出力先を差し替えない
+			const uint32 generation = m_asyncGeneration.load();
+			std::atomic<size_t>& writers = m_asyncWriters[generation & 1];
+			++writers;
+
+			// 数え始める前に世代が進んでいた場合、差し替えはこのカウンタを待たないので、やり直す
+			if ((m_asyncGeneration.load() == generation) && (not m_asyncSwitching.load()))
+			{
+				const ScopeGuard guard = [&writers]() { --writers; };
+
+				writeLine(type, timeStamp, s);
+				return;
+			}
+
+			// 差し替え中は、以前のロガーに書き込まれたログがすべて出力されるまで待つ
+			--writers;
+
+			while (m_asyncSwitching.load())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+	# else
+
+		writeLine(type, timeStamp, s);
+
+	# endif
+	}
+
+	void CLogger::setEnabled(const bool enabled)
+	{
+		m_enabled = enabled;
+	}
+
+	void CLogger::setAsync([[maybe_unused]] const bool enabled, [[maybe_unused]] const size_t bufferSize, [[maybe_unused]] const LogOverflowPolicy overflow)
+	{
+	# if SIV3D_ASYNC_LOGGER_THREAD
+
+		std::unique_ptr<AsyncLogger> asyncLogger;
+
+		if (enabled)
+		{
+			asyncLogger = std::make_unique<AsyncLogger>(bufferSize, overflow,
+				[this](const Array<LogRecord>& records) { writeRecords(records); });
+		}
+
+		replaceAsyncLogger(std::move(asyncLogger));
+
+	# endif
+	}
+
+	void CLogger::flush()
+	{
+	# if SIV3D_ASYNC_LOGGER_THREAD
+
+		{
+			std::lock_guard lock{ m_asyncMutex };
+
+			if (m_asyncLogger)
+			{
+				m_asyncLogger->flush();
+			}
+		}
+
+	# endif
+
+		std::lock_guard lock{ m_mutex };
+
+		if (m_file)
+		{
+			std::fflush(m_file);
+		}
+	}
+
+	bool CLogger::setOutputFile(const StringView path)
+	{
+		flush();
+
+		std::lock_guard lock{ m_mutex };
+
+		if (m_file)
+		{
+			std::fclose(m_file);
+			m_file = nullptr;
+		}
+
+		if (not path)
+		{
+			return true;
+		}
+
+		m_file = OpenFile(path);
+
+		return (m_file != nullptr);
+	}
+
+# if SIV3D_ASYNC_LOGGER_THREAD
+
+	void CLogger::replaceAsyncLogger(std::unique_ptr<AsyncLogger> asyncLogger)
+	{
+		std::lock_guard lock{ m_asyncMutex };
+
+		if ((not m_asyncLogger) && (not asyncLogger))
+		{
+			return;
+		}
+
+		// 差し替えが終わるまで、新しいログの書き込みを待たせる
+		m_asyncSwitching.store(true);
+
+		// 書き込み中の可能性があるのは、世代を進める前に、その世代のカウンタを増やしてから世代と m_asyncSwitching を確かめたスレッドだけ
+		const uint32 generation = m_asyncGeneration.fetch_add(1);
+
+		while (m_asyncWriters[generation & 1] != 0)
+		{
+			std::this_thread::yield();
+		}
+
+		// 以前のロガーに書き込まれたログをすべて出力してから破棄する。これにより、スレッドごとのログの順番が保たれる
+		if (m_asyncLogger)
+		{
+			m_asyncLogger->stop();
+		}
+
+		m_asyncLogger = std::move(asyncLogger);
+
+		m_async.store(m_asyncLogger.get());
+
+		m_asyncSwitching.store(false);
+	}
+
+# endif
+
+	void CLogger::writeLine(const LogType type, const uint64 timeStamp, const StringView s)
+	{
+	# if SIV3D_ASYNC_LOGGER_THREAD
+
+		// 文字列の変換と出力は、バックグラウンドのスレッドで行う
+		if (AsyncLogger* async = m_async.load())
+		{
+			async->write(type, timeStamp, s);
+			return;
+		}
+
+	# endif
+
+		String text;
+		detail::AppendLine(text, timeStamp, type, s);
+
+		writeOutput(text);
+	}
+
+	void CLogger::writeRecords(const Array<LogRecord>& records)
+	{
+		String text;
+
+		for (const auto& record : records)
+		{
+			detail::AppendLine(text, record.timeStamp, record.type, record.text);
+		}
+
+		writeOutput(text);
+	}
+}
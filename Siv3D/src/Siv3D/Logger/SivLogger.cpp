@@ -11,6 +11,7 @@
 
 # include <Siv3D/Logger.hpp>
 # include <Siv3D/LogType.hpp>
+# include <Siv3D/LogOverflowPolicy.hpp>
 # include <Siv3D/Logger/ILogger.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -81,5 +82,20 @@ namespace s3d
 		{
 			SIV3D_ENGINE(Logger)->setEnabled(true);
 		}
+
+		void Logger_impl::setAsync(const bool enabled, const size_t bufferSize, const LogOverflowPolicy overflow) const
+		{
+			SIV3D_ENGINE(Logger)->setAsync(enabled, bufferSize, overflow);
+		}
+
+		void Logger_impl::flush() const
+		{
+			SIV3D_ENGINE(Logger)->flush();
+		}
+
+		bool Logger_impl::setOutputFile(const FilePathView path) const
+		{
+			return SIV3D_ENGINE(Logger)->setOutputFile(path);
+		}
 	}
 }
@@ -14,6 +14,7 @@
 # include <Siv3D/Mouse.hpp>
 # include <Siv3D/Cursor.hpp>
 # include <Siv3D/Geometry2D.hpp>
+# include <Siv3D/Polygon/PolygonSpatialIndex.hpp>
 
 namespace s3d
 {
@@ -34,20 +35,26 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::append(const Array<value_type>& other)
 	{
-		m_data.insert(end(), other.begin(), other.end());
+		m_spatialIndex.reset();
+
+		m_data.insert(m_data.end(), other.begin(), other.end());
 
 		return *this;
 	}
 
 	MultiPolygon& MultiPolygon::append(const MultiPolygon& other)
 	{
-		m_data.insert(end(), other.begin(), other.end());
+		m_spatialIndex.reset();
+
+		m_data.insert(m_data.end(), other.begin(), other.end());
 
 		return *this;
 	}
 
 	MultiPolygon& MultiPolygon::remove_at(const size_t index)
 	{
+		m_spatialIndex.reset();
+
 		m_data.remove_at(index);
 
 		return *this;
@@ -55,6 +62,8 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::reverse()
 	{
+		m_spatialIndex.reset();
+
 		m_data.reverse();
 
 		return *this;
@@ -72,6 +81,8 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::shuffle()
 	{
+		m_spatialIndex.reset();
+
 		m_data.shuffle();
 
 		return *this;
@@ -123,7 +134,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::moveBy(const double x, const double y) noexcept
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.moveBy(x, y);
 		}
@@ -158,7 +171,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::rotate(const double angle)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.rotate(angle);
 		}
@@ -168,7 +183,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::rotateAt(const Vec2& pos, const double angle)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.rotateAt(pos, angle);
 		}
@@ -188,7 +205,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::transform(const double s, const double c, const Vec2& pos)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.transform(s, c, pos);
 		}
@@ -228,7 +247,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::scale(const double s)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.scale(s);
 		}
@@ -243,7 +264,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::scale(const Vec2 s)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.scale(s);
 		}
@@ -263,7 +286,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::scaleAt(const Vec2 pos, const double s)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.scaleAt(pos, s);
 		}
@@ -298,7 +323,9 @@ namespace s3d
 
 	MultiPolygon& MultiPolygon::scaleAt(const Vec2 pos, const Vec2 s)
 	{
-		for (auto& polygon : *this)
+		m_spatialIndex.reset();
+
+		for (auto& polygon : m_data)
 		{
 			polygon.scaleAt(pos, s);
 		}
@@ -553,4 +580,9 @@ namespace s3d
 			polygon.drawTransformed(s, c, pos, color);
 		}
 	}
+
+	const detail::MultiPolygonSpatialIndex* MultiPolygon::_spatialIndex() const
+	{
+		return m_spatialIndex.get(m_data);
+	}
 }
@@ -9,12 +9,21 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/ParallelFor.hpp>
 # include "NavMeshDetail.hpp"
 
 namespace s3d
 {
 	namespace detail
 	{
+		// 1 回に取り出す経路探索の数
+		inline constexpr size_t NavMeshQueryGrainSize = 16;
+
+		// dtPolyRef のうち、タイルとポリゴンの番号に使えるビット数
+		inline constexpr int32 NavMeshTilePolyBits = 22;
+
+		inline constexpr int32 NavMeshMaxTileBits = 14;
+
 		[[nodiscard]]
 		static NavMeshAABB CalculateAABB(const Array<Float2>& vertices) noexcept
 		{
@@ -105,6 +114,232 @@ namespace s3d
 
 			return cfg;
 		}
+
+		[[nodiscard]]
+		static float TileWidth(const NavMeshConfig& config) noexcept
+		{
+			return (config.tileSize * static_cast<float>(config.cellSize));
+		}
+
+		// 隣のタイルとつながるように、タイルの周囲も含めて構築する
+		[[nodiscard]]
+		static int32 TileBorderSize(const rcConfig& cfg) noexcept
+		{
+			return (cfg.walkableRadius + 3);
+		}
+
+		[[nodiscard]]
+		static rcConfig MakeTileConfig(const NavMeshConfig& config, const NavMeshAABB& aabb, const Point& tile)
+		{
+			rcConfig cfg = MakeConfig(config, aabb);
+
+			const float tileWidth = TileWidth(config);
+
+			cfg.tileSize	= config.tileSize;
+			cfg.borderSize	= TileBorderSize(cfg);
+			cfg.width		= (cfg.tileSize + cfg.borderSize * 2);
+			cfg.height		= (cfg.tileSize + cfg.borderSize * 2);
+
+			cfg.bmin[0] = (aabb.bmin[0] + tile.x * tileWidth);
+			cfg.bmin[2] = (aabb.bmin[2] + tile.y * tileWidth);
+			cfg.bmax[0] = (cfg.bmin[0] + tileWidth);
+			cfg.bmax[2] = (cfg.bmin[2] + tileWidth);
+
+			cfg.bmin[0] -= (cfg.borderSize * cfg.cs);
+			cfg.bmin[2] -= (cfg.borderSize * cfg.cs);
+			cfg.bmax[0] += (cfg.borderSize * cfg.cs);
+			cfg.bmax[2] += (cfg.borderSize * cfg.cs);
+
+			return cfg;
+		}
+
+		[[nodiscard]]
+		static dtQueryFilter MakeFilter(const Array<std::pair<int32, double>>& areaCosts)
+		{
+			dtQueryFilter filter;
+
+			for (const auto& areaCost : areaCosts)
+			{
+				if (areaCost.first <= RC_WALKABLE_AREA)
+				{
+					filter.setAreaCost(areaCost.first, static_cast<float>(areaCost.second));
+				}
+			}
+
+			return filter;
+		}
+
+		static bool CreateNavMeshData(const rcConfig& cfg, const NavMeshConfig& config, rcPolyMesh& mesh, const rcPolyMeshDetail& dmesh,
+			const Point& tile, unsigned char** navData, int32* navDataSize)
+		{
+			for (int32 i = 0; i < mesh.npolys; ++i)
+			{
+				mesh.flags[i] = 1;
+			}
+
+			dtNavMeshCreateParams params;
+			std::memset(&params, 0, sizeof(params));
+
+			params.verts		= mesh.verts;
+			params.vertCount	= mesh.nverts;
+			params.polys		= mesh.polys;
+			params.polyAreas	= mesh.areas;
+			params.polyFlags	= mesh.flags;
+			params.polyCount	= mesh.npolys;
+			params.nvp			= mesh.nvp;
+
+			params.detailMeshes		= dmesh.meshes;
+			params.detailVerts		= dmesh.verts;
+			params.detailVertsCount	= dmesh.nverts;
+			params.detailTris		= dmesh.tris;
+			params.detailTriCount	= dmesh.ntris;
+
+			params.walkableHeight	= static_cast<float>(cfg.walkableHeight);
+			params.walkableRadius	= static_cast<float>(config.agentRadius);
+			params.walkableClimb	= static_cast<float>(cfg.walkableClimb);
+			params.tileX			= tile.x;
+			params.tileY			= tile.y;
+			rcVcopy(params.bmin, mesh.bmin);
+			rcVcopy(params.bmax, mesh.bmax);
+			params.cs = cfg.cs;
+			params.ch = cfg.ch;
+			params.buildBvTree = true;
+
+			return dtCreateNavMeshData(&params, navData, navDataSize);
+		}
+
+		struct NavMeshTileData
+		{
+			unsigned char* data = nullptr;
+
+			int32 size = 0;
+		};
+
+		// 1 つのタイルを構築する。歩ける場所が無いタイルの data は nullptr のまま
+		static bool BuildTile(const NavMeshConfig& config, const rcConfig& cfg, const Point& tile,
+			const Array<Float3>& vertices, const Array<int32>& triangles, const Array<uint8>& areaIDs, NavMeshTileData& result)
+		{
+			if (not areaIDs)
+			{
+				return true;
+			}
+
+			// 複数のタイルを並列に構築するため、作業領域はタイルごとに用意する
+			rcContext ctx{ false };
+
+			const std::unique_ptr<rcHeightfield, decltype(&rcFreeHeightField)> hf{ rcAllocHeightfield(), rcFreeHeightField };
+			const std::unique_ptr<rcCompactHeightfield, decltype(&rcFreeCompactHeightfield)> chf{ rcAllocCompactHeightfield(), rcFreeCompactHeightfield };
+			const std::unique_ptr<rcContourSet, decltype(&rcFreeContourSet)> cset{ rcAllocContourSet(), rcFreeContourSet };
+			const std::unique_ptr<rcPolyMesh, decltype(&rcFreePolyMesh)> mesh{ rcAllocPolyMesh(), rcFreePolyMesh };
+			const std::unique_ptr<rcPolyMeshDetail, decltype(&rcFreePolyMeshDetail)> dmesh{ rcAllocPolyMeshDetail(), rcFreePolyMeshDetail };
+
+			if ((not hf) || (not chf) || (not cset) || (not mesh) || (not dmesh))
+			{
+				throw std::bad_alloc();
+			}
+
+			if (not rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+			{
+				return false;
+			}
+
+			const int32 flagMergeThreshold = 0;
+
+			rcRasterizeTriangles(&ctx, &vertices[0].x, static_cast<int32>(vertices.size()),
+				triangles.data(), areaIDs.data(), static_cast<int32>(areaIDs.size()), *hf, flagMergeThreshold);
+
+			rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+			rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+			rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+
+			if (not rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf))
+			{
+				return false;
+			}
+
+			if (not rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf))
+			{
+				return false;
+			}
+
+			if (not rcBuildDistanceField(&ctx, *chf))
+			{
+				return false;
+			}
+
+			if (not rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+			{
+				return false;
+			}
+
+			if (not rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset))
+			{
+				return false;
+			}
+
+			if (not rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *mesh))
+			{
+				return false;
+			}
+
+			if (mesh->npolys == 0)
+			{
+				return true;
+			}
+
+			if (not rcBuildPolyMeshDetail(&ctx, *mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *dmesh))
+			{
+				return false;
+			}
+
+			return CreateNavMeshData(cfg, config, *mesh, *dmesh, tile, &result.data, &result.size);
+		}
+
+		// 範囲 [min, max] にかかるタイルの範囲を返す
+		[[nodiscard]]
+		static std::pair<Point, Point> GetTileRange(const NavMeshAABB& aabb, const float tileWidth, const Point& tileCount,
+			const float minX, const float minZ, const float maxX, const float maxZ) noexcept
+		{
+			const Point begin{
+				Max(static_cast<int32>(std::floor((minX - aabb.bmin[0]) / tileWidth)), 0),
+				Max(static_cast<int32>(std::floor((minZ - aabb.bmin[2]) / tileWidth)), 0) };
+
+			const Point end{
+				Min(static_cast<int32>(std::floor((maxX - aabb.bmin[0]) / tileWidth)) + 1, tileCount.x),
+				Min(static_cast<int32>(std::floor((maxZ - aabb.bmin[2]) / tileWidth)) + 1, tileCount.y) };
+
+			return{ begin, end };
+		}
+
+		static void ToPath(const Array<Float3>& buffer, const int32 nvertices, Array<Vec2>& dst)
+		{
+			dst.resize(nvertices);
+
+			const Float3* pSrc = buffer.data();
+			const Float3* pSrcEnd = (pSrc + nvertices);
+			Vec2* pDst = dst.data();
+
+			while (pSrc != pSrcEnd)
+			{
+				pDst->set(pSrc->x, pSrc->z);
+				++pDst;
+				++pSrc;
+			}
+		}
+
+		static void ToPath(const Array<Float3>& buffer, const int32 nvertices, Array<Vec3>& dst)
+		{
+			dst.resize(nvertices);
+
+			const Float3* pSrc = buffer.data();
+			const Float3* pSrcEnd = (pSrc + nvertices);
+			Vec3* pDst = dst.data();
+
+			while (pSrc != pSrcEnd)
+			{
+				*pDst++ = *pSrc++;
+			}
+		}
 	}
 
 	NavMesh::NavMeshDetail::NavMeshDetail()
@@ -146,14 +381,20 @@ namespace s3d
 		try
 		{
 			const Array<Float3> vertex3 = vertices.map([](const Float2& v) { return Float3{ v.x, 0.0f, v.y }; });
-			build(config, detail::CalculateAABB(vertices), vertex3, indices, areaIDs);
+
+			if (0 < config.tileSize)
+			{
+				return buildTiled(config, detail::CalculateAABB(vertices), vertex3, indices, areaIDs);
+			}
+
+			return build(config, detail::CalculateAABB(vertices), vertex3, indices, areaIDs);
 		}
 		catch (...)
 		{
+			release();
+
 			return false;
 		}
-
-		return true;
 	}
 
 	bool NavMesh::NavMeshDetail::build(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config)
@@ -179,106 +420,111 @@ namespace s3d
 
 		try
 		{
-			build(config, detail::CalculateAABB(vertices), vertices, indices, areaIDs);
+			if (0 < config.tileSize)
+			{
+				return buildTiled(config, detail::CalculateAABB(vertices), vertices, indices, areaIDs);
+			}
+
+			return build(config, detail::CalculateAABB(vertices), vertices, indices, areaIDs);
 		}
 		catch (...)
 		{
+			release();
+
 			return false;
 		}
-
-		return true;
 	}
 
-	void NavMesh::NavMeshDetail::query(const Float2& _start, const Float2& _end, const Array<std::pair<int32, double>>& areaCosts, Array<Vec2>& dst) const
+	bool NavMesh::NavMeshDetail::rebuildTiles(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& region)
 	{
-		dst.clear();
+		return rebuildTiles(vertices.map([](const Float2& v) { return Float3{ v.x, 0.0f, v.y }; }), indices, areaIDs, region);
+	}
 
+	bool NavMesh::NavMeshDetail::rebuildTiles(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& regionXZ)
+	{
 		if (not m_built)
 		{
-			return;
+			return false;
 		}
 
-		dtQueryFilter filter;
+		// タイルに分けていない場合は、すべてを構築し直す
+		if (not m_tiled)
 		{
-			for (const auto& areaCost : areaCosts)
-			{
-				if (areaCost.first <= RC_WALKABLE_AREA)
-				{
-					filter.setAreaCost(areaCost.first, static_cast<float>(areaCost.second));
-				}
-			}
-		}
+			const NavMeshConfig config = m_config;
 
-		const Float3 start{ _start.x, 0.0f, _start.y }, end{ _end.x, 0.0f, _end.y };
-		constexpr Float3 extent{ 2.0f, 0.0f, 2.0f };
+			return build(vertices, indices, areaIDs, config);
+		}
 
-		dtPolyRef startpoly;
+		if ((not vertices)
+			|| (not indices)
+			|| (indices.size() != areaIDs.size()))
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
-			{
-				return;
-			}
-
-			if (startpoly == 0)
-			{
-				return;
-			}
+			return false;
 		}
 
-		dtPolyRef endpoly;
+		if (not areaIDs.all([](uint8 id) { return (id <= RC_WALKABLE_AREA); }))
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
-			{
-				return;
-			}
+			return false;
+		}
 
-			if (endpoly == 0)
-			{
-				return;
-			}
+		m_tiles.vertices	= vertices;
+		m_tiles.indices		= indices;
+		m_tiles.areaIDs		= areaIDs;
+
+		// 高さの範囲だけは広げられる。水平方向の範囲は最初に構築したときのまま
+		{
+			const NavMeshAABB aabb = detail::CalculateAABB(vertices);
+			m_tiles.aabb.bmin[1] = Min(m_tiles.aabb.bmin[1], aabb.bmin[1]);
+			m_tiles.aabb.bmax[1] = Max(m_tiles.aabb.bmax[1], aabb.bmax[1]);
 		}
 
-		int32 npolys = 0;
+		const float border = (detail::TileBorderSize(detail::MakeConfig(m_config, m_tiles.aabb)) * static_cast<float>(m_config.cellSize));
+
+		const auto [begin, end] = detail::GetTileRange(m_tiles.aabb, detail::TileWidth(m_config), { m_tiles.tileCountX, m_tiles.tileCountY },
+			static_cast<float>(regionXZ.x - border), static_cast<float>(regionXZ.y - border),
+			static_cast<float>(regionXZ.x + regionXZ.w + border), static_cast<float>(regionXZ.y + regionXZ.h + border));
+
+		Array<Point> tiles;
+
+		for (int32 y = begin.y; y < end.y; ++y)
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, m_polygonBuffer.data(), &npolys, PolygonBufferSize)))
+			for (int32 x = begin.x; x < end.x; ++x)
 			{
-				return;
+				tiles.emplace_back(x, y);
 			}
+		}
 
-			if (npolys <= 0)
-			{
-				return;
-			}
+		try
+		{
+			return buildTiles(tiles);
+		}
+		catch (...)
+		{
+			return false;
 		}
+	}
 
-		float end2[3] = { end.x, end.y, end.z };
+	void NavMesh::NavMeshDetail::query(const Float2& start, const Float2& end, const Array<std::pair<int32, double>>& areaCosts, Array<Vec2>& dst) const
+	{
+		dst.clear();
 
-		if (m_polygonBuffer[static_cast<size_t>(npolys) - 1] != endpoly)
+		if (not m_built)
 		{
-			bool posOverPoly;
-			m_data.navmeshQuery.closestPointOnPoly(m_polygonBuffer[static_cast<size_t>(npolys) - 1], &end.x, end2, &posOverPoly);
+			return;
 		}
 
+		const QueryContextPtr context = acquireQueryContext();
+
+		if (not context)
 		{
-			int32 nvertices = 0;
-			m_data.navmeshQuery.findStraightPath(&start.x, end2, m_polygonBuffer.data(), npolys, &m_buffer[0].x, 0, 0, &nvertices, MaxVertices);
+			return;
+		}
 
-			if (nvertices)
-			{
-				dst.resize(nvertices);
+		constexpr Float3 extent{ 2.0f, 0.0f, 2.0f };
 
-				const Float3* pSrc = m_buffer.data();
-				const Float3* pSrcEnd = (pSrc + nvertices);
-				Vec2* pDst = dst.data();
+		const int32 nvertices = findPath(*context, detail::MakeFilter(areaCosts), Float3{ start.x, 0.0f, start.y }, Float3{ end.x, 0.0f, end.y }, extent);
 
-				while (pSrc != pSrcEnd)
-				{
-					pDst->set(pSrc->x, pSrc->z);
-					++pDst;
-					++pSrc;
-				}
-			}
-		}
+		detail::ToPath(context->buffer, nvertices, dst);
 	}
 
 	void NavMesh::NavMeshDetail::query(const Float3& start, const Float3& end, const Array<std::pair<int32, double>>& areaCosts, Array<Vec3>& dst) const
@@ -290,84 +536,103 @@ namespace s3d
 			return;
 		}
 
-		dtQueryFilter filter;
+		const QueryContextPtr context = acquireQueryContext();
+
+		if (not context)
 		{
-			for (const auto& areaCost : areaCosts)
-			{
-				if (areaCost.first <= RC_WALKABLE_AREA)
-				{
-					filter.setAreaCost(areaCost.first, static_cast<float>(areaCost.second));
-				}
-			}
+			return;
 		}
 
 		constexpr Float3 extent{ 2.0f, 4.0f, 2.0f };
 
-		dtPolyRef startpoly;
+		const int32 nvertices = findPath(*context, detail::MakeFilter(areaCosts), start, end, extent);
+
+		detail::ToPath(context->buffer, nvertices, dst);
+	}
+
+	void NavMesh::NavMeshDetail::queryBatch(const Array<std::pair<Vec2, Vec2>>& queries, const Array<std::pair<int32, double>>& areaCosts, Array<Array<Vec2>>& dst) const
+	{
+		dst.resize(queries.size());
+
+		if (not m_built)
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
+			for (auto& path : dst)
 			{
-				return;
+				path.clear();
 			}
 
-			if (startpoly == 0)
-			{
-				return;
-			}
+			return;
 		}
 
-		dtPolyRef endpoly;
-		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
-			{
-				return;
-			}
+		const dtQueryFilter filter = detail::MakeFilter(areaCosts);
 
-			if (endpoly == 0)
+		ParallelFor(0, queries.size(), [&](const size_t first, const size_t last)
 			{
-				return;
-			}
-		}
+				const QueryContextPtr context = acquireQueryContext();
 
-		int32 npolys = 0;
+				if (not context)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						dst[i].clear();
+					}
+
+					return;
+				}
+
+				constexpr Float3 extent{ 2.0f, 0.0f, 2.0f };
+
+				for (size_t i = first; i < last; ++i)
+				{
+					const Float3 start{ queries[i].first.x, 0.0f, queries[i].first.y };
+					const Float3 end{ queries[i].second.x, 0.0f, queries[i].second.y };
+
+					const int32 nvertices = findPath(*context, filter, start, end, extent);
+
+					detail::ToPath(context->buffer, nvertices, dst[i]);
+				}
+			}, detail::NavMeshQueryGrainSize);
+	}
+
+	void NavMesh::NavMeshDetail::queryBatch(const Array<std::pair<Vec3, Vec3>>& queries, const Array<std::pair<int32, double>>& areaCosts, Array<Array<Vec3>>& dst) const
+	{
+		dst.resize(queries.size());
+
+		if (not m_built)
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, m_polygonBuffer.data(), &npolys, PolygonBufferSize)))
+			for (auto& path : dst)
 			{
-				return;
+				path.clear();
 			}
 
-			if (npolys <= 0)
-			{
-				return;
-			}
+			return;
 		}
 
-		float end2[3] = { end.x, end.y, end.z };
+		const dtQueryFilter filter = detail::MakeFilter(areaCosts);
 
-		if (m_polygonBuffer[static_cast<size_t>(npolys) - 1] != endpoly)
-		{
-			bool posOverPoly;
-			m_data.navmeshQuery.closestPointOnPoly(m_polygonBuffer[static_cast<size_t>(npolys) - 1], &end.x, end2, &posOverPoly);
-		}
+		ParallelFor(0, queries.size(), [&](const size_t first, const size_t last)
+			{
+				const QueryContextPtr context = acquireQueryContext();
 
-		{
-			int32 nvertices = 0;
-			m_data.navmeshQuery.findStraightPath(&start.x, end2, m_polygonBuffer.data(), npolys, &m_buffer[0].x, 0, 0, &nvertices, MaxVertices);
+				if (not context)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						dst[i].clear();
+					}
 
-			if (nvertices)
-			{
-				dst.resize(nvertices);
+					return;
+				}
 
-				const Float3* pSrc = m_buffer.data();
-				const Float3* pSrcEnd = (pSrc + nvertices);
-				Vec3* pDst = dst.data();
+				constexpr Float3 extent{ 2.0f, 4.0f, 2.0f };
 
-				while (pSrc != pSrcEnd)
+				for (size_t i = first; i < last; ++i)
 				{
-					*pDst++ = *pSrc++;
+					const int32 nvertices = findPath(*context, filter, queries[i].first, queries[i].second, extent);
+
+					detail::ToPath(context->buffer, nvertices, dst[i]);
 				}
-			}
-		}
+			}, detail::NavMeshQueryGrainSize);
 	}
 
 	bool NavMesh::NavMeshDetail::build(const NavMeshConfig& config, const NavMeshAABB& aabb,
@@ -428,60 +693,280 @@ namespace s3d
 			return false;
 		}
 
-		const auto& mesh	= *m_data.mesh;
-		const auto& dmesh	= *m_data.dmesh;
-
-		for (int32 i = 0; i < mesh.npolys; ++i)
+		if (not detail::CreateNavMeshData(cfg, config, *m_data.mesh, *m_data.dmesh, Point{ 0, 0 }, &m_navData, &m_navDataSize))
 		{
-			mesh.flags[i] = 1;
+			return false;
 		}
 
-		dtNavMeshCreateParams params;
-		std::memset(&params, 0, sizeof(params));
+		m_data.navmesh->init(m_navData, m_navDataSize, DT_TILE_FREE_DATA);
+
+		m_config = config;
+
+		m_built = true;
+
+		return true;
+	}
+
+	bool NavMesh::NavMeshDetail::buildTiled(const NavMeshConfig& config, const NavMeshAABB& aabb,
+		const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs)
+	{
+		assert(not m_built);
+
+		const float tileWidth = detail::TileWidth(config);
 
-		params.verts		= mesh.verts;
-		params.vertCount	= mesh.nverts;
-		params.polys		= mesh.polys;
-		params.polyAreas	= mesh.areas;
-		params.polyFlags	= mesh.flags;
-		params.polyCount	= mesh.npolys;
-		params.nvp			= mesh.nvp;
-
-		params.detailMeshes		= dmesh.meshes;
-		params.detailVerts		= dmesh.verts;
-		params.detailVertsCount	= dmesh.nverts;
-		params.detailTris		= dmesh.tris;
-		params.detailTriCount	= dmesh.ntris;
-
-		params.walkableHeight	= static_cast<float>(cfg.walkableHeight);
-		params.walkableClimb	= static_cast<float>(cfg.walkableClimb);
-		rcVcopy(params.bmin, mesh.bmin);
-		rcVcopy(params.bmax, mesh.bmax);
-		params.cs = cfg.cs;
-		params.ch = cfg.ch;
-		params.buildBvTree = true;
-
-		if (not dtCreateNavMeshData(&params, &m_navData, &m_navDataSize))
+		const int32 tileCountX = Max(static_cast<int32>(std::ceil((aabb.bmax[0] - aabb.bmin[0]) / tileWidth)), 1);
+		const int32 tileCountY = Max(static_cast<int32>(std::ceil((aabb.bmax[2] - aabb.bmin[2]) / tileWidth)), 1);
+		const int32 tileCount = (tileCountX * tileCountY);
+
+		const int32 tileBits = Min(static_cast<int32>(dtIlog2(dtNextPow2(static_cast<uint32>(tileCount)))), detail::NavMeshMaxTileBits);
+
+		// タイルが多すぎて、dtPolyRef で表せない
+		if ((1 << tileBits) < tileCount)
 		{
 			return false;
 		}
 
-		m_data.navmesh->init(m_navData, m_navDataSize, DT_TILE_FREE_DATA);
+		dtNavMeshParams params;
+		std::memset(&params, 0, sizeof(params));
+
+		rcVcopy(params.orig, aabb.bmin);
+		params.tileWidth	= tileWidth;
+		params.tileHeight	= tileWidth;
+		params.maxTiles		= (1 << tileBits);
+		params.maxPolys		= (1 << (detail::NavMeshTilePolyBits - tileBits));
+
+		m_data.navmesh = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), dtFreeNavMesh);
 
-		if (dtStatusFailed(m_data.navmeshQuery.init(m_data.navmesh.get(), 2048)))
+		if (not m_data.navmesh)
+		{
+			throw std::bad_alloc();
+		}
+
+		if (dtStatusFailed(m_data.navmesh->init(&params)))
 		{
 			return false;
 		}
 
-		m_buffer.resize(MaxVertices);
+		m_config = config;
+		m_tiled = true;
+		m_tiles.aabb		= aabb;
+		m_tiles.tileCountX	= tileCountX;
+		m_tiles.tileCountY	= tileCountY;
+		m_tiles.vertices	= vertices;
+		m_tiles.indices		= indices;
+		m_tiles.areaIDs		= areaIDs;
 
-		m_polygonBuffer.resize(PolygonBufferSize);
+		Array<Point> tiles(Arg::reserve = tileCount);
+
+		for (int32 y = 0; y < tileCountY; ++y)
+		{
+			for (int32 x = 0; x < tileCountX; ++x)
+			{
+				tiles.emplace_back(x, y);
+			}
+		}
+
+		if (not buildTiles(tiles))
+		{
+			return false;
+		}
 
 		m_built = true;
 
 		return true;
 	}
 
+	bool NavMesh::NavMeshDetail::buildTiles(const Array<Point>& tiles)
+	{
+		if (not tiles)
+		{
+			return true;
+		}
+
+		const Point tileCount{ m_tiles.tileCountX, m_tiles.tileCountY };
+		const float tileWidth = detail::TileWidth(m_config);
+		const float border = (detail::TileBorderSize(detail::MakeConfig(m_config, m_tiles.aabb)) * static_cast<float>(m_config.cellSize));
+
+		// 構築するタイルごとに、周囲を含めた範囲にかかる三角形を振り分ける
+		Array<int32> slots((tileCount.x * tileCount.y), -1);
+
+		for (size_t i = 0; i < tiles.size(); ++i)
+		{
+			slots[(tiles[i].y * tileCount.x + tiles[i].x)] = static_cast<int32>(i);
+		}
+
+		Array<Array<int32>> triangles(tiles.size());
+
+		Array<Array<uint8>> areaIDs(tiles.size());
+
+		for (size_t i = 0; i < m_tiles.indices.size(); ++i)
+		{
+			const TriangleIndex& triangleIndex = m_tiles.indices[i];
+			const Float3& p0 = m_tiles.vertices[triangleIndex.i0];
+			const Float3& p1 = m_tiles.vertices[triangleIndex.i1];
+			const Float3& p2 = m_tiles.vertices[triangleIndex.i2];
+
+			const auto [begin, end] = detail::GetTileRange(m_tiles.aabb, tileWidth, tileCount,
+				(Min({ p0.x, p1.x, p2.x }) - border), (Min({ p0.z, p1.z, p2.z }) - border),
+				(Max({ p0.x, p1.x, p2.x }) + border), (Max({ p0.z, p1.z, p2.z }) + border));
+
+			for (int32 y = begin.y; y < end.y; ++y)
+			{
+				for (int32 x = begin.x; x < end.x; ++x)
+				{
+					if (const int32 slot = slots[(y * tileCount.x + x)];
+						0 <= slot)
+					{
+						triangles[slot].append({ triangleIndex.i0, triangleIndex.i1, triangleIndex.i2 });
+						areaIDs[slot] << m_tiles.areaIDs[i];
+					}
+				}
+			}
+		}
+
+		// タイルは互いに独立しているので並列に構築し、ナビメッシュへの追加だけを順に行う
+		Array<detail::NavMeshTileData> results(tiles.size());
+
+		Array<uint8> succeeded(tiles.size(), 0);
+
+		ParallelFor(0, tiles.size(), [&](const size_t i)
+			{
+				const rcConfig cfg = detail::MakeTileConfig(m_config, m_tiles.aabb, tiles[i]);
+
+				succeeded[i] = detail::BuildTile(m_config, cfg, tiles[i], m_tiles.vertices, triangles[i], areaIDs[i], results[i]);
+			}, 1);
+
+		bool result = true;
+
+		for (size_t i = 0; i < tiles.size(); ++i)
+		{
+			// 構築に失敗したタイルは、以前のものを残す
+			if (not succeeded[i])
+			{
+				if (results[i].data)
+				{
+					dtFree(results[i].data);
+				}
+
+				result = false;
+
+				continue;
+			}
+
+			if (const dtTileRef tileRef = m_data.navmesh->getTileRefAt(tiles[i].x, tiles[i].y, 0))
+			{
+				m_data.navmesh->removeTile(tileRef, nullptr, nullptr);
+			}
+
+			if (not results[i].data)
+			{
+				continue;
+			}
+
+			if (dtStatusFailed(m_data.navmesh->addTile(results[i].data, results[i].size, DT_TILE_FREE_DATA, 0, nullptr)))
+			{
+				dtFree(results[i].data);
+
+				result = false;
+			}
+		}
+
+		return result;
+	}
+
+	void NavMesh::NavMeshDetail::QueryContextReleaser::operator ()(QueryContext* context) const
+	{
+		std::lock_guard lock{ detail->m_queryMutex };
+
+		detail->m_queryContexts.emplace_back(context);
+	}
+
+	NavMesh::NavMeshDetail::QueryContextPtr NavMesh::NavMeshDetail::acquireQueryContext() const
+	{
+		{
+			std::lock_guard lock{ m_queryMutex };
+
+			if (m_queryContexts)
+			{
+				QueryContext* context = m_queryContexts.back().release();
+
+				m_queryContexts.pop_back();
+
+				return QueryContextPtr{ context, QueryContextReleaser{ this } };
+			}
+		}
+
+		auto context = std::make_unique<QueryContext>();
+
+		if (dtStatusFailed(context->navmeshQuery.init(m_data.navmesh.get(), MaxQueryNodes)))
+		{
+			return QueryContextPtr{ nullptr, QueryContextReleaser{ this } };
+		}
+
+		context->buffer.resize(MaxVertices);
+
+		context->polygonBuffer.resize(PolygonBufferSize);
+
+		return QueryContextPtr{ context.release(), QueryContextReleaser{ this } };
+	}
+
+	int32 NavMesh::NavMeshDetail::findPath(QueryContext& context, const dtQueryFilter& filter, const Float3& start, const Float3& end, const Float3& extent) const
+	{
+		const dtNavMeshQuery& navmeshQuery = context.navmeshQuery;
+
+		dtPolyRef startpoly;
+		{
+			if (dtStatusFailed(navmeshQuery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
+			{
+				return 0;
+			}
+
+			if (startpoly == 0)
+			{
+				return 0;
+			}
+		}
+
+		dtPolyRef endpoly;
+		{
+			if (dtStatusFailed(navmeshQuery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
+			{
+				return 0;
+			}
+
+			if (endpoly == 0)
+			{
+				return 0;
+			}
+		}
+
+		int32 npolys = 0;
+		{
+			if (dtStatusFailed(navmeshQuery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, context.polygonBuffer.data(), &npolys, PolygonBufferSize)))
+			{
+				return 0;
+			}
+
+			if (npolys <= 0)
+			{
+				return 0;
+			}
+		}
+
+		float end2[3] = { end.x, end.y, end.z };
+
+		if (context.polygonBuffer[static_cast<size_t>(npolys) - 1] != endpoly)
+		{
+			bool posOverPoly;
+			navmeshQuery.closestPointOnPoly(context.polygonBuffer[static_cast<size_t>(npolys) - 1], &end.x, end2, &posOverPoly);
+		}
+
+		int32 nvertices = 0;
+		navmeshQuery.findStraightPath(&start.x, end2, context.polygonBuffer.data(), npolys, &context.buffer[0].x, 0, 0, &nvertices, MaxVertices);
+
+		return nvertices;
+	}
+
 	void NavMesh::NavMeshDetail::init()
 	{
 		try
@@ -528,13 +1013,18 @@ namespace s3d
 
 	void NavMesh::NavMeshDetail::release()
 	{
-		if (not m_built)
 		{
-			return;
+			std::lock_guard lock{ m_queryMutex };
+
+			m_queryContexts.clear();
 		}
 
 		m_data.navmesh.reset();
 
+		m_navData = nullptr;
+
+		m_navDataSize = 0;
+
 		if (m_data.dmesh)
 		{
 			rcFreePolyMeshDetail(m_data.dmesh);
@@ -565,6 +1055,10 @@ namespace s3d
 			m_data.hf = nullptr;
 		}
 
+		m_tiles = TileLayout{};
+
+		m_tiled = false;
+
 		m_built = false;
 	}
 }
@@ -11,6 +11,7 @@
 
 # pragma once
 # include <cfloat>
+# include <mutex>
 # include <Siv3D/NavMesh.hpp>
 # include <RecastDetour/Recast.h>
 # include <RecastDetour/DetourCommon.h>
@@ -41,16 +42,26 @@ namespace s3d
 
 		bool build(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config);
 
+		bool rebuildTiles(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& region);
+
+		bool rebuildTiles(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& regionXZ);
+
 		void query(const Float2& start, const Float2& end, const Array<std::pair<int32, double>>& areaCosts, Array<Vec2>& dst) const;
 
 		void query(const Float3& start, const Float3& end, const Array<std::pair<int32, double>>& areaCosts, Array<Vec3>& dst) const;
 
+		void queryBatch(const Array<std::pair<Vec2, Vec2>>& queries, const Array<std::pair<int32, double>>& areaCosts, Array<Array<Vec2>>& dst) const;
+
+		void queryBatch(const Array<std::pair<Vec3, Vec3>>& queries, const Array<std::pair<int32, double>>& areaCosts, Array<Array<Vec3>>& dst) const;
+
 	private:
 
 		static constexpr int32 MaxVertices = 8192;
 
 		static constexpr int32 PolygonBufferSize = 8192;
 
+		static constexpr int32 MaxQueryNodes = 2048;
+
 		struct Data
 		{
 			rcContext ctx;
@@ -67,9 +78,46 @@ namespace s3d
 
 			std::shared_ptr<dtNavMesh> navmesh;
 
+		} m_data;
+
+		// 経路探索の作業領域。dtNavMeshQuery は同時に使えないため、スレッドごとに貸し出す
+		struct QueryContext
+		{
 			dtNavMeshQuery navmeshQuery;
 
-		} m_data;
+			Array<Float3> buffer;
+
+			Array<dtPolyRef> polygonBuffer;
+		};
+
+		struct QueryContextReleaser
+		{
+			const NavMeshDetail* detail = nullptr;
+
+			void operator ()(QueryContext* context) const;
+		};
+
+		using QueryContextPtr = std::unique_ptr<QueryContext, QueryContextReleaser>;
+
+		// タイルに分けて構築した場合の、タイルの再構築に必要な情報
+		struct TileLayout
+		{
+			NavMeshAABB aabb;
+
+			int32 tileCountX = 0;
+
+			int32 tileCountY = 0;
+
+			Array<Float3> vertices;
+
+			Array<TriangleIndex> indices;
+
+			Array<uint8> areaIDs;
+		};
+
+		NavMeshConfig m_config;
+
+		TileLayout m_tiles;
 
 		unsigned char* m_navData = nullptr;
 
@@ -77,13 +125,27 @@ namespace s3d
 
 		bool m_built = false;
 
-		mutable Array<Float3> m_buffer;
+		bool m_tiled = false;
+
+		mutable std::mutex m_queryMutex;
 
-		mutable Array<dtPolyRef> m_polygonBuffer;
+		mutable Array<std::unique_ptr<QueryContext>> m_queryContexts;
 
 		bool build(const NavMeshConfig& config, const NavMeshAABB& aabb,
 			const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs);
 
+		bool buildTiled(const NavMeshConfig& config, const NavMeshAABB& aabb,
+			const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs);
+
+		bool buildTiles(const Array<Point>& tiles);
+
+		[[nodiscard]]
+		QueryContextPtr acquireQueryContext() const;
+
+		// 見つかった経路の頂点を context.buffer に格納し、その数を返す
+		[[nodiscard]]
+		int32 findPath(QueryContext& context, const dtQueryFilter& filter, const Float3& start, const Float3& end, const Float3& extent) const;
+
 		void init();
 
 		void release();
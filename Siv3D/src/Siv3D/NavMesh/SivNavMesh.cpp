@@ -101,6 +101,36 @@ namespace s3d
 		return pImpl->build(vertices, indices, areaIDs, config);
 	}
 
+	bool NavMesh::rebuildTiles(const Polygon& polygon, const RectF& region)
+	{
+		return pImpl->rebuildTiles(polygon.vertices(), polygon.indices(), Array<uint8>(polygon.indices().size(), 1), region);
+	}
+
+	bool NavMesh::rebuildTiles(const Polygon& polygon, const Array<uint8>& areaIDs, const RectF& region)
+	{
+		return pImpl->rebuildTiles(polygon.vertices(), polygon.indices(), areaIDs, region);
+	}
+
+	bool NavMesh::rebuildTiles(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const RectF& region)
+	{
+		return pImpl->rebuildTiles(vertices, indices, Array<uint8>(indices.size(), 1), region);
+	}
+
+	bool NavMesh::rebuildTiles(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& region)
+	{
+		return pImpl->rebuildTiles(vertices, indices, areaIDs, region);
+	}
+
+	bool NavMesh::rebuildTiles(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const RectF& regionXZ)
+	{
+		return pImpl->rebuildTiles(vertices, indices, Array<uint8>(indices.size(), 1), regionXZ);
+	}
+
+	bool NavMesh::rebuildTiles(const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs, const RectF& regionXZ)
+	{
+		return pImpl->rebuildTiles(vertices, indices, areaIDs, regionXZ);
+	}
+
 	Array<Vec2> NavMesh::query(const Vec2& start, const Vec2& end, const Array<std::pair<int32, double>>& areaCosts) const
 	{
 		Array<Vec2> dst;
@@ -128,4 +158,32 @@ namespace s3d
 	{
 		pImpl->query(start, end, areaCosts, dst);
 	}
+
+	Array<Array<Vec2>> NavMesh::queryBatch(const Array<std::pair<Vec2, Vec2>>& queries, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		Array<Array<Vec2>> dst;
+
+		pImpl->queryBatch(queries, areaCosts, dst);
+
+		return dst;
+	}
+
+	void NavMesh::queryBatch(const Array<std::pair<Vec2, Vec2>>& queries, Array<Array<Vec2>>& dst, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		pImpl->queryBatch(queries, areaCosts, dst);
+	}
+
+	Array<Array<Vec3>> NavMesh::queryBatch(const Array<std::pair<Vec3, Vec3>>& queries, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		Array<Array<Vec3>> dst;
+
+		pImpl->queryBatch(queries, areaCosts, dst);
+
+		return dst;
+	}
+
+	void NavMesh::queryBatch(const Array<std::pair<Vec3, Vec3>>& queries, Array<Array<Vec3>>& dst, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		pImpl->queryBatch(queries, areaCosts, dst);
+	}
 }
@@ -0,0 +1,143 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <atomic>
+# include <exception>
+# include <mutex>
+# include <thread>
+# include <Siv3D/ParallelFor.hpp>
+# include <Siv3D/Utility.hpp>
+# include <Siv3D/ThreadPool/IThreadPool.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 自動の場合、スレッドあたりおよそ 8 回に分けて取り出す
+		static constexpr size_t ChunksPerThread = 8;
+
+		struct ParallelForState
+		{
+			std::atomic<size_t> next;
+
+			size_t endIndex;
+
+			size_t grainSize;
+
+			ParallelForRangeFunction function;
+
+			void* context;
+
+			std::atomic<size_t> activeHelpers;
+
+			std::atomic<bool> canceled = false;
+
+			std::mutex exceptionMutex;
+
+			std::exception_ptr exception;
+
+			void run() noexcept
+			{
+				while (not canceled.load(std::memory_order_relaxed))
+				{
+					const size_t first = next.fetch_add(grainSize, std::memory_order_relaxed);
+
+					if (endIndex <= first)
+					{
+						break;
+					}
+
+					const size_t last = Min((first + grainSize), endIndex);
+
+					try
+					{
+						function(context, first, last);
+					}
+					catch (...)
+					{
+						std::lock_guard lock{ exceptionMutex };
+
+						if (not exception)
+						{
+							exception = std::current_exception();
+						}
+
+						canceled = true;
+					}
+				}
+			}
+		};
+
+		void ParallelForImpl(const size_t beginIndex, const size_t endIndex, size_t grainSize, const ParallelForRangeFunction f, void* context)
+		{
+			if (endIndex <= beginIndex)
+			{
+				return;
+			}
+
+			const size_t count = (endIndex - beginIndex);
+
+			ISiv3DThreadPool* pool = (Siv3DEngine::isActive() ? SIV3D_ENGINE(ThreadPool) : nullptr);
+
+			const size_t numWorkers = (pool ? pool->getWorkerCount() : 0);
+
+			if (grainSize == 0)
+			{
+				grainSize = Max<size_t>(1, (count / ((numWorkers + 1) * ChunksPerThread)));
+			}
+
+			if ((numWorkers == 0) || (count <= grainSize))
+			{
+				f(context, beginIndex, endIndex);
+				return;
+			}
+
+			const size_t numChunks = ((count + (grainSize - 1)) / grainSize);
+
+			const size_t numHelpers = Min(numWorkers, (numChunks - 1));
+
+			ParallelForState state;
+			state.next			= beginIndex;
+			state.endIndex		= endIndex;
+			state.grainSize		= grainSize;
+			state.function		= f;
+			state.context		= context;
+			state.activeHelpers	= numHelpers;
+
+			for (size_t i = 0; i < numHelpers; ++i)
+			{
+				pool->submit([&state]()
+				{
+					state.run();
+					state.activeHelpers.fetch_sub(1, std::memory_order_release);
+				});
+			}
+
+			// 呼び出し元のスレッドも処理に参加する
+			state.run();
+
+			// まだ開始されていない補助タスクは、ここで取り出して即座に終わらせる
+			while (state.activeHelpers.load(std::memory_order_acquire) != 0)
+			{
+				if (not pool->tryRunPendingTask())
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			if (state.exception)
+			{
+				std::rethrow_exception(state.exception);
+			}
+		}
+	}
+}
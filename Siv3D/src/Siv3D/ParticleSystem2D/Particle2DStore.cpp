@@ -0,0 +1,231 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <algorithm>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/ParallelFor.hpp>
+# include "Particle2DStore.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 並列に更新するときの、1 タスクあたりのパーティクル数
+		inline constexpr size_t ParticleUpdateGrainSize = (64 * 1024);
+
+		struct ParticleUpdateColumns
+		{
+			float* pPositionX;
+			float* pPositionY;
+			float* pVelocityX;
+			float* pVelocityY;
+			float* pRotation;
+			const float* pStartAngularVelocity;
+			float* pRemainingLifeTime;
+		};
+
+		// Particle2D::update() と同じ順序で計算する
+		static void UpdateParticles(const ParticleUpdateColumns& columns, const size_t first, const size_t last, const float deltaTime, const Float2& deltaVelocity) noexcept
+		{
+			const __m128 dt		= _mm_set1_ps(deltaTime);
+			const __m128 dvx	= _mm_set1_ps(deltaVelocity.x);
+			const __m128 dvy	= _mm_set1_ps(deltaVelocity.y);
+
+			size_t i = first;
+
+			for (; (i + 4) <= last; i += 4)
+			{
+				_mm_storeu_ps((columns.pRemainingLifeTime + i), _mm_sub_ps(_mm_loadu_ps(columns.pRemainingLifeTime + i), dt));
+
+				const __m128 vx = _mm_add_ps(_mm_loadu_ps(columns.pVelocityX + i), dvx);
+				const __m128 vy = _mm_add_ps(_mm_loadu_ps(columns.pVelocityY + i), dvy);
+				_mm_storeu_ps((columns.pVelocityX + i), vx);
+				_mm_storeu_ps((columns.pVelocityY + i), vy);
+
+				_mm_storeu_ps((columns.pPositionX + i), _mm_add_ps(_mm_loadu_ps(columns.pPositionX + i), _mm_mul_ps(vx, dt)));
+				_mm_storeu_ps((columns.pPositionY + i), _mm_add_ps(_mm_loadu_ps(columns.pPositionY + i), _mm_mul_ps(vy, dt)));
+
+				_mm_storeu_ps((columns.pRotation + i), _mm_add_ps(_mm_loadu_ps(columns.pRotation + i), _mm_mul_ps(_mm_loadu_ps(columns.pStartAngularVelocity + i), dt)));
+			}
+
+			for (; i < last; ++i)
+			{
+				columns.pRemainingLifeTime[i] -= deltaTime;
+				columns.pVelocityX[i] += deltaVelocity.x;
+				columns.pVelocityY[i] += deltaVelocity.y;
+				columns.pPositionX[i] += (columns.pVelocityX[i] * deltaTime);
+				columns.pPositionY[i] += (columns.pVelocityY[i] * deltaTime);
+				columns.pRotation[i] += (columns.pStartAngularVelocity[i] * deltaTime);
+			}
+		}
+
+		template <class Type>
+		static void SwapAndPop(Array<Type>& column, const size_t index) noexcept
+		{
+			column[index] = column.back();
+			column.pop_back();
+		}
+	}
+
+	size_t Particle2DStore::size() const noexcept
+	{
+		return m_remainingLifeTime.size();
+	}
+
+	bool Particle2DStore::isEmpty() const noexcept
+	{
+		return m_remainingLifeTime.isEmpty();
+	}
+
+	void Particle2DStore::clear() noexcept
+	{
+		m_positionX.clear();
+		m_positionY.clear();
+		m_velocityX.clear();
+		m_velocityY.clear();
+		m_rotation.clear();
+		m_startAngularVelocity.clear();
+		m_remainingLifeTime.clear();
+		m_startColor.clear();
+		m_startSize.clear();
+		m_startLifeTime.clear();
+	}
+
+	void Particle2DStore::push_back(const Particle2D& particle)
+	{
+		m_positionX.push_back(particle.position.x);
+		m_positionY.push_back(particle.position.y);
+		m_velocityX.push_back(particle.velocity.x);
+		m_velocityY.push_back(particle.velocity.y);
+		m_rotation.push_back(particle.rotation);
+		m_startAngularVelocity.push_back(particle.startAngularVelocity);
+		m_remainingLifeTime.push_back(particle.remainingLifeTime);
+		m_startColor.push_back(particle.startColor);
+		m_startSize.push_back(particle.startSize);
+		m_startLifeTime.push_back(particle.startLifeTime);
+	}
+
+	void Particle2DStore::update(const float deltaTime, const Float2& deltaVelocity)
+	{
+		if (isEmpty())
+		{
+			return;
+		}
+
+		const detail::ParticleUpdateColumns columns
+		{
+			.pPositionX				= m_positionX.data(),
+			.pPositionY				= m_positionY.data(),
+			.pVelocityX				= m_velocityX.data(),
+			.pVelocityY				= m_velocityY.data(),
+			.pRotation				= m_rotation.data(),
+			.pStartAngularVelocity	= m_startAngularVelocity.data(),
+			.pRemainingLifeTime		= m_remainingLifeTime.data(),
+		};
+
+		ParallelFor(0, size(), [&](const size_t first, const size_t last)
+		{
+			detail::UpdateParticles(columns, first, last, deltaTime, deltaVelocity);
+		}, detail::ParticleUpdateGrainSize);
+
+		removeDead();
+	}
+
+	void Particle2DStore::removeOldest(const size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (size() <= count)
+		{
+			clear();
+			return;
+		}
+
+		// 残り寿命が短い count 個を、最大ヒープを使って探す
+		Array<std::pair<float, size_t>> heap;
+		heap.reserve(count);
+
+		for (size_t i = 0; i < size(); ++i)
+		{
+			const float remainingLifeTime = m_remainingLifeTime[i];
+
+			if (heap.size() < count)
+			{
+				heap.emplace_back(remainingLifeTime, i);
+				std::push_heap(heap.begin(), heap.end());
+			}
+			else if (remainingLifeTime < heap.front().first)
+			{
+				std::pop_heap(heap.begin(), heap.end());
+				heap.back() = { remainingLifeTime, i };
+				std::push_heap(heap.begin(), heap.end());
+			}
+		}
+
+		// 後ろから取り除けば、末尾から移動してくる要素が取り除く対象になることはない
+		std::sort(heap.begin(), heap.end(), [](const auto& a, const auto& b) { return (a.second > b.second); });
+
+		for (const auto& [remainingLifeTime, index] : heap)
+		{
+			removeAt(index);
+		}
+	}
+
+	void Particle2DStore::removeAt(const size_t index) noexcept
+	{
+		detail::SwapAndPop(m_positionX, index);
+		detail::SwapAndPop(m_positionY, index);
+		detail::SwapAndPop(m_velocityX, index);
+		detail::SwapAndPop(m_velocityY, index);
+		detail::SwapAndPop(m_rotation, index);
+		detail::SwapAndPop(m_startAngularVelocity, index);
+		detail::SwapAndPop(m_remainingLifeTime, index);
+		detail::SwapAndPop(m_startColor, index);
+		detail::SwapAndPop(m_startSize, index);
+		detail::SwapAndPop(m_startLifeTime, index);
+	}
+
+	void Particle2DStore::removeDead() noexcept
+	{
+		const __m128 zero = _mm_setzero_ps();
+
+		size_t i = 0;
+
+		while (i < size())
+		{
+			// 4 個ずつ調べ、寿命が尽きたものが無ければ読み飛ばす
+			if ((i + 4) <= size())
+			{
+				const int32 mask = _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(m_remainingLifeTime.data() + i), zero));
+
+				if (mask == 0)
+				{
+					i += 4;
+					continue;
+				}
+			}
+
+			// Particle2D::isDead() と同じ判定
+			if (m_remainingLifeTime[i] < 0.0f)
+			{
+				// 末尾から移動してきた要素は、次のループで改めて調べる
+				removeAt(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+}
@@ -0,0 +1,86 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/Particle2D.hpp>
+
+namespace s3d
+{
+	/// @brief 2D パーティクルを、メンバごとの配列 (SoA) で保持するクラス
+	/// @remark 死んだパーティクルは末尾の要素と入れ替えて取り除くため、要素の順序は保たれません。
+	class Particle2DStore
+	{
+	public:
+
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		void clear() noexcept;
+
+		void push_back(const Particle2D& particle);
+
+		/// @brief すべてのパーティクルを deltaTime だけ進め、寿命が尽きたものを取り除きます。
+		/// @param deltaTime 経過時間（秒）
+		/// @param deltaVelocity この間に加わる速度
+		void update(float deltaTime, const Float2& deltaVelocity);
+
+		/// @brief 残り寿命が短いものから順に、パーティクルを count 個取り除きます。
+		/// @param count 取り除く個数
+		void removeOldest(size_t count);
+
+		[[nodiscard]]
+		const float* positionX() const noexcept { return m_positionX.data(); }
+
+		[[nodiscard]]
+		const float* positionY() const noexcept { return m_positionY.data(); }
+
+		[[nodiscard]]
+		const float* rotation() const noexcept { return m_rotation.data(); }
+
+		[[nodiscard]]
+		const Float4* startColor() const noexcept { return m_startColor.data(); }
+
+		[[nodiscard]]
+		const float* startSize() const noexcept { return m_startSize.data(); }
+
+		[[nodiscard]]
+		const float* startLifeTime() const noexcept { return m_startLifeTime.data(); }
+
+		[[nodiscard]]
+		const float* remainingLifeTime() const noexcept { return m_remainingLifeTime.data(); }
+
+	private:
+
+		// update() で毎フレーム書き換えられる列
+		Array<float> m_positionX;
+		Array<float> m_positionY;
+		Array<float> m_velocityX;
+		Array<float> m_velocityY;
+		Array<float> m_rotation;
+		Array<float> m_startAngularVelocity;
+		Array<float> m_remainingLifeTime;
+
+		// 描画のときだけ読まれる列
+		Array<Float4> m_startColor;
+		Array<float> m_startSize;
+		Array<float> m_startLifeTime;
+
+		void removeAt(size_t index) noexcept;
+
+		void removeDead() noexcept;
+	};
+}
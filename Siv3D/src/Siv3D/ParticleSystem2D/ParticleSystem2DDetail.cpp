@@ -146,12 +146,7 @@ namespace s3d
 	{
 		const Float2 deltaVelocity = (m_force * deltaTime);
 
-		for (auto& particle : m_particles)
-		{
-			particle.update(deltaTime, deltaVelocity);
-		}
-
-		m_particles.remove_if([](const Particle2D& p) { return p.isDead(); });
+		m_particles.update(deltaTime, deltaVelocity);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::addParticles(const ParticleSystem2DParameters& params)
@@ -183,12 +178,12 @@ namespace s3d
 
 			const float perParticledeltaTime = (particle.startLifeTime - particle.remainingLifeTime);
 			particle.advance(perParticledeltaTime, m_force * perParticledeltaTime);
-			m_particles << particle;
+			m_particles.push_back(particle);
 		}
 
 		if (const size_t maxParticles = static_cast<size_t>(params.maxParticles); m_particles.size() > maxParticles)
 		{
-			m_particles.erase(m_particles.begin(), m_particles.begin() + (m_particles.size() - maxParticles));
+			m_particles.removeOldest(m_particles.size() - maxParticles);
 		}
 	}
 
@@ -199,25 +194,23 @@ namespace s3d
 		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
 			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
 
-		for (const auto& particle : m_particles)
+		for (size_t i = 0; i < m_particles.size(); ++i)
 		{
-			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+			const float startLifeTime = m_particles.startLifeTime()[i];
+			const float remainingLifeTime = m_particles.remainingLifeTime()[i];
+			const float size = sizeOverLifeTimeFunc(m_particles.startSize()[i], startLifeTime, remainingLifeTime);
+			const Float4 color = colorOverLifeTimeFunc(m_particles.startColor()[i], startLifeTime, remainingLifeTime);
 
-			RectF{ Arg::center = particle.position, size }
-				.rotated(particle.rotation)
+			RectF{ Arg::center = Float2{ m_particles.positionX()[i], m_particles.positionY()[i] }, size }
+				.rotated(m_particles.rotation()[i])
 				.draw(ColorF{ color });
 		}
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawTexturedParticle() const
 	{
-		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
-			m_parameters.sizeOverLifeTimeFunc ? m_parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
-		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
-			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
-
-		SIV3D_ENGINE(Renderer2D)->addTexturedParticles(m_particleTexture, m_particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc);
+		// 空の関数を渡すと、頂点の生成時に既定の関数がインライン展開される
+		SIV3D_ENGINE(Renderer2D)->addTexturedParticles(m_particleTexture, m_particles, m_parameters.sizeOverLifeTimeFunc, m_parameters.colorOverLifeTimeFunc);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawDebugParticle() const
@@ -227,13 +220,15 @@ namespace s3d
 		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
 			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
 
-		for (const auto& particle : m_particles)
+		for (size_t i = 0; i < m_particles.size(); ++i)
 		{
-			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+			const float startLifeTime = m_particles.startLifeTime()[i];
+			const float remainingLifeTime = m_particles.remainingLifeTime()[i];
+			const float size = sizeOverLifeTimeFunc(m_particles.startSize()[i], startLifeTime, remainingLifeTime);
+			const Float4 color = colorOverLifeTimeFunc(m_particles.startColor()[i], startLifeTime, remainingLifeTime);
 
-			RectF{ Arg::center = particle.position, size }
-				.rotated(particle.rotation)
+			RectF{ Arg::center = Float2{ m_particles.positionX()[i], m_particles.positionY()[i] }, size }
+				.rotated(m_particles.rotation()[i])
 				.drawFrame(1, ColorF{ color });
 		}
 	}
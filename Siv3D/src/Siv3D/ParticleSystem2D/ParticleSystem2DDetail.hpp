@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/ParticleSystem2D.hpp>
 # include <Siv3D/Particle2D.hpp>
+# include "Particle2DStore.hpp"
 
 namespace s3d
 {
@@ -50,7 +51,7 @@ namespace s3d
 
 	private:
 
-		Array<Particle2D> m_particles;
+		Particle2DStore m_particles;
 		double m_remainingTime = 0.0;
 
 		Vec2 m_position = Vec2(0, 0);
@@ -0,0 +1,205 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/PerlinNoise.hpp>
+# include <Siv3D/Grid.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/ParallelFor.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		template <class Fty>
+		static void ForEachRow(const size_t height, const Parallel parallel, Fty f)
+		{
+			if (parallel)
+			{
+				ParallelFor(0, height, f);
+				return;
+			}
+
+			for (size_t y = 0; y < height; ++y)
+			{
+				f(y);
+			}
+		}
+	}
+
+	template <class Float>
+	void BasicPerlinNoise<Float>::fill(Grid<value_type>& dst, const Rect& region, const value_type frequency, const int32 octaves, const value_type persistence, const Parallel parallel) const
+	{
+		dst.resize(Max(region.w, 0), Max(region.h, 0));
+
+		detail::ForEachRow(dst.height(), parallel, [&](const size_t y)
+		{
+			fillRow2D(dst[y], dst.width(), region.x, (region.y + static_cast<int32>(y)), frequency, octaves, persistence);
+		});
+	}
+
+	template <class Float>
+	void BasicPerlinNoise<Float>::fill(Image& dst, const Rect& region, const value_type frequency, const int32 octaves, const value_type persistence, const Parallel parallel) const
+	{
+		dst.resize(Max(region.w, 0), Max(region.h, 0));
+
+		detail::ForEachRow(dst.height(), parallel, [&](const size_t y)
+		{
+			constexpr size_t ChunkSize = (RowBlockSize * 8);
+			value_type values[ChunkSize];
+			Color* pDst = dst[y];
+			const size_t width = dst.width();
+
+			for (size_t x = 0; x < width; x += ChunkSize)
+			{
+				const size_t count = Min(ChunkSize, (width - x));
+
+				fillRow2D(values, count, (region.x + static_cast<int32>(x)), (region.y + static_cast<int32>(y)), frequency, octaves, persistence);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					const value_type value = Min(Max(values[i], value_type(0)), value_type(1));
+
+					*pDst++ = Color{ static_cast<uint8>(value * 255) };
+				}
+			}
+		});
+	}
+
+	template <class Float>
+	void BasicPerlinNoise<Float>::addRow2D(value_type* dst, const size_t count, const int32 beginX, const value_type frequency, const value_type scale, const value_type y, const value_type amplitude) const noexcept
+	{
+		// y と z は行の中で一定なので、先に計算しておく
+		const value_type z = static_cast<value_type>(0.12345678901234567890); // noise2D() と同じ値
+
+		const value_type _y = std::floor(y);
+		const value_type _z = std::floor(z);
+
+		const std::int32_t iy = static_cast<std::int32_t>(_y) & 255;
+		const std::int32_t iz = static_cast<std::int32_t>(_z) & 255;
+
+		const value_type fy = (y - _y);
+		const value_type fz = (z - _z);
+
+		const value_type v = Fade(fy);
+		const value_type w = Fade(fz);
+
+		// y, z が一定のとき Grad(hash, x, y, z) は (gradX[hash] * x + gradYZ[hash]) になる
+		value_type gradX[16];
+		value_type gradYZ[4][16];
+
+		for (uint8 h = 0; h < 16; ++h)
+		{
+			gradX[h] = Grad(h, 1, 0, 0);
+			gradYZ[0][h] = Grad(h, 0, fy, fz);
+			gradYZ[1][h] = Grad(h, 0, (fy - 1), fz);
+			gradYZ[2][h] = Grad(h, 0, fy, (fz - 1));
+			gradYZ[3][h] = Grad(h, 0, (fy - 1), (fz - 1));
+		}
+
+		std::int32_t ix[RowBlockSize];
+		value_type fx[RowBlockSize];
+		value_type gx[8][RowBlockSize];
+		value_type gyz[8][RowBlockSize];
+		value_type result[RowBlockSize];
+
+		// 各段のループはブロック全体を処理し、ベクトル化しやすくする（末尾の余分なサンプルは捨てる）
+		for (size_t begin = 0; begin < count; begin += RowBlockSize)
+		{
+			for (size_t i = 0; i < RowBlockSize; ++i)
+			{
+				const value_type x = (static_cast<value_type>(beginX + static_cast<int32>(begin + i)) * frequency * scale);
+				const value_type _x = std::floor(x);
+
+				ix[i] = static_cast<std::int32_t>(_x) & 255;
+				fx[i] = (x - _x);
+			}
+
+			// 順列表の参照
+			for (size_t i = 0; i < RowBlockSize; ++i)
+			{
+				const std::uint8_t A = (m_perm[ix[i]] + iy) & 255;
+				const std::uint8_t B = (m_perm[(ix[i] + 1) & 255] + iy) & 255;
+
+				const std::uint8_t AA = (m_perm[A] + iz) & 255;
+				const std::uint8_t AB = (m_perm[(A + 1) & 255] + iz) & 255;
+
+				const std::uint8_t BA = (m_perm[B] + iz) & 255;
+				const std::uint8_t BB = (m_perm[(B + 1) & 255] + iz) & 255;
+
+				const std::uint8_t hashes[8] =
+				{
+					m_perm[AA], m_perm[BA], m_perm[AB], m_perm[BB],
+					m_perm[(AA + 1) & 255], m_perm[(BA + 1) & 255], m_perm[(AB + 1) & 255], m_perm[(BB + 1) & 255],
+				};
+
+				for (size_t k = 0; k < 8; ++k)
+				{
+					const std::uint8_t h = (hashes[k] & 15);
+					gx[k][i] = gradX[h];
+					gyz[k][i] = gradYZ[k >> 1][h];
+				}
+			}
+
+			// 勾配と補間
+			for (size_t i = 0; i < RowBlockSize; ++i)
+			{
+				const value_type x0 = fx[i];
+				const value_type x1 = (fx[i] - 1);
+				const value_type u = Fade(x0);
+
+				const value_type q0 = Lerp((gx[0][i] * x0 + gyz[0][i]), (gx[1][i] * x1 + gyz[1][i]), u);
+				const value_type q1 = Lerp((gx[2][i] * x0 + gyz[2][i]), (gx[3][i] * x1 + gyz[3][i]), u);
+				const value_type q2 = Lerp((gx[4][i] * x0 + gyz[4][i]), (gx[5][i] * x1 + gyz[5][i]), u);
+				const value_type q3 = Lerp((gx[6][i] * x0 + gyz[6][i]), (gx[7][i] * x1 + gyz[7][i]), u);
+
+				const value_type r0 = Lerp(q0, q1, v);
+				const value_type r1 = Lerp(q2, q3, v);
+
+				result[i] = (Lerp(r0, r1, w) * amplitude);
+			}
+
+			const size_t n = Min(RowBlockSize, (count - begin));
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				dst[begin + i] += result[i];
+			}
+		}
+	}
+
+	template <class Float>
+	void BasicPerlinNoise<Float>::fillRow2D(value_type* dst, const size_t count, const int32 beginX, const int32 y, const value_type frequency, const int32 octaves, const value_type persistence) const noexcept
+	{
+		std::fill_n(dst, count, value_type(0));
+
+		// Noise::Octave2D() と同じ順で加算する
+		value_type scale = 1;
+		value_type amplitude = 1;
+
+		for (int32 i = 0; i < octaves; ++i)
+		{
+			addRow2D(dst, count, beginX, frequency, scale, (static_cast<value_type>(y) * frequency * scale), amplitude);
+			scale *= 2;
+			amplitude *= persistence;
+		}
+
+		const value_type maxAmplitude = Noise::MaxAmplitude(octaves, persistence);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst[i] = Noise::To01(dst[i] / maxAmplitude);
+		}
+	}
+
+	template class BasicPerlinNoise<float>;
+	template class BasicPerlinNoise<double>;
+}
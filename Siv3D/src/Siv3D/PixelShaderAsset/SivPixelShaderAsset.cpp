@@ -222,7 +222,7 @@ namespace s3d
 
 	//void PixelShaderAsset::LoadAsync(const AssetNameView name)
 	//{
-	//	SIV3D_ENGINE(Asset)->loadAsync(AssetType::PixelShader, name, {});
+	//	SIV3D_ENGINE(Asset)->loadAsync(AssetType::PixelShader, name, {}, AssetLoadPriority::Normal);
 	//}
 
 	//void PixelShaderAsset::Wait(const AssetNameView name)
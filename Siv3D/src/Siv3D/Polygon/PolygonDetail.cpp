@@ -276,6 +276,8 @@ namespace s3d
 		}
 
 		m_boundingRect.moveBy(v);
+
+		m_spatialIndex.moveBy(v);
 	}
 
 	void Polygon::PolygonDetail::rotateAt(const Vec2 pos, const double angle)
@@ -370,6 +372,8 @@ namespace s3d
 		}
 
 		m_boundingRect = detail::CalculateBoundingRect(m_polygon.outer().data(), m_polygon.outer().size());
+
+		m_spatialIndex.reset();
 	}
 
 	void Polygon::PolygonDetail::transform(const double s, const double c, const Vec2& pos)
@@ -417,6 +421,8 @@ namespace s3d
 		}
 
 		m_boundingRect = detail::CalculateBoundingRect(m_polygon.outer().data(), m_polygon.outer().size());
+
+		m_spatialIndex.reset();
 	}
 
 	void Polygon::PolygonDetail::scale(const double s)
@@ -455,6 +461,8 @@ namespace s3d
 		}
 
 		m_boundingRect = m_boundingRect.scaledAt(Vec2{ 0, 0 }, s);
+
+		m_spatialIndex.reset();
 	}
 
 	void Polygon::PolygonDetail::scale(const Vec2 s)
@@ -493,6 +501,8 @@ namespace s3d
 		}
 
 		m_boundingRect = m_boundingRect.scaledAt(Vec2{ 0, 0 }, s);
+
+		m_spatialIndex.reset();
 	}
 
 	void Polygon::PolygonDetail::scaleAt(const Vec2 pos, const double s)
@@ -532,6 +542,8 @@ namespace s3d
 		}
 
 		m_boundingRect = m_boundingRect.scaledAt(pos, s);
+
+		m_spatialIndex.reset();
 	}
 
 	void Polygon::PolygonDetail::scaleAt(const Vec2 pos, const Vec2 s)
@@ -571,6 +583,8 @@ namespace s3d
 		}
 
 		m_boundingRect = m_boundingRect.scaledAt(pos, s);
+
+		m_spatialIndex.reset();
 	}
 
 	double Polygon::PolygonDetail::area() const noexcept
@@ -889,19 +903,10 @@ namespace s3d
 			return false;
 		}
 
-		const Float2* pVertex = m_vertices.data();
-
-		for (const auto& triangleIndex : m_indices)
-		{
-			const Triangle triangle{ pVertex[triangleIndex.i0], pVertex[triangleIndex.i1], pVertex[triangleIndex.i2] };
-
-			if (Geometry2D::Intersect(other, triangle))
+		return anyTriangle(other.boundingRect(), [&other](const Triangle& triangle)
 			{
-				return true;
-			}
-		}
-
-		return false;
+				return Geometry2D::Intersect(other, triangle);
+			});
 	}
 
 	bool Polygon::PolygonDetail::intersects(const RectF& other) const
@@ -912,6 +917,14 @@ namespace s3d
 			return false;
 		}
 
+		if (spatialIndex())
+		{
+			return anyTriangle(other, [&other](const Triangle& triangle)
+				{
+					return Geometry2D::Intersect(other, triangle);
+				});
+		}
+
 		const boost::geometry::model::box<Vec2> box{ other.pos, other.br() };
 
 		return boost::geometry::intersects(m_polygon, box);
@@ -1017,6 +1030,16 @@ namespace s3d
 	{
 		return m_polygon;
 	}
+
+	const detail::PolygonSpatialIndex* Polygon::PolygonDetail::spatialIndex() const
+	{
+		if (m_indices.size() < detail::PolygonSpatialIndex::MinTriangles)
+		{
+			return nullptr;
+		}
+
+		return &m_spatialIndex.get(m_vertices, m_indices, outer(), m_holes);
+	}
 }
 
 
@@ -35,6 +35,7 @@ SIV3D_DISABLE_MSVC_WARNINGS_POP()
 # include <boost/geometry/geometries/register/point.hpp>
 # include <Siv3D/Polygon.hpp>
 # include <Siv3D/2DShapes.hpp>
+# include "PolygonSpatialIndex.hpp"
 
 # ifdef __GNUC__
 #	pragma GCC diagnostic push
@@ -69,6 +70,12 @@ namespace s3d
 
 		RectF m_boundingRect = RectF::Empty();
 
+		// 三角形の数が多い場合に、交差判定で最初に必要になったときに作成する
+		detail::PolygonSpatialIndexCache m_spatialIndex;
+
+		[[nodiscard]]
+		const detail::PolygonSpatialIndex* spatialIndex() const;
+
 	public:
 
 		PolygonDetail();
@@ -134,6 +141,16 @@ namespace s3d
 
 		bool intersects(const PolygonDetail& other) const;
 
+		/// @brief `region` と交差する可能性がある三角形について、`f` が true を返すまで `f` を呼びます。
+		/// @return `f` が true を返した場合 true, それ以外の場合は false
+		template <class Fty>
+		bool anyTriangle(const RectF& region, Fty f) const;
+
+		/// @brief `region` と交差する可能性がある辺について、穴、外周の順に、`f` が true を返すまで `f(begin, end)` を呼びます。
+		/// @return `f` が true を返した場合 true, それ以外の場合は false
+		template <class Fty>
+		bool anyEdge(const RectF& region, Fty f) const;
+
 
 		void draw(const ColorF& color) const;
 
@@ -147,4 +164,80 @@ namespace s3d
 
 		const CwOpenPolygon& getPolygon() const noexcept;
 	};
+
+	template <class Fty>
+	inline bool Polygon::PolygonDetail::anyTriangle(const RectF& region, Fty f) const
+	{
+		const Float2* pVertex = m_vertices.data();
+
+		if (const auto index = spatialIndex())
+		{
+			return index->anyTriangle(region, [&](const uint32 i)
+				{
+					const TriangleIndex& triangleIndex = m_indices[i];
+					return f(Triangle{ pVertex[triangleIndex.i0], pVertex[triangleIndex.i1], pVertex[triangleIndex.i2] });
+				});
+		}
+
+		for (const auto& triangleIndex : m_indices)
+		{
+			if (f(Triangle{ pVertex[triangleIndex.i0], pVertex[triangleIndex.i1], pVertex[triangleIndex.i2] }))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <class Fty>
+	inline bool Polygon::PolygonDetail::anyEdge(const RectF& region, Fty f) const
+	{
+		if (const auto index = spatialIndex())
+		{
+			Array<uint32> edges;
+
+			index->getEdges(region, edges);
+
+			for (const auto edge : edges)
+			{
+				const size_t ring = index->edgeRing(edge);
+				const Array<Vec2>& points = ((ring < m_holes.size()) ? m_holes[ring] : outer());
+				const size_t i = index->edgeBegin(edge);
+
+				if (f(points[i], points[(i + 1) % points.size()]))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		for (const auto& hole : m_holes)
+		{
+			const size_t holeSize = hole.size();
+
+			for (size_t i = 0; i < holeSize; ++i)
+			{
+				if (f(hole[i], hole[(i + 1) % holeSize]))
+				{
+					return true;
+				}
+			}
+		}
+
+		const Array<Vec2>& points = outer();
+		const size_t outerSize = points.size();
+
+		for (size_t i = 0; i < outerSize; ++i)
+		{
+			if (f(points[i], points[(i + 1) % outerSize]))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
 }
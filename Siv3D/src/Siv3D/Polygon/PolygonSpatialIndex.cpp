@@ -0,0 +1,378 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <numeric>
+# include <Siv3D/Utility.hpp>
+# include "PolygonSpatialIndex.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		////////////////////////////////////////////////////////////////
+		//
+		//	AABBTree
+		//
+		////////////////////////////////////////////////////////////////
+
+		void AABBTree::build(const Array<Box>& boxes)
+		{
+			m_nodes.clear();
+			m_items.clear();
+
+			if (boxes.isEmpty())
+			{
+				return;
+			}
+
+			const uint32 count = static_cast<uint32>(boxes.size());
+
+			m_items.resize(count);
+			std::iota(m_items.begin(), m_items.end(), 0u);
+
+			Array<Float2> centers(Arg::reserve = count);
+
+			for (const auto& box : boxes)
+			{
+				centers.emplace_back(((box.minX + box.maxX) * 0.5f), ((box.minY + box.maxY) * 0.5f));
+			}
+
+			m_nodes.reserve(((count / LeafSize) + 1) * 2);
+			m_nodes.emplace_back();
+
+			build(boxes, centers, 0, 0, count, 0);
+		}
+
+		void AABBTree::build(const Array<Box>& boxes, const Array<Float2>& centers, const uint32 nodeIndex, const uint32 begin, const uint32 end, const size_t depth)
+		{
+			Box box = boxes[m_items[begin]];
+			Float2 centerMin = centers[m_items[begin]];
+			Float2 centerMax = centerMin;
+
+			for (uint32 i = (begin + 1); i < end; ++i)
+			{
+				const Box& b = boxes[m_items[i]];
+				box.minX = Min(box.minX, b.minX);
+				box.minY = Min(box.minY, b.minY);
+				box.maxX = Max(box.maxX, b.maxX);
+				box.maxY = Max(box.maxY, b.maxY);
+
+				const Float2& c = centers[m_items[i]];
+				centerMin.x = Min(centerMin.x, c.x);
+				centerMin.y = Min(centerMin.y, c.y);
+				centerMax.x = Max(centerMax.x, c.x);
+				centerMax.y = Max(centerMax.y, c.y);
+			}
+
+			if (((end - begin) <= LeafSize) || (depth == MaxDepth))
+			{
+				m_nodes[nodeIndex] = { box, begin, (end - begin) };
+				return;
+			}
+
+			// 中心の広がりが大きい軸で、要素の数が半分になるように分ける
+			const bool splitX = ((centerMax.y - centerMin.y) <= (centerMax.x - centerMin.x));
+			const uint32 mid = (begin + (end - begin) / 2);
+
+			std::nth_element((m_items.begin() + begin), (m_items.begin() + mid), (m_items.begin() + end),
+				[&centers, splitX](const uint32 a, const uint32 b)
+				{
+					return (splitX ? (centers[a].x < centers[b].x) : (centers[a].y < centers[b].y));
+				});
+
+			const uint32 left = static_cast<uint32>(m_nodes.size());
+			m_nodes.emplace_back();
+			m_nodes.emplace_back();
+			m_nodes[nodeIndex] = { box, left, 0 };
+
+			build(boxes, centers, left, begin, mid, (depth + 1));
+			build(boxes, centers, (left + 1), mid, end, (depth + 1));
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	PolygonSpatialIndex
+		//
+		////////////////////////////////////////////////////////////////
+
+		PolygonSpatialIndex::PolygonSpatialIndex(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<Vec2>& outer, const Array<Array<Vec2>>& inners)
+		{
+			{
+				Array<AABBTree::Box> boxes(Arg::reserve = indices.size());
+
+				for (const auto& triangleIndex : indices)
+				{
+					const Float2& p0 = vertices[triangleIndex.i0];
+					const Float2& p1 = vertices[triangleIndex.i1];
+					const Float2& p2 = vertices[triangleIndex.i2];
+
+					boxes.push_back({ Min({ p0.x, p1.x, p2.x }), Min({ p0.y, p1.y, p2.y }),
+						Max({ p0.x, p1.x, p2.x }), Max({ p0.y, p1.y, p2.y }) });
+				}
+
+				m_triangles.build(boxes);
+			}
+
+			{
+				Array<AABBTree::Box> boxes;
+
+				const auto addRing = [&](const Array<Vec2>& ring)
+				{
+					m_ringOffsets << static_cast<uint32>(boxes.size());
+
+					const size_t ringSize = ring.size();
+
+					for (size_t i = 0; i < ringSize; ++i)
+					{
+						const Vec2& p0 = ring[i];
+						const Vec2& p1 = ring[((i + 1) % ringSize)];
+
+						boxes.push_back({ static_cast<float>(Min(p0.x, p1.x)), static_cast<float>(Min(p0.y, p1.y)),
+							static_cast<float>(Max(p0.x, p1.x)), static_cast<float>(Max(p0.y, p1.y)) });
+					}
+				};
+
+				for (const auto& inner : inners)
+				{
+					addRing(inner);
+				}
+
+				addRing(outer);
+
+				m_ringOffsets << static_cast<uint32>(boxes.size());
+
+				m_edges.build(boxes);
+			}
+
+			double extent = 0.0;
+
+			for (const auto& point : outer)
+			{
+				extent = Max({ extent, Abs(point.x), Abs(point.y) });
+			}
+
+			// float に丸めた誤差と、平行移動で積み重なる誤差よりも十分に大きくとる
+			m_padding = (extent * 1e-5 + 1e-6);
+		}
+
+		void PolygonSpatialIndex::getEdges(const RectF& region, Array<uint32>& edges) const
+		{
+			edges.clear();
+
+			m_edges.any(toLocalBox(region), [&edges](const uint32 edge)
+				{
+					edges << edge;
+					return false;
+				});
+
+			edges.sort();
+		}
+
+		size_t PolygonSpatialIndex::edgeRing(const uint32 edge) const noexcept
+		{
+			return (std::upper_bound(m_ringOffsets.begin(), m_ringOffsets.end(), edge) - m_ringOffsets.begin() - 1);
+		}
+
+		size_t PolygonSpatialIndex::edgeBegin(const uint32 edge) const noexcept
+		{
+			return (edge - m_ringOffsets[edgeRing(edge)]);
+		}
+
+		bool PolygonSpatialIndex::moveBy(const Vec2& v) noexcept
+		{
+			m_translation += v;
+
+			m_padding += (Max(Abs(m_translation.x), Abs(m_translation.y)) * 1e-5);
+
+			return (++m_moves <= MaxMoves);
+		}
+
+		AABBTree::Box PolygonSpatialIndex::toLocalBox(const RectF& region) const noexcept
+		{
+			return{
+				static_cast<float>(region.x - m_translation.x - m_padding),
+				static_cast<float>(region.y - m_translation.y - m_padding),
+				static_cast<float>(region.x + region.w - m_translation.x + m_padding),
+				static_cast<float>(region.y + region.h - m_translation.y + m_padding) };
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	PolygonSpatialIndexCache
+		//
+		////////////////////////////////////////////////////////////////
+
+		PolygonSpatialIndexCache::PolygonSpatialIndexCache(const PolygonSpatialIndexCache&) noexcept {}
+
+		PolygonSpatialIndexCache& PolygonSpatialIndexCache::operator =(const PolygonSpatialIndexCache& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+			}
+
+			return *this;
+		}
+
+		const PolygonSpatialIndex& PolygonSpatialIndexCache::get(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<Vec2>& outer, const Array<Array<Vec2>>& inners) const
+		{
+			if (const PolygonSpatialIndex* index = m_index.load(std::memory_order_acquire))
+			{
+				return *index;
+			}
+
+			std::lock_guard lock{ m_mutex };
+
+			if (not m_owner)
+			{
+				m_owner = std::make_unique<PolygonSpatialIndex>(vertices, indices, outer, inners);
+				m_index.store(m_owner.get(), std::memory_order_release);
+			}
+
+			return *m_owner;
+		}
+
+		void PolygonSpatialIndexCache::moveBy(const Vec2& v) noexcept
+		{
+			if (m_owner && (not m_owner->moveBy(v)))
+			{
+				reset();
+			}
+		}
+
+		void PolygonSpatialIndexCache::reset() noexcept
+		{
+			m_index.store(nullptr, std::memory_order_relaxed);
+			m_owner.reset();
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	MultiPolygonSpatialIndex
+		//
+		////////////////////////////////////////////////////////////////
+
+		MultiPolygonSpatialIndex::MultiPolygonSpatialIndex(const Array<Polygon>& polygons)
+		{
+			Array<AABBTree::Box> boxes(Arg::reserve = polygons.size());
+
+			double extent = 0.0;
+
+			for (const auto& polygon : polygons)
+			{
+				const RectF& rect = polygon.boundingRect();
+
+				boxes.push_back({ static_cast<float>(rect.x), static_cast<float>(rect.y),
+					static_cast<float>(rect.x + rect.w), static_cast<float>(rect.y + rect.h) });
+
+				extent = Max({ extent, Abs(rect.x), Abs(rect.y), Abs(rect.x + rect.w), Abs(rect.y + rect.h) });
+			}
+
+			m_polygons.build(boxes);
+
+			// float に丸めた誤差よりも十分に大きくとる
+			m_padding = (extent * 1e-5 + 1e-6);
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	MultiPolygonSpatialIndexCache
+		//
+		////////////////////////////////////////////////////////////////
+
+		MultiPolygonSpatialIndexCache::MultiPolygonSpatialIndexCache(const MultiPolygonSpatialIndexCache&) noexcept {}
+
+		MultiPolygonSpatialIndexCache& MultiPolygonSpatialIndexCache::operator =(const MultiPolygonSpatialIndexCache& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+			}
+
+			return *this;
+		}
+
+		MultiPolygonSpatialIndexCache::~MultiPolygonSpatialIndexCache()
+		{
+			reset();
+		}
+
+		const MultiPolygonSpatialIndex* MultiPolygonSpatialIndexCache::get(const Array<Polygon>& polygons) const
+		{
+			// 返した参照を通して要素が変更されているかもしれない
+			if (m_mutableAccess)
+			{
+				return nullptr;
+			}
+
+			if (polygons.size() < MultiPolygonSpatialIndex::MinPolygons)
+			{
+				return nullptr;
+			}
+
+			if (const MultiPolygonSpatialIndex* index = m_index.load(std::memory_order_acquire))
+			{
+				return index;
+			}
+
+			// 複数のスレッドが同時に作成した場合は、最初に登録されたものを使う
+			auto index = std::make_unique<MultiPolygonSpatialIndex>(polygons);
+			MultiPolygonSpatialIndex* expected = nullptr;
+
+			if (m_index.compare_exchange_strong(expected, index.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				return index.release();
+			}
+
+			return expected;
+		}
+
+		void MultiPolygonSpatialIndexCache::reset() noexcept
+		{
+			delete m_index.exchange(nullptr, std::memory_order_acq_rel);
+		}
+
+		void MultiPolygonSpatialIndexCache::markMutableAccess() noexcept
+		{
+			reset();
+
+			m_mutableAccess = true;
+		}
+
+		void MultiPolygonSpatialIndexCache::resetMutableAccess() noexcept
+		{
+			reset();
+
+			m_mutableAccess = false;
+		}
+
+		void MultiPolygonSpatialIndexCache::moveFrom(MultiPolygonSpatialIndexCache& other) noexcept
+		{
+			if (this == &other)
+			{
+				return;
+			}
+
+			reset();
+			other.reset();
+
+			m_mutableAccess = std::exchange(other.m_mutableAccess, false);
+		}
+
+		void MultiPolygonSpatialIndexCache::swap(MultiPolygonSpatialIndexCache& other) noexcept
+		{
+			reset();
+			other.reset();
+
+			std::swap(m_mutableAccess, other.m_mutableAccess);
+		}
+	}
+}
@@ -0,0 +1,246 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <atomic>
+# include <mutex>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/TriangleIndex.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/MultiPolygon.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 軸平行境界ボックスの木 (BVH)
+		class AABBTree
+		{
+		public:
+
+			struct Box
+			{
+				float minX;
+
+				float minY;
+
+				float maxX;
+
+				float maxY;
+
+				[[nodiscard]]
+				constexpr bool intersects(const Box& other) const noexcept
+				{
+					return ((minX <= other.maxX) && (other.minX <= maxX)
+						&& (minY <= other.maxY) && (other.minY <= maxY));
+				}
+			};
+
+			void build(const Array<Box>& boxes);
+
+			/// @brief `region` と交差する要素について、`f` が true を返すまで `f` を呼びます。
+			/// @return `f` が true を返した場合 true, それ以外の場合は false
+			template <class Fty>
+			bool any(const Box& region, Fty f) const;
+
+		private:
+
+			static constexpr uint32 LeafSize = 4;
+
+			static constexpr size_t MaxDepth = 64;
+
+			struct Node
+			{
+				Box box;
+
+				// 葉の場合は m_items の先頭、それ以外の場合は左の子ノード（右の子ノードはその次）
+				uint32 first;
+
+				// 0 の場合は葉ではない
+				uint32 count;
+			};
+
+			Array<Node> m_nodes;
+
+			Array<uint32> m_items;
+
+			void build(const Array<Box>& boxes, const Array<Float2>& centers, uint32 nodeIndex, uint32 begin, uint32 end, size_t depth);
+		};
+
+		/// @brief 多角形の三角形と辺の空間インデックス
+		class PolygonSpatialIndex
+		{
+		public:
+
+			// これより三角形の数が少ない多角形では、すべての三角形を順に調べるほうが速い
+			static constexpr size_t MinTriangles = 64;
+
+			PolygonSpatialIndex(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<Vec2>& outer, const Array<Array<Vec2>>& inners);
+
+			/// @brief `region` と境界ボックスが交差する三角形について、`f` が true を返すまで `f` を呼びます。
+			template <class Fty>
+			bool anyTriangle(const RectF& region, Fty f) const;
+
+			/// @brief `region` と境界ボックスが交差する辺の番号を、穴、外周の順に並べて返します。
+			/// @remark 辺の番号は `edgeRing()` と `edgeBegin()` で、リングとその中の頂点に変換できます。
+			void getEdges(const RectF& region, Array<uint32>& edges) const;
+
+			/// @brief 辺が属するリングを返します。
+			/// @return 穴の場合はそのインデックス、外周の場合は穴の数
+			[[nodiscard]]
+			size_t edgeRing(uint32 edge) const noexcept;
+
+			/// @brief 辺の始点の、リング内でのインデックスを返します。
+			[[nodiscard]]
+			size_t edgeBegin(uint32 edge) const noexcept;
+
+			/// @brief 多角形の平行移動に合わせて、インデックスを移動します。
+			/// @return インデックスをそのまま使える場合 true, 作り直すべき場合は false
+			bool moveBy(const Vec2& v) noexcept;
+
+		private:
+
+			// 平行移動を何回まで、作り直さずに済ませるか
+			static constexpr uint32 MaxMoves = 64;
+
+			AABBTree m_triangles;
+
+			AABBTree m_edges;
+
+			// 各リングの最初の辺の番号
+			Array<uint32> m_ringOffsets;
+
+			// 作成後に平行移動した量
+			Vec2 m_translation{ 0, 0 };
+
+			// float の誤差を吸収するために、問い合わせの範囲を広げる量
+			double m_padding = 0.0;
+
+			uint32 m_moves = 0;
+
+			[[nodiscard]]
+			AABBTree::Box toLocalBox(const RectF& region) const noexcept;
+		};
+
+		/// @brief 多角形の空間インデックスを、必要になったときに作成して保持するクラス
+		/// @remark 複数のスレッドから同時に `get()` を呼べます。多角形を変更する操作とは同時に呼べません。
+		class PolygonSpatialIndexCache
+		{
+		public:
+
+			PolygonSpatialIndexCache() = default;
+
+			// コピーした多角形では、必要になったときに作り直す
+			PolygonSpatialIndexCache(const PolygonSpatialIndexCache&) noexcept;
+
+			PolygonSpatialIndexCache& operator =(const PolygonSpatialIndexCache&) noexcept;
+
+			[[nodiscard]]
+			const PolygonSpatialIndex& get(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Array<Vec2>& outer, const Array<Array<Vec2>>& inners) const;
+
+			void moveBy(const Vec2& v) noexcept;
+
+			void reset() noexcept;
+
+		private:
+
+			mutable std::atomic<const PolygonSpatialIndex*> m_index{ nullptr };
+
+			mutable std::unique_ptr<PolygonSpatialIndex> m_owner;
+
+			mutable std::mutex m_mutex;
+		};
+
+		/// @brief MultiPolygon の各多角形の境界ボックスの空間インデックス
+		class MultiPolygonSpatialIndex
+		{
+		public:
+
+			// これより多角形の数が少ない場合は、すべての多角形を順に調べるほうが速い
+			static constexpr size_t MinPolygons = 16;
+
+			explicit MultiPolygonSpatialIndex(const Array<Polygon>& polygons);
+
+			/// @brief `region` と境界ボックスが交差する多角形の番号について、`f` が true を返すまで `f` を呼びます。
+			template <class Fty>
+			bool anyPolygon(const RectF& region, Fty f) const;
+
+		private:
+
+			AABBTree m_polygons;
+
+			// float の誤差を吸収するために、問い合わせの範囲を広げる量
+			double m_padding = 0.0;
+		};
+
+		template <class Fty>
+		inline bool AABBTree::any(const Box& region, Fty f) const
+		{
+			if (m_nodes.isEmpty())
+			{
+				return false;
+			}
+
+			uint32 stack[MaxDepth + 1];
+			size_t stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while (stackSize)
+			{
+				const Node& node = m_nodes[stack[--stackSize]];
+
+				if (not node.box.intersects(region))
+				{
+					continue;
+				}
+
+				if (node.count)
+				{
+					for (uint32 i = node.first; i < (node.first + node.count); ++i)
+					{
+						if (f(m_items[i]))
+						{
+							return true;
+						}
+					}
+				}
+				else
+				{
+					stack[stackSize++] = (node.first + 1);
+					stack[stackSize++] = node.first;
+				}
+			}
+
+			return false;
+		}
+
+		template <class Fty>
+		inline bool PolygonSpatialIndex::anyTriangle(const RectF& region, Fty f) const
+		{
+			return m_triangles.any(toLocalBox(region), f);
+		}
+
+		template <class Fty>
+		inline bool MultiPolygonSpatialIndex::anyPolygon(const RectF& region, Fty f) const
+		{
+			const AABBTree::Box box{
+				static_cast<float>(region.x - m_padding),
+				static_cast<float>(region.y - m_padding),
+				static_cast<float>(region.x + region.w + m_padding),
+				static_cast<float>(region.y + region.h + m_padding) };
+
+			return m_polygons.any(box, f);
+		}
+	}
+}
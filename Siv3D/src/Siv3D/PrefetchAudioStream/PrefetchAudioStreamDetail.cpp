@@ -0,0 +1,347 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Utility.hpp>
+# include "PrefetchAudioStreamDetail.hpp"
+
+namespace s3d
+{
+	PrefetchAudioStreamDetail::PrefetchAudioStreamDetail(std::unique_ptr<IAudioDecoderStream>&& stream, const Duration& bufferLength)
+		: m_stream{ std::move(stream) }
+	{
+		if (not m_stream)
+		{
+			m_decodeEnded = true;
+			return;
+		}
+
+		m_sampleRate	= m_stream->sampleRate();
+		m_samples		= m_stream->samples();
+		m_capacity		= Max(static_cast<size_t>(bufferLength.count() * m_sampleRate), (DecodeChunkSize * 2));
+
+		m_left.resize(m_capacity);
+		m_right.resize(m_capacity);
+		m_decodeBuffer.resize(DecodeChunkSize);
+
+	# if SIV3D_PREFETCH_AUDIO_THREAD
+
+		m_thread = std::thread{ [this]() { run(); } };
+
+	# endif
+	}
+
+	PrefetchAudioStreamDetail::~PrefetchAudioStreamDetail()
+	{
+	# if SIV3D_PREFETCH_AUDIO_THREAD
+
+		if (m_thread.joinable())
+		{
+			m_abort.store(true, std::memory_order_release);
+			m_cv.notify_one();
+			m_thread.join();
+		}
+
+	# endif
+	}
+
+	bool PrefetchAudioStreamDetail::isOpen() const noexcept
+	{
+		return static_cast<bool>(m_stream);
+	}
+
+	uint32 PrefetchAudioStreamDetail::sampleRate() const noexcept
+	{
+		return m_sampleRate;
+	}
+
+	size_t PrefetchAudioStreamDetail::samples() const noexcept
+	{
+		return m_samples;
+	}
+
+	void PrefetchAudioStreamDetail::setLoop(const bool loop)
+	{
+		m_loop.store(loop, std::memory_order_release);
+
+	# if SIV3D_PREFETCH_AUDIO_THREAD
+
+		// 終端に達して待機している場合に、ループ区間の先頭からデコードを再開させる
+		m_cv.notify_one();
+
+	# endif
+	}
+
+	bool PrefetchAudioStreamDetail::isLoop() const noexcept
+	{
+		return m_loop.load(std::memory_order_acquire);
+	}
+
+	void PrefetchAudioStreamDetail::setLoopBegin(const uint64 loopBegin)
+	{
+		m_loopBegin.store(loopBegin, std::memory_order_release);
+	}
+
+	uint64 PrefetchAudioStreamDetail::posSample() const noexcept
+	{
+		return m_posSample.load(std::memory_order_relaxed);
+	}
+
+	size_t PrefetchAudioStreamDetail::loopCount() const noexcept
+	{
+		return m_loopCount.load(std::memory_order_relaxed);
+	}
+
+	size_t PrefetchAudioStreamDetail::bufferedSamples() const noexcept
+	{
+		if (isSeekPending())
+		{
+			return 0;
+		}
+
+		const uint64 readIndex = m_readIndex.load(std::memory_order_acquire);
+		const uint64 writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+		return static_cast<size_t>(writeIndex - readIndex);
+	}
+
+	size_t PrefetchAudioStreamDetail::underrunCount() const noexcept
+	{
+		return m_underrunCount.load(std::memory_order_relaxed);
+	}
+
+	void PrefetchAudioStreamDetail::getAudio(float* left, float* right, const size_t samplesToWrite)
+	{
+		if ((not m_stream) || isSeekPending())
+		{
+			std::fill_n(left, samplesToWrite, 0.0f);
+			std::fill_n(right, samplesToWrite, 0.0f);
+			return;
+		}
+
+	# if !SIV3D_PREFETCH_AUDIO_THREAD
+
+		// スレッドを使えない環境では、足りない分をここでデコードする
+		while ((bufferedSamples() < samplesToWrite) && produce()) {}
+
+	# endif
+
+		const uint64 readIndex = m_readIndex.load(std::memory_order_relaxed);
+		const uint64 writeIndex = m_writeIndex.load(std::memory_order_acquire);
+		const size_t count = Min(samplesToWrite, static_cast<size_t>(writeIndex - readIndex));
+
+		{
+			const size_t begin = static_cast<size_t>(readIndex % m_capacity);
+			const size_t first = Min(count, (m_capacity - begin));
+
+			std::copy_n((m_left.data() + begin), first, left);
+			std::copy_n((m_right.data() + begin), first, right);
+			std::copy_n(m_left.data(), (count - first), (left + first));
+			std::copy_n(m_right.data(), (count - first), (right + first));
+		}
+
+		// 読み込んだ範囲にあるマーカーから、再生位置を求める
+		{
+			const uint64 endIndex = (readIndex + count);
+			const size_t markerWrite = m_markerWrite.load(std::memory_order_acquire);
+			size_t markerRead = m_markerRead.load(std::memory_order_relaxed);
+			uint64 index = readIndex;
+			uint64 pos = m_posSample.load(std::memory_order_relaxed);
+
+			while ((markerRead != markerWrite)
+				&& (m_markers[markerRead % MaxMarkers].index <= endIndex))
+			{
+				const Marker& marker = m_markers[markerRead % MaxMarkers];
+				index = marker.index;
+				pos = marker.pos;
+
+				if (marker.loop)
+				{
+					m_loopCount.store((m_loopCount.load(std::memory_order_relaxed) + 1), std::memory_order_relaxed);
+				}
+
+				++markerRead;
+			}
+
+			m_markerRead.store(markerRead, std::memory_order_release);
+			m_posSample.store((pos + (endIndex - index)), std::memory_order_relaxed);
+			m_readIndex.store(endIndex, std::memory_order_release);
+		}
+
+		if (count < samplesToWrite)
+		{
+			std::fill((left + count), (left + samplesToWrite), 0.0f);
+			std::fill((right + count), (right + samplesToWrite), 0.0f);
+
+			if (not m_decodeEnded.load(std::memory_order_acquire))
+			{
+				m_underrunCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+	# if SIV3D_PREFETCH_AUDIO_THREAD
+
+		m_cv.notify_one();
+
+	# endif
+	}
+
+	bool PrefetchAudioStreamDetail::hasEnded() const
+	{
+		if (isLoop() || isSeekPending())
+		{
+			return false;
+		}
+
+		if (not m_decodeEnded.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		return (m_readIndex.load(std::memory_order_acquire) == m_writeIndex.load(std::memory_order_acquire));
+	}
+
+	void PrefetchAudioStreamDetail::seek(const uint64 posSample)
+	{
+		if (not m_stream)
+		{
+			return;
+		}
+
+		// すでにその位置にある場合は、先読みしたデータを捨てない
+		if ((not isSeekPending())
+			&& (m_posSample.load(std::memory_order_relaxed) == posSample))
+		{
+			return;
+		}
+
+		m_seekTarget.store(posSample, std::memory_order_relaxed);
+		m_posSample.store(posSample, std::memory_order_relaxed);
+		m_seekRequested.fetch_add(1, std::memory_order_release);
+
+	# if SIV3D_PREFETCH_AUDIO_THREAD
+
+		m_cv.notify_one();
+
+	# else
+
+		processSeek();
+
+	# endif
+	}
+
+# if SIV3D_PREFETCH_AUDIO_THREAD
+
+	void PrefetchAudioStreamDetail::run()
+	{
+		while (not m_abort.load(std::memory_order_acquire))
+		{
+			if (produce())
+			{
+				continue;
+			}
+
+			// 読み込み側はロックせずに通知するため、通知を取りこぼしても一定時間で再確認する
+			std::unique_lock lock{ m_mutex };
+			m_cv.wait_for(lock, std::chrono::milliseconds{ 5 });
+		}
+	}
+
+# endif
+
+	bool PrefetchAudioStreamDetail::isSeekPending() const noexcept
+	{
+		return (m_seekRequested.load(std::memory_order_acquire) != m_seekCompleted.load(std::memory_order_acquire));
+	}
+
+	bool PrefetchAudioStreamDetail::produce()
+	{
+		if (isSeekPending())
+		{
+			processSeek();
+			return true;
+		}
+
+		const uint64 writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		const uint64 readIndex = m_readIndex.load(std::memory_order_acquire);
+		const size_t space = (m_capacity - static_cast<size_t>(writeIndex - readIndex));
+
+		if (space < DecodeChunkSize)
+		{
+			return false;
+		}
+
+		if (not m_decodeEnded.load(std::memory_order_relaxed))
+		{
+			if (const size_t count = m_stream->read(m_decodeBuffer.data(), DecodeChunkSize))
+			{
+				const size_t begin = static_cast<size_t>(writeIndex % m_capacity);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					const size_t index = ((begin + i) < m_capacity) ? (begin + i) : (begin + i - m_capacity);
+					m_left[index] = m_decodeBuffer[i].left;
+					m_right[index] = m_decodeBuffer[i].right;
+				}
+
+				m_justLooped = false;
+				m_writeIndex.store((writeIndex + count), std::memory_order_release);
+				return true;
+			}
+		}
+
+		// 終端に達した
+		if (isLoop() && (not m_justLooped))
+		{
+			// 読み込み側がマーカーを処理するのを待つ
+			if ((m_markerWrite.load(std::memory_order_relaxed) - m_markerRead.load(std::memory_order_acquire)) == MaxMarkers)
+			{
+				return false;
+			}
+
+			const uint64 loopBegin = m_loopBegin.load(std::memory_order_acquire);
+
+			if (m_stream->seek(static_cast<size_t>(loopBegin)))
+			{
+				pushMarker(writeIndex, loopBegin, true);
+				m_justLooped = true;
+				m_decodeEnded.store(false, std::memory_order_release);
+				return true;
+			}
+		}
+
+		m_decodeEnded.store(true, std::memory_order_release);
+		return false;
+	}
+
+	void PrefetchAudioStreamDetail::processSeek()
+	{
+		const uint64 requested = m_seekRequested.load(std::memory_order_acquire);
+		const uint64 target = m_seekTarget.load(std::memory_order_relaxed);
+		const bool succeeded = m_stream->seek(static_cast<size_t>(target));
+
+		// 要求が処理されるまで読み込み側はバッファに触れないため、ここで空にできる
+		const uint64 readIndex = m_readIndex.load(std::memory_order_acquire);
+		m_writeIndex.store(readIndex, std::memory_order_release);
+		m_markerWrite.store(m_markerRead.load(std::memory_order_acquire), std::memory_order_release);
+		pushMarker(readIndex, target, false);
+
+		m_justLooped = false;
+		m_decodeEnded.store((not succeeded), std::memory_order_release);
+		m_seekCompleted.store(requested, std::memory_order_release);
+	}
+
+	void PrefetchAudioStreamDetail::pushMarker(const uint64 index, const uint64 pos, const bool loop)
+	{
+		const size_t markerWrite = m_markerWrite.load(std::memory_order_relaxed);
+		m_markers[markerWrite % MaxMarkers] = { index, pos, loop };
+		m_markerWrite.store((markerWrite + 1), std::memory_order_release);
+	}
+}
@@ -0,0 +1,162 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <array>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <Siv3D/PrefetchAudioStream.hpp>
+# include <Siv3D/Array.hpp>
+
+# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+#	define SIV3D_PREFETCH_AUDIO_THREAD 1
+# else
+#	define SIV3D_PREFETCH_AUDIO_THREAD 0
+# endif
+
+namespace s3d
+{
+	// デコードするスレッド（書き込み側）と、オーディオスレッド（読み込み側）が 1 つずつのリングバッファを使う。
+	//
+	// 再生位置の変更は、読み込み側が要求の番号を増やし、書き込み側がバッファを空にしてから処理済みの番号を更新する。
+	// 要求が処理されるまで、読み込み側は無音を出力する。
+	class PrefetchAudioStreamDetail
+	{
+	public:
+
+		PrefetchAudioStreamDetail(std::unique_ptr<IAudioDecoderStream>&& stream, const Duration& bufferLength);
+
+		~PrefetchAudioStreamDetail();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		uint32 sampleRate() const noexcept;
+
+		[[nodiscard]]
+		size_t samples() const noexcept;
+
+		void setLoop(bool loop);
+
+		[[nodiscard]]
+		bool isLoop() const noexcept;
+
+		void setLoopBegin(uint64 loopBegin);
+
+		[[nodiscard]]
+		uint64 posSample() const noexcept;
+
+		[[nodiscard]]
+		size_t loopCount() const noexcept;
+
+		[[nodiscard]]
+		size_t bufferedSamples() const noexcept;
+
+		[[nodiscard]]
+		size_t underrunCount() const noexcept;
+
+		void getAudio(float* left, float* right, size_t samplesToWrite);
+
+		[[nodiscard]]
+		bool hasEnded() const;
+
+		void seek(uint64 posSample);
+
+	private:
+
+		// 書き込み側の、リングバッファ内の位置と音声の位置の対応
+		struct Marker
+		{
+			uint64 index;
+
+			uint64 pos;
+
+			bool loop;
+		};
+
+		static constexpr size_t MaxMarkers = 32;
+
+		static constexpr size_t DecodeChunkSize = 4096;
+
+		std::unique_ptr<IAudioDecoderStream> m_stream;
+
+		uint32 m_sampleRate = 0;
+
+		size_t m_samples = 0;
+
+		size_t m_capacity = 0;
+
+		Array<float> m_left;
+
+		Array<float> m_right;
+
+		// 書き込み側のみが使う
+		Array<WaveSample> m_decodeBuffer;
+
+		// 書き込み側のみが使う。直前にループしてから 1 サンプルもデコードできていない
+		bool m_justLooped = false;
+
+		std::atomic<uint64> m_writeIndex{ 0 };
+
+		std::atomic<uint64> m_readIndex{ 0 };
+
+		std::array<Marker, MaxMarkers> m_markers{};
+
+		std::atomic<size_t> m_markerWrite{ 0 };
+
+		std::atomic<size_t> m_markerRead{ 0 };
+
+		std::atomic<uint64> m_seekTarget{ 0 };
+
+		std::atomic<uint64> m_seekRequested{ 0 };
+
+		std::atomic<uint64> m_seekCompleted{ 0 };
+
+		std::atomic<bool> m_loop{ false };
+
+		std::atomic<uint64> m_loopBegin{ 0 };
+
+		std::atomic<bool> m_decodeEnded{ false };
+
+		std::atomic<uint64> m_posSample{ 0 };
+
+		std::atomic<size_t> m_loopCount{ 0 };
+
+		std::atomic<size_t> m_underrunCount{ 0 };
+
+	# if SIV3D_PREFETCH_AUDIO_THREAD
+
+		std::atomic<bool> m_abort{ false };
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_cv;
+
+		std::thread m_thread;
+
+		void run();
+
+	# endif
+
+		[[nodiscard]]
+		bool isSeekPending() const noexcept;
+
+		// デコードを 1 回行う。待つべき場合は false を返す
+		bool produce();
+
+		void processSeek();
+
+		void pushMarker(uint64 index, uint64 pos, bool loop);
+	};
+}
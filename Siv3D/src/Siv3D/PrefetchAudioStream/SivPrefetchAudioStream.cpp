@@ -0,0 +1,106 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/PrefetchAudioStream.hpp>
+# include "PrefetchAudioStreamDetail.hpp"
+
+namespace s3d
+{
+	PrefetchAudioStream::PrefetchAudioStream()
+		: pImpl{ std::make_shared<PrefetchAudioStreamDetail>(nullptr, DefaultBufferLength) } {}
+
+	PrefetchAudioStream::PrefetchAudioStream(std::unique_ptr<IAudioDecoderStream>&& stream, const Duration& bufferLength)
+		: pImpl{ std::make_shared<PrefetchAudioStreamDetail>(std::move(stream), bufferLength) } {}
+
+	PrefetchAudioStream::~PrefetchAudioStream() {}
+
+	bool PrefetchAudioStream::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	PrefetchAudioStream::operator bool() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	uint32 PrefetchAudioStream::sampleRate() const noexcept
+	{
+		return pImpl->sampleRate();
+	}
+
+	size_t PrefetchAudioStream::samples() const noexcept
+	{
+		return pImpl->samples();
+	}
+
+	void PrefetchAudioStream::setLoop(const bool loop)
+	{
+		pImpl->setLoop(loop);
+	}
+
+	bool PrefetchAudioStream::isLoop() const noexcept
+	{
+		return pImpl->isLoop();
+	}
+
+	void PrefetchAudioStream::setLoopBegin(const uint64 loopBegin)
+	{
+		pImpl->setLoopBegin(loopBegin);
+	}
+
+	uint64 PrefetchAudioStream::posSample() const noexcept
+	{
+		return pImpl->posSample();
+	}
+
+	size_t PrefetchAudioStream::loopCount() const noexcept
+	{
+		return pImpl->loopCount();
+	}
+
+	size_t PrefetchAudioStream::bufferedSamples() const noexcept
+	{
+		return pImpl->bufferedSamples();
+	}
+
+	size_t PrefetchAudioStream::underrunCount() const noexcept
+	{
+		return pImpl->underrunCount();
+	}
+
+	void PrefetchAudioStream::getAudio(float* left, float* right, const size_t samplesToWrite)
+	{
+		pImpl->getAudio(left, right, samplesToWrite);
+	}
+
+	bool PrefetchAudioStream::hasEnded()
+	{
+		return pImpl->hasEnded();
+	}
+
+	void PrefetchAudioStream::rewind()
+	{
+		pImpl->seek(0);
+	}
+
+	bool PrefetchAudioStream::seekSamples(const size_t posSample)
+	{
+		if (not pImpl->isOpen())
+		{
+			return false;
+		}
+
+		pImpl->seek(posSample);
+
+		return true;
+	}
+}
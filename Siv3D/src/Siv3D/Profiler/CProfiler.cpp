@@ -24,6 +24,7 @@
 # include <Siv3D/Audio/IAudio.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "CProfiler.hpp"
+# include "ProfilerZoneRecorder.hpp"
 
 namespace s3d
 {
@@ -32,10 +33,18 @@ namespace s3d
 		LOG_SCOPED_TRACE(U"CProfiler::init()");
 
 		m_fpsTimestampMillisec = Time::GetMillisec();
+
+		// メインスレッドのバッファを最初に登録する
+		ProfilerZoneRecorder::Get().registerCurrentThread();
 	}
 
 	void CProfiler::beginFrame()
 	{
+		// Zone
+		{
+			ProfilerZoneRecorder::Get().beginFrame(Time::GetNanosec());
+		}
+
 		// FPS
 		{
 			if (const int64 timestampMillisec = Time::GetMillisec();
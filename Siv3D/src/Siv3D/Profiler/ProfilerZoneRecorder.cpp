@@ -0,0 +1,340 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/TextWriter.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/HSV.hpp>
+# include <Siv3D/SimpleGUI.hpp>
+# include <Siv3D/Font.hpp>
+# include <Siv3D/DrawableText.hpp>
+# include "ProfilerZoneRecorder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static void AppendJSONEscaped(std::string& out, const std::string_view s)
+		{
+			for (const char ch : s)
+			{
+				switch (ch)
+				{
+				case '"':
+					out.append("\\\"");
+					break;
+				case '\\':
+					out.append("\\\\");
+					break;
+				case '\n':
+					out.append("\\n");
+					break;
+				case '\t':
+					out.append("\\t");
+					break;
+				default:
+					if (static_cast<unsigned char>(ch) < 0x20)
+					{
+						out.push_back(' ');
+					}
+					else
+					{
+						out.push_back(ch);
+					}
+					break;
+				}
+			}
+		}
+
+		[[nodiscard]]
+		static ColorF GetZoneColor(const char32* name) noexcept
+		{
+			// 同じ名前には同じ色を割り当てる
+			const uint64 hash = StringView{ name }.hash();
+			return HSV{ static_cast<double>(hash % 360), 0.55, 0.85 };
+		}
+	}
+
+	ProfilerZoneThreadBuffer::ProfilerZoneThreadBuffer(const uint32 threadIndex)
+		: m_slots{ std::make_unique<Slot[]>(Capacity) }
+		, m_threadIndex{ threadIndex } {}
+
+	void ProfilerZoneThreadBuffer::push(const ProfilerZoneEvent& event) noexcept
+	{
+		const uint64 index = m_writeCount.load(std::memory_order_relaxed);
+
+		Slot& slot = m_slots[index & (Capacity - 1)];
+
+		slot.sequence.store((index * 2 + 1), std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.name.store(event.name, std::memory_order_relaxed);
+		slot.beginNanosec.store(event.beginNanosec, std::memory_order_relaxed);
+		slot.endNanosec.store(event.endNanosec, std::memory_order_relaxed);
+		slot.depth.store(event.depth, std::memory_order_relaxed);
+
+		slot.sequence.store((index * 2 + 2), std::memory_order_release);
+
+		m_writeCount.store((index + 1), std::memory_order_release);
+	}
+
+	void ProfilerZoneThreadBuffer::read(const uint64 beginNanosec, const uint64 endNanosec, Array<ProfilerZoneEvent>& events) const
+	{
+		const uint64 writeCount = m_writeCount.load(std::memory_order_acquire);
+		const uint64 first = ((Capacity < writeCount) ? (writeCount - Capacity) : 0);
+
+		for (uint64 i = first; i < writeCount; ++i)
+		{
+			const Slot& slot = m_slots[i & (Capacity - 1)];
+			const uint64 sequence = (i * 2 + 2);
+
+			// 書き込みスレッドと競合しうる読み出し。
+			// 読み出しの前後でシーケンス番号が一致しない要素は、すでに上書きされているので使わない
+			if (slot.sequence.load(std::memory_order_acquire) != sequence)
+			{
+				continue;
+			}
+
+			const ProfilerZoneEvent event{
+				slot.name.load(std::memory_order_relaxed),
+				slot.beginNanosec.load(std::memory_order_relaxed),
+				slot.endNanosec.load(std::memory_order_relaxed),
+				slot.depth.load(std::memory_order_relaxed) };
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+			{
+				continue;
+			}
+
+			if ((event.endNanosec <= beginNanosec) || (endNanosec <= event.beginNanosec))
+			{
+				continue;
+			}
+
+			events.push_back(event);
+		}
+	}
+
+	uint32 ProfilerZoneThreadBuffer::threadIndex() const noexcept
+	{
+		return m_threadIndex;
+	}
+
+	// スレッドの終了時に、バッファをレコーダーに返却する
+	struct ProfilerZoneRecorder::ThreadBufferHolder
+	{
+		std::shared_ptr<ProfilerZoneThreadBuffer> buffer;
+
+		~ThreadBufferHolder()
+		{
+			if (buffer)
+			{
+				ProfilerZoneRecorder::Get().releaseThreadBuffer(std::move(buffer));
+			}
+		}
+	};
+
+	ProfilerZoneRecorder& ProfilerZoneRecorder::Get()
+	{
+		static ProfilerZoneRecorder recorder;
+		return recorder;
+	}
+
+	void ProfilerZoneRecorder::setEnabled(const bool enabled) noexcept
+	{
+		m_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	ProfilerZoneThreadBuffer& ProfilerZoneRecorder::getThreadBuffer()
+	{
+		// スレッド終了後もバッファを読めるように、所有権をレコーダーと共有する
+		thread_local ThreadBufferHolder holder;
+
+		if (not holder.buffer)
+		{
+			std::lock_guard lock{ m_threadMutex };
+
+			// 終了したスレッドのバッファがあれば再利用し、スレッドの生成ごとにバッファが増え続けないようにする
+			if (m_freeThreadBuffers)
+			{
+				holder.buffer = std::move(m_freeThreadBuffers.back());
+				m_freeThreadBuffers.pop_back();
+				holder.buffer->depth = 0;
+			}
+			else
+			{
+				holder.buffer = std::make_shared<ProfilerZoneThreadBuffer>(static_cast<uint32>(m_threadBuffers.size()));
+				m_threadBuffers.push_back(holder.buffer);
+			}
+		}
+
+		return *holder.buffer;
+	}
+
+	void ProfilerZoneRecorder::registerCurrentThread()
+	{
+		[[maybe_unused]] const auto& buffer = getThreadBuffer();
+	}
+
+	void ProfilerZoneRecorder::beginFrame(const uint64 nanosec)
+	{
+		std::lock_guard lock{ m_frameMutex };
+
+		if (MaxFrames <= m_frameBeginNanosecs.size())
+		{
+			m_frameBeginNanosecs.pop_front_N(m_frameBeginNanosecs.size() - MaxFrames + 1);
+		}
+
+		m_frameBeginNanosecs.push_back(nanosec);
+	}
+
+	bool ProfilerZoneRecorder::exportChromeTrace(const FilePathView path, const size_t frames)
+	{
+		uint64 beginNanosec = 0, endNanosec = 0;
+
+		if (not getFrameRange(frames, beginNanosec, endNanosec))
+		{
+			return false;
+		}
+
+		TextWriter writer{ path, TextEncoding::UTF8_NO_BOM };
+
+		if (not writer)
+		{
+			return false;
+		}
+
+		std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+		bool first = true;
+
+		Array<ProfilerZoneEvent> events;
+
+		for (const auto& buffer : getThreadBuffers())
+		{
+			const uint32 tid = buffer->threadIndex();
+
+			if (not first)
+			{
+				json.push_back(',');
+			}
+			first = false;
+
+			json.append(fmt::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})",
+				tid, ((tid == 0) ? std::string{ "Main" } : fmt::format("Thread {}", tid))));
+
+			events.clear();
+			buffer->read(beginNanosec, endNanosec, events);
+
+			for (const auto& event : events)
+			{
+				json.append(R"(,{"name":")");
+				detail::AppendJSONEscaped(json, Unicode::ToUTF8(event.name));
+				json.append(fmt::format(R"(","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+					tid, (event.beginNanosec / 1'000.0), ((event.endNanosec - event.beginNanosec) / 1'000.0)));
+			}
+
+			writer.writeUTF8(json);
+			json.clear();
+		}
+
+		writer.writeUTF8("]}");
+
+		return true;
+	}
+
+	void ProfilerZoneRecorder::drawTimeline(const RectF& rect)
+	{
+		uint64 beginNanosec = 0, endNanosec = 0;
+
+		rect.draw(ColorF{ 0.0, 0.8 });
+
+		if (not getFrameRange(1, beginNanosec, endNanosec))
+		{
+			return;
+		}
+
+		const Font& font = SimpleGUI::GetFont();
+		constexpr double RowHeight = 18.0;
+		const double scale = (rect.w / static_cast<double>(endNanosec - beginNanosec));
+
+		double y = rect.y;
+		Array<ProfilerZoneEvent> events;
+
+		for (const auto& buffer : getThreadBuffers())
+		{
+			events.clear();
+			buffer->read(beginNanosec, endNanosec, events);
+
+			if (not events)
+			{
+				continue;
+			}
+
+			uint32 maxDepth = 0;
+
+			for (const auto& event : events)
+			{
+				const double x0 = (rect.x + (static_cast<int64>(Max(event.beginNanosec, beginNanosec) - beginNanosec) * scale));
+				const double x1 = (rect.x + (static_cast<int64>(Min(event.endNanosec, endNanosec) - beginNanosec) * scale));
+				const RectF zone{ x0, (y + event.depth * RowHeight), Max((x1 - x0), 1.0), (RowHeight - 1) };
+
+				if (rect.bottomY() <= zone.y)
+				{
+					continue;
+				}
+
+				zone.draw(detail::GetZoneColor(event.name));
+
+				if (40.0 < zone.w)
+				{
+					const String label = U"{} {:.2f}ms"_fmt(event.name, ((event.endNanosec - event.beginNanosec) / 1'000'000.0));
+					font(label).draw(12, zone.stretched(-2, 0), ColorF{ 0.0 });
+				}
+
+				maxDepth = Max(maxDepth, event.depth);
+			}
+
+			y += ((maxDepth + 1) * RowHeight + 4);
+		}
+	}
+
+	Array<std::shared_ptr<ProfilerZoneThreadBuffer>> ProfilerZoneRecorder::getThreadBuffers()
+	{
+		std::lock_guard lock{ m_threadMutex };
+		return m_threadBuffers;
+	}
+
+	void ProfilerZoneRecorder::releaseThreadBuffer(std::shared_ptr<ProfilerZoneThreadBuffer>&& buffer)
+	{
+		std::lock_guard lock{ m_threadMutex };
+		m_freeThreadBuffers.push_back(std::move(buffer));
+	}
+
+	bool ProfilerZoneRecorder::getFrameRange(const size_t frames, uint64& beginNanosec, uint64& endNanosec)
+	{
+		std::lock_guard lock{ m_frameMutex };
+
+		// 最後のフレームは記録中なので含めない
+		if ((frames == 0) || (m_frameBeginNanosecs.size() < 2))
+		{
+			return false;
+		}
+
+		const size_t n = Min(frames, (m_frameBeginNanosecs.size() - 1));
+		endNanosec = m_frameBeginNanosecs.back();
+		beginNanosec = m_frameBeginNanosecs[m_frameBeginNanosecs.size() - 1 - n];
+
+		return true;
+	}
+}
@@ -0,0 +1,131 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <memory>
+# include <mutex>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/StringView.hpp>
+# include <Siv3D/2DShapesFwd.hpp>
+
+namespace s3d
+{
+	struct ProfilerZoneEvent
+	{
+		const char32* name;
+
+		uint64 beginNanosec;
+
+		uint64 endNanosec;
+
+		uint32 depth;
+	};
+
+	// 1 つのスレッドだけが書き込み、任意のスレッドが読み出すリングバッファ
+	// 各要素はシーケンス番号で保護され、読み出し中に上書きされた要素は捨てられる
+	class ProfilerZoneThreadBuffer
+	{
+	public:
+
+		static constexpr size_t Capacity = (1 << 14);
+
+		explicit ProfilerZoneThreadBuffer(uint32 threadIndex);
+
+		void push(const ProfilerZoneEvent& event) noexcept;
+
+		void read(uint64 beginNanosec, uint64 endNanosec, Array<ProfilerZoneEvent>& events) const;
+
+		[[nodiscard]]
+		uint32 threadIndex() const noexcept;
+
+		// 書き込みスレッドだけが使う現在の入れ子の深さ
+		uint32 depth = 0;
+
+	private:
+
+		struct Slot
+		{
+			// 書き込み中は (2 * index + 1), 書き込み完了後は (2 * index + 2)
+			std::atomic<uint64> sequence = 0;
+
+			std::atomic<const char32*> name = nullptr;
+
+			std::atomic<uint64> beginNanosec = 0;
+
+			std::atomic<uint64> endNanosec = 0;
+
+			std::atomic<uint32> depth = 0;
+		};
+
+		std::unique_ptr<Slot[]> m_slots;
+
+		std::atomic<uint64> m_writeCount = 0;
+
+		uint32 m_threadIndex = 0;
+	};
+
+	class ProfilerZoneRecorder
+	{
+	public:
+
+		[[nodiscard]]
+		static ProfilerZoneRecorder& Get();
+
+		[[nodiscard]]
+		bool isEnabled() const noexcept
+		{
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+
+		void setEnabled(bool enabled) noexcept;
+
+		[[nodiscard]]
+		ProfilerZoneThreadBuffer& getThreadBuffer();
+
+		void registerCurrentThread();
+
+		void beginFrame(uint64 nanosec);
+
+		bool exportChromeTrace(FilePathView path, size_t frames);
+
+		void drawTimeline(const RectF& rect);
+
+	private:
+
+		static constexpr size_t MaxFrames = 256;
+
+		struct ThreadBufferHolder;
+
+		std::atomic<bool> m_enabled = false;
+
+		std::mutex m_threadMutex;
+
+		Array<std::shared_ptr<ProfilerZoneThreadBuffer>> m_threadBuffers;
+
+		// 終了したスレッドから返却され、再利用を待つバッファ
+		Array<std::shared_ptr<ProfilerZoneThreadBuffer>> m_freeThreadBuffers;
+
+		std::mutex m_frameMutex;
+
+		// フレームの開始時刻（古い順）
+		Array<uint64> m_frameBeginNanosecs;
+
+		[[nodiscard]]
+		Array<std::shared_ptr<ProfilerZoneThreadBuffer>> getThreadBuffers();
+
+		void releaseThreadBuffer(std::shared_ptr<ProfilerZoneThreadBuffer>&& buffer);
+
+		[[nodiscard]]
+		bool getFrameRange(size_t frames, uint64& beginNanosec, uint64& endNanosec);
+	};
+}
@@ -11,6 +11,7 @@
 
 # include <Siv3D/Profiler.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
+# include <Siv3D/Profiler/ProfilerZoneRecorder.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -32,5 +33,25 @@ namespace s3d
 		{
 			return SIV3D_ENGINE(Profiler)->getStat();
 		}
+
+		void EnableZoneRecording(const bool enabled)
+		{
+			ProfilerZoneRecorder::Get().setEnabled(enabled);
+		}
+
+		bool IsZoneRecordingEnabled() noexcept
+		{
+			return ProfilerZoneRecorder::Get().isEnabled();
+		}
+
+		bool ExportChromeTrace(const FilePathView path, const size_t frames)
+		{
+			return ProfilerZoneRecorder::Get().exportChromeTrace(path, frames);
+		}
+
+		void DrawZoneTimeline(const RectF& rect)
+		{
+			ProfilerZoneRecorder::Get().drawTimeline(rect);
+		}
 	}
 }
@@ -0,0 +1,48 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ProfilerZone.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/Profiler/ProfilerZoneRecorder.hpp>
+
+namespace s3d
+{
+	ProfilerZone::ProfilerZone(const char32* name) noexcept
+	{
+		auto& recorder = ProfilerZoneRecorder::Get();
+
+		if (not recorder.isEnabled())
+		{
+			return;
+		}
+
+		++recorder.getThreadBuffer().depth;
+
+		m_name = name;
+		m_beginNanosec = Time::GetNanosec();
+	}
+
+	ProfilerZone::~ProfilerZone()
+	{
+		if (not m_name)
+		{
+			return;
+		}
+
+		const uint64 endNanosec = Time::GetNanosec();
+
+		auto& buffer = ProfilerZoneRecorder::Get().getThreadBuffer();
+
+		const uint32 depth = --buffer.depth;
+
+		buffer.push(ProfilerZoneEvent{ m_name, m_beginNanosec, endNanosec, depth });
+	}
+}
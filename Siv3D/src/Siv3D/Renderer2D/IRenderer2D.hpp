@@ -29,7 +29,7 @@
 # include <Siv3D/RenderTexture.hpp>
 # include <Siv3D/ConstantBuffer.hpp>
 # include <Siv3D/Mat3x2.hpp>
-# include <Siv3D/Particle2D.hpp>
+# include <Siv3D/ParticleSystem2D/Particle2DStore.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
 
 namespace s3d
@@ -129,7 +129,7 @@ namespace s3d
 
 		virtual void addRoundRectShadow(const RoundRect& roundRect, float blur, const Float4& color, bool fill) = 0;
 
-		virtual void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		virtual void addTexturedParticles(const Texture& texture, const Particle2DStore& particles,
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) = 0;
 
@@ -222,7 +222,7 @@ namespace s3d
 		// do nothing
 	}
 
-	void CRenderer2D_Null::addTexturedParticles(const Texture&, const Array<Particle2D>&,
+	void CRenderer2D_Null::addTexturedParticles(const Texture&, const Particle2DStore&,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc)
 	{
@@ -13,6 +13,7 @@
 # include <Siv3D/FastMath.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/OffsetCircular.hpp>
+# include <Siv3D/ParallelFor.hpp>
 
 namespace s3d
 {
@@ -24,6 +25,9 @@ namespace s3d
 
 		static constexpr Vertex2D::IndexType MaxSinCosTableQuality = 40;
 
+		// パーティクルの頂点を並列に生成するときの、1 タスクあたりのパーティクル数
+		static constexpr size_t ParticleVertexGrainSize = 2048;
+
 		static constexpr Vertex2D::IndexType SinCosTableSize = ((MaxSinCosTableQuality - 5) * (6 + (MaxSinCosTableQuality))) / 2;
 
 		static const std::array<Float2, SinCosTableSize> CircleSinCosTable = []()
@@ -3455,11 +3459,22 @@ namespace s3d
 			return indexCount;
 		}
 
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Particle2DStore& particles, size_t first, size_t last,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
 		{
-			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(particles.size() * 4);
-			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(particles.size() * 6);
+			last = Min(last, particles.size());
+
+			if (last <= first)
+			{
+				return 0;
+			}
+
+			// インデックスが Vertex2D::IndexType で表せる範囲を超えないよう、呼び出し側で分割する
+			last = Min(last, (first + MaxParticlesPerBuild));
+
+			const size_t count = (last - first);
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4);
+			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(count * 6);
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
 
 			if (not pVertex)
@@ -3467,39 +3482,60 @@ namespace s3d
 				return 0;
 			}
 
-			for (const auto& particle : particles)
+			// 範囲の先頭を 0 番目とする
+			const float* pPositionX = (particles.positionX() + first);
+			const float* pPositionY = (particles.positionY() + first);
+			const float* pRotation = (particles.rotation() + first);
+			const Float4* pStartColor = (particles.startColor() + first);
+			const float* pStartSize = (particles.startSize() + first);
+			const float* pStartLifeTime = (particles.startLifeTime() + first);
+			const float* pRemainingLifeTime = (particles.remainingLifeTime() + first);
+
+			const auto build = [&](const size_t begin, const size_t end)
 			{
-				const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-				const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+				Vertex2D* pDst = (pVertex + (begin * 4));
+				Vertex2D::IndexType* pDstIndex = (pIndex + (begin * 6));
+				Vertex2D::IndexType indexBase = static_cast<Vertex2D::IndexType>(indexOffset + (begin * 4));
 
-				const float size_half = (size * 0.5f);
-				const float cx = particle.position.x;
-				const float cy = particle.position.y;
+				for (size_t i = begin; i < end; ++i)
+				{
+					const float size = (sizeOverLifeTimeFunc ? sizeOverLifeTimeFunc(pStartSize[i], pStartLifeTime[i], pRemainingLifeTime[i])
+						: (pStartSize[i] * (pRemainingLifeTime[i] / pStartLifeTime[i])));
+					const Float4 color = (colorOverLifeTimeFunc ? colorOverLifeTimeFunc(pStartColor[i], pStartLifeTime[i], pRemainingLifeTime[i])
+						: pStartColor[i]);
 
-				const float x = size_half;
-				const auto [s, c] = FastMath::SinCos(particle.rotation);
-				const float xc = x * c;
-				const float xs = x * s;
+					const float size_half = (size * 0.5f);
+					const float cx = pPositionX[i];
+					const float cy = pPositionY[i];
 
-				pVertex[0].set({ -xc + xs + cx, -xs - xc + cy }, 0.0f, 0.0f, color);
-				pVertex[1].set({ xc + xs + cx, xs - xc + cy }, 1.0f, 0.0f, color);
-				pVertex[2].set({ -xc - xs + cx, -xs + xc + cy }, 0.0f, 1.0f, color);
-				pVertex[3].set({ xc - xs + cx, xs + xc + cy }, 1.0f, 1.0f, color);
-				pVertex += 4;
-			}
+					const float x = size_half;
+					const auto [s, c] = FastMath::SinCos(pRotation[i]);
+					const float xc = x * c;
+					const float xs = x * s;
 
-			{
-				Vertex2D::IndexType indexBase = indexOffset;
+					pDst[0].set({ -xc + xs + cx, -xs - xc + cy }, 0.0f, 0.0f, color);
+					pDst[1].set({ xc + xs + cx, xs - xc + cy }, 1.0f, 0.0f, color);
+					pDst[2].set({ -xc - xs + cx, -xs + xc + cy }, 0.0f, 1.0f, color);
+					pDst[3].set({ xc - xs + cx, xs + xc + cy }, 1.0f, 1.0f, color);
+					pDst += 4;
 
-				for (Vertex2D::IndexType n = 0; n < particles.size(); ++n)
-				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
+					for (Vertex2D::IndexType k = 0; k < 6; ++k)
 					{
-						*pIndex++ = (indexBase + detail::RectIndexTable[i]);
+						*pDstIndex++ = (indexBase + detail::RectIndexTable[k]);
 					}
 
 					indexBase += 4;
 				}
+			};
+
+			// ユーザ定義の関数はスレッドセーフとは限らないため、既定の関数を使う場合のみ並列に処理する
+			if (sizeOverLifeTimeFunc || colorOverLifeTimeFunc)
+			{
+				build(0, count);
+			}
+			else
+			{
+				ParallelFor(0, count, build, detail::ParticleVertexGrainSize);
 			}
 
 			return indexSize;
@@ -20,8 +20,8 @@
 # include <Siv3D/LineStyle.hpp>
 # include <Siv3D/YesNo.hpp>
 # include <Siv3D/PredefinedYesNo.hpp>
-# include <Siv3D/Particle2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
+# include <Siv3D/ParticleSystem2D/Particle2DStore.hpp>
 # include "Vertex2DBufferPointer.hpp"
 
 namespace s3d
@@ -162,8 +162,14 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRoundRectShadow(const BufferCreatorFunc& bufferCreator, const RoundRect& roundRect, float blur, const Float4& color, float scale, bool fill);
 
+		// 1 回の BuildTexturedParticles() で扱えるパーティクルの最大数
+		// インデックス数 (パーティクルあたり 6) が Vertex2D::IndexType に収まるようにする
+		inline constexpr size_t MaxParticlesPerBuild = (Largest<Vertex2D::IndexType> / 6);
+
+		// particles の [first, last) の頂点を生成する。MaxParticlesPerBuild を超える分は生成しない
+		// sizeOverLifeTimeFunc, colorOverLifeTimeFunc が空の場合は既定の関数を使う
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Particle2DStore& particles, size_t first, size_t last,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
 	}
 }
@@ -0,0 +1,942 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <atomic>
+# include <numeric>
+# include <shared_mutex>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/ParallelFor.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatUtility.hpp>
+# include <ThirdParty/zstd/zstd.h>
+# include "ResourcePackDetail.hpp"
+
+namespace s3d
+{
+	namespace detail::init
+	{
+		const Array<FilePath>& GetResourceFilePaths() noexcept;
+	}
+
+	namespace detail
+	{
+		// 1 バケットあたりの平均のファイル数
+		static constexpr uint32 FilesPerBucket = 4;
+
+		// 1 つのバケットについて試す変位の上限
+		static constexpr uint32 MaxDisplacement = (1u << 24);
+
+		static constexpr uint64 MaxSeedTrials = 16;
+
+		// 一度に読み込んで圧縮するデータのサイズの目安
+		static constexpr size_t BatchSize = (64 * 1024 * 1024);
+
+		// EnumResourceFiles() のために保持しておく一覧の数の上限
+		static constexpr size_t MaxResourceFileLists = 16;
+
+		[[nodiscard]]
+		static constexpr uint64 AlignUp(const uint64 value, const uint64 alignment) noexcept
+		{
+			return ((value + (alignment - 1)) & ~(alignment - 1));
+		}
+
+		[[nodiscard]]
+		static FilePath NormalizeMountPoint(const FilePathView mountPoint)
+		{
+			FilePath result{ mountPoint };
+
+			result.replace(U'\\', U'/');
+
+			if (result && (not result.ends_with(U'/')))
+			{
+				result.push_back(U'/');
+			}
+
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	完全ハッシュの構築
+		//
+		//	hash-and-displace 法: ファイルをバケットに分け、大きいバケットから順に、
+		//	バケット内のすべてのファイルが空きスロットに収まる変位を探す。
+		//	スロット数をファイル数と同じにすることで、スロットの番号をそのままエントリーの番号として使う。
+		//
+		struct PerfectHash
+		{
+			uint64 seed = 0;
+
+			Array<uint32> displacements;
+
+			// ファイルごとのスロット
+			Array<uint32> slots;
+		};
+
+		[[nodiscard]]
+		static bool BuildPerfectHash(const Array<uint64>& pathHashes, PerfectHash& result)
+		{
+			const uint32 fileCount = static_cast<uint32>(pathHashes.size());
+			const uint32 bucketCount = Max<uint32>(1, ((fileCount + FilesPerBucket - 1) / FilesPerBucket));
+
+			for (uint64 seed = 0; seed < MaxSeedTrials; ++seed)
+			{
+				Array<Array<uint32>> buckets(bucketCount);
+				Array<uint64> bucketHashes(fileCount);
+
+				for (uint32 i = 0; i < fileCount; ++i)
+				{
+					bucketHashes[i] = ResourcePackBucketHash(pathHashes[i], seed);
+					buckets[bucketHashes[i] % bucketCount].push_back(i);
+				}
+
+				Array<uint32> order(bucketCount);
+				std::iota(order.begin(), order.end(), 0);
+				order.stable_sort_by([&](const uint32 a, const uint32 b) { return (buckets[a].size() > buckets[b].size()); });
+
+				result.seed = seed;
+				result.displacements.assign(bucketCount, 0);
+				result.slots.assign(fileCount, 0);
+
+				Array<bool> occupied(fileCount, false);
+				Array<uint32> candidates;
+				bool succeeded = true;
+
+				for (const uint32 bucketIndex : order)
+				{
+					const Array<uint32>& bucket = buckets[bucketIndex];
+
+					if (bucket.isEmpty())
+					{
+						break;
+					}
+
+					bool placed = false;
+
+					for (uint32 displacement = 0; displacement < MaxDisplacement; ++displacement)
+					{
+						candidates.clear();
+
+						for (const uint32 fileIndex : bucket)
+						{
+							const uint32 slot = static_cast<uint32>(ResourcePackSlotHash(bucketHashes[fileIndex], displacement) % fileCount);
+
+							if (occupied[slot] || candidates.contains(slot))
+							{
+								break;
+							}
+
+							candidates.push_back(slot);
+						}
+
+						if (candidates.size() != bucket.size())
+						{
+							continue;
+						}
+
+						for (size_t i = 0; i < bucket.size(); ++i)
+						{
+							occupied[candidates[i]] = true;
+							result.slots[bucket[i]] = candidates[i];
+						}
+
+						result.displacements[bucketIndex] = displacement;
+						placed = true;
+						break;
+					}
+
+					if (not placed)
+					{
+						succeeded = false;
+						break;
+					}
+				}
+
+				if (succeeded)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	リソースパックファイルの作成
+		//
+		struct PackingFile
+		{
+			FilePath path;
+
+			std::string packedPath;
+
+			ResourcePackEntry entry{};
+
+			Blob data;
+
+			Array<Blob> compressedBlocks;
+		};
+
+		[[nodiscard]]
+		static bool CompressFile(PackingFile& file, const int32 compressionLevel)
+		{
+			if (not file.data.createFromFile(file.path))
+			{
+				return false;
+			}
+
+			const size_t size = file.data.size();
+			file.entry.size = size;
+
+			const size_t blockCount = ((size + ResourcePackBlockSize - 1) / ResourcePackBlockSize);
+			size_t compressedSize = 0;
+
+			file.compressedBlocks.resize(blockCount);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				const size_t offset = (i * ResourcePackBlockSize);
+				const size_t rawSize = Min<size_t>(ResourcePackBlockSize, (size - offset));
+				Blob& block = file.compressedBlocks[i];
+
+				// 圧縮で小さくならないブロックはそのまま格納する
+				if ((not Compression::Compress((file.data.data() + offset), rawSize, block, compressionLevel))
+					|| (rawSize <= block.size()))
+				{
+					block.create((file.data.data() + offset), rawSize);
+				}
+
+				compressedSize += block.size();
+			}
+
+			// 圧縮の効果が小さいファイルは、展開の手間を省くため無圧縮で格納する
+			if ((size - (size / 16)) <= (compressedSize + (blockCount * sizeof(ResourcePackBlock))))
+			{
+				file.compressedBlocks.clear();
+			}
+			else
+			{
+				file.data.release();
+			}
+
+			return true;
+		}
+
+		bool CreateResourcePack(const Array<FilePath>& files, const FilePathView baseDirectory, const FilePathView outputPath, const int32 compressionLevel)
+		{
+			LOG_SCOPED_TRACE(U"CreateResourcePack()");
+
+			if (Largest<uint32> <= files.size())
+			{
+				LOG_FAIL(U"❌ ResourcePack::Create(): Too many files");
+				return false;
+			}
+
+			const FilePath base = NormalizeMountPoint(baseDirectory ? FileSystem::FullPath(baseDirectory) : FilePath{});
+
+			Array<PackingFile> packingFiles(files.size());
+
+			for (size_t i = 0; i < files.size(); ++i)
+			{
+				const FilePath fullPath = FileSystem::FullPath(files[i]);
+
+				if (not fullPath.starts_with(base))
+				{
+					LOG_FAIL(U"❌ ResourcePack::Create(): `{}` is not in `{}`"_fmt(files[i], base));
+					return false;
+				}
+
+				packingFiles[i].path = fullPath;
+				packingFiles[i].packedPath = Unicode::ToUTF8(StringView{ fullPath }.substr(base.size()));
+			}
+
+			// 同じパスのファイルがあると完全ハッシュを構築できない
+			{
+				Array<std::string_view> packedPaths = packingFiles.map([](const PackingFile& file) { return std::string_view{ file.packedPath }; });
+
+				packedPaths.sort();
+
+				if (std::adjacent_find(packedPaths.begin(), packedPaths.end()) != packedPaths.end())
+				{
+					LOG_FAIL(U"❌ ResourcePack::Create(): Duplicate file paths");
+					return false;
+				}
+			}
+
+			PerfectHash perfectHash;
+
+			if (not BuildPerfectHash(packingFiles.map([](const PackingFile& file) { return ResourcePackPathHash(file.packedPath); }), perfectHash))
+			{
+				LOG_FAIL(U"❌ ResourcePack::Create(): Failed to build the path index");
+				return false;
+			}
+
+			BinaryWriter writer{ outputPath };
+
+			if (not writer)
+			{
+				LOG_FAIL(U"❌ ResourcePack::Create(): Failed to open `{}`"_fmt(outputPath));
+				return false;
+			}
+
+			// ヘッダはすべてのデータを書き込んでから確定させる
+			ResourcePackHeader header{};
+			writer.write(header);
+
+			uint64 pos = sizeof(ResourcePackHeader);
+			Array<ResourcePackBlock> blocks;
+			const Byte padding[16] = {};
+
+			const auto writeAligned = [&](const void* data, const uint64 size)
+			{
+				const uint64 alignedPos = AlignUp(pos, 16);
+				writer.write(padding, static_cast<int64>(alignedPos - pos));
+				writer.write(data, static_cast<int64>(size));
+				pos = (alignedPos + size);
+				return alignedPos;
+			};
+
+			for (size_t batchBegin = 0; batchBegin < packingFiles.size();)
+			{
+				// 一定のサイズごとに、ファイルを並列に読み込んで圧縮する
+				size_t batchEnd = batchBegin;
+
+				for (size_t batchSize = 0; (batchEnd < packingFiles.size()) && (batchSize < BatchSize); ++batchEnd)
+				{
+					batchSize += static_cast<size_t>(Max<int64>(FileSystem::FileSize(packingFiles[batchEnd].path), 0));
+				}
+
+				std::atomic<bool> succeeded = true;
+
+				ParallelFor(batchBegin, batchEnd, [&](const size_t i)
+				{
+					if (not CompressFile(packingFiles[i], compressionLevel))
+					{
+						LOG_FAIL(U"❌ ResourcePack::Create(): Failed to read `{}`"_fmt(packingFiles[i].path));
+						succeeded = false;
+					}
+				}, 1);
+
+				if (not succeeded)
+				{
+					return false;
+				}
+
+				for (size_t i = batchBegin; i < batchEnd; ++i)
+				{
+					PackingFile& file = packingFiles[i];
+					ResourcePackEntry& entry = file.entry;
+
+					if (file.compressedBlocks)
+					{
+						for (const Blob& block : file.compressedBlocks)
+						{
+							blocks.push_back({ .offset = writeAligned(block.data(), block.size()), .compressedSize = static_cast<uint32>(block.size()), .reserved = 0 });
+						}
+
+						entry.firstBlock = static_cast<uint32>(blocks.size() - file.compressedBlocks.size());
+						entry.blockCount = static_cast<uint32>(file.compressedBlocks.size());
+						file.compressedBlocks.clear();
+					}
+					else
+					{
+						entry.offset = writeAligned(file.data.data(), file.data.size());
+						file.data.release();
+					}
+				}
+
+				batchBegin = batchEnd;
+			}
+
+			// 索引
+			std::string pathTable;
+			Array<ResourcePackEntry> entries(packingFiles.size());
+
+			for (size_t i = 0; i < packingFiles.size(); ++i)
+			{
+				ResourcePackEntry entry = packingFiles[i].entry;
+				entry.pathOffset = static_cast<uint32>(pathTable.size());
+				entry.pathLength = static_cast<uint32>(packingFiles[i].packedPath.size());
+				pathTable.append(packingFiles[i].packedPath);
+				entries[perfectHash.slots[i]] = entry;
+			}
+
+			std::memcpy(header.signature, ResourcePackSignature, sizeof(ResourcePackSignature));
+			header.version				= ResourcePackVersion;
+			header.fileCount			= static_cast<uint32>(entries.size());
+			header.bucketCount			= static_cast<uint32>(perfectHash.displacements.size());
+			header.blockSize			= ResourcePackBlockSize;
+			header.seed					= perfectHash.seed;
+			header.entryTableOffset		= writeAligned(entries.data(), entries.size_bytes());
+			header.bucketTableOffset	= writeAligned(perfectHash.displacements.data(), perfectHash.displacements.size_bytes());
+			header.blockTableOffset		= writeAligned(blocks.data(), blocks.size_bytes());
+			header.pathTableOffset		= writeAligned(pathTable.data(), pathTable.size());
+			header.pathTableSize		= pathTable.size();
+
+			writer.setPos(0);
+
+			if (not writer.write(header))
+			{
+				LOG_FAIL(U"❌ ResourcePack::Create(): Failed to write `{}`"_fmt(outputPath));
+				return false;
+			}
+
+			LOG_INFO(U"📦 ResourcePack: `{}` created ({} files, size: {})"_fmt(outputPath, entries.size(), FormatDataSize(static_cast<int64>(pos))));
+
+			return true;
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	ResourcePackFile
+		//
+		bool ResourcePackFile::open(const FilePathView packPath, const FilePathView mountPoint)
+		{
+			if (not m_view.open(packPath))
+			{
+				return false;
+			}
+
+			m_path = FileSystem::FullPath(packPath);
+			m_mountPoint = NormalizeMountPoint(mountPoint);
+
+			if (m_view.mappedSize() < sizeof(ResourcePackHeader))
+			{
+				return false;
+			}
+
+			std::memcpy(&m_header, m_view.data(), sizeof(ResourcePackHeader));
+
+			if (not validate())
+			{
+				return false;
+			}
+
+			const Byte* data = m_view.data();
+			m_entries	= reinterpret_cast<const ResourcePackEntry*>(data + m_header.entryTableOffset);
+			m_buckets	= reinterpret_cast<const uint32*>(data + m_header.bucketTableOffset);
+			m_blocks	= reinterpret_cast<const ResourcePackBlock*>(data + m_header.blockTableOffset);
+			m_paths		= reinterpret_cast<const char*>(data + m_header.pathTableOffset);
+
+			return true;
+		}
+
+		const FilePath& ResourcePackFile::path() const noexcept
+		{
+			return m_path;
+		}
+
+		const FilePath& ResourcePackFile::mountPoint() const noexcept
+		{
+			return m_mountPoint;
+		}
+
+		Optional<uint32> ResourcePackFile::find(const FilePathView path) const
+		{
+			if ((m_header.fileCount == 0) || (not path.starts_with(m_mountPoint)))
+			{
+				return none;
+			}
+
+			const std::string packedPath = Unicode::ToUTF8(path.substr(m_mountPoint.size()));
+			const uint64 bucketHash = ResourcePackBucketHash(ResourcePackPathHash(packedPath), m_header.seed);
+			const uint32 displacement = m_buckets[bucketHash % m_header.bucketCount];
+			const uint32 index = static_cast<uint32>(ResourcePackSlotHash(bucketHash, displacement) % m_header.fileCount);
+
+			// 完全ハッシュはパックに含まれないパスも何らかのスロットに写すので、パスを比較する
+			if (entryPath(m_entries[index]) != packedPath)
+			{
+				return none;
+			}
+
+			return index;
+		}
+
+		const ResourcePackEntry& ResourcePackFile::entry(const uint32 index) const noexcept
+		{
+			return m_entries[index];
+		}
+
+		const ResourcePackBlock& ResourcePackFile::block(const uint32 index) const noexcept
+		{
+			return m_blocks[index];
+		}
+
+		uint32 ResourcePackFile::blockSize() const noexcept
+		{
+			return m_header.blockSize;
+		}
+
+		const Byte* ResourcePackFile::data() const noexcept
+		{
+			return m_view.data();
+		}
+
+		Array<FilePath> ResourcePackFile::enumFiles() const
+		{
+			Array<FilePath> paths(Arg::reserve = m_header.fileCount);
+
+			for (uint32 i = 0; i < m_header.fileCount; ++i)
+			{
+				paths << (m_mountPoint + Unicode::FromUTF8(entryPath(m_entries[i])));
+			}
+
+			return paths;
+		}
+
+		bool ResourcePackFile::validate() const
+		{
+			const uint64 fileSize = m_view.mappedSize();
+
+			if ((std::memcmp(m_header.signature, ResourcePackSignature, sizeof(ResourcePackSignature)) != 0)
+				|| (m_header.version != ResourcePackVersion))
+			{
+				LOG_FAIL(U"❌ ResourcePack: `{}` is not a resource pack file"_fmt(m_path));
+				return false;
+			}
+
+			const auto inRange = [fileSize](const uint64 offset, const uint64 count, const uint64 elementSize)
+			{
+				return ((offset % 8) == 0) && (offset <= fileSize) && (count <= ((fileSize - offset) / elementSize));
+			};
+
+			if ((m_header.blockSize == 0)
+				|| (m_header.bucketCount == 0)
+				|| (not inRange(m_header.entryTableOffset, m_header.fileCount, sizeof(ResourcePackEntry)))
+				|| (not inRange(m_header.bucketTableOffset, m_header.bucketCount, sizeof(uint32)))
+				|| (m_header.blockTableOffset % 8)
+				|| (fileSize < m_header.blockTableOffset)
+				|| (m_header.pathTableOffset < m_header.blockTableOffset)
+				|| (fileSize < m_header.pathTableOffset)
+				|| ((fileSize - m_header.pathTableOffset) < m_header.pathTableSize))
+			{
+				LOG_FAIL(U"❌ ResourcePack: `{}` is broken"_fmt(m_path));
+				return false;
+			}
+
+			const uint64 blockCount = ((m_header.pathTableOffset - m_header.blockTableOffset) / sizeof(ResourcePackBlock));
+			const ResourcePackEntry* entries = reinterpret_cast<const ResourcePackEntry*>(m_view.data() + m_header.entryTableOffset);
+			const ResourcePackBlock* blocks = reinterpret_cast<const ResourcePackBlock*>(m_view.data() + m_header.blockTableOffset);
+
+			// 読み込み時に範囲を確認しなくて済むよう、マウントの時点ですべてのエントリーを確認する
+			for (uint32 i = 0; i < m_header.fileCount; ++i)
+			{
+				const ResourcePackEntry& entry = entries[i];
+
+				if (m_header.pathTableSize < (static_cast<uint64>(entry.pathOffset) + entry.pathLength))
+				{
+					LOG_FAIL(U"❌ ResourcePack: `{}` is broken"_fmt(m_path));
+					return false;
+				}
+
+				if (entry.blockCount == 0)
+				{
+					if ((fileSize < entry.offset) || ((fileSize - entry.offset) < entry.size))
+					{
+						LOG_FAIL(U"❌ ResourcePack: `{}` is broken"_fmt(m_path));
+						return false;
+					}
+
+					continue;
+				}
+
+				if ((blockCount < (static_cast<uint64>(entry.firstBlock) + entry.blockCount))
+					|| (((entry.size + m_header.blockSize - 1) / m_header.blockSize) != entry.blockCount))
+				{
+					LOG_FAIL(U"❌ ResourcePack: `{}` is broken"_fmt(m_path));
+					return false;
+				}
+
+				for (uint32 k = entry.firstBlock; k < (entry.firstBlock + entry.blockCount); ++k)
+				{
+					if ((fileSize < blocks[k].offset) || ((fileSize - blocks[k].offset) < blocks[k].compressedSize))
+					{
+						LOG_FAIL(U"❌ ResourcePack: `{}` is broken"_fmt(m_path));
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		std::string_view ResourcePackFile::entryPath(const ResourcePackEntry& entry) const noexcept
+		{
+			return{ (m_paths + entry.pathOffset), entry.pathLength };
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	マウントされているリソースパック
+		//
+		class MountedResourcePacks
+		{
+		public:
+
+			bool mount(const FilePathView packPath, const FilePathView mountPoint)
+			{
+				auto pack = std::make_shared<ResourcePackFile>();
+
+				if (not pack->open(packPath, mountPoint))
+				{
+					LOG_FAIL(U"❌ ResourcePack: Failed to mount `{}`"_fmt(packPath));
+					return false;
+				}
+
+				LOG_INFO(U"📦 ResourcePack: `{}` mounted on `{}`"_fmt(pack->path(), pack->mountPoint()));
+
+				std::lock_guard lock{ m_mutex };
+
+				m_packs.remove_if([&](const auto& p) { return (p->path() == pack->path()); });
+				m_packs.push_back(std::move(pack));
+				m_hasPacks = true;
+				updateResourceFiles_internal();
+
+				return true;
+			}
+
+			bool unmount(const FilePathView packPath)
+			{
+				const FilePath fullPath = FileSystem::FullPath(packPath);
+
+				std::lock_guard lock{ m_mutex };
+
+				const size_t count = m_packs.size();
+
+				m_packs.remove_if([&](const auto& p) { return (p->path() == fullPath); });
+				m_hasPacks = (not m_packs.isEmpty());
+				updateResourceFiles_internal();
+
+				return (m_packs.size() != count);
+			}
+
+			void unmountAll()
+			{
+				std::lock_guard lock{ m_mutex };
+
+				m_packs.clear();
+				m_hasPacks = false;
+				updateResourceFiles_internal();
+			}
+
+			[[nodiscard]]
+			std::shared_ptr<const ResourcePackFile> find(const FilePathView path, uint32& index) const
+			{
+				// リソースパックを使わないアプリケーションでは、ロックも取らない
+				if (not m_hasPacks.load(std::memory_order_relaxed))
+				{
+					return nullptr;
+				}
+
+				std::shared_lock lock{ m_mutex };
+
+				// 後からマウントしたパックを優先する
+				for (auto it = m_packs.rbegin(); it != m_packs.rend(); ++it)
+				{
+					if (const auto result = (*it)->find(path))
+					{
+						index = *result;
+						return *it;
+					}
+				}
+
+				return nullptr;
+			}
+
+			[[nodiscard]]
+			Array<FilePath> enumFiles() const
+			{
+				std::shared_lock lock{ m_mutex };
+
+				Array<FilePath> paths;
+
+				for (const auto& pack : m_packs)
+				{
+					paths.append(pack->enumFiles());
+				}
+
+				return paths.sort_and_unique();
+			}
+
+			[[nodiscard]]
+			const Array<FilePath>& enumResourceFiles(const Array<FilePath>& resourceFilePaths) const noexcept
+			{
+				if (const Array<FilePath>* paths = m_resourceFilePaths.load(std::memory_order_acquire))
+				{
+					return *paths;
+				}
+
+				return resourceFilePaths;
+			}
+
+		private:
+
+			mutable std::shared_mutex m_mutex;
+
+			Array<std::shared_ptr<const ResourcePackFile>> m_packs;
+
+			std::atomic<bool> m_hasPacks = false;
+
+			// これまでに作成した EnumResourceFiles() の一覧（最近使われたものほど後ろ）
+			// 呼び出し側が参照を保持している可能性があるため、MaxResourceFileLists 個を超えるまでは解放しない
+			Array<std::unique_ptr<const Array<FilePath>>> m_resourceFileLists;
+
+			// EnumResourceFiles() が返す一覧。リソースパックがマウントされていない場合は nullptr
+			std::atomic<const Array<FilePath>*> m_resourceFilePaths = nullptr;
+
+			// EnumResourceFiles() が返す一覧を、マウントの状態が変わったときに作り直す（m_mutex を保持した状態で呼ぶ）
+			void updateResourceFiles_internal()
+			{
+				if (m_packs.isEmpty())
+				{
+					m_resourceFilePaths.store(nullptr, std::memory_order_release);
+					return;
+				}
+
+				Array<FilePath> paths = init::GetResourceFilePaths();
+
+				for (const auto& pack : m_packs)
+				{
+					paths.append(pack->enumFiles());
+				}
+
+				paths.sort_and_unique();
+
+				// 同じ組み合わせのリソースパックを再びマウントした場合は、以前の一覧を使う
+				const auto it = std::find_if(m_resourceFileLists.begin(), m_resourceFileLists.end(),
+					[&paths](const std::unique_ptr<const Array<FilePath>>& list) { return (*list == paths); });
+
+				if (it != m_resourceFileLists.end())
+				{
+					std::rotate(it, (it + 1), m_resourceFileLists.end());
+				}
+				else
+				{
+					if (MaxResourceFileLists <= m_resourceFileLists.size())
+					{
+						m_resourceFileLists.pop_front();
+					}
+
+					m_resourceFileLists.push_back(std::make_unique<const Array<FilePath>>(std::move(paths)));
+				}
+
+				m_resourceFilePaths.store(m_resourceFileLists.back().get(), std::memory_order_release);
+			}
+		};
+
+		[[nodiscard]]
+		static MountedResourcePacks& GetMountedResourcePacks()
+		{
+			static MountedResourcePacks mountedResourcePacks;
+			return mountedResourcePacks;
+		}
+
+		bool MountResourcePack(const FilePathView packPath, const FilePathView mountPoint)
+		{
+			return GetMountedResourcePacks().mount(packPath, mountPoint);
+		}
+
+		bool UnmountResourcePack(const FilePathView packPath)
+		{
+			return GetMountedResourcePacks().unmount(packPath);
+		}
+
+		void UnmountAllResourcePacks()
+		{
+			GetMountedResourcePacks().unmountAll();
+		}
+
+		bool IsPackedFile(const FilePathView path)
+		{
+			uint32 index;
+			return static_cast<bool>(GetMountedResourcePacks().find(path, index));
+		}
+
+		Array<FilePath> EnumPackedFiles()
+		{
+			return GetMountedResourcePacks().enumFiles();
+		}
+
+		const Array<FilePath>& EnumResourceFilesWithPacks(const Array<FilePath>& resourceFilePaths) noexcept
+		{
+			return GetMountedResourcePacks().enumResourceFiles(resourceFilePaths);
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	PackedFileReader
+		//
+		void PackedFileReader::DCtxDeleter::operator()(ZSTD_DCtx_s* dctx) const noexcept
+		{
+			ZSTD_freeDCtx(dctx);
+		}
+
+		PackedFileReader::PackedFileReader() = default;
+
+		PackedFileReader::PackedFileReader(PackedFileReader&&) noexcept = default;
+
+		PackedFileReader::~PackedFileReader() = default;
+
+		PackedFileReader& PackedFileReader::operator =(PackedFileReader&&) noexcept = default;
+
+		bool PackedFileReader::open(const FilePathView path)
+		{
+			close();
+
+			uint32 index = 0;
+
+			if (auto pack = GetMountedResourcePacks().find(path, index))
+			{
+				m_pack = std::move(pack);
+				m_entry = &m_pack->entry(index);
+				return true;
+			}
+
+			return false;
+		}
+
+		void PackedFileReader::close()
+		{
+			m_pack.reset();
+			m_entry = nullptr;
+			m_cachedBlock = UINT32_MAX;
+		}
+
+		bool PackedFileReader::isOpen() const noexcept
+		{
+			return (m_entry != nullptr);
+		}
+
+		int64 PackedFileReader::size() const noexcept
+		{
+			return (m_entry ? static_cast<int64>(m_entry->size) : 0);
+		}
+
+		const FilePath& PackedFileReader::packPath() const noexcept
+		{
+			static const FilePath EmptyPath;
+			return (m_pack ? m_pack->path() : EmptyPath);
+		}
+
+		const Byte* PackedFileReader::data() const noexcept
+		{
+			if ((not m_entry) || m_entry->blockCount)
+			{
+				return nullptr;
+			}
+
+			return (m_pack->data() + m_entry->offset);
+		}
+
+		int64 PackedFileReader::read(void* dst, const int64 pos, const int64 size)
+		{
+			if ((not m_entry) || (pos < 0) || (size <= 0))
+			{
+				return 0;
+			}
+
+			const int64 readBytes = Clamp<int64>(size, 0, (static_cast<int64>(m_entry->size) - pos));
+
+			if (readBytes <= 0)
+			{
+				return 0;
+			}
+
+			// 無圧縮のファイルはマップされたメモリから直接コピーする
+			if (m_entry->blockCount == 0)
+			{
+				std::memcpy(dst, (m_pack->data() + m_entry->offset + pos), static_cast<size_t>(readBytes));
+				return readBytes;
+			}
+
+			const uint64 blockSize = m_pack->blockSize();
+			Byte* pDst = static_cast<Byte*>(dst);
+			uint64 current = static_cast<uint64>(pos);
+			const uint64 end = (current + readBytes);
+
+			while (current < end)
+			{
+				const uint32 blockIndex = static_cast<uint32>(current / blockSize);
+				const uint64 blockBegin = (blockIndex * blockSize);
+				const size_t rawSize = static_cast<size_t>(Min(blockSize, (m_entry->size - blockBegin)));
+				const size_t offsetInBlock = static_cast<size_t>(current - blockBegin);
+				const size_t copySize = static_cast<size_t>(Min<uint64>((rawSize - offsetInBlock), (end - current)));
+
+				if ((offsetInBlock == 0) && (copySize == rawSize) && (blockIndex != m_cachedBlock))
+				{
+					// ブロック全体を読む場合は、出力先に直接展開する
+					if (not decompressBlock(blockIndex, pDst, rawSize))
+					{
+						return static_cast<int64>(pDst - static_cast<Byte*>(dst));
+					}
+				}
+				else
+				{
+					if (blockIndex != m_cachedBlock)
+					{
+						m_blockBuffer.resize(blockSize);
+
+						if (not decompressBlock(blockIndex, m_blockBuffer.data(), rawSize))
+						{
+							m_cachedBlock = UINT32_MAX;
+							return static_cast<int64>(pDst - static_cast<Byte*>(dst));
+						}
+
+						m_cachedBlock = blockIndex;
+					}
+
+					std::memcpy(pDst, (m_blockBuffer.data() + offsetInBlock), copySize);
+				}
+
+				pDst += copySize;
+				current += copySize;
+			}
+
+			return readBytes;
+		}
+
+		bool PackedFileReader::decompressBlock(const uint32 blockIndex, Byte* dst, const size_t rawSize)
+		{
+			const ResourcePackBlock& block = m_pack->block(m_entry->firstBlock + blockIndex);
+			const Byte* src = (m_pack->data() + block.offset);
+
+			if (block.compressedSize == rawSize)
+			{
+				std::memcpy(dst, src, rawSize);
+				return true;
+			}
+
+			if (not m_dctx)
+			{
+				m_dctx.reset(ZSTD_createDCtx());
+
+				if (not m_dctx)
+				{
+					return false;
+				}
+			}
+
+			const size_t result = ZSTD_decompressDCtx(m_dctx.get(), dst, rawSize, src, block.compressedSize);
+
+			if (ZSTD_isError(result) || (result != rawSize))
+			{
+				LOG_FAIL(U"❌ ResourcePack: Failed to decompress a block in `{}`"_fmt(m_pack->path()));
+				return false;
+			}
+
+			return true;
+		}
+	}
+}
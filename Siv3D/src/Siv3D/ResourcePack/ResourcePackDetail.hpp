@@ -0,0 +1,276 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <string_view>
+# include <Siv3D/ResourcePack.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/Optional.hpp>
+
+struct ZSTD_DCtx_s;
+
+namespace s3d
+{
+	namespace detail
+	{
+		// リソースパックファイルの構成:
+		//
+		// [ResourcePackHeader]
+		// [ファイルのデータ ...]			各ファイルは 16 バイト境界から始まる
+		// [ResourcePackEntry × fileCount]	完全ハッシュのスロット順
+		// [uint32 × bucketCount]			バケットごとの変位
+		// [ResourcePackBlock × blockCount]
+		// [パス文字列 (UTF-8)]
+
+		inline constexpr char8 ResourcePackSignature[8] = { 'S', '3', 'D', 'P', 'A', 'C', 'K', '\0' };
+
+		inline constexpr uint32 ResourcePackVersion = 1;
+
+		// 圧縮の単位となるブロックの、展開後のサイズ
+		inline constexpr uint32 ResourcePackBlockSize = (256 * 1024);
+
+		struct ResourcePackHeader
+		{
+			char8 signature[8];
+
+			uint32 version;
+
+			uint32 fileCount;
+
+			uint32 bucketCount;
+
+			uint32 blockSize;
+
+			uint64 seed;
+
+			uint64 entryTableOffset;
+
+			uint64 bucketTableOffset;
+
+			uint64 blockTableOffset;
+
+			uint64 pathTableOffset;
+
+			uint64 pathTableSize;
+		};
+
+		struct ResourcePackEntry
+		{
+			// 無圧縮の場合はデータの位置、圧縮されている場合は未使用
+			uint64 offset;
+
+			// 展開後のサイズ
+			uint64 size;
+
+			uint32 pathOffset;
+
+			uint32 pathLength;
+
+			uint32 firstBlock;
+
+			// 0 の場合は無圧縮
+			uint32 blockCount;
+		};
+
+		struct ResourcePackBlock
+		{
+			uint64 offset;
+
+			// 展開後のサイズと同じ場合は無圧縮
+			uint32 compressedSize;
+
+			uint32 reserved;
+		};
+
+		static_assert(sizeof(ResourcePackHeader) == 72);
+		static_assert(sizeof(ResourcePackEntry) == 32);
+		static_assert(sizeof(ResourcePackBlock) == 16);
+
+		// パスのハッシュ値。ビルドしたプラットフォームによらず同じ値になるよう、64-bit の FNV-1a を使う
+		[[nodiscard]]
+		constexpr uint64 ResourcePackPathHash(const std::string_view utf8Path) noexcept
+		{
+			uint64 hash = 14695981039346656037ULL;
+
+			for (const char ch : utf8Path)
+			{
+				hash ^= static_cast<uint8>(ch);
+				hash *= 1099511628211ULL;
+			}
+
+			return hash;
+		}
+
+		[[nodiscard]]
+		constexpr uint64 ResourcePackMix(uint64 x) noexcept
+		{
+			x ^= (x >> 30);
+			x *= 0xbf58476d1ce4e5b9ULL;
+			x ^= (x >> 27);
+			x *= 0x94d049bb133111ebULL;
+			x ^= (x >> 31);
+			return x;
+		}
+
+		[[nodiscard]]
+		constexpr uint64 ResourcePackBucketHash(const uint64 pathHash, const uint64 seed) noexcept
+		{
+			return ResourcePackMix(pathHash ^ seed);
+		}
+
+		[[nodiscard]]
+		constexpr uint64 ResourcePackSlotHash(const uint64 bucketHash, const uint32 displacement) noexcept
+		{
+			return ResourcePackMix(bucketHash + ((displacement + 1ULL) * 0x9e3779b97f4a7c15ULL));
+		}
+
+		/// @brief マウントされたリソースパックファイル
+		/// @remark 開いた後は変更されないため、複数のスレッドから同時に読み込めます。
+		class ResourcePackFile
+		{
+		public:
+
+			[[nodiscard]]
+			bool open(FilePathView packPath, FilePathView mountPoint);
+
+			[[nodiscard]]
+			const FilePath& path() const noexcept;
+
+			[[nodiscard]]
+			const FilePath& mountPoint() const noexcept;
+
+			[[nodiscard]]
+			Optional<uint32> find(FilePathView path) const;
+
+			[[nodiscard]]
+			const ResourcePackEntry& entry(uint32 index) const noexcept;
+
+			[[nodiscard]]
+			const ResourcePackBlock& block(uint32 index) const noexcept;
+
+			[[nodiscard]]
+			uint32 blockSize() const noexcept;
+
+			[[nodiscard]]
+			const Byte* data() const noexcept;
+
+			[[nodiscard]]
+			Array<FilePath> enumFiles() const;
+
+		private:
+
+			MemoryMappedFileView m_view;
+
+			FilePath m_path;
+
+			FilePath m_mountPoint;
+
+			ResourcePackHeader m_header{};
+
+			const ResourcePackEntry* m_entries = nullptr;
+
+			const uint32* m_buckets = nullptr;
+
+			const ResourcePackBlock* m_blocks = nullptr;
+
+			const char* m_paths = nullptr;
+
+			[[nodiscard]]
+			bool validate() const;
+
+			[[nodiscard]]
+			std::string_view entryPath(const ResourcePackEntry& entry) const noexcept;
+		};
+
+		/// @brief リソースパック内のファイルの読み込み
+		class PackedFileReader
+		{
+		public:
+
+			PackedFileReader();
+
+			PackedFileReader(PackedFileReader&&) noexcept;
+
+			~PackedFileReader();
+
+			PackedFileReader& operator =(PackedFileReader&&) noexcept;
+
+			/// @brief マウントされているリソースパックから、ファイルを開きます。
+			/// @param path ファイルパス
+			/// @return ファイルがいずれかのリソースパックに含まれる場合 true, それ以外の場合は false
+			bool open(FilePathView path);
+
+			void close();
+
+			[[nodiscard]]
+			bool isOpen() const noexcept;
+
+			[[nodiscard]]
+			int64 size() const noexcept;
+
+			[[nodiscard]]
+			const FilePath& packPath() const noexcept;
+
+			/// @brief 無圧縮で格納されているファイルの、メモリマップされたデータを返します。
+			/// @return ファイルのデータ。圧縮されている場合は nullptr
+			[[nodiscard]]
+			const Byte* data() const noexcept;
+
+			/// @brief ファイルの指定した位置からデータを読み込みます。
+			/// @remark 必要なブロックだけを展開し、直前に展開したブロックを再利用します。
+			int64 read(void* dst, int64 pos, int64 size);
+
+		private:
+
+			struct DCtxDeleter
+			{
+				void operator()(ZSTD_DCtx_s* dctx) const noexcept;
+			};
+
+			std::shared_ptr<const ResourcePackFile> m_pack;
+
+			const ResourcePackEntry* m_entry = nullptr;
+
+			std::unique_ptr<ZSTD_DCtx_s, DCtxDeleter> m_dctx;
+
+			Array<Byte> m_blockBuffer;
+
+			// m_blockBuffer に展開されているブロック
+			uint32 m_cachedBlock = UINT32_MAX;
+
+			[[nodiscard]]
+			bool decompressBlock(uint32 blockIndex, Byte* dst, size_t rawSize);
+		};
+
+		[[nodiscard]]
+		bool CreateResourcePack(const Array<FilePath>& files, FilePathView baseDirectory, FilePathView outputPath, int32 compressionLevel);
+
+		bool MountResourcePack(FilePathView packPath, FilePathView mountPoint);
+
+		bool UnmountResourcePack(FilePathView packPath);
+
+		void UnmountAllResourcePacks();
+
+		[[nodiscard]]
+		bool IsPackedFile(FilePathView path);
+
+		[[nodiscard]]
+		Array<FilePath> EnumPackedFiles();
+
+		/// @brief ファイルとして存在するリソースファイルに、マウントされているリソースパック内のファイルを加えた一覧を返します。
+		/// @param resourceFilePaths ファイルとして存在するリソースファイルの一覧
+		/// @return リソースファイルの一覧。リソースパックがマウントされていない場合は `resourceFilePaths`
+		/// @remark 一覧はマウントの状態が変わるときに作成されます。返した参照は、異なる一覧がさらに 15 個作成されるまで有効です。
+		[[nodiscard]]
+		const Array<FilePath>& EnumResourceFilesWithPacks(const Array<FilePath>& resourceFilePaths) noexcept;
+	}
+}
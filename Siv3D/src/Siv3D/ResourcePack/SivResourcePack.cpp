@@ -0,0 +1,81 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ResourcePack.hpp>
+# include <Siv3D/Resource.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "ResourcePackDetail.hpp"
+
+namespace s3d
+{
+	namespace ResourcePack
+	{
+		bool Create(const FilePathView sourceDirectory, const FilePathView outputPath, const int32 compressionLevel)
+		{
+			if (not FileSystem::IsDirectory(sourceDirectory))
+			{
+				LOG_FAIL(U"❌ ResourcePack::Create(): `{}` is not a directory"_fmt(sourceDirectory));
+				return false;
+			}
+
+			Array<FilePath> files = FileSystem::DirectoryContents(sourceDirectory, Recursive::Yes);
+
+			files.remove_if(FileSystem::IsDirectory);
+
+			// 出力先がディレクトリ内にある場合、古いリソースパック自身はまとめない
+			if (const FilePath outputFullPath = FileSystem::FullPath(outputPath))
+			{
+				files.remove(outputFullPath);
+			}
+
+			// 同じファイルからは同じリソースパックファイルが作られるよう、順番をそろえる
+			files.sort();
+
+			return detail::CreateResourcePack(files, sourceDirectory, outputPath, compressionLevel);
+		}
+
+		bool Create(const Array<FilePath>& files, const FilePathView baseDirectory, const FilePathView outputPath, const int32 compressionLevel)
+		{
+			return detail::CreateResourcePack(files, baseDirectory, outputPath, compressionLevel);
+		}
+
+		bool Mount(const FilePathView packPath)
+		{
+			return detail::MountResourcePack(packPath, Resource(U""));
+		}
+
+		bool Mount(const FilePathView packPath, const FilePathView mountPoint)
+		{
+			return detail::MountResourcePack(packPath, mountPoint);
+		}
+
+		bool Unmount(const FilePathView packPath)
+		{
+			return detail::UnmountResourcePack(packPath);
+		}
+
+		void UnmountAll()
+		{
+			detail::UnmountAllResourcePacks();
+		}
+
+		bool Contains(const FilePathView path)
+		{
+			return detail::IsPackedFile(path);
+		}
+
+		Array<FilePath> EnumFiles()
+		{
+			return detail::EnumPackedFiles();
+		}
+	}
+}
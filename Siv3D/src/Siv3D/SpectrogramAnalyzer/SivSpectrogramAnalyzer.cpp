@@ -0,0 +1,87 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include <Siv3D/SpectrogramAnalyzer.hpp>
+# include <Siv3D/Wave.hpp>
+# include "SpectrogramAnalyzerDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline constexpr size_t DefaultSpectrogramFFTSize = 2048;
+	}
+
+	SpectrogramAnalyzer::SpectrogramAnalyzer()
+		: SpectrogramAnalyzer{ detail::DefaultSpectrogramFFTSize } {}
+
+	SpectrogramAnalyzer::SpectrogramAnalyzer(const size_t fftSize, const size_t hopSize, const FFTWindowFunction windowFunction)
+		: pImpl{ std::make_shared<SpectrogramAnalyzerDetail>(fftSize, hopSize, windowFunction) } {}
+
+	SpectrogramAnalyzer::~SpectrogramAnalyzer()
+	{
+
+	}
+
+	size_t SpectrogramAnalyzer::fftSize() const noexcept
+	{
+		return pImpl->fftSize();
+	}
+
+	size_t SpectrogramAnalyzer::hopSize() const noexcept
+	{
+		return pImpl->hopSize();
+	}
+
+	size_t SpectrogramAnalyzer::bins() const noexcept
+	{
+		return pImpl->bins();
+	}
+
+	FFTWindowFunction SpectrogramAnalyzer::windowFunction() const noexcept
+	{
+		return pImpl->windowFunction();
+	}
+
+	void SpectrogramAnalyzer::analyze(Spectrogram& dst, const float* samples, const size_t length, const uint32 sampleRate, const Parallel parallel)
+	{
+		pImpl->analyze(dst, samples, length, sampleRate, parallel);
+	}
+
+	void SpectrogramAnalyzer::analyze(Spectrogram& dst, const Wave& wave, const Parallel parallel)
+	{
+		pImpl->analyze(dst, wave, 0, wave.size(), parallel);
+	}
+
+	void SpectrogramAnalyzer::analyze(Spectrogram& dst, const Wave& wave, const size_t beginSample, const size_t sampleCount, const Parallel parallel)
+	{
+		pImpl->analyze(dst, wave, beginSample, sampleCount, parallel);
+	}
+
+	size_t SpectrogramAnalyzer::process(Spectrogram& dst, const float* samples, const size_t length, const uint32 sampleRate)
+	{
+		return pImpl->process(dst, samples, length, sampleRate);
+	}
+
+	size_t SpectrogramAnalyzer::process(Spectrogram& dst, IAudioStream& stream, const size_t sampleCount, const uint32 sampleRate)
+	{
+		return pImpl->process(dst, stream, sampleCount, sampleRate);
+	}
+
+	size_t SpectrogramAnalyzer::process(Spectrogram& dst, const Microphone& microphone)
+	{
+		return pImpl->process(dst, microphone);
+	}
+
+	void SpectrogramAnalyzer::resetStream()
+	{
+		pImpl->resetStream();
+	}
+}
@@ -0,0 +1,326 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include <cmath>
+# include <Siv3D/Wave.hpp>
+# include <Siv3D/IAudioStream.hpp>
+# include <Siv3D/Microphone.hpp>
+# include <Siv3D/Memory.hpp>
+# include <Siv3D/MathConstants.hpp>
+# include <Siv3D/ParallelFor.hpp>
+# include <Siv3D/Error.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "SpectrogramAnalyzerDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 並列に計算するときに、1 回に取り出すフレーム数
+		inline constexpr size_t SpectrogramFrameGrainSize = 16;
+
+		[[nodiscard]]
+		static Array<float> MakeWindow(const size_t size, const FFTWindowFunction windowFunction)
+		{
+			Array<float> window(size, 1.0f);
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				// STFT 用に、周期的な窓関数を使う
+				const double t = (Math::TwoPi * i / size);
+
+				switch (windowFunction)
+				{
+				case FFTWindowFunction::Hann:
+					window[i] = static_cast<float>(0.5 - 0.5 * std::cos(t));
+					break;
+				case FFTWindowFunction::Hamming:
+					window[i] = static_cast<float>(0.54 - 0.46 * std::cos(t));
+					break;
+				case FFTWindowFunction::Blackman:
+					window[i] = static_cast<float>(0.42 - 0.5 * std::cos(t) + 0.08 * std::cos(2 * t));
+					break;
+				default:
+					break;
+				}
+			}
+
+			return window;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	Workspace
+	//
+	////////////////////////////////////////////////////////////////
+
+	SpectrogramAnalyzer::SpectrogramAnalyzerDetail::Workspace::Workspace(const size_t fftSize)
+		: input{ AlignedMalloc<float, 16>(fftSize) }
+		, work{ AlignedMalloc<float, 16>(fftSize) } {}
+
+	SpectrogramAnalyzer::SpectrogramAnalyzerDetail::Workspace::~Workspace()
+	{
+		AlignedFree(work);
+
+		AlignedFree(input);
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	SpectrogramAnalyzerDetail
+	//
+	////////////////////////////////////////////////////////////////
+
+	SpectrogramAnalyzer::SpectrogramAnalyzerDetail::SpectrogramAnalyzerDetail(const size_t fftSize, const size_t hopSize, const FFTWindowFunction windowFunction)
+		: m_fftSize{ fftSize }
+		, m_hopSize{ hopSize ? hopSize : (fftSize / 4) }
+		, m_windowFunction{ windowFunction }
+		, m_setup{ (fftSize && ((fftSize % 32) == 0)) ? ::pffft_new_setup(static_cast<int>(fftSize), PFFFT_REAL) : nullptr }
+		, m_window{ detail::MakeWindow(fftSize, windowFunction) }
+		, m_workspace{ fftSize }
+	{
+		if (not m_setup)
+		{
+			throw Error{ U"SpectrogramAnalyzer: Unsupported FFT size ({})"_fmt(fftSize) };
+		}
+
+		double sum = 0.0;
+
+		for (const auto& w : m_window)
+		{
+			sum += w;
+		}
+
+		m_scale = static_cast<float>(2.0 / sum);
+	}
+
+	SpectrogramAnalyzer::SpectrogramAnalyzerDetail::~SpectrogramAnalyzerDetail()
+	{
+		::pffft_destroy_setup(m_setup);
+	}
+
+	size_t SpectrogramAnalyzer::SpectrogramAnalyzerDetail::fftSize() const noexcept
+	{
+		return m_fftSize;
+	}
+
+	size_t SpectrogramAnalyzer::SpectrogramAnalyzerDetail::hopSize() const noexcept
+	{
+		return m_hopSize;
+	}
+
+	size_t SpectrogramAnalyzer::SpectrogramAnalyzerDetail::bins() const noexcept
+	{
+		return (m_fftSize / 2);
+	}
+
+	FFTWindowFunction SpectrogramAnalyzer::SpectrogramAnalyzerDetail::windowFunction() const noexcept
+	{
+		return m_windowFunction;
+	}
+
+	void SpectrogramAnalyzer::SpectrogramAnalyzerDetail::analyze(Spectrogram& dst, const float* samples, const size_t length, const uint32 sampleRate, const Parallel parallel)
+	{
+		analyzeFrames(dst, length, sampleRate, parallel, [samples](const size_t begin, const size_t count, float* pDst)
+		{
+			std::memcpy(pDst, (samples + begin), (sizeof(float) * count));
+		});
+	}
+
+	void SpectrogramAnalyzer::SpectrogramAnalyzerDetail::analyze(Spectrogram& dst, const Wave& wave, size_t beginSample, size_t sampleCount, const Parallel parallel)
+	{
+		beginSample = Min(beginSample, wave.size());
+		sampleCount = Min(sampleCount, (wave.size() - beginSample));
+
+		const WaveSample* pSrc = (wave.data() + beginSample);
+
+		analyzeFrames(dst, sampleCount, wave.sampleRate(), parallel, [pSrc](const size_t begin, const size_t count, float* pDst)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const WaveSample& sample = pSrc[begin + i];
+				pDst[i] = ((sample.left + sample.right) * 0.5f);
+			}
+		});
+	}
+
+	size_t SpectrogramAnalyzer::SpectrogramAnalyzerDetail::process(Spectrogram& dst, const float* samples, const size_t length, const uint32 sampleRate)
+	{
+		prepare(dst, sampleRate);
+
+		m_stream.insert(m_stream.end(), samples, (samples + length));
+
+		const size_t available = ((m_streamOffset <= m_stream.size()) ? (m_stream.size() - m_streamOffset) : 0);
+
+		if (available < m_fftSize)
+		{
+			return 0;
+		}
+
+		const size_t newFrames = (1 + (available - m_fftSize) / m_hopSize);
+		const size_t firstFrame = dst.frames();
+
+		dst.magnitudes.resize(bins(), (firstFrame + newFrames));
+
+		for (size_t i = 0; i < newFrames; ++i)
+		{
+			std::memcpy(m_workspace.input, (m_stream.data() + m_streamOffset), (sizeof(float) * m_fftSize));
+
+			transform(m_workspace, dst.magnitudes[firstFrame + i]);
+
+			m_streamOffset += m_hopSize;
+		}
+
+		// 使い終わったサンプルを捨てる。hopSize が fftSize より大きい場合は、次に届くサンプルの先頭も読み飛ばす
+		const size_t consumed = Min(m_streamOffset, m_stream.size());
+		m_stream.erase(m_stream.begin(), (m_stream.begin() + consumed));
+		m_streamOffset -= consumed;
+
+		return newFrames;
+	}
+
+	size_t SpectrogramAnalyzer::SpectrogramAnalyzerDetail::process(Spectrogram& dst, IAudioStream& stream, const size_t sampleCount, const uint32 sampleRate)
+	{
+		m_left.resize(sampleCount);
+		m_right.resize(sampleCount);
+
+		stream.getAudio(m_left.data(), m_right.data(), sampleCount);
+
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			m_left[i] = ((m_left[i] + m_right[i]) * 0.5f);
+		}
+
+		return process(dst, m_left.data(), sampleCount, sampleRate);
+	}
+
+	size_t SpectrogramAnalyzer::SpectrogramAnalyzerDetail::process(Spectrogram& dst, const Microphone& microphone)
+	{
+		if (not microphone.isRecording())
+		{
+			return 0;
+		}
+
+		const Wave& buffer = microphone.getBuffer();
+		const size_t bufferLength = buffer.size();
+		const size_t pos = microphone.posSample();
+
+		if ((not m_microphonePos) || (bufferLength <= *m_microphonePos))
+		{
+			m_microphonePos = pos;
+			return 0;
+		}
+
+		// マイクのバッファはリングバッファになっている
+		const size_t sampleCount = ((pos + bufferLength - *m_microphonePos) % bufferLength);
+
+		m_left.resize(sampleCount);
+
+		for (size_t i = 0, readPos = *m_microphonePos; i < sampleCount; ++i)
+		{
+			const WaveSample& sample = buffer[readPos];
+			m_left[i] = ((sample.left + sample.right) * 0.5f);
+
+			if (++readPos == bufferLength)
+			{
+				readPos = 0;
+			}
+		}
+
+		m_microphonePos = pos;
+
+		return process(dst, m_left.data(), sampleCount, microphone.getSampleRate());
+	}
+
+	void SpectrogramAnalyzer::SpectrogramAnalyzerDetail::resetStream()
+	{
+		m_stream.clear();
+		m_streamOffset = 0;
+		m_microphonePos.reset();
+	}
+
+	void SpectrogramAnalyzer::SpectrogramAnalyzerDetail::prepare(Spectrogram& dst, const uint32 sampleRate) const
+	{
+		// 設定の異なる結果には追加できない
+		if ((dst.bins() != bins()) || (dst.hopSize != m_hopSize) || (dst.sampleRate != sampleRate))
+		{
+			dst.magnitudes.clear();
+		}
+
+		dst.resolution = (static_cast<double>(sampleRate) / m_fftSize);
+		dst.sampleRate = sampleRate;
+		dst.hopSize = m_hopSize;
+	}
+
+	void SpectrogramAnalyzer::SpectrogramAnalyzerDetail::transform(Workspace& workspace, float* dst) const
+	{
+		float* pInout = workspace.input;
+
+		for (size_t i = 0; i < m_fftSize; ++i)
+		{
+			pInout[i] *= m_window[i];
+		}
+
+		::pffft_transform_ordered(m_setup, pInout, pInout, workspace.work, PFFFT_FORWARD);
+
+		// pInout[0] は直流成分、pInout[1] はナイキスト周波数の成分（いずれも実数）
+		dst[0] = (std::abs(pInout[0]) * m_scale);
+
+		for (size_t i = 1; i < bins(); ++i)
+		{
+			const float re = pInout[i * 2];
+			const float im = pInout[i * 2 + 1];
+			dst[i] = (std::sqrt(re * re + im * im) * m_scale);
+		}
+	}
+
+	template <class Reader>
+	void SpectrogramAnalyzer::SpectrogramAnalyzerDetail::analyzeFrames(Spectrogram& dst, const size_t length, const uint32 sampleRate, const Parallel parallel, Reader reader)
+	{
+		prepare(dst, sampleRate);
+
+		const size_t frames = ((length + m_hopSize - 1) / m_hopSize);
+
+		dst.magnitudes.resize(bins(), frames);
+
+		const auto analyzeFrame = [&](Workspace& workspace, const size_t frame)
+		{
+			const size_t begin = (frame * m_hopSize);
+			const size_t count = Min(m_fftSize, (length - begin));
+
+			reader(begin, count, workspace.input);
+			std::fill((workspace.input + count), (workspace.input + m_fftSize), 0.0f);
+
+			transform(workspace, dst.magnitudes[frame]);
+		};
+
+		if (parallel && (detail::SpectrogramFrameGrainSize < frames))
+		{
+			ParallelFor(0, frames, [&](const size_t first, const size_t last)
+			{
+				Workspace workspace{ m_fftSize };
+
+				for (size_t frame = first; frame < last; ++frame)
+				{
+					analyzeFrame(workspace, frame);
+				}
+
+			}, detail::SpectrogramFrameGrainSize);
+		}
+		else
+		{
+			for (size_t frame = 0; frame < frames; ++frame)
+			{
+				analyzeFrame(m_workspace, frame);
+			}
+		}
+	}
+}
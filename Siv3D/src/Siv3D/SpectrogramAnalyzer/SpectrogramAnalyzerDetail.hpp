@@ -0,0 +1,105 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <Siv3D/SpectrogramAnalyzer.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Optional.hpp>
+# include <ThirdParty/pffft/pffft.h>
+
+namespace s3d
+{
+	class SpectrogramAnalyzer::SpectrogramAnalyzerDetail
+	{
+	public:
+
+		SpectrogramAnalyzerDetail(size_t fftSize, size_t hopSize, FFTWindowFunction windowFunction);
+
+		~SpectrogramAnalyzerDetail();
+
+		[[nodiscard]]
+		size_t fftSize() const noexcept;
+
+		[[nodiscard]]
+		size_t hopSize() const noexcept;
+
+		[[nodiscard]]
+		size_t bins() const noexcept;
+
+		[[nodiscard]]
+		FFTWindowFunction windowFunction() const noexcept;
+
+		void analyze(Spectrogram& dst, const float* samples, size_t length, uint32 sampleRate, Parallel parallel);
+
+		void analyze(Spectrogram& dst, const Wave& wave, size_t beginSample, size_t sampleCount, Parallel parallel);
+
+		size_t process(Spectrogram& dst, const float* samples, size_t length, uint32 sampleRate);
+
+		size_t process(Spectrogram& dst, IAudioStream& stream, size_t sampleCount, uint32 sampleRate);
+
+		size_t process(Spectrogram& dst, const Microphone& microphone);
+
+		void resetStream();
+
+	private:
+
+		// FFT の入出力と作業領域。並列に計算する場合はスレッドごとに用意する
+		class Workspace
+		{
+		public:
+
+			explicit Workspace(size_t fftSize);
+
+			Workspace(const Workspace&) = delete;
+
+			Workspace& operator =(const Workspace&) = delete;
+
+			~Workspace();
+
+			float* input = nullptr;
+
+			float* work = nullptr;
+		};
+
+		size_t m_fftSize = 0;
+
+		size_t m_hopSize = 0;
+
+		FFTWindowFunction m_windowFunction = FFTWindowFunction::Hann;
+
+		PFFFT_Setup* m_setup = nullptr;
+
+		Array<float> m_window;
+
+		// 振幅を正弦波の振幅に揃えるための係数
+		float m_scale = 0.0f;
+
+		Workspace m_workspace;
+
+		// ストリーミング入力のうち、まだフレームにしていないサンプル
+		Array<float> m_stream;
+
+		size_t m_streamOffset = 0;
+
+		Array<float> m_left;
+
+		Array<float> m_right;
+
+		Optional<size_t> m_microphonePos;
+
+		void prepare(Spectrogram& dst, uint32 sampleRate) const;
+
+		// workspace.input の fftSize() 個のサンプルから、bins() 個の振幅を dst に書き込む
+		void transform(Workspace& workspace, float* dst) const;
+
+		template <class Reader>
+		void analyzeFrames(Spectrogram& dst, size_t length, uint32 sampleRate, Parallel parallel, Reader reader);
+	};
+}
@@ -26,7 +26,12 @@ namespace s3d
 
 	void TCPServer::startAcceptMulti(const uint16 port)
 	{
-		pImpl->startAcceptMulti(port);
+		pImpl->startAcceptMulti(port, 1);
+	}
+
+	void TCPServer::startAcceptMulti(const uint16 port, const size_t numThreads)
+	{
+		pImpl->startAcceptMulti(port, numThreads);
 	}
 
 	void TCPServer::cancelAccept()
@@ -64,6 +69,11 @@ namespace s3d
 		return pImpl->getSessionIDs();
 	}
 
+	Array<TCPSessionID> TCPServer::getReadableSessionIDs(const size_t minSize) const
+	{
+		return pImpl->getReadableSessionIDs(minSize);
+	}
+
 	uint16 TCPServer::port() const
 	{
 		return pImpl->port();
@@ -93,4 +103,19 @@ namespace s3d
 	{
 		return pImpl->send(data, size, id);
 	}
+
+	bool TCPServer::send(Blob&& data, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->send(std::move(data), id);
+	}
+
+	size_t TCPServer::broadcast(const void* data, const size_t size)
+	{
+		return pImpl->broadcast(std::make_shared<const Blob>(data, size));
+	}
+
+	size_t TCPServer::broadcast(Blob&& data)
+	{
+		return pImpl->broadcast(std::make_shared<const Blob>(std::move(data)));
+	}
 }
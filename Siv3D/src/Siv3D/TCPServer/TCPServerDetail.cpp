@@ -13,81 +13,480 @@
 
 namespace s3d
 {
-	TCPServer::TCPServerDetail::TCPServerDetail()
-		: m_io_service(std::make_shared<asio::io_service>())
+	namespace detail
 	{
+		asio::mutable_buffer ReceiveBuffer::prepare()
+		{
+			const size_t readable = m_size.load(std::memory_order_acquire);
 
-	}
+			if (readable == 0)
+			{
+				m_head = 0;
+			}
 
-	TCPServer::TCPServerDetail::~TCPServerDetail()
-	{
-		disconnect();
-	}
+			if (readable == m_data.size())
+			{
+				if (MaxCapacity <= m_data.size())
+				{
+					return{};
+				}
 
-	void TCPServer::TCPServerDetail::startAccept(const uint16 port)
-	{
-		if (m_accepting)
+				grow();
+			}
+
+			const size_t capacity = m_data.size();
+			const size_t tail = ((m_head + readable) % capacity);
+			const size_t contiguous = ((tail < m_head) ? (m_head - tail) : (capacity - tail));
+
+			return asio::buffer((m_data.data() + tail), contiguous);
+		}
+
+		void ReceiveBuffer::commit(const size_t size) noexcept
 		{
-			cancelAccept();
+			m_size.fetch_add(size, std::memory_order_release);
 		}
 
-		m_accepting = true;
+		size_t ReceiveBuffer::size() const noexcept
+		{
+			return m_size.load(std::memory_order_acquire);
+		}
 
-		m_allowMulti = false;
+		void ReceiveBuffer::peek(void* dst, const size_t size) const noexcept
+		{
+			const size_t first = Min(size, (m_data.size() - m_head));
 
-		m_port = port;
+			std::memcpy(dst, (m_data.data() + m_head), first);
+
+			std::memcpy((static_cast<Byte*>(dst) + first), m_data.data(), (size - first));
+		}
 
-		if (!m_work)
+		void ReceiveBuffer::consume(const size_t size) noexcept
 		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
+			if (size == 0)
+			{
+				return;
+			}
 
-			m_io_service_thread = Async([this] { m_io_service->run(); });
+			m_head = ((m_head + size) % m_data.size());
+
+			m_size.fetch_sub(size, std::memory_order_release);
 		}
 
-		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+		void ReceiveBuffer::clear() noexcept
+		{
+			// 受信中の領域が解放されないよう、メモリは保持する
+			m_head = 0;
 
-		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
+			m_size.store(0, std::memory_order_release);
+		}
 
-		m_acceptor->async_accept(newSession->socket(),
-			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
-	}
+		void ReceiveBuffer::grow()
+		{
+			const size_t readable = m_size.load(std::memory_order_acquire);
 
-	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port)
-	{
-		if (m_accepting)
+			Array<Byte> newData(Max((m_data.size() * 2), InitialCapacity));
+
+			if (readable)
+			{
+				peek(newData.data(), readable);
+			}
+
+			m_data = std::move(newData);
+
+			m_head = 0;
+		}
+
+		void SendQueue::append(const void* data, const size_t size)
 		{
-			cancelAccept();
+			if (size == 0)
+			{
+				return;
+			}
+
+			// 直前のセグメントもコピーしたデータであれば、1 つにまとめる
+			if (segments && (not segments.back().blob))
+			{
+				segments.back().size += size;
+			}
+			else
+			{
+				segments.push_back({ nullptr, bytes.size(), size });
+			}
+
+			bytes.insert(bytes.end(), static_cast<const Byte*>(data), (static_cast<const Byte*>(data) + size));
 		}
 
-		m_accepting = true;
+		void SendQueue::append(const std::shared_ptr<const Blob>& blob)
+		{
+			if (blob->isEmpty())
+			{
+				return;
+			}
 
-		m_allowMulti = true;
+			segments.push_back({ blob, 0, blob->size() });
+		}
 
-		m_port = port;
+		bool SendQueue::isEmpty() const noexcept
+		{
+			return segments.isEmpty();
+		}
+
+		void SendQueue::clear() noexcept
+		{
+			bytes.clear();
+
+			segments.clear();
+		}
 
-		if (!m_work)
+		void SendQueue::getBuffers(std::vector<asio::const_buffer>& buffers) const
 		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
+			buffers.clear();
 
-			m_io_service_thread = Async([this] { m_io_service->run(); });
+			for (const auto& segment : segments)
+			{
+				const Byte* data = (segment.blob ? segment.blob->data() : bytes.data());
+
+				buffers.push_back(asio::buffer((data + segment.offset), segment.size));
+			}
 		}
 
-		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+		ServerSession::ServerSession(asio::io_service& io_service)
+			: m_socket(io_service)
+		{
 
-		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
+		}
 
-		m_acceptor->async_accept(newSession->socket(),
-			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+		ServerSession::~ServerSession()
+		{
+			close();
+		}
+
+		void ServerSession::close()
+		{
+			if (m_id == 0)
+			{
+				return;
+			}
+
+			m_isActive = false;
+
+			{
+				asio::error_code error;
+				m_socket.close(error);
+			}
+
+			{
+				std::lock_guard lock{ m_mutexSendingBuffer };
+				m_pendingBuffer.clear();
+			}
+
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+				m_receivedBuffer.clear();
+			}
+
+			m_eof = false;
+
+			LOG_TRACE(U"Session [{}] closed"_fmt(m_id));
+
+			m_id = 0;
+		}
+
+		void ServerSession::init(const TCPSessionID id)
+		{
+			m_id = id;
+
+			m_isActive = true;
+
+			LOG_TRACE(U"Session [{}] created"_fmt(id));
+		}
+
+		asio::ip::tcp::socket& ServerSession::socket()
+		{
+			return m_socket;
+		}
+
+		bool ServerSession::isActive() const
+		{
+			return m_isActive;
+		}
+
+		size_t ServerSession::available() const
+		{
+			return m_receivedBuffer.size();
+		}
+
+		void ServerSession::startReceive()
+		{
+			asio::mutable_buffer buffer;
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+
+				buffer = m_receivedBuffer.prepare();
+			}
+
+			if (buffer.size() == 0)
+			{
+				LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
+
+				close();
+
+				return;
+			}
+
+			m_socket.async_read_some(buffer,
+				std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
+		}
+
+		void ServerSession::onReceive(const asio::error_code& error, const size_t size, const std::shared_ptr<ServerSession>&)
+		{
+			if (error)
+			{
+				if (error == asio::error::operation_aborted)
+				{
+					return;
+				}
+
+				if (error != asio::error::eof)
+				{
+					LOG_FAIL(U"TCPServer: onReceive failed: {}"_fmt(Unicode::Widen(error.message())));
+				}
+				else
+				{
+					LOG_INFO(U"TCPServer: EOF");
+
+					m_eof = true;
+				}
+
+				close();
+
+				return;
+			}
+
+			if (not m_isActive)
+			{
+				return;
+			}
+
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+
+				m_receivedBuffer.commit(size);
+			}
+
+			startReceive();
+		}
+
+		void ServerSession::startSend()
+		{
+			{
+				std::lock_guard lock{ m_mutexSendingBuffer };
+
+				if (m_pendingBuffer.isEmpty())
+				{
+					m_isSending = false;
+					return;
+				}
+
+				std::swap(m_pendingBuffer, m_sendingBuffer);
+			}
+
+			send_internal();
+		}
+
+		void ServerSession::send_internal()
+		{
+			// 送信待ちのデータをまとめて 1 回の書き込みで送る
+			m_sendingBuffer.getBuffers(m_gatherBuffers);
+
+			asio::async_write(m_socket, m_gatherBuffers,
+				std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
+		}
+
+		void ServerSession::onSend(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
+		{
+			// 容量は次の送信で再利用する
+			m_sendingBuffer.clear();
+
+			if ((not m_isActive) || error)
+			{
+				{
+					std::lock_guard lock{ m_mutexSendingBuffer };
+					m_pendingBuffer.clear();
+					m_isSending = false;
+				}
+
+				if (m_isActive)
+				{
+					LOG_FAIL(U"TCPServer: send failed: {}"_fmt(Unicode::Widen(error.message())));
+
+					close();
+				}
+
+				return;
+			}
+
+			startSend();
+		}
+
+		bool ServerSession::skip(const size_t size)
+		{
+			if (not m_isActive)
+			{
+				return false;
+			}
+
+			if (size == 0)
+			{
+				return true;
+			}
+
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+
+				if (m_receivedBuffer.size() < size)
+				{
+					return false;
+				}
+
+				m_receivedBuffer.consume(size);
+			}
+
+			return true;
+		}
+
+		bool ServerSession::lookahead(void* dst, const size_t size)
+		{
+			if (not m_isActive)
+			{
+				return false;
+			}
+
+			if (size == 0)
+			{
+				return true;
+			}
+
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+
+				if (m_receivedBuffer.size() < size)
+				{
+					return false;
+				}
+
+				m_receivedBuffer.peek(dst, size);
+			}
+
+			return true;
+		}
+
+		bool ServerSession::read(void* dst, const size_t size)
+		{
+			if (not m_isActive)
+			{
+				return false;
+			}
+
+			if (size == 0)
+			{
+				return true;
+			}
+
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+
+				if (m_receivedBuffer.size() < size)
+				{
+					return false;
+				}
+
+				m_receivedBuffer.peek(dst, size);
+
+				m_receivedBuffer.consume(size);
+			}
+
+			return true;
+		}
+
+		bool ServerSession::send(const void* data, const size_t size)
+		{
+			if (not m_isActive)
+			{
+				return false;
+			}
+
+			{
+				std::lock_guard lock{ m_mutexSendingBuffer };
+
+				m_pendingBuffer.append(data, size);
+
+				if (m_isSending)
+				{
+					// 送信中の書き込みが完了したときに、まとめて送信される
+					return true;
+				}
+
+				m_isSending = true;
+			}
+
+			// ソケットは所属する I/O スレッドからのみ操作する
+			asio::post(m_socket.get_executor(), std::bind(&ServerSession::startSend, shared_from_this()));
+
+			return true;
+		}
+
+		bool ServerSession::send(const std::shared_ptr<const Blob>& data)
+		{
+			if (not m_isActive)
+			{
+				return false;
+			}
+
+			{
+				std::lock_guard lock{ m_mutexSendingBuffer };
+
+				m_pendingBuffer.append(data);
+
+				if (m_isSending)
+				{
+					return true;
+				}
+
+				m_isSending = true;
+			}
+
+			asio::post(m_socket.get_executor(), std::bind(&ServerSession::startSend, shared_from_this()));
+
+			return true;
+		}
+	}
+
+	TCPServer::TCPServerDetail::TCPServerDetail()
+	{
+
+	}
+
+	TCPServer::TCPServerDetail::~TCPServerDetail()
+	{
+		disconnect();
+	}
+
+	void TCPServer::TCPServerDetail::startAccept(const uint16 port)
+	{
+		startAccept(port, false, 1);
+	}
+
+	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port, const size_t numThreads)
+	{
+		startAccept(port, true, numThreads);
 	}
 
 	void TCPServer::TCPServerDetail::cancelAccept()
 	{
-		m_accepting = false;
+		std::lock_guard lock{ m_mutexSessions };
 
-		if (m_acceptor)
-		{
-			m_acceptor->close();
-		}
+		cancelAccept_internal();
 	}
 
 	bool TCPServer::TCPServerDetail::isAccepting() const
@@ -99,27 +498,46 @@ namespace s3d
 	{
 		cancelAccept();
 
-		for (auto& session : m_sessions)
+		if (m_works)
 		{
-			session.second->close();
-		}
+			m_works.clear();
+
+			for (auto& io_service : m_io_services)
+			{
+				io_service->stop();
+			}
+
+			for (auto& thread : m_io_service_threads)
+			{
+				thread.wait();
+			}
 
-		m_sessions.clear();
+			m_io_service_threads.clear();
+		}
 
-		if (m_work)
 		{
-			m_work.reset();
+			std::lock_guard lock{ m_mutexSessions };
 
-			m_io_service->stop();
+			for (auto& session : m_sessions)
+			{
+				session.second->close();
+			}
+
+			m_sessions.clear();
 
-			m_io_service_thread.wait();
+			m_acceptor.reset();
+		}
 
-			m_io_service->restart();
+		for (auto& io_service : m_io_services)
+		{
+			io_service->restart();
 		}
 	}
 
 	bool TCPServer::TCPServerDetail::hasSession()
 	{
+		std::lock_guard lock{ m_mutexSessions };
+
 		updateSession();
 
 		return m_sessions.any([](const auto& session) { return session.second->isActive(); });
@@ -127,6 +545,8 @@ namespace s3d
 
 	bool TCPServer::TCPServerDetail::hasSession(const TCPSessionID id)
 	{
+		std::lock_guard lock{ m_mutexSessions };
+
 		updateSession();
 
 		return m_sessions.contains_if([=](const auto& session) { return session.first == id; });
@@ -134,6 +554,8 @@ namespace s3d
 
 	size_t TCPServer::TCPServerDetail::num_sessions()
 	{
+		std::lock_guard lock{ m_mutexSessions };
+
 		updateSession();
 
 		return m_sessions.count_if([](const auto& session) { return session.second->isActive(); });
@@ -141,11 +563,32 @@ namespace s3d
 
 	Array<TCPSessionID> TCPServer::TCPServerDetail::getSessionIDs()
 	{
+		std::lock_guard lock{ m_mutexSessions };
+
 		updateSession();
 
 		return m_sessions.map([](const auto& session) { return session.first; });
 	}
 
+	Array<TCPSessionID> TCPServer::TCPServerDetail::getReadableSessionIDs(const size_t minSize) const
+	{
+		const size_t threshold = Max<size_t>(minSize, 1);
+
+		Array<TCPSessionID> ids;
+
+		std::lock_guard lock{ m_mutexSessions };
+
+		for (const auto& session : m_sessions)
+		{
+			if (session.second->isActive() && (threshold <= session.second->available()))
+			{
+				ids.push_back(session.first);
+			}
+		}
+
+		return ids;
+	}
+
 	uint16 TCPServer::TCPServerDetail::port() const
 	{
 		return m_port;
@@ -153,108 +596,164 @@ namespace s3d
 
 	size_t TCPServer::TCPServerDetail::available(const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return 0;
+			return session->available();
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return 0;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::skip(const size_t size, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->available();
-			}
+			return session->skip(size);
 		}
 
-		return 0;
+		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::skip(const size_t size, const Optional<TCPSessionID>& id)
+	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<TCPSessionID>& id) const
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->lookahead(dst, size);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->skip(size);
-			}
+			return session->read(dst, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<TCPSessionID>& id) const
+	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->send(data, size);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::send(Blob&& data, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->lookahead(dst, size);
-			}
+			return session->send(std::make_shared<const Blob>(std::move(data)));
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<TCPSessionID>& id)
+	size_t TCPServer::TCPServerDetail::broadcast(const std::shared_ptr<const Blob>& data)
 	{
-		if (m_sessions.isEmpty())
+		size_t count = 0;
+
+		std::lock_guard lock{ m_mutexSessions };
+
+		for (auto& session : m_sessions)
 		{
-			return false;
+			count += session.second->send(data);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return count;
+	}
 
-		for (auto& session : m_sessions)
+	void TCPServer::TCPServerDetail::run(const size_t numThreads)
+	{
+		while (m_io_services.size() < numThreads)
+		{
+			m_io_services.push_back(std::make_unique<asio::io_service>());
+		}
+
+		if (m_works)
 		{
-			if (session.first == sessionID)
+			// 実行中のスレッドは維持し、足りない分だけ追加する
+			for (size_t i = m_works.size(); i < m_io_services.size(); ++i)
 			{
-				return session.second->read(dst, size);
+				asio::io_service& io_service = *m_io_services[i];
+
+				m_works.push_back(std::make_unique<asio::io_service::work>(io_service));
+
+				m_io_service_threads.push_back(Async([&io_service] { io_service.run(); }));
 			}
+
+			return;
 		}
 
-		return false;
+		for (auto& io_service : m_io_services)
+		{
+			m_works.push_back(std::make_unique<asio::io_service::work>(*io_service));
+
+			m_io_service_threads.push_back(Async([&io_service = *io_service] { io_service.run(); }));
+		}
 	}
 
-	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<TCPSessionID>& id)
+	void TCPServer::TCPServerDetail::startAccept(const uint16 port, const bool allowMulti, const size_t numThreads)
 	{
-		if (m_sessions.isEmpty())
+		// I/O スレッドの onAccept() と、アクセプタや I/O スレッドの一覧を同時に操作しないようにする
+		std::lock_guard lock{ m_mutexSessions };
+
+		if (m_accepting)
 		{
-			return false;
+			cancelAccept_internal();
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		m_allowMulti = allowMulti;
 
-		for (auto& session : m_sessions)
+		m_port = port;
+
+		run(Max<size_t>(numThreads, 1));
+
+		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_services.front(), asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+
+		m_accepting = true;
+
+		asyncAccept();
+	}
+
+	void TCPServer::TCPServerDetail::asyncAccept()
+	{
+		// セッションは I/O スレッドに順番に割り当てる
+		const size_t index = (m_nextIOService++ % m_works.size());
+
+		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_services[index]);
+
+		m_acceptor->async_accept(newSession->socket(),
+			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+	}
+
+	void TCPServer::TCPServerDetail::cancelAccept_internal()
+	{
+		m_accepting = false;
+
+		if (m_acceptor)
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->send(data, size);
-			}
+			asio::error_code error;
+			m_acceptor->close(error);
 		}
-
-		return false;
 	}
 
 	void TCPServer::TCPServerDetail::onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session)
 	{
-		updateSession();
+		// 閉じられたアクセプタの完了ハンドラは、新しいアクセプタに影響を与えないようにする
+		if (error == asio::error::operation_aborted)
+		{
+			return;
+		}
+
+		std::lock_guard lock{ m_mutexSessions };
 
+		// cancelAccept() の後に完了した場合は、セッションを追加しない
 		if (!m_accepting)
 		{
 			return;
@@ -264,7 +763,7 @@ namespace s3d
 		{
 			LOG_FAIL(U"TCPServer: accept failed: {}"_fmt(Unicode::Widen(error.message())));
 
-			cancelAccept();
+			cancelAccept_internal();
 
 			return;
 		}
@@ -283,22 +782,22 @@ namespace s3d
 				socket.local_endpoint().port()));
 		}
 
+		updateSession();
+
 		m_sessions.push_back({ id, session });
 
 		LOG_TRACE(U"TCPServer session [{}] created"_fmt(id));
 
-		m_sessions.back().second->startReceive();
+		// 受信は、ソケットが所属する I/O スレッドで開始する
+		asio::post(session->socket().get_executor(), std::bind(&detail::ServerSession::startReceive, session));
 
 		if (m_allowMulti)
 		{
-			std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
-
-			m_acceptor->async_accept(newSession->socket(),
-				std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+			asyncAccept();
 		}
 		else
 		{
-			cancelAccept();
+			cancelAccept_internal();
 		}
 	}
 
@@ -306,4 +805,27 @@ namespace s3d
 	{
 		m_sessions.remove_if([](const auto& session) { return !session.second->isActive(); });
 	}
+
+	std::shared_ptr<detail::ServerSession> TCPServer::TCPServerDetail::findSession(const Optional<TCPSessionID>& id) const
+	{
+		std::lock_guard lock{ m_mutexSessions };
+
+		if (m_sessions.isEmpty())
+		{
+			return nullptr;
+		}
+
+		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+
+		// m_sessions は ID の昇順に並んでいるため、二分探索できる
+		const auto it = std::lower_bound(m_sessions.begin(), m_sessions.end(), sessionID,
+			[](const auto& session, const TCPSessionID id) { return (session.first < id); });
+
+		if ((it == m_sessions.end()) || (it->first != sessionID))
+		{
+			return nullptr;
+		}
+
+		return it->second;
+	}
 }
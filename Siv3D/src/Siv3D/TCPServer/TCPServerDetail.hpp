@@ -30,309 +30,144 @@ namespace s3d
 {
 	namespace detail
 	{
-		class ServerSession : public std::enable_shared_from_this<ServerSession>
+		/// @brief 受信データのリングバッファ
+		/// @remark I/O スレッドは `prepare()` で得た空き領域にソケットから直接書き込み、`commit()` で公開します。
+		/// 読み取り側と書き込み側の領域は重ならないため、ロックが必要なのは位置の更新時だけです。
+		class ReceiveBuffer
 		{
-		private:
-
-			asio::ip::tcp::socket m_socket;
-
-			TCPSessionID m_id = 0;
-
-			bool m_isActive = false;
-
-			bool m_eof = false;
-
-			asio::streambuf m_streamBuffer;
-
-			// 受信	
-			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
-
-			std::mutex m_mutexReceivedBuffer;
-
-			Array<Byte> m_receivedBuffer;
-
-
-			// 送信
-			std::mutex m_mutexSendingBuffer;
-
-			Array<Array<Byte>> m_sendingBuffer;
-
-			bool m_isSending = false;
-
-
-			void send_internal()
-			{
-				m_isSending = true;
-
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
-					std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
-			}
-
 		public:
 
-			ServerSession(asio::io_service& io_service)
-				: m_socket(io_service)
-			{
-
-			}
+			static constexpr size_t InitialCapacity = (16 * 1024);
 
-			~ServerSession()
-			{
-				close();
-			}
+			static constexpr size_t MaxCapacity = (32 * 1024 * 1024);
 
-			void close()
-			{
-				if (m_id == 0)
-				{
-					return;
-				}
-
-				//if (m_eof)
-				//{
-				//	m_socket.shutdown(asio::socket_base::shutdown_type::shutdown_both);
-				//}
-
-				m_socket.close();
-
-				if (!m_isSending)
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
-				}
-
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
-					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
-				}
-
-				m_isSending = false;
-				m_isActive = false;
-				m_eof = false;
-
-				if (m_id)
-				{
-					LOG_TRACE(U"Session [{}] closed"_fmt(m_id));
-				}
-
-				m_id = 0;
-			}
-
-			void init(const TCPSessionID id)
-			{
-				m_id = id;
+			/// @brief 受信に使う連続した空き領域を返します。I/O スレッドからのみ呼びます。
+			/// @return 空き領域。バッファが上限に達している場合は空の領域
+			[[nodiscard]]
+			asio::mutable_buffer prepare();
 
-				m_isActive = true;
+			/// @brief `prepare()` で得た領域に書き込んだデータを公開します。
+			/// @param size 書き込んだサイズ（バイト）
+			void commit(size_t size) noexcept;
 
-				LOG_TRACE(U"Session [{}] created"_fmt(id));
-			}
+			[[nodiscard]]
+			size_t size() const noexcept;
 
-			asio::ip::tcp::socket& socket()
-			{
-				return m_socket;
-			}
+			void peek(void* dst, size_t size) const noexcept;
 
-			bool isActive() const
-			{
-				return m_isActive;
-			}
-
-			size_t available()
-			{
-				std::lock_guard lock{ m_mutexReceivedBuffer };
+			void consume(size_t size) noexcept;
 
-				return m_receivedBuffer.size();
-			}
+			void clear() noexcept;
 
-			void startReceive()
-			{
-				asio::async_read(m_socket, m_streamBuffer, asio::transfer_at_least(1),
-					std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
-			}
-
-			void onReceive(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
-			{
-				if (error)
-				{
-					if (error != asio::error::eof)
-					{
-						LOG_FAIL(U"TCPServer: onReceive failed: {}"_fmt(Unicode::Widen(error.message())));
-					}
-					else
-					{
-						LOG_INFO(U"TCPServer: EOF");
+		private:
 
-						m_eof = true;
-					}
+			Array<Byte> m_data;
 
-					m_streamBuffer.consume(m_streamBuffer.size());
+			size_t m_head = 0;
 
-					close();
+			// ロックせずに available() から参照できるよう atomic にする
+			std::atomic<size_t> m_size = 0;
 
-					return;
-				}
+			void grow();
+		};
 
-				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
-				const size_t size = m_streamBuffer.size();
+		/// @brief 送信待ちのデータ
+		/// @remark コピーして送信するデータは 1 つの Array にまとめ、移動された Blob はそのまま参照します。
+		struct SendQueue
+		{
+			struct Segment
+			{
+				// nullptr の場合は bytes の一部
+				std::shared_ptr<const Blob> blob;
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+				size_t offset = 0;
 
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
+				size_t size = 0;
+			};
 
-						m_streamBuffer.consume(m_streamBuffer.size());
+			Array<Byte> bytes;
 
-						close();
+			Array<Segment> segments;
 
-						return;
-					}
+			void append(const void* data, size_t size);
 
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
-				}
+			void append(const std::shared_ptr<const Blob>& blob);
 
-				m_streamBuffer.consume(m_streamBuffer.size());
+			[[nodiscard]]
+			bool isEmpty() const noexcept;
 
-				startReceive();
-			}
+			void clear() noexcept;
 
-			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
-			{
-				m_isSending = false;
+			void getBuffers(std::vector<asio::const_buffer>& buffers) const;
+		};
 
-				if (!m_isActive)
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
-					return;
-				}
+		class ServerSession : public std::enable_shared_from_this<ServerSession>
+		{
+		private:
 
-				if (error)
-				{
-					LOG_FAIL(U"TCPServer: send failed: {}"_fmt(Unicode::Widen(error.message())));
+			asio::ip::tcp::socket m_socket;
 
-					close();
+			TCPSessionID m_id = 0;
 
-					return;
-				}
+			std::atomic<bool> m_isActive = false;
 
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
+			bool m_eof = false;
 
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
+			// 受信
+			std::mutex m_mutexReceivedBuffer;
 
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
-				}
-			}
+			ReceiveBuffer m_receivedBuffer;
 
-			bool skip(const size_t size)
-			{
-				if (!m_isActive)
-				{
-					return false;
-				}
 
-				if (size == 0)
-				{
-					return true;
-				}
+			// 送信
+			std::mutex m_mutexSendingBuffer;
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+			// 次に送信するデータ（m_mutexSendingBuffer で保護）
+			SendQueue m_pendingBuffer;
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
+			// 送信中のデータ（I/O スレッドのみが使う）
+			SendQueue m_sendingBuffer;
 
-					m_receivedBuffer.pop_front_N(size);
-				}
+			std::vector<asio::const_buffer> m_gatherBuffers;
 
-				return true;
-			}
+			// m_mutexSendingBuffer で保護
+			bool m_isSending = false;
 
-			bool lookahead(void* dst, const size_t size)
-			{
-				if (!m_isActive)
-				{
-					return false;
-				}
+			void startSend();
 
-				if (size == 0)
-				{
-					return true;
-				}
+			void send_internal();
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+		public:
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+			ServerSession(asio::io_service& io_service);
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
-				}
+			~ServerSession();
 
-				return true;
-			}
+			void close();
 
-			bool read(void* dst, const size_t size)
-			{
-				if (!m_isActive)
-				{
-					return false;
-				}
+			void init(TCPSessionID id);
 
-				if (size == 0)
-				{
-					return true;
-				}
+			asio::ip::tcp::socket& socket();
 
-				{
-					std::lock_guard<std::mutex> lock{ m_mutexReceivedBuffer };
+			bool isActive() const;
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+			size_t available() const;
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+			void startReceive();
 
-					m_receivedBuffer.pop_front_N(size);
-				}
+			void onReceive(const asio::error_code& error, size_t size, const std::shared_ptr<ServerSession>&);
 
-				return true;
-			}
+			void onSend(const asio::error_code& error, size_t size, const std::shared_ptr<ServerSession>&);
 
-			bool send(const void* data, const size_t size)
-			{
-				if (!m_isActive)
-				{
-					return false;
-				}
+			bool skip(size_t size);
 
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
+			bool lookahead(void* dst, size_t size);
 
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
+			bool read(void* dst, size_t size);
 
-					if (!m_isSending)
-					{
-						send_internal();
-					}
-				}
+			bool send(const void* data, size_t size);
 
-				return true;
-			}
+			bool send(const std::shared_ptr<const Blob>& data);
 		};
 	}
 
@@ -340,28 +175,49 @@ namespace s3d
 	{
 	private:
 
-		std::shared_ptr<asio::io_service> m_io_service;
+		// I/O スレッドごとの io_service
+		Array<std::unique_ptr<asio::io_service>> m_io_services;
 
-		std::unique_ptr<asio::io_service::work> m_work;
+		Array<std::unique_ptr<asio::io_service::work>> m_works;
 
-		std::unique_ptr<asio::ip::tcp::acceptor> m_acceptor;
+		Array<AsyncTask<void>> m_io_service_threads;
+
+		std::atomic<size_t> m_nextIOService = 0;
 
-		AsyncTask<void> m_io_service_thread;
+		// I/O スレッドの完了ハンドラからも操作されるため m_mutexSessions で保護する
+		std::unique_ptr<asio::ip::tcp::acceptor> m_acceptor;
 
+		// ID の昇順。I/O スレッドからも追加されるため m_mutexSessions で保護する
 		Array<std::pair<TCPSessionID, std::shared_ptr<detail::ServerSession>>> m_sessions;
 
+		mutable std::mutex m_mutexSessions;
+
 		std::atomic<TCPSessionID> m_currentTCPSessionID = 0;
 
 		uint16 m_port = 0;
 
-		bool m_accepting = false;
+		// 変更は m_mutexSessions を確保して行う。isAccepting() からはロックせずに読む
+		std::atomic<bool> m_accepting = false;
 
 		bool m_allowMulti = false;
 
+		void run(size_t numThreads);
+
+		void startAccept(uint16 port, bool allowMulti, size_t numThreads);
+
+		// m_mutexSessions を確保した状態で呼ぶ
+		void asyncAccept();
+
+		// m_mutexSessions を確保した状態で呼ぶ
+		void cancelAccept_internal();
+
 		void onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session);
 
 		void updateSession();
 
+		[[nodiscard]]
+		std::shared_ptr<detail::ServerSession> findSession(const Optional<TCPSessionID>& id) const;
+
 	public:
 
 		TCPServerDetail();
@@ -370,7 +226,7 @@ namespace s3d
 
 		void startAccept(uint16 port);
 
-		void startAcceptMulti(uint16 port);
+		void startAcceptMulti(uint16 port, size_t numThreads);
 
 		void cancelAccept();
 
@@ -386,6 +242,8 @@ namespace s3d
 
 		Array<TCPSessionID> getSessionIDs();
 
+		Array<TCPSessionID> getReadableSessionIDs(size_t minSize) const;
+
 		uint16 port() const;
 
 		size_t available(const Optional<TCPSessionID>& id);
@@ -397,5 +255,9 @@ namespace s3d
 		bool read(void* dst, size_t size, const Optional<TCPSessionID>& id);
 
 		bool send(const void* data, size_t size, const Optional<TCPSessionID>& id);
+
+		bool send(Blob&& data, const Optional<TCPSessionID>& id);
+
+		size_t broadcast(const std::shared_ptr<const Blob>& data);
 	};
 }
@@ -0,0 +1,87 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <thread>
+# include <Siv3D/TaskGroup.hpp>
+# include <Siv3D/ThreadPool/IThreadPool.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	TaskGroup::~TaskGroup()
+	{
+		try
+		{
+			wait();
+		}
+		catch (...) {}
+	}
+
+	void TaskGroup::wait()
+	{
+		while (m_pendingCount.load(std::memory_order_acquire) != 0)
+		{
+			if (not (Siv3DEngine::isActive() && SIV3D_ENGINE(ThreadPool)->tryRunPendingTask()))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		std::exception_ptr exception;
+		{
+			std::lock_guard lock{ m_exceptionMutex };
+			std::swap(exception, m_exception);
+		}
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	size_t TaskGroup::num_pending() const noexcept
+	{
+		return m_pendingCount.load(std::memory_order_acquire);
+	}
+
+	void TaskGroup::submit(std::function<void()> task)
+	{
+		++m_pendingCount;
+
+		auto f = [this, task = std::move(task)]()
+		{
+			try
+			{
+				task();
+			}
+			catch (...)
+			{
+				std::lock_guard lock{ m_exceptionMutex };
+
+				if (not m_exception)
+				{
+					m_exception = std::current_exception();
+				}
+			}
+
+			m_pendingCount.fetch_sub(1, std::memory_order_release);
+		};
+
+		if (Siv3DEngine::isActive())
+		{
+			SIV3D_ENGINE(ThreadPool)->submit(std::move(f));
+		}
+		else
+		{
+			f();
+		}
+	}
+}
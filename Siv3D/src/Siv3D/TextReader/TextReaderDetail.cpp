@@ -14,10 +14,67 @@
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Endian.hpp>
 # include <Siv3D/Unicode.hpp>
-# include <Siv3D/UnicodeConverter.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/Unicode/UnicodeKernels.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 一度に読み込むバイト数
+		inline constexpr size_t TextReaderBlockSize = (256 * 1024);
+
+		// 末尾で途切れている UTF-8 の文字を除いた長さを返す
+		[[nodiscard]]
+		static size_t UTF8CompleteLength(const uint8* pSrc, const size_t size) noexcept
+		{
+			for (size_t i = 1; i <= Min<size_t>(3, size); ++i)
+			{
+				const uint8 c = pSrc[size - i];
+
+				if (c < 0x80)
+				{
+					return size;
+				}
+				else if (0xC0 <= c)
+				{
+					const size_t sequenceLength = ((c < 0xE0) ? 2 : (c < 0xF0) ? 3 : (c < 0xF8) ? 4 : 1);
+					return ((i < sequenceLength) ? (size - i) : size);
+				}
+			}
+
+			return size;
+		}
+
+		// [first, last) から t0 か t1 を探す
+		[[nodiscard]]
+		static const char32* FindEither(const char32* first, const char32* const last, const char32 t0, const char32 t1) noexcept
+		{
+			const __m128i v0 = _mm_set1_epi32(static_cast<int32>(t0));
+			const __m128i v1 = _mm_set1_epi32(static_cast<int32>(t1));
+
+			for (; 4 <= (last - first); first += 4)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+				if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi32(v, v0), _mm_cmpeq_epi32(v, v1))))
+				{
+					break;
+				}
+			}
+
+			for (; first != last; ++first)
+			{
+				if ((*first == t0) || (*first == t1))
+				{
+					break;
+				}
+			}
+
+			return first;
+		}
+	}
+
 	TextReader::TextReaderDetail::TextReaderDetail()
 	{
 		// do nothing
@@ -56,6 +113,8 @@ namespace s3d
 			m_reader->skip(bomSize);
 		}
 
+		resetBuffer();
+
 		return true;
 	}
 
@@ -90,6 +149,8 @@ namespace s3d
 			m_reader->skip(bomSize);
 		}
 
+		resetBuffer();
+
 		return true;
 	}
 
@@ -103,6 +164,8 @@ namespace s3d
 		m_reader.reset();
 
 		m_info = {};
+
+		resetBuffer();
 	}
 
 	bool TextReader::TextReaderDetail::isOpen() const noexcept
@@ -117,24 +180,15 @@ namespace s3d
 			return none;
 		}
 
-		for (;;)
-		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				return none;
-			}
+		char32 codePoint;
 
-			if (codePoint == U'\0')
-			{
-				return none;
-			}
-			else if (codePoint != U'\r')
-			{
-				return codePoint;
-			}
+		if ((not readCodePoint(codePoint))
+			|| (codePoint == U'\0'))
+		{
+			return none;
 		}
+
+		return codePoint;
 	}
 
 	Optional<String> TextReader::TextReaderDetail::readLine()
@@ -146,65 +200,21 @@ namespace s3d
 
 		String line;
 
-		for (;;)
+		if (readUntil(line, U'\n', U'\0') || line)
 		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					return line;
-				}
-
-				return none;
-			}
-
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				return line;
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
+			return line;
 		}
+
+		return none;
 	}
 
 	Array<String> TextReader::TextReaderDetail::readLines()
 	{
-		if (not m_info.isOpen) SIV3D_UNLIKELY
-		{
-			return{};
-		}
-
 		Array<String> lines;
-		String line;
 
-		for (;;)
-		{
-			char32 codePoint;
+		readLines(lines);
 
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					lines.push_back(std::move(line));
-				}
-
-				return lines;
-			}
-
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				lines.push_back(line);
-				line.clear();
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
-		}
+		return lines;
 	}
 
 	String TextReader::TextReaderDetail::readAll()
@@ -216,24 +226,9 @@ namespace s3d
 
 		String s;
 
-		for (;;)
-		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				return s;
-			}
+		readUntil(s, U'\0', U'\0');
 
-			if (codePoint == U'\0')
-			{
-				return s;
-			}
-			else if (codePoint != U'\r')
-			{
-				s.push_back(codePoint);
-			}
-		}
+		return s;
 	}
 
 	bool TextReader::TextReaderDetail::readChar(char32& ch)
@@ -245,25 +240,16 @@ namespace s3d
 			return false;
 		}
 
-		for (;;)
-		{
-			char32 codePoint;
+		char32 codePoint;
 
-			if (not readCodePoint(codePoint))
-			{
-				return false;
-			}
-
-			if (codePoint == U'\0')
-			{
-				return false;
-			}
-			else if (codePoint != U'\r')
-			{
-				ch = codePoint;
-				return true;
-			}
+		if ((not readCodePoint(codePoint))
+			|| (codePoint == U'\0'))
+		{
+			return false;
 		}
+
+		ch = codePoint;
+		return true;
 	}
 
 	bool TextReader::TextReaderDetail::readLine(String& line)
@@ -275,29 +261,7 @@ namespace s3d
 			return false;
 		}
 
-		for (;;)
-		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					return true;
-				}
-
-				return false;
-			}
-
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				return true;
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
-		}
+		return (readUntil(line, U'\n', U'\0') || line);
 	}
 
 	bool TextReader::TextReaderDetail::readLines(Array<String>& lines)
@@ -309,36 +273,22 @@ namespace s3d
 			return false;
 		}
 
-		String line;
-
 		for (;;)
 		{
-			char32 codePoint;
+			String line;
 
-			if (not readCodePoint(codePoint))
+			if (readUntil(line, U'\n', U'\0'))
 			{
-				if (line)
-				{
-					lines.push_back(std::move(line));
-				}
-
-				if (not lines)
-				{
-					return false;
-				}
-
-				return true;
+				lines.push_back(std::move(line));
+				continue;
 			}
 
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
+			if (line)
 			{
-				lines.push_back(line);
-				line.clear();
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
+				lines.push_back(std::move(line));
 			}
+
+			return static_cast<bool>(lines);
 		}
 	}
 
@@ -351,29 +301,7 @@ namespace s3d
 			return false;
 		}
 
-		for (;;)
-		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (not s)
-				{
-					return false;
-				}
-
-				return true;
-			}
-
-			if (codePoint == U'\0')
-			{
-				return true;
-			}
-			else if (codePoint != U'\r')
-			{
-				s.push_back(codePoint);
-			}
-		}
+		return (readUntil(s, U'\0', U'\0') || s);
 	}
 
 	TextEncoding TextReader::TextReaderDetail::encoding() const noexcept
@@ -386,138 +314,140 @@ namespace s3d
 		return m_info.fullPath;
 	}
 
-	bool TextReader::TextReaderDetail::readByte(uint8& c)
+	void TextReader::TextReaderDetail::resetBuffer()
 	{
-		return m_reader->read(c);
+		m_input.clear();
+		m_utf16.clear();
+		m_buffer.clear();
+		m_bufferPos = 0;
+		m_inputEnd = false;
 	}
 
-	bool TextReader::TextReaderDetail::readTwoBytes(uint16& c)
+	bool TextReader::TextReaderDetail::fillBuffer()
 	{
-		return m_reader->read(c);
-	}
+		m_buffer.clear();
+		m_bufferPos = 0;
 
-	bool TextReader::TextReaderDetail::readUTF8(char32& c)
-	{
-		uint8 cx;
-
-		if (not readByte(cx))
+		// 途切れた文字や '\r' だけのブロックでは文字が得られないため、得られるまで繰り返す
+		while (m_buffer.isEmpty())
 		{
-			return false;
-		}
+			if (m_inputEnd)
+			{
+				return false;
+			}
 
-		UTF8toUTF32_Converter converter;
+			const size_t carrySize = m_input.size();
+			m_input.resize(carrySize + detail::TextReaderBlockSize);
 
-		if (converter.put(cx)) // 1
-		{
-			c = converter.get();
-			return true;
-		}
+			const int64 readSize = Max<int64>(m_reader->read((m_input.data() + carrySize), detail::TextReaderBlockSize), 0);
+			m_input.resize(carrySize + static_cast<size_t>(readSize));
 
-		if (not readByte(cx))
-		{
-			return false;
-		}
+			if (readSize == 0)
+			{
+				m_inputEnd = true;
+			}
 
-		if (converter.put(cx)) // 2
-		{
-			c = converter.get();
-			return true;
-		}
+			if ((m_info.encoding == TextEncoding::UTF16LE)
+				|| (m_info.encoding == TextEncoding::UTF16BE))
+			{
+				decodeUTF16();
+			}
+			else
+			{
+				decodeUTF8();
+			}
 
-		if (not readByte(cx))
-		{
-			return false;
+			m_buffer.remove(U'\r');
 		}
 
-		if (converter.put(cx)) // 3
-		{
-			c = converter.get();
-			return true;
-		}
+		return true;
+	}
 
-		if (not readByte(cx))
-		{
-			return false;
-		}
+	void TextReader::TextReaderDetail::decodeUTF8()
+	{
+		// 終端に達していなければ、途切れた文字は次のブロックに持ち越す
+		const size_t completeSize = (m_inputEnd ? m_input.size() : detail::UTF8CompleteLength(m_input.data(), m_input.size()));
+		const char8* pSrc = reinterpret_cast<const char8*>(m_input.data());
 
-		if (converter.put(cx)) // 4
-		{
-			c = converter.get();
-			return true;
-		}
+		// UTF-32 の要素数は UTF-8 のバイト数を超えない
+		m_buffer.resize(completeSize);
+		const char32* pDstEnd = UnicodeKernels::UTF8ToUTF32(pSrc, completeSize, m_buffer.data());
+		m_buffer.resize(pDstEnd - m_buffer.data());
 
-		return false;
+		m_input.erase(m_input.begin(), (m_input.begin() + completeSize));
 	}
 
-	bool TextReader::TextReaderDetail::readUTF16LE(char32& c)
+	void TextReader::TextReaderDetail::decodeUTF16()
 	{
-		uint16 c0 = 0, c1 = 0;
-		
-		if (not readTwoBytes(c0))
-		{
-			return false;
-		}
+		size_t unitCount = (m_input.size() / 2);
+		m_utf16.resize(unitCount);
+		std::memcpy(m_utf16.data(), m_input.data(), (unitCount * 2));
 
-		if (Unicode::IsHighSurrogate(c0))
+		if (m_info.encoding == TextEncoding::UTF16BE)
 		{
-			if (not readTwoBytes(c1))
+			for (auto& ch : m_utf16)
 			{
-				return false;
+				ch = SwapEndian(static_cast<uint16>(ch));
 			}
+		}
 
-			c = ((((c0 - 0xD800) << 10) | (c1 - 0xDC00)) + 0x10000);
+		// 終端に達していなければ、途切れたサロゲートペアは次のブロックに持ち越す
+		if ((not m_inputEnd) && unitCount
+			&& Unicode::IsHighSurrogate(m_utf16[unitCount - 1]))
+		{
+			--unitCount;
+		}
+
+		m_buffer.resize(unitCount);
+		const char32* pDstEnd = UnicodeKernels::UTF16ToUTF32(m_utf16.data(), unitCount, m_buffer.data());
+		m_buffer.resize(pDstEnd - m_buffer.data());
+
+		if (m_inputEnd)
+		{
+			// 終端の奇数バイトは捨てる
+			m_input.clear();
 		}
 		else
 		{
-			c = c0;
+			m_input.erase(m_input.begin(), (m_input.begin() + (unitCount * 2)));
 		}
-
-		return true;
 	}
 
-	bool TextReader::TextReaderDetail::readUTF16BE(char32& c)
+	bool TextReader::TextReaderDetail::readCodePoint(char32& codePoint)
 	{
-		uint16 c0 = 0, c1 = 0;
-
-		if (not readTwoBytes(c0))
+		if ((m_bufferPos == m_buffer.size())
+			&& (not fillBuffer()))
 		{
 			return false;
 		}
 
-		c0 = SwapEndian(c0);
+		codePoint = m_buffer[m_bufferPos++];
+		return true;
+	}
 
-		if (Unicode::IsHighSurrogate(c0))
+	bool TextReader::TextReaderDetail::readUntil(String& s, const char32 t0, const char32 t1)
+	{
+		for (;;)
 		{
-			if (not readTwoBytes(c1))
+			if ((m_bufferPos == m_buffer.size())
+				&& (not fillBuffer()))
 			{
 				return false;
 			}
 
-			c1 = SwapEndian(c1);
+			const char32* const pBegin = (m_buffer.data() + m_bufferPos);
+			const char32* const pEnd = (m_buffer.data() + m_buffer.size());
+			const char32* const pFound = detail::FindEither(pBegin, pEnd, t0, t1);
 
-			c = ((((c0 - 0xD800) << 10) | (c1 - 0xDC00)) + 0x10000);
-		}
-		else
-		{
-			c = c0;
-		}
+			s.append(pBegin, (pFound - pBegin));
 
-		return true;
-	}
+			if (pFound != pEnd)
+			{
+				m_bufferPos = ((pFound - m_buffer.data()) + 1);
+				return true;
+			}
 
-	bool TextReader::TextReaderDetail::readCodePoint(char32& codePoint)
-	{
-		if (m_info.encoding == TextEncoding::UTF16LE)
-		{
-			return readUTF16LE(codePoint);
-		}
-		else if (m_info.encoding == TextEncoding::UTF16BE)
-		{
-			return readUTF16BE(codePoint);
-		}
-		else
-		{
-			return readUTF8(codePoint);
+			m_bufferPos = m_buffer.size();
 		}
 	}
 }
@@ -27,24 +27,35 @@ namespace s3d
 			bool isOpen = false;
 		} m_info;
 
-		[[nodiscard]]
-		bool readByte(uint8& c);
+		// 読み込んだが、まだ変換していないバイト列（ブロックの境界で途切れた文字）
+		Array<uint8> m_input;
 
-		[[nodiscard]]
-		bool readTwoBytes(uint16& c);
+		// UTF-16 の変換用バッファ
+		Array<char16> m_utf16;
 
-		[[nodiscard]]
-		bool readUTF8(char32& c);
+		// 変換済みの文字列（'\r' は取り除かれている）
+		String m_buffer;
 
-		[[nodiscard]]
-		bool readUTF16LE(char32& c);
+		size_t m_bufferPos = 0;
+
+		bool m_inputEnd = false;
 
+		void resetBuffer();
+
+		// 次のブロックを読み込んで変換する。これ以上文字が無い場合 false を返す
 		[[nodiscard]]
-		bool readUTF16BE(char32& c);
+		bool fillBuffer();
+
+		void decodeUTF8();
+
+		void decodeUTF16();
 
 		[[nodiscard]]
 		bool readCodePoint(char32& codePoint);
 
+		// t0 か t1 が現れるまでの文字を s に追加し、その文字を読み飛ばす。t0 か t1 が現れずに終端に達した場合 false を返す
+		bool readUntil(String& s, char32 t0, char32 t1);
+
 	public:
 
 		TextReaderDetail();
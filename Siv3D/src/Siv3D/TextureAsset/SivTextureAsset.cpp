@@ -171,9 +171,9 @@ namespace s3d
 		return SIV3D_ENGINE(Asset)->load(AssetType::Texture, name, {});
 	}
 
-	void TextureAsset::LoadAsync(const AssetNameView name)
+	void TextureAsset::LoadAsync(const AssetNameView name, const AssetLoadPriority priority)
 	{
-		SIV3D_ENGINE(Asset)->loadAsync(AssetType::Texture, name, {});
+		SIV3D_ENGINE(Asset)->loadAsync(AssetType::Texture, name, {}, priority);
 	}
 
 	void TextureAsset::Wait(const AssetNameView name)
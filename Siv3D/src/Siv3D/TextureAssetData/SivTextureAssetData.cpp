@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/TextureAssetData.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 
 namespace s3d
 {
@@ -45,6 +46,8 @@ namespace s3d
 
 	bool TextureAssetData::load(const String& hint)
 	{
+		SIV3D_PROFILE_ZONE(U"TextureAsset::load");
+
 		if (isUninitialized())
 		{
 			if (onLoad(*this, hint))
@@ -71,21 +74,13 @@ namespace s3d
 	{
 		if (isUninitialized())
 		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
-				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
-				});
+			requestAsyncLoad([this, hint = hint]() { return onLoad(*this, hint); }, { path, secondaryPath });
 		}
 	}
 
 	void TextureAssetData::wait()
 	{
-		if (m_task.isValid())
-		{
-			m_task.get();
-		}
+		waitAsyncLoad();
 	}
 
 	void TextureAssetData::release()
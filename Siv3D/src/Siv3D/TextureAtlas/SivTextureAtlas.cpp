@@ -0,0 +1,231 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/TextureAtlas.hpp>
+# include <Siv3D/TextureAsset.hpp>
+# include <Siv3D/TextureAssetData.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Asset/IAsset.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "TextureAtlasDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// TextureAssetData::DefaultLoad() と同じ情報から、テクスチャではなく画像を作成する
+		[[nodiscard]]
+		static Image LoadAssetImage(const TextureAssetData& asset)
+		{
+			if (asset.path)
+			{
+				if (asset.secondaryPath)
+				{
+					return Image{ asset.path, asset.secondaryPath };
+				}
+				else
+				{
+					return Image{ asset.path };
+				}
+			}
+			else if (asset.secondaryPath)
+			{
+				return Image{ asset.rgbColor, asset.secondaryPath };
+			}
+			else if (asset.emoji.codePoints)
+			{
+				return Image{ asset.emoji };
+			}
+			else if (asset.icon.code)
+			{
+				return Image{ asset.icon, asset.iconSize };
+			}
+
+			return{};
+		}
+	}
+
+	TextureAtlas::TextureAtlas()
+		: pImpl{ std::make_shared<TextureAtlasDetail>(DefaultMaxSide, DefaultPadding, TextureDesc::Unmipped) } {}
+
+	TextureAtlas::TextureAtlas(const int32 maxSide, const int32 padding, const TextureDesc desc)
+		: pImpl{ std::make_shared<TextureAtlasDetail>(maxSide, padding, desc) } {}
+
+	TextureAtlas::~TextureAtlas() {}
+
+	bool TextureAtlas::add(const StringView name, const Image& image)
+	{
+		return pImpl->add(name, Image{ image });
+	}
+
+	bool TextureAtlas::add(const StringView name, Image&& image)
+	{
+		return pImpl->add(name, std::move(image));
+	}
+
+	bool TextureAtlas::addAsset(const AssetNameView name)
+	{
+		const TextureAssetData* assetData = dynamic_cast<const TextureAssetData*>(SIV3D_ENGINE(Asset)->getAsset(AssetType::Texture, name));
+
+		if (not assetData)
+		{
+			LOG_FAIL(U"❌ TextureAtlas::addAsset(): TextureAsset `" + name + U"` is not registered");
+			return false;
+		}
+
+		Image image = detail::LoadAssetImage(*assetData);
+
+		if (not image)
+		{
+			LOG_FAIL(U"❌ TextureAtlas::addAsset(): Failed to load the image of TextureAsset `" + name + U"`");
+			return false;
+		}
+
+		return pImpl->add(name, std::move(image));
+	}
+
+	size_t TextureAtlas::addAssetsWithTag(const AssetTag& tag)
+	{
+		size_t count = 0;
+
+		for (auto&& [name, info] : TextureAsset::Enumerate())
+		{
+			if (info.tags.contains(tag)
+				&& addAsset(name))
+			{
+				++count;
+			}
+		}
+
+		return count;
+	}
+
+	bool TextureAtlas::remove(const StringView name)
+	{
+		return pImpl->remove(name);
+	}
+
+	bool TextureAtlas::contains(const StringView name) const
+	{
+		return pImpl->contains(name);
+	}
+
+	size_t TextureAtlas::num_images() const noexcept
+	{
+		return pImpl->num_images();
+	}
+
+	bool TextureAtlas::build()
+	{
+		return pImpl->build();
+	}
+
+	TextureAtlasRegion TextureAtlas::region(const StringView name) const
+	{
+		if (const auto index = pImpl->find(name))
+		{
+			return TextureAtlasRegion{ pImpl, *index, pImpl->getID(*index) };
+		}
+
+		return{};
+	}
+
+	TextureRegion TextureAtlas::operator ()(const StringView name) const
+	{
+		if (const auto index = pImpl->find(name))
+		{
+			return pImpl->getRegion(*index);
+		}
+
+		return{};
+	}
+
+	const Texture& TextureAtlas::getTexture() const
+	{
+		return pImpl->getTexture();
+	}
+
+	Size TextureAtlas::size() const
+	{
+		return pImpl->size();
+	}
+
+	uint64 TextureAtlas::version() const noexcept
+	{
+		return pImpl->version();
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	TextureAtlasRegion
+	//
+	////////////////////////////////////////////////////////////////
+
+	TextureAtlasRegion::TextureAtlasRegion(const std::shared_ptr<TextureAtlas::TextureAtlasDetail>& atlas, const uint32 index, const uint64 id)
+		: m_atlas{ atlas }
+		, m_index{ index }
+		, m_id{ id } {}
+
+	bool TextureAtlasRegion::isEmpty() const
+	{
+		return ((not m_atlas) || (not m_atlas->isValid(m_index, m_id)));
+	}
+
+	TextureAtlasRegion::operator bool() const
+	{
+		return (not isEmpty());
+	}
+
+	TextureRegion TextureAtlasRegion::get() const
+	{
+		if (isEmpty())
+		{
+			return{};
+		}
+
+		return m_atlas->getRegion(m_index);
+	}
+
+	TextureAtlasRegion::operator TextureRegion() const
+	{
+		return get();
+	}
+
+	Size TextureAtlasRegion::size() const
+	{
+		if (isEmpty())
+		{
+			return{ 0, 0 };
+		}
+
+		return m_atlas->getImageSize(m_index);
+	}
+
+	RectF TextureAtlasRegion::draw(const double x, const double y, const ColorF& diffuse) const
+	{
+		return get().draw(x, y, diffuse);
+	}
+
+	RectF TextureAtlasRegion::draw(const Vec2& pos, const ColorF& diffuse) const
+	{
+		return get().draw(pos, diffuse);
+	}
+
+	RectF TextureAtlasRegion::drawAt(const double x, const double y, const ColorF& diffuse) const
+	{
+		return get().drawAt(x, y, diffuse);
+	}
+
+	RectF TextureAtlasRegion::drawAt(const Vec2& pos, const ColorF& diffuse) const
+	{
+		return get().drawAt(pos, diffuse);
+	}
+}
@@ -0,0 +1,398 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/RectanglePacking.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "TextureAtlasDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 描画時のサンプリングで隣の画像の色が混ざらないよう、パディングを画像の端のピクセルで埋める
+		static void FillPadding(Image& atlas, const Rect& rect, const int32 padding)
+		{
+			const int32 x0 = rect.x;
+			const int32 x1 = (rect.x + rect.w - 1);
+			const int32 y0 = rect.y;
+			const int32 y1 = (rect.y + rect.h - 1);
+
+			for (int32 y = y0; y <= y1; ++y)
+			{
+				Color* const line = atlas[y];
+
+				for (int32 i = 1; i <= padding; ++i)
+				{
+					line[x0 - i] = line[x0];
+					line[x1 + i] = line[x1];
+				}
+			}
+
+			const int32 left = (x0 - padding);
+			const size_t width = (rect.w + padding * 2);
+
+			for (int32 i = 1; i <= padding; ++i)
+			{
+				std::memcpy((atlas[y0 - i] + left), (atlas[y0] + left), (width * sizeof(Color)));
+				std::memcpy((atlas[y1 + i] + left), (atlas[y1] + left), (width * sizeof(Color)));
+			}
+		}
+	}
+
+	TextureAtlas::TextureAtlasDetail::TextureAtlasDetail(const int32 maxSide, const int32 padding, const TextureDesc desc)
+		: m_maxSide{ Max(maxSide, 1) }
+		, m_padding{ Max(padding, 0) }
+		, m_desc{ desc }
+		, m_layout{ m_maxSide } {}
+
+	bool TextureAtlas::TextureAtlasDetail::add(const StringView name, Image&& image)
+	{
+		if (not image)
+		{
+			return false;
+		}
+
+		if (const int32 paddedSide = (m_padding * 2);
+			(m_maxSide < (image.width() + paddedSide)) || (m_maxSide < (image.height() + paddedSide)))
+		{
+			LOG_FAIL(U"❌ TextureAtlas::add(): Image `{}` ({}) does not fit in the atlas (maxSide: {})"_fmt(name, image.size(), m_maxSide));
+			return false;
+		}
+
+		if (auto it = m_indices.find(name);
+			it != m_indices.end())
+		{
+			// 同じ添字を使い続け、既存のハンドルが新しい画像を指すようにする
+			Entry& entry = m_entries[it->second];
+			const Size paddedSize = (image.size() + Size::All(m_padding * 2));
+
+			if (entry.placed
+				&& (paddedSize.x <= entry.slot.w) && (paddedSize.y <= entry.slot.h))
+			{
+				// 確保済みの領域に収まる場合は、その場で置き換える
+				entry.rect.size = image.size();
+			}
+			else if (entry.placed)
+			{
+				m_layout.release(entry.slot);
+				entry.placed = false;
+			}
+
+			entry.image = std::move(image);
+			entry.uploaded = false;
+		}
+		else
+		{
+			uint32 index;
+
+			if (m_freeIndices)
+			{
+				index = m_freeIndices.back();
+				m_freeIndices.pop_back();
+			}
+			else
+			{
+				index = static_cast<uint32>(m_entries.size());
+				m_entries.emplace_back();
+			}
+
+			Entry& entry = m_entries[index];
+			entry.name = name;
+			entry.image = std::move(image);
+			entry.id = ++m_lastID;
+			entry.active = true;
+
+			m_indices.emplace(String{ name }, index);
+		}
+
+		m_dirty = true;
+		m_buildFailed = false;
+		return true;
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::remove(const StringView name)
+	{
+		auto it = m_indices.find(name);
+
+		if (it == m_indices.end())
+		{
+			return false;
+		}
+
+		const uint32 index = it->second;
+		m_indices.erase(it);
+
+		release(m_entries[index]);
+		m_freeIndices.push_back(index);
+
+		// 末尾の使われていない要素を取り除く
+		if (not m_entries.back().active)
+		{
+			while (m_entries && (not m_entries.back().active))
+			{
+				m_entries.pop_back();
+			}
+
+			m_freeIndices.remove_if([size = m_entries.size()](const uint32 i) { return (size <= i); });
+		}
+
+		m_dirty = true;
+		m_buildFailed = false;
+		return true;
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::contains(const StringView name) const
+	{
+		return m_indices.contains(name);
+	}
+
+	size_t TextureAtlas::TextureAtlasDetail::num_images() const noexcept
+	{
+		return m_indices.size();
+	}
+
+	Optional<uint32> TextureAtlas::TextureAtlasDetail::find(const StringView name) const
+	{
+		if (auto it = m_indices.find(name);
+			it != m_indices.end())
+		{
+			return it->second;
+		}
+
+		return none;
+	}
+
+	uint64 TextureAtlas::TextureAtlasDetail::getID(const uint32 index) const noexcept
+	{
+		return (isValid(index) ? m_entries[index].id : 0);
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::build()
+	{
+		if (not m_dirty)
+		{
+			return true;
+		}
+
+		if (m_buildFailed)
+		{
+			return false;
+		}
+
+		if (m_indices.empty())
+		{
+			m_layout.clear();
+			m_image.release();
+			m_texture.release();
+			m_size = Size{ 0, 0 };
+			m_dirty = false;
+			++m_version;
+			return true;
+		}
+
+		// 新しい画像と、確保済みの領域に収まらなくなった画像だけを空き領域に配置する
+		Array<uint32> indices;
+		Array<Size> sizes;
+
+		for (uint32 i = 0; i < m_entries.size(); ++i)
+		{
+			const Entry& entry = m_entries[i];
+
+			if (entry.active && (not entry.placed))
+			{
+				indices.push_back(i);
+				sizes.push_back(entry.image.size() + Size::All(m_padding * 2));
+			}
+		}
+
+		Array<Rect> slots;
+		bool repacked = false;
+
+		if (not m_layout.insert(sizes, slots))
+		{
+			// 空き領域が足りない場合は、すべての画像を配置し直す
+			indices.clear();
+			sizes.clear();
+
+			for (uint32 i = 0; i < m_entries.size(); ++i)
+			{
+				const Entry& entry = m_entries[i];
+
+				if (entry.active)
+				{
+					indices.push_back(i);
+					sizes.push_back(entry.image.size() + Size::All(m_padding * 2));
+				}
+			}
+
+			if (not m_layout.repack(sizes, slots))
+			{
+				LOG_FAIL(U"❌ TextureAtlas::build(): Failed to pack {} images into {}x{}"_fmt(indices.size(), m_maxSide, m_maxSide));
+				m_buildFailed = true;
+				return false;
+			}
+
+			repacked = true;
+		}
+
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			Entry& entry = m_entries[indices[i]];
+			entry.slot = slots[i];
+			entry.rect.set((entry.slot.x + m_padding), (entry.slot.y + m_padding), entry.image.size());
+			entry.placed = true;
+			entry.uploaded = false;
+		}
+
+		compose(repacked);
+
+		m_dirty = false;
+		++m_version;
+
+		LOG_TRACE(U"TextureAtlas::build(): {} {} images into {}"_fmt((repacked ? U"Repacked" : U"Inserted"), indices.size(), m_size));
+
+		return true;
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::isValid(const uint32 index) const noexcept
+	{
+		return ((index < m_entries.size()) && m_entries[index].active);
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::isValid(const uint32 index, const uint64 id) const noexcept
+	{
+		return (isValid(index) && (m_entries[index].id == id));
+	}
+
+	TextureRegion TextureAtlas::TextureAtlasDetail::getRegion(const uint32 index)
+	{
+		build();
+
+		if (not isValid(index))
+		{
+			return{};
+		}
+
+		const Entry& entry = m_entries[index];
+
+		if ((not entry.placed) || (m_size.x == 0))
+		{
+			return{};
+		}
+
+		const float invW = (1.0f / m_size.x);
+		const float invH = (1.0f / m_size.y);
+		const Rect& rect = entry.rect;
+
+		return{ m_texture,
+			FloatRect{ (rect.x * invW), (rect.y * invH), ((rect.x + rect.w) * invW), ((rect.y + rect.h) * invH) },
+			Vec2{ rect.size } };
+	}
+
+	Size TextureAtlas::TextureAtlasDetail::getImageSize(const uint32 index) const noexcept
+	{
+		if (not isValid(index))
+		{
+			return{ 0, 0 };
+		}
+
+		return m_entries[index].image.size();
+	}
+
+	const Texture& TextureAtlas::TextureAtlasDetail::getTexture()
+	{
+		build();
+
+		return m_texture;
+	}
+
+	Size TextureAtlas::TextureAtlasDetail::size()
+	{
+		build();
+
+		return m_size;
+	}
+
+	uint64 TextureAtlas::TextureAtlasDetail::version() const noexcept
+	{
+		return m_version;
+	}
+
+	void TextureAtlas::TextureAtlasDetail::release(Entry& entry)
+	{
+		if (entry.placed)
+		{
+			m_layout.release(entry.slot);
+		}
+
+		entry = Entry{};
+	}
+
+	void TextureAtlas::TextureAtlasDetail::compose(const bool repacked)
+	{
+		const Size size = m_layout.size();
+
+		if (repacked || (m_image.size() != size))
+		{
+			Image image{ size, Color{ 0, 0 } };
+
+			// 拡大しただけなら、配置済みの画像はそのまま引き継げる
+			if ((not repacked) && m_image)
+			{
+				m_image.overwrite(image, Point{ 0, 0 });
+			}
+
+			m_image = std::move(image);
+		}
+
+		Array<Rect> updatedRects;
+
+		for (auto& entry : m_entries)
+		{
+			if (entry.placed && (not entry.uploaded))
+			{
+				entry.image.overwrite(m_image, entry.rect.pos);
+
+				if (m_padding)
+				{
+					detail::FillPadding(m_image, entry.rect, m_padding);
+				}
+
+				updatedRects.push_back(entry.slot);
+				entry.uploaded = true;
+			}
+		}
+
+		// サイズが変わらなければ、更新した領域だけをテクスチャに転送する
+		if ((size == m_size) && m_texture)
+		{
+			bool succeeded = true;
+
+			for (const auto& rect : updatedRects)
+			{
+				if (not m_texture.fillRegion(m_image, rect))
+				{
+					succeeded = false;
+					break;
+				}
+			}
+
+			if (succeeded)
+			{
+				return;
+			}
+		}
+
+		m_texture = DynamicTexture{ m_image, m_desc };
+		m_size = size;
+	}
+}
@@ -0,0 +1,126 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/TextureAtlas.hpp>
+# include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/HashTable.hpp>
+# include "TextureAtlasLayout.hpp"
+
+namespace s3d
+{
+	class TextureAtlas::TextureAtlasDetail
+	{
+	public:
+
+		TextureAtlasDetail(int32 maxSide, int32 padding, TextureDesc desc);
+
+		bool add(StringView name, Image&& image);
+
+		bool remove(StringView name);
+
+		[[nodiscard]]
+		bool contains(StringView name) const;
+
+		[[nodiscard]]
+		size_t num_images() const noexcept;
+
+		[[nodiscard]]
+		Optional<uint32> find(StringView name) const;
+
+		[[nodiscard]]
+		uint64 getID(uint32 index) const noexcept;
+
+		bool build();
+
+		[[nodiscard]]
+		bool isValid(uint32 index) const noexcept;
+
+		[[nodiscard]]
+		bool isValid(uint32 index, uint64 id) const noexcept;
+
+		[[nodiscard]]
+		TextureRegion getRegion(uint32 index);
+
+		[[nodiscard]]
+		Size getImageSize(uint32 index) const noexcept;
+
+		[[nodiscard]]
+		const Texture& getTexture();
+
+		[[nodiscard]]
+		Size size();
+
+		[[nodiscard]]
+		uint64 version() const noexcept;
+
+	private:
+
+		struct Entry
+		{
+			String name;
+
+			Image image;
+
+			// パディングを含まない、アトラス内の領域
+			Rect rect{ 0 };
+
+			// パディングを含む、確保した領域
+			Rect slot{ 0 };
+
+			// 添字を再利用しても古いハンドルと区別できるよう、画像ごとに一意な ID
+			uint64 id = 0;
+
+			bool active = false;
+
+			// アトラス内の領域が確保済みか
+			bool placed = false;
+
+			// 現在の画像がテクスチャに転送済みか
+			bool uploaded = false;
+		};
+
+		Array<Entry> m_entries;
+
+		// 削除した要素の添字。新しい画像に再利用する
+		Array<uint32> m_freeIndices;
+
+		HashTable<String, uint32> m_indices;
+
+		int32 m_maxSide = TextureAtlas::DefaultMaxSide;
+
+		int32 m_padding = TextureAtlas::DefaultPadding;
+
+		TextureDesc m_desc = TextureDesc::Unmipped;
+
+		TextureAtlasLayout m_layout;
+
+		// テクスチャと同じ内容の画像
+		Image m_image;
+
+		DynamicTexture m_texture;
+
+		Size m_size{ 0, 0 };
+
+		bool m_dirty = false;
+
+		// 画像が追加・削除されるまで、配置に失敗した build() を繰り返さない
+		bool m_buildFailed = false;
+
+		uint64 m_version = 0;
+
+		uint64 m_lastID = 0;
+
+		void release(Entry& entry);
+
+		void compose(bool repacked);
+	};
+}
@@ -0,0 +1,309 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <numeric>
+# include <Siv3D/RectanglePacking.hpp>
+# include "TextureAtlasLayout.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static int32 CeilPowerOfTwo(const int32 n, const int32 maxSide) noexcept
+		{
+			int32 result = 1;
+
+			while ((result < n) && (result < maxSide))
+			{
+				result *= 2;
+			}
+
+			return Min(result, maxSide);
+		}
+
+		// 辺が接しているだけの場合は重ならない
+		[[nodiscard]]
+		static bool Overlaps(const Rect& a, const Rect& b) noexcept
+		{
+			return ((a.x < (b.x + b.w)) && (b.x < (a.x + a.w))
+				&& (a.y < (b.y + b.h)) && (b.y < (a.y + a.h)));
+		}
+
+		[[nodiscard]]
+		static bool Contains(const Rect& a, const Rect& b) noexcept
+		{
+			return ((a.x <= b.x) && (a.y <= b.y)
+				&& ((b.x + b.w) <= (a.x + a.w)) && ((b.y + b.h) <= (a.y + a.h)));
+		}
+
+		// 他の空き領域に含まれる空き領域を取り除く
+		static void Prune(Array<Rect>& freeRects)
+		{
+			for (size_t i = 0; i < freeRects.size(); ++i)
+			{
+				for (size_t k = (i + 1); k < freeRects.size();)
+				{
+					if (Contains(freeRects[i], freeRects[k]))
+					{
+						freeRects.erase(freeRects.begin() + k);
+					}
+					else if (Contains(freeRects[k], freeRects[i]))
+					{
+						freeRects.erase(freeRects.begin() + i);
+						--i;
+						break;
+					}
+					else
+					{
+						++k;
+					}
+				}
+			}
+		}
+
+		// 使用する領域と重なる空き領域を、重ならない部分に分割する
+		static void Occupy(Array<Rect>& freeRects, const Rect& used)
+		{
+			Array<Rect> splits;
+
+			freeRects.remove_if([&](const Rect& free)
+			{
+				if (not Overlaps(free, used))
+				{
+					return false;
+				}
+
+				if (free.x < used.x)
+				{
+					splits.emplace_back(free.x, free.y, (used.x - free.x), free.h);
+				}
+
+				if ((used.x + used.w) < (free.x + free.w))
+				{
+					splits.emplace_back((used.x + used.w), free.y, ((free.x + free.w) - (used.x + used.w)), free.h);
+				}
+
+				if (free.y < used.y)
+				{
+					splits.emplace_back(free.x, free.y, free.w, (used.y - free.y));
+				}
+
+				if ((used.y + used.h) < (free.y + free.h))
+				{
+					splits.emplace_back(free.x, (used.y + used.h), free.w, ((free.y + free.h) - (used.y + used.h)));
+				}
+
+				return true;
+			});
+
+			freeRects.append(splits);
+
+			Prune(freeRects);
+		}
+
+		// 短い辺の余りが最も小さくなる空き領域に配置する
+		[[nodiscard]]
+		static Optional<Rect> Allocate(Array<Rect>& freeRects, const Size& size)
+		{
+			Optional<Rect> result;
+			int32 bestShortSide = INT32_MAX;
+			int32 bestLongSide = INT32_MAX;
+
+			for (const auto& free : freeRects)
+			{
+				if ((free.w < size.x) || (free.h < size.y))
+				{
+					continue;
+				}
+
+				const int32 shortSide = Min((free.w - size.x), (free.h - size.y));
+				const int32 longSide = Max((free.w - size.x), (free.h - size.y));
+
+				if ((shortSide < bestShortSide)
+					|| ((shortSide == bestShortSide) && (longSide < bestLongSide)))
+				{
+					result = Rect{ free.pos, size };
+					bestShortSide = shortSide;
+					bestLongSide = longSide;
+				}
+			}
+
+			if (result)
+			{
+				Occupy(freeRects, *result);
+			}
+
+			return result;
+		}
+
+		// 短い辺を 2 倍に拡大し、増えた領域を空き領域に加える
+		[[nodiscard]]
+		static bool Grow(Size& size, Array<Rect>& freeRects, const int32 maxSide)
+		{
+			Size newSize = size;
+
+			if ((size.x <= size.y) && (size.x < maxSide))
+			{
+				newSize.x = Min((size.x * 2), maxSide);
+			}
+			else if (size.y < maxSide)
+			{
+				newSize.y = Min((size.y * 2), maxSide);
+			}
+			else if (size.x < maxSide)
+			{
+				newSize.x = Min((size.x * 2), maxSide);
+			}
+			else
+			{
+				return false;
+			}
+
+			// 右端・下端に接する空き領域は、拡大した領域まで伸ばせる
+			for (auto& free : freeRects)
+			{
+				if ((free.x + free.w) == size.x)
+				{
+					free.w = (newSize.x - free.x);
+				}
+
+				if ((free.y + free.h) == size.y)
+				{
+					free.h = (newSize.y - free.y);
+				}
+			}
+
+			if (size.x < newSize.x)
+			{
+				freeRects.emplace_back(size.x, 0, (newSize.x - size.x), newSize.y);
+			}
+
+			if (size.y < newSize.y)
+			{
+				freeRects.emplace_back(0, size.y, newSize.x, (newSize.y - size.y));
+			}
+
+			Prune(freeRects);
+
+			size = newSize;
+			return true;
+		}
+	}
+
+	TextureAtlasLayout::TextureAtlasLayout(const int32 maxSide)
+		: m_maxSide{ Max(maxSide, 1) } {}
+
+	bool TextureAtlasLayout::insert(const Array<Size>& sizes, Array<Rect>& rects)
+	{
+		if (not sizes)
+		{
+			rects.clear();
+			return true;
+		}
+
+		Size size = m_size;
+		Array<Rect> freeRects = m_freeRects;
+
+		// 大きい長方形から順に配置する
+		Array<size_t> order(sizes.size());
+		std::iota(order.begin(), order.end(), 0);
+		order.stable_sort_by([&](const size_t a, const size_t b)
+		{
+			return (Max(sizes[b].x, sizes[b].y) < Max(sizes[a].x, sizes[a].y));
+		});
+
+		if ((size.x == 0) || (size.y == 0))
+		{
+			const Size& first = sizes[order.front()];
+			size.set(detail::CeilPowerOfTwo(first.x, m_maxSide), detail::CeilPowerOfTwo(first.y, m_maxSide));
+			freeRects = { Rect{ size } };
+		}
+
+		Array<Rect> results(sizes.size());
+
+		for (const auto i : order)
+		{
+			for (;;)
+			{
+				if (const auto rect = detail::Allocate(freeRects, sizes[i]))
+				{
+					results[i] = *rect;
+					break;
+				}
+
+				if (not detail::Grow(size, freeRects, m_maxSide))
+				{
+					return false;
+				}
+			}
+		}
+
+		m_size = size;
+		m_freeRects = std::move(freeRects);
+		rects = std::move(results);
+		return true;
+	}
+
+	bool TextureAtlasLayout::repack(const Array<Size>& sizes, Array<Rect>& rects)
+	{
+		if (not sizes)
+		{
+			clear();
+			rects.clear();
+			return true;
+		}
+
+		const RectanglePack pack = RectanglePacking::Pack(sizes.map([](const Size& size) { return Rect{ size }; }), m_maxSide);
+
+		if ((pack.size.x <= 0) || (pack.size.y <= 0)
+			|| (m_maxSide < pack.size.x) || (m_maxSide < pack.size.y)
+			|| (pack.rects.size() != sizes.size()))
+		{
+			return false;
+		}
+
+		// テクスチャを作り直す回数を減らすため、サイズを 2 の累乗に切り上げる
+		m_size.set(detail::CeilPowerOfTwo(pack.size.x, m_maxSide), detail::CeilPowerOfTwo(pack.size.y, m_maxSide));
+		m_freeRects = { Rect{ m_size } };
+
+		for (const auto& rect : pack.rects)
+		{
+			detail::Occupy(m_freeRects, rect);
+		}
+
+		rects = pack.rects;
+		return true;
+	}
+
+	void TextureAtlasLayout::release(const Rect& rect)
+	{
+		m_freeRects.push_back(rect);
+
+		detail::Prune(m_freeRects);
+	}
+
+	void TextureAtlasLayout::clear()
+	{
+		m_size = Size{ 0, 0 };
+		m_freeRects.clear();
+	}
+
+	Size TextureAtlasLayout::size() const noexcept
+	{
+		return m_size;
+	}
+
+	const Array<Rect>& TextureAtlasLayout::getFreeRects() const noexcept
+	{
+		return m_freeRects;
+	}
+}
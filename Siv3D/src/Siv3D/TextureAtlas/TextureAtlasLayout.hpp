@@ -0,0 +1,57 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/2DShapes.hpp>
+
+namespace s3d
+{
+	// テクスチャアトラスの空き領域を管理し、長方形を配置する
+	// 配置済みの長方形は、repack() を呼ぶまで移動しない
+	class TextureAtlasLayout
+	{
+	public:
+
+		explicit TextureAtlasLayout(int32 maxSide);
+
+		// 空き領域に長方形を追加で配置する。空き領域が足りなければ、最大サイズまでアトラスを拡大する
+		// 失敗した場合は何も変更しない
+		[[nodiscard]]
+		bool insert(const Array<Size>& sizes, Array<Rect>& rects);
+
+		// すべての長方形を配置し直す
+		// 失敗した場合は何も変更しない
+		[[nodiscard]]
+		bool repack(const Array<Size>& sizes, Array<Rect>& rects);
+
+		// 配置済みの長方形の領域を空き領域に戻す
+		void release(const Rect& rect);
+
+		void clear();
+
+		[[nodiscard]]
+		Size size() const noexcept;
+
+		[[nodiscard]]
+		const Array<Rect>& getFreeRects() const noexcept;
+
+	private:
+
+		int32 m_maxSide = 1;
+
+		Size m_size{ 0, 0 };
+
+		// 互いに重なりうる、極大な空き領域
+		Array<Rect> m_freeRects;
+	};
+}
@@ -0,0 +1,212 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "CThreadPool.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static constexpr size_t NotWorker = static_cast<size_t>(-1);
+
+		// 現在のスレッドがどのプールの何番目のワーカーか
+		static thread_local const CThreadPool* tl_pool = nullptr;
+
+		static thread_local size_t tl_workerIndex = NotWorker;
+	}
+
+	CThreadPool::~CThreadPool()
+	{
+		LOG_SCOPED_TRACE(U"CThreadPool::~CThreadPool()");
+
+		{
+			std::lock_guard lock{ m_sleepMutex };
+			m_abort = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+	}
+
+	void CThreadPool::init()
+	{
+		LOG_SCOPED_TRACE(U"CThreadPool::init()");
+
+	# if SIV3D_PLATFORM(WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+		const size_t numWorkers = 0;
+
+	# else
+
+		// 呼び出し元のスレッドも処理に参加するため 1 つ少なくする
+		const size_t numWorkers = (Threading::GetConcurrency() - 1);
+
+	# endif
+
+		for (size_t i = 0; i < numWorkers; ++i)
+		{
+			m_queues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		for (size_t i = 0; i < numWorkers; ++i)
+		{
+			m_threads.emplace_back([this, i]() { workerLoop(i); });
+		}
+
+		LOG_INFO(U"ℹ️ Thread pool: {} worker threads"_fmt(numWorkers));
+	}
+
+	size_t CThreadPool::getWorkerCount() const noexcept
+	{
+		return m_threads.size();
+	}
+
+	void CThreadPool::submit(Task task)
+	{
+		if (m_threads.isEmpty())
+		{
+			task();
+			return;
+		}
+
+		if ((detail::tl_pool == this) && (detail::tl_workerIndex != detail::NotWorker))
+		{
+			auto& queue = *m_queues[detail::tl_workerIndex];
+			std::lock_guard lock{ queue.mutex };
+			queue.tasks.push_back(std::move(task));
+		}
+		else
+		{
+			std::lock_guard lock{ m_injectionQueue.mutex };
+			m_injectionQueue.tasks.push_back(std::move(task));
+		}
+
+		++m_pendingCount;
+
+		wakeOne();
+	}
+
+	bool CThreadPool::tryRunPendingTask()
+	{
+		if (m_pendingCount.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		const size_t workerIndex = ((detail::tl_pool == this) ? detail::tl_workerIndex : detail::NotWorker);
+
+		Task task;
+
+		if (not popTask(workerIndex, task))
+		{
+			return false;
+		}
+
+		task();
+
+		return true;
+	}
+
+	void CThreadPool::workerLoop(const size_t workerIndex)
+	{
+		detail::tl_pool = this;
+		detail::tl_workerIndex = workerIndex;
+
+		while (not m_abort)
+		{
+			Task task;
+
+			if (popTask(workerIndex, task))
+			{
+				task();
+				continue;
+			}
+
+			std::unique_lock lock{ m_sleepMutex };
+			m_sleepCondition.wait(lock, [this]() { return (m_abort || (0 < m_pendingCount)); });
+		}
+	}
+
+	bool CThreadPool::popTask(const size_t workerIndex, Task& task)
+	{
+		// 自分のキューの末尾
+		if (workerIndex != detail::NotWorker)
+		{
+			auto& queue = *m_queues[workerIndex];
+			std::lock_guard lock{ queue.mutex };
+
+			if (not queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				--m_pendingCount;
+				return true;
+			}
+		}
+
+		// ワーカー以外から追加されたタスク
+		{
+			std::lock_guard lock{ m_injectionQueue.mutex };
+
+			if (not m_injectionQueue.tasks.empty())
+			{
+				task = std::move(m_injectionQueue.tasks.front());
+				m_injectionQueue.tasks.pop_front();
+				--m_pendingCount;
+				return true;
+			}
+		}
+
+		// 他のワーカーのキューの先頭から盗む
+		return stealTask(((workerIndex == detail::NotWorker) ? 0 : (workerIndex + 1)), task);
+	}
+
+	bool CThreadPool::stealTask(const size_t startIndex, Task& task)
+	{
+		const size_t numQueues = m_queues.size();
+
+		for (size_t i = 0; i < numQueues; ++i)
+		{
+			auto& queue = *m_queues[(startIndex + i) % numQueues];
+			std::unique_lock lock{ queue.mutex, std::try_to_lock };
+
+			if (lock.owns_lock() && (not queue.tasks.empty()))
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				--m_pendingCount;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CThreadPool::wakeOne()
+	{
+		{
+			// wait() の述語評価と通知の間の取りこぼしを防ぐ
+			std::lock_guard lock{ m_sleepMutex };
+		}
+
+		m_sleepCondition.notify_one();
+	}
+}
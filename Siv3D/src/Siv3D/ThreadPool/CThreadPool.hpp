@@ -0,0 +1,74 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <condition_variable>
+# include <deque>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <Siv3D/Array.hpp>
+# include "IThreadPool.hpp"
+
+namespace s3d
+{
+	class CThreadPool final : public ISiv3DThreadPool
+	{
+	public:
+
+		CThreadPool() = default;
+
+		~CThreadPool() override;
+
+		void init() override;
+
+		size_t getWorkerCount() const noexcept override;
+
+		void submit(Task task) override;
+
+		bool tryRunPendingTask() override;
+
+	private:
+
+		// 各ワーカーのタスクキュー
+		// 所有者は末尾から（LIFO）、他のスレッドは先頭から（FIFO）取り出す
+		struct WorkQueue
+		{
+			std::mutex mutex;
+
+			std::deque<Task> tasks;
+		};
+
+		Array<std::unique_ptr<WorkQueue>> m_queues;
+
+		Array<std::thread> m_threads;
+
+		// ワーカー以外のスレッドから追加されたタスク
+		WorkQueue m_injectionQueue;
+
+		std::mutex m_sleepMutex;
+
+		std::condition_variable m_sleepCondition;
+
+		std::atomic<size_t> m_pendingCount = 0;
+
+		std::atomic<bool> m_abort = false;
+
+		void workerLoop(size_t workerIndex);
+
+		bool popTask(size_t workerIndex, Task& task);
+
+		bool stealTask(size_t startIndex, Task& task);
+
+		void wakeOne();
+	};
+}
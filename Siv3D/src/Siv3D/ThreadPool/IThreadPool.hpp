@@ -0,0 +1,39 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <functional>
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	class SIV3D_NOVTABLE ISiv3DThreadPool
+	{
+	public:
+
+		using Task = std::function<void()>;
+
+		static ISiv3DThreadPool* Create();
+
+		virtual ~ISiv3DThreadPool() = default;
+
+		virtual void init() = 0;
+
+		/// @brief 呼び出し元スレッドを除いたワーカースレッドの数を返します。
+		virtual size_t getWorkerCount() const noexcept = 0;
+
+		virtual void submit(Task task) = 0;
+
+		/// @brief 待機中のタスクを 1 つ取り出して呼び出し元スレッドで実行します。
+		/// @return タスクを実行した場合 true, 待機中のタスクが無かった場合 false
+		virtual bool tryRunPendingTask() = 0;
+	};
+}
@@ -13,6 +13,7 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Unicode.hpp>
 # include "UnicodeUtility.hpp"
+# include "UnicodeKernels.hpp"
 
 namespace s3d
 {
@@ -27,16 +28,7 @@ namespace s3d
 		{
 			String result(detail::UTF32_Length(s), '0');
 
-			const char8* pSrc = s.data();
-			const char8* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-				*pDst++ = detail::utf8_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
-			}
+			UnicodeKernels::UTF8ToUTF32(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -45,16 +37,7 @@ namespace s3d
 		{
 			String result(detail::UTF32_Length(s), '0');
 
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
-			}
+			UnicodeKernels::UTF16ToUTF32(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -84,14 +67,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			UnicodeKernels::UTF32ToUTF8(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -141,18 +117,7 @@ namespace s3d
 		{
 			std::u32string result(detail::UTF32_Length(s), '0');
 
-			const char8* pSrc = s.data();
-			const char8* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				*pDst++ = detail::utf8_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-			}
+			UnicodeKernels::UTF8ToUTF32(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -181,18 +146,7 @@ namespace s3d
 		{
 			std::u32string result(detail::UTF32_Length(s), '0');
 
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-			}
+			UnicodeKernels::UTF16ToUTF32(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -201,14 +155,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			UnicodeKernels::UTF32ToUTF8(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -0,0 +1,566 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <ThirdParty/miniutf/miniutf.hpp>
+# include <Siv3D/CPUInfo.hpp>
+# include <Siv3D/SIMD.hpp>
+# include "UnicodeKernels.hpp"
+# include "UnicodeUtility.hpp"
+
+// x64 では AVX2 / SSE2 を実行時に選択する。ARM では SSE2 のコードが SIMDe によって NEON に変換される
+# if SIV3D_INTRINSIC(SSE) && (defined(_M_X64) || defined(__x86_64__))
+#	define SIV3D_UNICODE_KERNELS_X64 1
+#	include <immintrin.h>
+#	if defined(_MSC_VER) && !defined(__clang__)
+#		define SIV3D_TARGET_AVX2
+#	else
+#		define SIV3D_TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+# else
+#	define SIV3D_UNICODE_KERNELS_X64 0
+# endif
+
+namespace s3d
+{
+	namespace UnicodeKernels
+	{
+		namespace
+		{
+			//
+			// Reference
+			//
+
+			[[nodiscard]]
+			inline char32 DecodeUTF8(const char8*& pSrc, const char8* const pSrcEnd) noexcept
+			{
+				int32 offset;
+				const char32 codePoint = detail::utf8_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+				return codePoint;
+			}
+
+			[[nodiscard]]
+			inline char32 DecodeUTF16(const char16*& pSrc, const char16* const pSrcEnd) noexcept
+			{
+				int32 offset;
+				const char32 codePoint = detail::utf16_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+				return codePoint;
+			}
+
+			size_t UTF8ToUTF32Length_Reference(const char8* pSrc, const char8* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (pSrc != pSrcEnd)
+				{
+					[[maybe_unused]] const char32 codePoint = DecodeUTF8(pSrc, pSrcEnd);
+					++length;
+				}
+
+				return length;
+			}
+
+			char32* UTF8ToUTF32_Reference(const char8* pSrc, const char8* const pSrcEnd, char32* pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					*pDst++ = DecodeUTF8(pSrc, pSrcEnd);
+				}
+
+				return pDst;
+			}
+
+			size_t UTF16ToUTF32Length_Reference(const char16* pSrc, const char16* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (pSrc != pSrcEnd)
+				{
+					[[maybe_unused]] const char32 codePoint = DecodeUTF16(pSrc, pSrcEnd);
+					++length;
+				}
+
+				return length;
+			}
+
+			char32* UTF16ToUTF32_Reference(const char16* pSrc, const char16* const pSrcEnd, char32* pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					*pDst++ = DecodeUTF16(pSrc, pSrcEnd);
+				}
+
+				return pDst;
+			}
+
+			size_t UTF32ToUTF8Length_Reference(const char32* pSrc, const char32* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (pSrc != pSrcEnd)
+				{
+					length += detail::UTF8_Length(*pSrc++);
+				}
+
+				return length;
+			}
+
+			char8* UTF32ToUTF8_Reference(const char32* pSrc, const char32* const pSrcEnd, char8* pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					detail::UTF8_Encode(&pDst, *pSrc++);
+				}
+
+				return pDst;
+			}
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			//
+			// SSE2
+			//
+
+			[[nodiscard]]
+			inline __m128i Load(const void* p) noexcept
+			{
+				return ::_mm_loadu_si128(static_cast<const __m128i*>(p));
+			}
+
+			inline void Store(void* p, const __m128i v) noexcept
+			{
+				::_mm_storeu_si128(static_cast<__m128i*>(p), v);
+			}
+
+			// マスクの最下位の立っているビットの位置
+			[[nodiscard]]
+			inline int32 LowestBit(const int32 mask) noexcept
+			{
+				return std::countr_zero(static_cast<uint32>(mask));
+			}
+
+			// ASCII の連続は 16 バイトずつ変換し、それ以外は 1 文字ずつ変換する
+			size_t UTF8ToUTF32Length_SSE2(const char8* pSrc, const char8* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (pSrc != pSrcEnd)
+				{
+					while (16 <= (pSrcEnd - pSrc))
+					{
+						if (const int32 mask = ::_mm_movemask_epi8(Load(pSrc)))
+						{
+							const int32 n = LowestBit(mask);
+							pSrc += n;
+							length += n;
+							break;
+						}
+
+						pSrc += 16;
+						length += 16;
+					}
+
+					if (pSrc != pSrcEnd)
+					{
+						[[maybe_unused]] const char32 codePoint = DecodeUTF8(pSrc, pSrcEnd);
+						++length;
+					}
+				}
+
+				return length;
+			}
+
+			char32* UTF8ToUTF32_SSE2(const char8* pSrc, const char8* const pSrcEnd, char32* pDst) noexcept
+			{
+				const __m128i zero = ::_mm_setzero_si128();
+
+				while (pSrc != pSrcEnd)
+				{
+					while (16 <= (pSrcEnd - pSrc))
+					{
+						const __m128i v = Load(pSrc);
+
+						if (const int32 mask = ::_mm_movemask_epi8(v))
+						{
+							const int32 n = LowestBit(mask);
+
+							for (int32 i = 0; i < n; ++i)
+							{
+								*pDst++ = static_cast<uint8>(*pSrc++);
+							}
+
+							break;
+						}
+
+						const __m128i lo = ::_mm_unpacklo_epi8(v, zero);
+						const __m128i hi = ::_mm_unpackhi_epi8(v, zero);
+						Store((pDst + 0), ::_mm_unpacklo_epi16(lo, zero));
+						Store((pDst + 4), ::_mm_unpackhi_epi16(lo, zero));
+						Store((pDst + 8), ::_mm_unpacklo_epi16(hi, zero));
+						Store((pDst + 12), ::_mm_unpackhi_epi16(hi, zero));
+						pSrc += 16;
+						pDst += 16;
+					}
+
+					if (pSrc != pSrcEnd)
+					{
+						*pDst++ = DecodeUTF8(pSrc, pSrcEnd);
+					}
+				}
+
+				return pDst;
+			}
+
+			// サロゲートを含まない 8 要素を返す。含む場合は、その位置までの要素数を返す
+			[[nodiscard]]
+			inline int32 NonSurrogateCount(const __m128i v) noexcept
+			{
+				const __m128i surrogate = ::_mm_cmpeq_epi16(::_mm_and_si128(v, ::_mm_set1_epi16(static_cast<int16>(0xF800))), ::_mm_set1_epi16(static_cast<int16>(0xD800)));
+
+				if (const int32 mask = ::_mm_movemask_epi8(surrogate))
+				{
+					return (LowestBit(mask) / 2);
+				}
+
+				return 8;
+			}
+
+			// サロゲートを含まない連続は 8 要素ずつ変換し、それ以外は 1 文字ずつ変換する
+			size_t UTF16ToUTF32Length_SSE2(const char16* pSrc, const char16* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (pSrc != pSrcEnd)
+				{
+					while (8 <= (pSrcEnd - pSrc))
+					{
+						const int32 n = NonSurrogateCount(Load(pSrc));
+						pSrc += n;
+						length += n;
+
+						if (n != 8)
+						{
+							break;
+						}
+					}
+
+					if (pSrc != pSrcEnd)
+					{
+						[[maybe_unused]] const char32 codePoint = DecodeUTF16(pSrc, pSrcEnd);
+						++length;
+					}
+				}
+
+				return length;
+			}
+
+			char32* UTF16ToUTF32_SSE2(const char16* pSrc, const char16* const pSrcEnd, char32* pDst) noexcept
+			{
+				const __m128i zero = ::_mm_setzero_si128();
+
+				while (pSrc != pSrcEnd)
+				{
+					while (8 <= (pSrcEnd - pSrc))
+					{
+						const __m128i v = Load(pSrc);
+
+						if (const int32 n = NonSurrogateCount(v); n != 8)
+						{
+							for (int32 i = 0; i < n; ++i)
+							{
+								*pDst++ = *pSrc++;
+							}
+
+							break;
+						}
+
+						Store((pDst + 0), ::_mm_unpacklo_epi16(v, zero));
+						Store((pDst + 4), ::_mm_unpackhi_epi16(v, zero));
+						pSrc += 8;
+						pDst += 8;
+					}
+
+					if (pSrc != pSrcEnd)
+					{
+						*pDst++ = DecodeUTF16(pSrc, pSrcEnd);
+					}
+				}
+
+				return pDst;
+			}
+
+			// 16 要素がすべて ASCII であるか
+			[[nodiscard]]
+			inline bool IsASCII16(const __m128i v0, const __m128i v1, const __m128i v2, const __m128i v3) noexcept
+			{
+				const __m128i bits = ::_mm_or_si128(::_mm_or_si128(v0, v1), ::_mm_or_si128(v2, v3));
+				const __m128i nonASCII = ::_mm_and_si128(bits, ::_mm_set1_epi32(~0x7F));
+				return (::_mm_movemask_epi8(::_mm_cmpeq_epi32(nonASCII, ::_mm_setzero_si128())) == 0xFFFF);
+			}
+
+			// 16 要素ずつ調べ、すべて ASCII であればまとめて変換する
+			size_t UTF32ToUTF8Length_SSE2(const char32* pSrc, const char32* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (16 <= (pSrcEnd - pSrc))
+				{
+					if (IsASCII16(Load(pSrc), Load(pSrc + 4), Load(pSrc + 8), Load(pSrc + 12)))
+					{
+						length += 16;
+					}
+					else
+					{
+						length += UTF32ToUTF8Length_Reference(pSrc, (pSrc + 16));
+					}
+
+					pSrc += 16;
+				}
+
+				return (length + UTF32ToUTF8Length_Reference(pSrc, pSrcEnd));
+			}
+
+			char8* UTF32ToUTF8_SSE2(const char32* pSrc, const char32* const pSrcEnd, char8* pDst) noexcept
+			{
+				while (16 <= (pSrcEnd - pSrc))
+				{
+					const __m128i v0 = Load(pSrc);
+					const __m128i v1 = Load(pSrc + 4);
+					const __m128i v2 = Load(pSrc + 8);
+					const __m128i v3 = Load(pSrc + 12);
+
+					if (IsASCII16(v0, v1, v2, v3))
+					{
+						Store(pDst, ::_mm_packus_epi16(::_mm_packs_epi32(v0, v1), ::_mm_packs_epi32(v2, v3)));
+						pDst += 16;
+					}
+					else
+					{
+						pDst = UTF32ToUTF8_Reference(pSrc, (pSrc + 16), pDst);
+					}
+
+					pSrc += 16;
+				}
+
+				return UTF32ToUTF8_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+		# endif
+
+		# if SIV3D_UNICODE_KERNELS_X64
+
+			//
+			// AVX2
+			//
+
+			// ASCII の連続は 32 バイトずつ変換し、それ以外は 1 文字ずつ変換する
+			SIV3D_TARGET_AVX2
+			size_t UTF8ToUTF32Length_AVX2(const char8* pSrc, const char8* const pSrcEnd) noexcept
+			{
+				size_t length = 0;
+
+				while (pSrc != pSrcEnd)
+				{
+					while (32 <= (pSrcEnd - pSrc))
+					{
+						if (const int32 mask = ::_mm256_movemask_epi8(::_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc))))
+						{
+							const int32 n = LowestBit(mask);
+							pSrc += n;
+							length += n;
+							break;
+						}
+
+						pSrc += 32;
+						length += 32;
+					}
+
+					if (pSrc != pSrcEnd)
+					{
+						[[maybe_unused]] const char32 codePoint = DecodeUTF8(pSrc, pSrcEnd);
+						++length;
+					}
+				}
+
+				return length;
+			}
+
+			SIV3D_TARGET_AVX2
+			char32* UTF8ToUTF32_AVX2(const char8* pSrc, const char8* const pSrcEnd, char32* pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					while (32 <= (pSrcEnd - pSrc))
+					{
+						if (const int32 mask = ::_mm256_movemask_epi8(::_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc))))
+						{
+							const int32 n = LowestBit(mask);
+
+							for (int32 i = 0; i < n; ++i)
+							{
+								*pDst++ = static_cast<uint8>(*pSrc++);
+							}
+
+							break;
+						}
+
+						for (int32 i = 0; i < 32; i += 8)
+						{
+							const __m256i v = ::_mm256_cvtepu8_epi32(::_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc + i)));
+							::_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), v);
+						}
+
+						pSrc += 32;
+						pDst += 32;
+					}
+
+					if (pSrc != pSrcEnd)
+					{
+						*pDst++ = DecodeUTF8(pSrc, pSrcEnd);
+					}
+				}
+
+				return pDst;
+			}
+
+		# endif
+
+			enum class KernelLevel
+			{
+				Reference,
+
+				SSE2,
+
+				AVX2,
+			};
+
+			[[nodiscard]]
+			KernelLevel GetKernelLevel() noexcept
+			{
+			# if SIV3D_UNICODE_KERNELS_X64
+
+				static const KernelLevel level = []()
+				{
+					if (GetCPUInfo().features.avx2)
+					{
+						return KernelLevel::AVX2;
+					}
+
+					return KernelLevel::SSE2;
+				}();
+
+				return level;
+
+			# elif SIV3D_INTRINSIC(SSE)
+
+				return KernelLevel::SSE2;
+
+			# else
+
+				return KernelLevel::Reference;
+
+			# endif
+			}
+		}
+
+		size_t UTF8ToUTF32Length(const char8* pSrc, const size_t length) noexcept
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_UNICODE_KERNELS_X64
+			case KernelLevel::AVX2:
+				return UTF8ToUTF32Length_AVX2(pSrc, (pSrc + length));
+		# endif
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::SSE2:
+				return UTF8ToUTF32Length_SSE2(pSrc, (pSrc + length));
+		# endif
+			default:
+				return UTF8ToUTF32Length_Reference(pSrc, (pSrc + length));
+			}
+		}
+
+		char32* UTF8ToUTF32(const char8* pSrc, const size_t length, char32* pDst) noexcept
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_UNICODE_KERNELS_X64
+			case KernelLevel::AVX2:
+				return UTF8ToUTF32_AVX2(pSrc, (pSrc + length), pDst);
+		# endif
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::SSE2:
+				return UTF8ToUTF32_SSE2(pSrc, (pSrc + length), pDst);
+		# endif
+			default:
+				return UTF8ToUTF32_Reference(pSrc, (pSrc + length), pDst);
+			}
+		}
+
+		size_t UTF16ToUTF32Length(const char16* pSrc, const size_t length) noexcept
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::AVX2:
+			case KernelLevel::SSE2:
+				return UTF16ToUTF32Length_SSE2(pSrc, (pSrc + length));
+		# endif
+			default:
+				return UTF16ToUTF32Length_Reference(pSrc, (pSrc + length));
+			}
+		}
+
+		char32* UTF16ToUTF32(const char16* pSrc, const size_t length, char32* pDst) noexcept
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::AVX2:
+			case KernelLevel::SSE2:
+				return UTF16ToUTF32_SSE2(pSrc, (pSrc + length), pDst);
+		# endif
+			default:
+				return UTF16ToUTF32_Reference(pSrc, (pSrc + length), pDst);
+			}
+		}
+
+		size_t UTF32ToUTF8Length(const char32* pSrc, const size_t length) noexcept
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::AVX2:
+			case KernelLevel::SSE2:
+				return UTF32ToUTF8Length_SSE2(pSrc, (pSrc + length));
+		# endif
+			default:
+				return UTF32ToUTF8Length_Reference(pSrc, (pSrc + length));
+			}
+		}
+
+		char8* UTF32ToUTF8(const char32* pSrc, const size_t length, char8* pDst) noexcept
+		{
+			switch (GetKernelLevel())
+			{
+		# if SIV3D_INTRINSIC(SSE)
+			case KernelLevel::AVX2:
+			case KernelLevel::SSE2:
+				return UTF32ToUTF8_SSE2(pSrc, (pSrc + length), pDst);
+		# endif
+			default:
+				return UTF32ToUTF8_Reference(pSrc, (pSrc + length), pDst);
+			}
+		}
+	}
+}
@@ -0,0 +1,38 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	// 不正なビット列の扱いは detail::utf8_decode(), detail::utf16_decode() と同じ
+	namespace UnicodeKernels
+	{
+		[[nodiscard]]
+		size_t UTF8ToUTF32Length(const char8* pSrc, size_t length) noexcept;
+
+		// pDst は UTF8ToUTF32Length() の要素数を持つ。書き込んだ範囲の終端を返す
+		char32* UTF8ToUTF32(const char8* pSrc, size_t length, char32* pDst) noexcept;
+
+		[[nodiscard]]
+		size_t UTF16ToUTF32Length(const char16* pSrc, size_t length) noexcept;
+
+		// pDst は UTF16ToUTF32Length() の要素数を持つ。書き込んだ範囲の終端を返す
+		char32* UTF16ToUTF32(const char16* pSrc, size_t length, char32* pDst) noexcept;
+
+		[[nodiscard]]
+		size_t UTF32ToUTF8Length(const char32* pSrc, size_t length) noexcept;
+
+		// pDst は UTF32ToUTF8Length() の要素数を持つ。書き込んだ範囲の終端を返す
+		char8* UTF32ToUTF8(const char32* pSrc, size_t length, char8* pDst) noexcept;
+	}
+}
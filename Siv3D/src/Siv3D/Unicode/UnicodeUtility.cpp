@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include "UnicodeUtility.hpp"
+# include "UnicodeKernels.hpp"
 # include <ThirdParty/miniutf/miniutf.hpp>
 
 namespace s3d
@@ -68,17 +69,7 @@ namespace s3d
 
 		size_t UTF8_Length(const StringView s) noexcept
 		{
-			size_t result = 0;
-
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-
-			while (pSrc != pSrcEnd)
-			{
-				result += UTF8_Length(*pSrc++);
-			}
-
-			return result;
+			return UnicodeKernels::UTF32ToUTF8Length(s.data(), s.size());
 		}
 
 		void UTF8_Encode(char8** s, const char32 codePoint) noexcept
@@ -174,44 +165,12 @@ namespace s3d
 
 		size_t UTF32_Length(const std::string_view s) noexcept
 		{
-			size_t length = 0;
-
-			const char8* pSrc = s.data();
-			const char8* const pSrcEnd = pSrc + s.size();
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				utf8_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-
-				++length;
-			}
-
-			return length;
+			return UnicodeKernels::UTF8ToUTF32Length(s.data(), s.size());
 		}
 
 		size_t UTF32_Length(const std::u16string_view s) noexcept
 		{
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-
-			size_t length = 0;
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-
-				++length;
-			}
-
-			return length;
+			return UnicodeKernels::UTF16ToUTF32Length(s.data(), s.size());
 		}
 	}
 }
@@ -222,7 +222,7 @@ namespace s3d
 
 	//void VertexShaderAsset::LoadAsync(const AssetNameView name)
 	//{
-	//	SIV3D_ENGINE(Asset)->loadAsync(AssetType::VertexShader, name, {});
+	//	SIV3D_ENGINE(Asset)->loadAsync(AssetType::VertexShader, name, {}, AssetLoadPriority::Normal);
 	//}
 
 	//void VertexShaderAsset::Wait(const AssetNameView name)
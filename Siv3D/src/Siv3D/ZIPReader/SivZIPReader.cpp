@@ -56,6 +56,11 @@ namespace s3d
 		return pImpl->enumPaths();
 	}
 
+	bool ZIPReader::contains(const FilePathView filePath) const
+	{
+		return pImpl->contains(filePath);
+	}
+
 	bool ZIPReader::extractAll(const FilePathView targetDirectory) const
 	{
 		return pImpl->extractAll(targetDirectory);
@@ -75,4 +80,9 @@ namespace s3d
 	{
 		return pImpl->extractToBlob(filePath);
 	}
+
+	std::unique_ptr<IReader> ZIPReader::openReader(const FilePathView filePath) const
+	{
+		return pImpl->openReader(filePath);
+	}
 }
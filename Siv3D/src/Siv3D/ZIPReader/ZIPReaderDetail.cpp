@@ -11,8 +11,13 @@
 
 # include "ZIPReaderDetail.hpp"
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/ParallelFor.hpp>
+# include <Siv3D/HashSet.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <ThirdParty/zlib/zlib.h>
 # include <ThirdParty/minizip/mz.h>
+# include <ThirdParty/minizip/mz_os.h>
 # include <ThirdParty/minizip/mz_strm.h>
 # include <ThirdParty/minizip/mz_strm_mem.h>
 # include <ThirdParty/minizip/mz_zip.h>
@@ -27,6 +32,67 @@ namespace s3d
 			bool allowOverwrite = true;
 		};
 
+		// コールバックは open() の後も呼ばれるため、静的な記憶域に置く
+		static ZipOption DefaultZipOption;
+
+		// zlib の 1 回の呼び出しで扱うサイズの上限
+		static constexpr size_t ZlibChunkSize = (1u << 30);
+
+		// ファイルを展開するときのバッファサイズ
+		static constexpr size_t ExtractBufferSize = (256 * 1024);
+
+		static constexpr uint32 LocalFileHeaderSignature = 0x04034b50;
+
+		static constexpr size_t LocalFileHeaderSize = 30;
+
+		[[nodiscard]]
+		static uint16 ReadUint16(const Byte* p) noexcept
+		{
+			return static_cast<uint16>(static_cast<uint16>(p[0]) | (static_cast<uint16>(p[1]) << 8));
+		}
+
+		[[nodiscard]]
+		static uint32 ReadUint32(const Byte* p) noexcept
+		{
+			return (static_cast<uint32>(p[0]) | (static_cast<uint32>(p[1]) << 8)
+				| (static_cast<uint32>(p[2]) << 16) | (static_cast<uint32>(p[3]) << 24));
+		}
+
+		[[nodiscard]]
+		static uint32 CRC32(uint32 crc, const void* data, size_t size) noexcept
+		{
+			const ::Bytef* p = static_cast<const ::Bytef*>(data);
+
+			while (size)
+			{
+				const size_t chunkSize = Min(size, ZlibChunkSize);
+
+				crc = static_cast<uint32>(::crc32(crc, p, static_cast<::uInt>(chunkSize)));
+
+				p += chunkSize;
+
+				size -= chunkSize;
+			}
+
+			return crc;
+		}
+
+		// アーカイブ内のパスを、展開先のディレクトリからの相対パスに変換する（".." などを取り除く）
+		[[nodiscard]]
+		static std::string ResolvePath(const std::string& path)
+		{
+			std::string resolved(path.size() + 1, '\0');
+
+			if (::mz_path_resolve(path.c_str(), resolved.data(), static_cast<int32>(resolved.size())) != MZ_OK)
+			{
+				return{};
+			}
+
+			resolved.resize(std::strlen(resolved.c_str()));
+
+			return resolved;
+		}
+
 		static int32 ExtractEntryCallback(void*, void*, [[maybe_unused]] mz_zip_file* file_info, const char*)
 		{
 			LOG_TRACE(U"Extracting: `{}`"_fmt(Unicode::Widen(file_info->filename)));
@@ -68,6 +134,278 @@ namespace s3d
 
 			return MZ_OK;
 		}
+
+		ZIPEntryReader::ZIPEntryReader(const MemoryMappedFileView& view, const Byte* data, const ZIPEntry& entry)
+			: m_view{ view }
+			, m_data{ data }
+			, m_entry{ entry }
+		{
+			if (isDeflated())
+			{
+				resetStream();
+			}
+		}
+
+		ZIPEntryReader::~ZIPEntryReader()
+		{
+			if (m_stream)
+			{
+				::inflateEnd(m_stream.get());
+			}
+		}
+
+		bool ZIPEntryReader::supportsLookahead() const noexcept
+		{
+			return true;
+		}
+
+		bool ZIPEntryReader::isOpen() const noexcept
+		{
+			return (m_data != nullptr);
+		}
+
+		int64 ZIPEntryReader::size() const
+		{
+			return m_entry.uncompressedSize;
+		}
+
+		int64 ZIPEntryReader::getPos() const
+		{
+			return m_pos;
+		}
+
+		bool ZIPEntryReader::setPos(const int64 pos)
+		{
+			if ((pos < 0) || (m_entry.uncompressedSize < pos))
+			{
+				return false;
+			}
+
+			if (not isDeflated())
+			{
+				m_pos = pos;
+				return true;
+			}
+
+			// 後ろへ戻る場合は、先頭から展開し直す
+			if (pos < m_pos)
+			{
+				resetStream();
+				m_pos = 0;
+			}
+
+			{
+				const size_t fromBuffer = static_cast<size_t>(Min<int64>(buffered(), (pos - m_pos)));
+				m_bufferPos += fromBuffer;
+				m_pos += fromBuffer;
+			}
+
+			Byte scratch[16 * 1024];
+
+			while (m_pos < pos)
+			{
+				const int64 decoded = inflate(scratch, Min<int64>(sizeof(scratch), (pos - m_pos)));
+
+				if (decoded <= 0)
+				{
+					return false;
+				}
+
+				m_pos += decoded;
+			}
+
+			return true;
+		}
+
+		int64 ZIPEntryReader::skip(const int64 offset)
+		{
+			setPos(Clamp<int64>((m_pos + offset), 0, m_entry.uncompressedSize));
+
+			return m_pos;
+		}
+
+		int64 ZIPEntryReader::read(void* dst, int64 size)
+		{
+			if ((not dst) || (size <= 0))
+			{
+				return 0;
+			}
+
+			size = Min(size, (m_entry.uncompressedSize - m_pos));
+
+			if (not isDeflated())
+			{
+				std::memcpy(dst, (m_data + m_pos), static_cast<size_t>(size));
+				m_pos += size;
+				return size;
+			}
+
+			const size_t fromBuffer = static_cast<size_t>(Min<int64>(buffered(), size));
+
+			if (fromBuffer)
+			{
+				std::memcpy(dst, (m_buffer.data() + m_bufferPos), fromBuffer);
+				m_bufferPos += fromBuffer;
+			}
+
+			// 残りは読み込み先に直接展開する
+			const int64 decoded = inflate((static_cast<Byte*>(dst) + fromBuffer), (size - fromBuffer));
+			const int64 readSize = (fromBuffer + decoded);
+
+			m_pos += readSize;
+			return readSize;
+		}
+
+		int64 ZIPEntryReader::read(void* dst, const int64 pos, const int64 size)
+		{
+			if (not setPos(pos))
+			{
+				return 0;
+			}
+
+			return read(dst, size);
+		}
+
+		int64 ZIPEntryReader::lookahead(void* dst, int64 size) const
+		{
+			if ((not dst) || (size <= 0))
+			{
+				return 0;
+			}
+
+			size = Min(size, (m_entry.uncompressedSize - m_pos));
+
+			if (not isDeflated())
+			{
+				std::memcpy(dst, (m_data + m_pos), static_cast<size_t>(size));
+				return size;
+			}
+
+			fillBuffer(static_cast<size_t>(size));
+
+			const size_t readSize = Min(buffered(), static_cast<size_t>(size));
+
+			std::memcpy(dst, (m_buffer.data() + m_bufferPos), readSize);
+
+			return readSize;
+		}
+
+		int64 ZIPEntryReader::lookahead(void* dst, const int64 pos, const int64 size) const
+		{
+			if (pos == m_pos)
+			{
+				return lookahead(dst, size);
+			}
+
+			if ((not dst) || (size <= 0) || (pos < 0) || (m_entry.uncompressedSize < pos))
+			{
+				return 0;
+			}
+
+			if (not isDeflated())
+			{
+				const int64 readSize = Min(size, (m_entry.uncompressedSize - pos));
+				std::memcpy(dst, (m_data + pos), static_cast<size_t>(readSize));
+				return readSize;
+			}
+
+			// 現在の展開状態を変えないよう、別の Reader で展開する
+			ZIPEntryReader reader{ m_view, m_data, m_entry };
+
+			return reader.read(dst, pos, size);
+		}
+
+		bool ZIPEntryReader::hasError() const noexcept
+		{
+			return m_hasError;
+		}
+
+		bool ZIPEntryReader::isDeflated() const noexcept
+		{
+			return (m_entry.compressionMethod == MZ_COMPRESS_METHOD_DEFLATE);
+		}
+
+		size_t ZIPEntryReader::buffered() const noexcept
+		{
+			return (m_buffer.size() - m_bufferPos);
+		}
+
+		void ZIPEntryReader::resetStream() const
+		{
+			if (m_stream)
+			{
+				::inflateEnd(m_stream.get());
+			}
+			else
+			{
+				m_stream = std::make_unique<z_stream_s>();
+			}
+
+			*m_stream = {};
+			m_inputPos = 0;
+			m_buffer.clear();
+			m_bufferPos = 0;
+			m_hasError = (::inflateInit2(m_stream.get(), -MAX_WBITS) != Z_OK);
+		}
+
+		int64 ZIPEntryReader::inflate(void* dst, const int64 size) const
+		{
+			int64 total = 0;
+
+			while ((total < size) && (not m_hasError))
+			{
+				if ((m_stream->avail_in == 0) && (m_inputPos < m_entry.compressedSize))
+				{
+					const size_t inputSize = static_cast<size_t>(Min<int64>((m_entry.compressedSize - m_inputPos), ZlibChunkSize));
+					m_stream->next_in = const_cast<::Bytef*>(reinterpret_cast<const ::Bytef*>(m_data + m_inputPos));
+					m_stream->avail_in = static_cast<::uInt>(inputSize);
+					m_inputPos += inputSize;
+				}
+
+				const size_t outputSize = static_cast<size_t>(Min<int64>((size - total), ZlibChunkSize));
+				m_stream->next_out = (static_cast<::Bytef*>(dst) + total);
+				m_stream->avail_out = static_cast<::uInt>(outputSize);
+
+				const int32 result = ::inflate(m_stream.get(), Z_NO_FLUSH);
+				const size_t decoded = (outputSize - m_stream->avail_out);
+				total += decoded;
+
+				if (result == Z_STREAM_END)
+				{
+					break;
+				}
+
+				if (((result != Z_OK) && (result != Z_BUF_ERROR))
+					|| ((result == Z_BUF_ERROR) && (decoded == 0)))
+				{
+					LOG_FAIL(U"ZIPReader: Failed to inflate an entry");
+					m_hasError = true;
+				}
+			}
+
+			return total;
+		}
+
+		void ZIPEntryReader::fillBuffer(const size_t size) const
+		{
+			if (size <= buffered())
+			{
+				return;
+			}
+
+			// 読み込み済みの部分を詰める
+			if (m_bufferPos)
+			{
+				m_buffer.erase(m_buffer.begin(), (m_buffer.begin() + m_bufferPos));
+				m_bufferPos = 0;
+			}
+
+			const size_t oldSize = m_buffer.size();
+			m_buffer.resize(size);
+
+			const int64 decoded = inflate((m_buffer.data() + oldSize), (size - oldSize));
+			m_buffer.resize(oldSize + static_cast<size_t>(decoded));
+		}
 	}
 
 	ZIPReader::ZIPReaderDetail::ZIPReaderDetail()
@@ -89,10 +427,9 @@ namespace s3d
 
 		::mz_zip_reader_create(&m_reader);
 
-		detail::ZipOption option;
-		::mz_zip_reader_set_entry_cb(m_reader, &option, detail::ExtractEntryCallback);
-		::mz_zip_reader_set_progress_cb(m_reader, &option, detail::ExtractProgressCallback);
-		::mz_zip_reader_set_overwrite_cb(m_reader, &option, detail::ExtractOverwriteCallback);
+		::mz_zip_reader_set_entry_cb(m_reader, &detail::DefaultZipOption, detail::ExtractEntryCallback);
+		::mz_zip_reader_set_progress_cb(m_reader, &detail::DefaultZipOption, detail::ExtractProgressCallback);
+		::mz_zip_reader_set_overwrite_cb(m_reader, &detail::DefaultZipOption, detail::ExtractOverwriteCallback);
 
 		{
 			int32 err = MZ_OK;
@@ -106,6 +443,9 @@ namespace s3d
 				err = ::mz_zip_reader_open_buffer(m_reader,
 					const_cast<uint8*>(static_cast<const std::uint8_t*>(m_resource.data())),
 					static_cast<int32>(m_resource.size()), 0);
+
+				m_archiveData = static_cast<const Byte*>(m_resource.data());
+				m_archiveSize = static_cast<size_t>(m_resource.size());
 			}
 			else
 			{
@@ -144,7 +484,26 @@ namespace s3d
 					break;
 				}
 
-				m_paths << Unicode::Widen(fileInfo->filename);
+				detail::ZIPEntry entry;
+				entry.localHeaderOffset	= fileInfo->disk_offset;
+				entry.compressedSize	= fileInfo->compressed_size;
+				entry.uncompressedSize	= fileInfo->uncompressed_size;
+				entry.modifiedDate		= fileInfo->modified_date;
+				entry.accessedDate		= fileInfo->accessed_date;
+				entry.creationDate		= fileInfo->creation_date;
+				entry.crc				= fileInfo->crc;
+				entry.compressionMethod	= fileInfo->compression_method;
+				entry.isDirectory		= (::mz_zip_reader_entry_is_dir(m_reader) == MZ_OK);
+				entry.needsMinizip		= ((fileInfo->flag & MZ_ZIP_FLAG_ENCRYPTED)
+					|| ((fileInfo->compression_method != MZ_COMPRESS_METHOD_STORE) && (fileInfo->compression_method != MZ_COMPRESS_METHOD_DEFLATE))
+					|| (::mz_zip_attrib_is_symlink(fileInfo->external_fa, fileInfo->version_madeby) == MZ_OK));
+
+				FilePath entryPath = Unicode::Widen(fileInfo->filename);
+
+				// 同じパスが複数ある場合は、minizip と同じく最初のものを使う
+				m_pathIndex.emplace(entryPath, m_paths.size());
+				m_paths << std::move(entryPath);
+				m_entries << entry;
 
 				err = ::mz_zip_reader_goto_next_entry(m_reader);
 
@@ -161,6 +520,14 @@ namespace s3d
 			}
 		}
 
+		// アーカイブをメモリマップし、minizip を介さずにファイルを読み込めるようにする
+		// Windows のリソースに埋め込まれたアーカイブはリソースのメモリを直接読むため、m_view は空のままになる
+		if ((not m_archiveData) && m_view.open(path))
+		{
+			m_archiveData = m_view.data();
+			m_archiveSize = m_view.mappedSize();
+		}
+
 		m_archiveFileFullPath = FileSystem::FullPath(path);
 
 		return true;
@@ -175,8 +542,19 @@ namespace s3d
 
 		m_paths.clear();
 
+		m_entries.clear();
+
+		m_pathIndex.clear();
+
 		m_archiveFileFullPath.clear();
 
+		m_archiveData = nullptr;
+
+		m_archiveSize = 0;
+
+		// 作成済みの IReader はマッピングを共有しているため、それらが破棄されるまでマッピングは維持される
+		m_view = MemoryMappedFileView{};
+
 		::mz_zip_reader_delete(&m_reader); // 内部で m_reader = nullptr;
 	}
 
@@ -190,6 +568,11 @@ namespace s3d
 		return m_paths;
 	}
 
+	bool ZIPReader::ZIPReaderDetail::contains(const FilePathView filePath) const
+	{
+		return (findEntry(filePath) != nullptr);
+	}
+
 	bool ZIPReader::ZIPReaderDetail::extractAll(const FilePathView targetDirectory) const
 	{
 		return extract(StringView(), targetDirectory);
@@ -208,39 +591,87 @@ namespace s3d
 			return false;
 		}
 
-		int32 err = MZ_OK;
+		const std::string patternC = Unicode::Narrow(pattern);
+		const FilePath directory = (targetDirectory.ends_with(U'/') ? FilePath{ targetDirectory } : (targetDirectory + U'/'));
 
-		if (pattern)
-		{
-			const std::string patternC = Unicode::Narrow(pattern);
-			::mz_zip_reader_set_pattern(m_reader, patternC.c_str(), 1);
-		}
-		else
+		// 展開するファイルを選び、ディレクトリを先に作成する
+		Array<std::pair<size_t, FilePath>> files;
+		HashTable<FilePath, size_t> fileIndices;
+		HashSet<FilePath> createdDirectories;
+		bool found = false;
+
+		for (size_t i = 0; i < m_paths.size(); ++i)
 		{
-			::mz_zip_reader_set_pattern(m_reader, "*", 1);
-		}
+			const std::string pathC = Unicode::Narrow(m_paths[i]);
 
-		const std::string targetDirectoryC = Unicode::Narrow(targetDirectory);
-		err = ::mz_zip_reader_save_all(m_reader, targetDirectoryC.c_str());
+			if (pattern && (::mz_path_compare_wc(pathC.c_str(), patternC.c_str(), 1) != MZ_OK))
+			{
+				continue;
+			}
 
-		if (err == MZ_END_OF_LIST)
+			found = true;
+
+			const std::string resolvedPathC = detail::ResolvePath(pathC);
+			const FilePath path = (directory + Unicode::Widen(resolvedPathC));
+
+			if (m_entries[i].isDirectory)
+			{
+				if (createdDirectories.insert(path).second)
+				{
+					FileSystem::CreateDirectories(path);
+				}
+
+				continue;
+			}
+
+			if (const FilePath parentPath = FileSystem::ParentPath(path);
+				parentPath && createdDirectories.insert(parentPath).second)
+			{
+				FileSystem::CreateDirectories(parentPath);
+			}
+
+			// 展開先が同じエントリが複数ある場合は、逐次に展開した場合と同じく最後のものを残す
+			// 並列に展開すると同じファイルへの書き込みが競合するため、ここで 1 つにまとめる
+			if (const auto it = fileIndices.find(path);
+				it != fileIndices.end())
+			{
+				files[it->second].first = i;
+				continue;
+			}
+
+			fileIndices.emplace(path, files.size());
+			files.emplace_back(i, path);
+		}
+
+		if (not found)
 		{
 			if (pattern)
 			{
 				LOG_FAIL(U"ZIPReader::extract(): Files matching `{}` not found in archive"_fmt(pattern));
+				return false;
 			}
-			else
+
+			LOG_TRACE(U"ZIPReader::extract(): No files in archive");
+			return true;
+		}
+
+		// 各ファイルは独立して展開できるため、ワーカースレッドで並列に展開する
+		std::atomic<bool> succeeded = true;
+
+		ParallelFor(0, files.size(), [&](const size_t i)
+		{
+			if (not saveEntry(files[i].first, files[i].second))
 			{
-				LOG_TRACE(U"ZIPReader::extract(): No files in archive");
-				err = MZ_OK;
+				succeeded = false;
 			}
-		}
-		else if (err != MZ_OK)
+		}, 1);
+
+		if (not succeeded)
 		{
 			LOG_FAIL(U"ZIPReader::extract(): Failed to save entries");
 		}
 
-		return (err == MZ_OK);
+		return succeeded;
 	}
 
 	Blob ZIPReader::ZIPReaderDetail::extractToBlob(const FilePathView filePath) const
@@ -250,6 +681,186 @@ namespace s3d
 			return{};
 		}
 
+		if (const detail::ZIPEntry* entry = findEntry(filePath))
+		{
+			if (const auto reader = createEntryReader(*entry))
+			{
+				const int64 size = entry->uncompressedSize;
+				Blob blob(static_cast<size_t>(size));
+
+				if ((reader->read(blob.data(), size) != size) || reader->hasError()
+					|| (detail::CRC32(0, blob.data(), blob.size()) != entry->crc))
+				{
+					LOG_FAIL(U"ZIPReader::extractToBlob(): Failed to extract `{}`"_fmt(filePath));
+					return{};
+				}
+
+				return blob;
+			}
+		}
+
+		// 索引にないパス（パターン）や、minizip でしか展開できないファイル
+		return extractToBlobWithMinizip(filePath);
+	}
+
+	std::unique_ptr<IReader> ZIPReader::ZIPReaderDetail::openReader(const FilePathView filePath) const
+	{
+		if (not isOpen())
+		{
+			return nullptr;
+		}
+
+		const detail::ZIPEntry* entry = findEntry(filePath);
+
+		if ((not entry) || entry->isDirectory)
+		{
+			return nullptr;
+		}
+
+		if (auto reader = createEntryReader(*entry))
+		{
+			return reader;
+		}
+
+		return std::make_unique<MemoryReader>(extractToBlobWithMinizip(filePath));
+	}
+
+	const detail::ZIPEntry* ZIPReader::ZIPReaderDetail::findEntry(const FilePathView filePath) const
+	{
+		if (const auto it = m_pathIndex.find(FilePath{ filePath });
+			it != m_pathIndex.end())
+		{
+			return &m_entries[it->second];
+		}
+
+		return nullptr;
+	}
+
+	const Byte* ZIPReader::ZIPReaderDetail::getEntryData(const detail::ZIPEntry& entry) const
+	{
+		if ((not m_archiveData) || entry.needsMinizip || (entry.localHeaderOffset < 0) || (entry.compressedSize < 0))
+		{
+			return nullptr;
+		}
+
+		const size_t headerOffset = static_cast<size_t>(entry.localHeaderOffset);
+
+		if (m_archiveSize < (headerOffset + detail::LocalFileHeaderSize))
+		{
+			return nullptr;
+		}
+
+		const Byte* header = (m_archiveData + headerOffset);
+
+		if (detail::ReadUint32(header) != detail::LocalFileHeaderSignature)
+		{
+			return nullptr;
+		}
+
+		const size_t dataOffset = (headerOffset + detail::LocalFileHeaderSize
+			+ detail::ReadUint16(header + 26) + detail::ReadUint16(header + 28));
+
+		if (m_archiveSize < (dataOffset + static_cast<size_t>(entry.compressedSize)))
+		{
+			return nullptr;
+		}
+
+		if ((entry.compressionMethod == MZ_COMPRESS_METHOD_STORE) && (entry.compressedSize != entry.uncompressedSize))
+		{
+			return nullptr;
+		}
+
+		return (m_archiveData + dataOffset);
+	}
+
+	std::unique_ptr<detail::ZIPEntryReader> ZIPReader::ZIPReaderDetail::createEntryReader(const detail::ZIPEntry& entry) const
+	{
+		if (const Byte* data = getEntryData(entry))
+		{
+			return std::make_unique<detail::ZIPEntryReader>(m_view, data, entry);
+		}
+
+		return nullptr;
+	}
+
+	bool ZIPReader::ZIPReaderDetail::saveEntry(const size_t index, const FilePath& path) const
+	{
+		const detail::ZIPEntry& entry = m_entries[index];
+		const Byte* data = getEntryData(entry);
+
+		if (not data)
+		{
+			return saveEntryWithMinizip(index, path);
+		}
+
+		LOG_TRACE(U"Extracting: `{}`"_fmt(m_paths[index]));
+
+		uint32 crc = 0;
+		{
+			BinaryWriter writer{ path };
+
+			if (not writer)
+			{
+				LOG_FAIL(U"ZIPReader::extract(): Failed to create `{}`"_fmt(path));
+				return false;
+			}
+
+			if (entry.compressionMethod == MZ_COMPRESS_METHOD_STORE)
+			{
+				// 無圧縮のファイルは、メモリマップしたアーカイブから直接書き出す
+				crc = detail::CRC32(crc, data, static_cast<size_t>(entry.uncompressedSize));
+				writer.write(data, entry.uncompressedSize);
+			}
+			else
+			{
+				detail::ZIPEntryReader reader{ m_view, data, entry };
+				Array<Byte> buffer(static_cast<size_t>(Min<int64>(entry.uncompressedSize, detail::ExtractBufferSize)));
+
+				for (int64 remaining = entry.uncompressedSize; 0 < remaining;)
+				{
+					const int64 readSize = reader.read(buffer.data(), Min<int64>(remaining, buffer.size()));
+
+					if (readSize <= 0)
+					{
+						break;
+					}
+
+					crc = detail::CRC32(crc, buffer.data(), static_cast<size_t>(readSize));
+					writer.write(buffer.data(), readSize);
+					remaining -= readSize;
+				}
+			}
+		}
+
+		if (crc != entry.crc)
+		{
+			LOG_FAIL(U"ZIPReader::extract(): CRC mismatch in `{}`"_fmt(m_paths[index]));
+			return false;
+		}
+
+		::mz_os_set_file_date(Unicode::ToUTF8(path).c_str(), entry.modifiedDate, entry.accessedDate, entry.creationDate);
+
+		return true;
+	}
+
+	bool ZIPReader::ZIPReaderDetail::saveEntryWithMinizip(const size_t index, const FilePath& path) const
+	{
+		std::lock_guard lock{ m_readerMutex };
+
+		const std::string pathC = Unicode::Narrow(m_paths[index]);
+
+		if (::mz_zip_reader_locate_entry(m_reader, pathC.c_str(), 0) != MZ_OK)
+		{
+			return false;
+		}
+
+		return (::mz_zip_reader_entry_save_file(m_reader, Unicode::ToUTF8(path).c_str()) == MZ_OK);
+	}
+
+	Blob ZIPReader::ZIPReaderDetail::extractToBlobWithMinizip(const FilePathView filePath) const
+	{
+		std::lock_guard lock{ m_readerMutex };
+
 		const std::string patternC = Unicode::Narrow(filePath);
 		Array<Byte> data;
 		int32 err = MZ_OK;
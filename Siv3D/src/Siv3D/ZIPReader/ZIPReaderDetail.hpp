@@ -10,8 +10,13 @@
 //-----------------------------------------------
 
 # pragma once
+# include <mutex>
 # include <Siv3D/ZIPReader.hpp>
 # include <Siv3D/Unicode.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+
+struct z_stream_s;
 
 # if SIV3D_PLATFORM(WINDOWS)
 
@@ -71,6 +76,110 @@ namespace s3d
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief アーカイブ内のファイルの情報
+		struct ZIPEntry
+		{
+			int64 localHeaderOffset = 0;
+
+			int64 compressedSize = 0;
+
+			int64 uncompressedSize = 0;
+
+			time_t modifiedDate = 0;
+
+			time_t accessedDate = 0;
+
+			time_t creationDate = 0;
+
+			uint32 crc = 0;
+
+			uint16 compressionMethod = 0;
+
+			bool isDirectory = false;
+
+			// 暗号化や Deflate 以外の圧縮方式など、minizip を介して展開する必要がある
+			bool needsMinizip = false;
+		};
+
+		/// @brief アーカイブ内の 1 つのファイルを、メモリマップしたアーカイブから読み込む IReader
+		/// @remark 無圧縮のファイルはコピーせずに読み込み、Deflate で圧縮されたファイルは読み込みに合わせて展開します。
+		class ZIPEntryReader final : public IReader
+		{
+		public:
+
+			ZIPEntryReader(const MemoryMappedFileView& view, const Byte* data, const ZIPEntry& entry);
+
+			~ZIPEntryReader() override;
+
+			[[nodiscard]]
+			bool supportsLookahead() const noexcept override;
+
+			[[nodiscard]]
+			bool isOpen() const noexcept override;
+
+			[[nodiscard]]
+			int64 size() const override;
+
+			[[nodiscard]]
+			int64 getPos() const override;
+
+			bool setPos(int64 pos) override;
+
+			int64 skip(int64 offset) override;
+
+			int64 read(void* dst, int64 size) override;
+
+			int64 read(void* dst, int64 pos, int64 size) override;
+
+			int64 lookahead(void* dst, int64 size) const override;
+
+			int64 lookahead(void* dst, int64 pos, int64 size) const override;
+
+			/// @brief 展開中にエラーが発生したかを返します。
+			[[nodiscard]]
+			bool hasError() const noexcept;
+
+		private:
+
+			// 読み込み中にマッピングが解放されないよう保持する
+			// Windows のリソースに埋め込まれたアーカイブの場合は空。リソースのメモリはモジュールが解放されるまで有効なため、ZIPReader より長く使える
+			MemoryMappedFileView m_view;
+
+			const Byte* m_data = nullptr;
+
+			ZIPEntry m_entry;
+
+			int64 m_pos = 0;
+
+			// 以下は Deflate で圧縮されたファイルの展開状態
+
+			mutable std::unique_ptr<z_stream_s> m_stream;
+
+			mutable int64 m_inputPos = 0;
+
+			// lookahead() で展開し、まだ読み込んでいないデータ
+			mutable Array<Byte> m_buffer;
+
+			mutable size_t m_bufferPos = 0;
+
+			mutable bool m_hasError = false;
+
+			[[nodiscard]]
+			bool isDeflated() const noexcept;
+
+			[[nodiscard]]
+			size_t buffered() const noexcept;
+
+			void resetStream() const;
+
+			int64 inflate(void* dst, int64 size) const;
+
+			void fillBuffer(size_t size) const;
+		};
+	}
+
 	class ZIPReader::ZIPReaderDetail
 	{
 	public:
@@ -90,6 +199,9 @@ namespace s3d
 		[[nodiscard]]
 		const Array<FilePath>& enumPaths() const;
 
+		[[nodiscard]]
+		bool contains(FilePathView filePath) const;
+
 		bool extractAll(FilePathView targetDirectory) const;
 
 		bool extract(StringView pattern, FilePathView targetDirectory) const;
@@ -97,18 +209,56 @@ namespace s3d
 		[[nodiscard]]
 		Blob extractToBlob(FilePathView filePath) const;
 
+		[[nodiscard]]
+		std::unique_ptr<IReader> openReader(FilePathView filePath) const;
+
 	private:
 
 		void* m_reader = nullptr;
 
+		// minizip の m_reader はスレッドセーフではないため、使うときはロックする
+		mutable std::mutex m_readerMutex;
+
 		FilePath m_archiveFileFullPath;
 
 		Array<FilePath> m_paths;
 
+		// m_paths と同じ順序
+		Array<detail::ZIPEntry> m_entries;
+
+		// パス → m_entries のインデックス
+		HashTable<FilePath, size_t> m_pathIndex;
+
+		// アーカイブファイルのマッピング。Windows のリソースに埋め込まれたアーカイブの場合は空
+		MemoryMappedFileView m_view;
+
+		// アーカイブ全体のデータ（マッピングまたはリソースのメモリ）。どちらも得られなかった場合は nullptr
+		const Byte* m_archiveData = nullptr;
+
+		size_t m_archiveSize = 0;
+
 	# if SIV3D_PLATFORM(WINDOWS)
 
 		ZIPResourceHolder m_resource;
 
 	# endif
+
+		[[nodiscard]]
+		const detail::ZIPEntry* findEntry(FilePathView filePath) const;
+
+		/// @brief ファイルのデータの先頭を返します。
+		/// @return データの先頭。minizip を介して展開する必要がある場合や、ローカルヘッダが壊れている場合は nullptr
+		[[nodiscard]]
+		const Byte* getEntryData(const detail::ZIPEntry& entry) const;
+
+		[[nodiscard]]
+		std::unique_ptr<detail::ZIPEntryReader> createEntryReader(const detail::ZIPEntry& entry) const;
+
+		bool saveEntry(size_t index, const FilePath& path) const;
+
+		bool saveEntryWithMinizip(size_t index, const FilePath& path) const;
+
+		[[nodiscard]]
+		Blob extractToBlobWithMinizip(FilePathView filePath) const;
 	};
 }
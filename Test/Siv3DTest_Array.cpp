@@ -82,6 +82,24 @@ TEST_CASE("Array::parallel_map()")
 	}
 }
 
+TEST_CASE("Array::parallel_each()")
+{
+	{
+		Array<uint32> v(64 * 1024);
+		for (size_t i = 0; i < v.size(); ++i)
+		{
+			v[i] = RandomUint32();
+		}
+
+		Array<uint32> expected = v;
+		expected.each([](uint32& n) { n = (n / 3 + 1); });
+
+		v.parallel_each([](uint32& n) { n = (n / 3 + 1); }, 100);
+
+		REQUIRE(v == expected);
+	}
+}
+
 # if defined(SIV3D_RUN_BENCHMARK)
 
 TEST_CASE("Array::parallel_count_if() : benchmark")
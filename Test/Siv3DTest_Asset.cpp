@@ -0,0 +1,398 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// ファイルを読まない TextureAssetData の onLoad を差し替えて、アセットローダーの動作を確かめる
+
+namespace
+{
+	// 開かれるまでロード処理を止めておく
+	class Gate
+	{
+	public:
+
+		void open()
+		{
+			{
+				std::lock_guard lock{ m_mutex };
+
+				m_opened = true;
+			}
+
+			m_condition.notify_all();
+		}
+
+		void wait()
+		{
+			std::unique_lock lock{ m_mutex };
+
+			m_condition.wait(lock, [this]() { return m_opened; });
+		}
+
+	private:
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+
+		bool m_opened = false;
+	};
+
+	// ロード処理が呼ばれた順番を記録する
+	class LoadLog
+	{
+	public:
+
+		void add(const String& name)
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_names << name;
+		}
+
+		[[nodiscard]]
+		Array<String> get() const
+		{
+			std::lock_guard lock{ m_mutex };
+
+			return m_names;
+		}
+
+	private:
+
+		mutable std::mutex m_mutex;
+
+		Array<String> m_names;
+	};
+
+	[[nodiscard]]
+	TextureAssetData* RegisterAsset(const String& name, const Array<AssetTag>& tags, std::function<bool()> load)
+	{
+		auto data = std::make_unique<TextureAssetData>(U"", TextureDesc::Unmipped, tags);
+		data->onLoad = [load = std::move(load)](TextureAssetData&, const String&) { return load(); };
+		data->onRelease = [](TextureAssetData&) {};
+
+		TextureAssetData* p = data.get();
+
+		if (not TextureAsset::Register(name, std::move(data)))
+		{
+			return nullptr;
+		}
+
+		return p;
+	}
+
+	// アセットローダーのロード処理のスレッド数
+	[[nodiscard]]
+	size_t GetLoadThreadCount()
+	{
+		return (Max<size_t>(Threading::GetConcurrency(), 2) - 1);
+	}
+
+	template <class Predicate>
+	[[nodiscard]]
+	bool WaitUntil(Predicate predicate)
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (not predicate())
+		{
+			if (5.0 < stopwatch.sF())
+			{
+				return false;
+			}
+
+			System::Sleep(1);
+		}
+
+		return true;
+	}
+
+	// すべてのロード処理のスレッドを止めるアセット
+	class Blockers
+	{
+	public:
+
+		explicit Blockers(const size_t count)
+			: m_gates(count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				m_gates[i] = std::make_unique<Gate>();
+
+				Gate* gate = m_gates[i].get();
+
+				(void)RegisterAsset(U"blocker{}"_fmt(i), { U"blocker" }, [this, gate]()
+					{
+						++m_started;
+						gate->wait();
+						return true;
+					});
+			}
+
+			Asset::LoadAsync(U"blocker");
+		}
+
+		~Blockers()
+		{
+			openAll();
+		}
+
+		[[nodiscard]]
+		bool waitForStart() const
+		{
+			return WaitUntil([this]() { return (m_started == m_gates.size()); });
+		}
+
+		void open(const size_t index)
+		{
+			m_gates[index]->open();
+		}
+
+		void openAll()
+		{
+			for (auto& gate : m_gates)
+			{
+				gate->open();
+			}
+		}
+
+	private:
+
+		Array<std::unique_ptr<Gate>> m_gates;
+
+		std::atomic<size_t> m_started{ 0 };
+	};
+
+	[[nodiscard]]
+	bool WaitForAllLoads()
+	{
+		return WaitUntil([]() { return Asset::LoadProgress().isFinished(); });
+	}
+}
+
+TEST_CASE("Asset async load")
+{
+	REQUIRE(WaitForAllLoads());
+
+	LoadLog log;
+
+	// 途中で失敗しても、登録したアセットを残さない
+	const ScopeGuard unregister{ []() { TextureAsset::UnregisterAll(); } };
+
+	SECTION("priority")
+	{
+		Blockers blockers{ GetLoadThreadCount() };
+		REQUIRE(blockers.waitForStart());
+
+		const std::pair<AssetTag, AssetLoadPriority> requests[] = {
+			{ U"low", AssetLoadPriority::Low },
+			{ U"normal", AssetLoadPriority::Normal },
+			{ U"high", AssetLoadPriority::High },
+		};
+
+		for (const auto& [tag, priority] : requests)
+		{
+			for (int32 i = 0; i < 3; ++i)
+			{
+				const String name = U"{}{}"_fmt(tag, i);
+				REQUIRE(RegisterAsset(name, { tag }, [&log, name]() { log.add(name); return true; }));
+			}
+
+			Asset::LoadAsync(tag, priority);
+		}
+
+		// 待機中のロードの優先度を上げる
+		TextureAsset::LoadAsync(U"low2", AssetLoadPriority::High);
+
+		// 1 つのスレッドだけを空けて、待機中のロードが 1 つずつ処理されるようにする
+		blockers.open(0);
+		REQUIRE(WaitUntil([&log]() { return (log.get().size() == 9); }));
+
+		// 同じタグのアセットどうしの順番は決まっていない
+		const Array<String> names = log.get();
+		CHECK(names.slice(0, 3).all([](const String& name) { return name.starts_with(U"high"); }));
+		CHECK(names[3] == U"low2");
+		CHECK(names.slice(4, 3).all([](const String& name) { return name.starts_with(U"normal"); }));
+		CHECK(names.slice(7, 2).all([](const String& name) { return name.starts_with(U"low"); }));
+
+		blockers.openAll();
+		REQUIRE(WaitForAllLoads());
+	}
+
+	SECTION("CancelLoadAsync")
+	{
+		Blockers blockers{ GetLoadThreadCount() };
+		REQUIRE(blockers.waitForStart());
+
+		Array<TextureAssetData*> assets;
+
+		for (int32 i = 0; i < 3; ++i)
+		{
+			const String name = U"cancel{}"_fmt(i);
+			assets << RegisterAsset(name, { U"cancel" }, [&log, name]() { log.add(name); return true; });
+			REQUIRE(assets.back());
+		}
+
+		REQUIRE(RegisterAsset(U"keep", { U"keep" }, [&log]() { log.add(U"keep"); return true; }));
+
+		Asset::LoadAsync(U"cancel");
+		Asset::LoadAsync(U"keep");
+
+		for (const auto& asset : assets)
+		{
+			CHECK(asset->getState() == AssetState::AsyncLoading);
+		}
+
+		CHECK(Asset::CancelLoadAsync(U"cancel") == 3);
+		CHECK(Asset::CancelLoadAsync(U"cancel") == 0);
+
+		// キャンセルされたアセットは、ロードを開始していない状態に戻る
+		for (const auto& asset : assets)
+		{
+			CHECK(asset->getState() == AssetState::Uninitialized);
+		}
+
+		blockers.openAll();
+		REQUIRE(WaitForAllLoads());
+
+		CHECK(log.get() == Array<String>{ U"keep" });
+		CHECK(TextureAsset::IsReady(U"keep"));
+		CHECK_FALSE(TextureAsset::IsReady(U"cancel0"));
+
+		const AssetLoadProgress progress = Asset::LoadProgress();
+		CHECK(progress.canceled == 3);
+		CHECK(progress.failed == 0);
+		CHECK(progress.finished == progress.total);
+
+		// キャンセルした後でも、再びロードできる
+		TextureAsset::Wait(U"cancel0");
+		CHECK(TextureAsset::Load(U"cancel0"));
+		CHECK(log.get().back() == U"cancel0");
+	}
+
+	SECTION("dependencies")
+	{
+		for (int32 i = 0; i < 4; ++i)
+		{
+			const String name = U"dependency{}"_fmt(i);
+			REQUIRE(RegisterAsset(name, { U"dependency" }, [&log, name]()
+				{
+					System::Sleep(20);
+					log.add(name);
+					return true;
+				}));
+		}
+
+		for (int32 i = 0; i < 4; ++i)
+		{
+			const String name = U"main{}"_fmt(i);
+			REQUIRE(RegisterAsset(name, { U"main" }, [&log, name]() { log.add(name); return true; }));
+		}
+
+		// 依存先のアセットは、まだロードを要求していなくてもロードされる
+		Asset::LoadAsync(U"main", { U"dependency" });
+		REQUIRE(WaitForAllLoads());
+
+		const Array<String> names = log.get();
+		REQUIRE(names.size() == 8);
+
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			CHECK(names[i].starts_with((i < 4) ? U"dependency" : U"main"));
+		}
+	}
+
+	SECTION("LoadProgress")
+	{
+		Blockers blockers{ GetLoadThreadCount() };
+		REQUIRE(blockers.waitForStart());
+
+		REQUIRE(RegisterAsset(U"succeeded", { U"progress" }, []() { return true; }));
+		REQUIRE(RegisterAsset(U"failed", { U"progress" }, []() { return false; }));
+		REQUIRE(RegisterAsset(U"canceled", { U"canceled" }, []() { return true; }));
+
+		Asset::LoadAsync(U"progress");
+		Asset::LoadAsync(U"canceled");
+
+		{
+			const AssetLoadProgress progress = Asset::LoadProgress();
+			CHECK(progress.total == (GetLoadThreadCount() + 3));
+			CHECK(progress.finished == 0);
+			CHECK_FALSE(progress.isFinished());
+		}
+
+		CHECK(Asset::CancelLoadAsync(U"canceled") == 1);
+
+		blockers.openAll();
+		REQUIRE(WaitForAllLoads());
+
+		{
+			const AssetLoadProgress progress = Asset::LoadProgress();
+			CHECK(progress.total == (GetLoadThreadCount() + 3));
+			CHECK(progress.finished == progress.total);
+			CHECK(progress.failed == 1);
+			CHECK(progress.canceled == 1);
+			CHECK(progress.ratio() == 1.0);
+		}
+
+		// すべて終わった後に要求されたロードから、集計をやり直す
+		REQUIRE(RegisterAsset(U"next", { U"next" }, []() { return true; }));
+		Asset::LoadAsync(U"next");
+		REQUIRE(WaitForAllLoads());
+
+		{
+			const AssetLoadProgress progress = Asset::LoadProgress();
+			CHECK(progress.total == 1);
+			CHECK(progress.finished == 1);
+			CHECK(progress.failed == 0);
+			CHECK(progress.canceled == 0);
+		}
+	}
+
+	SECTION("wait from multiple threads")
+	{
+		Gate gate;
+		std::atomic<bool> started{ false };
+		REQUIRE(RegisterAsset(U"shared", { U"shared" }, [&gate, &started]() { started = true; gate.wait(); return true; }));
+
+		TextureAsset::LoadAsync(U"shared");
+		REQUIRE(WaitUntil([&started]() { return started.load(); }));
+
+		// 先に始まったロードを、メインスレッド以外の複数のスレッドが待つ
+		std::atomic<size_t> returned{ 0 };
+		Array<std::thread> threads;
+
+		for (int32 i = 0; i < 3; ++i)
+		{
+			threads.emplace_back([&returned]()
+				{
+					TextureAsset::Wait(U"shared");
+					++returned;
+				});
+		}
+
+		System::Sleep(100);
+		CHECK(returned == 0);
+		CHECK_FALSE(TextureAsset::IsReady(U"shared"));
+
+		gate.open();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		CHECK(returned == 3);
+		CHECK(TextureAsset::IsReady(U"shared"));
+	}
+}
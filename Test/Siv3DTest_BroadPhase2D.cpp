@@ -0,0 +1,95 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	template <class ShapeA, class ShapeB>
+	Array<BroadPhase2D::IndexPair> BruteForce(const Array<ShapeA>& a, const Array<ShapeB>& b)
+	{
+		Array<BroadPhase2D::IndexPair> results;
+
+		for (uint32 i = 0; i < a.size(); ++i)
+		{
+			for (uint32 k = 0; k < b.size(); ++k)
+			{
+				if (Geometry2D::Intersect(a[i], b[k]))
+				{
+					results.push_back({ i, k });
+				}
+			}
+		}
+
+		return results;
+	}
+
+	template <class Shape>
+	Array<BroadPhase2D::IndexPair> BruteForce(const Array<Shape>& shapes)
+	{
+		Array<BroadPhase2D::IndexPair> results;
+
+		for (uint32 i = 0; i < shapes.size(); ++i)
+		{
+			for (uint32 k = (i + 1); k < shapes.size(); ++k)
+			{
+				if (Geometry2D::Intersect(shapes[i], shapes[k]))
+				{
+					results.push_back({ i, k });
+				}
+			}
+		}
+
+		return results;
+	}
+}
+
+TEST_CASE("BroadPhase2D::FindIntersections()")
+{
+	SmallRNG rng{ 12345 };
+
+	const Array<Circle> circles = Array<Circle>::Generate(2000, [&]() { return Circle{ RandomVec2(RectF{ 1000 }, rng), Random(0.0, 20.0, rng) }; });
+	const Array<RectF> rects = Array<RectF>::Generate(1000, [&]() { return RectF{ RandomVec2(RectF{ 1000 }, rng), Random(0.0, 40.0, rng), Random(0.0, 40.0, rng) }; });
+	const Array<Line> lines = Array<Line>::Generate(500, [&]() { return Line{ RandomVec2(RectF{ 1000 }, rng), RandomVec2(RectF{ 1000 }, rng) }; });
+
+	REQUIRE(BroadPhase2D::FindIntersections(circles, rects) == BruteForce(circles, rects));
+	REQUIRE(BroadPhase2D::FindIntersections(rects, circles) == BruteForce(rects, circles));
+	REQUIRE(BroadPhase2D::FindIntersections(lines, circles) == BruteForce(lines, circles));
+	REQUIRE(BroadPhase2D::FindIntersections(rects, lines) == BruteForce(rects, lines));
+	REQUIRE(BroadPhase2D::FindIntersections(circles) == BruteForce(circles));
+	REQUIRE(BroadPhase2D::FindIntersections(lines) == BruteForce(lines));
+
+	REQUIRE(BroadPhase2D::ParallelFindIntersections(circles, rects) == BruteForce(circles, rects));
+	REQUIRE(BroadPhase2D::ParallelFindIntersections(circles) == BruteForce(circles));
+
+	REQUIRE(BroadPhase2D::FindIntersections(Array<Circle>{}, rects).isEmpty());
+	REQUIRE(BroadPhase2D::FindIntersections(Array<Circle>{ Circle{ 0, 0, 1 }, Circle{ 2, 0, 1 } }) == Array<BroadPhase2D::IndexPair>{ { 0, 1 } });
+}
+
+TEST_CASE("BroadPhase2D::FindIntersections() with coordinates beyond float range")
+{
+	// 右端が float で表せない大きさの図形
+	const RectF wide{ 0, 0, 1e300, 10 };
+
+	for (size_t count = 1; count <= 9; ++count)
+	{
+		Array<RectF> rects = Array<RectF>::IndexedGenerate(count, [](const size_t i) { return RectF{ (i * 20.0), 0, 5, 5 }; });
+		rects << wide;
+
+		Array<RectF> others = Array<RectF>::IndexedGenerate(count, [](const size_t i) { return RectF{ (i * 20.0 + 2.0), 2, 5, 5 }; });
+		others << RectF{ 1e200, 0, 1e250, 5 };
+
+		CHECK(BroadPhase2D::FindIntersections(rects) == BruteForce(rects));
+		CHECK(BroadPhase2D::FindIntersections(rects, others) == BruteForce(rects, others));
+		CHECK(BroadPhase2D::FindIntersections(others, rects) == BruteForce(others, rects));
+		CHECK(BroadPhase2D::ParallelFindIntersections(rects, others) == BruteForce(rects, others));
+	}
+}
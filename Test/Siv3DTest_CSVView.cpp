@@ -0,0 +1,84 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	FilePath WriteTestCSV()
+	{
+		const FilePath path = U"test/runtime/csvview/test.csv";
+
+		TextWriter writer{ path };
+		REQUIRE(writer);
+
+		writer.writeUTF8("id,name,value\r\n");
+
+		// 行をまたいでチャンクに分割されるよう、十分な行数を書き込む
+		for (int32 i = 0; i < 300'000; ++i)
+		{
+			writer.writeUTF8(U"{},\"名前,{}\",{}\r\n"_fmt(i, i, (i * 0.25)).toUTF8());
+		}
+
+		writer.writeUTF8("\n");
+		writer.writeUTF8("a\\\"b,\"c\"\"d\",e\\,f,g\\nh,\\x");
+
+		return path;
+	}
+}
+
+TEST_CASE("CSVView")
+{
+	const FilePath path = WriteTestCSV();
+	const CSV csv{ path };
+
+	SECTION("random access")
+	{
+		const CSVView view{ path };
+		REQUIRE(view.isOpen());
+		REQUIRE(view.rows() == csv.rows());
+
+		for (size_t row = 0; row < csv.rows(); row += 997)
+		{
+			REQUIRE(view.columns(row) == csv.columns(row));
+			REQUIRE(view.getRow(row).asArray() == csv.getRow(row));
+		}
+
+		for (size_t row = (csv.rows() - 3); row < csv.rows(); ++row)
+		{
+			REQUIRE(view.columns(row) == csv.columns(row));
+			REQUIRE(view[row].asArray() == csv[row]);
+		}
+
+		REQUIRE(view.get<int32>(12346, 0) == 12345);
+		REQUIRE(view.get<double>(12346, 2) == (12345 * 0.25));
+		REQUIRE(view.get(12346, 1) == U"名前,12345");
+		REQUIRE(view.getOpt<int32>(12346, 1) == none);
+		REQUIRE(view.getOpt<int32>(12346, 3) == none);
+		REQUIRE(view.getOr<int32>(view.rows(), 0, -1) == -1);
+	}
+
+	SECTION("ForEachRow")
+	{
+		size_t row = 0;
+		bool matched = true;
+
+		REQUIRE(CSVView::ForEachRow(path, [&](const CSVRowView& rowView)
+		{
+			matched &= (rowView.asArray() == csv[row]);
+			++row;
+		}));
+
+		REQUIRE(matched);
+		REQUIRE(row == csv.rows());
+	}
+}
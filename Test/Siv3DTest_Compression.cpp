@@ -0,0 +1,153 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	Blob MakeTestData(const size_t size)
+	{
+		Blob blob;
+		blob.resize(size);
+
+		SmallRNG rng{ 12345 };
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			// 圧縮できるよう、ゆっくり変化する値にノイズを混ぜる
+			blob.data()[i] = Byte{ static_cast<uint8>(((rng() % 16) == 0) ? rng() : (i / 1000)) };
+		}
+
+		return blob;
+	}
+
+	[[nodiscard]]
+	FilePath WriteCompressedFile(const Blob& data, const CompressionFormat format)
+	{
+		const FilePath path = U"test/runtime/compression/stream_{}.bin"_fmt(static_cast<int32>(format));
+
+		CompressionWriter writer{ path, format };
+		REQUIRE(writer.isOpen());
+
+		// 大きさの異なる書き込みを混ぜる
+		size_t offset = 0;
+		size_t step = 1;
+
+		while (offset < data.size())
+		{
+			const size_t size = Min(step, (data.size() - offset));
+			REQUIRE(writer.write((data.data() + offset), size) == static_cast<int64>(size));
+			offset += size;
+			step = ((step < 200'000) ? (step * 3 + 1) : 1);
+		}
+
+		REQUIRE(writer.size() == static_cast<int64>(data.size()));
+		REQUIRE(writer.close());
+		REQUIRE(not writer.isOpen());
+
+		return path;
+	}
+}
+
+TEST_CASE("CompressionWriter / DecompressionReader")
+{
+	const Blob data = MakeTestData(3'000'000);
+	const std::array<CompressionFormat, 2> formats = { CompressionFormat::Zstandard, CompressionFormat::Zlib };
+
+	SECTION("read all")
+	{
+		for (const auto format : formats)
+		{
+			DecompressionReader reader{ WriteCompressedFile(data, format), format };
+			REQUIRE(reader.isOpen());
+			REQUIRE(reader.size() == -1);
+
+			Blob result;
+			result.resize(data.size() + 100);
+
+			REQUIRE(reader.read(result.data(), result.size()) == static_cast<int64>(data.size()));
+			REQUIRE(std::memcmp(result.data(), data.data(), data.size()) == 0);
+			REQUIRE(reader.size() == static_cast<int64>(data.size()));
+			REQUIRE(reader.read(result.data(), 1) == 0);
+		}
+	}
+
+	SECTION("seek")
+	{
+		for (const auto format : formats)
+		{
+			DecompressionReader reader{ WriteCompressedFile(data, format), format };
+			Byte buffer[100];
+
+			REQUIRE(reader.setPos(2'000'000));
+			REQUIRE(reader.read(buffer, 100) == 100);
+			REQUIRE(std::memcmp(buffer, (data.data() + 2'000'000), 100) == 0);
+
+			REQUIRE(reader.read(buffer, 12345, 100) == 100);
+			REQUIRE(std::memcmp(buffer, (data.data() + 12345), 100) == 0);
+			REQUIRE(reader.getPos() == 12445);
+		}
+	}
+
+	SECTION("one-shot API compatibility")
+	{
+		{
+			const Blob compressed{ WriteCompressedFile(data, CompressionFormat::Zstandard) };
+			REQUIRE(Compression::Decompress(compressed) == data);
+		}
+
+		{
+			const Blob compressed{ WriteCompressedFile(data, CompressionFormat::Zlib) };
+			REQUIRE(Zlib::Decompress(compressed) == data);
+		}
+
+		{
+			DecompressionReader reader{ MemoryReader{ Compression::Compress(data) } };
+
+			Blob result;
+			result.resize(data.size());
+			REQUIRE(reader.read(result.data(), result.size()) == static_cast<int64>(data.size()));
+			REQUIRE(result == data);
+		}
+	}
+
+	SECTION("multi-threaded")
+	{
+		const FilePath path = U"test/runtime/compression/stream_mt.bin";
+		{
+			CompressionWriter writer{ path, CompressionFormat::Zstandard, CompressionWriter::DefaultLevel, 2 };
+			REQUIRE(writer.write(data.data(), data.size()) == static_cast<int64>(data.size()));
+		}
+
+		REQUIRE(Compression::DecompressFile(path) == data);
+	}
+
+	SECTION("Serializer")
+	{
+		const FilePath path = U"test/runtime/compression/serializer.bin";
+		const Array<int32> values = Range(0, 100'000).asArray();
+		{
+			Serializer<CompressionWriter> writer{ path };
+			REQUIRE(writer);
+			writer(values);
+		}
+
+		Array<int32> loaded;
+		{
+			Deserializer<DecompressionReader> reader{ path };
+			REQUIRE(reader);
+			reader(loaded);
+		}
+
+		REQUIRE(loaded == values);
+	}
+}
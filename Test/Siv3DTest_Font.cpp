@@ -0,0 +1,219 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	bool HasSameRegion(const TextureRegion& a, const TextureRegion& b)
+	{
+		return ((a.uvRect.left == b.uvRect.left) && (a.uvRect.top == b.uvRect.top)
+			&& (a.uvRect.right == b.uvRect.right) && (a.uvRect.bottom == b.uvRect.bottom)
+			&& (a.size == b.size));
+	}
+
+	constexpr StringView PreloadTexts[] =
+	{
+		U"The quick brown fox",
+		U"jumps over the lazy dog",
+		U"0123456789 fox dog",
+		U"ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+	};
+
+	void CheckSameGlyphs(const Font& font, const Font& expected, const StringView text)
+	{
+		const Array<Glyph> expectedGlyphs = expected.getGlyphs(text);
+		const Array<Glyph> glyphs = font.getGlyphs(text);
+
+		REQUIRE(glyphs.size() == expectedGlyphs.size());
+
+		for (size_t i = 0; i < glyphs.size(); ++i)
+		{
+			CHECK(glyphs[i].glyphIndex == expectedGlyphs[i].glyphIndex);
+			CHECK(HasSameRegion(glyphs[i].texture, expectedGlyphs[i].texture));
+			CHECK(glyphs[i].xAdvance == expectedGlyphs[i].xAdvance);
+		}
+	}
+
+	// グリフキャッシュファイルの一部を書き換えて保存する
+	template <class Type>
+	void PatchFile(const FilePathView from, const FilePathView to, const size_t offset, const Type value)
+	{
+		Blob blob{ from };
+		REQUIRE((offset + sizeof(Type)) <= blob.size());
+		std::memcpy((blob.data() + offset), &value, sizeof(Type));
+		REQUIRE(blob.save(to));
+	}
+
+	void CheckPreloadAsync(const FontMethod method)
+	{
+		const Font expected{ method, 32, Typeface::Regular };
+		const Font font{ method, 32, Typeface::Regular };
+
+		// 前の先読みの完了を待たずに、続けて要求できる
+		for (const auto& text : PreloadTexts)
+		{
+			REQUIRE(expected.preload(text));
+			REQUIRE(font.preloadAsync(text));
+		}
+
+		// 先読み中のグリフを使うと、その先読みまでが要求された順に取り込まれる
+		const String allText = String{ PreloadTexts[0] } + PreloadTexts[1] + PreloadTexts[2] + PreloadTexts[3];
+		const Array<Glyph> expectedGlyphs = expected.getGlyphs(allText);
+		const Array<Glyph> glyphs = font.getGlyphs(allText);
+
+		REQUIRE(glyphs.size() == expectedGlyphs.size());
+		CHECK(font.getTexture().size() == expected.getTexture().size());
+
+		for (size_t i = 0; i < glyphs.size(); ++i)
+		{
+			CHECK(glyphs[i].glyphIndex == expectedGlyphs[i].glyphIndex);
+			CHECK(HasSameRegion(glyphs[i].texture, expectedGlyphs[i].texture));
+			CHECK(glyphs[i].xAdvance == expectedGlyphs[i].xAdvance);
+		}
+	}
+}
+
+TEST_CASE("Font::preloadAsync() SDF")
+{
+	CheckPreloadAsync(FontMethod::SDF);
+}
+
+TEST_CASE("Font::preloadAsync() MSDF")
+{
+	CheckPreloadAsync(FontMethod::MSDF);
+}
+
+TEST_CASE("Font::preloadAsync() then preload()")
+{
+	const Font expected{ FontMethod::SDF, 24, Typeface::Regular };
+	const Font font{ FontMethod::SDF, 24, Typeface::Regular };
+
+	REQUIRE(expected.preload(PreloadTexts[0]));
+	REQUIRE(expected.preload(PreloadTexts[1]));
+
+	// 2 つの文字列は共通のグリフを含むため、先に要求された非同期の先読みが先に取り込まれる
+	REQUIRE(font.preloadAsync(PreloadTexts[0]));
+	REQUIRE(font.preload(PreloadTexts[1]));
+
+	for (const auto& text : { PreloadTexts[0], PreloadTexts[1] })
+	{
+		const Array<Glyph> expectedGlyphs = expected.getGlyphs(text);
+		const Array<Glyph> glyphs = font.getGlyphs(text);
+
+		REQUIRE(glyphs.size() == expectedGlyphs.size());
+
+		for (size_t i = 0; i < glyphs.size(); ++i)
+		{
+			CHECK(HasSameRegion(glyphs[i].texture, expectedGlyphs[i].texture));
+		}
+	}
+}
+
+TEST_CASE("Font::saveGlyphCache() and loadGlyphCache()")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/font/glyphs.bin");
+	const String text = String{ PreloadTexts[0] } + PreloadTexts[1];
+
+	const Font expected{ FontMethod::SDF, 32, Typeface::Regular };
+	REQUIRE(expected.preload(text));
+	REQUIRE(expected.saveGlyphCache(path));
+
+	SECTION("round trip")
+	{
+		const Font font{ FontMethod::SDF, 32, Typeface::Regular };
+		REQUIRE(font.loadGlyphCache(path));
+		CHECK(font.getTexture().size() == expected.getTexture().size());
+		CheckSameGlyphs(font, expected, text);
+
+		// 読み込み後に追加したグリフも、保存元と同じ位置に配置される
+		REQUIRE(expected.preload(PreloadTexts[3]));
+		CheckSameGlyphs(font, expected, PreloadTexts[3]);
+	}
+
+	SECTION("different font")
+	{
+		const Font font{ FontMethod::SDF, 24, Typeface::Regular };
+		CHECK_FALSE(font.loadGlyphCache(path));
+		CHECK_FALSE(Font{ FontMethod::MSDF, 32, Typeface::Regular }.loadGlyphCache(path));
+		CHECK_FALSE(Font{ FontMethod::SDF, 32, Typeface::Bold }.loadGlyphCache(path));
+	}
+
+	SECTION("corrupt file")
+	{
+		const FilePath brokenPath = FileSystem::FullPath(U"test/runtime/font/broken.bin");
+		const Font font{ FontMethod::SDF, 32, Typeface::Regular };
+
+		// ファイルの形式: ヘッダ (80 bytes), グリフごとのレコード (48 bytes), 画像
+		constexpr size_t ImageWidthOffset		= 52;
+		constexpr size_t ImageHeightOffset		= 56;
+		constexpr size_t PenPosXOffset			= 60;
+		constexpr size_t PenPosYOffset			= 64;
+		constexpr size_t CurrentMaxHeightOffset	= 68;
+		constexpr size_t RecordOffset			= 80;
+		constexpr size_t RegionLeftOffset		= (RecordOffset + 20);
+		constexpr size_t RegionTopOffset		= (RecordOffset + 22);
+		constexpr size_t RegionWidthOffset		= (RecordOffset + 24);
+		constexpr size_t RegionHeightOffset		= (RecordOffset + 26);
+
+		const Size imageSize = expected.getTexture().size();
+
+		PatchFile<int32>(path, brokenPath, PenPosXOffset, (imageSize.x + 1));
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int32>(path, brokenPath, PenPosXOffset, -1);
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int32>(path, brokenPath, PenPosYOffset, (imageSize.y + 1));
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int32>(path, brokenPath, CurrentMaxHeightOffset, (imageSize.y + 1));
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int16>(path, brokenPath, RegionLeftOffset, Largest<int16>);
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int16>(path, brokenPath, RegionTopOffset, -1);
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int16>(path, brokenPath, RegionTopOffset, Largest<int16>);
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int16>(path, brokenPath, RegionWidthOffset, static_cast<int16>(imageSize.x + 1));
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int16>(path, brokenPath, RegionHeightOffset, static_cast<int16>(imageSize.y + 1));
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		// 画像の大きさとファイルの大きさが一致しない
+		PatchFile<int32>(path, brokenPath, ImageWidthOffset, (imageSize.x * 2));
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		PatchFile<int32>(path, brokenPath, ImageHeightOffset, -imageSize.y);
+		CHECK_FALSE(font.loadGlyphCache(brokenPath));
+
+		// 途中で切れている
+		{
+			Blob blob{ path };
+			blob.resize(blob.size() - 1);
+			REQUIRE(blob.save(brokenPath));
+			CHECK_FALSE(font.loadGlyphCache(brokenPath));
+		}
+
+		// 読み込みに失敗しても、キャッシュは壊れない
+		CheckSameGlyphs(font, expected, text);
+
+		// 書き換えなければ読み込める
+		PatchFile<int32>(path, brokenPath, PenPosXOffset, imageSize.x);
+		CHECK(font.loadGlyphCache(brokenPath));
+	}
+}
@@ -0,0 +1,143 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	Image Replay(const Graphics2D::CommandList& list)
+	{
+		const RenderTexture renderTexture{ 64, 64, Palette::Black };
+		{
+			const ScopedRenderTarget2D target{ renderTexture };
+			list.draw();
+		}
+		Graphics2D::Flush();
+
+		Image image;
+		renderTexture.readAsImage(image);
+		return image;
+	}
+}
+
+TEST_CASE("Graphics2D::CommandList record")
+{
+	Graphics2D::CommandList list;
+	REQUIRE(list.isEmpty());
+
+	list.addRect(RectF{ 0, 0, 10, 10 }, Palette::Red);
+	list.addTriangle(Triangle{ 0, 0, 10, 0, 0, 10 }, Palette::Green);
+	REQUIRE(list.num_vertices() == 7);
+	REQUIRE(list.num_triangles() == 3);
+	REQUIRE(list.num_batches() == 1);
+
+	list.setBlendState(BlendState::Additive);
+	list.addRect(RectF{ 20, 20, 10, 10 }, Palette::Blue);
+	REQUIRE(list.num_batches() == 2);
+
+	list.clear();
+	REQUIRE(list.isEmpty());
+	REQUIRE(list.num_vertices() == 0);
+	REQUIRE(list.getTransform() == Mat3x2::Identity());
+}
+
+TEST_CASE("Graphics2D::CommandList oversized addVertices()")
+{
+	// 1 つのセグメントに収まらない数の三角形
+	constexpr size_t N = 30000;
+
+	Array<Vertex2D> vertices(3);
+	vertices[0].pos = Float2{ 0, 0 };
+	vertices[1].pos = Float2{ 1, 0 };
+	vertices[2].pos = Float2{ 0, 1 };
+
+	const Array<TriangleIndex> indices(N, TriangleIndex{ 0, 1, 2 });
+
+	Graphics2D::CommandList list;
+	list.addVertices(vertices.data(), vertices.size(), indices.data(), indices.size());
+
+	REQUIRE(list.num_triangles() == N);
+	REQUIRE(2 <= list.num_batches());
+}
+
+TEST_CASE("Graphics2D::CommandList replay")
+{
+	Graphics2D::CommandList list;
+
+	std::thread{ [&]()
+	{
+		list.addRect(RectF{ 0, 0, 32, 64 }, Palette::Red);
+		list.setTransform(Mat3x2::Translate(32, 0));
+		list.addRect(RectF{ 0, 0, 32, 64 }, Palette::Blue);
+	} }.join();
+
+	const Image image = Replay(list);
+	REQUIRE(image[16][8] == Color{ 255, 0, 0 });
+	REQUIRE(image[16][40] == Color{ 0, 0, 255 });
+
+	// draw() は記録を消費しない
+	REQUIRE(Replay(list) == image);
+}
+
+TEST_CASE("Graphics2D::CommandList reorder")
+{
+	const Texture textureA{ Image{ 4, 4, Palette::Red } };
+	const Texture textureB{ Image{ 4, 4, Palette::Blue } };
+
+	const auto record = [&](Graphics2D::CommandList& list, const bool reorderable, const double spacing)
+	{
+		list.clear();
+		list.reserve(64, 32);
+		list.setReorderable(reorderable);
+
+		for (int32 i = 0; i < 4; ++i)
+		{
+			const Texture& texture = ((i % 2) ? textureB : textureA);
+			list.addTextureRegion(texture(0, 0, 4, 4), RectF{ (i * spacing), (i * spacing), 10, 10 });
+		}
+	};
+
+	Graphics2D::CommandList list;
+
+	// 重ならない図形は、同じテクスチャの図形の直後へ移動される
+	{
+		record(list, false, 16.0);
+		REQUIRE(list.num_batches() == 4);
+		const Image expected = Replay(list);
+
+		record(list, true, 16.0);
+		REQUIRE(list.num_batches() == 2);
+		REQUIRE(list.num_triangles() == 8);
+		REQUIRE(Replay(list) == expected);
+	}
+
+	// 重なる図形は追い越さない
+	{
+		record(list, false, 5.0);
+		const Image expected = Replay(list);
+
+		record(list, true, 5.0);
+		REQUIRE(list.num_batches() == 4);
+		REQUIRE(Replay(list) == expected);
+	}
+
+	// 並べ替えを許可しない図形は、記録順に追加される
+	{
+		list.clear();
+		list.setReorderable(true);
+		list.addTextureRegion(textureA(0, 0, 4, 4), RectF{ 0, 0, 10, 10 });
+		list.setReorderable(false);
+		list.addTextureRegion(textureB(0, 0, 4, 4), RectF{ 16, 16, 10, 10 });
+		list.addTextureRegion(textureA(0, 0, 4, 4), RectF{ 32, 32, 10, 10 });
+		REQUIRE(list.num_batches() == 3);
+	}
+}
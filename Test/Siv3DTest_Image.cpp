@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/OpenCV_Bridge.hpp>
 # include "Siv3DTest.hpp"
 
 TEST_CASE("Image")
@@ -201,3 +202,349 @@ TEST_CASE("Image")
 		}
 	}
 }
+
+namespace
+{
+	[[nodiscard]]
+	Image MakeRandomImage(const int32 width, const int32 height)
+	{
+		Image image{ Size{ width, height } };
+
+		for (auto& pixel : image)
+		{
+			pixel = Color{ static_cast<uint8>(Random(255)), static_cast<uint8>(Random(255)), static_cast<uint8>(Random(255)), static_cast<uint8>(Random(255)) };
+		}
+
+		return image;
+	}
+
+	// Image::warpAffine() と同じ出力サイズ・変換行列で cv::warpAffine() を直接呼ぶ
+	[[nodiscard]]
+	Image CVWarpAffine(const Image& src, const Mat3x2& mat, const Color& background)
+	{
+		const Quad quad{
+			mat.transformPoint(Point{ 0, 0 }),
+			mat.transformPoint(Point{ src.width(), 0 }),
+			mat.transformPoint(Point{ src.width(), src.height() }),
+			mat.transformPoint(Point{ 0, src.height() })
+		};
+		const RectF boundingRect = Geometry2D::BoundingRect(&quad.p0, 4);
+		const Mat3x2 m = mat.translated(-boundingRect.pos);
+		const Size dstSize = Math::Ceil(boundingRect.size).asPoint();
+
+		const cv::Matx23f transform{ m._11, m._21, m._31, m._12, m._22, m._32 };
+		const cv::Mat matSrc(cv::Size(src.width(), src.height()), CV_8UC4, const_cast<uint8*>(src.dataAsUint8()), src.stride());
+		cv::Mat_<cv::Vec4b> matDst;
+
+		cv::warpAffine(matSrc, matDst, transform, cv::Size(dstSize.x, dstSize.y), cv::INTER_LINEAR, cv::BORDER_CONSTANT,
+			cv::Scalar(background.r, background.g, background.b, background.a));
+
+		Image image;
+		OpenCV_Bridge::FromMatVec4bRGBA(matDst, image);
+		return image;
+	}
+}
+
+TEST_CASE("Image pixel operations")
+{
+	// SIMD 版の端数処理を確認するため、4 や 8 で割り切れないサイズも含める
+	Array<Image> sources;
+
+	for (const Size size : { Size{ 1, 1 }, Size{ 3, 5 }, Size{ 8, 8 }, Size{ 37, 29 }, Size{ 130, 67 } })
+	{
+		sources << MakeRandomImage(size.x, size.y);
+	}
+
+	SECTION("negated")
+	{
+		for (const auto& src : sources)
+		{
+			const Image image = src.negated();
+
+			for (size_t i = 0; i < src.num_pixels(); ++i)
+			{
+				REQUIRE(image.data()[i] == ~src.data()[i]);
+			}
+		}
+	}
+
+	SECTION("grayscaled")
+	{
+		for (const auto& src : sources)
+		{
+			const Image image = src.grayscaled();
+
+			for (size_t i = 0; i < src.num_pixels(); ++i)
+			{
+				const Color pixel = src.data()[i];
+				const uint8 gray = pixel.grayscale0_255();
+				REQUIRE(image.data()[i] == Color{ gray, gray, gray, pixel.a });
+			}
+		}
+	}
+
+	SECTION("premultipliedAlpha")
+	{
+		for (const auto& src : sources)
+		{
+			const Image image = src.premultipliedAlpha();
+
+			for (size_t i = 0; i < src.num_pixels(); ++i)
+			{
+				const Color pixel = src.data()[i];
+				const uint32 a = pixel.a;
+				REQUIRE(image.data()[i] == Color{ static_cast<uint8>((pixel.r * a + 127) / 255), static_cast<uint8>((pixel.g * a + 127) / 255), static_cast<uint8>((pixel.b * a + 127) / 255), pixel.a });
+			}
+		}
+	}
+
+	SECTION("mirrored")
+	{
+		for (const auto& src : sources)
+		{
+			const Size size = src.size();
+
+			const Image image = src.mirrored();
+			REQUIRE(Image{ src }.mirror() == image);
+
+			for (int32 y = 0; y < size.y; ++y)
+			{
+				for (int32 x = 0; x < size.x; ++x)
+				{
+					REQUIRE(image[y][x] == src[y][size.x - 1 - x]);
+				}
+			}
+		}
+	}
+
+	SECTION("rotated90 / rotated270")
+	{
+		for (const auto& src : sources)
+		{
+			const Size size = src.size();
+
+			const Image image90 = src.rotated90();
+			const Image image270 = src.rotated270();
+			REQUIRE(image90.size() == Size{ size.y, size.x });
+			REQUIRE(Image{ src }.rotate90() == image90);
+			REQUIRE(Image{ src }.rotate270() == image270);
+
+			for (int32 y = 0; y < size.y; ++y)
+			{
+				for (int32 x = 0; x < size.x; ++x)
+				{
+					REQUIRE(image90[x][size.y - 1 - y] == src[y][x]);
+					REQUIRE(image270[size.x - 1 - x][y] == src[y][x]);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Image parallel filters")
+{
+	// 複数のタイルに分割されるよう、十分な大きさの画像を使う
+	Array<Image> sources;
+
+	for (const Size size : { Size{ 1, 1 }, Size{ 37, 29 }, Size{ 1000, 517 }, Size{ 1531, 203 } })
+	{
+		sources << MakeRandomImage(size.x, size.y);
+	}
+
+	SECTION("gaussianBlurred")
+	{
+		for (const auto& src : sources)
+		{
+			for (const BorderType borderType : { BorderType::Replicate, BorderType::Reflect, BorderType::Reflect_101 })
+			{
+				REQUIRE(src.gaussianBlurred(2, borderType, Parallel::Yes) == src.gaussianBlurred(2, borderType));
+				REQUIRE(src.gaussianBlurred(3, 40, borderType, Parallel::Yes) == src.gaussianBlurred(3, 40, borderType));
+			}
+		}
+	}
+
+	SECTION("gaussianBlur")
+	{
+		for (const auto& src : sources)
+		{
+			Image image{ src };
+			image.gaussianBlur(5, 7, BorderType::Reflect_101, Parallel::Yes);
+			REQUIRE(image == src.gaussianBlurred(5, 7));
+		}
+	}
+
+	SECTION("rotated")
+	{
+		for (const auto& src : sources)
+		{
+			for (const double angle : { 0.0, 0.3, -1.7, Math::Pi })
+			{
+				REQUIRE(src.rotated(angle, Color{ 20, 40, 60, 80 }, Parallel::Yes) == src.rotated(angle, Color{ 20, 40, 60, 80 }));
+			}
+		}
+	}
+
+	SECTION("warpAffine")
+	{
+		const Mat3x2 mat = (Mat3x2::Scale(1.3, 0.7) * Mat3x2::Rotate(0.5) * Mat3x2::Translate(10.5, -3.25));
+
+		for (const auto& src : sources)
+		{
+			REQUIRE(src.warpAffine(mat, Palette::White, Parallel::Yes) == src.warpAffine(mat, Palette::White));
+		}
+	}
+
+	SECTION("warpAffine matches cv::warpAffine")
+	{
+		// 並列版は cv::warpAffine() の固定小数点の座標計算を再現しているため、結果が一致することを確かめる
+		const Mat3x2 mats[] =
+		{
+			Mat3x2::Identity(),
+			Mat3x2::Translate(0.37, -12.81),
+			(Mat3x2::Scale(1.3, 0.7) * Mat3x2::Rotate(0.5) * Mat3x2::Translate(10.5, -3.25)),
+			Mat3x2::Rotate(-2.9, Vec2{ 100.3, 50.7 }),
+			Mat3x2::Scale(-1.0, 1.0),
+			Mat3x2::Scale(0.11, 3.7),
+			(Mat3x2::ShearX(0.4) * Mat3x2::ShearY(-0.25)),
+			Mat3x2{ 0.93f, 0.21f, -0.48f, 1.07f, 3.3f, -7.9f },
+		};
+
+		for (const auto& src : sources)
+		{
+			for (const auto& mat : mats)
+			{
+				const Image expected = CVWarpAffine(src, mat, Color{ 20, 40, 60, 80 });
+				REQUIRE(src.warpAffine(mat, Color{ 20, 40, 60, 80 }, Parallel::Yes) == expected);
+				REQUIRE(src.warpAffine(mat, Color{ 20, 40, 60, 80 }) == expected);
+			}
+		}
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Image pixel operations : benchmark")
+{
+	const Image src = MakeRandomImage(3840, 2160);
+
+	BENCHMARK("scalar grayscale | 4K")
+	{
+		Image image{ src };
+
+		for (auto& pixel : image)
+		{
+			const uint8 gray = pixel.grayscale0_255();
+			pixel.r = gray;
+			pixel.g = gray;
+			pixel.b = gray;
+		}
+
+		return image;
+	};
+
+	BENCHMARK("Image::grayscaled() | 4K")
+	{
+		return src.grayscaled();
+	};
+
+	BENCHMARK("scalar negate | 4K")
+	{
+		Image image{ src };
+
+		for (auto& pixel : image)
+		{
+			pixel = ~pixel;
+		}
+
+		return image;
+	};
+
+	BENCHMARK("Image::negated() | 4K")
+	{
+		return src.negated();
+	};
+
+	BENCHMARK("scalar premultiply alpha | 4K")
+	{
+		Image image{ src };
+
+		for (auto& pixel : image)
+		{
+			const uint32 a = pixel.a;
+			pixel.r = static_cast<uint8>((pixel.r * a + 127) / 255);
+			pixel.g = static_cast<uint8>((pixel.g * a + 127) / 255);
+			pixel.b = static_cast<uint8>((pixel.b * a + 127) / 255);
+		}
+
+		return image;
+	};
+
+	BENCHMARK("Image::premultipliedAlpha() | 4K")
+	{
+		return src.premultipliedAlpha();
+	};
+
+	BENCHMARK("scalar mirror | 4K")
+	{
+		Image image{ src };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			std::reverse(image[y], (image[y] + image.width()));
+		}
+
+		return image;
+	};
+
+	BENCHMARK("Image::mirrored() | 4K")
+	{
+		return src.mirrored();
+	};
+
+	BENCHMARK("scalar rotate90 | 4K")
+	{
+		Image image{ src.height(), src.width() };
+
+		for (int32 y = 0; y < src.height(); ++y)
+		{
+			for (int32 x = 0; x < src.width(); ++x)
+			{
+				image[x][src.height() - y - 1] = src[y][x];
+			}
+		}
+
+		return image;
+	};
+
+	BENCHMARK("Image::rotated90() | 4K")
+	{
+		return src.rotated90();
+	};
+}
+
+TEST_CASE("Image parallel filters : benchmark")
+{
+	const Image src = MakeRandomImage(3840, 2160);
+
+	BENCHMARK("Image::gaussianBlurred() | 4K")
+	{
+		return src.gaussianBlurred(8);
+	};
+
+	BENCHMARK("Image::gaussianBlurred(Parallel::Yes) | 4K")
+	{
+		return src.gaussianBlurred(8, BorderType::Reflect_101, Parallel::Yes);
+	};
+
+	BENCHMARK("Image::rotated() | 4K")
+	{
+		return src.rotated(0.5);
+	};
+
+	BENCHMARK("Image::rotated(Parallel::Yes) | 4K")
+	{
+		return src.rotated(0.5, Color{ 0, 0 }, Parallel::Yes);
+	};
+}
+
+# endif
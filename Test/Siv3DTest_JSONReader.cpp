@@ -0,0 +1,166 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("JSONReader / JSONWriter")
+{
+	const FilePath path = U"test/runtime/jsonreader/test.json";
+
+	{
+		JSONWriter writer{ path };
+		REQUIRE(writer);
+
+		writer.startObject();
+		{
+			writer.write(U"name", U"テスト \"1\"\n😀");
+			writer.write(U"version", 3);
+			writer.write(U"ratio", 0.125);
+			writer.write(U"enabled", true);
+			writer.write(U"parent", nullptr);
+
+			writer.key(U"items");
+			writer.startArray();
+			for (int32 i = 0; i < 100'000; ++i)
+			{
+				writer.startObject();
+				writer.write(U"id", i);
+				writer.write(U"tags", JSON{ Array<String>{ U"a", U"b" } });
+				writer.endObject();
+			}
+			writer.endArray();
+		}
+		writer.endObject();
+
+		REQUIRE(writer.close());
+	}
+
+	SECTION("compare with JSON")
+	{
+		const JSON json = JSON::Load(path);
+		REQUIRE(json);
+		REQUIRE(json[U"name"].getString() == U"テスト \"1\"\n😀");
+		REQUIRE(json[U"version"].get<int32>() == 3);
+		REQUIRE(json[U"ratio"].get<double>() == 0.125);
+		REQUIRE(json[U"enabled"].get<bool>() == true);
+		REQUIRE(json[U"parent"].isNull());
+		REQUIRE(json[U"items"].size() == 100'000);
+	}
+
+	SECTION("pull events")
+	{
+		JSONReader reader{ path };
+		REQUIRE(reader);
+		REQUIRE(reader.next() == JSONEvent::StartObject);
+
+		int64 sum = 0;
+		size_t count = 0;
+
+		while (reader.next() == JSONEvent::Key)
+		{
+			if (reader.isKey("name"))
+			{
+				REQUIRE(reader.next() == JSONEvent::String);
+				REQUIRE(reader.get<String>() == U"テスト \"1\"\n😀");
+			}
+			else if (reader.isKey("version"))
+			{
+				REQUIRE(reader.next() == JSONEvent::Number);
+				REQUIRE(reader.get<int32>() == 3);
+			}
+			else if (reader.isKey("ratio"))
+			{
+				REQUIRE(reader.next() == JSONEvent::Number);
+				REQUIRE(reader.get<double>() == 0.125);
+			}
+			else if (reader.isKey("enabled"))
+			{
+				REQUIRE(reader.next() == JSONEvent::Bool);
+				REQUIRE(reader.get<bool>() == true);
+			}
+			else if (reader.isKey("items"))
+			{
+				REQUIRE(reader.next() == JSONEvent::StartArray);
+
+				while (reader.next() == JSONEvent::StartObject)
+				{
+					REQUIRE(reader.depth() == 2);
+
+					while (reader.next() == JSONEvent::Key)
+					{
+						if (reader.isKey("id"))
+						{
+							reader.next();
+							sum += reader.getOr<int64>(0);
+						}
+						else
+						{
+							REQUIRE(reader.skip());
+						}
+					}
+
+					++count;
+				}
+
+				REQUIRE(reader.event() == JSONEvent::EndArray);
+			}
+			else
+			{
+				REQUIRE(reader.skip());
+			}
+		}
+
+		REQUIRE(reader.event() == JSONEvent::EndObject);
+		REQUIRE(reader.next() == JSONEvent::None);
+		REQUIRE(count == 100'000);
+		REQUIRE(sum == (99'999LL * 100'000LL / 2));
+	}
+
+	SECTION("readJSON")
+	{
+		JSONReader reader{ path };
+		REQUIRE(reader.next() == JSONEvent::StartObject);
+
+		while (reader.next() == JSONEvent::Key)
+		{
+			if (reader.isKey("items"))
+			{
+				reader.next();
+				const JSON items = reader.readJSON();
+				REQUIRE(items.size() == 100'000);
+				REQUIRE(items[99'999][U"id"].get<int32>() == 99'999);
+			}
+			else
+			{
+				reader.next();
+				REQUIRE(reader.readJSON());
+			}
+		}
+	}
+
+	SECTION("errors")
+	{
+		const std::string text = R"({"a": [1, 2,]})";
+		JSONReader reader{ MemoryReader{ Blob{ text.data(), text.size() } } };
+
+		JSONEvent event;
+		while ((event = reader.next()) != JSONEvent::None)
+		{
+			if (event == JSONEvent::Error)
+			{
+				break;
+			}
+		}
+
+		REQUIRE(event == JSONEvent::Error);
+		REQUIRE(not reader.getErrorMessage().isEmpty());
+	}
+}
@@ -0,0 +1,132 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	constexpr size_t ThreadCount = 4;
+
+	constexpr size_t MessageCount = 2000;
+
+	// 各スレッドから、番号付きのログを書き込む
+	void WriteLogs(const std::function<void(size_t)>& onProgress = {})
+	{
+		Array<std::thread> threads;
+
+		for (size_t t = 0; t < ThreadCount; ++t)
+		{
+			threads.emplace_back([t, &onProgress]()
+				{
+					for (size_t i = 0; i < MessageCount; ++i)
+					{
+						Logger << U"thread{} message{}"_fmt(t, i);
+
+						if (onProgress && (t == 0))
+						{
+							onProgress(i);
+						}
+					}
+				});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	// すべてのログが 1 回ずつ、スレッドごとに書き込んだ順に出力されているか
+	[[nodiscard]]
+	bool CheckLogs(const FilePath& path)
+	{
+		TextReader reader{ path };
+
+		if (not reader)
+		{
+			return false;
+		}
+
+		Array<size_t> next(ThreadCount, 0);
+		String line;
+
+		while (reader.readLine(line))
+		{
+			// "時刻: thread{t} message{i}"
+			const size_t pos = line.indexOf(U": thread");
+
+			if (pos == String::npos)
+			{
+				continue;
+			}
+
+			const Array<String> words = line.substr(pos + 2).split(U' ');
+
+			if (words.size() != 2)
+			{
+				return false;
+			}
+
+			const size_t t = Parse<size_t>(words[0].substr(6));
+			const size_t i = Parse<size_t>(words[1].substr(7));
+
+			if ((ThreadCount <= t) || (next[t] != i))
+			{
+				return false;
+			}
+
+			++next[t];
+		}
+
+		return next.all([](size_t n) { return (n == MessageCount); });
+	}
+}
+
+TEST_CASE("Logger async")
+{
+	const FilePath directory = U"test/runtime/logger/";
+	FileSystem::Remove(directory);
+	REQUIRE(FileSystem::CreateDirectories(directory));
+
+	SECTION("setAsync")
+	{
+		const FilePath path = (directory + U"async.txt");
+		REQUIRE(Logger.setOutputFile(path));
+
+		Logger.setAsync(true, (256 * 1024), LogOverflowPolicy::Block);
+		WriteLogs();
+		Logger.flush();
+
+		CHECK(CheckLogs(path));
+	}
+
+	SECTION("setAsync while writing")
+	{
+		// 非同期出力を切り替えている間に書き込まれたログも失われない
+		const FilePath path = (directory + U"switch.txt");
+		REQUIRE(Logger.setOutputFile(path));
+
+		WriteLogs([](const size_t i)
+			{
+				if ((i % 200) == 0)
+				{
+					Logger.setAsync(((i / 200) % 2) == 0, (64 * 1024), LogOverflowPolicy::Block);
+				}
+			});
+
+		Logger.flush();
+
+		CHECK(CheckLogs(path));
+	}
+
+	Logger.setAsync(false);
+	Logger.setOutputFile(U"");
+}
@@ -0,0 +1,164 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	constexpr RectF Field{ 0, 0, 40, 30 };
+
+	// 上側だけを空けて、左右を分ける壁
+	constexpr RectF Wall{ 19, -1, 2, 18 };
+
+	constexpr Vec2 Start{ 2, 10 };
+
+	constexpr Vec2 Goal{ 38, 10 };
+
+	[[nodiscard]]
+	Polygon MakeMap(const bool blocked)
+	{
+		if (not blocked)
+		{
+			return Field.asPolygon();
+		}
+
+		// 壁の部分を切り抜く
+		const Array<Polygon> polygons = Geometry2D::Subtract(Field.asPolygon(), Wall);
+
+		return (polygons.size() == 1) ? polygons.front() : Polygon{};
+	}
+
+	[[nodiscard]]
+	double PathLength(const Array<Vec2>& path)
+	{
+		double length = 0.0;
+
+		for (size_t i = 1; i < path.size(); ++i)
+		{
+			length += path[i - 1].distanceFrom(path[i]);
+		}
+
+		return length;
+	}
+
+	[[nodiscard]]
+	bool CrossesWall(const Array<Vec2>& path)
+	{
+		// 経路は壁の角をかすめるので、少し縮めた壁と比べる
+		const RectF wall = Wall.stretched(-0.1);
+
+		for (size_t i = 1; i < path.size(); ++i)
+		{
+			if (Line{ path[i - 1], path[i] }.intersects(wall))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	[[nodiscard]]
+	Array<std::pair<Vec2, Vec2>> MakeQueries()
+	{
+		DefaultRNG rng{ 12345 };
+
+		Array<std::pair<Vec2, Vec2>> queries;
+
+		for (int32 i = 0; i < 200; ++i)
+		{
+			const Vec2 start{ Random(1.0, 39.0, rng), Random(1.0, 29.0, rng) };
+			const Vec2 end{ Random(1.0, 39.0, rng), Random(1.0, 29.0, rng) };
+			queries.emplace_back(start, end);
+		}
+
+		return queries;
+	}
+
+	// queryBatch() の結果が、それぞれ query() を呼んだ場合と一致するか
+	[[nodiscard]]
+	bool BatchMatchesQuery(const NavMesh& navMesh, const Array<std::pair<Vec2, Vec2>>& queries)
+	{
+		const Array<Array<Vec2>> results = navMesh.queryBatch(queries);
+
+		if (results.size() != queries.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			if (results[i] != navMesh.query(queries[i].first, queries[i].second))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+TEST_CASE("NavMesh")
+{
+	NavMeshConfig config;
+	config.tileSize = 8;
+
+	const Polygon openMap = MakeMap(false);
+	const Polygon blockedMap = MakeMap(true);
+	REQUIRE(blockedMap);
+
+	NavMesh navMesh{ openMap, config };
+	REQUIRE(navMesh);
+
+	const Array<std::pair<Vec2, Vec2>> queries = MakeQueries();
+
+	// 壁が無ければ、ほぼ真っすぐに進む
+	{
+		const Array<Vec2> path = navMesh.query(Start, Goal);
+		REQUIRE(2 <= path.size());
+		CHECK(path.front().distanceFrom(Start) < 0.5);
+		CHECK(path.back().distanceFrom(Goal) < 0.5);
+		CHECK(PathLength(path) < (Start.distanceFrom(Goal) + 0.5));
+		CHECK(CrossesWall(path));
+		CHECK(BatchMatchesQuery(navMesh, queries));
+	}
+
+	SECTION("rebuildTiles")
+	{
+		// 壁にかかるタイルだけを再構築すると、壁の上側を回り込む
+		REQUIRE(navMesh.rebuildTiles(blockedMap, Wall));
+
+		const Array<Vec2> path = navMesh.query(Start, Goal);
+		REQUIRE(2 < path.size());
+		CHECK(path.back().distanceFrom(Goal) < 0.5);
+		CHECK_FALSE(CrossesWall(path));
+		CHECK(path.any([](const Vec2& p) { return (Wall.bottomY() < p.y); }));
+		CHECK((Start.distanceFrom(Goal) + 2.0) < PathLength(path));
+
+		// すべてを構築し直したものと同じ経路になる
+		const NavMesh rebuilt{ blockedMap, config };
+		REQUIRE(rebuilt);
+		CHECK(rebuilt.query(Start, Goal) == path);
+
+		CHECK(BatchMatchesQuery(navMesh, queries));
+
+		// 壁を取り除くと、元の経路に戻る
+		REQUIRE(navMesh.rebuildTiles(openMap, Wall));
+		CHECK(CrossesWall(navMesh.query(Start, Goal)));
+	}
+
+	SECTION("rebuildTiles (unchanged region)")
+	{
+		// 地形を差し替えても、再構築しなかったタイルは以前のまま
+		REQUIRE(navMesh.rebuildTiles(blockedMap, RectF{ 0, 0, 1, 1 }));
+		CHECK(CrossesWall(navMesh.query(Start, Goal)));
+	}
+}
@@ -0,0 +1,70 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("ParallelFor()")
+{
+	{
+		Array<int32> v(100000, 0);
+
+		ParallelFor(0, v.size(), [&](size_t i) { v[i] = static_cast<int32>(i * 2); });
+
+		REQUIRE(v == Array<int32>::IndexedGenerate(v.size(), [](size_t i) { return static_cast<int32>(i * 2); }));
+	}
+
+	{
+		std::atomic<size_t> sum = 0;
+		std::atomic<bool> oversized = false;
+
+		ParallelFor(10, 1010, [&](size_t first, size_t last)
+		{
+			if (7 < (last - first))
+			{
+				oversized = true;
+			}
+
+			for (size_t i = first; i < last; ++i)
+			{
+				sum += i;
+			}
+
+		}, 7);
+
+		REQUIRE(sum == 509500);
+		REQUIRE(oversized == false);
+	}
+
+	{
+		REQUIRE_THROWS_AS(ParallelFor(0, 1000, [](size_t i) { if (i == 500) { throw std::runtime_error{ "error" }; } }, 1), std::runtime_error);
+	}
+}
+
+TEST_CASE("TaskGroup")
+{
+	std::atomic<int32> count = 0;
+
+	TaskGroup group;
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		group.run([&]()
+		{
+			// 入れ子の並列処理
+			ParallelFor(0, 100, [&](size_t) { ++count; });
+		});
+	}
+
+	group.wait();
+
+	REQUIRE(count == 10000);
+	REQUIRE(group.num_pending() == 0);
+}
@@ -0,0 +1,165 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/Renderer2D/Vertex2DBuilder.hpp>
+
+namespace
+{
+	struct ParticleBuildResult
+	{
+		Array<Vertex2D> vertices;
+
+		// 全体の頂点に対する通し番号
+		Array<size_t> indices;
+
+		size_t bufferRequests = 0;
+
+		size_t draws = 0;
+
+		bool indicesInRange = true;
+	};
+
+	// 各レンダラーの addTexturedParticles() と同じ方法で、分割して頂点を生成する
+	[[nodiscard]]
+	ParticleBuildResult BuildParticles(const Particle2DStore& particles,
+		const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc = {},
+		const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc = {})
+	{
+		ParticleBuildResult result;
+		Array<Vertex2D> vertices;
+		Array<Vertex2D::IndexType> indices;
+
+		const BufferCreatorFunc bufferCreator = [&](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+		{
+			++result.bufferRequests;
+			vertices.assign(vertexSize, Vertex2D{});
+			indices.assign(indexSize, 0);
+			return Vertex2DBufferPointer{ vertices.data(), indices.data(), 0 };
+		};
+
+		for (size_t first = 0; first < particles.size(); first += Vertex2DBuilder::MaxParticlesPerBuild)
+		{
+			const size_t last = Min((first + Vertex2DBuilder::MaxParticlesPerBuild), particles.size());
+
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(bufferCreator, particles, first, last, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+			{
+				++result.draws;
+
+				if (indexCount != ((last - first) * 6))
+				{
+					result.indicesInRange = false;
+				}
+
+				// 分割した頂点列の中を指していることを確かめ、通し番号に直して記録する
+				const size_t base = result.vertices.size();
+
+				for (const auto index : indices)
+				{
+					if (vertices.size() <= index)
+					{
+						result.indicesInRange = false;
+					}
+
+					result.indices << (base + index);
+				}
+
+				result.vertices.append(vertices);
+			}
+		}
+
+		return result;
+	}
+
+	[[nodiscard]]
+	Particle2DStore MakeParticles(const size_t count)
+	{
+		Particle2DStore particles;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			Particle2D particle;
+			particle.position = Float2{ static_cast<float>(i % 1000), static_cast<float>(i / 1000) };
+			particle.velocity = Float2{ 0.0f, 0.0f };
+			particle.startColor = Float4{ 1.0f, 0.5f, 0.25f, 1.0f };
+			particle.startSize = 2.0f;
+			particle.rotation = 0.0f;
+			particle.startAngularVelocity = 0.0f;
+			particle.startLifeTime = 1.0f;
+			particle.remainingLifeTime = 1.0f;
+			particles.push_back(particle);
+		}
+
+		return particles;
+	}
+}
+
+TEST_CASE("Vertex2DBuilder::BuildTexturedParticles()")
+{
+	// インデックスの型 (uint16) の範囲を超える数のパーティクル
+	constexpr size_t ParticleCount = 40000;
+	static_assert((Vertex2DBuilder::MaxParticlesPerBuild * 4) <= Largest<Vertex2D::IndexType>);
+	static_assert((Vertex2DBuilder::MaxParticlesPerBuild * 6) <= Largest<Vertex2D::IndexType>);
+	static_assert(16383 < ParticleCount);
+
+	const Particle2DStore particles = MakeParticles(ParticleCount);
+	const size_t chunkCount = ((ParticleCount + (Vertex2DBuilder::MaxParticlesPerBuild - 1)) / Vertex2DBuilder::MaxParticlesPerBuild);
+
+	SECTION("default functions (parallel)")
+	{
+		const ParticleBuildResult result = BuildParticles(particles);
+
+		CHECK(result.bufferRequests == chunkCount);
+		CHECK(result.draws == chunkCount);
+		CHECK(result.indicesInRange);
+		REQUIRE(result.vertices.size() == (ParticleCount * 4));
+		REQUIRE(result.indices.size() == (ParticleCount * 6));
+
+		for (size_t i = 0; i < ParticleCount; ++i)
+		{
+			constexpr size_t RectIndices[6] = { 0, 1, 2, 2, 1, 3 };
+
+			for (size_t k = 0; k < 6; ++k)
+			{
+				REQUIRE(result.indices[i * 6 + k] == (i * 4 + RectIndices[k]));
+			}
+
+			const Float2 center{ static_cast<float>(i % 1000), static_cast<float>(i / 1000) };
+			const Vertex2D* pVertex = &result.vertices[i * 4];
+
+			REQUIRE(pVertex[0].pos == (center + Float2{ -1.0f, -1.0f }));
+			REQUIRE(pVertex[1].pos == (center + Float2{ 1.0f, -1.0f }));
+			REQUIRE(pVertex[2].pos == (center + Float2{ -1.0f, 1.0f }));
+			REQUIRE(pVertex[3].pos == (center + Float2{ 1.0f, 1.0f }));
+		}
+	}
+
+	SECTION("user functions (serial)")
+	{
+		const auto sizeFunc = [](const float startSize, float, float) { return startSize; };
+		const auto colorFunc = [](const Float4& startColor, float, float) { return startColor; };
+
+		const ParticleBuildResult expected = BuildParticles(particles);
+		const ParticleBuildResult result = BuildParticles(particles, sizeFunc, colorFunc);
+
+		CHECK(result.bufferRequests == chunkCount);
+		CHECK(result.draws == chunkCount);
+		CHECK(result.indicesInRange);
+		REQUIRE(result.vertices.size() == expected.vertices.size());
+		CHECK(result.indices == expected.indices);
+
+		for (size_t i = 0; i < result.vertices.size(); ++i)
+		{
+			REQUIRE(result.vertices[i].pos == expected.vertices[i].pos);
+			REQUIRE(result.vertices[i].color == expected.vertices[i].color);
+		}
+	}
+}
@@ -0,0 +1,76 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// 負の座標を含み、幅が計算のブロックの大きさで割り切れない範囲
+	constexpr Rect Region{ -37, -21, 131, 67 };
+
+	constexpr int32 Octaves = 5;
+
+	// fill() の結果が、サンプルごとに normalizedOctave2D0_1() を呼んだ結果と一致しない数
+	// 積和演算の融合などによる丸め誤差は許容する
+	template <class Float>
+	[[nodiscard]]
+	size_t CountMismatches(const BasicPerlinNoise<Float>& noise, const Grid<Float>& grid, const Float frequency, const Float persistence)
+	{
+		constexpr Float Tolerance = (std::numeric_limits<Float>::epsilon() * 64);
+
+		size_t mismatches = 0;
+
+		for (int32 y = 0; y < Region.h; ++y)
+		{
+			for (int32 x = 0; x < Region.w; ++x)
+			{
+				const Float expected = noise.normalizedOctave2D0_1((static_cast<Float>(Region.x + x) * frequency), (static_cast<Float>(Region.y + y) * frequency), Octaves, persistence);
+
+				mismatches += (Tolerance < std::abs(grid[y][x] - expected));
+			}
+		}
+
+		return mismatches;
+	}
+
+	template <class Float>
+	void CheckFill()
+	{
+		const BasicPerlinNoise<Float> noise{ 12345u };
+		const Float frequency = Float(0.0625);
+		const Float persistence = Float(0.6);
+
+		Grid<Float> serial;
+		noise.fill(serial, Region, frequency, Octaves, persistence);
+		REQUIRE(serial.size() == Region.size);
+		CHECK(CountMismatches(noise, serial, frequency, persistence) == 0);
+
+		// 並列に計算しても、結果は変わらない
+		Grid<Float> parallel;
+		noise.fill(parallel, Region, frequency, Octaves, persistence, Parallel::Yes);
+		REQUIRE(parallel.size() == Region.size);
+		CHECK(CountMismatches(noise, parallel, frequency, persistence) == 0);
+		CHECK((parallel == serial));
+	}
+}
+
+TEST_CASE("PerlinNoise fill")
+{
+	SECTION("float")
+	{
+		CheckFill<float>();
+	}
+
+	SECTION("double")
+	{
+		CheckFill<double>();
+	}
+}
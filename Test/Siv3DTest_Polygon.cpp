@@ -0,0 +1,309 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// 空間インデックスを使う判定が、すべての三角形・辺を調べる判定と一致することを確かめる
+
+namespace
+{
+	// 3 つの穴を持ち、空間インデックスが作られる数の三角形からなる多角形
+	[[nodiscard]]
+	Polygon MakeHoledPolygon()
+	{
+		Array<Array<Vec2>> holes;
+		holes << Circle{ 350, 300, 60 }.asPolygon(16).outer().reversed();
+		holes << Circle{ 450, 300, 30 }.asPolygon(16).outer().reversed();
+		holes << Circle{ 400, 180, 40 }.asPolygon(16).outer().reversed();
+
+		return Polygon{ Circle{ 400, 300, 200 }.asPolygon(72).outer(), holes };
+	}
+
+	[[nodiscard]]
+	Array<Line> GetEdges(const Polygon& polygon)
+	{
+		Array<Line> edges;
+
+		// 穴、外周の順
+		for (const auto& ring : polygon.inners())
+		{
+			for (size_t i = 0; i < ring.size(); ++i)
+			{
+				edges.emplace_back(ring[i], ring[(i + 1) % ring.size()]);
+			}
+		}
+
+		const auto& outer = polygon.outer();
+
+		for (size_t i = 0; i < outer.size(); ++i)
+		{
+			edges.emplace_back(outer[i], outer[(i + 1) % outer.size()]);
+		}
+
+		return edges;
+	}
+
+	template <class Shape2DType>
+	[[nodiscard]]
+	bool BruteForceIntersects(const Polygon& polygon, const Shape2DType& shape)
+	{
+		for (size_t i = 0; i < polygon.num_triangles(); ++i)
+		{
+			if (Geometry2D::Intersect(shape, polygon.triangle(i)))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	[[nodiscard]]
+	Optional<Array<Vec2>> BruteForceIntersectAt(const Polygon& polygon, const Line& line)
+	{
+		if (not Geometry2D::Intersect(line, polygon.boundingRect()))
+		{
+			return none;
+		}
+
+		bool hasIntersection = false;
+		Array<Vec2> results;
+
+		for (const auto& edge : GetEdges(polygon))
+		{
+			if (const auto point = line.intersectsAt(edge))
+			{
+				hasIntersection = true;
+
+				if (not point->hasNaN())
+				{
+					results << *point;
+				}
+			}
+		}
+
+		if (hasIntersection)
+		{
+			return results;
+		}
+
+		if (BruteForceIntersects(polygon, line))
+		{
+			return Array<Vec2>{};
+		}
+
+		return none;
+	}
+
+	[[nodiscard]]
+	bool BruteForceContains(const Polygon& polygon, const Circle& circle)
+	{
+		if (not BruteForceIntersects(polygon, circle.center))
+		{
+			return false;
+		}
+
+		return GetEdges(polygon).none([&circle](const Line& edge) { return edge.intersects(circle); });
+	}
+
+	// 重複を除いた交点の集合が一致するか
+	[[nodiscard]]
+	bool SamePoints(const Optional<Array<Vec2>>& a, const Optional<Array<Vec2>>& b)
+	{
+		if (a.has_value() != b.has_value())
+		{
+			return false;
+		}
+
+		if (not a)
+		{
+			return true;
+		}
+
+		const auto includes = [](const Array<Vec2>& points, const Vec2& p)
+			{
+				return points.any([&p](const Vec2& q) { return (q.distanceFromSq(p) < 1e-12); });
+			};
+
+		return (a->all([&](const Vec2& p) { return includes(*b, p); })
+			&& b->all([&](const Vec2& p) { return includes(*a, p); }));
+	}
+
+	[[nodiscard]]
+	Vec2 RandomPoint(const RectF& area, DefaultRNG& rng)
+	{
+		return{ Random(area.x, (area.x + area.w), rng), Random(area.y, (area.y + area.h), rng) };
+	}
+
+	// 境界ボックスの周辺にランダムな図形を作り、インデックスありとなしの結果を比べる
+	void CheckPolygon(const Polygon& polygon, DefaultRNG& rng)
+	{
+		const RectF area = polygon.boundingRect().stretched(50);
+
+		size_t pointMismatches = 0, rectMismatches = 0, circleMismatches = 0, lineMismatches = 0, intersectAtMismatches = 0, containsMismatches = 0;
+		size_t hits = 0;
+
+		for (int32 i = 0; i < 300; ++i)
+		{
+			const Vec2 point = RandomPoint(area, rng);
+			const RectF rect{ RandomPoint(area, rng), Random(0.0, 80.0, rng), Random(0.0, 80.0, rng) };
+			const Circle circle{ RandomPoint(area, rng), Random(1.0, 60.0, rng) };
+			const Line line{ RandomPoint(area, rng), RandomPoint(area, rng) };
+
+			hits += polygon.contains(point);
+
+			pointMismatches += (polygon.contains(point) != BruteForceIntersects(polygon, point));
+			rectMismatches += (polygon.intersects(rect) != BruteForceIntersects(polygon, rect));
+			circleMismatches += (polygon.intersects(circle) != BruteForceIntersects(polygon, circle));
+			lineMismatches += (polygon.intersects(line) != BruteForceIntersects(polygon, line));
+			intersectAtMismatches += (not SamePoints(Geometry2D::IntersectAt(line, polygon), BruteForceIntersectAt(polygon, line)));
+			containsMismatches += (Geometry2D::Contains(polygon, circle) != BruteForceContains(polygon, circle));
+		}
+
+		CHECK(0 < hits);
+		CHECK(pointMismatches == 0);
+		CHECK(rectMismatches == 0);
+		CHECK(circleMismatches == 0);
+		CHECK(lineMismatches == 0);
+		CHECK(intersectAtMismatches == 0);
+		CHECK(containsMismatches == 0);
+	}
+
+	template <class Shape2DType>
+	[[nodiscard]]
+	bool BruteForceIntersects(const MultiPolygon& polygons, const Shape2DType& shape)
+	{
+		return polygons.any([&shape](const Polygon& polygon) { return Geometry2D::Intersect(shape, polygon); });
+	}
+
+	void CheckMultiPolygon(const MultiPolygon& polygons, DefaultRNG& rng)
+	{
+		const RectF area = polygons.computeBoundingRect().stretched(50);
+
+		size_t mismatches = 0;
+		size_t hits = 0;
+
+		for (int32 i = 0; i < 300; ++i)
+		{
+			const Vec2 point = RandomPoint(area, rng);
+			const RectF rect{ RandomPoint(area, rng), Random(0.0, 40.0, rng), Random(0.0, 40.0, rng) };
+			const Circle circle{ RandomPoint(area, rng), Random(1.0, 30.0, rng) };
+			const Line line{ RandomPoint(area, rng), RandomPoint(area, rng) };
+
+			hits += polygons.intersects(point);
+
+			mismatches += (polygons.intersects(point) != BruteForceIntersects(polygons, point));
+			mismatches += (polygons.intersects(rect) != BruteForceIntersects(polygons, rect));
+			mismatches += (polygons.intersects(circle) != BruteForceIntersects(polygons, circle));
+			mismatches += (polygons.intersects(line) != BruteForceIntersects(polygons, line));
+		}
+
+		CHECK(0 < hits);
+		CHECK(mismatches == 0);
+	}
+}
+
+TEST_CASE("Polygon spatial index")
+{
+	DefaultRNG rng{ 12345 };
+
+	Polygon polygon = MakeHoledPolygon();
+	REQUIRE(polygon.inners().size() == 3);
+	REQUIRE(64 <= polygon.num_triangles());
+
+	CheckPolygon(polygon, rng);
+
+	// 移動した後も一致する
+	polygon.moveBy(123.5, -45.25);
+	CheckPolygon(polygon, rng);
+
+	// インデックスが作り直されるまで移動を繰り返す
+	for (int32 i = 0; i < 70; ++i)
+	{
+		polygon.moveBy(-1.5, 0.75);
+	}
+
+	CheckPolygon(polygon, rng);
+
+	// コピーしたものも一致する
+	const Polygon copied = polygon;
+	CheckPolygon(copied, rng);
+}
+
+TEST_CASE("MultiPolygon spatial index")
+{
+	DefaultRNG rng{ 67890 };
+
+	MultiPolygon polygons;
+
+	for (int32 y = 0; y < 5; ++y)
+	{
+		for (int32 x = 0; x < 5; ++x)
+		{
+			polygons << Circle{ (x * 90.0), (y * 70.0), 25 }.asPolygon(12);
+		}
+	}
+
+	polygons << MakeHoledPolygon().scaled(0.25).movedBy(500, 100);
+	REQUIRE(16 <= polygons.size());
+
+	CheckMultiPolygon(polygons, rng);
+
+	// 移動
+	polygons.moveBy(-30, 40);
+	CheckMultiPolygon(polygons, rng);
+
+	// 追加
+	polygons.push_back(Circle{ 700, 400, 50 }.asPolygon(24));
+	CheckMultiPolygon(polygons, rng);
+
+	// 要素の直接の書き換え
+	polygons[3].moveBy(300, 300);
+	polygons[10] = Rect{ -200, -200, 80, 40 }.asPolygon();
+	CheckMultiPolygon(polygons, rng);
+
+	// 削除
+	polygons.remove_at(0);
+	CheckMultiPolygon(polygons, rng);
+
+	// コピーしたものも一致する
+	const MultiPolygon copied = polygons;
+	CheckMultiPolygon(copied, rng);
+
+	// 参照を取得した後に判定してから、参照を通して書き換える
+	{
+		Polygon& polygon = polygons[5];
+		auto it = (polygons.begin() + 7);
+		const Vec2 target{ -500, 600 };
+		REQUIRE_FALSE(polygons.intersects(target));
+
+		polygon = Circle{ target, 10 }.asPolygon(12);
+		it->moveBy(900, 900);
+		CHECK(polygons.intersects(target));
+		CheckMultiPolygon(polygons, rng);
+	}
+
+	// すべての要素を置き換えた後も一致する
+	polygons.assign(copied);
+	CheckMultiPolygon(polygons, rng);
+
+	// ムーブしても、ムーブ元から取得した参照を通した書き換えが反映される
+	{
+		Polygon& polygon = polygons[2];
+		MultiPolygon moved = std::move(polygons);
+		const Vec2 target{ 800, -400 };
+		REQUIRE_FALSE(moved.intersects(target));
+
+		polygon = Circle{ target, 10 }.asPolygon(12);
+		CHECK(moved.intersects(target));
+		CheckMultiPolygon(moved, rng);
+	}
+}
@@ -0,0 +1,311 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// i 番目のサンプルが (i, -i) になるストリーム
+	class RampDecoderStream : public IAudioDecoderStream
+	{
+	public:
+
+		explicit RampDecoderStream(const size_t samples)
+			: m_samples{ samples } {}
+
+		uint32 sampleRate() const override
+		{
+			return 44100;
+		}
+
+		size_t samples() const override
+		{
+			return m_samples;
+		}
+
+		size_t read(WaveSample* dst, const size_t count) override
+		{
+			const size_t n = Min(count, (m_samples - m_pos));
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				const float value = static_cast<float>(m_pos + i);
+				dst[i] = WaveSample{ value, -value };
+			}
+
+			m_pos += n;
+
+			return n;
+		}
+
+		bool seek(const size_t posSample) override
+		{
+			if (m_samples < posSample)
+			{
+				return false;
+			}
+
+			m_pos = posSample;
+
+			return true;
+		}
+
+	private:
+
+		size_t m_samples = 0;
+
+		size_t m_pos = 0;
+	};
+
+	// 指定したサンプル数の先読みが済むまで待つ
+	[[nodiscard]]
+	bool WaitForBuffered(const PrefetchAudioStream& stream, const size_t samples)
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (stream.bufferedSamples() < samples)
+		{
+			if (5.0 < stopwatch.sF())
+			{
+				return false;
+			}
+
+			System::Sleep(1);
+		}
+
+		return true;
+	}
+
+	// デコードが終端に達するまで待つ
+	[[nodiscard]]
+	bool WaitForEnd(PrefetchAudioStream& stream)
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (not stream.hasEnded())
+		{
+			if (5.0 < stopwatch.sF())
+			{
+				return false;
+			}
+
+			System::Sleep(1);
+		}
+
+		return true;
+	}
+
+	// 先読みを待ちながら、指定したサンプル数を読み込む
+	[[nodiscard]]
+	Array<WaveSample> ReadSamples(PrefetchAudioStream& stream, const size_t samples)
+	{
+		constexpr size_t ChunkSize = 1000;
+
+		Array<float> left(ChunkSize), right(ChunkSize);
+		Array<WaveSample> result;
+
+		while (result.size() < samples)
+		{
+			const size_t count = Min(ChunkSize, (samples - result.size()));
+
+			if (not WaitForBuffered(stream, count))
+			{
+				break;
+			}
+
+			stream.getAudio(left.data(), right.data(), count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				result.emplace_back(left[i], right[i]);
+			}
+		}
+
+		return result;
+	}
+
+	// ループしない場合は pos, ループ区間 [loopBegin, length) をループする場合はループ後の位置を返す
+	[[nodiscard]]
+	size_t LoopedPos(const size_t pos, const size_t length, const size_t loopBegin)
+	{
+		if (pos < length)
+		{
+			return pos;
+		}
+
+		return (loopBegin + ((pos - length) % (length - loopBegin)));
+	}
+}
+
+TEST_CASE("PrefetchAudioStream")
+{
+	constexpr size_t Length = 10000;
+
+	SECTION("read through")
+	{
+		PrefetchAudioStream stream{ std::make_unique<RampDecoderStream>(Length) };
+		REQUIRE(stream.isOpen());
+		CHECK(stream.sampleRate() == 44100);
+		CHECK(stream.samples() == Length);
+
+		const Array<WaveSample> samples = ReadSamples(stream, Length);
+		REQUIRE(samples.size() == Length);
+
+		bool matched = true;
+
+		for (size_t i = 0; i < Length; ++i)
+		{
+			matched &= ((samples[i].left == static_cast<float>(i)) && (samples[i].right == -static_cast<float>(i)));
+		}
+
+		CHECK(matched);
+		CHECK(stream.posSample() == Length);
+		CHECK(stream.loopCount() == 0);
+		CHECK(stream.underrunCount() == 0);
+		CHECK(WaitForEnd(stream));
+
+		// 終端の後は無音になる
+		float left = 1.0f, right = 1.0f;
+		stream.getAudio(&left, &right, 1);
+		CHECK(left == 0.0f);
+		CHECK(right == 0.0f);
+		CHECK(stream.posSample() == Length);
+	}
+
+	SECTION("seek")
+	{
+		PrefetchAudioStream stream{ std::make_unique<RampDecoderStream>(Length) };
+		REQUIRE(ReadSamples(stream, 3000).size() == 3000);
+
+		REQUIRE(stream.seekSamples(7000));
+		CHECK(stream.posSample() == 7000);
+
+		{
+			const Array<WaveSample> samples = ReadSamples(stream, 100);
+			REQUIRE(samples.size() == 100);
+			CHECK(samples.front().left == 7000.0f);
+			CHECK(samples.back().left == 7099.0f);
+			CHECK(stream.posSample() == 7100);
+		}
+
+		// 前方へのシーク
+		REQUIRE(stream.seekSamples(500));
+		CHECK(stream.posSample() == 500);
+
+		{
+			const Array<WaveSample> samples = ReadSamples(stream, (Length - 500));
+			REQUIRE(samples.size() == (Length - 500));
+			CHECK(samples.front().left == 500.0f);
+			CHECK(samples.back().left == static_cast<float>(Length - 1));
+			CHECK(stream.posSample() == Length);
+			CHECK(WaitForEnd(stream));
+		}
+
+		// 先頭に戻す
+		stream.rewind();
+		CHECK(stream.posSample() == 0);
+		CHECK_FALSE(stream.hasEnded());
+		CHECK(ReadSamples(stream, 1).front().left == 0.0f);
+	}
+
+	SECTION("loop")
+	{
+		constexpr size_t LoopBegin = 2000;
+
+		PrefetchAudioStream stream{ std::make_unique<RampDecoderStream>(Length) };
+		stream.setLoopBegin(LoopBegin);
+		stream.setLoop(true);
+		CHECK(stream.isLoop());
+
+		// 3 周目の途中まで読み込む
+		const size_t total = (Length + (Length - LoopBegin) + 3000);
+		const Array<WaveSample> samples = ReadSamples(stream, total);
+		REQUIRE(samples.size() == total);
+
+		bool matched = true;
+
+		for (size_t i = 0; i < total; ++i)
+		{
+			matched &= (samples[i].left == static_cast<float>(LoopedPos(i, Length, LoopBegin)));
+		}
+
+		CHECK(matched);
+		CHECK(stream.loopCount() == 2);
+		CHECK(stream.posSample() == (LoopBegin + 3000));
+		CHECK_FALSE(stream.hasEnded());
+		CHECK(stream.underrunCount() == 0);
+
+		// ループ区間の途中へのシーク
+		REQUIRE(stream.seekSamples(9500));
+		const Array<WaveSample> seeked = ReadSamples(stream, 1000);
+		REQUIRE(seeked.size() == 1000);
+		CHECK(seeked[499].left == static_cast<float>(Length - 1));
+		CHECK(seeked[500].left == static_cast<float>(LoopBegin));
+		CHECK(stream.loopCount() == 3);
+		CHECK(stream.posSample() == (LoopBegin + 500));
+	}
+
+	SECTION("loop (sample.ogg)")
+	{
+		const FilePathView path = U"test/audio/sample.ogg";
+		constexpr size_t OggLength = 83968;
+		constexpr size_t LoopBegin = 40000;
+
+		// 比較用に、デコーダのストリームから直接読み込む
+		Array<WaveSample> expected(OggLength);
+		{
+			auto decoder = AudioDecoder::OpenStream(path, AudioFormat::OggVorbis);
+			REQUIRE(decoder);
+			REQUIRE(decoder->sampleRate() == 44100);
+			REQUIRE(decoder->samples() == OggLength);
+
+			size_t count = 0;
+
+			while (const size_t n = decoder->read((expected.data() + count), (OggLength - count)))
+			{
+				count += n;
+			}
+
+			REQUIRE(count == OggLength);
+		}
+
+		PrefetchAudioStream stream{ AudioDecoder::OpenStream(path, AudioFormat::OggVorbis) };
+		REQUIRE(stream.isOpen());
+		CHECK(stream.samples() == OggLength);
+
+		stream.setLoopBegin(LoopBegin);
+		stream.setLoop(true);
+
+		const size_t total = (OggLength + 1000);
+		const Array<WaveSample> samples = ReadSamples(stream, total);
+		REQUIRE(samples.size() == total);
+
+		// ループの先頭へのシークでは、デコーダの状態の違いによるわずかな誤差を許容する
+		bool matched = true;
+
+		for (size_t i = 0; i < total; ++i)
+		{
+			const WaveSample& e = expected[LoopedPos(i, OggLength, LoopBegin)];
+			matched &= ((std::abs(samples[i].left - e.left) < 1e-4f) && (std::abs(samples[i].right - e.right) < 1e-4f));
+		}
+
+		CHECK(matched);
+		CHECK(stream.loopCount() == 1);
+		CHECK(stream.posSample() == (LoopBegin + 1000));
+
+		// シークした位置のサンプルが、先頭から読み込んだ場合と一致する
+		REQUIRE(stream.seekSamples(20000));
+		const Array<WaveSample> seeked = ReadSamples(stream, 1);
+		REQUIRE(seeked.size() == 1);
+		CHECK(std::abs(seeked.front().left - expected[20000].left) < 1e-4f);
+		CHECK(std::abs(seeked.front().right - expected[20000].right) < 1e-4f);
+	}
+}
@@ -0,0 +1,89 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	String ExportTrace()
+	{
+		const FilePath path = U"test/runtime/profilerzone/trace.json";
+
+		if (not Profiler::ExportChromeTrace(path, 1))
+		{
+			return{};
+		}
+
+		return TextReader{ path }.readAll();
+	}
+}
+
+TEST_CASE("ProfilerZone")
+{
+	Profiler::EnableZoneRecording(true);
+
+	System::Update();
+	System::Update();
+
+	const size_t threadCount = ExportTrace().count(U"\"thread_name\"");
+
+	{
+		SIV3D_PROFILE_ZONE(U"ProfilerZoneTest.Main");
+	}
+
+	// 短命なスレッドを繰り返し作っても、バッファは再利用される
+	for (int32 i = 0; i < 64; ++i)
+	{
+		std::thread{ []()
+		{
+			SIV3D_PROFILE_ZONE(U"ProfilerZoneTest.Thread");
+			{
+				SIV3D_PROFILE_ZONE(U"ProfilerZoneTest.Nested");
+			}
+		} }.join();
+	}
+
+	// リングバッファの容量を超えて書き込みながら読み出す
+	{
+		std::atomic<bool> done = false;
+
+		std::thread writer{ [&]()
+		{
+			for (int32 i = 0; i < 20000; ++i)
+			{
+				SIV3D_PROFILE_ZONE(U"ProfilerZoneTest.Writer");
+			}
+
+			done = true;
+		} };
+
+		while (not done)
+		{
+			[[maybe_unused]] const String trace = ExportTrace();
+		}
+
+		writer.join();
+	}
+
+	System::Update();
+
+	const String trace = ExportTrace();
+
+	Profiler::EnableZoneRecording(false);
+
+	REQUIRE(trace.ends_with(U"]}"));
+	REQUIRE(trace.count(U"\"name\":\"ProfilerZoneTest.Main\"") == 1);
+	REQUIRE(trace.count(U"\"name\":\"ProfilerZoneTest.Thread\"") == 64);
+	REQUIRE(trace.count(U"\"name\":\"ProfilerZoneTest.Nested\"") == 64);
+	REQUIRE(trace.count(U"\"name\":\"ProfilerZoneTest.Writer\"") == 16384);
+	REQUIRE(trace.count(U"\"thread_name\"") <= (threadCount + 2));
+}
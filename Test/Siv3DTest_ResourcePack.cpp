@@ -0,0 +1,219 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// test/runtime/resourcepack/src/ にまとめるファイル
+// - text.txt		圧縮されるブロックのみ（3 ブロック）
+// - mixed.bin		圧縮されるブロックと、圧縮で小さくならないため無圧縮で格納されるブロック
+// - sub/random.bin	圧縮の効果がないため、ファイル全体が無圧縮で格納される
+
+namespace
+{
+	constexpr size_t BlockSize = (256 * 1024);
+
+	[[nodiscard]]
+	Blob MakeRandomData(const size_t size, uint64 seed)
+	{
+		Blob blob(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			seed ^= (seed << 13);
+			seed ^= (seed >> 7);
+			seed ^= (seed << 17);
+			blob.data()[i] = static_cast<Byte>(seed >> 56);
+		}
+
+		return blob;
+	}
+
+	[[nodiscard]]
+	Blob MakeTextData()
+	{
+		std::string text;
+
+		for (size_t i = 0; text.size() < (BlockSize * 2 + 1000); ++i)
+		{
+			text += "Siv3D ResourcePack line " + std::to_string(i) + "\n";
+		}
+
+		return Blob{ text.data(), text.size() };
+	}
+
+	[[nodiscard]]
+	Blob MakeMixedData()
+	{
+		const Blob randomData = MakeRandomData(BlockSize, 12345);
+
+		Blob blob(BlockSize);
+		blob.append(randomData.data(), randomData.size());
+		return blob;
+	}
+
+	[[nodiscard]]
+	bool SaveBlob(const Blob& blob, const FilePathView path)
+	{
+		BinaryWriter writer{ path };
+		return (writer && (writer.write(blob.data(), blob.size()) == static_cast<int64>(blob.size())));
+	}
+
+	[[nodiscard]]
+	Blob ReadAll(const FilePathView path)
+	{
+		BinaryReader reader{ path };
+
+		if (not reader)
+		{
+			return{};
+		}
+
+		Blob blob(static_cast<size_t>(reader.size()));
+
+		if (reader.read(blob.data(), reader.size()) != reader.size())
+		{
+			return{};
+		}
+
+		return blob;
+	}
+
+	[[nodiscard]]
+	bool MatchesRange(BinaryReader& reader, const Blob& expected, const int64 pos, const int64 size)
+	{
+		Array<Byte> buffer(static_cast<size_t>(size));
+
+		if (reader.read(buffer.data(), pos, size) != size)
+		{
+			return false;
+		}
+
+		return (std::memcmp(buffer.data(), (expected.data() + pos), static_cast<size_t>(size)) == 0);
+	}
+}
+
+TEST_CASE("ResourcePack")
+{
+	const FilePath sourceDirectory = U"test/runtime/resourcepack/src/";
+	const FilePath packPath = U"test/runtime/resourcepack/test.s3dpack";
+	const FilePath mountPoint = U"test/runtime/resourcepack/mnt/";
+
+	FileSystem::Remove(U"test/runtime/resourcepack/");
+
+	const Blob textData = MakeTextData();
+	const Blob mixedData = MakeMixedData();
+	const Blob randomData = MakeRandomData(100000, 67890);
+
+	REQUIRE(SaveBlob(textData, (sourceDirectory + U"text.txt")));
+	REQUIRE(SaveBlob(mixedData, (sourceDirectory + U"mixed.bin")));
+	REQUIRE(SaveBlob(randomData, (sourceDirectory + U"sub/random.bin")));
+
+	REQUIRE(ResourcePack::Create(sourceDirectory, packPath));
+	REQUIRE(ResourcePack::Mount(packPath, mountPoint));
+
+	// 圧縮されたファイルはパックの中で小さくなる
+	CHECK(FileSystem::FileSize(packPath) < static_cast<int64>(textData.size() + mixedData.size() + randomData.size()));
+
+	SECTION("Contains / EnumFiles")
+	{
+		CHECK(ResourcePack::Contains(mountPoint + U"text.txt"));
+		CHECK(ResourcePack::Contains(mountPoint + U"mixed.bin"));
+		CHECK(ResourcePack::Contains(mountPoint + U"sub/random.bin"));
+		CHECK_FALSE(ResourcePack::Contains(mountPoint + U"random.bin"));
+		CHECK_FALSE(ResourcePack::Contains(sourceDirectory + U"text.txt"));
+
+		CHECK(ResourcePack::EnumFiles() == Array<FilePath>{ (mountPoint + U"mixed.bin"), (mountPoint + U"sub/random.bin"), (mountPoint + U"text.txt") });
+	}
+
+	SECTION("BinaryReader")
+	{
+		// マウント先にはファイルが存在しないので、パックから読み込まれる
+		CHECK_FALSE(FileSystem::Exists(mountPoint + U"text.txt"));
+
+		CHECK(ReadAll(mountPoint + U"text.txt") == textData);
+		CHECK(ReadAll(mountPoint + U"mixed.bin") == mixedData);
+		CHECK(ReadAll(mountPoint + U"sub/random.bin") == randomData);
+	}
+
+	SECTION("BinaryReader (partial reads)")
+	{
+		{
+			BinaryReader reader{ mountPoint + U"text.txt" };
+			REQUIRE(reader);
+			CHECK(reader.size() == static_cast<int64>(textData.size()));
+
+			// ブロックの境界をまたぐ読み込みと、前のブロックへの読み戻し
+			CHECK(MatchesRange(reader, textData, (BlockSize - 100), 200));
+			CHECK(MatchesRange(reader, textData, (BlockSize * 2 - 10), 1010));
+			CHECK(MatchesRange(reader, textData, 10, 100));
+			CHECK(MatchesRange(reader, textData, 0, static_cast<int64>(textData.size())));
+		}
+
+		{
+			BinaryReader reader{ mountPoint + U"mixed.bin" };
+			REQUIRE(reader);
+
+			// 圧縮されたブロックから、無圧縮で格納されたブロックへまたがる読み込み
+			CHECK(MatchesRange(reader, mixedData, (BlockSize - 50), 100));
+			CHECK(MatchesRange(reader, mixedData, (BlockSize + 1000), 5000));
+			CHECK(MatchesRange(reader, mixedData, 0, 4096));
+		}
+
+		{
+			BinaryReader reader{ mountPoint + U"sub/random.bin" };
+			REQUIRE(reader);
+
+			CHECK(reader.setPos(50000) == 50000);
+			CHECK(MatchesRange(reader, randomData, 50000, 50000));
+		}
+	}
+
+	SECTION("Unmount")
+	{
+		BinaryReader reader{ mountPoint + U"text.txt" };
+		REQUIRE(reader);
+
+		CHECK(ResourcePack::Unmount(packPath));
+		CHECK_FALSE(ResourcePack::Unmount(packPath));
+
+		CHECK_FALSE(ResourcePack::Contains(mountPoint + U"text.txt"));
+		CHECK_FALSE(BinaryReader{ mountPoint + U"text.txt" }.isOpen());
+
+		// マウントを解除する前に開いたファイルは、引き続き読み込める
+		CHECK(MatchesRange(reader, textData, (BlockSize - 100), 200));
+	}
+
+	SECTION("EnumResourceFiles")
+	{
+		const FilePath resourceDirectory = Resource(U"");
+
+		REQUIRE(ResourcePack::Mount(packPath));
+
+		const Array<FilePath>& files = EnumResourceFiles();
+		CHECK(files.includes(resourceDirectory + U"text.txt"));
+		CHECK(files.includes(resourceDirectory + U"sub/random.bin"));
+
+		// マウントの状態が変わっても、以前に返した一覧は有効なまま
+		ResourcePack::UnmountAll();
+		CHECK_FALSE(EnumResourceFiles().includes(resourceDirectory + U"text.txt"));
+		CHECK(files.includes(resourceDirectory + U"text.txt"));
+
+		// 同じリソースパックをマウントし直すと、同じ一覧が使われる
+		for (int32 i = 0; i < 100; ++i)
+		{
+			REQUIRE(ResourcePack::Mount(packPath));
+			CHECK(&EnumResourceFiles() == &files);
+			ResourcePack::UnmountAll();
+		}
+	}
+
+	ResourcePack::UnmountAll();
+}
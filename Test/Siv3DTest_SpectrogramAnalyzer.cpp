@@ -0,0 +1,65 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include "Siv3DTest.hpp"
+
+TEST_CASE("SpectrogramAnalyzer")
+{
+	constexpr uint32 SampleRate = 44100;
+
+	Array<float> samples(SampleRate * 2);
+
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		samples[i] = static_cast<float>(0.5 * std::sin(Math::TwoPi * 1000.0 * i / SampleRate));
+	}
+
+	SpectrogramAnalyzer analyzer{ 4096, 1024, FFTWindowFunction::Hann };
+
+	Spectrogram spectrogram;
+	analyzer.analyze(spectrogram, samples.data(), samples.size(), SampleRate);
+
+	REQUIRE(spectrogram.bins() == 2048);
+	REQUIRE(spectrogram.frames() == ((samples.size() + 1023) / 1024));
+
+	{
+		const float* frame = spectrogram.magnitudes[10];
+		const size_t peak = (std::max_element(frame, (frame + spectrogram.bins())) - frame);
+
+		REQUIRE(std::abs(peak * spectrogram.resolution - 1000.0) < spectrogram.resolution);
+		REQUIRE(std::abs(frame[peak] - 0.5f) < 0.05f);
+	}
+
+	{
+		Spectrogram parallel;
+		analyzer.analyze(parallel, samples.data(), samples.size(), SampleRate, Parallel::Yes);
+
+		REQUIRE(parallel.magnitudes == spectrogram.magnitudes);
+	}
+
+	{
+		SpectrogramAnalyzer streaming{ 4096, 1024, FFTWindowFunction::Hann };
+		Spectrogram result;
+
+		for (size_t i = 0; i < samples.size(); i += 777)
+		{
+			streaming.process(result, (samples.data() + i), Min<size_t>(777, (samples.size() - i)), SampleRate);
+		}
+
+		REQUIRE(result.frames() == (1 + (samples.size() - 4096) / 1024));
+
+		for (size_t frame = 0; frame < result.frames(); ++frame)
+		{
+			REQUIRE(std::equal(result.magnitudes[frame], (result.magnitudes[frame] + result.bins()), spectrogram.magnitudes[frame]));
+		}
+	}
+
+	REQUIRE_THROWS_AS(SpectrogramAnalyzer{ 1000 }, Error);
+}
@@ -0,0 +1,153 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	constexpr uint16 TestPort = 50123;
+
+	// 条件が満たされるまで最大 5 秒待つ
+	template <class Fty>
+	[[nodiscard]]
+	bool WaitUntil(Fty f)
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (not f())
+		{
+			if (5.0 < stopwatch.sF())
+			{
+				return false;
+			}
+
+			System::Sleep(1);
+		}
+
+		return true;
+	}
+}
+
+TEST_CASE("TCPServer")
+{
+	SECTION("accept and send")
+	{
+		TCPServer server;
+		server.startAccept(TestPort);
+		CHECK(server.isAccepting());
+
+		TCPClient client;
+		REQUIRE(client.connect(IPv4Address::Localhost(), TestPort));
+		REQUIRE(WaitUntil([&]() { return (server.hasSession() && client.isConnected()); }));
+
+		// 1 対 1 の場合は、接続後に待ち受けを終了する
+		CHECK_FALSE(server.isAccepting());
+		CHECK(server.num_sessions() == 1);
+
+		const int64 request = 0x0123456789ABCDEF;
+		REQUIRE(client.send(request));
+		REQUIRE(WaitUntil([&]() { return (sizeof(request) <= server.available()); }));
+
+		int64 received = 0;
+		REQUIRE(server.read(received));
+		CHECK(received == request);
+
+		const int64 response = -request;
+		REQUIRE(server.send(response));
+		REQUIRE(WaitUntil([&]() { return (sizeof(response) <= client.available()); }));
+
+		int64 echoed = 0;
+		REQUIRE(client.read(echoed));
+		CHECK(echoed == response);
+
+		server.disconnect();
+		CHECK_FALSE(server.hasSession());
+	}
+
+	SECTION("multiple sessions")
+	{
+		constexpr size_t NumClients = 8;
+
+		TCPServer server;
+		server.startAcceptMulti(TestPort, 4);
+
+		Array<std::unique_ptr<TCPClient>> clients;
+
+		for (size_t i = 0; i < NumClients; ++i)
+		{
+			clients << std::make_unique<TCPClient>();
+			REQUIRE(clients.back()->connect(IPv4Address::Localhost(), TestPort));
+		}
+
+		REQUIRE(WaitUntil([&]() { return ((server.num_sessions() == NumClients)
+			&& clients.all([](const auto& client) { return client->isConnected(); })); }));
+		CHECK(server.isAccepting());
+
+		for (size_t i = 0; i < NumClients; ++i)
+		{
+			REQUIRE(clients[i]->send(static_cast<uint32>(i)));
+		}
+
+		REQUIRE(WaitUntil([&]() { return (server.getReadableSessionIDs(sizeof(uint32)).size() == NumClients); }));
+
+		Array<uint32> values;
+
+		for (const auto id : server.getSessionIDs())
+		{
+			uint32 value = 0;
+			REQUIRE(server.read(value, id));
+			values << value;
+		}
+
+		CHECK(values.sorted() == Range(0, (NumClients - 1)).map([](const size_t i) { return static_cast<uint32>(i); }).asArray());
+
+		CHECK(server.broadcast(uint32{ 42 }) == NumClients);
+
+		for (const auto& client : clients)
+		{
+			REQUIRE(WaitUntil([&]() { return (sizeof(uint32) <= client->available()); }));
+
+			uint32 value = 0;
+			REQUIRE(client->read(value));
+			CHECK(value == 42);
+		}
+
+		server.cancelAccept();
+		CHECK_FALSE(server.isAccepting());
+		CHECK(server.num_sessions() == NumClients);
+	}
+
+	SECTION("cancel and restart while clients connect")
+	{
+		// 接続の完了とアクセプタの停止・再開が重なっても、セッションの一覧が壊れないことを確かめる
+		TCPServer server;
+
+		for (int32 i = 0; i < 20; ++i)
+		{
+			server.startAcceptMulti(TestPort, 2);
+
+			TCPClient client;
+			[[maybe_unused]] const bool connected = client.connect(IPv4Address::Localhost(), TestPort);
+
+			server.cancelAccept();
+			CHECK_FALSE(server.isAccepting());
+		}
+
+		server.disconnect();
+		CHECK_FALSE(server.hasSession());
+
+		server.startAccept(TestPort);
+
+		TCPClient client;
+		REQUIRE(client.connect(IPv4Address::Localhost(), TestPort));
+		REQUIRE(WaitUntil([&]() { return server.hasSession(); }));
+	}
+}
@@ -1416,4 +1416,48 @@ TEST_CASE("TextReader::readAll(String&) | LONG")
 	}
 }
 
+TEST_CASE("TextReader | block boundary")
+{
+	// 内部のブロック (256 KiB) の境界に、複数バイトの文字やサロゲートペアがまたがるようにする
+	Array<String> expected;
+
+	for (int32 i = 0; i < 40000; ++i)
+	{
+		expected << U"{}: Siv3D あいう 😀{}"_fmt(i, String(i % 7, U'x'));
+	}
+
+	for (const auto encoding : { TextEncoding::UTF8_NO_BOM, TextEncoding::UTF8_WITH_BOM, TextEncoding::UTF16LE, TextEncoding::UTF16BE })
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/textreader/block_{}.txt"_fmt(FromEnum(encoding)));
+		{
+			TextWriter writer{ path, encoding };
+			REQUIRE(writer.isOpen());
+
+			for (const auto& line : expected)
+			{
+				writer.writeln(line);
+			}
+		}
+
+		{
+			TextReader reader{ path };
+			REQUIRE(reader.encoding() == encoding);
+			REQUIRE(reader.readLines() == expected);
+		}
+
+		{
+			TextReader reader{ path };
+			String line;
+			size_t count = 0;
+
+			while (reader.readLine(line))
+			{
+				REQUIRE(line == expected[count++]);
+			}
+
+			REQUIRE(count == expected.size());
+		}
+	}
+}
+
 SIV3D_DISABLE_MSVC_WARNINGS_POP()
@@ -0,0 +1,215 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/TextureAtlas/TextureAtlasLayout.hpp>
+
+namespace
+{
+	[[nodiscard]]
+	bool Overlaps(const Rect& a, const Rect& b)
+	{
+		return ((a.x < (b.x + b.w)) && (b.x < (a.x + a.w))
+			&& (a.y < (b.y + b.h)) && (b.y < (a.y + a.h)));
+	}
+
+	[[nodiscard]]
+	bool IsValidLayout(const Array<Rect>& rects, const Size& size)
+	{
+		for (size_t i = 0; i < rects.size(); ++i)
+		{
+			if (not Rect{ size }.contains(rects[i]))
+			{
+				return false;
+			}
+
+			for (size_t k = (i + 1); k < rects.size(); ++k)
+			{
+				if (Overlaps(rects[i], rects[k]))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// テクスチャ領域を、アトラス内のピクセル単位の領域に戻す
+	[[nodiscard]]
+	Rect ToPixelRect(const TextureRegion& region, const Size& atlasSize)
+	{
+		return Rect{ static_cast<int32>(Math::Round(region.uvRect.left * atlasSize.x)),
+			static_cast<int32>(Math::Round(region.uvRect.top * atlasSize.y)),
+			static_cast<int32>(region.size.x), static_cast<int32>(region.size.y) };
+	}
+}
+
+TEST_CASE("TextureAtlasLayout")
+{
+	SECTION("insert")
+	{
+		TextureAtlasLayout layout{ 256 };
+		Array<Rect> placed;
+
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const Array<Size> sizes = { Size{ (10 + i * 3), 20 }, Size{ 16, (5 + i * 4) }, Size{ 30, 30 } };
+			Array<Rect> rects;
+			REQUIRE(layout.insert(sizes, rects));
+			REQUIRE(rects.size() == sizes.size());
+
+			for (size_t k = 0; k < rects.size(); ++k)
+			{
+				REQUIRE(rects[k].size == sizes[k]);
+			}
+
+			// 配置済みの長方形は移動しないので、新しい長方形はそれらと重ならない
+			placed.append(rects);
+			REQUIRE(IsValidLayout(placed, layout.size()));
+		}
+
+		REQUIRE(layout.size().x <= 256);
+		REQUIRE(layout.size().y <= 256);
+	}
+
+	SECTION("release")
+	{
+		TextureAtlasLayout layout{ 64 };
+		Array<Rect> rects;
+		REQUIRE(layout.insert(Array<Size>(4, Size{ 32, 32 }), rects));
+		REQUIRE(layout.size() == Size{ 64, 64 });
+
+		layout.release(rects[2]);
+
+		Array<Rect> reused;
+		REQUIRE(layout.insert({ Size{ 32, 32 } }, reused));
+		REQUIRE(reused.front() == rects[2]);
+		REQUIRE(layout.size() == Size{ 64, 64 });
+	}
+
+	SECTION("failure")
+	{
+		TextureAtlasLayout layout{ 64 };
+		Array<Rect> rects;
+		REQUIRE(layout.insert({ Size{ 40, 40 } }, rects));
+
+		const Size size = layout.size();
+		const Array<Rect> freeRects = layout.getFreeRects();
+
+		// 失敗した場合は何も変更しない
+		Array<Rect> failed;
+		REQUIRE_FALSE(layout.insert({ Size{ 10, 10 }, Size{ 40, 40 } }, failed));
+		REQUIRE(layout.size() == size);
+		REQUIRE(layout.getFreeRects() == freeRects);
+
+		REQUIRE(layout.repack({ Size{ 40, 40 }, Size{ 10, 10 } }, rects));
+		REQUIRE(IsValidLayout(rects, layout.size()));
+	}
+}
+
+TEST_CASE("TextureAtlas")
+{
+	SECTION("lookup")
+	{
+		TextureAtlas atlas{ 512 };
+		REQUIRE(atlas.add(U"a", Image{ 40, 30, Palette::Red }));
+		REQUIRE(atlas.add(U"b", Image{ 20, 50, Palette::Green }));
+		REQUIRE(atlas.contains(U"a"));
+		REQUIRE_FALSE(atlas.contains(U"x"));
+		REQUIRE(atlas.num_images() == 2);
+		REQUIRE(atlas.build());
+
+		const TextureAtlasRegion a = atlas.region(U"a");
+		REQUIRE(a);
+		REQUIRE(a.size() == Size{ 40, 30 });
+		REQUIRE(atlas.region(U"x").isEmpty());
+
+		const Rect rectA = ToPixelRect(a.get(), atlas.size());
+		const Rect rectB = ToPixelRect(atlas(U"b"), atlas.size());
+		REQUIRE(IsValidLayout({ rectA, rectB }, atlas.size()));
+
+		// 画像を追加しても、配置済みの画像は移動しない
+		for (int32 i = 0; i < 16; ++i)
+		{
+			REQUIRE(atlas.add(U"c{}"_fmt(i), Image{ 24, 24, Palette::Blue }));
+		}
+
+		REQUIRE(atlas.build());
+		REQUIRE(ToPixelRect(a.get(), atlas.size()) == rectA);
+		REQUIRE(ToPixelRect(atlas(U"b"), atlas.size()) == rectB);
+	}
+
+	SECTION("replace")
+	{
+		TextureAtlas atlas{ 512 };
+		REQUIRE(atlas.add(U"a", Image{ 40, 40, Palette::Red }));
+		REQUIRE(atlas.add(U"b", Image{ 40, 40, Palette::Green }));
+		REQUIRE(atlas.build());
+
+		const TextureAtlasRegion a = atlas.region(U"a");
+		const Rect rectA = ToPixelRect(a.get(), atlas.size());
+
+		// 確保済みの領域に収まる画像は、同じ位置で置き換えられる
+		REQUIRE(atlas.add(U"a", Image{ 30, 20, Palette::Yellow }));
+		REQUIRE(a.size() == Size{ 30, 20 });
+		REQUIRE(ToPixelRect(a.get(), atlas.size()).pos == rectA.pos);
+
+		// 収まらない画像に置き換えても、ハンドルは新しい画像を指す
+		REQUIRE(atlas.add(U"a", Image{ 100, 60, Palette::Yellow }));
+		REQUIRE(a.size() == Size{ 100, 60 });
+		REQUIRE(IsValidLayout({ ToPixelRect(a.get(), atlas.size()), ToPixelRect(atlas(U"b"), atlas.size()) }, atlas.size()));
+	}
+
+	SECTION("remove")
+	{
+		TextureAtlas atlas{ 512 };
+		REQUIRE(atlas.add(U"a", Image{ 16, 16, Palette::Red }));
+		REQUIRE(atlas.add(U"b", Image{ 16, 16, Palette::Green }));
+
+		const TextureAtlasRegion b = atlas.region(U"b");
+		REQUIRE(atlas.remove(U"b"));
+		REQUIRE_FALSE(atlas.remove(U"b"));
+		REQUIRE(b.isEmpty());
+
+		// 削除した画像の添字が再利用されても、古いハンドルは新しい画像を指さない
+		REQUIRE(atlas.add(U"c", Image{ 16, 16, Palette::Blue }));
+		REQUIRE(b.isEmpty());
+		REQUIRE(b.size() == Size{ 0, 0 });
+		REQUIRE(atlas.region(U"c").size() == Size{ 16, 16 });
+
+		REQUIRE(atlas.remove(U"a"));
+		REQUIRE(atlas.remove(U"c"));
+		REQUIRE(atlas.build());
+		REQUIRE(atlas.size() == Size{ 0, 0 });
+	}
+
+	SECTION("failure")
+	{
+		TextureAtlas atlas{ 64, 0 };
+		REQUIRE(atlas.add(U"a", Image{ 60, 60, Palette::Red }));
+		REQUIRE(atlas.build());
+
+		const uint64 version = atlas.version();
+		const Rect rectA = ToPixelRect(atlas(U"a"), atlas.size());
+
+		// 配置に失敗しても、直前の配置が使われる
+		REQUIRE(atlas.add(U"b", Image{ 60, 60, Palette::Green }));
+		REQUIRE_FALSE(atlas.build());
+		REQUIRE(atlas.version() == version);
+		REQUIRE(ToPixelRect(atlas(U"a"), atlas.size()) == rectA);
+
+		// 画像を削除すれば、再び配置できる
+		REQUIRE(atlas.remove(U"a"));
+		REQUIRE(atlas.build());
+		REQUIRE(atlas.region(U"b").size() == Size{ 60, 60 });
+	}
+}
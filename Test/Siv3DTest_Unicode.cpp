@@ -51,4 +51,38 @@ TEST_CASE("Unicode")
 		REQUIRE(Unicode::ToUTF32(U"OpenSiv3D") == U"OpenSiv3D");
 		REQUIRE(Unicode::ToUTF32(U"あいうえお") == U"あいうえお");
 	}
+
+	SECTION("FromUTF8 / ToUTF8 | long")
+	{
+		// ASCII の連続と、それ以外の文字が混ざる場合
+		String s;
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			s += U"OpenSiv3D あいうえお 😀 {}\n"_fmt(i);
+		}
+
+		const std::string utf8 = Unicode::ToUTF8(s);
+		REQUIRE(Unicode::FromUTF8(utf8) == s);
+		REQUIRE(Unicode::FromUTF16(Unicode::ToUTF16(s)) == s);
+		REQUIRE(Unicode::UTF8ToUTF32(utf8) == s.str());
+		REQUIRE(Unicode::UTF32ToUTF8(s.str()) == utf8);
+	}
+
+	SECTION("FromUTF8 | invalid")
+	{
+		// 不正なバイトは 1 バイトずつ U+FFFD になる
+		const std::string ascii(40, 'a');
+		REQUIRE(Unicode::FromUTF8(ascii + "\x80" + ascii) == (String(40, U'a') + U"\uFFFD" + String(40, U'a')));
+		REQUIRE(Unicode::FromUTF8(ascii + "\xE3\x81") == (String(40, U'a') + U"\uFFFD\uFFFD"));
+		REQUIRE(Unicode::FromUTF8(ascii + "\xFF" + ascii + "\xE3\x81\x82") == (String(40, U'a') + U"\uFFFD" + String(40, U'a') + U"あ"));
+	}
+
+	SECTION("FromUTF16 | invalid")
+	{
+		// 対になっていないサロゲートは U+FFFD になる
+		const std::u16string ascii(20, u'a');
+		REQUIRE(Unicode::FromUTF16(ascii + u'\xD800' + ascii) == (String(20, U'a') + U"\uFFFD" + String(20, U'a')));
+		REQUIRE(Unicode::FromUTF16(ascii + u'\xDC00') == (String(20, U'a') + U"\uFFFD"));
+	}
 }
@@ -0,0 +1,161 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// test/zip/test.zip の内容
+// - a.txt			無圧縮	"Hello, Siv3D!"
+// - dir/			ディレクトリ
+// - dir/b.bin		Deflate	100,000 bytes
+// - dir/sub/c.txt	Deflate	"Siv3D " * 200
+// - dup.txt		無圧縮	"first"
+// - dup.txt		Deflate	"second"（同じパスのエントリ）
+
+namespace
+{
+	[[nodiscard]]
+	Blob MakeBinaryData()
+	{
+		Blob blob(100000);
+
+		for (size_t i = 0; i < blob.size(); ++i)
+		{
+			blob.data()[i] = static_cast<Byte>(((i * 7) + (i >> 8)) & 0xFF);
+		}
+
+		return blob;
+	}
+
+	[[nodiscard]]
+	String Repeat(const StringView s, const size_t count)
+	{
+		String result;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			result += s;
+		}
+
+		return result;
+	}
+
+	[[nodiscard]]
+	std::string ReadAll(IReader& reader)
+	{
+		std::string result(static_cast<size_t>(reader.size()), '\0');
+
+		if (reader.read(result.data(), reader.size()) != reader.size())
+		{
+			return{};
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("ZIPReader")
+{
+	const ZIPReader zip{ U"test/zip/test.zip" };
+	REQUIRE(zip.isOpen());
+
+	const Blob binaryData = MakeBinaryData();
+	const std::string textData = Repeat(U"Siv3D ", 200).narrow();
+
+	SECTION("enumPaths")
+	{
+		CHECK(zip.enumPaths() == Array<FilePath>{ U"a.txt", U"dir/", U"dir/b.bin", U"dir/sub/c.txt", U"dup.txt", U"dup.txt" });
+		CHECK(zip.contains(U"dir/b.bin"));
+		CHECK_FALSE(zip.contains(U"b.bin"));
+	}
+
+	SECTION("extractToBlob")
+	{
+		CHECK(zip.extractToBlob(U"a.txt").asArray() == Array<Byte>{ Byte{ 'H' }, Byte{ 'e' }, Byte{ 'l' }, Byte{ 'l' }, Byte{ 'o' },
+			Byte{ ',' }, Byte{ ' ' }, Byte{ 'S' }, Byte{ 'i' }, Byte{ 'v' }, Byte{ '3' }, Byte{ 'D' }, Byte{ '!' } });
+		CHECK(zip.extractToBlob(U"dir/b.bin") == binaryData);
+		CHECK_FALSE(zip.extractToBlob(U"missing.txt"));
+	}
+
+	SECTION("openReader")
+	{
+		{
+			const auto reader = zip.openReader(U"dir/sub/c.txt");
+			REQUIRE(reader);
+			CHECK(ReadAll(*reader) == textData);
+		}
+
+		{
+			const auto reader = zip.openReader(U"dir/b.bin");
+			REQUIRE(reader);
+			REQUIRE(reader->size() == static_cast<int64>(binaryData.size()));
+
+			// 前後に移動しながら読む
+			Byte value{};
+			REQUIRE(reader->read(&value, 50000, 1) == 1);
+			CHECK(value == binaryData.data()[50000]);
+			REQUIRE(reader->read(&value, 10, 1) == 1);
+			CHECK(value == binaryData.data()[10]);
+			REQUIRE(reader->lookahead(&value, 99999, 1) == 1);
+			CHECK(value == binaryData.data()[99999]);
+			CHECK(reader->getPos() == 11);
+		}
+
+		// 同じパスが複数ある場合は、最初のエントリを読む
+		{
+			const auto reader = zip.openReader(U"dup.txt");
+			REQUIRE(reader);
+			CHECK(ReadAll(*reader) == "first");
+		}
+	}
+
+	SECTION("extractAll")
+	{
+		const FilePath directory = FileSystem::FullPath(U"test/runtime/zipreader/all/");
+		FileSystem::Remove(directory);
+		FileSystem::CreateDirectories(directory);
+
+		REQUIRE(zip.extractAll(directory));
+
+		CHECK(FileSystem::IsDirectory(directory + U"dir/sub"));
+		CHECK(TextReader{ directory + U"a.txt" }.readAll() == U"Hello, Siv3D!");
+		CHECK(Blob{ directory + U"dir/b.bin" } == binaryData);
+		CHECK(TextReader{ directory + U"dir/sub/c.txt" }.readAll().narrow() == textData);
+
+		// 展開先が同じエントリは、逐次に展開した場合と同じく最後のものが残る
+		CHECK(TextReader{ directory + U"dup.txt" }.readAll() == U"second");
+
+		// 展開したファイルを読み直しても、アーカイブの内容と一致する
+		for (const auto& path : zip.enumPaths())
+		{
+			if (path.ends_with(U'/') || (path == U"dup.txt"))
+			{
+				continue;
+			}
+
+			CHECK(Blob{ directory + path } == zip.extractToBlob(path));
+		}
+	}
+
+	SECTION("extractFiles")
+	{
+		const FilePath directory = FileSystem::FullPath(U"test/runtime/zipreader/pattern/");
+		FileSystem::Remove(directory);
+		FileSystem::CreateDirectories(directory);
+
+		REQUIRE(zip.extractFiles(U"dir/*", directory));
+
+		CHECK(Blob{ directory + U"dir/b.bin" } == binaryData);
+		CHECK(FileSystem::Exists(directory + U"dir/sub/c.txt"));
+		CHECK_FALSE(FileSystem::Exists(directory + U"a.txt"));
+
+		CHECK_FALSE(zip.extractFiles(U"missing/*", directory));
+	}
+}